@@ -1,5 +1,6 @@
 import os
 import re
+import struct
 import sys
 
 import datalib
@@ -12,6 +13,15 @@ import glob
 ###
 ####################################################################################
 def parse_stats( path_run, types = None ):
+	# The binary log is much faster to load, but lacks a few text-only
+	# values (e.g. food patch percentages), so only use it when it has
+	# everything asked for.
+	path_log = os.path.join( path_run, 'stats', 'status.bin' )
+	if types and os.path.exists( path_log ):
+		colnames, rows = __read_status_log( path_log )
+		if set(types).issubset( colnames ):
+			return __status_tables( colnames, rows, types )
+
 	paths = glob.glob( os.path.join(path_run, 'stats', 'stat.*') )
 	paths.sort( lambda x, y: __path2step(x) - __path2step(y) )
 	
@@ -25,6 +35,85 @@ def parse_stats( path_run, types = None ):
 	return tables
 
 
+####################################################################################
+###
+### FUNCTION parse_status_log
+###
+### Same result as parse_stats(), read from the binary run/stats/status.bin
+### written alongside the stat.* files (see src/library/sim/StatusLog.h).
+###
+####################################################################################
+def parse_status_log( path_run, types = None ):
+	path_log = os.path.join( path_run, 'stats', 'status.bin' )
+	colnames, rows = __read_status_log( path_log )
+
+	if types and not set(types).issubset( colnames ):
+		raise datalib.MissingTableError( "Cannot find: " + ", ".join(set(types).difference( set(colnames) )) )
+
+	return __status_tables( colnames, rows, types )
+
+
+####################################################################################
+###
+### FUNCTION __read_status_log
+###
+####################################################################################
+def __read_status_log( path ):
+	data = open( path, 'rb' ).read()
+
+	if data[:8] != b'PWSTATUS':
+		raise Exception( "%s is not a status log" % path )
+	version, ncols = struct.unpack_from( '=II', data, 8 )
+	if version != 1:
+		raise Exception( "%s: unsupported status log version %d" % (path, version) )
+
+	offset = 16
+	colnames = []
+	for i in range(ncols):
+		end = data.index( b'\0', offset )
+		colnames.append( data[offset:end].decode('ascii') )
+		offset = end + 1
+
+	rowsize = 8 * ncols
+	nrows = (len(data) - offset) // rowsize
+	rows = [struct.unpack_from( '=%dd' % ncols, data, offset + i * rowsize ) for i in range(nrows)]
+
+	return colnames, rows
+
+
+####################################################################################
+###
+### FUNCTION __status_tables
+###
+####################################################################################
+def __status_tables( colnames, rows, labels ):
+	istep = colnames.index( 'step' )
+
+	tables = {}
+	for icol in range(len(colnames)):
+		label = colnames[icol]
+		if label == 'step' or (labels and label not in labels):
+			continue
+
+		values = [row[icol] for row in rows]
+		if all( v == v and abs(v) != float('inf') and v == int(v) for v in values ):
+			type = 'int'
+			values = [int(v) for v in values]
+		else:
+			type = 'float'
+
+		tables[label] = table = datalib.Table( label,
+											   ['step', 'value'],
+											   ['int', type],
+											   keycolname = 'step' )
+		for irow in range(len(rows)):
+			row = table.createRow()
+			row['step'] = int( rows[irow][istep] )
+			row['value'] = values[irow]
+
+	return tables
+
+
 ####################################################################################
 ###
 ### FUNCTION __add_step
@@ -641,7 +641,17 @@ else
 	########################
 	PWFARM_STATUS "Polyworld"
 
-	./Polyworld --ui term ./worldfile
+	# Polyworld publishes its farm status properties to run/metrics rather
+	# than invoking PWFARM_STATUS itself; forward them while it runs.
+	./Polyworld --ui term ./worldfile &
+	pid_polyworld=$!
+	while kill -0 $pid_polyworld 2>/dev/null; do
+	    sleep 5
+	    if status=$( pwmetrics --farm ./run 2>/dev/null ); then
+		PWFARM_STATUS "Polyworld $status"
+	    fi
+	done
+	wait $pid_polyworld
 	exitval=$?
 
 	###
@@ -1,7 +1,7 @@
 #!/bin/bash
 
 if [ -z "$1" ]; then
-    TESTS="clean determinism complexity"
+    TESTS="clean determinism parallelbodies concurrent allocations movies complexity interpreter"
 else
     TESTS="$*"
 fi
@@ -98,6 +98,188 @@ if istest determinism; then
     determinism static=true
 fi
 
+#
+# PARALLEL BODIES
+#
+if istest parallelbodies; then
+    NSTEPS=101
+    NTHREADS=4
+
+    echo "--- Testing Parallel Bodies Thread Independence"
+
+    dir=regression/parallelbodies
+    rm -rf $dir
+    mkdir -p $dir
+
+    worldfile recordPerformanceStats=0 maxSteps=$NSTEPS
+
+    for threads in 1 $NTHREADS; do
+	try ./Polyworld --ui term --threads $threads --StaticTimestepGeometry True --ParallelBodies True --RecordBirthsDeaths True --RecordPosition Precise ./worldfile > $dir/threads-$threads.out
+	mv run $dir/threads-$threads
+    done
+
+    for log in BirthsDeaths.log motion/position; do
+	if ! diff -r $dir/threads-1/$log $dir/threads-$NTHREADS/$log >> $dir/diff.out; then
+	    fail "ParallelBodies $log differs between 1 and $NTHREADS threads (see $dir/diff.out)"
+	fi
+    done
+fi
+
+#
+# CONCURRENT
+#
+if istest concurrent; then
+    NSTEPS=101
+
+    echo "--- Testing Concurrent Simulations"
+
+    dir=regression/concurrent
+    rm -rf $dir
+    mkdir -p $dir
+
+    # The variants differ in brain architecture, world size, food patches and
+    # barriers, so configuration leaking between simulations changes a run.
+    # The base worldfile has dynamic barriers and a food patch token ring.
+    wf=./worldfiles/m-neurons/growingBarriers.wf
+
+    variants=(
+'  {
+    BrainArchitecture Groups
+  }
+'
+'  {
+    BrainArchitecture Sheets
+    GenomeLayout None
+    WorldSize 60
+    Barriers [
+      {
+        X1 0.25
+      }
+      ,
+      {
+        X1 0.75
+      }
+    ]
+    Domains [
+      {
+        FoodPatches [
+          {
+            CenterX 0.2
+            FoodFraction 0.5
+          }
+          ,
+          {
+            FoodFraction 0.25
+          }
+          ,
+          {
+            FoodFraction 0.25
+          }
+        ]
+      }
+    ]
+  }
+'
+    )
+
+    ( echo "overlays ["
+      for i in 0 1; do
+	  [ $i -gt 0 ] && echo ","
+	  echo "${variants[$i]}"
+      done
+      echo "]" ) > $dir/variants.wfo
+
+    # Each variant alone in its own process...
+    for i in 0 1; do
+	( echo "overlays ["; echo "${variants[$i]}"; echo "]" ) > $dir/solo-$i.wfo
+	try ./Polyworld --batch $dir/solo-$i.wfo --jobs 1 --threads 1 --MaxSteps $NSTEPS --RecordBirthsDeaths True $wf > $dir/solo-$i.out
+	mv batch/0/run $dir/solo-$i
+	rm -rf batch
+    done
+
+    # ...must match the same variant run alongside the other in one process.
+    try ./Polyworld --batch $dir/variants.wfo --jobs 2 --threads 1 --MaxSteps $NSTEPS --RecordBirthsDeaths True $wf > $dir/batch.out
+    mv batch $dir/batch
+
+    for i in 0 1; do
+	if ! diff -r -x .cppprops $dir/solo-$i $dir/batch/$i/run > $dir/diff-$i.out; then
+	    fail "Concurrent simulation $i differs from its solo run (see $dir/diff-$i.out)"
+	fi
+    done
+
+    # Guard against the variants collapsing into one.
+    if diff -q $dir/solo-0/BirthsDeaths.log $dir/solo-1/BirthsDeaths.log > /dev/null; then
+	fail "Concurrent variants ran identically; the overlays had no effect"
+    fi
+fi
+
+#
+# ALLOCATIONS
+#
+if istest allocations; then
+    # The population is at MaxAgents from the start, so once it is steady
+    # every newborn should reuse a dead agent.
+    STEADY=500
+    NSTEPS=1000
+
+    echo "--- Testing Agent Reuse"
+
+    dir=regression/allocations
+    rm -rf $dir
+    mkdir -p $dir
+
+    if [ -e term.mf ]; then
+	fail "Move ./term.mf aside; this test publishes metrics through its own"
+    fi
+    cat > term.mf <<EOF
+@defaults term
+Metrics {
+  Enabled   True
+  Frequency 100
+}
+EOF
+
+    # Runs are deterministic, so a shorter run gives the metrics of a longer
+    # one at its last step.
+    for steps in $STEADY $NSTEPS; do
+	try ./Polyworld --ui term --MaxSteps $steps ./worldfiles/tests/low-spec-pc/minitest.wf > $dir/run-$steps.out
+	mv run $dir/run-$steps
+    done
+    rm term.mf
+
+    # Sets metric_value to the named metric of the run of the given length.
+    function metric {
+	if ! metric_value=`./bin/pwmetrics --metric $1 $dir/run-$2`; then
+	    fail "No metric $1 in $dir/run-$2"
+	fi
+    }
+
+    metric polyworld_births_total $STEADY; births=$metric_value
+    metric polyworld_births_total $NSTEPS; births=$(( metric_value - births ))
+    metric polyworld_agents_allocated_total $STEADY; allocated=$metric_value
+    metric polyworld_agents_allocated_total $NSTEPS; allocated=$(( metric_value - allocated ))
+
+    if [ $births -eq 0 ]; then
+	fail "No births between steps $STEADY and $NSTEPS; agent reuse was not exercised"
+    fi
+    if [ $allocated -ne 0 ]; then
+	fail "$allocated agents allocated during $births births at a steady population"
+    fi
+fi
+
+#
+# MOVIES
+#
+if istest movies; then
+    echo "--- Testing Movie Encoding"
+
+    dir=regression/movies
+    rm -rf $dir
+    mkdir -p $dir
+
+    try ./bin/pmvutil roundtrip $dir/roundtrip.pmv > $dir/roundtrip.out
+fi
+
 #
 # COMPLEXITY
 #
@@ -118,5 +300,33 @@ if istest complexity; then
     try scripts/plotNeuralComplexity Recent $dir
 fi
 
+#
+# INTERPRETER
+#
+if istest interpreter; then
+    echo "--- Testing Native Expression Evaluation"
+
+    dir=regression/interpreter
+    mkdir -p $dir
+
+    # Legacy worldfiles are skipped; they exercise the format converter, not evaluation.
+    for wf in `find worldfiles -name "*.wf" -not -path "worldfiles/legacy/*" | sort`; do
+	out=$dir/`echo $wf | tr / _`
+
+	try ./bin/proputil -i python -w apply etc/worldfile.wfs $wf > $out.python
+	try ./bin/proputil -i native -w apply etc/worldfile.wfs $wf > $out.native
+
+	if ! diff $out.python $out.native > $out.diff; then
+	    fail "Native evaluation differs from python for $wf"
+	fi
+
+	# The normalized worldfile keeps expressions as written, so also compare
+	# every evaluated value.
+	if ! ./bin/proputil -i check -w apply etc/worldfile.wfs $wf > /dev/null 2> $out.check; then
+	    fail "Native evaluation differs from python for $wf (see $out.check)"
+	fi
+    done
+fi
+
 echo "(-: REGRESSION SUCCESSFUL :-)"
 exit 0
\ No newline at end of file
@@ -0,0 +1,235 @@
+#include "BatchRunner.h"
+
+// System
+#include <errno.h>
+#include <locale.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+
+// STL
+#include <algorithm>
+#include <atomic>
+#include <thread>
+
+#if PW_HEADLESS
+#include <QCoreApplication>
+#else
+#include <QApplication>
+#endif
+
+#include "proplib/editor.h"
+#include "proplib/overlay.h"
+#include "sim/Scheduler.h"
+#include "sim/Simulation.h"
+#include "utils/misc.h"
+
+#define BATCHDIR "batch"
+
+//===========================================================================
+// BatchRunner
+//===========================================================================
+
+//---------------------------------------------------------------------------
+// BatchRunner::BatchRunner
+//---------------------------------------------------------------------------
+BatchRunner::BatchRunner( const std::string &worldfilePath,
+                          const proplib::ParameterMap &parameters,
+                          const std::string &overlayPath )
+    : worldfilePath( worldfilePath )
+    , parameters( parameters )
+    , overlayPath( overlayPath )
+    , maxJobs( 0 )
+    , threadsPerJob( 0 )
+    , overlay( NULL )
+    , schema( NULL )
+{
+}
+
+//---------------------------------------------------------------------------
+// BatchRunner::~BatchRunner
+//---------------------------------------------------------------------------
+BatchRunner::~BatchRunner()
+{
+    for( proplib::Document *worldfile : worldfiles )
+        delete worldfile;
+    delete schema;
+    delete overlay;
+}
+
+//---------------------------------------------------------------------------
+// BatchRunner::setMaxJobs
+//---------------------------------------------------------------------------
+void BatchRunner::setMaxJobs( int maxJobs )
+{
+    this->maxJobs = maxJobs;
+}
+
+//---------------------------------------------------------------------------
+// BatchRunner::setThreadsPerJob
+//---------------------------------------------------------------------------
+void BatchRunner::setThreadsPerJob( int threadsPerJob )
+{
+    this->threadsPerJob = threadsPerJob;
+}
+
+//---------------------------------------------------------------------------
+// BatchRunner::run
+//---------------------------------------------------------------------------
+void BatchRunner::run( int argc, char *argv[] )
+{
+    int ncores = std::max( 1u, std::thread::hardware_concurrency() );
+    if( maxJobs <= 0 && threadsPerJob <= 0 )
+        threadsPerJob = 1;
+    if( maxJobs <= 0 )
+        maxJobs = std::max( 1, ncores / threadsPerJob );
+    if( threadsPerJob <= 0 )
+        threadsPerJob = std::max( 1, ncores / maxJobs );
+
+    // ---
+    // --- Process-wide setup, shared by every instance
+    // ---
+#if PW_HEADLESS
+    QCoreApplication app( argc, argv );
+#else
+    // The agent POV renderers need a GL context.
+    QApplication app( argc, argv );
+#endif
+    setlocale( LC_NUMERIC, "C" );
+
+#if !__WIN64__ && !__WIN32__
+    setenv( "OMP_NUM_THREADS", std::to_string(threadsPerJob).c_str(), 1 );
+#endif
+    Scheduler::setThreadCount( threadsPerJob );
+
+    // Instances evaluate worldfile expressions as they initialize, so the
+    // interpreter stays up until they have all finished.
+    proplib::Interpreter::init();
+
+    // ---
+    // --- Parse everything once and validate each variant before launching
+    // ---
+    {
+        proplib::DocumentBuilder builder;
+        overlay = builder.buildDocument( overlayPath );
+
+        int n = overlay->get( "overlays" ).size();
+        if( n == 0 )
+        {
+            fprintf( stderr, "No overlays in %s\n", overlayPath.c_str() );
+            exit( 1 );
+        }
+
+        schema = builder.buildSchemaDocument( "./etc/worldfile.wfs" );
+        proplib::Document *base = builder.buildWorldfileDocument( schema, worldfilePath, parameters );
+
+        for( int i = 0; i < n; i++ )
+        {
+            proplib::Document *worldfile = buildVariant( base, i );
+
+            // Applying the schema modifies the document, so the copy handed to
+            // the instance is kept pristine.
+            proplib::Document *validate = worldfile->cloneDocument();
+            schema->apply( validate );
+            delete validate;
+
+            worldfiles.push_back( worldfile );
+        }
+
+        delete base;
+    }
+
+    if( exists(BATCHDIR) )
+    {
+        char t[64];
+        sprintf( t, BATCHDIR "_%ld", (long)time(NULL) );
+        if( rename(BATCHDIR, t) )
+        {
+            fprintf( stderr, "Failed renaming old " BATCHDIR " directory (%d)\n", errno );
+            exit( 1 );
+        }
+    }
+
+    int ninstances = (int)worldfiles.size();
+    int njobs = std::min( maxJobs, ninstances );
+    printf( "[batch] %d simulations, %d at a time, %d thread(s) each\n",
+            ninstances, njobs, threadsPerJob );
+    fflush( stdout );
+
+    // ---
+    // --- Each job runs instances until none are left
+    // ---
+    std::atomic<int> next( 0 );
+    std::vector<std::thread> jobs;
+
+    for( int i = 0; i < njobs; i++ )
+    {
+        jobs.emplace_back( [this, &next, ninstances]()
+            {
+                for( int index = next++; index < ninstances; index = next++ )
+                {
+                    printf( "[batch] %d: started\n", index );
+                    fflush( stdout );
+
+                    runInstance( index );
+
+                    printf( "[batch] %d: done\n", index );
+                    fflush( stdout );
+                }
+            } );
+    }
+
+    for( std::thread &job : jobs )
+        job.join();
+
+    proplib::Interpreter::dispose();
+
+    printf( "[batch] %d simulations done\n", ninstances );
+}
+
+//---------------------------------------------------------------------------
+// BatchRunner::buildVariant
+//
+// Clones the worldfile, which already has the command-line parameters, and
+// applies the given overlay clause. The schema has not been applied to the
+// result.
+//---------------------------------------------------------------------------
+proplib::Document *BatchRunner::buildVariant( proplib::Document *base, int index )
+{
+    proplib::Document *worldfile = base->cloneDocument();
+
+    proplib::DocumentEditor editor( schema, worldfile );
+    proplib::Overlay().applyDocument( overlay, index, &editor );
+
+    return worldfile;
+}
+
+//---------------------------------------------------------------------------
+// BatchRunner::getInstanceDir
+//---------------------------------------------------------------------------
+std::string BatchRunner::getInstanceDir( int index )
+{
+    return std::string( BATCHDIR "/" ) + std::to_string( index );
+}
+
+//---------------------------------------------------------------------------
+// BatchRunner::runInstance
+//
+// Executes on a job thread. The simulation's context is bound to the thread
+// from construction to deletion.
+//---------------------------------------------------------------------------
+void BatchRunner::runInstance( int index )
+{
+    // Takes ownership of the worldfile. The schema stays with us.
+    TSimulation *simulation = new TSimulation( schema,
+                                               worldfiles[index],
+                                               getInstanceDir(index) + "/run" );
+    worldfiles[index] = NULL;
+
+    bool ended = false;
+    simulation->ended += [&ended]() { ended = true; };
+    while( !ended )
+        simulation->Step();
+
+    delete simulation;
+}
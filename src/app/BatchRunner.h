@@ -0,0 +1,51 @@
+#pragma once
+
+#include <string>
+#include <vector>
+
+#include "proplib/proplib.h"
+
+//===========================================================================
+// BatchRunner
+//
+// Runs one simulation per clause of an overlay file, the format written by
+// scripts/farm/pwfarm_overlay.py. The schema, worldfile and overlays are
+// parsed once; each variant is a clone of the worldfile with its clause
+// applied, and every variant is validated before anything is launched.
+// The simulations then run on threads of this process, each with its own
+// SimulationContext and its output in batch/<index>/run, with at most
+// maxJobs running at a time and threadsPerJob scheduler threads each. They
+// share stdout, and a simulation that exits takes the batch with it.
+//===========================================================================
+
+class BatchRunner
+{
+ public:
+    BatchRunner( const std::string &worldfilePath,
+                 const proplib::ParameterMap &parameters,
+                 const std::string &overlayPath );
+    ~BatchRunner();
+
+    // 0 derives the value from the core count and the other setting.
+    void setMaxJobs( int maxJobs );
+    void setThreadsPerJob( int threadsPerJob );
+
+    void run( int argc, char *argv[] );
+
+ private:
+    proplib::Document *buildVariant( proplib::Document *base, int index );
+    std::string getInstanceDir( int index );
+    void runInstance( int index );
+
+    std::string worldfilePath;
+    proplib::ParameterMap parameters;
+    std::string overlayPath;
+    int maxJobs;
+    int threadsPerJob;
+
+    proplib::Document *overlay;
+    // Shared by the instances' TSimulations, which only borrow it.
+    proplib::SchemaDocument *schema;
+    // Handed over to each instance's TSimulation, which deletes them.
+    std::vector<proplib::Document *> worldfiles;
+};
@@ -1,9 +1,15 @@
-QT       += core gui opengl
+# "qmake CONFIG+=headless" must match the library build; only --ui term is
+# available then.
+headless {
+    QT = core
+    DEFINES += PW_HEADLESS
+} else {
+    QT += core gui opengl
+    greaterThan(QT_MAJOR_VERSION, 4): QT += widgets
+}
 DEFINES += CORE_UTILS=\\\"C:\\\\\\\\mingw\\\\\\\\coreutils-5.3.0\\\\\\\\bin\\\"
 CONFIG += console
 
-greaterThan(QT_MAJOR_VERSION, 4): QT += widgets
-
 # QMAKE_LFLAGS += rdynamic
 
 # CONFIG += c++11
@@ -18,8 +24,18 @@ INCLUDEPATH += \
     C:/Qt/Tools/mingw810_64/x86_64-w64-mingw32/include/GL
 
 SOURCES += \
+    BatchRunner.cpp \
     main.cpp \
     ui/SimulationController.cpp \
+    ui/term/TerminalUI.cpp
+
+HEADERS += \
+    BatchRunner.h \
+    ui/SimulationController.h \
+    ui/term/TerminalUI.h
+
+!headless {
+SOURCES += \
     ui/gui/BrainMonitorView.cpp \
     ui/gui/ChartMonitorView.cpp \
     ui/gui/MainWindow.cpp \
@@ -30,7 +46,6 @@ SOURCES += \
     ui/gui/ToggleWidgetOpenAction.cpp
 
 HEADERS += \
-    ui/SimulationController.h \
     ui/gui/BinChartViewMonitor.h \
     ui/gui/BrainMonitorView.h \
     ui/gui/ChartMonitorView.h \
@@ -40,6 +55,7 @@ HEADERS += \
     ui/gui/SceneMonitorView.h \
     ui/gui/StatusTextMonitorView.h \
     ui/gui/ToggleWidgetOpenAction.h
+}
 
 TARGET = polyworld
 
@@ -56,9 +72,9 @@ DEPENDPATH += $$PWD/../library
 
 win32: LIBS += -lgsl
 
-win32: LIBS += -lglu32
+win32:!headless: LIBS += -lglu32
 
-win32: LIBS += -lopengl32
+win32:!headless: LIBS += -lopengl32
 
 win32: LIBS += -lws2_32
 
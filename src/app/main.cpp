@@ -10,22 +10,31 @@
 // STL
 #include <string>
 
+#if PW_HEADLESS
+#include <QCoreApplication>
+#else
 #include <qgl.h>
 #include <QApplication>
+#endif
 
+#include "BatchRunner.h"
 #include "monitor/Monitor.h"
 #include "monitor/MonitorManager.h"
 #include "proplib/proplib.h"
+#include "sim/Scheduler.h"
 #include "sim/Simulation.h"
 #include "ui/SimulationController.h"
+#include "ui/term/TerminalUI.h"
+#if !PW_HEADLESS
 #include "ui/gui/MainWindow.h"
-//#include "ui/term/TerminalUI.h"
+#endif
 
 //===========================================================================
 // usage
 //===========================================================================
 void usage(const char* format, ...) {
-    printf( "Usage:  Polyworld [--ui gui|term] [--key value]... worldfile\n" );
+    printf( "Usage:  Polyworld [--ui gui|term] [--threads N] [--key value]... worldfile\n" );
+    printf( "        Polyworld --batch overlays.wfo [--jobs N] [--threads N] [--key value]... worldfile\n" );
     if (format) {
         printf("Error:\n\t");
         va_list argv;
@@ -45,6 +54,9 @@ int main(int argc, char *argv[]) {
 
     const char *worldfilePath = NULL;
     std::string ui = "gui";
+    std::string batchPath;
+    int jobs = 0;
+    int threads = 0;
     proplib::ParameterMap parameters;
 
     for( int argi = 1; argi < argc; argi++ )
@@ -63,6 +75,12 @@ int main(int argc, char *argv[]) {
             std::string value( argv[argi] );
             if( key == "ui" )
                 ui = value;
+            else if( key == "batch" )
+                batchPath = value;
+            else if( key == "jobs" )
+                jobs = atoi( value.c_str() );
+            else if( key == "threads" )
+                threads = atoi( value.c_str() );
             else {
                 parameters[key] = value;
             }
@@ -76,7 +94,11 @@ int main(int argc, char *argv[]) {
         }
     }
 
-    if( (ui != "gui") )
+#if PW_HEADLESS
+    if( ui == "gui" )
+        ui = "term";
+#endif
+    if( (ui != "gui") && (ui != "term") )
     {
         usage( "Invalid --ui arg (%s)", ui.c_str() );
     }
@@ -120,12 +142,27 @@ int main(int argc, char *argv[]) {
     }
 #endif
 
+    if( !batchPath.empty() )
+    {
+        BatchRunner batch( worldfilePath, parameters, batchPath );
+        batch.setMaxJobs( jobs );
+        batch.setThreadsPerJob( threads );
+        batch.run( argc, argv );
+        return 0;
+    }
+
+#if PW_HEADLESS
+    QCoreApplication app(argc, argv);
+#else
+    // The terminal UI needs this too, since agent vision renders into an
+    // offscreen GL buffer.
     QApplication app(argc, argv);
 
     if (!QGLFormat::hasOpenGL()) {
         qWarning("This system has no OpenGL support. Exiting.");
         return -1;
     }
+#endif
 
     // Establish how our preference settings file will be named
     QCoreApplication::setOrganizationDomain( "indiana.edu" );
@@ -138,6 +175,9 @@ int main(int argc, char *argv[]) {
 
     proplib::Interpreter::init();
 
+    if( threads > 0 )
+        Scheduler::setThreadCount( threads );
+
     TSimulation *simulation = new TSimulation( worldfilePath, parameters );
 
     MonitorManager *monitorManager = new MonitorManager(simulation, monitorPath);
@@ -149,9 +189,14 @@ int main(int argc, char *argv[]) {
     int exitval;
     std::function<void()> dispose_ui;
 
-    if (ui == "gui") {
+    if (ui == "term") {
+        TerminalUI *terminalUI = new TerminalUI( simulationController );
+        dispose_ui = [terminalUI]() {delete terminalUI;};
+#if !PW_HEADLESS
+    } else if (ui == "gui") {
         MainWindow *mainWindow = new MainWindow( simulationController );
         dispose_ui = [mainWindow]() {delete mainWindow;};
+#endif
     } else {
         assert( false );
     }
@@ -1,6 +1,6 @@
 #include "SimulationController.h"
 
-#include <QApplication>
+#include <QCoreApplication>
 #include <QTimer>
 
 #include "monitor/MonitorManager.h"
@@ -5,10 +5,10 @@
 
 // Local
 #include "agent/agent.h"
-#include "agent/Retina.h"
 #include "brain/Brain.h"
 #include "monitor/AgentTracker.h"
 #include "monitor/Monitor.h"
+#include "monitor/WorldSnapshot.h"
 
 using namespace std;
 
@@ -94,13 +94,20 @@ void BrainMonitorView::draw()
 
 	if( fAgent != NULL )
 	{
+		BrainMonitor *monitor = (BrainMonitor *)getMonitor();
+		WorldSnapshotBuffer::Ref snapshot = monitor->getSnapshots()->acquire();
+		const WorldSnapshot::TrackedAgent *tracked = snapshot ? snapshot->findTrackedAgent( monitor->getTracker() ) : NULL;
+
 		// Frame and draw the actual vision pixels
-		qglColor( Qt::gray );
-		glRecti( 2*PATCH_WIDTH-1, 0, (2+Brain::config.retinaWidth)*PATCH_WIDTH+1, PATCH_HEIGHT );
-		glPixelZoom( float(PATCH_WIDTH), float(PATCH_HEIGHT) );
-		glRasterPos2i( 2*PATCH_WIDTH, 0 );
-		glDrawPixels( Brain::config.retinaWidth, 1, GL_RGBA, GL_UNSIGNED_BYTE, fAgent->GetRetina()->getBuffer() );
-		glPixelZoom( 1.0, 1.0 );
+		if( tracked != NULL )
+		{
+			qglColor( Qt::gray );
+			glRecti( 2*PATCH_WIDTH-1, 0, (2+Brain::config().retinaWidth)*PATCH_WIDTH+1, PATCH_HEIGHT );
+			glPixelZoom( float(PATCH_WIDTH), float(PATCH_HEIGHT) );
+			glRasterPos2i( 2*PATCH_WIDTH, 0 );
+			glDrawPixels( Brain::config().retinaWidth, 1, GL_RGBA, GL_UNSIGNED_BYTE, tracked->retina.data() );
+			glPixelZoom( 1.0, 1.0 );
+		}
 
 		// Render brain
 		fAgent->GetBrain()->getRenderer()->render( PATCH_WIDTH, PATCH_HEIGHT );
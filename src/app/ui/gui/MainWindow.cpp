@@ -143,6 +143,7 @@ void MainWindow::createMonitorViews()
 			}
 			break;
 		case Monitor::FARM:
+		case Monitor::METRICS:
 			{
 				// no-op
 			}
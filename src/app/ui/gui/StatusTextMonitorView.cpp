@@ -105,7 +105,7 @@ void StatusTextMonitorView::draw()
 
 	itfor( StatusText, statusText, iter )
 	{
-		renderText( 7, y, *iter, font );
+		renderText( 7, y, iter->c_str(), font );
 		y += lineHeight;
 	}
 
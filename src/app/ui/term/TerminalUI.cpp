@@ -0,0 +1,102 @@
+#include "TerminalUI.h"
+
+#include <ctype.h>
+#include <signal.h>
+#include <stdio.h>
+
+#include <string>
+
+#include "monitor/Monitor.h"
+#include "monitor/MonitorManager.h"
+#include "sim/Profiler.h"
+#include "sim/Simulation.h"
+#include "ui/SimulationController.h"
+#include "utils/misc.h"
+
+static volatile sig_atomic_t interrupted = 0;
+
+static void handleInterrupt( int sig )
+{
+    interrupted = 1;
+    signal( sig, SIG_DFL );
+}
+
+//===========================================================================
+// TerminalUI
+//===========================================================================
+
+//---------------------------------------------------------------------------
+// TerminalUI::TerminalUI
+//---------------------------------------------------------------------------
+TerminalUI::TerminalUI( SimulationController *simulationController_ )
+    : simulationController( simulationController_ )
+    , simulation( simulationController_->getSimulation() )
+{
+    citfor( Monitors, simulationController->getMonitorManager()->getMonitors(), it )
+    {
+        if( (*it)->getType() == Monitor::STATUS_TEXT )
+        {
+            StatusTextMonitor *monitor = dynamic_cast<StatusTextMonitor *>( *it );
+            monitor->update += [=]() { printStatus( monitor->getStatus() ); };
+        }
+    }
+
+    simulation->stepEnding += [=]() { checkInterrupt(); };
+
+    signal( SIGINT, handleInterrupt );
+    signal( SIGTERM, handleInterrupt );
+}
+
+//---------------------------------------------------------------------------
+// TerminalUI::~TerminalUI
+//---------------------------------------------------------------------------
+TerminalUI::~TerminalUI()
+{
+    signal( SIGINT, SIG_DFL );
+    signal( SIGTERM, SIG_DFL );
+}
+
+//---------------------------------------------------------------------------
+// TerminalUI::printStatus
+//---------------------------------------------------------------------------
+void TerminalUI::printStatus( const StatusSnapshot &status )
+{
+    printf( "status step=%ld agents=%ld food=%d born=%ld created=%ld sps=%.1f sps_overall=%.1f",
+            status.step,
+            status.agents,
+            status.food,
+            status.born,
+            status.created,
+            status.framesPerSecondRecent,
+            status.framesPerSecondOverall );
+
+    // With RecordTiming, the mean milliseconds per step of each phase over
+    // the last timing interval, e.g. t_vision=1.25.
+    if( status.profiled )
+    {
+        for( int i = 0; i < Profiler::__NPHASES; i++ )
+        {
+            std::string name = Profiler::getName( (Profiler::Phase)i );
+            for( char &c : name )
+                c = tolower( c );
+            printf( " t_%s=%.2f", name.c_str(), status.phaseMillis[i] );
+        }
+    }
+
+    printf( "\n" );
+    fflush( stdout );
+}
+
+//---------------------------------------------------------------------------
+// TerminalUI::checkInterrupt
+//---------------------------------------------------------------------------
+void TerminalUI::checkInterrupt()
+{
+    if( interrupted )
+    {
+        interrupted = 0;
+        // Ending from within the step would post SimEnd before this step's
+        // remaining events, so stop at the start of the next one instead.
+        simulationController->end( simulation->getStep() );
+    }
+}
@@ -0,0 +1,27 @@
+#pragma once
+
+//===========================================================================
+// TerminalUI
+//
+// Front end for --ui term. Prints one machine-readable status line to stdout
+// every StatusText FrequencyDisplay steps (see etc/term.mf), e.g.
+//
+//   status step=100 agents=182 food=411 born=57 created=20 sps=41.3 sps_overall=38.9
+//
+// SIGINT/SIGTERM end the simulation at the next step boundary, so logs are
+// closed normally; a second signal kills the process.
+//===========================================================================
+
+class TerminalUI
+{
+ public:
+    TerminalUI( class SimulationController *simulationController );
+    ~TerminalUI();
+
+ private:
+    void printStatus( const struct StatusSnapshot &status );
+    void checkInterrupt();
+
+    class SimulationController *simulationController;
+    class TSimulation *simulation;
+};
@@ -3,22 +3,45 @@
 #include <assert.h>
 
 #include "agent.h"
+#include "sim/SimulationContext.h"
 
 //===========================================================================
 // AgentAttachedData
 //===========================================================================
 
-bool AgentAttachedData::allocatedAgent = false;
-unsigned int AgentAttachedData::nslots = 0;
+namespace
+{
+	struct Slots
+	{
+		bool allocatedAgent = false;
+		unsigned int nslots = 0;
+	};
+}
+
+//---------------------------------------------------------------------------
+// AgentAttachedData::allocatedAgent
+//---------------------------------------------------------------------------
+bool &AgentAttachedData::allocatedAgent()
+{
+	return SimulationContext::current()->get<Slots>().allocatedAgent;
+}
+
+//---------------------------------------------------------------------------
+// AgentAttachedData::nslots
+//---------------------------------------------------------------------------
+unsigned int &AgentAttachedData::nslots()
+{
+	return SimulationContext::current()->get<Slots>().nslots;
+}
 
 //---------------------------------------------------------------------------
 // AgentAttachedData::createSlot
 //---------------------------------------------------------------------------
 AgentAttachedData::SlotHandle AgentAttachedData::createSlot()
 {
-	assert( !allocatedAgent );
+	assert( !allocatedAgent() );
 
-	return nslots++;
+	return nslots()++;
 }
 
 //---------------------------------------------------------------------------
@@ -26,9 +49,19 @@ AgentAttachedData::SlotHandle AgentAttachedData::createSlot()
 //---------------------------------------------------------------------------
 void AgentAttachedData::alloc( agent *a )
 {
-	allocatedAgent = true;
-	a->attachedData = new SlotData[ nslots ];
-	memset( a->attachedData, 0, sizeof(SlotData) * nslots );
+	allocatedAgent() = true;
+	a->attachedData = new SlotData[ nslots() ];
+	memset( a->attachedData, 0, sizeof(SlotData) * nslots() );
+}
+
+//---------------------------------------------------------------------------
+// AgentAttachedData::clear
+//
+// Empties the slots of an agent constructed over a recycled one's data.
+//---------------------------------------------------------------------------
+void AgentAttachedData::clear( agent *a )
+{
+	memset( a->attachedData, 0, sizeof(SlotData) * nslots() );
 }
 
 //---------------------------------------------------------------------------
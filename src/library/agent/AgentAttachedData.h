@@ -17,12 +17,14 @@ class LIBRARY_SHARED AgentAttachedData
 	static SlotHandle createSlot();
 
 	static void alloc( class agent *a );
+	static void clear( class agent *a );
 	static void dispose( class agent *a );
 
 	static void set( class agent *a, SlotHandle handle, SlotData data );
 	static SlotData get( class agent *a, SlotHandle handle );
 
  private:
-	static bool allocatedAgent;
-	static unsigned int nslots;
+	// Slots are created by each simulation's own loggers and renderers.
+	static bool &allocatedAgent();
+	static unsigned int &nslots();
 };
@@ -39,7 +39,7 @@ void MateWaitSensor::sensor_update( bool print )
 	float activation = 1.0 - float(age - lastMate) / mateWait;
 
     activation = pwclamp( activation, 0, 1 );
-	if(agent::config.invertMateWaitFeedback)
+	if(agent::config().invertMateWaitFeedback)
 	{
 		activation = 1.0 - activation;
 	}
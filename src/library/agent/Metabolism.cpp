@@ -1,8 +1,38 @@
 
 #include "Metabolism.h"
 
-std::vector<Metabolism *> Metabolism::metabolisms;
-Metabolism::SelectionMode Metabolism::selectionMode;
+#include "sim/SimulationContext.h"
+
+// Defined by each simulation's worldfile.
+namespace
+{
+	struct Metabolisms
+	{
+		std::vector<Metabolism *> metabolisms;
+		Metabolism::SelectionMode selectionMode;
+
+		~Metabolisms()
+		{
+			for( Metabolism *metabolism : metabolisms )
+				delete metabolism;
+		}
+	};
+
+	Metabolisms &metabolisms()
+	{
+		return SimulationContext::current()->get<Metabolisms>();
+	}
+}
+
+std::vector<Metabolism *> &Metabolism::metabolisms()
+{
+	return ::metabolisms().metabolisms;
+}
+
+Metabolism::SelectionMode &Metabolism::selectionMode()
+{
+	return ::metabolisms().selectionMode;
+}
 
 Metabolism::Metabolism(int index_,
                        const std::string &name_,
@@ -28,20 +58,20 @@ void Metabolism::define( const std::string &name,
 						 float minEatAge,
 						 const FoodType *carcassFoodType )
 {
-	Metabolism *metabolism = new Metabolism( metabolisms.size(),
+	Metabolism *metabolism = new Metabolism( metabolisms().size(),
 											 name,
 											 energyPolarity,
 											 eatMultiplier,
 											 energyDelta,
 											 minEatAge,
 											 carcassFoodType );
-    metabolisms.push_back(metabolism);
+    metabolisms().push_back(metabolism);
 }
 
 int Metabolism::getNumberOfDefinitions() {
-	return metabolisms.size();
+	return metabolisms().size();
 }
 
 Metabolism LIBRARY_SHARED *Metabolism::get(int index) {
-    return metabolisms[index];
+    return metabolisms()[index];
 }
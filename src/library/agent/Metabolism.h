@@ -22,7 +22,7 @@ public:
 		Random
 	};
 
-	static SelectionMode selectionMode;
+	static SelectionMode &selectionMode();
 
 	const int index;
 	const std::string name;
@@ -41,5 +41,5 @@ private:
                float _minEatAge,
                const FoodType *_carcassFoodType);
 
-	static std::vector<Metabolism *> metabolisms;
+	static std::vector<Metabolism *> &metabolisms();
 };
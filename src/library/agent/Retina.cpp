@@ -3,6 +3,7 @@
 #include <gl.h>
 #include <stdio.h>
 #include <stdlib.h>
+#include <string.h>
 
 #include "brain/Brain.h"
 #include "brain/NervousSystem.h"
@@ -35,6 +36,15 @@ Retina::~Retina()
 	free( buf );
 }
 
+void Retina::clear()
+{
+	memset( buf, 0, width * 4 );
+
+#if PrintBrain
+	bprinted = false;
+#endif
+}
+
 void Retina::sensor_grow( NervousSystem *cns )
 {
 	channels[0].init( this, cns, 0, "Red" );
@@ -71,19 +81,19 @@ void Retina::sensor_update( bool bprint )
 
 	IF_BPRINT
 	(
-        printf("***** step = %ld ******\n", TSimulation::fStep);
-        printf("retinaBuf [0 - %d]\n",(Brain::config.retinaWidth - 1));
+        printf("***** step = %ld ******\n", SimulationContext::current()->simulation->getStep());
+        printf("retinaBuf [0 - %d]\n",(Brain::config().retinaWidth - 1));
         printf("red:");
         
-        for( int i = 0; i < (Brain::config.retinaWidth * 4); i+=4 )
+        for( int i = 0; i < (Brain::config().retinaWidth * 4); i+=4 )
             printf(" %3d", buf[i]);
         printf("\ngreen:");
         
-        for( int i = 1; i < (Brain::config.retinaWidth * 4); i+=4 )
+        for( int i = 1; i < (Brain::config().retinaWidth * 4); i+=4 )
             printf(" %3d",buf[i]);
         printf("\nblue:");
         
-        for( int i = 2; i < (Brain::config.retinaWidth * 4); i+=4 )
+        for( int i = 2; i < (Brain::config().retinaWidth * 4); i+=4 )
             printf(" %3d", buf[i]);
         printf("\n");		
 	)
@@ -113,6 +123,7 @@ void Retina::updateBuffer( short x, short y,
 	// DrawAgentPOV() call above and the glReadPixels()
 	// call below.  It is set in TSimulation::Step().
 			
+#if !PW_HEADLESS
 	glReadPixels(x,
 				 y + height / 2,
 				 width,
@@ -122,6 +133,7 @@ void Retina::updateBuffer( short x, short y,
 				 buf);
 
 	debugcheck( "after glReadPixels" );
+#endif
 
 #if 0
 	static FILE* pixelFile = NULL;
@@ -14,6 +14,9 @@ class LIBRARY_SHARED Retina : public Sensor
 	Retina( int width );
 	virtual ~Retina();
 
+	// Back to the state of a new Retina, for a recycled agent.
+	void clear();
+
 	virtual void sensor_grow( NervousSystem *cns );
 	virtual void sensor_prebirth_signal( RandomNumberGenerator *rng );
 	virtual void sensor_update( bool print );
@@ -37,7 +37,7 @@ void RqSensor::sensor_update( bool print )
 		for( int i = 0; i < neuronCount; i++ )
 		{
 			#if GaussianRq
-				nerve->set( i, logistic( rng->nrand(), Brain::config.logisticSlope ) );
+				nerve->set( i, logistic( rng->nrand(), Brain::config().logisticSlope ) );
 			#else
 				nerve->set( i, rng->drand() );
 			#endif
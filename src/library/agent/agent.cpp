@@ -9,6 +9,7 @@
 // System
 #include <gl.h>
 #include <limits.h>
+#include <new>
 #include <string.h>
 
 // Local
@@ -32,10 +33,12 @@
 #include "sim/debug.h"
 #include "sim/globals.h"
 #include "sim/Simulation.h"
+#include "sim/SimulationContext.h"
 #include "utils/AbstractFile.h"
 #include "utils/datalib.h"
 #include "utils/graybin.h"
 #include "utils/misc.h"
+#include "utils/PositionSnapshot.h"
 #include "utils/RandomNumberGenerator.h"
 #include "utils/Resources.h"
 
@@ -48,157 +51,233 @@ using namespace genome;
 
 #define DirectYaw 0
 
+//---------------------------------------------------------------------------
+// renew
+//
+// Constructs *p again in its own storage, or allocates it the first time.
+//---------------------------------------------------------------------------
+template<typename T, typename... Args>
+static T *renew( T *&p, Args... args )
+{
+	if( p )
+	{
+		p->~T();
+		new (p) T( args... );
+	}
+	else
+	{
+		p = new T( args... );
+	}
+
+	return p;
+}
+
 #ifdef CORE_UTILS
 #define UTILS_PATH CORE_UTILS"\\"
 #else
 #define UTILS_PATH ""
 #endif
 
-// Agent globals
-bool		agent::gClassInited;
-unsigned long	agent::agentsEver;
-long		agent::agentsliving;
-gpolyobj*	agent::agentobj;
-bool agent::fSeedSynapsesFromFile;
-std::vector<std::string> agent::fSeedSynapseFilePaths;
-bool agent::fFreezeSeededSynapses;
+// Agent globals, kept per simulation
+namespace
+{
+	struct AgentGlobals
+	{
+		bool		classInited;
+		long		agentsliving;
+		gpolyobj*	agentobj;
+		bool seedSynapsesFromFile;
+		std::vector<std::string> seedSynapseFilePaths;
+		bool freezeSeededSynapses;
+	};
+
+	AgentGlobals &agentGlobals()
+	{
+		return SimulationContext::current()->get<AgentGlobals>();
+	}
+}
+
+bool &agent::gClassInited() { return agentGlobals().classInited; }
+long &agent::agentsliving() { return agentGlobals().agentsliving; }
+gpolyobj* &agent::agentobj() { return agentGlobals().agentobj; }
+bool &agent::fSeedSynapsesFromFile() { return agentGlobals().seedSynapsesFromFile; }
+std::vector<std::string> &agent::fSeedSynapseFilePaths() { return agentGlobals().seedSynapseFilePaths; }
+bool &agent::fFreezeSeededSynapses() { return agentGlobals().freezeSeededSynapses; }
 
-agent::Configuration agent::config;
+//---------------------------------------------------------------------------
+// agent::config
+//---------------------------------------------------------------------------
+agent::Configuration &agent::config()
+{
+	return SimulationContext::current()->get<Configuration>();
+}
+
+//---------------------------------------------------------------------------
+// agent::agentsEver
+//---------------------------------------------------------------------------
+unsigned long &agent::agentsEver()
+{
+	return SimulationContext::current()->agentsEver;
+}
+
+//---------------------------------------------------------------------------
+// agent::agentsAllocated
+//---------------------------------------------------------------------------
+unsigned long &agent::agentsAllocated()
+{
+	return SimulationContext::current()->agentsAllocated;
+}
+
+//---------------------------------------------------------------------------
+// agent::getAgentsAllocated
+//---------------------------------------------------------------------------
+unsigned long agent::getAgentsAllocated()
+{
+	return agentsAllocated();
+}
+
+//---------------------------------------------------------------------------
+// agent::freeAgents
+//---------------------------------------------------------------------------
+std::vector<agent*> &agent::freeAgents()
+{
+	return SimulationContext::current()->freeAgents;
+}
 
 //---------------------------------------------------------------------------
 // agent::processWorldfile
 //---------------------------------------------------------------------------
 void agent::processWorldfile( proplib::Document &doc )
 {
-    agent::fSeedSynapsesFromFile = doc.get( "SeedSynapsesFromRun" );
-    if( agent::fSeedSynapsesFromFile )
+    agent::fSeedSynapsesFromFile() = doc.get( "SeedSynapsesFromRun" );
+    if( agent::fSeedSynapsesFromFile() )
     {
         ReadSeedSynapseFilePaths();
     }
-    agent::fFreezeSeededSynapses = doc.get( "FreezeSeededSynapses" );
-
-    agent::config.agentHeight = doc.get( "AgentHeight" );
-	agent::config.vision = doc.get( "Vision" );
-	agent::config.maxVelocity = doc.get( "MaxVelocity" );
-	agent::config.maxCarries = doc.get( "MaxCarries" );
-	agent::config.minVisionPitch = doc.get( "MinVisionPitch" );
-	agent::config.maxVisionPitch = doc.get( "MaxVisionPitch" );
-	agent::config.minVisionYaw = doc.get( "MinVisionYaw" );
-	agent::config.maxVisionYaw = doc.get( "MaxVisionYaw" );
-	agent::config.eyeHeight = doc.get( "EyeHeight" );
-    agent::config.initMateWait = doc.get( "InitMateWait" );
-    agent::config.randomSeedMateWait = doc.get( "RandomSeedMateWait" );
-    agent::config.minAgentSize = doc.get( "MinAgentSize" );
-    agent::config.maxAgentSize = doc.get( "MaxAgentSize" );
-    agent::config.minLifeSpan = doc.get( "MinLifeSpan" );
-    agent::config.maxLifeSpan = doc.get( "MaxLifeSpan" );
-    agent::config.minStrength = doc.get( "MinAgentStrength" );
-    agent::config.maxStrength = doc.get( "MaxAgentStrength" );
-    agent::config.minmaxspeed = doc.get( "MinAgentMaxSpeed" );
-    agent::config.maxmaxspeed = doc.get( "MaxAgentMaxSpeed" );
-    agent::config.minmateenergy = doc.get( "MinEnergyFractionToOffspring" );
-    agent::config.maxmateenergy = doc.get( "MaxEnergyFractionToOffspring" );
-    agent::config.minMaxEnergy = doc.get( "MinAgentMaxEnergy" );
-    agent::config.maxMaxEnergy = doc.get( "MaxAgentMaxEnergy" );
-    agent::config.speed2DPosition = doc.get( "MotionRate" );
-    agent::config.yaw2DYaw = doc.get( "YawRate" );
+    agent::fFreezeSeededSynapses() = doc.get( "FreezeSeededSynapses" );
+
+    agent::config().agentHeight = doc.get( "AgentHeight" );
+	agent::config().vision = doc.get( "Vision" );
+	agent::config().maxVelocity = doc.get( "MaxVelocity" );
+	agent::config().maxCarries = doc.get( "MaxCarries" );
+	agent::config().minVisionPitch = doc.get( "MinVisionPitch" );
+	agent::config().maxVisionPitch = doc.get( "MaxVisionPitch" );
+	agent::config().minVisionYaw = doc.get( "MinVisionYaw" );
+	agent::config().maxVisionYaw = doc.get( "MaxVisionYaw" );
+	agent::config().eyeHeight = doc.get( "EyeHeight" );
+    agent::config().initMateWait = doc.get( "InitMateWait" );
+    agent::config().randomSeedMateWait = doc.get( "RandomSeedMateWait" );
+    agent::config().minAgentSize = doc.get( "MinAgentSize" );
+    agent::config().maxAgentSize = doc.get( "MaxAgentSize" );
+    agent::config().minLifeSpan = doc.get( "MinLifeSpan" );
+    agent::config().maxLifeSpan = doc.get( "MaxLifeSpan" );
+    agent::config().minStrength = doc.get( "MinAgentStrength" );
+    agent::config().maxStrength = doc.get( "MaxAgentStrength" );
+    agent::config().minmaxspeed = doc.get( "MinAgentMaxSpeed" );
+    agent::config().maxmaxspeed = doc.get( "MaxAgentMaxSpeed" );
+    agent::config().minmateenergy = doc.get( "MinEnergyFractionToOffspring" );
+    agent::config().maxmateenergy = doc.get( "MaxEnergyFractionToOffspring" );
+    agent::config().minMaxEnergy = doc.get( "MinAgentMaxEnergy" );
+    agent::config().maxMaxEnergy = doc.get( "MaxAgentMaxEnergy" );
+    agent::config().speed2DPosition = doc.get( "MotionRate" );
+    agent::config().yaw2DYaw = doc.get( "YawRate" );
 	{
         std::string encoding = doc.get( "YawEncoding" );
 		if( encoding == "Oppose" )
-			agent::config.yawEncoding = agent::YE_OPPOSE;
+			agent::config().yawEncoding = agent::YE_OPPOSE;
 		else if( encoding == "Squash" )
-			agent::config.yawEncoding = agent::YE_SQUASH;
+			agent::config().yawEncoding = agent::YE_SQUASH;
 		else
 			assert( false );
 	}
-    agent::config.minFocus = doc.get( "MinHorizontalFieldOfView" );
-    agent::config.maxFocus = doc.get( "MaxHorizontalFieldOfView" );
-    agent::config.agentFOV = doc.get( "VerticalFieldOfView" );
-    agent::config.maxSizeAdvantage = doc.get( "MaxSizeFightAdvantage" );
+    agent::config().minFocus = doc.get( "MinHorizontalFieldOfView" );
+    agent::config().maxFocus = doc.get( "MaxHorizontalFieldOfView" );
+    agent::config().agentFOV = doc.get( "VerticalFieldOfView" );
+    agent::config().maxSizeAdvantage = doc.get( "MaxSizeFightAdvantage" );
 	{
 		proplib::Property &prop = doc.get( "BodyRedChannel" );
         if( (std::string)prop == "Fight" )
-			agent::config.bodyRedChannel = agent::BRC_FIGHT;
+			agent::config().bodyRedChannel = agent::BRC_FIGHT;
         else if( (std::string)prop == "Give" )
-			agent::config.bodyRedChannel = agent::BRC_GIVE;
+			agent::config().bodyRedChannel = agent::BRC_GIVE;
 		else
 		{
-			agent::config.bodyRedChannel = agent::BRC_CONST;
-			agent::config.bodyRedChannelConstValue = (float)prop;
+			agent::config().bodyRedChannel = agent::BRC_CONST;
+			agent::config().bodyRedChannelConstValue = (float)prop;
 		}
 	}
 	{
 		proplib::Property &prop = doc.get( "BodyGreenChannel" );
         if( (std::string)prop == "I" )
-			agent::config.bodyGreenChannel = agent::BGC_ID;
+			agent::config().bodyGreenChannel = agent::BGC_ID;
         else if( (std::string)prop == "L" )
-			agent::config.bodyGreenChannel = agent::BGC_LIGHT;
+			agent::config().bodyGreenChannel = agent::BGC_LIGHT;
         else if( (std::string)prop == "E" )
-			agent::config.bodyGreenChannel = agent::BGC_EAT;
+			agent::config().bodyGreenChannel = agent::BGC_EAT;
         else if( (std::string)prop == "F" )
-			agent::config.bodyGreenChannel = agent::BGC_FOOD;
+			agent::config().bodyGreenChannel = agent::BGC_FOOD;
 		else
 		{
-			agent::config.bodyGreenChannel = agent::BGC_CONST;
-			agent::config.bodyGreenChannelConstValue = (float)prop;
+			agent::config().bodyGreenChannel = agent::BGC_CONST;
+			agent::config().bodyGreenChannelConstValue = (float)prop;
 		}
 	}
 	{
 		proplib::Property &prop = doc.get( "BodyBlueChannel" );
         if( (std::string)prop == "Mate" )
-			agent::config.bodyBlueChannel = agent::BBC_MATE;
+			agent::config().bodyBlueChannel = agent::BBC_MATE;
         else if( (std::string) prop == "Energy" )
-			agent::config.bodyBlueChannel = agent::BBC_ENERGY;
+			agent::config().bodyBlueChannel = agent::BBC_ENERGY;
 		else
 		{
-			agent::config.bodyBlueChannel = agent::BBC_CONST;
-			agent::config.bodyBlueChannelConstValue = (float)prop;
+			agent::config().bodyBlueChannel = agent::BBC_CONST;
+			agent::config().bodyBlueChannelConstValue = (float)prop;
 		}
 	}
 	{
 		proplib::Property &prop = doc.get( "NoseColor" );
         if( (std::string)prop == "L" )
-			agent::config.noseColor = agent::NC_LIGHT;
+			agent::config().noseColor = agent::NC_LIGHT;
         else if( (std::string)prop == "B" )
-			agent::config.noseColor = agent::NC_BODY;
+			agent::config().noseColor = agent::NC_BODY;
 		else
 		{
-			agent::config.noseColor = agent::NC_CONST;
-			agent::config.noseColorConstValue = (float)prop;
+			agent::config().noseColor = agent::NC_CONST;
+			agent::config().noseColorConstValue = (float)prop;
 		}
 	}
-    agent::config.hasLightBehavior = agent::config.bodyGreenChannel == agent::BGC_LIGHT || agent::config.noseColor == agent::NC_LIGHT;
-    agent::config.maxSeedEnergy = doc.get( "MaxSeedEnergy" );
-    agent::config.randomSeedEnergy = doc.get( "RandomSeedEnergy" );
-    agent::config.energyUseMultiplier = doc.get( "EnergyUseMultiplier" );
-    agent::config.ageEnergyMultiplier = doc.get( "AgeEnergyMultiplier" );
-    agent::config.dieAtMaxAge = doc.get( "DieAtMaxAge" );
-    agent::config.starvationEnergyFraction = doc.get( "StarvationEnergyFraction" );
-    agent::config.starvationWait = doc.get( "StarvationWait" );
-    agent::config.eat2Energy = doc.get( "EnergyUseEat" );
-	agent::config.mate2Energy = doc.get( "EnergyUseMate" );
-    agent::config.fight2Energy = doc.get( "EnergyUseFight" );
-    agent::config.give2Energy = doc.get( "EnergyUseGive" );
-	agent::config.minSizePenalty = doc.get( "MinSizeEnergyPenalty" );
-    agent::config.maxSizePenalty = doc.get( "MaxSizeEnergyPenalty" );
-    agent::config.speed2Energy = doc.get( "EnergyUseMove" );
-    agent::config.yaw2Energy = doc.get( "EnergyUseTurn" );
-    agent::config.light2Energy = doc.get( "EnergyUseLight" );
-    agent::config.focus2Energy = doc.get( "EnergyUseFocus" );
-	agent::config.pickup2Energy = doc.get( "EnergyUsePickup" );
-	agent::config.drop2Energy = doc.get( "EnergyUseDrop" );
-	agent::config.carryAgent2Energy = doc.get( "EnergyUseCarryAgent" );
-	agent::config.carryAgentSize2Energy = doc.get( "EnergyUseCarryAgentSize" );
-    agent::config.fixedEnergyDrain = doc.get( "EnergyUseFixed" );
-
-	agent::config.enableMateWaitFeedback = doc.get( "EnableMateWaitFeedback" );
-	agent::config.invertMateWaitFeedback = doc.get( "InvertMateWaitFeedback" );
-	agent::config.enableSpeedFeedback = doc.get( "EnableSpeedFeedback" );
-	agent::config.enableGive = doc.get( "EnableGive" );
-	agent::config.enableCarry = doc.get( "EnableCarry" );
-	agent::config.invertFocus = doc.get( "InvertFocus" );
-	agent::config.enableVisionPitch = doc.get( "EnableVisionPitch" );
-	agent::config.enableVisionYaw = doc.get( "EnableVisionYaw" );
+    agent::config().hasLightBehavior = agent::config().bodyGreenChannel == agent::BGC_LIGHT || agent::config().noseColor == agent::NC_LIGHT;
+    agent::config().maxSeedEnergy = doc.get( "MaxSeedEnergy" );
+    agent::config().randomSeedEnergy = doc.get( "RandomSeedEnergy" );
+    agent::config().energyUseMultiplier = doc.get( "EnergyUseMultiplier" );
+    agent::config().ageEnergyMultiplier = doc.get( "AgeEnergyMultiplier" );
+    agent::config().dieAtMaxAge = doc.get( "DieAtMaxAge" );
+    agent::config().starvationEnergyFraction = doc.get( "StarvationEnergyFraction" );
+    agent::config().starvationWait = doc.get( "StarvationWait" );
+    agent::config().eat2Energy = doc.get( "EnergyUseEat" );
+	agent::config().mate2Energy = doc.get( "EnergyUseMate" );
+    agent::config().fight2Energy = doc.get( "EnergyUseFight" );
+    agent::config().give2Energy = doc.get( "EnergyUseGive" );
+	agent::config().minSizePenalty = doc.get( "MinSizeEnergyPenalty" );
+    agent::config().maxSizePenalty = doc.get( "MaxSizeEnergyPenalty" );
+    agent::config().speed2Energy = doc.get( "EnergyUseMove" );
+    agent::config().yaw2Energy = doc.get( "EnergyUseTurn" );
+    agent::config().light2Energy = doc.get( "EnergyUseLight" );
+    agent::config().focus2Energy = doc.get( "EnergyUseFocus" );
+	agent::config().pickup2Energy = doc.get( "EnergyUsePickup" );
+	agent::config().drop2Energy = doc.get( "EnergyUseDrop" );
+	agent::config().carryAgent2Energy = doc.get( "EnergyUseCarryAgent" );
+	agent::config().carryAgentSize2Energy = doc.get( "EnergyUseCarryAgentSize" );
+    agent::config().fixedEnergyDrain = doc.get( "EnergyUseFixed" );
+
+	agent::config().enableMateWaitFeedback = doc.get( "EnableMateWaitFeedback" );
+	agent::config().invertMateWaitFeedback = doc.get( "InvertMateWaitFeedback" );
+	agent::config().enableSpeedFeedback = doc.get( "EnableSpeedFeedback" );
+	agent::config().enableGive = doc.get( "EnableGive" );
+	agent::config().enableCarry = doc.get( "EnableCarry" );
+	agent::config().invertFocus = doc.get( "InvertFocus" );
+	agent::config().enableVisionPitch = doc.get( "EnableVisionPitch" );
+	agent::config().enableVisionYaw = doc.get( "EnableVisionYaw" );
 }
 
 //---------------------------------------------------------------------------
@@ -214,8 +293,8 @@ void agent::ReadSeedSynapseFilePaths()
 		exit( 1 );
 	}
 
-    makeDirs("run/brain");
-    SYSTEM(UTILS_PATH "cp synapseSeeds.txt run/brain" );
+    makeDirs( SimulationContext::runPath("brain") );
+    SYSTEM( (UTILS_PATH "cp synapseSeeds.txt " + SimulationContext::runPath("brain")).c_str() );
 
 	char buf[1024 * 4];
 	while( !in.eof() )
@@ -224,11 +303,11 @@ void agent::ReadSeedSynapseFilePaths()
 
 		if( strlen(buf) )
 		{
-            fSeedSynapseFilePaths.push_back( std::string(buf) );
+            fSeedSynapseFilePaths().push_back( std::string(buf) );
 		}
 	}
 
-	if( fSeedSynapseFilePaths.size() == 0 )
+	if( fSeedSynapseFilePaths().size() == 0 )
 	{
         std::cerr << "synapseSeeds.txt is empty!" << std::endl;
 		exit( 1 );
@@ -239,6 +318,18 @@ void agent::ReadSeedSynapseFilePaths()
 // agent::agent
 //---------------------------------------------------------------------------
 agent::agent(TSimulation* sim, gstage* stage)
+	:	agent(sim, stage, NULL)
+{
+}
+
+
+//---------------------------------------------------------------------------
+// agent::agent
+//
+// With parts, takes over the heap state of a recycled agent instead of
+// allocating it, which leaves the new agent as it would be from scratch.
+//---------------------------------------------------------------------------
+agent::agent(TSimulation* sim, gstage* stage, RecycledParts* parts)
 	:	fSimulation(sim),
 		fAlive(false), 		// must grow() to be truly alive
     	fDeathByPatch(false),
@@ -255,12 +346,20 @@ agent::agent(TSimulation* sim, gstage* stage)
 		fCarryingSensor(NULL),
 		fBeingCarriedSensor(NULL)
 {
-	AgentAttachedData::alloc( this );
+	if( parts )
+	{
+		attachedData = parts->attachedData;
+		AgentAttachedData::clear( this );
+	}
+	else
+	{
+		AgentAttachedData::alloc( this );
+	}
 
 	/* Set object type to be AGENTTYPE */
 	setType(AGENTTYPE);
 
-	if (!gClassInited)
+	if (!gClassInited())
 		agentinit();
 
 	fLastPosition[0] = 0.0;
@@ -282,8 +381,26 @@ agent::agent(TSimulation* sim, gstage* stage)
 	fLastEatEnergy = 0.0;
 	fLastEatEnergyRaw = 0.0;
 
-	fGenome = GenomeUtil::createGenome();
-	fCns = new NervousSystem();
+	if( parts )
+	{
+		fGenome = parts->genome;
+		fCns = parts->cns;
+		fCns->reset();
+		fRetina = parts->retina;
+		fRandomSensor = parts->randomSensor;
+		fEnergySensor = parts->energySensor;
+		fMateWaitSensor = parts->mateWaitSensor;
+		fSpeedSensor = parts->speedSensor;
+		fCarryingSensor = parts->carryingSensor;
+		fBeingCarriedSensor = parts->beingCarriedSensor;
+		fNumPolygons = parts->numPolygons;
+		fPolygon = parts->polygon;
+	}
+	else
+	{
+		fGenome = GenomeUtil::createGenome();
+		fCns = new NervousSystem();
+	}
 	fMetabolism = NULL;
 
 	// Set up agent POV
@@ -319,14 +436,14 @@ agent::~agent()
 //-------------------------------------------------------------------------------------------
 void agent::agentinit()
 {
-    if (agent::gClassInited)
+    if (agent::gClassInited())
         return;
 
-    agent::gClassInited = true;
-    agent::agentsliving = 0;
-    agent::agentobj = new gpolyobj();
-	Resources::loadPolygons( agent::agentobj, "agent" );
-	agent::agentobj->SetName("agentobj");
+    agent::gClassInited() = true;
+    agent::agentsliving() = 0;
+    agent::agentobj() = new gpolyobj();
+	Resources::loadPolygons( agent::agentobj(), "agent" );
+	agent::agentobj()->SetName("agentobj()");
 }
 
 
@@ -337,26 +454,74 @@ void agent::agentinit()
 //-------------------------------------------------------------------------------------------
 void agent::agentdestruct()
 {
-	delete agent::agentobj;
+	itfor( std::vector<agent*>, freeAgents(), it )
+		delete *it;
+	freeAgents().clear();
+
+	delete agent::agentobj();
 }
 
 
 //-------------------------------------------------------------------------------------------
 // agent::getfreeagent
 //
-// Return a newly allocated agent, but enforce the max number of allowed agents
+// Return a new agent, constructed in place of a recycled one when there is one
 //-------------------------------------------------------------------------------------------
 agent* agent::getfreeagent(TSimulation* simulation, gstage* stage)
 {
-	// Create the new agent
-	agent* c = new agent(simulation, stage);
+	agent* c;
+#if DebugBirthAllocations
+	unsigned long allocations = freeAgents().empty() ? ULONG_MAX : DebugAllocationCount();
+#endif
+
+	if( freeAgents().empty() )
+	{
+		c = new agent(simulation, stage);
+		agentsAllocated()++;
+	}
+	else
+	{
+		c = freeAgents().back();
+		freeAgents().pop_back();
+
+		RecycledParts parts = { c->fGenome,
+								c->fCns,
+								c->fRetina,
+								c->fRandomSensor,
+								c->fEnergySensor,
+								c->fMateWaitSensor,
+								c->fSpeedSensor,
+								c->fCarryingSensor,
+								c->fBeingCarriedSensor,
+								c->attachedData,
+								c->fNumPolygons,
+								c->fPolygon };
+		c->fGenome = NULL;
+		c->fCns = NULL;
+		c->fRetina = NULL;
+		c->fRandomSensor = NULL;
+		c->fEnergySensor = NULL;
+		c->fMateWaitSensor = NULL;
+		c->fSpeedSensor = NULL;
+		c->fCarryingSensor = NULL;
+		c->fBeingCarriedSensor = NULL;
+		c->attachedData = NULL;
+		c->fNumPolygons = 0;
+		c->fPolygon = NULL;
+
+		c->~agent();
+		new (c) agent(simulation, stage, &parts);
+	}
+#if DebugBirthAllocations
+	c->fDebugAllocations = allocations;
+#endif
 
     // Increase current total of creatures alive
-    agent::agentsliving++;
+    agent::agentsliving()++;
 
     // Set number to total creatures that have ever lived (note this is 1-based)
-    c->setTypeNumber( ++agent::agentsEver );
-	c->fCns->getRNG()->seedIfLocal( agent::agentsEver );
+    c->setTypeNumber( ++agent::agentsEver() );
+	c->fCns->getRNG()->seedIfLocal( agent::agentsEver() );
 
 	simulation->GetAgentPovRenderer()->add( c );
 
@@ -364,13 +529,27 @@ agent* agent::getfreeagent(TSimulation* simulation, gstage* stage)
 }
 
 
+//-------------------------------------------------------------------------------------------
+// agent::recycle
+//
+// Takes a dead agent, which nothing may refer to any longer. Its genome,
+// nervous system, sensors and attached data serve the next getfreeagent().
+//-------------------------------------------------------------------------------------------
+void agent::recycle(agent* a)
+{
+	assert( !a->fAlive );
+
+	freeAgents().push_back( a );
+}
+
+
 //---------------------------------------------------------------------------
 // agent::agentdump
 //---------------------------------------------------------------------------
 void agent::agentdump(std::ostream& out)
 {
-    out << agent::agentsEver nl;
-    out << agent::agentsliving nl;
+    out << agent::agentsEver() nl;
+    out << agent::agentsliving() nl;
 
 }
 
@@ -382,20 +561,20 @@ void agent::agentload(std::istream&)
 {
     WARN_ONCE("agent::agentload called. Not supported.");
 #if 0
-    in >> agent::agentsEver;
-    in >> agent::agentsliving;
+    in >> agent::agentsEver();
+    in >> agent::agentsliving();
 
     agent::agentlist->load(in);
 
 	long i;
 
-    for (i = 0; i < agent::config.maxNumAgents; i++)
+    for (i = 0; i < agent::config().maxNumAgents; i++)
         if (!agent::pc[i])
             break;
     if (i)
         error(2,"agent::pc[] array not empty during agentload");
 
-    //    if (agent::config.xSortedAgents.count())
+    //    if (agent::config().xSortedAgents.count())
     //        error(2,"gXSortedAgents list not empty during agentload");
     if (allxsortedlist::gXSortedAll.getCount(AGENTTYPE))
         error(2,"gXSortedAll list not empty during agentload");
@@ -410,7 +589,7 @@ void agent::agentload(std::istream&)
         if (agent::agentlist->isone(i))
         {
             (agent::pc[i])->load(in);
-            //agent::pc[i]->listLink = agent::config.xSortedAgents.add(agent::pc[i]);
+            //agent::pc[i]->listLink = agent::config().xSortedAgents.add(agent::pc[i]);
 	    	agent::pc[i]->listLink = allxsortedlist::gXSortedAll.add(agent::pc[i]);
             globals::worldstage.addobject(agent::pc[i]);
         }
@@ -500,7 +679,9 @@ void agent::load(std::istream& in)
 //---------------------------------------------------------------------------
 void agent::setGenomeReady()
 {
-	switch( Metabolism::selectionMode )
+	fGenome->decode();
+
+	switch( Metabolism::selectionMode() )
 	{
 	case Metabolism::Gene:
 		fMetabolism = GenomeUtil::getMetabolism( fGenome );
@@ -529,11 +710,11 @@ void agent::grow( long mateWait, bool seeding )
 #define INPUT_NERVE( NAME ) fCns->createNerve( Nerve::INPUT, NAME )
 	INPUT_NERVE( "Random" );
 	INPUT_NERVE( "Energy" );
-	if( agent::config.enableMateWaitFeedback )
+	if( agent::config().enableMateWaitFeedback )
 		INPUT_NERVE( "MateWaitFeedback" );
-	if( agent::config.enableSpeedFeedback )
+	if( agent::config().enableSpeedFeedback )
 		INPUT_NERVE( "SpeedFeedback" );
-	if( agent::config.enableCarry )
+	if( agent::config().enableCarry )
 	{
 		INPUT_NERVE( "Carrying" );
 		INPUT_NERVE( "BeingCarried" );
@@ -552,18 +733,18 @@ void agent::grow( long mateWait, bool seeding )
 	OUTPUT_NERVE(fight, "Fight");
 	OUTPUT_NERVE(speed, "Speed");
 	OUTPUT_NERVE(yaw, "Yaw");
-	if( agent::config.yawEncoding == YE_OPPOSE )
+	if( agent::config().yawEncoding == YE_OPPOSE )
 		OUTPUT_NERVE(yawOppose, "YawOppose");
-	if( agent::config.hasLightBehavior )
+	if( agent::config().hasLightBehavior )
 		OUTPUT_NERVE(light, "Light");
 	OUTPUT_NERVE(focus, "Focus");
-	if( agent::config.enableVisionPitch )
+	if( agent::config().enableVisionPitch )
 		OUTPUT_NERVE(visionPitch, "VisionPitch");
-	if( agent::config.enableVisionYaw )
+	if( agent::config().enableVisionYaw )
 		OUTPUT_NERVE(visionYaw, "VisionYaw");
-	if( agent::config.enableGive )
+	if( agent::config().enableGive )
 		OUTPUT_NERVE(give, "Give");
-	if( agent::config.enableCarry )
+	if( agent::config().enableCarry )
 	{
 		OUTPUT_NERVE(pickup, "Pickup");
 		OUTPUT_NERVE(drop, "Drop");
@@ -573,35 +754,40 @@ void agent::grow( long mateWait, bool seeding )
 	// ---
 	// --- Create Sensors
 	// ---
-	fCns->addSensor( fRetina = new Retina(Brain::config.retinaWidth) );
-	fCns->addSensor( fEnergySensor = new EnergySensor(this) );
-	fCns->addSensor( fRandomSensor = new RandomSensor(fCns->getRNG()) );
-	if( agent::config.enableMateWaitFeedback )
-		fCns->addSensor( fMateWaitSensor = new MateWaitSensor(this, mateWait) );
-	if( agent::config.enableSpeedFeedback )
-		fCns->addSensor( fSpeedSensor = new SpeedSensor(this) );
-	if( agent::config.enableSpeedFeedback )
-		fCns->addSensor( fSpeedSensor = new SpeedSensor(this) );
-	if( agent::config.enableCarry )
+	// A recycled agent's sensors are constructed again in place.
+	if( fRetina )
+		fRetina->clear();
+	else
+		fRetina = new Retina(Brain::config().retinaWidth);
+	fCns->addSensor( fRetina );
+	fCns->addSensor( renew(fEnergySensor, this) );
+	fCns->addSensor( renew(fRandomSensor, fCns->getRNG()) );
+	if( agent::config().enableMateWaitFeedback )
+		fCns->addSensor( renew(fMateWaitSensor, this, mateWait) );
+	if( agent::config().enableSpeedFeedback )
+		fCns->addSensor( renew(fSpeedSensor, this) );
+	if( agent::config().enableSpeedFeedback )
+		fCns->addSensor( renew(fSpeedSensor, this) );
+	if( agent::config().enableCarry )
 	{
-		fCns->addSensor( fCarryingSensor = new CarryingSensor(this) );
-		fCns->addSensor( fBeingCarriedSensor = new BeingCarriedSensor(this) );
+		fCns->addSensor( renew(fCarryingSensor, this) );
+		fCns->addSensor( renew(fBeingCarriedSensor, this) );
 	}
 
 	// ---
 	// --- Grow Nervous System (Brain)
 	// ---
 	fCns->grow( fGenome );
-	if( seeding && agent::fSeedSynapsesFromFile )
+	if( seeding && agent::fSeedSynapsesFromFile() )
 	{
 		SeedSynapsesFromFile();
-		if( agent::fFreezeSeededSynapses )
+		if( agent::fFreezeSeededSynapses() )
 			fCns->getBrain()->freeze();
 	}
-	logs->postEvent( BrainGrownEvent(this) );
+	Logs::current()->postEvent( BrainGrownEvent(this) );
 
 	fCns->prebirth();
-	if( Brain::config.learningMode == Brain::Configuration::LEARN_PREBIRTH )
+	if( Brain::config().learningMode == Brain::Configuration::LEARN_PREBIRTH )
 		fCns->getBrain()->freeze();
 
     // setup the agent's geometry
@@ -611,10 +797,10 @@ void agent::grow( long mateWait, bool seeding )
     fColor[0] = fColor[2] = 0.0;
 
 	// set body red channel
-	switch(agent::config.bodyRedChannel)
+	switch(agent::config().bodyRedChannel)
 	{
 	case BRC_CONST:
-		fColor[0] = agent::config.bodyRedChannelConstValue;
+		fColor[0] = agent::config().bodyRedChannelConstValue;
 		break;
 	case BRC_FIGHT:
 	case BRC_GIVE:
@@ -626,13 +812,13 @@ void agent::grow( long mateWait, bool seeding )
 	}
 
 	// set body green channel
-	switch(agent::config.bodyGreenChannel)
+	switch(agent::config().bodyGreenChannel)
 	{
 	case BGC_ID:
-		fColor[1] = fGenome->get( "ID" );
+		fColor[1] = fGenome->get( fGenome->ID );
 		break;
 	case BGC_CONST:
-		fColor[1] = agent::config.bodyGreenChannelConstValue;
+		fColor[1] = agent::config().bodyGreenChannelConstValue;
 		break;
 	case BGC_LIGHT:
 	case BGC_EAT:
@@ -645,10 +831,10 @@ void agent::grow( long mateWait, bool seeding )
 	}
 
 	// set body blue channel
-	switch(agent::config.bodyBlueChannel)
+	switch(agent::config().bodyBlueChannel)
 	{
 	case BBC_CONST:
-		fColor[2] = agent::config.bodyBlueChannelConstValue;
+		fColor[2] = agent::config().bodyBlueChannelConstValue;
 		break;
 	case BBC_MATE:
 	case BBC_ENERGY:
@@ -661,10 +847,10 @@ void agent::grow( long mateWait, bool seeding )
 
 	// set the initial nose color
 	float noseColor;
-	switch(agent::config.noseColor)
+	switch(agent::config().noseColor)
 	{
 	case NC_CONST:
-		noseColor = agent::config.noseColorConstValue;
+		noseColor = agent::config().noseColorConstValue;
 		break;
 	case NC_LIGHT:
 	case NC_BODY:
@@ -681,7 +867,7 @@ void agent::grow( long mateWait, bool seeding )
     fAge = 0;
     if( seeding )
     {
-        if( agent::config.randomSeedMateWait )
+        if( agent::config().randomSeedMateWait )
         {
             fLastMate = (long)(randpw() * -mateWait);
         }
@@ -692,23 +878,23 @@ void agent::grow( long mateWait, bool seeding )
     }
     else
     {
-        fLastMate = agent::config.initMateWait;
+        fLastMate = agent::config().initMateWait;
     }
 
-	float size_rel = geneCache.size - agent::config.minAgentSize;
+	float size_rel = geneCache.size - agent::config().minAgentSize;
 
     float maxEnergy;
-    if( agent::config.minAgentSize == agent::config.maxAgentSize )
+    if( agent::config().minAgentSize == agent::config().maxAgentSize )
     {
-        maxEnergy = 0.5 * (agent::config.minMaxEnergy + agent::config.maxMaxEnergy);
+        maxEnergy = 0.5 * (agent::config().minMaxEnergy + agent::config().maxMaxEnergy);
     }
     else
     {
-        maxEnergy = agent::config.minMaxEnergy + (size_rel
-                    * (agent::config.maxMaxEnergy - agent::config.minMaxEnergy) / (agent::config.maxAgentSize - agent::config.minAgentSize) );
+        maxEnergy = agent::config().minMaxEnergy + (size_rel
+                    * (agent::config().maxMaxEnergy - agent::config().minMaxEnergy) / (agent::config().maxAgentSize - agent::config().minAgentSize) );
     }
     fMaxEnergy = maxEnergy;
-    fStarvationFoodEnergy = agent::config.starvationEnergyFraction * maxEnergy;
+    fStarvationFoodEnergy = agent::config().starvationEnergyFraction * maxEnergy;
 
     fEnergy = fMaxEnergy;
 	fFoodEnergy = fMaxEnergy;
@@ -718,13 +904,13 @@ void agent::grow( long mateWait, bool seeding )
 	if( seeding )
 	{
 		float energy;
-		if( agent::config.randomSeedEnergy )
+		if( agent::config().randomSeedEnergy )
 		{
-			energy = trand( agent::config.starvationEnergyFraction, agent::config.maxSeedEnergy ) * maxEnergy;
+			energy = trand( agent::config().starvationEnergyFraction, agent::config().maxSeedEnergy ) * maxEnergy;
 		}
 		else
 		{
-			energy = agent::config.maxSeedEnergy * maxEnergy;
+			energy = agent::config().maxSeedEnergy * maxEnergy;
 		}
 		fEnergy = energy;
 		fFoodEnergy = energy;
@@ -732,28 +918,28 @@ void agent::grow( long mateWait, bool seeding )
 
 //	printf( "%s: energy initialized to %g\n", __func__, fEnergy );
 
-    if( agent::config.minAgentSize == agent::config.maxAgentSize )
+    if( agent::config().minAgentSize == agent::config().maxAgentSize )
     {
-        fSpeed2Energy = agent::config.speed2Energy * geneCache.maxSpeed;
-        fYaw2Energy = agent::config.yaw2Energy * geneCache.maxSpeed;
+        fSpeed2Energy = agent::config().speed2Energy * geneCache.maxSpeed;
+        fYaw2Energy = agent::config().yaw2Energy * geneCache.maxSpeed;
         fSizeAdvantage = 1.0;
     }
     else
     {
 	    // Note: gMinSizePenalty can be used to prevent size_rel==0 from giving
 	    // the agents "free" speed.
-        fSpeed2Energy = agent::config.speed2Energy * geneCache.maxSpeed
-		                * (agent::config.minSizePenalty + size_rel) * agent::config.maxSizePenalty
-					    / (agent::config.minSizePenalty + agent::config.maxAgentSize - agent::config.minAgentSize);
+        fSpeed2Energy = agent::config().speed2Energy * geneCache.maxSpeed
+		                * (agent::config().minSizePenalty + size_rel) * agent::config().maxSizePenalty
+					    / (agent::config().minSizePenalty + agent::config().maxAgentSize - agent::config().minAgentSize);
 
 	    // Note: gMinSizePenalty can be used to prevent size_rel==0 from giving
 	    // the agents "free" yaw.
-        fYaw2Energy = agent::config.yaw2Energy * geneCache.maxSpeed
-		              * (agent::config.minSizePenalty + size_rel) * agent::config.maxSizePenalty
-                  	  / (agent::config.minSizePenalty + agent::config.maxAgentSize - agent::config.minAgentSize);
+        fYaw2Energy = agent::config().yaw2Energy * geneCache.maxSpeed
+		              * (agent::config().minSizePenalty + size_rel) * agent::config().maxSizePenalty
+                  	  / (agent::config().minSizePenalty + agent::config().maxAgentSize - agent::config().minAgentSize);
 
         fSizeAdvantage = 1.0 + ( size_rel *
-                    (agent::config.maxSizeAdvantage - 1.0) / (agent::config.maxAgentSize - agent::config.minAgentSize) );
+                    (agent::config().maxSizeAdvantage - 1.0) / (agent::config().maxAgentSize - agent::config().minAgentSize) );
     }
 
     // now setup the camera & window for our agent to see the world in
@@ -761,7 +947,7 @@ void agent::grow( long mateWait, bool seeding )
 
     fAlive = true;
 
-	logs->postEvent( AgentGrownEvent(this) );
+	Logs::current()->postEvent( AgentGrownEvent(this) );
 }
 
 
@@ -770,7 +956,7 @@ void agent::grow( long mateWait, bool seeding )
 //---------------------------------------------------------------------------
 void agent::SeedSynapsesFromFile()
 {
-    const std::string &path = fSeedSynapseFilePaths[ (fTypeNumber - 1) % fSeedSynapseFilePaths.size() ];
+    const std::string &path = fSeedSynapseFilePaths()[ (fTypeNumber - 1) % fSeedSynapseFilePaths().size() ];
 	AbstractFile *in = AbstractFile::open( path.c_str(), "r" );
 	if( in == NULL )
 	{
@@ -905,7 +1091,7 @@ Energy agent::mating( float mateFitnessParam, long mateWait, bool lockstep )
 	if( mateWait <= 0 )
 		mateWait = 1;
 
-	Energy mymateenergy = fGenome->get( "MateEnergyFraction" ) * fEnergy;
+	Energy mymateenergy = fGenome->get( fGenome->MATE_ENERGY_FRACTION ) * fEnergy;
 
 	if( !lockstep )
 	{
@@ -987,8 +1173,8 @@ void agent::Die()
 	}
 
 	// Decrement total number of agents
-	agent::agentsliving--;
-	assert(agent::agentsliving >= 0);
+	agent::agentsliving()--;
+	assert(agent::agentsliving() >= 0);
 
 	fSimulation->GetAgentPovRenderer()->remove( this );
 }
@@ -999,18 +1185,18 @@ void agent::Die()
 void agent::SetGeometry()
 {
 	// obtain a fresh copy of the basic agent geometry
-    clonegeom(*agentobj);
+    clonegeom(*agentobj());
 
     // then adjust the geometry to fit size, speed, & agentheight
     fLengthX = Size() / sqrt(geneCache.maxSpeed);
     fLengthZ = Size() * sqrt(geneCache.maxSpeed);
-    srPrint( "agent::%s(): min=%g, max=%g, speed=%g, size=%g, lx=%g, lz=%g\n", __FUNCTION__, agent::config.minAgentSize, agent::config.maxAgentSize, geneCache.maxSpeed, Size(), fLengthX, fLengthZ );
+    srPrint( "agent::%s(): min=%g, max=%g, speed=%g, size=%g, lx=%g, lz=%g\n", __FUNCTION__, agent::config().minAgentSize, agent::config().maxAgentSize, geneCache.maxSpeed, Size(), fLengthX, fLengthZ );
     for (long i = 0; i < fNumPolygons; i++)
     {
         for (long j = 0; j < fPolygon[i].fNumPoints; j++)
         {
             fPolygon[i].fVertices[j * 3  ] *= fLengthX;
-            fPolygon[i].fVertices[j * 3 + 1] *= agent::config.agentHeight;
+            fPolygon[i].fVertices[j * 3 + 1] *= agent::config().agentHeight;
             fPolygon[i].fVertices[j * 3 + 2] *= fLengthZ;
         }
     }
@@ -1027,11 +1213,11 @@ void agent::SetGraphics()
     // setup the camera & window for our agent to see the world in
 	float fovx = FieldOfView();
 
-	fCamera.SetAspect(fovx * Brain::config.retinaHeight / (agent::config.agentFOV * Brain::config.retinaWidth));
-    fCamera.settranslation(0.0, (agent::config.eyeHeight - 0.5) * agent::config.agentHeight, -0.5 * fLengthZ);
+	fCamera.SetAspect(fovx * Brain::config().retinaHeight / (agent::config().agentFOV * Brain::config().retinaWidth));
+    fCamera.settranslation(0.0, (agent::config().eyeHeight - 0.5) * agent::config().agentHeight, -0.5 * fLengthZ);
 	fCamera.SetNear(.01);
-	fCamera.SetFar(1.5 * globals::worldsize);
-	fCamera.SetFOV(agent::config.agentFOV);
+	fCamera.SetFar(1.5 * globals::worldsize());
+	fCamera.SetFOV(agent::config().agentFOV);
 
 	if( fSimulation->glFogFunction() != 'O' )
 		fCamera.SetFog(true, fSimulation->glFogFunction(), fSimulation->glExpFogDensity(), fSimulation->glLinearFogEnd() );
@@ -1045,11 +1231,11 @@ void agent::SetGraphics()
 //---------------------------------------------------------------------------
 void agent::InitGeneCache()
 {
-	geneCache.maxSpeed = fGenome->get("MaxSpeed");
-	geneCache.strength = fGenome->get("Strength");
-	geneCache.size = fGenome->get("Size");
-	if( agent::config.dieAtMaxAge )
-		geneCache.lifespan = fGenome->get("LifeSpan");
+	geneCache.maxSpeed = fGenome->get( fGenome->MAX_SPEED );
+	geneCache.strength = fGenome->get( fGenome->STRENGTH );
+	geneCache.size = fGenome->get( fGenome->SIZE );
+	if( agent::config().dieAtMaxAge )
+		geneCache.lifespan = fGenome->get( fGenome->LIFE_SPAN );
 	else
 		geneCache.lifespan = INT_MAX;
 }
@@ -1070,25 +1256,25 @@ void agent::SaveLastPosition()
 //---------------------------------------------------------------------------
 void agent::UpdateVision()
 {
-    if (agent::config.vision)
+    if (agent::config().vision)
     {
 		// create retinal pixmap, based on values of focus & numvisneurons
-        const float fovx = agent::config.invertFocus
-            ? outputNerves.focus->get() * (agent::config.minFocus - agent::config.maxFocus) + agent::config.maxFocus
-            : outputNerves.focus->get() * (agent::config.maxFocus - agent::config.minFocus) + agent::config.minFocus;
+        const float fovx = agent::config().invertFocus
+            ? outputNerves.focus->get() * (agent::config().minFocus - agent::config().maxFocus) + agent::config().maxFocus
+            : outputNerves.focus->get() * (agent::config().maxFocus - agent::config().minFocus) + agent::config().minFocus;
 
-		fFrustum.Set(fPosition[0], fPosition[2], fAngle[0], fovx, agent::config.maxRadius);
-		fCamera.SetAspect(fovx * Brain::config.retinaHeight / (agent::config.agentFOV * Brain::config.retinaWidth));
+		fFrustum.Set(fPosition[0], fPosition[2], fAngle[0], fovx, agent::config().maxRadius);
+		fCamera.SetAspect(fovx * Brain::config().retinaHeight / (agent::config().agentFOV * Brain::config().retinaWidth));
 
-		if( agent::config.enableVisionPitch )
+		if( agent::config().enableVisionPitch )
 		{
-			const float pitch = outputNerves.visionPitch->get() * (agent::config.maxVisionPitch - agent::config.minVisionPitch) + agent::config.minVisionPitch;
+			const float pitch = outputNerves.visionPitch->get() * (agent::config().maxVisionPitch - agent::config().minVisionPitch) + agent::config().minVisionPitch;
 			fCamera.setpitch( pitch );
 		}
 
-		if( agent::config.enableVisionYaw )
+		if( agent::config().enableVisionYaw )
 		{
-			const float yaw = outputNerves.visionYaw->get() * (agent::config.maxVisionYaw - agent::config.minVisionYaw) + agent::config.minVisionYaw;
+			const float yaw = outputNerves.visionYaw->get() * (agent::config().maxVisionYaw - agent::config().minVisionYaw) + agent::config().minVisionYaw;
 			fCamera.setyaw( yaw );
 		}
 
@@ -1106,7 +1292,28 @@ void agent::UpdateBrain()
 {
 	fCns->update( false );
 
-	logs->postEvent( BrainUpdatedEvent(this) );
+	Logs::current()->postEvent( BrainUpdatedEvent(this) );
+}
+
+//---------------------------------------------------------------------------
+// Body update effects on the rest of the simulation, applied now or, for a
+// parallel update, deferred.
+//---------------------------------------------------------------------------
+static void bodyEffect( agent::ParallelBodyUpdate *parallel, std::function<void()> effect )
+{
+	if( parallel )
+		parallel->deferred.push_back( effect );
+	else
+		effect();
+}
+
+template<typename T>
+static void postBodyEvent( agent::ParallelBodyUpdate *parallel, const T &e )
+{
+	if( parallel )
+		parallel->deferred.push_back( [e]() { Logs::current()->postEvent( e ); } );
+	else
+		Logs::current()->postEvent( e );
 }
 
 //---------------------------------------------------------------------------
@@ -1119,7 +1326,8 @@ const float FF = 1.01;
 float agent::UpdateBody( float moveFitnessParam,
 						 float speed2dpos,
 						 int solidObjects,
-						 agent* carrier )
+						 agent* carrier,
+						 ParallelBodyUpdate *parallel )
 {
     debugcheck( "%lu", Number() );
 	assert( lxor( !BeingCarried(), carrier ) );
@@ -1150,9 +1358,9 @@ float agent::UpdateBody( float moveFitnessParam,
 	#if TestWorld
 		dx = dz = 0.0;
 	#else
-		float dpos = outputNerves.speed->get() * geneCache.maxSpeed * agent::config.speed2DPosition;
-		if( dpos > agent::config.maxVelocity )
-			dpos = agent::config.maxVelocity;
+		float dpos = outputNerves.speed->get() * geneCache.maxSpeed * agent::config().speed2DPosition;
+		if( dpos > agent::config().maxVelocity )
+			dpos = agent::config().maxVelocity;
 		dx = -dpos * sin( yaw() * DEGTORAD );
 		dz = -dpos * cos( yaw() * DEGTORAD );
 		addx( dx );
@@ -1165,7 +1373,7 @@ float agent::UpdateBody( float moveFitnessParam,
 	setyaw( outputNerves.yaw->get() * 360.0 );
   #else
 	float dyaw;
-	switch(agent::config.yawEncoding)
+	switch(agent::config().yawEncoding)
 	{
 	case YE_OPPOSE:
 		dyaw = outputNerves.yaw->get() - outputNerves.yawOppose->get();
@@ -1177,40 +1385,40 @@ float agent::UpdateBody( float moveFitnessParam,
 		assert(false);
 		break;
 	}
-	addyaw( dyaw * geneCache.maxSpeed * agent::config.yaw2DYaw );
+	addyaw( dyaw * geneCache.maxSpeed * agent::config().yaw2DYaw );
   #endif
 #endif
 
 	// Whether being carried or not, behaviors cost energy
-    float energyused = outputNerves.eat->get()   * agent::config.eat2Energy
-                     + outputNerves.mate->get()  * agent::config.mate2Energy
-                     + outputNerves.fight->get() * agent::config.fight2Energy
+    float energyused = outputNerves.eat->get()   * agent::config().eat2Energy
+                     + outputNerves.mate->get()  * agent::config().mate2Energy
+                     + outputNerves.fight->get() * agent::config().fight2Energy
                      + outputNerves.speed->get() * fSpeed2Energy
                      + fabs(dyaw) * fYaw2Energy
                      + fCns->getEnergyUse()
-                     + agent::config.fixedEnergyDrain;
+                     + agent::config().fixedEnergyDrain;
 
-	if( agent::config.hasLightBehavior )
+	if( agent::config().hasLightBehavior )
 	{
-		energyused += outputNerves.light->get() * agent::config.light2Energy;
+		energyused += outputNerves.light->get() * agent::config().light2Energy;
 	}
 
-	if( agent::config.enableGive )
+	if( agent::config().enableGive )
 	{
-		energyused += outputNerves.give->get() * agent::config.give2Energy;
+		energyused += outputNerves.give->get() * agent::config().give2Energy;
 	}
 
-	if( agent::config.enableCarry )
+	if( agent::config().enableCarry )
 	{
 		energyused += CarryEnergy();	// depends on number and size of items being carried
 	}
 
-    float denergy = energyused * Strength() * (1.0f + agent::config.ageEnergyMultiplier * fAge);
+    float denergy = energyused * Strength() * (1.0f + agent::config().ageEnergyMultiplier * fAge);
 
 	// Apply large-population energy penalty (only if NumDepletionSteps > 0)
 	float populationEnergyPenalty;
 #if UniformPopulationEnergyPenalty
-	populationEnergyPenalty = fSimulation->fPopulationPenaltyFraction * 0.5 * (agent::config.maxMaxEnergy + agent::config.minMaxEnergy);
+	populationEnergyPenalty = fSimulation->fPopulationPenaltyFraction * 0.5 * (agent::config().maxMaxEnergy + agent::config().minMaxEnergy);
 #else
 	populationEnergyPenalty = fSimulation->fPopulationPenaltyFraction * fMaxEnergy.mean();
 #endif
@@ -1222,7 +1430,7 @@ float agent::UpdateBody( float moveFitnessParam,
 					   * fSimulation->fDomains[fDomain].energyScaleFactor;
 	denergy *= scaleFactor;	// if population is getting too low or too high, adjust energy consumption
 
-	denergy *= agent::config.energyUseMultiplier;	// global control over rate at which energy is consumed
+	denergy *= agent::config().energyUseMultiplier;	// global control over rate at which energy is consumed
 
     fEnergy -= denergy;
     fFoodEnergy -= denergy;
@@ -1249,8 +1457,20 @@ float agent::UpdateBody( float moveFitnessParam,
 		// other side.
 
 		barrier* b = NULL;
-		barrier::gXSortedBarriers.reset();
-		while( barrier::gXSortedBarriers.next(b) )
+		size_t barrierIndex = 0;
+		auto nextBarrier = [&b, &barrierIndex, parallel]()
+			{
+				if( !parallel )
+					return barrier::gXSortedBarriers().next( b ) != 0;
+				if( barrierIndex == parallel->snapshot->barriers.size() )
+					return false;
+				b = parallel->snapshot->barriers[barrierIndex++];
+				return true;
+			};
+
+		if( !parallel )
+			barrier::gXSortedBarriers().reset();
+		while( nextBarrier() )
 		{
 			if( (b->xmax() > (    x() - FF * CarryRadius())) ||
 				(b->xmax() > (LastX() - FF * CarryRadius())) )
@@ -1271,7 +1491,7 @@ float agent::UpdateBody( float moveFitnessParam,
 					if( ((b->zmin() < ( z() + FF * CarryRadius())) || (b->zmin() < (LastZ() + FF * CarryRadius()))) &&
 						((b->zmax() > ( z() - FF * CarryRadius())) || (b->zmax() > (LastZ() - FF * CarryRadius()))) )
 					{
-						if( barrier::gStickyBarriers )
+						if( barrier::gStickyBarriers() )
 						{
 							fPosition[0] = LastX();
 							fPosition[2] = LastZ();
@@ -1314,11 +1534,11 @@ float agent::UpdateBody( float moveFitnessParam,
 							}
 						}
 
-						logs->postEvent( CollisionEvent(this, OT_BARRIER) );
+						postBodyEvent( parallel, CollisionEvent(this, OT_BARRIER) );
 					} // overlap in z
 				} // beginning of barrier comes after end of agent
 			} // end of barrier comes after beginning of agent
-		} // while( barrier::gXSortedBarriers.next(b) )
+		} // while( barrier::gXSortedBarriers().next(b) )
 
 		// If there are solid objects besides bricks, or
 		// if only bricks are solid and bricks are present in the simulation...
@@ -1328,15 +1548,15 @@ float agent::UpdateBody( float moveFitnessParam,
 			// If the agent moves, then we want to do collision avoidance
 			if( dx != 0.0 || dz != 0.0 )
 			{
-				AvoidCollisions( solidObjects );
+				AvoidCollisions( solidObjects, parallel );
 			}
 		}
 
 	#if 0
 		TODO
 		// Do a check
-		barrier::gXSortedBarriers.reset();
-		while( barrier::gXSortedBarriers.next( b ) )
+		barrier::gXSortedBarriers().reset();
+		while( barrier::gXSortedBarriers().next( b ) )
 		{
 			float dist  = b->dist(     x(),     z() );
 			float disto = b->dist( LastX(), LastZ() );
@@ -1353,14 +1573,14 @@ float agent::UpdateBody( float moveFitnessParam,
 		// Need to do something special with the agent list,
 		// when the agents do a wraparound (for the sake of efficiency
 		// and possibly correctness in the sort)
-		if( globals::blockedEdges )
+		if( globals::blockedEdges() )
 		{
 			bool collision = false;
 
-			if( fPosition[0] > globals::worldsize )
+			if( fPosition[0] > globals::worldsize() )
 			{
 				collision = true;
-				fPosition[0] = globals::worldsize;
+				fPosition[0] = globals::worldsize();
 			}
 			else if( fPosition[0] < 0.0 )
 			{
@@ -1368,10 +1588,10 @@ float agent::UpdateBody( float moveFitnessParam,
 				fPosition[0] = 0.0;
 			}
 
-			if( fPosition[2] < -globals::worldsize )
+			if( fPosition[2] < -globals::worldsize() )
 			{
 				collision = true;
-				fPosition[2] = -globals::worldsize;
+				fPosition[2] = -globals::worldsize();
 			}
 			else if( fPosition[2] > 0.0 )
 			{
@@ -1381,31 +1601,31 @@ float agent::UpdateBody( float moveFitnessParam,
 
 			if( collision )
 			{
-				if( globals::stickyEdges )
+				if( globals::stickyEdges() )
 				{
 					fPosition[0] = LastX();
 					fPosition[2] = LastZ();
 				}
 
-				logs->postEvent( CollisionEvent(this, OT_EDGE) );
+				postBodyEvent( parallel, CollisionEvent(this, OT_EDGE) );
 			}
 		}
-		else if( globals::wraparound )
+		else if( globals::wraparound() )
 		{
-			if( fPosition[0] > globals::worldsize )
-				fPosition[0] -= globals::worldsize;
+			if( fPosition[0] > globals::worldsize() )
+				fPosition[0] -= globals::worldsize();
 			else if( fPosition[0] < 0.0 )
-				fPosition[0] += globals::worldsize;
+				fPosition[0] += globals::worldsize();
 
-			if( fPosition[2] < -globals::worldsize )
-				fPosition[2] += globals::worldsize;
+			if( fPosition[2] < -globals::worldsize() )
+				fPosition[2] += globals::worldsize();
 			else if( fPosition[2] > 0.0 )
-				fPosition[2] -= globals::worldsize;
+				fPosition[2] -= globals::worldsize();
 		}
 		else
 		{
-			if( fPosition[0] > globals::worldsize || fPosition[0] < 0.0 ||
-				fPosition[2] < -globals::worldsize || fPosition[2] > 0.0 )
+			if( fPosition[0] > globals::worldsize() || fPosition[0] < 0.0 ||
+				fPosition[2] < -globals::worldsize() || fPosition[2] > 0.0 )
 				// The agent fell off a tabletop world, so it's no longer in a domain
 				// We can avoid an error below by skipping the call to TSimulation::WhichDomain
 				// Unfortunately, TSimulation::DeathAndStats may fail to subsequently kill the agent
@@ -1425,7 +1645,8 @@ float agent::UpdateBody( float moveFitnessParam,
         short newDomain = fSimulation->WhichDomain( fPosition[0], fPosition[2], fDomain );
         if( newDomain != fDomain )
         {
-            fSimulation->SwitchDomain( newDomain, fDomain, AGENTTYPE );
+            short oldDomain = fDomain;
+            bodyEffect( parallel, [=]() { fSimulation->SwitchDomain( newDomain, oldDomain, AGENTTYPE ); } );
             fDomain = newDomain;
         }
     }
@@ -1456,15 +1677,20 @@ float agent::UpdateBody( float moveFitnessParam,
 				energyUsed += ((agent*)carried)->UpdateBody( moveFitnessParam,
 															speed2dpos,
 															solidObjects,
-															this );
+															this,
+															parallel );
 				// carried agent's domain will be taken care of in its UpdateBody() call
 				break;
 
 			case FOODTYPE:
-				carried->setx( x() );
-				carried->setz( z() );
-				fSimulation->SwitchDomain( Domain(), ((food*)carried)->domain(), FOODTYPE );
-				((food*)carried)->domain( Domain() );
+				{
+					carried->setx( x() );
+					carried->setz( z() );
+					short newDomain = Domain();
+					short oldDomain = ((food*)carried)->domain();
+					bodyEffect( parallel, [=]() { fSimulation->SwitchDomain( newDomain, oldDomain, FOODTYPE ); } );
+					((food*)carried)->domain( newDomain );
+				}
 				break;
 
 			case BRICKTYPE:
@@ -1478,7 +1704,7 @@ float agent::UpdateBody( float moveFitnessParam,
 		}
 	}
 
-	logs->postEvent( AgentBodyUpdatedEvent(this, denergy, energyused) );
+	postBodyEvent( parallel, AgentBodyUpdatedEvent(this, denergy, energyused) );
 
     return energyUsed;
 }
@@ -1489,98 +1715,125 @@ float agent::UpdateBody( float moveFitnessParam,
 //---------------------------------------------------------------------------
 void agent::UpdateColor()
 {
-	if( agent::config.bodyRedChannel == BRC_FIGHT )
+	if( agent::config().bodyRedChannel == BRC_FIGHT )
 	{
 		SetRed( outputNerves.fight->get() );	// set red color according to desire to fight
 	}
-	else if( agent::config.bodyRedChannel == BRC_GIVE )
+	else if( agent::config().bodyRedChannel == BRC_GIVE )
 	{
 		SetRed( outputNerves.give->get() );	// set red color according to desire to give
 	}
 
-  	if( agent::config.bodyGreenChannel == BGC_LIGHT )
+  	if( agent::config().bodyGreenChannel == BGC_LIGHT )
 	{
 		SetGreen(outputNerves.light->get());
 	}
-	else if( agent::config.bodyGreenChannel == BGC_EAT )
+	else if( agent::config().bodyGreenChannel == BGC_EAT )
 	{
 		SetGreen(outputNerves.eat->get());
 	}
-	else if( agent::config.bodyGreenChannel == BGC_FOOD )
+	else if( agent::config().bodyGreenChannel == BGC_FOOD )
 	{
 		SetGreen(NormalizedFoodEnergy());
 	}
 
-	if( agent::config.bodyBlueChannel == BBC_MATE )
+	if( agent::config().bodyBlueChannel == BBC_MATE )
 	{
 		SetBlue( outputNerves.mate->get() ); 	// set blue color according to desire to mate
 	}
-	else if( agent::config.bodyBlueChannel == BBC_ENERGY )
+	else if( agent::config().bodyBlueChannel == BBC_ENERGY )
 	{
 		SetBlue( 1 - NormalizedEnergy() );
 	}
 
-	if( agent::config.noseColor == NC_LIGHT )
+	if( agent::config().noseColor == NC_LIGHT )
 	{
 		fNoseColor[0] = fNoseColor[1] = fNoseColor[2] = outputNerves.light->get();
 	}
 }
 
 
-void agent::AvoidCollisions( int solidObjects )
+void agent::AvoidCollisions( int solidObjects, ParallelBodyUpdate *parallel )
 {
+	// The snapshot has no shared cursor to save and restore
+	if( parallel )
+	{
+		AvoidCollisionDirectional( PREV, solidObjects, parallel );
+		AvoidCollisionDirectional( NEXT, solidObjects, parallel );
+		return;
+	}
+
 	// Save the current agent pointer in the master x-sorted list before we mess with it, so we can restore it later
-	objectxsortedlist::gXSortedObjects.setMark( AGENTTYPE );
+	objectxsortedlist::gXSortedObjects().setMark( AGENTTYPE );
 
 	// First look backwards in the list (to the left, decreasing x)
 	AvoidCollisionDirectional( PREV, solidObjects );
 
 	// Restore the current agent pointer in the master x-sorted list
-	objectxsortedlist::gXSortedObjects.toMark( AGENTTYPE );
+	objectxsortedlist::gXSortedObjects().toMark( AGENTTYPE );
 
 	// Then look forwards in the list (to the right, increasing x)
 	AvoidCollisionDirectional( NEXT, solidObjects );
 
 	// Restore the current agent pointer in the master x-sorted list
-	objectxsortedlist::gXSortedObjects.toMark( AGENTTYPE );
+	objectxsortedlist::gXSortedObjects().toMark( AGENTTYPE );
 }
 
 
 // WARNING:  AvoidCollisionDirectional assumes it will not be called
 // with both dx == 0.0 and dz == 0.0.  This is normally taken care of
 // in Update() before calling AvoidCollisions().
-void agent::AvoidCollisionDirectional( int direction, int solidObjects )
+void agent::AvoidCollisionDirectional( int direction, int solidObjects, ParallelBodyUpdate *parallel )
 {
 	#define CollisionRadiusReductionFactor 0.90
 
 	gobject* obj;
+	float objX, objZ, objRadius;
+	int snapshotIndex = parallel ? parallel->index : 0;
 
 	float dx = x() - LastX();
 	float dz = z() - LastZ();
 	float agtRadius = radius() * CollisionRadiusReductionFactor;
 
 	// Look in the specified direction
-	while( objectxsortedlist::gXSortedObjects.anotherObj( direction, solidObjects, &obj ) )
+	while( true )
 	{
-		float objRadius = obj->radius() * CollisionRadiusReductionFactor;
+		if( parallel )
+		{
+			const PositionSnapshot::Object *entry = parallel->snapshot->anotherObj( direction, solidObjects, snapshotIndex );
+			if( !entry )
+				break;
+			obj = entry->obj;
+			objX = entry->x;
+			objZ = entry->z;
+			objRadius = entry->radius * CollisionRadiusReductionFactor;
+		}
+		else
+		{
+			if( !objectxsortedlist::gXSortedObjects().anotherObj( direction, solidObjects, &obj ) )
+				break;
+			objX = obj->x();
+			objZ = obj->z();
+			objRadius = obj->radius() * CollisionRadiusReductionFactor;
+		}
 
 		// Test to see if we're close enough in x; if not, get out, we're done,
 		// because all objects after this one are even farther away
 		// Note: anotherObj() will complain and exit if direction is neither NEXT nor PREV
 		if( direction == NEXT )
 		{
-            if( obj->x() - objRadius > std::max( x(), LastX() ) + agtRadius )
+            if( objX - objRadius > std::max( x(), LastX() ) + agtRadius )
 				break;
 		}
 		else	// direction == PREV
 		{
-            if( obj->x() + objRadius < std::min( x(), LastX() ) - agtRadius)
+            if( objX + objRadius < std::min( x(), LastX() ) - agtRadius)
 				break;
 		}
 
 		// Test to see if we're too far away in z; if so, we're done with this object
-        if( obj->z() - objRadius > std::max( z(), LastZ() ) + agtRadius  ||
-            obj->z() + objRadius < std::min( z(), LastZ() ) - agtRadius )
+        if( objZ - objRadius > std::max( z(), LastZ() ) + agtRadius  ||
+            objZ + objRadius < std::min( z(), LastZ() ) - agtRadius )
 			continue;
 
 		// If we're carrying the object, then there's nothing to be done
@@ -1598,20 +1851,20 @@ void agent::AvoidCollisionDirectional( int direction, int solidObjects )
 		// up farther away than it started, after going completely through the collision
 		// object.  Dividing by worldsize should take care of that in any situation.)
 		float xs, zs;
-		float dosquared = (obj->x()-LastX())*(obj->x()-LastX()) + (obj->z()-LastZ())*(obj->z()-LastZ());
+		float dosquared = (objX-LastX())*(objX-LastX()) + (objZ-LastZ())*(objZ-LastZ());
 		if( fabs( dx ) > fabs( dz ) )
 		{
 			float s = dz / dx;
-			xs = LastX()  +  dx / globals::worldsize;
+			xs = LastX()  +  dx / globals::worldsize();
 			zs = LastZ()  +  s * (xs - LastX());
 		}
 		else
 		{
 			float s = dx / dz;
-			zs = LastZ()  +  dz / globals::worldsize;
+			zs = LastZ()  +  dz / globals::worldsize();
 			xs = LastX()  +  s * (zs - LastZ());
 		}
-		float dssquared = (obj->x()-xs)*(obj->x()-xs) + (obj->z()-zs)*(obj->z()-zs);
+		float dssquared = (objX-xs)*(objX-xs) + (objZ-zs)*(objZ-zs);
 
 		// Test to see if the agent is approaching the potential collision object
 		if( dssquared < dosquared )
@@ -1619,7 +1872,7 @@ void agent::AvoidCollisionDirectional( int direction, int solidObjects )
 			// If we reach here, then there was a collision
 			// So calculate where along our path we had to stop in order to avoid it
 			float xf, zf;	// the "fixed" coordinates so as to avoid penetrating the brick
-			GetCollisionFixedCoordinates( LastX(), LastZ(), x(), z(), obj->x(), obj->z(), agtRadius, objRadius, &xf, &zf );
+			GetCollisionFixedCoordinates( LastX(), LastZ(), x(), z(), objX, objZ, agtRadius, objRadius, &xf, &zf );
 			setx( xf );
 			setz( zf );
 
@@ -1640,7 +1893,7 @@ void agent::AvoidCollisionDirectional( int direction, int solidObjects )
 				break;
 			}
 
-			logs->postEvent( CollisionEvent(this, ot) );
+			postBodyEvent( parallel, CollisionEvent(this, ot) );
 			//break;	// can only hit one
 		}
 	}
@@ -1756,7 +2009,7 @@ void agent::PickupObject( gobject* o )
 	if( o->radius() > fCarryRadius )
 		fCarryRadius = o->radius();
 
-	logs->postEvent( CarryEvent(this,
+	Logs::current()->postEvent( CarryEvent(this,
 								CarryEvent::Pickup,
 								o) );
 }
@@ -1778,7 +2031,7 @@ void agent::DropMostRecent( void )
 		RecalculateCarryRadius();
 	}
 
-	logs->postEvent( CarryEvent(this,
+	Logs::current()->postEvent( CarryEvent(this,
 								CarryEvent::DropRecent,
 								o) );
 }
@@ -1798,7 +2051,7 @@ void agent::DropObject( gobject* o )
 		RecalculateCarryRadius();
 	}
 
-	logs->postEvent( CarryEvent(this,
+	Logs::current()->postEvent( CarryEvent(this,
 								CarryEvent::DropObject,
 								o) );
 }
@@ -1824,16 +2077,18 @@ void agent::RecalculateCarryRadius( void )
 //---------------------------------------------------------------------------
 void agent::draw()
 {
+#if !PW_HEADLESS
 	glPushMatrix();
 		position();
 		glScalef(fScale, fScale, fScale);
-		if( agent::config.noseColor == agent::NC_BODY )
+		if( agent::config().noseColor == agent::NC_BODY )
 			gpolyobj::drawcolpolyrange(0, 4, fColor);
 		else
 			gpolyobj::drawcolpolyrange(0, 4, fNoseColor);
 		gpolyobj::drawcolpolyrange(5, 9, fColor);
 //		fCamera.draw();
 	glPopMatrix();
+#endif
 }
 
 
@@ -1857,7 +2112,7 @@ void agent::print()
     if (fGenome != NULL)
     {
         std::cout << "  fGenome->Lifespan() = " << MaxAge() nl;
-        std::cout << "  fGenome->MutationRate() = " << fGenome->get( "MutationRate" ) nl;
+        std::cout << "  fGenome->MutationRate() = " << fGenome->get( fGenome->MUTATION_RATE ) nl;
         std::cout << "  fGenome->Strength() = " << Strength() nl;
         std::cout << "  fGenome->Size() = " << Size() nl;
         std::cout << "  fGenome->MaxSpeed() = " << geneCache.maxSpeed nl;
@@ -1873,7 +2128,7 @@ void agent::print()
     std::cout << "  fBrain->fight() = " << outputNerves.fight->get() nl;
     std::cout << "  fBrain->speed() = " << outputNerves.speed->get() nl;
     std::cout << "  fBrain->yaw() = " << outputNerves.yaw->get() nl;
-	if (agent::config.hasLightBehavior)
+	if (agent::config().hasLightBehavior)
 	{
         std::cout << "  fBrain->light() = " << outputNerves.light->get() nl;
 	}
@@ -1887,12 +2142,12 @@ void agent::print()
 //---------------------------------------------------------------------------
 float agent::NormalizedYaw()
 {
-	switch(agent::config.yawEncoding)
+	switch(agent::config().yawEncoding)
 	{
 	case YE_OPPOSE:
-        return pwclamp( ((outputNerves.yaw->get() - outputNerves.yawOppose->get()) * geneCache.maxSpeed) / agent::config.maxmaxspeed, -1.0, 1.0 );
+        return pwclamp( ((outputNerves.yaw->get() - outputNerves.yawOppose->get()) * geneCache.maxSpeed) / agent::config().maxmaxspeed, -1.0, 1.0 );
 	case YE_SQUASH:
-        return pwclamp( ((2.0 * outputNerves.yaw->get() - 1.0) * geneCache.maxSpeed) / agent::config.maxmaxspeed, -1.0, 1.0 );
+        return pwclamp( ((2.0 * outputNerves.yaw->get() - 1.0) * geneCache.maxSpeed) / agent::config().maxmaxspeed, -1.0, 1.0 );
 	default:
 		assert(false);
 		return 0.0f;
@@ -1904,9 +2159,9 @@ float agent::NormalizedYaw()
 //---------------------------------------------------------------------------
 float agent::FieldOfView()
 {
-	return agent::config.invertFocus
-		? outputNerves.focus->get() * (agent::config.minFocus - agent::config.maxFocus) + agent::config.maxFocus
-		: outputNerves.focus->get() * (agent::config.maxFocus - agent::config.minFocus) + agent::config.minFocus;
+	return agent::config().invertFocus
+		? outputNerves.focus->get() * (agent::config().minFocus - agent::config().maxFocus) + agent::config().maxFocus
+		: outputNerves.focus->get() * (agent::config().maxFocus - agent::config().minFocus) + agent::config().minFocus;
 }
 
 
@@ -1916,7 +2171,7 @@ float agent::FieldOfView()
 void agent::NumberToName()
 {
 	char tempstring[256];
-	sprintf(tempstring, "agent#%ld", agentsEver);
+	sprintf(tempstring, "agent#%ld", agentsEver());
 	this->SetName(tempstring);
 }
 
@@ -1966,19 +2221,19 @@ float agent::CarryEnergy( void )
 		switch( o->getType() )
 		{
 			case AGENTTYPE:
-				energy += agent::config.carryAgent2Energy;
-				if( agent::config.minAgentSize != agent::config.maxAgentSize )
+				energy += agent::config().carryAgent2Energy;
+				if( agent::config().minAgentSize != agent::config().maxAgentSize )
 				{
-					energy += agent::config.carryAgentSize2Energy * (((agent*)o)->Size() - agent::config.minAgentSize) / (agent::config.maxAgentSize - agent::config.minAgentSize);
+					energy += agent::config().carryAgentSize2Energy * (((agent*)o)->Size() - agent::config().minAgentSize) / (agent::config().maxAgentSize - agent::config().minAgentSize);
 				}
 				break;
 
 			case FOODTYPE:
-				energy += food::gCarryFood2Energy * o->radius() / food::gMaxFoodRadius;
+				energy += food::gCarryFood2Energy() * o->radius() / food::gMaxFoodRadius();
 				break;
 
 			case BRICKTYPE:
-				energy += brick::gCarryBrick2Energy;	// all bricks are the same size currently
+				energy += brick::gCarryBrick2Energy();	// all bricks are the same size currently
 				break;
 
 			default:
@@ -3,6 +3,8 @@
 
 // System
 #include <algorithm>
+#include <functional>
+#include <vector>
 
 // Local
 #include "AgentAttachedData.h"
@@ -37,6 +39,7 @@ class food;
 class MateWaitSensor;
 class Metabolism;
 class NervousSystem;
+class PositionSnapshot;
 class RandomSensor;
 class Retina;
 class SpeedSensor;
@@ -57,7 +60,7 @@ public:
 	enum NoseColor { NC_LIGHT, NC_BODY, NC_CONST };
 	enum YawEncoding { YE_SQUASH, YE_OPPOSE };
 
-	static struct Configuration
+	struct Configuration
 	{
 		float	agentHeight;
 		float	minAgentSize;
@@ -131,11 +134,14 @@ public:
 		bool	enableVisionPitch;
 		bool	enableVisionYaw;
 
-	} config;
+	};
+	static Configuration &config();
 
 	static void processWorldfile( proplib::Document &doc );
 	static void agentinit();
 	static agent* getfreeagent(TSimulation* simulation, gstage* stage);
+	static void recycle(agent* a);
+	static unsigned long getAgentsAllocated();
 	static void agentload(std::istream& in);
 	static void agentdestruct();
 	static void agentdump(std::ostream& out);
@@ -147,13 +153,27 @@ public:
     void load(std::istream& in);
 	void UpdateVision();
 	void UpdateBrain();
+
+	// When bodies are updated in parallel, collision queries read a snapshot
+	// of positions from before the body phase, and effects on anything but
+	// the agent itself are deferred, to be applied serially in list order.
+	// Results then don't depend on the thread count.
+	struct ParallelBodyUpdate
+	{
+		const PositionSnapshot *snapshot;
+		int index;	// this agent's entry in snapshot
+		std::vector<std::function<void()>> deferred;
+		float energyUsed;
+	};
+
     float UpdateBody( float moveFitnessParam,
 					  float speed2dpos,
 					  int solidObjects,
-					  agent* carrier );
+					  agent* carrier,
+					  ParallelBodyUpdate *parallel = NULL );
 	void UpdateColor();
-	void AvoidCollisions( int solidObjects );
-	void AvoidCollisionDirectional( int direction, int solidObjects );
+	void AvoidCollisions( int solidObjects, ParallelBodyUpdate *parallel = NULL );
+	void AvoidCollisionDirectional( int direction, int solidObjects, ParallelBodyUpdate *parallel = NULL );
 	void GetCollisionFixedCoordinates( float xo, float zo, float xn, float zn, float xb, float zb, float rc, float rb, float *xf, float *zf );
 
     void SetVelocity(float x, float y, float z);
@@ -220,6 +240,9 @@ public:
 	float Pickup();
 	float Drop();
     float Size();
+    float LengthX();
+    float LengthZ();
+    const float* GetNoseColor();
     bool IsSeed();
     long Age();
     long MaxAge();
@@ -264,6 +287,11 @@ public:
 	float CarryEnergy( void );
 	void PrintCarries( FILE* );
 	TSimulation* fSimulation;
+#if DebugBirthAllocations
+	// DebugAllocationCount() when this agent was recycled, or ULONG_MAX if
+	// it was newly allocated.
+	unsigned long fDebugAllocations;
+#endif
 
 	struct BrainAnalysisParms
 	{
@@ -271,19 +299,42 @@ public:
 	} brainAnalysisParms;
 
 protected:
+	// What a dead agent on the free list hands over to the agent next
+	// constructed in its place.
+	struct RecycledParts
+	{
+		genome::Genome *genome;
+		NervousSystem *cns;
+		Retina *retina;
+		RandomSensor *randomSensor;
+		EnergySensor *energySensor;
+		MateWaitSensor *mateWaitSensor;
+		SpeedSensor *speedSensor;
+		CarryingSensor *carryingSensor;
+		BeingCarriedSensor *beingCarriedSensor;
+		AgentAttachedData::SlotData *attachedData;
+		// Body geometry storage; SetGeometry() overwrites it in place.
+		long numPolygons;
+		opoly *polygon;
+	};
+
+    agent(TSimulation* simulation, gstage* stage, RecycledParts* parts);
+
     void NumberToName();
     void SetGeometry();
     void SetGraphics();
 	void InitGeneCache();
 
-	static bool gClassInited;
-    static unsigned long agentsEver;
-    static long agentsliving;
-    static gpolyobj* agentobj;
+	static bool &gClassInited();
+    static unsigned long &agentsEver();
+    static unsigned long &agentsAllocated();
+    static std::vector<agent*> &freeAgents();
+    static long &agentsliving();
+    static gpolyobj* &agentobj();
     static agent** pc;
-    static bool fSeedSynapsesFromFile;
-    static std::vector<std::string> fSeedSynapseFilePaths;
-    static bool fFreezeSeededSynapses;
+    static bool &fSeedSynapsesFromFile();
+    static std::vector<std::string> &fSeedSynapseFilePaths();
+    static bool &fFreezeSeededSynapses();
 
     static void ReadSeedSynapseFilePaths();
     void SeedSynapsesFromFile();
@@ -391,7 +442,7 @@ inline float agent::VelocityY() { return fVelocity[1]; }
 inline float agent::VelocityZ() { return fVelocity[2]; }
 inline float agent::Speed() { return fSpeed; }
 inline float agent::MaxSpeed() { return fMaxSpeed; }
-inline float agent::NormalizedSpeed() { return std::min( 1.0f, Speed() / agent::config.maxVelocity ); }
+inline float agent::NormalizedSpeed() { return std::min( 1.0f, Speed() / agent::config().maxVelocity ); }
 inline float agent::Mass() { return fMass; }
 inline float agent::SizeAdvantage() { return fSizeAdvantage; }
 inline const Metabolism *agent::GetMetabolism() { return fMetabolism; }
@@ -411,6 +462,9 @@ inline float agent::Mate() { return outputNerves.mate->get(); }
 inline float agent::Pickup() { return outputNerves.pickup->get(); }
 inline float agent::Drop() { return outputNerves.drop->get(); }
 inline float agent::Size() { return geneCache.size; }
+inline float agent::LengthX() { return fLengthX; }
+inline float agent::LengthZ() { return fLengthZ; }
+inline const float* agent::GetNoseColor() { return fNoseColor; }
 inline bool agent::IsSeed() { return fIsSeed; }
 inline long agent::Age() { return fAge; }
 inline long agent::MaxAge() { return geneCache.lifespan; }
@@ -441,7 +495,7 @@ inline Retina* agent::GetRetina() { return fRetina; }
 inline gscene& agent::GetScene() { return fScene; }
 inline gcamera &agent::getCamera() { return fCamera; }
 inline frustumXZ& agent::GetFrustum() { return fFrustum; }
-inline gpolyobj* agent::GetAgentObj() { return agentobj; }
+inline gpolyobj* agent::GetAgentObj() { return agentobj(); }
 //inline gdlink<agent*>* agent::GetListLink() { return listLink; }
 
 inline void agent::SetComplexity( float value ) { fComplexity = value; }
@@ -26,6 +26,11 @@ class BaseNeuronModel : public NeuronModel
 		newneuronactivation = NULL;
 		synapse = NULL;
 
+		neuronCapacity = 0;
+		neuronactivationCapacity = 0;
+		newneuronactivationCapacity = 0;
+		synapseCapacity = 0;
+
 #if PrintBrain
 		bprinted = false;
 #endif
@@ -46,13 +51,13 @@ class BaseNeuronModel : public NeuronModel
 	{
 		this->dims = dims;
 
-#define __ALLOC(NAME, TYPE, N) if(NAME) free(NAME); NAME = (TYPE *)calloc(N, sizeof(TYPE)); assert(NAME);
+#define __ALLOC(NAME, N) allocZeroed( NAME, NAME##Capacity, N );
 
-		__ALLOC( neuron, T_neuron, dims->numNeurons );
-		__ALLOC( neuronactivation, double, dims->numNeurons );
-		__ALLOC( newneuronactivation, double, dims->numNeurons );
+		__ALLOC( neuron, dims->numNeurons );
+		__ALLOC( neuronactivation, dims->numNeurons );
+		__ALLOC( newneuronactivation, dims->numNeurons );
 
-		__ALLOC( synapse, T_synapse, dims->numSynapses );
+		__ALLOC( synapse, dims->numSynapses );
 
 #undef __ALLOC
 
@@ -138,6 +143,33 @@ class BaseNeuronModel : public NeuronModel
 
 	}
 
+	virtual bool is_allocated()
+	{
+		return (neuron != NULL) && (synapse != NULL);
+	}
+
+	virtual float get_neuron_bias( int index )
+	{
+		return neuron[index].bias;
+	}
+
+	virtual double get_activation( int index )
+	{
+		return neuronactivation[index];
+	}
+
+	virtual double get_new_activation( int index )
+	{
+		return newneuronactivation[index];
+	}
+
+	virtual size_t getMemoryFootprint()
+	{
+		return sizeof(T_neuron) * dims->numNeurons
+			+ 2 * sizeof(double) * dims->numNeurons
+			+ sizeof(T_synapse) * dims->numSynapses;
+	}
+
 	virtual void getActivations( double *activations, int start, int count )
 	{
 		for( int i = 0; i < count; i++ )
@@ -168,7 +200,7 @@ class BaseNeuronModel : public NeuronModel
 		float*	connectionMatrix;
 		short	i,j;
 		long	s;
-        float	maxWeight = std::max( Brain::config.maxWeight, Brain::config.maxbias );
+        float	maxWeight = std::max( Brain::config().maxWeight, Brain::config().maxbias );
 		double	inverseMaxWeight = 1. / maxWeight;
 		long imin = 10000;
 		long imax = -10000;
@@ -315,6 +347,13 @@ class BaseNeuronModel : public NeuronModel
 	double *newneuronactivation;
 	T_synapse *synapse;
 
+	// Elements allocated. update() swaps the activation buffers, which is
+	// fine since init() always sizes them alike.
+	long neuronCapacity;
+	long neuronactivationCapacity;
+	long newneuronactivationCapacity;
+	long synapseCapacity;
+
 #if PrintBrain
 	bool bprinted;
 #endif
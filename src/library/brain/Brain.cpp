@@ -13,6 +13,7 @@
 #include <sys/stat.h>
 
 // Local
+#include "FiringRateModel.h"
 #include "NervousSystem.h"
 #include "NeuronModel.h"
 #include "agent/agent.h"
@@ -21,7 +22,9 @@
 #include "sim/debug.h"
 #include "sim/globals.h"
 #include "sim/Simulation.h"
+#include "sim/SimulationContext.h"
 #include "utils/AbstractFile.h"
+#include "utils/Activation.h"
 #include "utils/misc.h"
 
 using namespace genome;
@@ -36,7 +39,13 @@ using namespace genome;
 // Brain
 //===========================================================================
 
-Brain::Configuration Brain::config;
+//---------------------------------------------------------------------------
+// Brain::config
+//---------------------------------------------------------------------------
+Brain::Configuration &Brain::config()
+{
+	return SimulationContext::current()->get<Configuration>();
+}
 
 //---------------------------------------------------------------------------
 // Brain::processWorldfile
@@ -46,76 +55,79 @@ void Brain::processWorldfile( proplib::Document &doc )
 	{
         std::string val = doc.get( "BrainArchitecture" );
 		if( val == "Groups" )
-			Brain::config.architecture = Brain::Configuration::Groups;
+			Brain::config().architecture = Brain::Configuration::Groups;
 		else if( val == "Sheets" )
-			Brain::config.architecture = Brain::Configuration::Sheets;
+			Brain::config().architecture = Brain::Configuration::Sheets;
 		else
 			assert( false );
 	}
 	{
         std::string val = doc.get( "NeuronModel" );
 		if( val == "F" )
-			Brain::config.neuronModel = Brain::Configuration::FIRING_RATE;
+			Brain::config().neuronModel = Brain::Configuration::FIRING_RATE;
 		else if( val == "T" )
-			Brain::config.neuronModel = Brain::Configuration::TAU_GAIN;
+			Brain::config().neuronModel = Brain::Configuration::TAU_GAIN;
 		else if( val == "S" )
-			Brain::config.neuronModel = Brain::Configuration::SPIKING;
+			Brain::config().neuronModel = Brain::Configuration::SPIKING;
 		else
 			assert( false );
 	}
+	Brain::config().compactStorage = (std::string)doc.get( "BrainStorage" ) == "Compact";
+	Brain::config().compactHalfLrate = doc.get( "CompactBrainHalfLearningRate" );
 	{
         std::string val = doc.get( "LearningMode" );
 		if( val == "None" )
-			Brain::config.learningMode = Brain::Configuration::LEARN_NONE;
+			Brain::config().learningMode = Brain::Configuration::LEARN_NONE;
 		else if( val == "Prebirth" )
-			Brain::config.learningMode = Brain::Configuration::LEARN_PREBIRTH;
+			Brain::config().learningMode = Brain::Configuration::LEARN_PREBIRTH;
 		else if( val == "All" )
-			Brain::config.learningMode = Brain::Configuration::LEARN_ALL;
+			Brain::config().learningMode = Brain::Configuration::LEARN_ALL;
 		else
 			assert( false );
 	}
 
-    Brain::config.Spiking.enableGenes = doc.get( "EnableSpikingGenes" );
-	Brain::config.Spiking.aMinVal = doc.get( "SpikingAMin" );
-	Brain::config.Spiking.aMaxVal = doc.get( "SpikingAMax" );
-	Brain::config.Spiking.bMinVal = doc.get( "SpikingBMin" );
-	Brain::config.Spiking.bMaxVal = doc.get( "SpikingBMax" );
-	Brain::config.Spiking.cMinVal = doc.get( "SpikingCMin" );
-	Brain::config.Spiking.cMaxVal = doc.get( "SpikingCMax" );
-	Brain::config.Spiking.dMinVal = doc.get( "SpikingDMin" );
-	Brain::config.Spiking.dMaxVal = doc.get( "SpikingDMax" );
-
-	Brain::config.Tau.minVal = doc.get( "TauMin" );
-	Brain::config.Tau.maxVal = doc.get( "TauMax" );
-	Brain::config.Tau.seedVal = doc.get( "TauSeed" );
-
-	Brain::config.Gain.minVal = doc.get( "GainMin" );
-	Brain::config.Gain.maxVal = doc.get( "GainMax" );
-	Brain::config.Gain.seedVal = doc.get( "GainSeed" );
-
-    Brain::config.maxbias = doc.get( "MaxBiasWeight" );
-	Brain::config.maxneuron2energy = doc.get( "EnergyUseNeurons" );
-	Brain::config.outputSynapseLearning = doc.get( "OutputSynapseLearning" );
-	Brain::config.synapseFromOutputNeurons = doc.get( "SynapseFromOutputNeurons" );
-	Brain::config.synapseFromInputToOutputNeurons = doc.get( "SynapseFromInputToOutputNeurons" );
-	Brain::config.numPrebirthCycles = doc.get( "PreBirthCycles" );
-
-    Brain::config.logisticSlope = doc.get( "LogisticSlope" );
-    Brain::config.fixedInitWeight = doc.get( "FixedInitSynapseWeight" );
-    Brain::config.gaussianInitWeight = doc.get( "GaussianInitSynapseWeight" );
-    Brain::config.gaussianInitMaxStdev = doc.get( "GaussianInitSynapseWeightMaxStdev" );
-    Brain::config.maxWeight = doc.get( "MaxSynapseWeight" );
-    Brain::config.initMaxWeight = doc.get( "MaxSynapseWeightInitial" );
-
-    Brain::config.enableLearning = Brain::config.learningMode != Brain::Configuration::LEARN_NONE;
-    Brain::config.minlrate = doc.get( "MinLearningRate" );
-    Brain::config.maxlrate = doc.get( "MaxLearningRate" );
-
-    Brain::config.maxsynapse2energy = doc.get( "EnergyUseSynapses" );
-    Brain::config.decayRate = doc.get( "SynapseWeightDecayRate" );
+    Brain::config().Spiking.enableGenes = doc.get( "EnableSpikingGenes" );
+	Brain::config().Spiking.aMinVal = doc.get( "SpikingAMin" );
+	Brain::config().Spiking.aMaxVal = doc.get( "SpikingAMax" );
+	Brain::config().Spiking.bMinVal = doc.get( "SpikingBMin" );
+	Brain::config().Spiking.bMaxVal = doc.get( "SpikingBMax" );
+	Brain::config().Spiking.cMinVal = doc.get( "SpikingCMin" );
+	Brain::config().Spiking.cMaxVal = doc.get( "SpikingCMax" );
+	Brain::config().Spiking.dMinVal = doc.get( "SpikingDMin" );
+	Brain::config().Spiking.dMaxVal = doc.get( "SpikingDMax" );
+
+	Brain::config().Tau.minVal = doc.get( "TauMin" );
+	Brain::config().Tau.maxVal = doc.get( "TauMax" );
+	Brain::config().Tau.seedVal = doc.get( "TauSeed" );
+
+	Brain::config().Gain.minVal = doc.get( "GainMin" );
+	Brain::config().Gain.maxVal = doc.get( "GainMax" );
+	Brain::config().Gain.seedVal = doc.get( "GainSeed" );
+
+    Brain::config().maxbias = doc.get( "MaxBiasWeight" );
+	Brain::config().maxneuron2energy = doc.get( "EnergyUseNeurons" );
+	Brain::config().outputSynapseLearning = doc.get( "OutputSynapseLearning" );
+	Brain::config().synapseFromOutputNeurons = doc.get( "SynapseFromOutputNeurons" );
+	Brain::config().synapseFromInputToOutputNeurons = doc.get( "SynapseFromInputToOutputNeurons" );
+	Brain::config().numPrebirthCycles = doc.get( "PreBirthCycles" );
+
+    Brain::config().logisticSlope = doc.get( "LogisticSlope" );
+	Brain::config().fastActivation = (std::string)doc.get( "ActivationFunction" ) == "Fast";
+    Brain::config().fixedInitWeight = doc.get( "FixedInitSynapseWeight" );
+    Brain::config().gaussianInitWeight = doc.get( "GaussianInitSynapseWeight" );
+    Brain::config().gaussianInitMaxStdev = doc.get( "GaussianInitSynapseWeightMaxStdev" );
+    Brain::config().maxWeight = doc.get( "MaxSynapseWeight" );
+    Brain::config().initMaxWeight = doc.get( "MaxSynapseWeightInitial" );
+
+    Brain::config().enableLearning = Brain::config().learningMode != Brain::Configuration::LEARN_NONE;
+    Brain::config().minlrate = doc.get( "MinLearningRate" );
+    Brain::config().maxlrate = doc.get( "MaxLearningRate" );
+
+    Brain::config().maxsynapse2energy = doc.get( "EnergyUseSynapses" );
+    Brain::config().decayRate = doc.get( "SynapseWeightDecayRate" );
 
  	// Set up retina values
-	Brain::config.minWin = doc.get( "RetinaWidth" );
+	Brain::config().minWin = doc.get( "RetinaWidth" );
 
 	GroupsBrain::processWorldfile( doc );
 	SheetsBrain::processWorldfile( doc );
@@ -126,18 +138,21 @@ void Brain::processWorldfile( proplib::Document &doc )
 //---------------------------------------------------------------------------
 void Brain::init()
 {
-    Brain::config.retinaWidth = std::max(Brain::config.minWin, GroupsBrain::config.maxvisneurpergroup);
+    Brain::config().retinaWidth = std::max(Brain::config().minWin, GroupsBrain::config().maxvisneurpergroup);
 
-    if (Brain::config.retinaWidth & 1)
-        Brain::config.retinaWidth++;  // keep it even for efficiency (so I'm told)
+    if (Brain::config().retinaWidth & 1)
+        Brain::config().retinaWidth++;  // keep it even for efficiency (so I'm told)
 
-    Brain::config.retinaHeight = Brain::config.minWin;
+    Brain::config().retinaHeight = Brain::config().minWin;
 
-    if (Brain::config.retinaHeight & 1)
-        Brain::config.retinaHeight++;
+    if (Brain::config().retinaHeight & 1)
+        Brain::config().retinaHeight++;
 
 	GroupsBrain::init();
 	SheetsBrain::init();
+
+	Activation::setMode( Brain::config().fastActivation ? Activation::FAST : Activation::EXACT );
+	FiringRateModel::selectUpdateKernels();
 }
 
 //---------------------------------------------------------------------------
@@ -162,6 +177,14 @@ Brain::~Brain()
 	delete _renderer;
 }
 
+//---------------------------------------------------------------------------
+// Brain::regrow
+//---------------------------------------------------------------------------
+bool Brain::regrow( genome::Genome * )
+{
+	return false;
+}
+
 //---------------------------------------------------------------------------
 // Brain::dumpAnatomical
 //---------------------------------------------------------------------------
@@ -169,7 +192,7 @@ void Brain::dumpAnatomical( AbstractFile *file, long index, float fitness )
 {
 	// print the header, with index, fitness, and number of neurons
 	file->printf( "brain %ld fitness=%g numneurons+1=%d maxWeight=%g maxBias=%g",
-				  index, fitness, _dims.numNeurons+1, Brain::config.maxWeight, Brain::config.maxbias );
+				  index, fitness, _dims.numNeurons+1, Brain::config().maxWeight, Brain::config().maxbias );
 
 	_cns->dumpAnatomical( file );
 	file->printf( "\n" );
@@ -191,7 +214,7 @@ void Brain::startFunctional( AbstractFile *file, long index )
 	_neuralnet->startFunctional( file );
 
 	// print timestep born
-	file->printf( " %ld", TSimulation::fStep );
+	file->printf( " %ld", SimulationContext::current()->simulation->getStep() );
 
 	// print organs portion
 	_cns->startFunctional( file );
@@ -221,7 +244,7 @@ void Brain::writeFunctional( AbstractFile *file )
 void Brain::dumpSynapses( AbstractFile *file, long index )
 {
 	file->printf( "synapses %ld maxweight=%g numsynapses=%ld numneurons=%d numinputneurons=%d numoutputneurons=%d\n",
-				  index, Brain::config.maxWeight, _dims.numSynapses, _dims.numNeurons, _dims.numInputNeurons, _dims.numOutputNeurons );
+				  index, Brain::config().maxWeight, _dims.numSynapses, _dims.numNeurons, _dims.numInputNeurons, _dims.numOutputNeurons );
 	_neuralnet->dumpSynapses( file );
 }
 
@@ -267,7 +290,7 @@ void Brain::prebirth()
 {
     // now send some signals through the system
     // try pure noise for now...
-    for( int i = 0; i < Brain::config.numPrebirthCycles; i++ )
+    for( int i = 0; i < Brain::config().numPrebirthCycles; i++ )
     {
 		_cns->prebirthSignal();
 
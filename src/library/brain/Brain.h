@@ -48,7 +48,7 @@ class NeuronModel;
 class LIBRARY_SHARED Brain
 {
 public:
-	static struct Configuration
+	struct Configuration
 	{
 		enum
 		{
@@ -61,6 +61,8 @@ public:
 			TAU_GAIN,
 			SPIKING
 		} neuronModel;
+		bool compactStorage;
+		bool compactHalfLrate;
 		enum
 		{
 			LEARN_NONE,
@@ -97,6 +99,7 @@ public:
 		bool synapseFromInputToOutputNeurons;
 		long numPrebirthCycles;
 		float logisticSlope;
+		bool fastActivation;
 		bool fixedInitWeight;
 		bool gaussianInitWeight;
 		float gaussianInitMaxStdev;
@@ -111,7 +114,8 @@ public:
 		short retinaHeight;
 		float maxsynapse2energy; // (amount if all synapses usable)
 		float maxneuron2energy;
-	} config;
+	};
+	static Configuration &config();
 
 	static void processWorldfile( proplib::Document &doc );
 	static void init();
@@ -119,6 +123,10 @@ public:
     Brain( NervousSystem *cns );
     virtual ~Brain();
 
+	// Rebuilds the brain in place for a new genome, reusing its storage.
+	// Returns false when the architecture can't, and a new brain is needed.
+	virtual bool regrow( genome::Genome *g );
+
 	void prebirth();
     void update( bool bprint );
 
@@ -127,6 +135,7 @@ public:
     float getEnergyUse();
     short getNumNeurons();
 	long  getNumSynapses();
+	size_t getMemoryFootprint();
 	NeuronModel::Dimensions getDimensions();
 	NeuronModel *getNeuronModel();
 
@@ -165,6 +174,7 @@ protected:
 inline float Brain::getEnergyUse() { return _energyUse; }
 inline short Brain::getNumNeurons() { return _dims.numNeurons; }
 inline long Brain::getNumSynapses() { return _dims.numSynapses; }
+inline size_t Brain::getMemoryFootprint() { return _neuralnet->getMemoryFootprint(); }
 inline NeuronModel::Dimensions Brain::getDimensions() { return _dims; }
 inline NeuronModel *Brain::getNeuronModel() { return _neuralnet; }
 inline void Brain::getActivations( double *activations, int start, int count ) { _neuralnet->getActivations( activations, start, count ); }
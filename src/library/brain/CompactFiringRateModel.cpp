@@ -0,0 +1,588 @@
+#include "CompactFiringRateModel.h"
+
+#include <assert.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <algorithm>
+
+#include "Brain.h"
+#include "Nerve.h"
+#include "NervousSystem.h"
+#include "sim/debug.h"
+#include "utils/AbstractFile.h"
+#include "utils/Activation.h"
+#include "utils/misc.h"
+
+//---------------------------------------------------------------------------
+// IEEE 754 binary16 conversion (round to nearest even).
+//---------------------------------------------------------------------------
+static uint16_t float_to_half( float f )
+{
+	uint32_t x;
+	memcpy( &x, &f, sizeof(x) );
+
+	uint32_t sign = (x >> 16) & 0x8000;
+	int32_t exp = ((x >> 23) & 0xff) - 127 + 15;
+	uint32_t mant = x & 0x7fffff;
+
+	if( ((x >> 23) & 0xff) == 0xff )
+		return sign | 0x7c00 | (mant ? 0x200 : 0);	// inf/nan
+	if( exp >= 0x1f )
+		return sign | 0x7c00;						// overflow
+	if( exp <= 0 )
+	{
+		if( exp < -10 )
+			return sign;							// underflow to zero
+		mant |= 0x800000;
+		uint32_t shift = 14 - exp;
+		uint32_t half = mant >> shift;
+		uint32_t rem = mant & ((1u << shift) - 1);
+		uint32_t mid = 1u << (shift - 1);
+		if( (rem > mid) || ((rem == mid) && (half & 1)) )
+			half++;
+		return sign | half;
+	}
+
+	uint32_t half = sign | (exp << 10) | (mant >> 13);
+	uint32_t rem = mant & 0x1fff;
+	if( (rem > 0x1000) || ((rem == 0x1000) && (half & 1)) )
+		half++;
+	return half;
+}
+
+static float half_to_float( uint16_t h )
+{
+	uint32_t sign = (uint32_t)(h & 0x8000) << 16;
+	uint32_t exp = (h >> 10) & 0x1f;
+	uint32_t mant = h & 0x3ff;
+	uint32_t x;
+
+	if( exp == 0 )
+	{
+		if( mant == 0 )
+			x = sign;
+		else
+		{
+			// subnormal
+			exp = 127 - 15 + 1;
+			while( !(mant & 0x400) )
+			{
+				mant <<= 1;
+				exp--;
+			}
+			mant &= 0x3ff;
+			x = sign | (exp << 23) | (mant << 13);
+		}
+	}
+	else if( exp == 0x1f )
+		x = sign | 0x7f800000 | (mant << 13);
+	else
+		x = sign | ((exp - 15 + 127) << 23) | (mant << 13);
+
+	float f;
+	memcpy( &f, &x, sizeof(f) );
+	return f;
+}
+
+//---------------------------------------------------------------------------
+// CompactFiringRateModel::CompactFiringRateModel
+//---------------------------------------------------------------------------
+CompactFiringRateModel::CompactFiringRateModel( NervousSystem *cns, bool halfLrate )
+{
+	this->cns = cns;
+	this->halfLrate = halfLrate;
+
+	dims = NULL;
+	neuron = NULL;
+	activation = NULL;
+	newactivation = NULL;
+	rowstart = NULL;
+	fromneuron = NULL;
+	efficacy = NULL;
+	lrate.f32 = NULL;
+	pendingToneuron = NULL;
+	pendingStorage = NULL;
+
+	neuronCapacity = 0;
+	activationCapacity = 0;
+	newactivationCapacity = 0;
+	rowstartCapacity = 0;
+	fromneuronCapacity = 0;
+	efficacyCapacity = 0;
+	lrateCapacity = 0;
+	pendingStorageCapacity = 0;
+}
+
+//---------------------------------------------------------------------------
+// CompactFiringRateModel::~CompactFiringRateModel
+//---------------------------------------------------------------------------
+CompactFiringRateModel::~CompactFiringRateModel()
+{
+	free( neuron );
+	free( activation );
+	free( newactivation );
+	free( rowstart );
+	free( fromneuron );
+	free( efficacy );
+	free( lrate.f32 );
+	free( pendingStorage );
+}
+
+//---------------------------------------------------------------------------
+// CompactFiringRateModel::init
+//---------------------------------------------------------------------------
+void CompactFiringRateModel::init( Dimensions *dims,
+								   double initial_activation )
+{
+	this->dims = dims;
+
+	assert( dims->numNeurons <= 0xffff );
+
+#define __ALLOC(NAME, N) allocZeroed( NAME, NAME##Capacity, N );
+
+	__ALLOC( neuron, dims->numNeurons );
+	__ALLOC( activation, dims->numNeurons );
+	__ALLOC( newactivation, dims->numNeurons );
+
+	__ALLOC( rowstart, dims->numNeurons + 1 );
+	__ALLOC( fromneuron, dims->numSynapses );
+	__ALLOC( efficacy, dims->numSynapses );
+	if( halfLrate )
+	{
+		allocZeroed( lrate.f16, lrateCapacity, dims->numSynapses );
+	}
+	else
+	{
+		allocZeroed( lrate.f32, lrateCapacity, dims->numSynapses );
+	}
+	__ALLOC( pendingStorage, dims->numSynapses );
+	pendingToneuron = pendingStorage;
+
+#undef __ALLOC
+
+	citfor( NervousSystem::NerveList, cns->getNerves(), it )
+	{
+		Nerve *nerve = *it;
+
+		nerve->config( &(this->activation), &(this->newactivation) );
+	}
+
+	for( int i = 0; i < dims->numNeurons; i++ )
+		activation[i] = initial_activation;
+}
+
+//---------------------------------------------------------------------------
+// CompactFiringRateModel::set_neuron
+//
+// Synapse ranges are derived from the synapses' postsynaptic neurons, so
+// startsynapses/endsynapses are not needed.
+//---------------------------------------------------------------------------
+void CompactFiringRateModel::set_neuron( int index,
+										 void *attributes,
+										 int startsynapses,
+										 int endsynapses )
+{
+	NeuronAttrs *attrs = (NeuronAttrs *)attributes;
+	Neuron &n = neuron[index];
+
+	assert( !isnan(attrs->bias) );
+	assert( !isnan(attrs->tau) );
+	assert( !isnan(attrs->gain) );
+
+	n.bias = attrs->bias;
+	n.tau = attrs->tau;
+	n.gain = attrs->gain;
+}
+
+void CompactFiringRateModel::set_neuron_endsynapses( int index,
+													 int endsynapses )
+{
+}
+
+//---------------------------------------------------------------------------
+// CompactFiringRateModel::get_synapse
+//---------------------------------------------------------------------------
+void CompactFiringRateModel::get_synapse( int index,
+										  short &from,
+										  short &to,
+										  float &efficacy,
+										  float &lrate )
+{
+	finalize();
+
+	// row containing index
+	to = short( std::upper_bound(rowstart, rowstart + dims->numNeurons + 1, index) - rowstart - 1 );
+	from = fromneuron[index];
+	efficacy = this->efficacy[index];
+	lrate = getLrate( index );
+}
+
+//---------------------------------------------------------------------------
+// CompactFiringRateModel::set_synapse
+//---------------------------------------------------------------------------
+void CompactFiringRateModel::set_synapse( int index,
+										  int from,
+										  int to,
+										  float efficacy,
+										  float lrate )
+{
+	assert( !isnan(efficacy) );
+	assert( !isnan(lrate) );
+	assert( (from >= 0) && (from < dims->numNeurons) );
+	assert( (to >= 0) && (to < dims->numNeurons) );
+
+	unfinalize();
+
+	fromneuron[index] = (uint16_t)from;
+	pendingToneuron[index] = (short)to;
+	this->efficacy[index] = efficacy;
+	setLrate( index, lrate );
+}
+
+//---------------------------------------------------------------------------
+// CompactFiringRateModel::finalize
+//
+// Sorts synapses (stably) by postsynaptic neuron and builds row pointers.
+// Synapses grown by GroupsBrain and SheetsBrain are already in row order,
+// in which case this is a single counting pass.
+//---------------------------------------------------------------------------
+void CompactFiringRateModel::finalize()
+{
+	if( pendingToneuron == NULL )
+		return;
+
+	int numneurons = dims->numNeurons;
+	long numsynapses = dims->numSynapses;
+
+	memset( rowstart, 0, sizeof(int32_t) * (numneurons + 1) );
+
+	bool sorted = true;
+	for( long k = 0; k < numsynapses; k++ )
+	{
+		rowstart[ pendingToneuron[k] + 1 ]++;
+		if( (k > 0) && (pendingToneuron[k] < pendingToneuron[k - 1]) )
+			sorted = false;
+	}
+	for( int i = 0; i < numneurons; i++ )
+		rowstart[i + 1] += rowstart[i];
+
+	if( !sorted )
+	{
+		uint16_t *newfrom = (uint16_t *)malloc( sizeof(uint16_t) * numsynapses );
+		float *newefficacy = (float *)malloc( sizeof(float) * numsynapses );
+		float *newlrate = (float *)malloc( sizeof(float) * numsynapses );
+		int32_t *next = (int32_t *)malloc( sizeof(int32_t) * numneurons );
+		assert( newfrom && newefficacy && newlrate && next );
+
+		memcpy( next, rowstart, sizeof(int32_t) * numneurons );
+		for( long k = 0; k < numsynapses; k++ )
+		{
+			int32_t dst = next[ pendingToneuron[k] ]++;
+			newfrom[dst] = fromneuron[k];
+			newefficacy[dst] = efficacy[k];
+			newlrate[dst] = getLrate( k );
+		}
+
+		memcpy( fromneuron, newfrom, sizeof(uint16_t) * numsynapses );
+		memcpy( efficacy, newefficacy, sizeof(float) * numsynapses );
+		for( long k = 0; k < numsynapses; k++ )
+			setLrate( k, newlrate[k] );
+
+		free( newfrom );
+		free( newefficacy );
+		free( newlrate );
+		free( next );
+	}
+
+	pendingToneuron = NULL;
+}
+
+//---------------------------------------------------------------------------
+// CompactFiringRateModel::unfinalize
+//---------------------------------------------------------------------------
+void CompactFiringRateModel::unfinalize()
+{
+	if( pendingToneuron != NULL )
+		return;
+
+	allocZeroed( pendingStorage, pendingStorageCapacity, std::max(dims->numSynapses, 1L) );
+	pendingToneuron = pendingStorage;
+
+	for( int i = 0; i < dims->numNeurons; i++ )
+		for( int32_t k = rowstart[i]; k < rowstart[i + 1]; k++ )
+			pendingToneuron[k] = (short)i;
+}
+
+//---------------------------------------------------------------------------
+// CompactFiringRateModel::getLrate/setLrate
+//---------------------------------------------------------------------------
+inline float CompactFiringRateModel::getLrate( long k )
+{
+	return halfLrate ? half_to_float( lrate.f16[k] ) : lrate.f32[k];
+}
+
+inline void CompactFiringRateModel::setLrate( long k, float value )
+{
+	if( halfLrate )
+	{
+		uint16_t h = float_to_half( value );
+		// The sign of lrate selects excitatory/inhibitory clamping, so tiny
+		// inhibitory rates must not flush to (signless) zero.
+		if( ((h & 0x7fff) == 0) && (value < 0.0f) )
+			h = 0x8001;
+		lrate.f16[k] = h;
+	}
+	else
+		lrate.f32[k] = value;
+}
+
+//---------------------------------------------------------------------------
+// CompactFiringRateModel accessors
+//---------------------------------------------------------------------------
+bool CompactFiringRateModel::is_allocated()
+{
+	return (neuron != NULL) && (rowstart != NULL);
+}
+
+float CompactFiringRateModel::get_neuron_bias( int index )
+{
+	return neuron[index].bias;
+}
+
+double CompactFiringRateModel::get_activation( int index )
+{
+	return activation[index];
+}
+
+double CompactFiringRateModel::get_new_activation( int index )
+{
+	return newactivation[index];
+}
+
+//---------------------------------------------------------------------------
+// CompactFiringRateModel::getMemoryFootprint
+//---------------------------------------------------------------------------
+size_t CompactFiringRateModel::getMemoryFootprint()
+{
+	size_t n = dims->numNeurons;
+	size_t s = dims->numSynapses;
+
+	return sizeof(Neuron) * n
+		+ 2 * sizeof(float) * n
+		+ sizeof(int32_t) * (n + 1)
+		+ (sizeof(uint16_t) + sizeof(float) + (halfLrate ? sizeof(uint16_t) : sizeof(float))) * s
+		+ (pendingToneuron ? sizeof(short) * s : 0);
+}
+
+//---------------------------------------------------------------------------
+// CompactFiringRateModel::update
+//---------------------------------------------------------------------------
+void CompactFiringRateModel::update( bool bprint )
+{
+	debugcheck( "(compact firing-rate brain) on entry" );
+
+	if( (neuron == NULL) || (activation == NULL) )
+		return;
+
+	finalize();
+
+	int numneurons = dims->numNeurons;
+	int firstOutputNeuron = dims->getFirstOutputNeuron();
+	bool tauGain = Brain::config().neuronModel == Brain::Configuration::TAU_GAIN;
+	float logisticSlope = Brain::config().logisticSlope;
+
+	for( int i = 0; i < firstOutputNeuron; i++ )
+		newactivation[i] = activation[i];
+
+	for( int i = firstOutputNeuron; i < numneurons; i++ )
+	{
+		float sum = neuron[i].bias;
+		for( int32_t k = rowstart[i], end = rowstart[i + 1]; k < end; k++ )
+			sum += efficacy[k] * activation[ fromneuron[k] ];
+
+		if( tauGain )
+		{
+			float tau = neuron[i].tau;
+			newactivation[i] = (1.0f - tau) * activation[i] + tau * (float)Activation::logistic( sum, neuron[i].gain );
+		}
+		else
+		{
+			newactivation[i] = (float)Activation::logistic( sum, logisticSlope );
+		}
+	}
+
+	debugcheck( "after updating neurons" );
+
+	if( Brain::config().enableLearning && !cns->getBrain()->isFrozen() )
+	{
+		float maxWeight = Brain::config().maxWeight;
+		float halfMaxWeight = 0.5f * maxWeight;
+		float decay = 1.0f - Brain::config().decayRate;
+
+		for( int i = firstOutputNeuron; i < numneurons; i++ )
+		{
+			float post = newactivation[i] - 0.5f;
+
+			for( int32_t k = rowstart[i], end = rowstart[i + 1]; k < end; k++ )
+			{
+				float learningrate = getLrate( k );
+				float eff = efficacy[k] + learningrate * post * (activation[ fromneuron[k] ] - 0.5f);
+
+				if( fabs(eff) > halfMaxWeight )
+				{
+					eff *= 1.0f - decay * (fabs(eff) - halfMaxWeight) / halfMaxWeight;
+					if( eff > maxWeight )
+						eff = maxWeight;
+					else if( eff < -maxWeight )
+						eff = -maxWeight;
+				}
+				else
+				{
+					if( learningrate >= 0.0f )  // excitatory
+						eff = std::max( 0.0f, eff );
+					else  // inhibitory
+						eff = std::min( -1.e-10f, eff );
+				}
+
+				efficacy[k] = eff;
+			}
+		}
+	}
+
+	debugcheck( "after updating synapses" );
+
+	float *saveactivation = activation;
+	activation = newactivation;
+	newactivation = saveactivation;
+}
+
+//---------------------------------------------------------------------------
+// CompactFiringRateModel::getActivations/setActivations
+//---------------------------------------------------------------------------
+void CompactFiringRateModel::getActivations( double *activations, int start, int count )
+{
+	for( int i = 0; i < count; i++ )
+		activations[i] = activation[start + i];
+}
+
+void CompactFiringRateModel::setActivations( double *activations, int start, int count )
+{
+	for( int i = 0; i < count; i++ )
+		activation[start + i] = (float)activations[i];
+}
+
+void CompactFiringRateModel::randomizeActivations()
+{
+	for( int i = 0; i < dims->numNeurons; i++ )
+		activation[i] = randpw();
+}
+
+//---------------------------------------------------------------------------
+// CompactFiringRateModel::dumpAnatomical
+//
+// Same format as BaseNeuronModel::dumpAnatomical.
+//---------------------------------------------------------------------------
+void CompactFiringRateModel::dumpAnatomical( AbstractFile *file )
+{
+	finalize();
+
+	int numneurons = dims->numNeurons;
+	float maxWeight = std::max( Brain::config().maxWeight, Brain::config().maxbias );
+	double inverseMaxWeight = 1. / maxWeight;
+	size_t dimCM = (numneurons + 1) * (numneurons + 1);	// +1 for bias neuron
+
+	float *connectionMatrix = (float *)calloc( sizeof(*connectionMatrix), dimCM );
+	if( !connectionMatrix )
+	{
+		fprintf( stderr, "%s: unable to alloca connectionMatrix\n", __FUNCTION__ );
+		return;
+	}
+
+	// columns correspond to presynaptic "from-neurons"
+	// rows correspond to postsynaptic "to-neurons"
+	for( int i = 0; i < numneurons; i++ )
+	{
+		for( int32_t k = rowstart[i]; k < rowstart[i + 1]; k++ )
+			connectionMatrix[ fromneuron[k] + i * (numneurons + 1) ] += efficacy[k];
+
+		// bias
+		connectionMatrix[ numneurons + i * (numneurons + 1) ] = neuron[i].bias;
+	}
+
+	for( int i = 0; i <= numneurons; i++ )
+	{
+		for( int j = 0; j <= numneurons; j++ )
+			file->printf( "%+06.4f ", connectionMatrix[j + i * (numneurons + 1)] * inverseMaxWeight );
+		file->printf( ";\n" );
+	}
+
+	free( connectionMatrix );
+}
+
+//---------------------------------------------------------------------------
+// CompactFiringRateModel::startFunctional/writeFunctional
+//---------------------------------------------------------------------------
+void CompactFiringRateModel::startFunctional( AbstractFile *file )
+{
+	file->printf( " %d %d %d %ld",
+				  dims->numNeurons, dims->numInputNeurons, dims->numOutputNeurons, dims->numSynapses );
+}
+
+void CompactFiringRateModel::writeFunctional( AbstractFile *file )
+{
+	for( int i = 0; i < dims->numNeurons; i++ )
+		file->printf( "%d %g\n", i, (double)activation[i] );
+}
+
+//---------------------------------------------------------------------------
+// CompactFiringRateModel::dumpSynapses
+//---------------------------------------------------------------------------
+void CompactFiringRateModel::dumpSynapses( AbstractFile *file )
+{
+	finalize();
+
+	for( int i = 0; i < dims->numNeurons; i++ )
+		for( int32_t k = rowstart[i]; k < rowstart[i + 1]; k++ )
+			file->printf( "%hd %hd %g %g\n", (short)fromneuron[k], (short)i, efficacy[k], getLrate(k) );
+}
+
+//---------------------------------------------------------------------------
+// CompactFiringRateModel::loadSynapses
+//---------------------------------------------------------------------------
+void CompactFiringRateModel::loadSynapses( AbstractFile *file )
+{
+	for( long k = 0; k < dims->numSynapses; k++ )
+	{
+		short from, to;
+		float eff, lr;
+		int rc = file->scanf( "%hd %hd %g %g", &from, &to, &eff, &lr );
+		assert( rc == 4 );
+		set_synapse( k, from, to, eff, lr );
+	}
+	finalize();
+}
+
+//---------------------------------------------------------------------------
+// CompactFiringRateModel::copySynapses
+//---------------------------------------------------------------------------
+void CompactFiringRateModel::copySynapses( NeuronModel *other )
+{
+	for( long k = 0; k < dims->numSynapses; k++ )
+	{
+		short from, to;
+		float eff, lr;
+		other->get_synapse( k, from, to, eff, lr );
+		set_synapse( k, from, to, eff, lr );
+	}
+	finalize();
+}
+
+//---------------------------------------------------------------------------
+// CompactFiringRateModel::scaleSynapses
+//---------------------------------------------------------------------------
+void CompactFiringRateModel::scaleSynapses( float factor )
+{
+	for( long k = 0; k < dims->numSynapses; k++ )
+		efficacy[k] *= factor;
+}
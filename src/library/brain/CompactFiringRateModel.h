@@ -0,0 +1,122 @@
+#pragma once
+
+#include <stdint.h>
+
+#include "FiringRateModel.h"
+#include "NeuronModel.h"
+
+// forward decls
+class NervousSystem;
+
+// Compact storage for the firing-rate/tau-gain models:
+//
+//   - float activations instead of double
+//   - CSR row pointers (numNeurons + 1) instead of per-neuron start/end
+//   - 16-bit presynaptic indices; the postsynaptic index is implicit in the row
+//   - optionally, learning rates stored as IEEE half floats
+//
+// Synapses may be set in any order during growth; they are sorted into rows
+// the first time the network is used.
+struct CompactFiringRateModel__Neuron
+{
+	float bias;
+	float tau;
+	float gain;
+};
+
+typedef FiringRateModel__NeuronAttrs CompactFiringRateModel__NeuronAttrs;
+
+class CompactFiringRateModel : public NeuronModel
+{
+	typedef CompactFiringRateModel__Neuron Neuron;
+	typedef CompactFiringRateModel__NeuronAttrs NeuronAttrs;
+
+ public:
+	CompactFiringRateModel( NervousSystem *cns, bool halfLrate );
+	virtual ~CompactFiringRateModel();
+
+	virtual void init( Dimensions *dims,
+					   double initial_activation );
+
+	virtual void set_neuron( int index,
+							 void *attributes,
+							 int startsynapses,
+							 int endsynapses );
+	virtual void set_neuron_endsynapses( int index,
+										 int endsynapses );
+	virtual void get_synapse( int index,
+							  short &from,
+							  short &to,
+							  float &efficacy,
+							  float &lrate );
+	virtual void set_synapse( int index,
+							  int from,
+							  int to,
+							  float efficacy,
+							  float lrate );
+
+	virtual bool is_allocated();
+	virtual float get_neuron_bias( int index );
+	virtual double get_activation( int index );
+	virtual double get_new_activation( int index );
+
+	virtual size_t getMemoryFootprint();
+
+	virtual void update( bool bprint );
+
+	virtual void getActivations( double *activations, int start, int count );
+	virtual void setActivations( double *activations, int start, int count );
+	virtual void randomizeActivations();
+
+	virtual void dumpAnatomical( AbstractFile *file );
+
+	virtual void startFunctional( AbstractFile *file );
+	virtual void writeFunctional( AbstractFile *file );
+
+	virtual void dumpSynapses( AbstractFile *file );
+	virtual void loadSynapses( AbstractFile *file );
+	virtual void copySynapses( NeuronModel *other );
+	virtual void scaleSynapses( float factor );
+
+ private:
+	void finalize();
+	void unfinalize();
+	float getLrate( long k );
+	void setLrate( long k, float lrate );
+
+ public:
+	NervousSystem *cns;
+	Dimensions *dims;
+
+ private:
+	bool halfLrate;
+
+	Neuron *neuron;
+	float *activation;
+	float *newactivation;
+
+	int32_t *rowstart;
+	uint16_t *fromneuron;
+	float *efficacy;
+	union
+	{
+		float *f32;
+		uint16_t *f16;
+	} lrate;
+
+	// Only non-NULL while synapses are being (re)assigned, when it points
+	// at pendingStorage.
+	short *pendingToneuron;
+	short *pendingStorage;
+
+	// Elements allocated, kept across init()s. update() swaps the
+	// activation buffers, which is fine since init() always sizes them alike.
+	long neuronCapacity;
+	long activationCapacity;
+	long newactivationCapacity;
+	long rowstartCapacity;
+	long fromneuronCapacity;
+	long efficacyCapacity;
+	long lrateCapacity;
+	long pendingStorageCapacity;
+};
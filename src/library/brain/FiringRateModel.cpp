@@ -3,6 +3,8 @@
 #include "genome/Genome.h"
 #include "genome/GenomeSchema.h"
 #include "sim/debug.h"
+#include "sim/SimulationContext.h"
+#include "utils/Activation.h"
 #include "utils/misc.h"
 
 using namespace genome;
@@ -14,6 +16,16 @@ using namespace genome;
 	#define GaussianActivationVariance (GaussianActivationStandardDeviation * GaussianActivationStandardDeviation)
 #endif
 
+FiringRateModel::Kernels &FiringRateModel::kernels()
+{
+	return SimulationContext::current()->get<Kernels>();
+}
+
+bool &FiringRateModel::useSpecializedKernels()
+{
+	return kernels().useSpecialized;
+}
+
 
 FiringRateModel::FiringRateModel( NervousSystem *cns )
 : BaseNeuronModel<Neuron, NeuronAttrs, Synapse>( cns )
@@ -49,7 +61,114 @@ void FiringRateModel::set_neuron( int index,
 	n.gain = attrs->gain;
 }
 
+// The neuron model and learning switches are fixed for the whole run, so
+// rather than testing them for every neuron on every step we pick a kernel
+// with those branches compiled out. Only isFrozen() can change during a
+// brain's life, which update() resolves once per call.
+void FiringRateModel::selectUpdateKernels()
+{
+	Kernels &k = kernels();
+
+	if( !k.useSpecialized )
+	{
+		k.learning = k.frozen = &FiringRateModel::updateGeneric;
+		return;
+	}
+
+	bool tauGain = Brain::config().neuronModel == Brain::Configuration::TAU_GAIN;
+	bool learning = Brain::config().enableLearning;
+
+	if( tauGain )
+	{
+		k.frozen = &FiringRateModel::updateSpecialized<true, false>;
+		k.learning = learning ? &FiringRateModel::updateSpecialized<true, true> : k.frozen;
+	}
+	else
+	{
+		k.frozen = &FiringRateModel::updateSpecialized<false, false>;
+		k.learning = learning ? &FiringRateModel::updateSpecialized<false, true> : k.frozen;
+	}
+}
+
 void FiringRateModel::update( bool bprint )
+{
+	Kernels &k = kernels();
+	UpdateKernel kernel = cns->getBrain()->isFrozen() ? k.frozen : k.learning;
+
+	(this->*kernel)( bprint );
+}
+
+// Must produce results identical to updateGeneric. Net inputs are gathered
+// first so the transfer function can be applied to the whole range in one
+// (possibly vectorized) batch.
+template<bool TauGain, bool Learning>
+void FiringRateModel::updateSpecialized( bool bprint )
+{
+	debugcheck( "(firing-rate brain) on entry" );
+
+	if ((neuron == NULL) || (synapse == NULL) || (neuronactivation == NULL))
+		return;
+
+	const int numneurons = dims->numNeurons;
+	const int firstOutputNeuron = dims->getFirstOutputNeuron();
+#if GaussianOutputNeurons
+	const int firstLogisticNeuron = dims->getFirstInternalNeuron();
+#else
+	const int firstLogisticNeuron = firstOutputNeuron;
+#endif
+	const float logisticSlope = Brain::config().logisticSlope;
+
+	for( int i = 0; i < firstOutputNeuron; i++ )
+	{
+		newneuronactivation[i] = neuronactivation[i];
+	}
+
+	for( int i = firstOutputNeuron; i < numneurons; i++ )
+	{
+		const Neuron &n = neuron[i];
+
+		double newactivation = n.bias;
+		for( long k = n.startsynapses; k < n.endsynapses; k++ )
+		{
+			newactivation += synapse[k].efficacy *
+				neuronactivation[synapse[k].fromneuron];
+		}
+
+	#if GaussianOutputNeurons
+		if( i < firstLogisticNeuron )
+		{
+			newneuronactivation[i] = gaussian( newactivation, GaussianActivationMean, GaussianActivationVariance );
+			continue;
+		}
+	#endif
+
+		// logistic(x, slope) == logistic(x * slope, 1)
+		if( TauGain )
+			newneuronactivation[i] = newactivation * n.gain;
+		else
+			newneuronactivation[i] = newactivation * logisticSlope;
+	}
+
+	Activation::logistic( newneuronactivation + firstLogisticNeuron, numneurons - firstLogisticNeuron );
+
+	if( TauGain )
+	{
+		for( int i = firstLogisticNeuron; i < numneurons; i++ )
+		{
+			float tau = neuron[i].tau;
+			newneuronactivation[i] = (1.0 - tau) * neuronactivation[i]  +  tau * newneuronactivation[i];
+		}
+	}
+
+    debugcheck( "after updating neurons" );
+
+	if( Learning )
+		learn();
+
+	swapActivations();
+}
+
+void FiringRateModel::updateGeneric( bool bprint )
 {
     debugcheck( "(firing-rate brain) on entry" );
 
@@ -90,21 +209,21 @@ void FiringRateModel::update( bool bprint )
 	#if GaussianOutputNeurons
         newneuronactivation[i] = gaussian( newneuronactivation[i], GaussianActivationMean, GaussianActivationVariance );
 	#else
-		if( Brain::config.neuronModel == Brain::Configuration::TAU_GAIN )
+		if( Brain::config().neuronModel == Brain::Configuration::TAU_GAIN )
 		{
 			float tau = neuron[i].tau;
 			float gain = neuron[i].gain;
-			newneuronactivation[i] = (1.0 - tau) * neuronactivation[i]  +  tau * logistic( newneuronactivation[i], gain );
+			newneuronactivation[i] = (1.0 - tau) * neuronactivation[i]  +  tau * Activation::logistic( newneuronactivation[i], gain );
 		}
 		else
 		{
-			newneuronactivation[i] = logistic( newneuronactivation[i], Brain::config.logisticSlope );
+			newneuronactivation[i] = Activation::logistic( newneuronactivation[i], Brain::config().logisticSlope );
 		}
 	#endif
 	}
 
 	long numneurons = dims->numNeurons;
-	float logisticSlope = Brain::config.logisticSlope;
+	float logisticSlope = Brain::config().logisticSlope;
     for( i = dims->getFirstInternalNeuron(); i < numneurons; i++ )
     {
 		double newactivation = neuron[i].bias;
@@ -113,17 +232,17 @@ void FiringRateModel::update( bool bprint )
             newactivation += synapse[k].efficacy *
                neuronactivation[synapse[k].fromneuron];
 		}
-        //newneuronactivation[i] = logistic(newneuronactivation[i], Brain::config.logisticSlope);
+        //newneuronactivation[i] = logistic(newneuronactivation[i], Brain::config().logisticSlope);
 
-		if( Brain::config.neuronModel == Brain::Configuration::TAU_GAIN )
+		if( Brain::config().neuronModel == Brain::Configuration::TAU_GAIN )
 		{
 			float tau = neuron[i].tau;
 			float gain = neuron[i].gain;
-			newactivation = (1.0 - tau) * neuronactivation[i]  +  tau * logistic( newactivation, gain );
+			newactivation = (1.0 - tau) * neuronactivation[i]  +  tau * Activation::logistic( newactivation, gain );
 		}
 		else
 		{
-			newactivation = logistic( newactivation, logisticSlope );
+			newactivation = Activation::logistic( newactivation, logisticSlope );
 		}
 
         newneuronactivation[i] = newactivation;
@@ -140,48 +259,56 @@ void FiringRateModel::update( bool bprint )
 
 //	printf( "yaw activation = %g\n", newneuronactivation[yawneuron] );
 
-    if (Brain::config.enableLearning && !cns->getBrain()->isFrozen())
+	if (Brain::config().enableLearning && !cns->getBrain()->isFrozen())
+		learn();
+
+	swapActivations();
+}
+
+void FiringRateModel::learn()
+{
+    float learningrate;
+    long numsynapses = dims->numSynapses;
+    for (long k = 0; k < numsynapses; k++)
     {
-        float learningrate;
-		long numsynapses = dims->numSynapses;
-        for (k = 0; k < numsynapses; k++)
-        {
-			FiringRateModel__Synapse &syn = synapse[k];
+        FiringRateModel__Synapse &syn = synapse[k];
 
-			learningrate = syn.lrate;
+        learningrate = syn.lrate;
 
-			float efficacy = syn.efficacy + learningrate
-				* (newneuronactivation[syn.toneuron]-0.5)
-				* (   neuronactivation[syn.fromneuron]-0.5);
+        float efficacy = syn.efficacy + learningrate
+            * (newneuronactivation[syn.toneuron]-0.5)
+            * (   neuronactivation[syn.fromneuron]-0.5);
 
-            if (fabs(efficacy) > (0.5f * Brain::config.maxWeight))
-            {
-                efficacy *= 1.0f - (1.0f - Brain::config.decayRate) *
-                    (fabs(efficacy) - 0.5f * Brain::config.maxWeight) / (0.5f * Brain::config.maxWeight);
-                if (efficacy > Brain::config.maxWeight)
-                    efficacy = Brain::config.maxWeight;
-                else if (efficacy < -Brain::config.maxWeight)
-                    efficacy = -Brain::config.maxWeight;
-            }
-            else
-            {
+        if (fabs(efficacy) > (0.5f * Brain::config().maxWeight))
+        {
+            efficacy *= 1.0f - (1.0f - Brain::config().decayRate) *
+                (fabs(efficacy) - 0.5f * Brain::config().maxWeight) / (0.5f * Brain::config().maxWeight);
+            if (efficacy > Brain::config().maxWeight)
+                efficacy = Brain::config().maxWeight;
+            else if (efficacy < -Brain::config().maxWeight)
+                efficacy = -Brain::config().maxWeight;
+        }
+        else
+        {
 #define MIN(x,y) ((x) < (y) ? (x) : (y))
 #define MAX(x,y) ((x) > (y) ? (x) : (y))
-                // not strictly correct for this to be in an else clause,
-                // but if lrate is reasonable, efficacy should never change
-                // sign with a new magnitude greater than 0.5 * Brain::config.maxWeight
-                if (learningrate >= 0.0f)  // excitatory
-                    efficacy = MAX(0.0f, efficacy);
-                if (learningrate < 0.0f)  // inhibitory
-                    efficacy = MIN(-1.e-10f, efficacy);
-            }
-
-			syn.efficacy = efficacy;
+            // not strictly correct for this to be in an else clause,
+            // but if lrate is reasonable, efficacy should never change
+            // sign with a new magnitude greater than 0.5 * Brain::config().maxWeight
+            if (learningrate >= 0.0f)  // excitatory
+                efficacy = MAX(0.0f, efficacy);
+            if (learningrate < 0.0f)  // inhibitory
+                efficacy = MIN(-1.e-10f, efficacy);
         }
+
+        syn.efficacy = efficacy;
     }
 
     debugcheck( "after updating synapses" );
+}
 
+void FiringRateModel::swapActivations()
+{
     double* saveneuronactivation = neuronactivation;
     neuronactivation = newneuronactivation;
     newneuronactivation = saveneuronactivation;
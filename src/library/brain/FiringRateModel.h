@@ -52,4 +52,27 @@ class FiringRateModel : public BaseNeuronModel<FiringRateModel__Neuron, FiringRa
 							 int endsynapses );
 
 	virtual void update( bool bprint );
+
+	// Chooses update kernels for the current Brain::config(). Called once from
+	// Brain::init; call again after changing useSpecializedKernels.
+	static void selectUpdateKernels();
+	static bool &useSpecializedKernels();
+
+ private:
+	typedef void (FiringRateModel::*UpdateKernel)( bool bprint );
+
+	void updateGeneric( bool bprint );
+	template<bool TauGain, bool Learning>
+	void updateSpecialized( bool bprint );
+	void learn();
+	void swapActivations();
+
+	// Selected per simulation.
+	struct Kernels
+	{
+		bool useSpecialized = true;
+		UpdateKernel learning = &FiringRateModel::updateGeneric;
+		UpdateKernel frozen = &FiringRateModel::updateGeneric;
+	};
+	static Kernels &kernels();
 };
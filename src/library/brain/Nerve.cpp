@@ -12,6 +12,7 @@ Nerve::Nerve( Type _type,
 , index(-1)
 {
 	memset( activations, 0, sizeof(activations) );
+	memset( factivations, 0, sizeof(factivations) );
 }
 
 double Nerve::get( int ineuron,
@@ -22,6 +23,8 @@ double Nerve::get( int ineuron,
 
 	assert( (ineuron >= 0) && (ineuron < numneurons) && (index > -1) );
 
+	if( factivations[buf] )
+		return (*(factivations[buf]))[index + ineuron];
 	return (*(activations[buf]))[index + ineuron];
 }
 
@@ -42,7 +45,10 @@ void Nerve::set( int ineuron,
 {
 	assert( (ineuron >= 0) && (ineuron < numneurons) && (index > -1) );
 
-	(*(activations[buf]))[index + ineuron] = activation;
+	if( factivations[buf] )
+		(*(factivations[buf]))[index + ineuron] = (float)activation;
+	else
+		(*(activations[buf]))[index + ineuron] = activation;
 }
 
 int Nerve::getIndex()
@@ -68,3 +74,10 @@ void Nerve::config( double **_activations,
 	activations[CURRENT] = _activations;
 	activations[SWAP] = _activations_swap;
 }
+
+void Nerve::config( float **_activations,
+					float **_activations_swap )
+{
+	factivations[CURRENT] = _activations;
+	factivations[SWAP] = _activations_swap;
+}
@@ -45,9 +45,12 @@ class Nerve
 				 int index );
 	void config( double **activations,
 				 double **activations_swap );
+	void config( float **activations,
+				 float **activations_swap );
 
  private:
 	int numneurons;
 	double **activations[__NBUFFERS];
+	float **factivations[__NBUFFERS];
 	int index;
 };
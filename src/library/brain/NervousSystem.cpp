@@ -14,8 +14,11 @@ using namespace genome;
 
 
 NervousSystem::NervousSystem()
+: b( NULL )
 {
 	rng = RandomNumberGenerator::create( RandomNumberGenerator::NERVOUS_SYSTEM );
+	for( int role = 0; role < RandomNumberGenerator::__NROLES; role++ )
+		roleRngs[role] = NULL;
 }
 
 NervousSystem::~NervousSystem()
@@ -24,13 +27,28 @@ NervousSystem::~NervousSystem()
 		delete *it;
 
 	RandomNumberGenerator::dispose( rng );
+	for( int role = 0; role < RandomNumberGenerator::__NROLES; role++ )
+		if( roleRngs[role] )
+			RandomNumberGenerator::dispose( roleRngs[role] );
 
 	delete b;
 }
 
+// Readies a recycled agent's nervous system for another grow(). Nerves and
+// brain are kept: createNerve() hands back the existing nerves, and the brain
+// is regrown into its own storage where it can be.
+void NervousSystem::reset()
+{
+	sensors.clear();
+}
+
 void NervousSystem::grow( Genome *g )
 {
-	b = g->createBrain( this );
+	if( !b || !b->regrow(g) )
+	{
+		delete b;
+		b = g->createBrain( this );
+	}
 
 	for( SensorList::iterator
 			 it = sensors.begin(),
@@ -71,8 +89,23 @@ RandomNumberGenerator *NervousSystem::getRNG()
 	return rng;
 }
 
+RandomNumberGenerator *NervousSystem::getRNG( RandomNumberGenerator::Role role )
+{
+	if( !roleRngs[role] )
+		roleRngs[role] = RandomNumberGenerator::create( role );
+
+	return roleRngs[role];
+}
+
 Nerve *NervousSystem::createNerve( Nerve::Type type, const std::string &name )
 {
+	NerveMap::iterator it = map.find( name );
+	if( it != map.end() && it->second )
+	{
+		assert( it->second->type == type );
+		return it->second;
+	}
+
 	Nerve *nerve = new Nerve( type,
 							  name,
 							  all.size() );
@@ -9,10 +9,10 @@
 #include "Nerve.h"
 #include "Sensor.h"
 #include "library_global.h"
+#include "utils/RandomNumberGenerator.h"
 
 class AbstractFile;
 class Brain;
-class RandomNumberGenerator;
 namespace genome
 {
 	class Genome;
@@ -27,10 +27,14 @@ class LIBRARY_SHARED NervousSystem
 	NervousSystem();
 	virtual ~NervousSystem();
 
+	void reset();
 	virtual void grow( genome::Genome *g );
 	void update( bool bprint );
 
 	RandomNumberGenerator *getRNG();
+	// Kept for the life of the nervous system, across recycling, so the
+	// caller must seed it before drawing.
+	RandomNumberGenerator *getRNG( RandomNumberGenerator::Role role );
 	Brain *getBrain();
 	float getEnergyUse();
 
@@ -54,6 +58,7 @@ class LIBRARY_SHARED NervousSystem
  protected:
 	Brain *b;
 	RandomNumberGenerator *rng;
+	RandomNumberGenerator *roleRngs[RandomNumberGenerator::__NROLES];
 
 	typedef std::map<std::string, Nerve *> NerveMap;
 	NerveMap map;
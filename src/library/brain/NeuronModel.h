@@ -1,6 +1,10 @@
 #pragma once
 
+#include <assert.h>
+#include <stddef.h>
 #include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
 
 #include <iostream>
 
@@ -57,6 +61,16 @@ class NeuronModel
 							  float efficacy,
 							  float lrate ) = 0;
 
+	// Read-only accessors for renderers and loggers, independent of the
+	// model's storage layout.
+	virtual bool is_allocated() = 0;
+	virtual float get_neuron_bias( int index ) = 0;
+	virtual double get_activation( int index ) = 0;
+	virtual double get_new_activation( int index ) = 0;
+
+	// Bytes of heap owned by the model (neurons, activations, synapses).
+	virtual size_t getMemoryFootprint() = 0;
+
 	virtual void update( bool bprint ) = 0;
 
 	virtual void getActivations( double *activations, int start, int count ) = 0;
@@ -72,4 +86,23 @@ class NeuronModel
 	virtual void loadSynapses( AbstractFile *file ) = 0;
 	virtual void copySynapses( NeuronModel *other ) = 0;
 	virtual void scaleSynapses( float factor ) = 0;
+
+ protected:
+	// Points p at n zeroed elements. A model that is init()'ed again (a
+	// recycled agent's brain) keeps any buffer already holding n elements.
+	template<typename T>
+	static void allocZeroed( T *&p, long &capacity, long n )
+	{
+		if( p && (n <= capacity) )
+		{
+			memset( p, 0, n * sizeof(T) );
+		}
+		else
+		{
+			free( p );
+			p = (T *)calloc( n, sizeof(T) );
+			assert( p );
+			capacity = n;
+		}
+	}
 };
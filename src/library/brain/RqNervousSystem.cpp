@@ -20,15 +20,15 @@ void RqNervousSystem::grow( Genome *g )
 {
 	createInput( "Random" );
 	createInput( "Energy" );
-	if( agent::config.enableMateWaitFeedback )
+	if( agent::config().enableMateWaitFeedback )
 	{
 		createInput( "MateWaitFeedback" );
 	}
-	if( agent::config.enableSpeedFeedback )
+	if( agent::config().enableSpeedFeedback )
 	{
 		createInput( "SpeedFeedback" );
 	}
-	if( agent::config.enableCarry )
+	if( agent::config().enableCarry )
 	{
 		createInput( "Carrying" );
 		createInput( "BeingCarried" );
@@ -42,28 +42,28 @@ void RqNervousSystem::grow( Genome *g )
 	createOutput( "Fight" );
 	createOutput( "Speed" );
 	createOutput( "Yaw" );
-	if( agent::config.yawEncoding == agent::YE_OPPOSE )
+	if( agent::config().yawEncoding == agent::YE_OPPOSE )
 	{
 		createOutput( "YawOppose" );
 	}
-	if( agent::config.hasLightBehavior )
+	if( agent::config().hasLightBehavior )
 	{
 		createOutput( "Light" );
 	}
 	createOutput( "Focus" );
-	if( agent::config.enableVisionPitch )
+	if( agent::config().enableVisionPitch )
 	{
 		createOutput( "VisionPitch" );
 	}
-	if( agent::config.enableVisionYaw )
+	if( agent::config().enableVisionYaw )
 	{
 		createOutput( "VisionYaw" );
 	}
-	if( agent::config.enableGive )
+	if( agent::config().enableGive )
 	{
 		createOutput( "Give" );
 	}
-	if( agent::config.enableCarry )
+	if( agent::config().enableCarry )
 	{
 		createOutput( "Pickup" );
 		createOutput( "Drop" );
@@ -17,6 +17,7 @@ SpikingModel::SpikingModel( NervousSystem *cns, float scale_latest_spikes_ )
 	this->rng = cns->getRNG();
 
 	outputActivation = NULL;
+	outputActivationCapacity = 0;
 }
 
 SpikingModel::~SpikingModel()
@@ -24,13 +25,14 @@ SpikingModel::~SpikingModel()
 	free( outputActivation );
 }
 
-void SpikingModel::init_derived( double initial_activation )
+void SpikingModel::setScaleLatestSpikes( float scale_latest_spikes_ )
 {
-#define ALLOC(NAME, TYPE, N) if(NAME) free(NAME); NAME = (TYPE *)calloc(N, sizeof(TYPE)); assert(NAME);
-
-	ALLOC( outputActivation, double, dims->numOutputNeurons );
+	scale_latest_spikes = scale_latest_spikes_;
+}
 
-#undef ALLOC
+void SpikingModel::init_derived( double initial_activation )
+{
+	allocZeroed( outputActivation, outputActivationCapacity, dims->numOutputNeurons );
 
 	// TODO: initial_activation is currently ignored for backwards-compatibility
 	for( int i = 0; i < dims->numNeurons; i++ )
@@ -40,7 +42,7 @@ void SpikingModel::init_derived( double initial_activation )
 
 	for( int i = 0; i < dims->numOutputNeurons; i++ )
 	{
-		outputActivation[i]= 0.0;	// fmax((double)neuron[acc+dims->getFirstOutputNeuron()].bias / brain::Brain::config.maxbias, 0.0);
+		outputActivation[i]= 0.0;	// fmax((double)neuron[acc+dims->getFirstOutputNeuron()].bias / brain::Brain::config().maxbias, 0.0);
 	}
 }
 
@@ -332,14 +334,14 @@ void SpikingModel::update( bool bprint )
 	}//end brainsteps
 
 
-	if (Brain::config.enableLearning && !cns->getBrain()->isFrozen())
+	if (Brain::config().enableLearning && !cns->getBrain()->isFrozen())
 	{
 		//now this is where learning actually takes place.  It's here that we take the delta's we've been modifying
 		//this whole time and actually use them to modify the efficacy of the synapses.  The reason we wait to modify
 		//the actual synapse efficacies until all brain steps is complete is two fold one Izhikevich does it and two
 		//for the sake of efficiency.
 		float learningrate;
-		// float half_max_weight = .5f * Brain::config.maxWeight, one_minus_decay = 1. - Brain::config.decayRate;
+		// float half_max_weight = .5f * Brain::config().maxWeight, one_minus_decay = 1. - Brain::config().decayRate;
 
         for (k = 0; k < dims->numSynapses; k++)
         {
@@ -350,14 +352,14 @@ void SpikingModel::update( bool bprint )
 			else
 				synapse[k].efficacy -= (.01 + synapse[k].delta * learningrate);
 
-            if (fabs(synapse[k].efficacy) > (0.5f * Brain::config.maxWeight))
+            if (fabs(synapse[k].efficacy) > (0.5f * Brain::config().maxWeight))
             {
-                synapse[k].efficacy *= 1.0f - (1.0f - Brain::config.decayRate) *
-                    (fabs(synapse[k].efficacy) - 0.5f * Brain::config.maxWeight) / (0.5f * Brain::config.maxWeight);
-                if (synapse[k].efficacy > Brain::config.maxWeight)
-                    synapse[k].efficacy = Brain::config.maxWeight;
-                else if (synapse[k].efficacy < -Brain::config.maxWeight)
-                    synapse[k].efficacy = -Brain::config.maxWeight;
+                synapse[k].efficacy *= 1.0f - (1.0f - Brain::config().decayRate) *
+                    (fabs(synapse[k].efficacy) - 0.5f * Brain::config().maxWeight) / (0.5f * Brain::config().maxWeight);
+                if (synapse[k].efficacy > Brain::config().maxWeight)
+                    synapse[k].efficacy = Brain::config().maxWeight;
+                else if (synapse[k].efficacy < -Brain::config().maxWeight)
+                    synapse[k].efficacy = -Brain::config().maxWeight;
             }
             else
             {
@@ -374,8 +376,8 @@ void SpikingModel::update( bool bprint )
 			if (synapse[k].efficacy >= 0)
 			{
 				synapse[k].efficacy += .01 + synapse[k].delta * learningrate;// * delta t; need a delta t
-				if (synapse[k].efficacy > Brain::config.maxWeight)
-                    synapse[k].efficacy = Brain::config.maxWeight - (one_minus_decay);
+				if (synapse[k].efficacy > Brain::config().maxWeight)
+                    synapse[k].efficacy = Brain::config().maxWeight - (one_minus_decay);
 				else if (synapse[k].efficacy > half_max_weight)
 					synapse[k].efficacy *= 1.0f - (one_minus_decay) * (synapse[k].efficacy - half_max_weight) / (half_max_weight);
 				else
@@ -384,8 +386,8 @@ void SpikingModel::update( bool bprint )
 			else
 			{
 				synapse[k].efficacy -= .01 + synapse[k].delta * learningrate;
-				if (synapse[k].efficacy < -Brain::config.maxWeight)
-                    synapse[k].efficacy = -Brain::config.maxWeight + (one_minus_decay);
+				if (synapse[k].efficacy < -Brain::config().maxWeight)
+                    synapse[k].efficacy = -Brain::config().maxWeight + (one_minus_decay);
 				else if(synapse[k].efficacy < -half_max_weight)
 				//fix me later should be a      +
 					synapse[k].efficacy *= 1.0f - one_minus_decay * (fabs(synapse[k].efficacy) - half_max_weight) / half_max_weight;
@@ -64,6 +64,8 @@ class SpikingModel : public BaseNeuronModel<SpikingModel__Neuron, SpikingModel__
 	SpikingModel( NervousSystem *cns, float scale_latest_spikes );
 	virtual ~SpikingModel();
 
+	void setScaleLatestSpikes( float scale_latest_spikes );
+
 	virtual void init_derived( double initial_activation );
 
 	virtual void set_neuron( int index,
@@ -79,4 +81,5 @@ class SpikingModel : public BaseNeuronModel<SpikingModel__Neuron, SpikingModel__
 	float scale_latest_spikes;
 
 	double *outputActivation;
+	long outputActivationCapacity;
 };
@@ -2,11 +2,13 @@
 
 #include "GroupsNeuralNetRenderer.h"
 #include "agent/agent.h"
+#include "brain/CompactFiringRateModel.h"
 #include "brain/FiringRateModel.h"
 #include "brain/NervousSystem.h"
 #include "brain/SpikingModel.h"
 #include "genome/groups/GroupsGenome.h"
 #include "sim/globals.h"
+#include "sim/SimulationContext.h"
 #include "utils/error.h"
 #include "utils/misc.h"
 #include "utils/RandomNumberGenerator.h"
@@ -32,7 +34,13 @@ static float initminweight = 0.0; // could read this in
 	ALLOC_STACK_BUFFER( iiremainder, float );							\
 	ALLOC_STACK_BUFFER( ieremainder, float )
 
-GroupsBrain::Configuration GroupsBrain::config;
+//---------------------------------------------------------------------------
+// GroupsBrain::config
+//---------------------------------------------------------------------------
+GroupsBrain::Configuration &GroupsBrain::config()
+{
+	return SimulationContext::current()->get<Configuration>();
+}
 
 
 //---------------------------------------------------------------------------
@@ -40,29 +48,29 @@ GroupsBrain::Configuration GroupsBrain::config;
 //---------------------------------------------------------------------------
 void GroupsBrain::processWorldfile( proplib::Document &doc )
 {
-    GroupsBrain::config.minvisneurpergroup = doc.get( "MinVisionNeuronsPerGroup" );
-    GroupsBrain::config.maxvisneurpergroup = doc.get( "MaxVisionNeuronsPerGroup" );
-    GroupsBrain::config.seedvisneur = doc.get( "SeedVisionNeurons" );
-    GroupsBrain::config.mininternalneurgroups = doc.get( "MinInternalNeuralGroups" );
-    GroupsBrain::config.maxinternalneurgroups = doc.get( "MaxInternalNeuralGroups" );
-    GroupsBrain::config.orderedinternalneurgroups = doc.get( "OrderedInternalNeuralGroups" );
-    GroupsBrain::config.mineneurpergroup = doc.get( "MinExcitatoryNeuronsPerGroup" );
-    GroupsBrain::config.maxeneurpergroup = doc.get( "MaxExcitatoryNeuronsPerGroup" );
-    GroupsBrain::config.minineurpergroup = doc.get( "MinInhibitoryNeuronsPerGroup" );
-    GroupsBrain::config.maxineurpergroup = doc.get( "MaxInhibitoryNeuronsPerGroup" );
-    GroupsBrain::config.minconnectiondensity = doc.get( "MinConnectionDensity" );
-    GroupsBrain::config.maxconnectiondensity = doc.get( "MaxConnectionDensity" );
-    GroupsBrain::config.simpleseedconnectiondensity = doc.get( "SimpleSeedConnectionDensity" );
-    GroupsBrain::config.simpleseedioconnectiondensity = doc.get( "SimpleSeedIOConnectionDensity" );
-    GroupsBrain::config.mirroredtopologicaldistortion = doc.get( "MirroredTopologicalDistortion" );
-    GroupsBrain::config.mintopologicaldistortion = doc.get( "MinTopologicalDistortion" );
-    GroupsBrain::config.maxtopologicaldistortion = doc.get( "MaxTopologicalDistortion" );
-	GroupsBrain::config.enableTopologicalDistortionRngSeed = doc.get( "EnableTopologicalDistortionRngSeed" );
-	GroupsBrain::config.minTopologicalDistortionRngSeed = doc.get( "MinTopologicalDistortionRngSeed" );
-	GroupsBrain::config.maxTopologicalDistortionRngSeed = doc.get( "MaxTopologicalDistortionRngSeed" );
-	GroupsBrain::config.enableInitWeightRngSeed = doc.get( "EnableInitWeightRngSeed" );
-	GroupsBrain::config.minInitWeightRngSeed = doc.get( "MinInitWeightRngSeed" );
-	GroupsBrain::config.maxInitWeightRngSeed = doc.get( "MaxInitWeightRngSeed" );
+    GroupsBrain::config().minvisneurpergroup = doc.get( "MinVisionNeuronsPerGroup" );
+    GroupsBrain::config().maxvisneurpergroup = doc.get( "MaxVisionNeuronsPerGroup" );
+    GroupsBrain::config().seedvisneur = doc.get( "SeedVisionNeurons" );
+    GroupsBrain::config().mininternalneurgroups = doc.get( "MinInternalNeuralGroups" );
+    GroupsBrain::config().maxinternalneurgroups = doc.get( "MaxInternalNeuralGroups" );
+    GroupsBrain::config().orderedinternalneurgroups = doc.get( "OrderedInternalNeuralGroups" );
+    GroupsBrain::config().mineneurpergroup = doc.get( "MinExcitatoryNeuronsPerGroup" );
+    GroupsBrain::config().maxeneurpergroup = doc.get( "MaxExcitatoryNeuronsPerGroup" );
+    GroupsBrain::config().minineurpergroup = doc.get( "MinInhibitoryNeuronsPerGroup" );
+    GroupsBrain::config().maxineurpergroup = doc.get( "MaxInhibitoryNeuronsPerGroup" );
+    GroupsBrain::config().minconnectiondensity = doc.get( "MinConnectionDensity" );
+    GroupsBrain::config().maxconnectiondensity = doc.get( "MaxConnectionDensity" );
+    GroupsBrain::config().simpleseedconnectiondensity = doc.get( "SimpleSeedConnectionDensity" );
+    GroupsBrain::config().simpleseedioconnectiondensity = doc.get( "SimpleSeedIOConnectionDensity" );
+    GroupsBrain::config().mirroredtopologicaldistortion = doc.get( "MirroredTopologicalDistortion" );
+    GroupsBrain::config().mintopologicaldistortion = doc.get( "MinTopologicalDistortion" );
+    GroupsBrain::config().maxtopologicaldistortion = doc.get( "MaxTopologicalDistortion" );
+	GroupsBrain::config().enableTopologicalDistortionRngSeed = doc.get( "EnableTopologicalDistortionRngSeed" );
+	GroupsBrain::config().minTopologicalDistortionRngSeed = doc.get( "MinTopologicalDistortionRngSeed" );
+	GroupsBrain::config().maxTopologicalDistortionRngSeed = doc.get( "MaxTopologicalDistortionRngSeed" );
+	GroupsBrain::config().enableInitWeightRngSeed = doc.get( "EnableInitWeightRngSeed" );
+	GroupsBrain::config().minInitWeightRngSeed = doc.get( "MinInitWeightRngSeed" );
+	GroupsBrain::config().maxInitWeightRngSeed = doc.get( "MaxInitWeightRngSeed" );
 }
 
 //---------------------------------------------------------------------------
@@ -76,49 +84,49 @@ void GroupsBrain::init()
 								RandomNumberGenerator::LOCAL );
 
 	int numinputneurgroups = 5;
-	if( agent::config.enableMateWaitFeedback )
+	if( agent::config().enableMateWaitFeedback )
 		numinputneurgroups++;
-	if( agent::config.enableSpeedFeedback )
+	if( agent::config().enableSpeedFeedback )
 		numinputneurgroups++;
-	if( agent::config.enableCarry )
+	if( agent::config().enableCarry )
 		numinputneurgroups += 2;
-	config.numinputneurgroups = numinputneurgroups;
+	config().numinputneurgroups = numinputneurgroups;
 
 	int numoutneurgroups = 6;
-	if( agent::config.yawEncoding == agent::YE_OPPOSE )
+	if( agent::config().yawEncoding == agent::YE_OPPOSE )
 		numoutneurgroups++;
-	if( agent::config.hasLightBehavior )
+	if( agent::config().hasLightBehavior )
 		numoutneurgroups++;
-	if( agent::config.enableVisionPitch )
+	if( agent::config().enableVisionPitch )
 		numoutneurgroups++;
-	if( agent::config.enableVisionYaw )
+	if( agent::config().enableVisionYaw )
 		numoutneurgroups++;
-	if( agent::config.enableGive )
+	if( agent::config().enableGive )
 		numoutneurgroups++;
-	if( agent::config.enableCarry )
+	if( agent::config().enableCarry )
 		numoutneurgroups += 2;
-	config.numoutneurgroups = numoutneurgroups;
+	config().numoutneurgroups = numoutneurgroups;
 
-    config.maxnoninputneurgroups = config.maxinternalneurgroups + config.numoutneurgroups;
-    config.maxneurgroups = config.maxnoninputneurgroups + config.numinputneurgroups;
-    config.maxneurpergroup = config.maxeneurpergroup + config.maxineurpergroup;
-    config.maxinternalneurons = config.maxneurpergroup * config.maxinternalneurgroups;
-    config.maxinputneurons = GroupsBrain::config.maxvisneurpergroup * 3 + (numinputneurgroups - 3);
-    config.maxnoninputneurons = config.maxinternalneurons + config.numoutneurgroups;
-    config.maxneurons = config.maxinternalneurons + config.maxinputneurons + config.numoutneurgroups;
+    config().maxnoninputneurgroups = config().maxinternalneurgroups + config().numoutneurgroups;
+    config().maxneurgroups = config().maxnoninputneurgroups + config().numinputneurgroups;
+    config().maxneurpergroup = config().maxeneurpergroup + config().maxineurpergroup;
+    config().maxinternalneurons = config().maxneurpergroup * config().maxinternalneurgroups;
+    config().maxinputneurons = GroupsBrain::config().maxvisneurpergroup * 3 + (numinputneurgroups - 3);
+    config().maxnoninputneurons = config().maxinternalneurons + config().numoutneurgroups;
+    config().maxneurons = config().maxinternalneurons + config().maxinputneurons + config().numoutneurgroups;
 
     // the 2's are due to the input & output neurons
     //     doubling as e & i presynaptically
     // the 3's are due to the output neurons also acting as e-neurons
     //     postsynaptically, accepting internal connections
     // the -'s are due to the output & internal neurons not self-stimulating
-    config.maxsynapses = config.maxinternalneurons * config.maxinternalneurons 	// internal
-                + 2 * config.numoutneurgroups * config.numoutneurgroups					// output
-                + 3 * config.maxinternalneurons * config.numoutneurgroups       			// internal/output
-                + 2 * config.maxinternalneurons * config.maxinputneurons  				// internal/input
-                + 2 * config.maxinputneurons * config.numoutneurgroups       				// input/output
-                - 2 * config.numoutneurgroups													// output/output
-                - config.maxinternalneurons;                   									// internal/internal
+    config().maxsynapses = config().maxinternalneurons * config().maxinternalneurons 	// internal
+                + 2 * config().numoutneurgroups * config().numoutneurgroups					// output
+                + 3 * config().maxinternalneurons * config().numoutneurgroups       			// internal/output
+                + 2 * config().maxinternalneurons * config().maxinputneurons  				// internal/input
+                + 2 * config().maxinputneurons * config().numoutneurgroups       				// input/output
+                - 2 * config().numoutneurgroups													// output/output
+                - config().maxinternalneurons;                   									// internal/internal
 }
 
 //---------------------------------------------------------------------------
@@ -140,27 +148,61 @@ GroupsBrain::~GroupsBrain()
 {
 }
 
+//---------------------------------------------------------------------------
+// GroupsBrain::regrow
+//---------------------------------------------------------------------------
+bool GroupsBrain::regrow( Genome *g )
+{
+	assert( g == _genome );
+
+	_dims = NeuronModel::Dimensions();
+	_energyUse = 0;
+	_frozen = false;
+
+	grow();
+
+	return true;
+}
+
 //---------------------------------------------------------------------------
 // GroupsBrain::initNeuralNet
 //---------------------------------------------------------------------------
 void GroupsBrain::initNeuralNet( double initial_activation )
 {
-	switch( Brain::config.neuronModel )
+	// A regrown brain keeps its model, and with it the model's storage.
+	if( _neuralnet )
+	{
+		if( Brain::config().neuronModel == Brain::Configuration::SPIKING )
+			((SpikingModel *)_neuralnet)->setScaleLatestSpikes( _genome->get("ScaleLatestSpikes") );
+
+		_neuralnet->init( &_dims, initial_activation );
+		return;
+	}
+
+	switch( Brain::config().neuronModel )
 	{
 	case Brain::Configuration::SPIKING:
 		{
 			SpikingModel *spiking = new SpikingModel( _cns,
 													  _genome->get("ScaleLatestSpikes") );
 			_neuralnet = spiking;
-			_renderer = new GroupsNeuralNetRenderer<SpikingModel>( spiking, _genome );
+			_renderer = new GroupsNeuralNetRenderer<SpikingModel>( spiking, _genome, orderedGroups );
 		}
 		break;
 	case Brain::Configuration::FIRING_RATE:
 	case Brain::Configuration::TAU_GAIN:
+		if( Brain::config().compactStorage )
+		{
+			CompactFiringRateModel *compact = new CompactFiringRateModel( _cns,
+																		  Brain::config().compactHalfLrate );
+			_neuralnet = compact;
+			_renderer = new GroupsNeuralNetRenderer<CompactFiringRateModel>( compact, _genome, orderedGroups );
+		}
+		else
 		{
 			FiringRateModel *firingRate = new FiringRateModel( _cns );
 			_neuralnet = firingRate;
-			_renderer = new GroupsNeuralNetRenderer<FiringRateModel>( firingRate, _genome );
+			_renderer = new GroupsNeuralNetRenderer<FiringRateModel>( firingRate, _genome, orderedGroups );
 		}
 		break;
 	default:
@@ -352,17 +394,17 @@ void GroupsBrain::grow()
     }
 
     _dims.numNeurons = numNonInputNeurons + _dims.numInputNeurons;
-	if( _dims.numNeurons > config.maxneurons )
-		error( 2, "numneurons (", _dims.numNeurons, ") > maxneurons (", config.maxneurons, ") in brain::grow" );
+	if( _dims.numNeurons > config().maxneurons )
+		error( 2, "numneurons (", _dims.numNeurons, ") > maxneurons (", config().maxneurons, ") in brain::grow" );
 
-	if( _dims.numSynapses > config.maxsynapses )
-		error( 2, "numsynapses (", _dims.numSynapses, ") > maxsynapses (", config.maxsynapses, ") in brain::grow" );
+	if( _dims.numSynapses > config().maxsynapses )
+		error( 2, "numsynapses (", _dims.numSynapses, ") > maxsynapses (", config().maxsynapses, ") in brain::grow" );
 
 #if DebugBrainGrow
 	if( DebugBrainGrowPrint )
 	{
-		cout << "numneurons = " << _dims.numNeurons << "  (of " << config.maxneurons pnlf;
-		cout << "numsynapses = " << _dims.numSynapses << "  (of " << config.maxsynapses pnlf;
+		cout << "numneurons = " << _dims.numNeurons << "  (of " << config().maxneurons pnlf;
+		cout << "numsynapses = " << _dims.numSynapses << "  (of " << config().maxsynapses pnlf;
 	}
 #endif
 
@@ -393,7 +435,7 @@ void GroupsBrain::grow()
 		FiringRateModel__NeuronAttrs *firingRate;
 	} neuronAttrs;
 
-	switch( Brain::config.neuronModel )
+	switch( Brain::config().neuronModel )
 	{
 	case Brain::Configuration::SPIKING:
 		neuronAttrs.spiking = (SpikingModel__NeuronAttrs *)alloca( sizeof(SpikingModel__NeuronAttrs) );
@@ -409,7 +451,7 @@ void GroupsBrain::grow()
 	// ---
 	// --- Initialize Input Neuron Activations
 	// ---
-	switch( Brain::config.neuronModel )
+	switch( Brain::config().neuronModel )
 	{
 	case Brain::Configuration::SPIKING:
 		neuronAttrs.spiking->SpikingParameter_a = 0;
@@ -428,7 +470,7 @@ void GroupsBrain::grow()
 		assert(false);
 	}
 
-    for (int i = 0, ineur = 0; i < config.numinputneurgroups; i++)
+    for (int i = 0, ineur = 0; i < config().numinputneurgroups; i++)
     {
         int gi = orderedGroups[i];
         for (int j = 0; j < _genome->getNeuronCount(EXCITATORY, gi); j++, ineur++)
@@ -440,7 +482,7 @@ void GroupsBrain::grow()
 	// ---
 	// --- Grow Synapses
 	// ---
-    for (int groupIndex_to = config.numinputneurgroups; groupIndex_to < _numgroups; groupIndex_to++)
+    for (int groupIndex_to = config().numinputneurgroups; groupIndex_to < _numgroups; groupIndex_to++)
     {
 		int g_groupIndex_to = orderedGroups[groupIndex_to];
 #if DebugBrainGrow
@@ -448,11 +490,11 @@ void GroupsBrain::grow()
 			cout << "For group " << groupIndex_to << ":" nlf;
 #endif
 
-		switch( Brain::config.neuronModel )
+		switch( Brain::config().neuronModel )
 		{
 		case Brain::Configuration::SPIKING:
 			neuronAttrs.spiking->bias = _genome->get(_genome->BIAS,g_groupIndex_to);
-			if(Brain::config.Spiking.enableGenes) {
+			if(Brain::config().Spiking.enableGenes) {
 				neuronAttrs.spiking->SpikingParameter_a = _genome->get(_genome->SPIKING_A, g_groupIndex_to);
 				neuronAttrs.spiking->SpikingParameter_b = _genome->get(_genome->SPIKING_B, g_groupIndex_to);
 				neuronAttrs.spiking->SpikingParameter_c = _genome->get(_genome->SPIKING_C, g_groupIndex_to);
@@ -597,7 +639,7 @@ void GroupsBrain::grow()
 
     if( numsyn != _dims.numSynapses )
 	{
-		if( Brain::config.synapseFromOutputNeurons && Brain::config.synapseFromInputToOutputNeurons )
+		if( Brain::config().synapseFromOutputNeurons && Brain::config().synapseFromInputToOutputNeurons )
 		{
 			if( (numsyn > _dims.numSynapses)
 				|| (( (_dims.numSynapses - numsyn) / float(_dims.numSynapses) ) > 1.e-3) )
@@ -613,8 +655,8 @@ void GroupsBrain::grow()
 	// ---
 	// --- Calculate Energy Use
 	// ---
-    _energyUse = Brain::config.maxneuron2energy * float(_dims.numNeurons) / float(config.maxneurons)
-		+ Brain::config.maxsynapse2energy * float(_dims.numSynapses) / float(config.maxsynapses);
+    _energyUse = Brain::config().maxneuron2energy * float(_dims.numNeurons) / float(config().maxneurons)
+		+ Brain::config().maxsynapse2energy * float(_dims.numSynapses) / float(config().maxsynapses);
 
     debugcheck( "after setting up brain architecture" );
 }
@@ -639,9 +681,9 @@ void GroupsBrain::growSynapses( int groupIndex_to,
 
 	RandomNumberGenerator *td_rng;
 	Gene *td_seedGene;
-	if( config.enableTopologicalDistortionRngSeed )
+	if( config().enableTopologicalDistortionRngSeed )
 	{
-		td_rng = RandomNumberGenerator::create( RandomNumberGenerator::TOPOLOGICAL_DISTORTION );
+		td_rng = _cns->getRNG( RandomNumberGenerator::TOPOLOGICAL_DISTORTION );
 		td_seedGene = _genome->gene( "TopologicalDistortionRngSeed" );
 	}
 	else
@@ -651,9 +693,9 @@ void GroupsBrain::growSynapses( int groupIndex_to,
 	}
 	RandomNumberGenerator *weight_rng;
 	Gene *weight_seedGene;
-	if( config.enableInitWeightRngSeed )
+	if( config().enableInitWeightRngSeed )
 	{
-		weight_rng = RandomNumberGenerator::create( RandomNumberGenerator::INIT_WEIGHT );
+		weight_rng = _cns->getRNG( RandomNumberGenerator::INIT_WEIGHT );
 		weight_seedGene = _genome->gene( "InitWeightRngSeed" );
 	}
 	else
@@ -665,9 +707,9 @@ void GroupsBrain::growSynapses( int groupIndex_to,
 	for (int groupIndex_from = 0; groupIndex_from < _numgroups; groupIndex_from++)
 	{
 		int g_groupIndex_from = orderedGroups[groupIndex_from];
-		if( !Brain::config.synapseFromOutputNeurons && IsOutputNeuralGroup(g_groupIndex_from) )
+		if( !Brain::config().synapseFromOutputNeurons && IsOutputNeuralGroup(g_groupIndex_from) )
 			continue;
-		if( !Brain::config.synapseFromInputToOutputNeurons && IsInputNeuralGroup(g_groupIndex_from) && IsOutputNeuralGroup(g_groupIndex_to) )
+		if( !Brain::config().synapseFromInputToOutputNeurons && IsInputNeuralGroup(g_groupIndex_from) && IsOutputNeuralGroup(g_groupIndex_to) )
 			continue;
 
 		int neuronCount_from = _genome->getNeuronCount(synapseType->nt_from, g_groupIndex_from);
@@ -691,7 +733,7 @@ void GroupsBrain::growSynapses( int groupIndex_to,
 										synapseType,
 										g_groupIndex_from,
 										g_groupIndex_to );
-		if( config.enableTopologicalDistortionRngSeed )
+		if( config().enableTopologicalDistortionRngSeed )
 		{
 			long td_seed = _genome->get( td_seedGene,
 										 synapseType,
@@ -699,7 +741,7 @@ void GroupsBrain::growSynapses( int groupIndex_to,
 										 g_groupIndex_to );
 			td_rng->seed( td_seed );
 		}
-		if( config.enableInitWeightRngSeed )
+		if( config().enableInitWeightRngSeed )
 		{
 			long weight_seed = _genome->get( weight_seedGene,
 											 synapseType,
@@ -712,7 +754,7 @@ void GroupsBrain::growSynapses( int groupIndex_to,
 		// the group as opposed to the entire neuron array.
 		int neuronLocalIndex_fromBase = short((float(neuronLocalIndex_to) / float(neuronCount_to)) * float(neuronCount_from) - float(synapseCount_new) * 0.5);
         neuronLocalIndex_fromBase = std::max<short>(0, std::min<short>(neuronCount_from - synapseCount_new, neuronLocalIndex_fromBase));
-		if( GroupsBrain::config.mirroredtopologicaldistortion && td_fromto >= 0.5 )
+		if( GroupsBrain::config().mirroredtopologicaldistortion && td_fromto >= 0.5 )
 		{
 			neuronLocalIndex_fromBase = (neuronCount_from - 1) - neuronLocalIndex_fromBase;
 		}
@@ -729,7 +771,7 @@ void GroupsBrain::growSynapses( int groupIndex_to,
 
 		{
 			bool legal = true;
-			if (!GroupsBrain::config.mirroredtopologicaldistortion || td_fromto < 0.5)
+			if (!GroupsBrain::config().mirroredtopologicaldistortion || td_fromto < 0.5)
 				legal = neuronLocalIndex_fromBase + synapseCount_new <= neuronCount_from;
 			else
 				legal = neuronLocalIndex_fromBase - synapseCount_new >= -1;
@@ -753,10 +795,10 @@ void GroupsBrain::growSynapses( int groupIndex_to,
 			// the group as opposed to the entire neuron array.
 			int neuronLocalIndex_from;
 
-			if (GroupsBrain::config.mirroredtopologicaldistortion || td_rng->drand() < td_fromto)
+			if (GroupsBrain::config().mirroredtopologicaldistortion || td_rng->drand() < td_fromto)
 			{
 				float td_fromto_abs;
-				if (GroupsBrain::config.mirroredtopologicaldistortion)
+				if (GroupsBrain::config().mirroredtopologicaldistortion)
 				{
 					if (td_fromto < 0.5)
 					{
@@ -813,30 +855,30 @@ void GroupsBrain::growSynapses( int groupIndex_to,
 			assert( neuronIndex_from != neuronIndex_to );
 
 			float efficacy;
-			if( Brain::config.fixedInitWeight )
+			if( Brain::config().fixedInitWeight )
 			{
-				efficacy = Brain::config.initMaxWeight;
+				efficacy = Brain::config().initMaxWeight;
 			}
-			else if( Brain::config.gaussianInitWeight )
+			else if( Brain::config().gaussianInitWeight )
 			{
 				float stdev = _genome->get( _genome->WEIGHT_STDEV,
 											synapseType,
 											g_groupIndex_from,
 											g_groupIndex_to )
-							  * Brain::config.gaussianInitMaxStdev;
+							  * Brain::config().gaussianInitMaxStdev;
 				efficacy = nrand(0.0, stdev);
 				if( efficacy < 0.0 )
 				{
 					efficacy = -efficacy;
 				}
-				if( efficacy > Brain::config.maxWeight )
+				if( efficacy > Brain::config().maxWeight )
 				{
-					efficacy = Brain::config.maxWeight;
+					efficacy = Brain::config().maxWeight;
 				}
 			}
 			else
 			{
-				efficacy = weight_rng->range(initminweight, Brain::config.initMaxWeight);
+				efficacy = weight_rng->range(initminweight, Brain::config().initMaxWeight);
 			}
 			if( synapseType->nt_from == INHIBITORY )
 			{
@@ -844,18 +886,18 @@ void GroupsBrain::growSynapses( int groupIndex_to,
 			}
 
 			float lrate;
-			if( !Brain::config.enableLearning )
+			if( !Brain::config().enableLearning )
 			{
 				lrate = 0;
 			}
-			else if( !Brain::config.outputSynapseLearning
+			else if( !Brain::config().outputSynapseLearning
 					 && (IsOutputNeuralGroup(g_groupIndex_from) || IsOutputNeuralGroup(g_groupIndex_to)) )
 			{
 				lrate = 0;
 			}
-			else if( Brain::config.minlrate == Brain::config.maxlrate )
+			else if( Brain::config().minlrate == Brain::config().maxlrate )
 			{
-				lrate = Brain::config.minlrate;
+				lrate = Brain::config().minlrate;
 				if( synapseType->nt_from == INHIBITORY )
 				{
                     lrate = std::min(-1.e-10f, -lrate);
@@ -878,13 +920,4 @@ void GroupsBrain::growSynapses( int groupIndex_to,
 			synapseCount_brain++;
 		}
 	}
-
-	if( config.enableTopologicalDistortionRngSeed )
-	{
-		RandomNumberGenerator::dispose( td_rng );
-	}
-	if( config.enableInitWeightRngSeed )
-	{
-		RandomNumberGenerator::dispose( weight_rng );
-	}
 }
@@ -11,7 +11,7 @@ namespace genome { class GroupsGenome; }
 class GroupsBrain : public Brain
 {
  public:
-	static struct Configuration
+	struct Configuration
 	{
 		short maxneurons;
 		long maxsynapses;
@@ -49,7 +49,8 @@ class GroupsBrain : public Brain
 		bool enableInitWeightRngSeed;
 		long minInitWeightRngSeed;
 		long maxInitWeightRngSeed;
-	} config;
+	};
+	static Configuration &config();
 
 	static void processWorldfile( proplib::Document &doc );
 	static void init();
@@ -58,6 +59,8 @@ class GroupsBrain : public Brain
 	GroupsBrain( NervousSystem *cns, genome::GroupsGenome *g );
 	virtual ~GroupsBrain();
 
+	virtual bool regrow( genome::Genome *g );
+
 	short NumNeuronGroups( bool ignoreEmpty = true );
 
  private:
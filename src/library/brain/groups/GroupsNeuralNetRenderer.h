@@ -11,10 +11,12 @@ template <typename T_neuronModel>
 class GroupsNeuralNetRenderer : public NeuralNetRenderer
 {
  public:
-	GroupsNeuralNetRenderer( T_neuronModel *neuronModel, genome::GroupsGenome *genome )
+	GroupsNeuralNetRenderer( T_neuronModel *neuronModel,
+							 genome::GroupsGenome *genome,
+							 const std::vector<int> &orderedGroups )
 		: _neuronModel( neuronModel )
 		, _genome( genome )
-		, _orderedGroups( genome->getOrderedGroups() )
+		, _orderedGroups( orderedGroups )
 	{
 	}
 
@@ -27,7 +29,8 @@ class GroupsNeuralNetRenderer : public NeuralNetRenderer
 
 	void render( short patchwidth, short patchheight )
 	{
-		if ((_neuronModel->neuron == NULL) || (_neuronModel->synapse == NULL))
+#if !PW_HEADLESS
+		if( !_neuronModel->is_allocated() )
 			return;
 
 		int numgroups = _genome->getGroupCount(genome::NGT_ANY);
@@ -49,7 +52,7 @@ class GroupsNeuralNetRenderer : public NeuralNetRenderer
 		{
 			// the following reference to "newneuron" really gets the old
 			// values, except for the clamped input neuron values (which are new)
-			const unsigned char mag = (unsigned char)(_neuronModel->newneuronactivation[i] * 255.);
+			const unsigned char mag = (unsigned char)(_neuronModel->get_new_activation(i) * 255.);
 			glColor3ub(mag, mag, mag);
 			glRecti(x1, y1, x1 + patchwidth, y2);
 		}
@@ -61,7 +64,7 @@ class GroupsNeuralNetRenderer : public NeuralNetRenderer
 		x2 = patchwidth;
 		for (i = _neuronModel->dims->getFirstOutputNeuron(), y1 = 2*patchheight; i < _neuronModel->dims->numNeurons; i++, y1 += patchheight)
 		{
-			const unsigned char mag = (unsigned char)((Brain::config.maxWeight + _neuronModel->neuron[i].bias) * 127.5 / Brain::config.maxWeight);
+			const unsigned char mag = (unsigned char)((Brain::config().maxWeight + _neuronModel->get_neuron_bias(i)) * 127.5 / Brain::config().maxWeight);
 			glColor3ub(mag, mag, mag);
 			glRecti(x1, y1, x2, y1 + patchheight);
 		}
@@ -73,7 +76,7 @@ class GroupsNeuralNetRenderer : public NeuralNetRenderer
 		for (i = _neuronModel->dims->getFirstOutputNeuron(), y1 = 2*patchheight; i < _neuronModel->dims->numNeurons;
 			 i++, y1 += patchheight)
 		{
-			const unsigned char mag = (unsigned char)(_neuronModel->neuronactivation[i] * 255.);
+			const unsigned char mag = (unsigned char)(_neuronModel->get_activation(i) * 255.);
 			glColor3ub(mag, mag, mag);
 			glRecti(x1, y1, x2, y1 + patchheight);
 		}
@@ -95,16 +98,20 @@ class GroupsNeuralNetRenderer : public NeuralNetRenderer
 		rPrint( "**************************************************************\n");
 		for (k = 0; k < _neuronModel->dims->numSynapses; k++)
 		{
-			const unsigned char mag = (unsigned char)((Brain::config.maxWeight + _neuronModel->synapse[k].efficacy) * 127.5 / Brain::config.maxWeight);
+			short fromneuron, toneuron;
+			float efficacy, lrate;
+			_neuronModel->get_synapse( k, fromneuron, toneuron, efficacy, lrate );
+
+			const unsigned char mag = (unsigned char)((Brain::config().maxWeight + efficacy) * 127.5 / Brain::config().maxWeight);
 
 			// Fill the rect
 			glColor3ub(mag, mag, mag);
-			x1 = xoff  +   abs(_neuronModel->synapse[k].fromneuron) * patchwidth;
-			y1 = yoff  +  (abs(_neuronModel->synapse[k].toneuron)-_neuronModel->dims->getFirstOutputNeuron()) * patchheight;
+			x1 = xoff  +   abs(fromneuron) * patchwidth;
+			y1 = yoff  +  (abs(toneuron)-_neuronModel->dims->getFirstOutputNeuron()) * patchheight;
 
-			if( abs( _neuronModel->synapse[k].fromneuron ) < _neuronModel->dims->getFirstInternalNeuron() )	// input or output neuron, so it can be both excitatory and inhibitory
+			if( abs( fromneuron ) < _neuronModel->dims->getFirstInternalNeuron() )	// input or output neuron, so it can be both excitatory and inhibitory
 			{
-				if( _neuronModel->synapse[k].efficacy >= 0.0 )	// excitatory
+				if( efficacy >= 0.0 )	// excitatory
 				{
 					// fill it
 					glRecti( x1, y1 + patchheight/2, x1 + patchwidth, y1 + patchheight );
@@ -143,7 +150,7 @@ class GroupsNeuralNetRenderer : public NeuralNetRenderer
 				rPrint( " " );
 
 				// frame it
-				if( _neuronModel->synapse[k].efficacy >= 0.0 )	// excitatory
+				if( efficacy >= 0.0 )	// excitatory
 					glColor3ub( 255, 255, 255 );
 				else	// inhibitory
 					glColor3ub( 0, 0, 0 );
@@ -156,7 +163,7 @@ class GroupsNeuralNetRenderer : public NeuralNetRenderer
 				glEnd();
 			}
 			rPrint( "k = %ld, eff = %5.2f, mag = %d, x1 = %d, y1 = %d, abs(from) = %d, abs(to) = %d, firstOutputNeuron = %d, firstInternalNeuron = %d\n",
-					k, _neuronModel->synapse[k].efficacy, mag, x1, y1, abs(_neuronModel->synapse[k].fromneuron), abs(_neuronModel->synapse[k].toneuron), _neuronModel->dims->getFirstOutputNeuron(), _neuronModel->dims->getFirstInternalNeuron() );
+					k, efficacy, mag, x1, y1, abs(fromneuron), abs(toneuron), _neuronModel->dims->getFirstOutputNeuron(), _neuronModel->dims->getFirstInternalNeuron() );
 		}
 
 		//
@@ -220,7 +227,7 @@ class GroupsNeuralNetRenderer : public NeuralNetRenderer
 		glColor3ub(255, 255, 255);
 		glLineWidth(1.0);
 		x2 = _neuronModel->dims->numInputNeurons * patchwidth + xoff;
-		for (i = GroupsBrain::config.numinputneurgroups; i < numgroups; i++)
+		for (i = GroupsBrain::config().numinputneurgroups; i < numgroups; i++)
 		{
 			short numneur;
 
@@ -241,7 +248,7 @@ class GroupsNeuralNetRenderer : public NeuralNetRenderer
 		x2 = x1 + patchwidth;
 		y2 = yoff;
 
-		for (i = GroupsBrain::config.numinputneurgroups; i < numgroups; i++)
+		for (i = GroupsBrain::config().numinputneurgroups; i < numgroups; i++)
 		{
 			short numneur;
 
@@ -257,10 +264,12 @@ class GroupsNeuralNetRenderer : public NeuralNetRenderer
         	glVertex2i(x1, y2);
 			glEnd();
 		}
+#endif
 	}
 
  private:
 	T_neuronModel *_neuronModel;
 	genome::GroupsGenome *_genome;
-	std::vector<int> _orderedGroups;
+	// The brain's, so it follows a regrow.
+	const std::vector<int> &_orderedGroups;
 };
@@ -2,16 +2,24 @@
 
 #include <assert.h>
 
+#include "brain/CompactFiringRateModel.h"
 #include "brain/FiringRateModel.h"
 #include "brain/NervousSystem.h"
 #include "brain/SpikingModel.h"
 #include "genome/sheets/SheetsGenome.h"
+#include "sim/SimulationContext.h"
 #include "utils/misc.h"
 
 using namespace genome;
 using namespace sheets;
 
-SheetsBrain::Configuration SheetsBrain::config;
+//---------------------------------------------------------------------------
+// SheetsBrain::config
+//---------------------------------------------------------------------------
+SheetsBrain::Configuration &SheetsBrain::config()
+{
+	return SimulationContext::current()->get<Configuration>();
+}
 
 //---------------------------------------------------------------------------
 // SheetsBrain::processWorldfile
@@ -20,31 +28,31 @@ void SheetsBrain::processWorldfile( proplib::Document &doc )
 {
 	proplib::Property &sheets = doc.get( "Sheets" );
 
-	SheetsBrain::config.minBrainSize.x = sheets.get( "MinBrainSize" ).get( "X" );
-	SheetsBrain::config.minBrainSize.y = sheets.get( "MinBrainSize" ).get( "Y" );
-	SheetsBrain::config.minBrainSize.z = sheets.get( "MinBrainSize" ).get( "Z" );
+	SheetsBrain::config().minBrainSize.x = sheets.get( "MinBrainSize" ).get( "X" );
+	SheetsBrain::config().minBrainSize.y = sheets.get( "MinBrainSize" ).get( "Y" );
+	SheetsBrain::config().minBrainSize.z = sheets.get( "MinBrainSize" ).get( "Z" );
 
-	SheetsBrain::config.maxBrainSize.x = sheets.get( "MaxBrainSize" ).get( "X" );
-	SheetsBrain::config.maxBrainSize.y = sheets.get( "MaxBrainSize" ).get( "Y" );
-	SheetsBrain::config.maxBrainSize.z = sheets.get( "MaxBrainSize" ).get( "Z" );
+	SheetsBrain::config().maxBrainSize.x = sheets.get( "MaxBrainSize" ).get( "X" );
+	SheetsBrain::config().maxBrainSize.y = sheets.get( "MaxBrainSize" ).get( "Y" );
+	SheetsBrain::config().maxBrainSize.z = sheets.get( "MaxBrainSize" ).get( "Z" );
 
-	SheetsBrain::config.minSynapseProbabilityX = sheets.get( "MinSynapseProbabilityX" );
-	SheetsBrain::config.maxSynapseProbabilityX = sheets.get( "MaxSynapseProbabilityX" );
+	SheetsBrain::config().minSynapseProbabilityX = sheets.get( "MinSynapseProbabilityX" );
+	SheetsBrain::config().maxSynapseProbabilityX = sheets.get( "MaxSynapseProbabilityX" );
 
-	SheetsBrain::config.minLearningRate = sheets.get( "MinLearningRate" );
-	SheetsBrain::config.maxLearningRate = sheets.get( "MaxLearningRate" );
+	SheetsBrain::config().minLearningRate = sheets.get( "MinLearningRate" );
+	SheetsBrain::config().maxLearningRate = sheets.get( "MaxLearningRate" );
 
-    SheetsBrain::config.minVisionNeuronsPerSheet = sheets.get( "MinVisionNeuronsPerSheet" );
-    SheetsBrain::config.maxVisionNeuronsPerSheet = sheets.get( "MaxVisionNeuronsPerSheet" );
+    SheetsBrain::config().minVisionNeuronsPerSheet = sheets.get( "MinVisionNeuronsPerSheet" );
+    SheetsBrain::config().maxVisionNeuronsPerSheet = sheets.get( "MaxVisionNeuronsPerSheet" );
 
-    SheetsBrain::config.minInternalSheetsCount = sheets.get( "MinInternalSheetsCount" );
-    SheetsBrain::config.maxInternalSheetsCount = sheets.get( "MaxInternalSheetsCount" );
+    SheetsBrain::config().minInternalSheetsCount = sheets.get( "MinInternalSheetsCount" );
+    SheetsBrain::config().maxInternalSheetsCount = sheets.get( "MaxInternalSheetsCount" );
 
-    SheetsBrain::config.minInternalSheetSize = sheets.get( "MinInternalSheetSize" );
-    SheetsBrain::config.maxInternalSheetSize = sheets.get( "MaxInternalSheetSize" );
+    SheetsBrain::config().minInternalSheetSize = sheets.get( "MinInternalSheetSize" );
+    SheetsBrain::config().maxInternalSheetSize = sheets.get( "MaxInternalSheetSize" );
 
-    SheetsBrain::config.minInternalSheetNeuronCount = sheets.get( "MinInternalSheetNeuronCount" );
-    SheetsBrain::config.maxInternalSheetNeuronCount = sheets.get( "MaxInternalSheetNeuronCount" );
+    SheetsBrain::config().minInternalSheetNeuronCount = sheets.get( "MinInternalSheetNeuronCount" );
+    SheetsBrain::config().maxInternalSheetNeuronCount = sheets.get( "MaxInternalSheetNeuronCount" );
 }
 
 //---------------------------------------------------------------------------
@@ -88,8 +96,7 @@ void SheetsBrain::grow( SheetsGenome *genome, SheetsModel *model )
 	// ---
 	// --- Configure Synapse Count
 	// ---
-	itfor( NeuronVector, model->getNeurons(), it )
-		_dims.numSynapses += (int)(*it)->synapsesOut.size();
+	_dims.numSynapses = (int)model->getSynapses().size();
 
 	// ---
 	// --- Configure Input/Output Neurons/Nerves
@@ -149,7 +156,7 @@ void SheetsBrain::grow( SheetsGenome *genome, SheetsModel *model )
 	// --- Instantiate Neural Net
 	// ---
 	{
-		switch( Brain::config.neuronModel )
+		switch( Brain::config().neuronModel )
 		{
 		case Brain::Configuration::SPIKING:
 			{
@@ -160,6 +167,12 @@ void SheetsBrain::grow( SheetsGenome *genome, SheetsModel *model )
 			break;
 		case Brain::Configuration::FIRING_RATE:
 		case Brain::Configuration::TAU_GAIN:
+			if( Brain::config().compactStorage )
+			{
+				_neuralnet = new CompactFiringRateModel( _cns,
+														 Brain::config().compactHalfLrate );
+			}
+			else
 			{
 				FiringRateModel *firingRate = new FiringRateModel( _cns );
 				_neuralnet = firingRate;
@@ -176,6 +189,7 @@ void SheetsBrain::grow( SheetsGenome *genome, SheetsModel *model )
 	// --- Configure Neural Net
 	// ---
 	{
+		SynapseVector &synapses = model->getSynapses();
 		int synapseIndex = 0;
 
 		itfor( NeuronVector, model->getNeurons(), it )
@@ -186,9 +200,9 @@ void SheetsBrain::grow( SheetsGenome *genome, SheetsModel *model )
 									&(neuron->attrs.neuronModel),
 									synapseIndex );
 
-			itfor( SynapseMap, neuron->synapsesIn, it_synapse )
+			while( (synapseIndex < (int)synapses.size()) && (synapses[synapseIndex].to == neuron) )
 			{
-				Synapse *synapse = it_synapse->second;
+				Synapse *synapse = &synapses[synapseIndex];
 
 				_neuralnet->set_synapse( synapseIndex++,
 										 synapse->from->id,
@@ -201,5 +215,7 @@ void SheetsBrain::grow( SheetsGenome *genome, SheetsModel *model )
 
 			_neuralnet->set_neuron_endsynapses( neuron->id, synapseIndex );
 		}
+
+		assert( synapseIndex == (int)synapses.size() );
 	}
 }
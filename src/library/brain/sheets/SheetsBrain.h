@@ -8,7 +8,7 @@ namespace genome { class SheetsGenome; }
 class SheetsBrain : public Brain
 {
  public:
-	static struct Configuration
+	struct Configuration
 	{
 		sheets::Vector3f minBrainSize;
 		sheets::Vector3f maxBrainSize;
@@ -24,7 +24,8 @@ class SheetsBrain : public Brain
 		float maxInternalSheetSize;
 		int minInternalSheetNeuronCount;
 		int maxInternalSheetNeuronCount;
-	} config;
+	};
+	static Configuration &config();
 
 	static void processWorldfile( proplib::Document &doc );
 	static void init();
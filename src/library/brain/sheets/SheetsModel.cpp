@@ -2,6 +2,8 @@
 
 #include <stdlib.h>
 
+#include <algorithm>
+
 #include "utils/misc.h"
 
 using namespace sheets;
@@ -26,18 +28,11 @@ namespace sheets
 // Neuron
 //===========================================================================
 
-bool NeuronKeyCompare::operator()( Neuron *x, Neuron *y ) const
-{
-	return x->nonCulledId < y->nonCulledId;
-}
-
 //---------------------------------------------------------------------------
 // Neuron::~Neuron
 //---------------------------------------------------------------------------
 Neuron::~Neuron()
 {
-	itfor( SynapseMap, synapsesOut, it )
-		delete it->second;
 }
 
 //===========================================================================
@@ -231,6 +226,21 @@ void Sheet::addReceptiveField( ReceptiveFieldRole role,
 	NeuronSubset currentNeurons = findNeurons( currentCenter, currentSize );
 	NeuronSubset otherNeurons = other->findNeurons( otherCenter, otherSize );
 
+	// ---
+	// --- The predicate only depends on the neuron, so evaluate it once for
+	// --- the other sheet's region rather than once per receptive field.
+	// ---
+	int otherSpanB = std::max( 0, otherNeurons._end.b - otherNeurons._begin.b + 1 );
+	std::vector<bool> otherPasses( otherNeurons.size() );
+	for( Vector2i otherNeuronIndex : otherNeurons )
+	{
+		int offset = (otherNeuronIndex.a - otherNeurons._begin.a) * otherSpanB
+			+ (otherNeuronIndex.b - otherNeurons._begin.b);
+		otherPasses[offset] = neuronPredicate( other->getNeuron(otherNeuronIndex), otherNeuronRole );
+	}
+
+	std::vector<Neuron *> fieldNeurons;
+
 	// Iterate over each neuron in this sheet's region.
 	for( Vector2i currentNeuronIndex : currentNeurons )
 	{
@@ -269,7 +279,7 @@ void Sheet::addReceptiveField( ReceptiveFieldRole role,
 		// --- Find which neurons pass the predicate, and determine the mean distance.
 		// ---
 
-		Neuron *fieldNeurons[ constrainedReceptiveFieldNeurons.size() ];
+		fieldNeurons.clear();
 		int nfieldNeurons = 0;
 		float totalDistance = 0;
 
@@ -281,10 +291,13 @@ void Sheet::addReceptiveField( ReceptiveFieldRole role,
 			if( currentNeuron == otherNeuron )
 				continue;
 
-			if( !neuronPredicate(otherNeuron, otherNeuronRole) )
+			int offset = (otherNeuronIndex.a - otherNeurons._begin.a) * otherSpanB
+				+ (otherNeuronIndex.b - otherNeurons._begin.b);
+			if( !otherPasses[offset] )
 				continue;
 
-			fieldNeurons[ nfieldNeurons++ ] = otherNeuron;
+			fieldNeurons.push_back( otherNeuron );
+			nfieldNeurons++;
 			totalDistance += currentNeuron->absPosition.distance( otherNeuron->absPosition );
 		}
 
@@ -315,10 +328,10 @@ void Sheet::addReceptiveField( ReceptiveFieldRole role,
 			switch( role )
 			{
 			case Source:
-				synapse = createSynapse( otherNeuron, currentNeuron );
+				synapse = _sheetsModel->createSynapse( otherNeuron, currentNeuron );
 				break;
 			case Target:
-				synapse = createSynapse( currentNeuron, otherNeuron );
+				synapse = _sheetsModel->createSynapse( currentNeuron, otherNeuron );
 				break;
 			default:
 				assert( false );
@@ -375,8 +388,6 @@ void Sheet::createNeurons( std::function<void (Neuron*)> &neuronCreated )
 			neuron->nonCulledId = _sheetsModel->_numNonCulledNeurons++;
 			neuron->id = -1;
 			neuron->sheetIndex.set( i, j );
-			neuron->cullState.touchedFromInput = false;
-			neuron->cullState.touchedFromOutput = false;
 
 			// ---
 			// --- Compute position within sheet 
@@ -461,29 +472,6 @@ NeuronSubset Sheet::findReceptiveFieldNeurons( const Vector2f &neuronPosition,
 	return findNeurons( center, fieldSize );
 }
 
-//---------------------------------------------------------------------------
-// Sheet::createSynapse
-//---------------------------------------------------------------------------
-Synapse *Sheet::createSynapse( Neuron *from, Neuron *to )
-{
-	if( from == to )
-		return NULL;
-
-	if( from->synapsesOut[to] != NULL )
-		return NULL;
-
-	Synapse *synapse = new Synapse();
-	synapse->from = from;
-	synapse->to = to;
-
-	from->synapsesOut[to] = synapse;
-	to->synapsesIn[from] = synapse;
-
-	trc( "Synapse [" << from->sheet->_id << "] " << from->absPosition << " --> [" << to->sheet->_id << "] " << to->absPosition );
-
-	return synapse;
-}
-
 
 //===========================================================================
 // SheetsModel
@@ -586,31 +574,136 @@ const SheetVector &SheetsModel::getSheets( Sheet::Type type )
 
 //---------------------------------------------------------------------------
 // SheetsModel::cull
+//
+// Keeps the neurons that are reachable from an input neuron and that can
+// reach an output neuron, along with the synapses between them.
 //---------------------------------------------------------------------------
 void SheetsModel::cull()
 {
 	assert( !_inputSheets.empty() );
 	assert( !_outputSheets.empty() );
 
+	int nneurons = _numNonCulledNeurons;
+
+	// ---
+	// --- Sort candidates by (to, from), keeping the first-created synapse
+	// --- of any duplicate pair.
+	// ---
+	std::stable_sort( _synapses.begin(), _synapses.end(),
+					  []( const Synapse &x, const Synapse &y )
+					  {
+						  if( x.to->nonCulledId != y.to->nonCulledId )
+							  return x.to->nonCulledId < y.to->nonCulledId;
+						  return x.from->nonCulledId < y.from->nonCulledId;
+					  } );
+	_synapses.erase( std::unique(_synapses.begin(), _synapses.end(),
+								 []( const Synapse &x, const Synapse &y )
+								 {
+									 return x.to == y.to && x.from == y.from;
+								 }),
+					 _synapses.end() );
+
+	int nsynapses = (int)_synapses.size();
+
+	// ---
+	// --- Build CSR adjacency in both directions.
+	// ---
+	std::vector<int> inStart( nneurons + 1, 0 );
+	std::vector<int> outStart( nneurons + 1, 0 );
+	for( Synapse &syn : _synapses )
+	{
+		inStart[syn.to->nonCulledId + 1]++;
+		outStart[syn.from->nonCulledId + 1]++;
+	}
+	for( int i = 0; i < nneurons; i++ )
+	{
+		inStart[i + 1] += inStart[i];
+		outStart[i + 1] += outStart[i];
+	}
+
+	std::vector<int> outTo( nsynapses );
+	{
+		std::vector<int> cursor( outStart.begin(), outStart.end() - 1 );
+		for( Synapse &syn : _synapses )
+			outTo[ cursor[syn.from->nonCulledId]++ ] = syn.to->nonCulledId;
+	}
+
+	// ---
+	// --- Breadth-first reachability from inputs and, backwards, from outputs.
+	// ---
+	std::vector<bool> touchedFromInput( nneurons, false );
+	std::vector<bool> touchedFromOutput( nneurons, false );
+	std::vector<int> queue;
+	queue.reserve( nneurons );
+
 	for( Sheet *sheet : _inputSheets )
+		for( int i = 0; i < sheet->_nneurons; i++ )
+		{
+			int id = sheet->_neurons[i].nonCulledId;
+			touchedFromInput[id] = true;
+			queue.push_back( id );
+		}
+	for( size_t head = 0; head < queue.size(); head++ )
 	{
-		const Vector2i count = sheet->getNeuronCount();
-		for( int a = 0; a < count.a; a++ )
-			for( int b = 0; b < count.b; b++ )
-				touchFromInput( sheet->getNeuron(a, b) );
+		int id = queue[head];
+		for( int k = outStart[id]; k < outStart[id + 1]; k++ )
+		{
+			int to = outTo[k];
+			if( !touchedFromInput[to] )
+			{
+				touchedFromInput[to] = true;
+				queue.push_back( to );
+			}
+		}
 	}
 
+	queue.clear();
 	for( Sheet *sheet : _outputSheets )
+		for( int i = 0; i < sheet->_nneurons; i++ )
+		{
+			int id = sheet->_neurons[i].nonCulledId;
+			touchedFromOutput[id] = true;
+			queue.push_back( id );
+		}
+	for( size_t head = 0; head < queue.size(); head++ )
 	{
-		const Vector2i count = sheet->getNeuronCount();
-		for( int a = 0; a < count.a; a++ )
-			for( int b = 0; b < count.b; b++ )
-				touchFromOutput( sheet->getNeuron(a, b) );
+		int id = queue[head];
+		for( int k = inStart[id]; k < inStart[id + 1]; k++ )
+		{
+			int from = _synapses[k].from->nonCulledId;
+			if( !touchedFromOutput[from] )
+			{
+				touchedFromOutput[from] = true;
+				queue.push_back( from );
+			}
+		}
 	}
 
-	addNonCulledNeurons( _inputSheets );
-	addNonCulledNeurons( _outputSheets );
-	addNonCulledNeurons( _internalSheets );
+	std::vector<bool> keep( nneurons, false );
+	for( int i = 0; i < nneurons; i++ )
+		keep[i] = touchedFromInput[i] && touchedFromOutput[i];
+
+	addNonCulledNeurons( _inputSheets, keep );
+	addNonCulledNeurons( _outputSheets, keep );
+	addNonCulledNeurons( _internalSheets, keep );
+
+	// ---
+	// --- Drop synapses of culled neurons, preserving order.
+	// ---
+	_synapses.erase( std::remove_if(_synapses.begin(), _synapses.end(),
+									[&keep]( const Synapse &syn )
+									{
+										return !keep[syn.from->nonCulledId] || !keep[syn.to->nonCulledId];
+									}),
+					 _synapses.end() );
+
+	// Ids follow sheet type rather than creation order, so rows may need
+	// regrouping; the stable sort keeps sources in creation order.
+	auto byTargetId = []( const Synapse &x, const Synapse &y ) { return x.to->id < y.to->id; };
+	if( !std::is_sorted(_synapses.begin(), _synapses.end(), byTargetId) )
+		std::stable_sort( _synapses.begin(), _synapses.end(), byTargetId );
+
+	SynapseVector( _synapses ).swap( _synapses );
 }
 
 //---------------------------------------------------------------------------
@@ -621,6 +714,14 @@ NeuronVector &SheetsModel::getNeurons()
 	return _neurons;
 }
 
+//---------------------------------------------------------------------------
+// SheetsModel::getSynapses
+//---------------------------------------------------------------------------
+SynapseVector &SheetsModel::getSynapses()
+{
+	return _synapses;
+}
+
 //---------------------------------------------------------------------------
 // SheetsModel::getProbabilitySynapse
 //---------------------------------------------------------------------------
@@ -633,43 +734,29 @@ float SheetsModel::getProbabilitySynapse( float distance )
 }
 
 //---------------------------------------------------------------------------
-// SheetsModel::touchFromInput
+// SheetsModel::createSynapse
+//
+// Duplicates are resolved by cull(), so this only appends.
 //---------------------------------------------------------------------------
-void SheetsModel::touchFromInput( Neuron *neuron )
+Synapse *SheetsModel::createSynapse( Neuron *from, Neuron *to )
 {
-	if( neuron->cullState.touchedFromInput )
-		return;
-
-	neuron->cullState.touchedFromInput = true;
-
-	itfor( SynapseMap, neuron->synapsesOut, it )
-	{
-		Synapse *syn = it->second;
-		touchFromInput( syn->to );
-	}
-}
+	if( from == to )
+		return NULL;
 
-//---------------------------------------------------------------------------
-// SheetsModel::touchFromOutput
-//---------------------------------------------------------------------------
-void SheetsModel::touchFromOutput( Neuron *neuron )
-{
-	if( neuron->cullState.touchedFromOutput )
-		return;
+	_synapses.push_back( Synapse() );
+	Synapse *synapse = &_synapses.back();
+	synapse->from = from;
+	synapse->to = to;
 
-	neuron->cullState.touchedFromOutput = true;
+	trc( "Synapse [" << from->sheet->_id << "] " << from->absPosition << " --> [" << to->sheet->_id << "] " << to->absPosition );
 
-	itfor( SynapseMap, neuron->synapsesIn, it )
-	{
-		Synapse *syn = it->second;
-		touchFromOutput( syn->from );
-	}
+	return synapse;
 }
 
 //---------------------------------------------------------------------------
 // SheetsModel::addNonCulledNeurons
 //---------------------------------------------------------------------------
-void SheetsModel::addNonCulledNeurons( SheetVector &sheets )
+void SheetsModel::addNonCulledNeurons( SheetVector &sheets, std::vector<bool> &keep )
 {
 	itfor( SheetVector, sheets, it )
 	{
@@ -680,7 +767,7 @@ void SheetsModel::addNonCulledNeurons( SheetVector &sheets )
 			for( int b = 0; b < count.b; b++ )
 			{
 				Neuron *neuron = sheet->getNeuron( a, b );
-				if( neuron->cullState.touchedFromOutput && neuron->cullState.touchedFromInput )
+				if( keep[neuron->nonCulledId] )
 				{
 					neuron->id = (int)_neurons.size();
 					_neurons.push_back( neuron );
@@ -688,25 +775,8 @@ void SheetsModel::addNonCulledNeurons( SheetVector &sheets )
 				else
 				{
 					trc( "CULLED: " << "[" << sheet->getId() << "] " << neuron->absPosition );
-
-					itfor( SynapseMap, neuron->synapsesIn, it_syn )
-					{
-						Synapse *syn = it_syn->second;
-						syn->from->synapsesOut.erase( neuron );
-						delete syn;
-					}
-					neuron->synapsesIn.clear();
-
-					itfor( SynapseMap, neuron->synapsesOut, it_syn )
-					{
-						Synapse *syn = it_syn->second;
-						syn->to->synapsesIn.erase( neuron );
-						delete syn;
-					}
-					neuron->synapsesOut.clear();
 				}
 			}
 		}
 	}
-
 }
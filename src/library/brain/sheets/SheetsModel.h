@@ -101,15 +101,11 @@ namespace sheets
 		} attrs;
 	};
 
+	typedef std::vector<Synapse> SynapseVector;
+
 	//===========================================================================
 	// Neuron
 	//===========================================================================
-	struct NeuronKeyCompare
-	{
-		bool operator()( class Neuron *, class Neuron * ) const;
-	};
-	typedef std::map<class Neuron *, Synapse *, NeuronKeyCompare> SynapseMap;
-
 	class Neuron
 	{
 	public:
@@ -121,8 +117,6 @@ namespace sheets
 		Vector2i sheetIndex;
 		Vector2f sheetPosition;
 		Vector3f absPosition;
-		SynapseMap synapsesOut;
-		SynapseMap synapsesIn;
 		struct Attributes
 		{
 			enum Type { E, I, EI } type;
@@ -133,11 +127,6 @@ namespace sheets
 				SpikingModel__NeuronAttrs spiking;
 			} neuronModel;
 		} attrs;
-		struct
-		{
-			bool touchedFromInput;
-			bool touchedFromOutput;
-		} cullState;
 	};
 
 	typedef std::vector<Neuron *> NeuronVector;
@@ -241,8 +230,6 @@ namespace sheets
 		void createNeurons( std::function<void (Neuron*)> &neuronCreated );
 		float distance( Neuron *a, Neuron *b );
 
-		Synapse *createSynapse( Neuron *from, Neuron *to );
-
 		class SheetsModel *_sheetsModel;
 		std::string _name;
 		int _id;
@@ -287,16 +274,17 @@ namespace sheets
 		void cull();
 
 		NeuronVector &getNeurons();
+		// Valid after cull(). Grouped by target id, in order of source creation.
+		SynapseVector &getSynapses();
 
 	private:
 		friend class Sheet;
 
 		float getProbabilitySynapse( float distance );
+		Synapse *createSynapse( Neuron *from, Neuron *to );
 
 	private:
-		void touchFromInput( Neuron *neuron );
-		void touchFromOutput( Neuron *neuron );
-		void addNonCulledNeurons( SheetVector &sheets );
+		void addNonCulledNeurons( SheetVector &sheets, std::vector<bool> &keep );
 
 		int _numNonCulledNeurons;
 		Vector3f _size;
@@ -306,6 +294,9 @@ namespace sheets
 		SheetVector _outputSheets;
 		SheetVector _internalSheets;
 		NeuronVector _neurons;
+		// Candidates in creation order until cull(), which sorts and
+		// deduplicates them.
+		SynapseVector _synapses;
 	};
 }
 
@@ -33,9 +33,9 @@ void computeAdamiComplexity( long timestep,
 
 	if( ftell(FileOneBit) == 0 )
 	{
-		fprintf( FileOneBit, "%% BitsInGenome: %d WindowSize: 1\n", GenomeUtil::schema->getMutableSize() * 8 );		// write the number of bits into the top of the file.
-		fprintf( FileTwoBit, "%% BitsInGenome: %d WindowSize: 2\n", GenomeUtil::schema->getMutableSize() * 8 );		// write the number of bits into the top of the file.
-		fprintf( FileFourBit, "%% BitsInGenome: %d WindowSize: 4\n", GenomeUtil::schema->getMutableSize() * 8 );		// write the number of bits into the top of the file.
+		fprintf( FileOneBit, "%% BitsInGenome: %d WindowSize: 1\n", GenomeUtil::schema()->getMutableSize() * 8 );		// write the number of bits into the top of the file.
+		fprintf( FileTwoBit, "%% BitsInGenome: %d WindowSize: 2\n", GenomeUtil::schema()->getMutableSize() * 8 );		// write the number of bits into the top of the file.
+		fprintf( FileFourBit, "%% BitsInGenome: %d WindowSize: 4\n", GenomeUtil::schema()->getMutableSize() * 8 );		// write the number of bits into the top of the file.
 		fprintf( FileSummary, "%% Timestep 1bit 2bit 4bit\n" );
 	}
 
@@ -45,17 +45,17 @@ void computeAdamiComplexity( long timestep,
 	fprintf( FileFourBit, "%ld:", timestep );		// write the timestep on the beginning of the line
 	fprintf( FileSummary, "%ld ", timestep );		// write the timestep on the beginning of the line
 			
-	int numagents = objectxsortedlist::gXSortedObjects.getCount(AGENTTYPE);
+	int numagents = objectxsortedlist::gXSortedObjects().getCount(AGENTTYPE);
 
 	bool bits[numagents][8];
 		
-	for( int gene = 0, n = GenomeUtil::schema->getMutableSize(); gene < n; gene++ )			// for each gene ...
+	for( int gene = 0, n = GenomeUtil::schema()->getMutableSize(); gene < n; gene++ )			// for each gene ...
 	{
 		int count = 0;
 
-		objectxsortedlist::gXSortedObjects.reset();				
+		objectxsortedlist::gXSortedObjects().reset();				
 		
-		while( objectxsortedlist::gXSortedObjects.nextObj( AGENTTYPE, (gobject**) &c ) )	// for each agent ...
+		while( objectxsortedlist::gXSortedObjects().nextObj( AGENTTYPE, (gobject**) &c ) )	// for each agent ...
 		{
 			genevalue = c->Genes()->get_raw_uint(gene);
 
@@ -70,7 +70,7 @@ void BrickPatch::addBricks()
 		b->setz(z);
 
 		b->setPatch(this);
-		objectxsortedlist::gXSortedObjects.add(b);
+		objectxsortedlist::gXSortedObjects().add(b);
 		fStage->AddObject(b); 
 	}
 }
@@ -82,12 +82,12 @@ void BrickPatch::removeBricks()
     std::list<brick *> removeList;
 
 	// There are patches currently needing removal, so do it
-	objectxsortedlist::gXSortedObjects.reset();
-	while( objectxsortedlist::gXSortedObjects.nextObj( BRICKTYPE, (gobject**) &b ) )
+	objectxsortedlist::gXSortedObjects().reset();
+	while( objectxsortedlist::gXSortedObjects().nextObj( BRICKTYPE, (gobject**) &b ) )
 	{
 		if( b->myBrickPatch == this )
 		{
-			objectxsortedlist::gXSortedObjects.removeCurrentObject();   // get it out of the list
+			objectxsortedlist::gXSortedObjects().removeCurrentObject();   // get it out of the list
 			fStage->RemoveObject( b );
 			if( b->BeingCarried() )
 			{
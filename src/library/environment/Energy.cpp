@@ -13,24 +13,24 @@
 
 EnergyPolarity::EnergyPolarity()
 {
-	assert( globals::numEnergyTypes <= MAX_ENERGY_TYPES );
+	assert( globals::numEnergyTypes() <= MAX_ENERGY_TYPES );
 
-	for( int i = 0; i < globals::numEnergyTypes; i++ )
+	for( int i = 0; i < globals::numEnergyTypes(); i++ )
 		values[i] = POSITIVE;
 }
 
 EnergyPolarity::EnergyPolarity( proplib::Property &prop )
 {
 	assert( prop.getType() == proplib::Node::Array );
-	assert( (int)prop.elements().size() == globals::numEnergyTypes );
+	assert( (int)prop.elements().size() == globals::numEnergyTypes() );
 
-	for( int i = 0; i < globals::numEnergyTypes; i++ )
+	for( int i = 0; i < globals::numEnergyTypes(); i++ )
 		values[i] = (Polarity)(int)prop.get( i );
 }
 
 bool EnergyPolarity::operator==( const EnergyPolarity &other ) const
 {
-	for( int i = 0; i < globals::numEnergyTypes; i++ )
+	for( int i = 0; i < globals::numEnergyTypes(); i++ )
 	{
 		if( values[i] != other.values[i] )
 			return false;
@@ -43,7 +43,7 @@ EnergyPolarity EnergyPolarity::operator*( const EnergyPolarity &other ) const
 {
 	EnergyPolarity result;
 
-	for( int i = 0; i < globals::numEnergyTypes; i++ )
+	for( int i = 0; i < globals::numEnergyTypes(); i++ )
 	{
 		result.values[i] = (Polarity)(values[i] * other.values[i]);
 	}
@@ -54,24 +54,24 @@ EnergyPolarity EnergyPolarity::operator*( const EnergyPolarity &other ) const
 
 EnergyMultiplier::EnergyMultiplier()
 {
-	assert( globals::numEnergyTypes <= MAX_ENERGY_TYPES );
+	assert( globals::numEnergyTypes() <= MAX_ENERGY_TYPES );
 
-	for( int i = 0; i < globals::numEnergyTypes; i++ )
+	for( int i = 0; i < globals::numEnergyTypes(); i++ )
 		values[i] = 1;
 }
 
 EnergyMultiplier::EnergyMultiplier( float *values )
 {
-	for( int i = 0; i < globals::numEnergyTypes; i++ )
+	for( int i = 0; i < globals::numEnergyTypes(); i++ )
 		this->values[i] = values[i];
 }
 
 EnergyMultiplier::EnergyMultiplier( proplib::Property &prop )
 {
 	assert( prop.getType() == proplib::Node::Array );
-	assert( (int)prop.elements().size() == globals::numEnergyTypes );
+	assert( (int)prop.elements().size() == globals::numEnergyTypes() );
 
-	for( int i = 0; i < globals::numEnergyTypes; i++ )
+	for( int i = 0; i < globals::numEnergyTypes(); i++ )
 		values[i] = (float)prop.get( i );
 }
 
@@ -82,7 +82,7 @@ float EnergyMultiplier::operator[]( int i ) const
 
 bool operator==( const EnergyMultiplier &a, const EnergyMultiplier &b )
 {
-	for( int i = 0; i < globals::numEnergyTypes; i++ )
+	for( int i = 0; i < globals::numEnergyTypes(); i++ )
 		if( fabs( a[i] - b[i] ) > EPSILON )
 			return false;
 
@@ -108,15 +108,15 @@ Energy::Energy( float val )
 Energy::Energy( proplib::Property &prop )
 {
 	assert( prop.getType() == proplib::Node::Array );
-	assert( (int)prop.elements().size() == globals::numEnergyTypes );
+	assert( (int)prop.elements().size() == globals::numEnergyTypes() );
 
-	for( int i = 0; i < globals::numEnergyTypes; i++ )
+	for( int i = 0; i < globals::numEnergyTypes(); i++ )
 		values[i] = (float)prop.get( i );
 }
 
 Energy::Energy( const Energy &positive, const Energy &negative, const EnergyPolarity &polarity )
 {
-	for( int i = 0; i < globals::numEnergyTypes; i++ )
+	for( int i = 0; i < globals::numEnergyTypes(); i++ )
 	{
 		if( polarity.values[i] == EnergyPolarity::NEGATIVE )
 			values[i] = negative.values[i];
@@ -128,9 +128,9 @@ Energy::Energy( const Energy &positive, const Energy &negative, const EnergyPola
 
 void Energy::init( float val )
 {
-	assert( globals::numEnergyTypes <= MAX_ENERGY_TYPES );
+	assert( globals::numEnergyTypes() <= MAX_ENERGY_TYPES );
 
-	for( int i = 0; i < globals::numEnergyTypes; i++ )
+	for( int i = 0; i < globals::numEnergyTypes(); i++ )
 		values[i] = val;
 }
 
@@ -141,7 +141,7 @@ bool Energy::isDepleted() const
 
 bool Energy::isDepleted( const Energy &threshold ) const
 {
-	for( int i = 0; i < globals::numEnergyTypes; i++ )
+	for( int i = 0; i < globals::numEnergyTypes(); i++ )
 	{
 		if( values[i] <= threshold.values[i] )
 			return true;
@@ -152,7 +152,7 @@ bool Energy::isDepleted( const Energy &threshold ) const
 
 bool Energy::isZero() const
 {
-	for( int i = 0; i < globals::numEnergyTypes; i++ )
+	for( int i = 0; i < globals::numEnergyTypes(); i++ )
 	{
 		if( (values[i] < -EPSILON) || (values[i] > EPSILON) )
 			return false;
@@ -165,7 +165,7 @@ float Energy::sum() const
 {
 	float result = 0;
 
-	for( int i = 0; i < globals::numEnergyTypes; i++ )
+	for( int i = 0; i < globals::numEnergyTypes(); i++ )
 		result += values[i];
 
 	return result;
@@ -173,18 +173,18 @@ float Energy::sum() const
 
 float Energy::mean() const
 {
-	return sum() / globals::numEnergyTypes;
+	return sum() / globals::numEnergyTypes();
 }
 
 void Energy::zero()
 {
-	for( int i = 0; i < globals::numEnergyTypes; i++ )
+	for( int i = 0; i < globals::numEnergyTypes(); i++ )
 		values[i] = 0.0;
 }
 
 void Energy::constrain( const Energy &minEnergy, const Energy &maxEnergy )
 {
-	for( int i = 0; i < globals::numEnergyTypes; i++ )
+	for( int i = 0; i < globals::numEnergyTypes(); i++ )
 	{
 		if( values[i] < minEnergy.values[i] )
 		{
@@ -201,7 +201,7 @@ void Energy::constrain( const Energy &minEnergy, const Energy &maxEnergy, Energy
 {
 	result_overflow = 0;
 
-	for( int i = 0; i < globals::numEnergyTypes; i++ )
+	for( int i = 0; i < globals::numEnergyTypes(); i++ )
 	{
 		float diff;
 
@@ -227,7 +227,7 @@ Energy Energy::createDepletionThreshold( const Energy &threshold, const EnergyPo
 {
 	Energy result = threshold;
 
-	for( int i = 0; i < globals::numEnergyTypes; i++ )
+	for( int i = 0; i < globals::numEnergyTypes(); i++ )
 	{
 		if( polarity.values[i] == EnergyPolarity::UNDEFINED )
             result.values[i] = std::numeric_limits<float>::quiet_NaN();
@@ -243,7 +243,7 @@ float Energy::operator[]( int index ) const
 
 Energy &Energy::operator+=( const Energy &other )
 {
-	for( int i = 0; i < globals::numEnergyTypes; i++ )
+	for( int i = 0; i < globals::numEnergyTypes(); i++ )
 	{
 		values[i] += other.values[i];
 	}
@@ -253,7 +253,7 @@ Energy &Energy::operator+=( const Energy &other )
 
 Energy &Energy::operator-=( const Energy &other )
 {
-	for( int i = 0; i < globals::numEnergyTypes; i++ )
+	for( int i = 0; i < globals::numEnergyTypes(); i++ )
 	{
 		values[i] -= other.values[i];
 	}
@@ -265,7 +265,7 @@ Energy operator+( const Energy &a, const Energy &b )
 {
 	Energy result;
 
-	for( int i = 0; i < globals::numEnergyTypes; i++ )
+	for( int i = 0; i < globals::numEnergyTypes(); i++ )
 	{
 		result.values[i] = a.values[i] + b.values[i];
 	}
@@ -277,7 +277,7 @@ Energy operator-( const Energy &a, const Energy &b )
 {
 	Energy result;
 
-	for( int i = 0; i < globals::numEnergyTypes; i++ )
+	for( int i = 0; i < globals::numEnergyTypes(); i++ )
 	{
 		result.values[i] = a.values[i] - b.values[i];
 	}
@@ -289,7 +289,7 @@ Energy operator*( const Energy &a, float val )
 {
 	Energy result;
 
-	for( int i = 0; i < globals::numEnergyTypes; i++ )
+	for( int i = 0; i < globals::numEnergyTypes(); i++ )
 	{
 		result.values[i] = a.values[i] * val;
 	}
@@ -306,7 +306,7 @@ Energy operator*( const Energy &e, const EnergyPolarity &p )
 {
 	Energy result;
 
-	for( int i = 0; i < globals::numEnergyTypes; i++ )
+	for( int i = 0; i < globals::numEnergyTypes(); i++ )
 	{
 		result.values[i] = e.values[i] * p.values[i];
 	}
@@ -318,7 +318,7 @@ Energy operator*( const Energy &e, const EnergyMultiplier &m )
 {
 	Energy result;
 
-	for( int i = 0; i < globals::numEnergyTypes; i++ )
+	for( int i = 0; i < globals::numEnergyTypes(); i++ )
 	{
 		if( (m[i] != 0) && ( sign(m[i]) == sign(e.values[i]) ) )
 			result.values[i] = e.values[i] * fabs( m.values[i] );
@@ -332,10 +332,10 @@ Energy operator*( const Energy &e, const EnergyMultiplier &m )
 std::ostream &operator<<( std::ostream &out, const Energy &e )
 {
 	out << "Energy(";
-	for( int i = 0; i < globals::numEnergyTypes; i++ )
+	for( int i = 0; i < globals::numEnergyTypes(); i++ )
 	{
 		out << e.values[i];
-		if( i != globals::numEnergyTypes - 1 )
+		if( i != globals::numEnergyTypes() - 1 )
 			out << ",";
 	}
 	out << ")";
@@ -345,7 +345,7 @@ std::ostream &operator<<( std::ostream &out, const Energy &e )
 
 void Energy::test()
 {
-	globals::numEnergyTypes = 3;
+	globals::numEnergyTypes() = 3;
 
 	{
 		Energy e;
@@ -118,7 +118,7 @@ food *FoodPatch::addFood( long step )
 		f->setPatch( this );
 
 		// Finally, add it to the world object list and fStage
-		objectxsortedlist::gXSortedObjects.add( f );
+		objectxsortedlist::gXSortedObjects().add( f );
 		fStage->AddObject( f );
 
 		// Update the patch's count
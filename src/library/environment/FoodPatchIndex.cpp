@@ -0,0 +1,167 @@
+#include "FoodPatchIndex.h"
+
+#include <math.h>
+
+#include <algorithm>
+
+#include "FoodPatch.h"
+
+#define CellsPerAxis 64
+
+//===========================================================================
+// FoodPatchIndex
+//===========================================================================
+
+//---------------------------------------------------------------------------
+// FoodPatchIndex::FoodPatchIndex
+//---------------------------------------------------------------------------
+FoodPatchIndex::FoodPatchIndex()
+	: patches( NULL )
+	, startX( 0.0 )
+	, startZ( 0.0 )
+	, cellSizeX( 1.0 )
+	, cellSizeZ( 1.0 )
+	, ncellsX( 0 )
+	, ncellsZ( 0 )
+{
+}
+
+//---------------------------------------------------------------------------
+// FoodPatchIndex::build
+//---------------------------------------------------------------------------
+void FoodPatchIndex::build( FoodPatch *patches, int npatches )
+{
+	this->patches = patches;
+	cellStart.clear();
+	cellPatches.clear();
+	ncellsX = ncellsZ = 0;
+
+	if( npatches == 0 )
+		return;
+
+	// ---
+	// --- Bounding box of all neighborhoods
+	// ---
+	float endX, endZ;
+	for( int i = 0; i < npatches; i++ )
+	{
+		FoodPatch &patch = patches[i];
+		float range = std::max( 0.0f, patch.neighborhoodSize );
+		if( i == 0 )
+		{
+			startX = patch.startX - range;
+			startZ = patch.startZ - range;
+			endX = patch.endX + range;
+			endZ = patch.endZ + range;
+		}
+		else
+		{
+			startX = std::min( startX, patch.startX - range );
+			startZ = std::min( startZ, patch.startZ - range );
+			endX = std::max( endX, patch.endX + range );
+			endZ = std::max( endZ, patch.endZ + range );
+		}
+	}
+
+	ncellsX = ncellsZ = CellsPerAxis;
+	cellSizeX = std::max( (endX - startX) / ncellsX, 1e-6f );
+	cellSizeZ = std::max( (endZ - startZ) / ncellsZ, 1e-6f );
+
+	// ---
+	// --- Bucket each patch into the cells its neighborhood overlaps
+	// ---
+	std::vector< std::vector<int> > cells( ncellsX * ncellsZ );
+	for( int i = 0; i < npatches; i++ )
+	{
+		FoodPatch &patch = patches[i];
+		float range = std::max( 0.0f, patch.neighborhoodSize );
+		int x0 = std::max( 0, (int)floor((patch.startX - range - startX) / cellSizeX) );
+		int x1 = std::min( ncellsX - 1, (int)floor((patch.endX + range - startX) / cellSizeX) );
+		int z0 = std::max( 0, (int)floor((patch.startZ - range - startZ) / cellSizeZ) );
+		int z1 = std::min( ncellsZ - 1, (int)floor((patch.endZ + range - startZ) / cellSizeZ) );
+
+		for( int z = z0; z <= z1; z++ )
+			for( int x = x0; x <= x1; x++ )
+				cells[z * ncellsX + x].push_back( i );
+	}
+
+	cellStart.reserve( cells.size() + 1 );
+	for( std::vector<int> &cell : cells )
+	{
+		cellStart.push_back( cellPatches.size() );
+		cellPatches.insert( cellPatches.end(), cell.begin(), cell.end() );
+	}
+	cellStart.push_back( cellPatches.size() );
+}
+
+//---------------------------------------------------------------------------
+// FoodPatchIndex::getCandidates
+//---------------------------------------------------------------------------
+const int *FoodPatchIndex::getCandidates( float x, float z, int &count ) const
+{
+	count = 0;
+	if( ncellsX == 0 )
+		return NULL;
+
+	float fx = (x - startX) / cellSizeX;
+	float fz = (z - startZ) / cellSizeZ;
+	if( fx < 0.0 || fz < 0.0 )
+		return NULL;
+
+	// A point exactly on the far edge belongs to the last cell.
+	int cx = std::min( (int)fx, ncellsX );
+	int cz = std::min( (int)fz, ncellsZ );
+	if( cx == ncellsX )
+	{
+		if( fx > ncellsX )
+			return NULL;
+		cx--;
+	}
+	if( cz == ncellsZ )
+	{
+		if( fz > ncellsZ )
+			return NULL;
+		cz--;
+	}
+
+	int cell = cz * ncellsX + cx;
+	count = cellStart[cell + 1] - cellStart[cell];
+	return cellPatches.data() + cellStart[cell];
+}
+
+//---------------------------------------------------------------------------
+// FoodPatchIndex::countAgent
+//---------------------------------------------------------------------------
+void FoodPatchIndex::countAgent( float x, float z )
+{
+	int count;
+	const int *candidates = getCandidates( x, z, count );
+
+	for( int i = 0; i < count; i++ )
+	{
+		FoodPatch &patch = patches[candidates[i]];
+
+		if( patch.pointIsInside(x, z, 0) )
+			patch.agentInsideCount++;
+		else if( patch.pointIsInside(x, z, patch.neighborhoodSize) )
+			patch.agentNeighborhoodCount++;
+	}
+}
+
+//---------------------------------------------------------------------------
+// FoodPatchIndex::whichPatch
+//---------------------------------------------------------------------------
+FoodPatch *FoodPatchIndex::whichPatch( float x, float z )
+{
+	int count;
+	const int *candidates = getCandidates( x, z, count );
+
+	for( int i = 0; i < count; i++ )
+	{
+		FoodPatch &patch = patches[candidates[i]];
+		if( patch.pointIsInside(x, z, 0) )
+			return &patch;
+	}
+
+	return NULL;
+}
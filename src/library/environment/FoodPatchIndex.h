@@ -0,0 +1,46 @@
+#pragma once
+
+#include <vector>
+
+class FoodPatch;
+
+//===========================================================================
+// FoodPatchIndex
+//
+// Grid over a domain's food patches. Each cell lists, in patch order, the
+// patches whose neighborhood overlaps it, so finding the patches around a
+// point costs a cell lookup plus exact tests against a handful of
+// candidates rather than a test against every patch. Patch geometry is
+// fixed once the worldfile has been read, so the grid is built once; the
+// on/off state of a patch doesn't affect membership.
+//===========================================================================
+class FoodPatchIndex
+{
+ public:
+	FoodPatchIndex();
+
+	void build( FoodPatch *patches, int npatches );
+
+	// Updates the agent counts of the patch(es) containing (x, z) or
+	// having it in their neighborhood.
+	void countAgent( float x, float z );
+	// First patch, in worldfile order, containing (x, z).
+	FoodPatch *whichPatch( float x, float z );
+
+ private:
+	const int *getCandidates( float x, float z, int &count ) const;
+
+	FoodPatch *patches;
+
+	float startX;
+	float startZ;
+	float cellSizeX;
+	float cellSizeZ;
+	int ncellsX;
+	int ncellsZ;
+
+	// Candidates for cell i are cellPatches[cellStart[i]] up to
+	// cellPatches[cellStart[i+1]].
+	std::vector<int> cellStart;
+	std::vector<int> cellPatches;
+};
@@ -2,10 +2,38 @@
 
 #include <assert.h>
 
+#include "sim/SimulationContext.h"
 #include "utils/misc.h"
 
-std::map<std::string, const FoodType *> FoodType::foodTypes;
-std::vector<FoodType *> FoodType::foodTypesVector;
+namespace
+{
+	struct FoodTypes
+	{
+		std::map<std::string, const FoodType *> foodTypes;
+		std::vector<FoodType *> foodTypesVector;
+
+		~FoodTypes()
+		{
+			itfor( std::vector<FoodType *>, foodTypesVector, it )
+				delete *it;
+		}
+	};
+
+	FoodTypes &foodTypes()
+	{
+		return SimulationContext::current()->get<FoodTypes>();
+	}
+}
+
+std::map<std::string, const FoodType *> &FoodType::foodTypes()
+{
+	return ::foodTypes().foodTypes;
+}
+
+std::vector<FoodType *> &FoodType::foodTypesVector()
+{
+	return ::foodTypes().foodTypesVector;
+}
 
 
 FoodType::FoodType( int _index,
@@ -29,24 +57,24 @@ void FoodType::define( std::string _name,
 					   EnergyMultiplier _eatMultiplier,
 					   Energy _depletionThreshold )
 {
-	FoodType *foodType = new FoodType( foodTypesVector.size(),
+	FoodType *foodType = new FoodType( foodTypesVector().size(),
 									   _name,
 									   _color,
 									   _energyPolarity,
 									   _eatMultiplier,
 									   _depletionThreshold );
-	foodTypes[_name] = foodType;
-	foodTypesVector.push_back( foodType );
+	foodTypes()[_name] = foodType;
+	foodTypesVector().push_back( foodType );
 }
 
 const FoodType *FoodType::lookup( std::string name )
 {
-	return foodTypes[name];
+	return foodTypes()[name];
 }
 
 const FoodType *FoodType::find( const EnergyPolarity &polarity )
 {
-	itfor( FoodTypeMap, foodTypes, it )
+	itfor( FoodTypeMap, foodTypes(), it )
 	{
 		if( it->second->energyPolarity == polarity )
 		{
@@ -59,9 +87,9 @@ const FoodType *FoodType::find( const EnergyPolarity &polarity )
 
 FoodType *FoodType::get( int index )
 {
-	return foodTypesVector[index];
+	return foodTypesVector()[index];
 }
 
 int FoodType::getNumberDefinitions() {
-	return (int)foodTypes.size();
+	return (int)foodTypes().size();
 }
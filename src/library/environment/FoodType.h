@@ -37,6 +37,7 @@ class FoodType
 
 	typedef std::map<std::string, const FoodType *> FoodTypeMap;
 
-	static FoodTypeMap foodTypes;
-	static std::vector<FoodType *> foodTypesVector;
+	// Defined by each simulation's worldfile.
+	static FoodTypeMap &foodTypes();
+	static std::vector<FoodType *> &foodTypesVector();
 };
@@ -96,21 +96,21 @@ void  Patch::setPoint( float* x, float* z )
 		}
 	}
 
-	// Check for points outside of the ellipse and keep generating points until
-	// we get one inside the ellipse
+	// Uniform points are drawn directly in polar coordinates on the unit disk
+	// and then stretched onto the ellipse. Linear and gaussian points keep
+	// being generated until we get one inside the ellipse; getNormal() clips
+	// its own density, so the gaussian can't be drawn in closed form without
+	// changing the distribution.
 	else if( areaShape == ELLIPTICAL )
 	{
 		float a = sizeX / 2.0;
 		float b = sizeZ / 2.0;
 		if( distribution == UNIFORM )
 		{
-			*x = startX  +  sizeX * randpw();
-			*z = startZ  +  sizeZ * randpw();
-			while( ((*x - centerX) * (*x - centerX) / (a * a) + (*z - centerZ) * (*z - centerZ) / (b * b)) > 1.0 )
-			{
-				*x = startX  +  sizeX * randpw();
-				*z = startZ  +  sizeZ * randpw();
-			}
+			float r = sqrt( randpw() );
+			float theta = 2.0 * PI * randpw();
+			*x = centerX  +  a * r * cos( theta );
+			*z = centerZ  +  b * r * sin( theta );
 		}
 		else if( distribution == LINEAR )
 		{
@@ -15,19 +15,44 @@
 // Local
 #include "graphics/graphics.h"
 #include "sim/globals.h"
+#include "sim/SimulationContext.h"
 
-// barrier globals
-float barrier::gBarrierHeight;
-Color barrier::gBarrierColor;
-bool barrier::gStickyBarriers;
-bool barrier::gRatioPositions;
-bxsortedlist barrier::gXSortedBarriers;
-std::vector<barrier *> barrier::gBarriers;
+// barrier globals, kept per simulation
+namespace
+{
+	struct BarrierGlobals
+	{
+		float barrierHeight;
+		Color barrierColor;
+		bool stickyBarriers;
+		bool ratioPositions;
+		std::vector<barrier *> barriers;
+	};
+
+	BarrierGlobals &barrierGlobals()
+	{
+		return SimulationContext::current()->get<BarrierGlobals>();
+	}
+}
+
+float &barrier::gBarrierHeight() { return barrierGlobals().barrierHeight; }
+Color &barrier::gBarrierColor() { return barrierGlobals().barrierColor; }
+bool &barrier::gStickyBarriers() { return barrierGlobals().stickyBarriers; }
+bool &barrier::gRatioPositions() { return barrierGlobals().ratioPositions; }
+std::vector<barrier *> &barrier::gBarriers() { return barrierGlobals().barriers; }
 
 //===========================================================================
 // barrier
 //===========================================================================
 
+//---------------------------------------------------------------------------
+// barrier::gXSortedBarriers
+//---------------------------------------------------------------------------
+bxsortedlist &barrier::gXSortedBarriers()
+{
+	return SimulationContext::current()->xsortedBarriers;
+}
+
 //---------------------------------------------------------------------------
 // barrier::barrier
 //---------------------------------------------------------------------------
@@ -58,7 +83,7 @@ barrier::~barrier()
 //---------------------------------------------------------------------------
 void barrier::init()
 {
-	setcolor(gBarrierColor);
+	setcolor(gBarrierColor());
 	updateVertices();
 }
 
@@ -68,11 +93,13 @@ void barrier::init()
 void barrier::draw()
 {
 	gpoly::draw();
-	setcolor(gBarrierColor);
+	setcolor(gBarrierColor());
+#if !PW_HEADLESS
 	glBegin(GL_LINES);
-		glVertex3f(absCurrPosition.xa, gBarrierHeight, absCurrPosition.za);
-		glVertex3f(absCurrPosition.xb, gBarrierHeight, absCurrPosition.zb);
+		glVertex3f(absCurrPosition.xa, gBarrierHeight(), absCurrPosition.za);
+		glVertex3f(absCurrPosition.xb, gBarrierHeight(), absCurrPosition.zb);
 	glEnd();
+#endif
 }
 
 //---------------------------------------------------------------------------
@@ -92,12 +119,12 @@ void barrier::updateVertices()
 {
 	currPosition = nextPosition;
 	absCurrPosition = currPosition;
-	if( gRatioPositions )
+	if( gRatioPositions() )
 	{
-		absCurrPosition.xa *= globals::worldsize;
-		absCurrPosition.za *= globals::worldsize;
-		absCurrPosition.xb *= globals::worldsize;
-		absCurrPosition.zb *= globals::worldsize;
+		absCurrPosition.xa *= globals::worldsize();
+		absCurrPosition.za *= globals::worldsize();
+		absCurrPosition.xb *= globals::worldsize();
+		absCurrPosition.zb *= globals::worldsize();
 	}
 
 	float x1;
@@ -106,8 +133,8 @@ void barrier::updateVertices()
 	float z2;
 
 	fVertices[ 0] = absCurrPosition.xa; fVertices[ 1] = 0.; 			 fVertices[ 2] = absCurrPosition.za;
-	fVertices[ 3] = absCurrPosition.xa; fVertices[ 4] = gBarrierHeight; fVertices[ 5] = absCurrPosition.za;
-	fVertices[ 6] = absCurrPosition.xb; fVertices[ 7] = gBarrierHeight; fVertices[ 8] = absCurrPosition.zb;
+	fVertices[ 3] = absCurrPosition.xa; fVertices[ 4] = gBarrierHeight(); fVertices[ 5] = absCurrPosition.za;
+	fVertices[ 6] = absCurrPosition.xb; fVertices[ 7] = gBarrierHeight(); fVertices[ 8] = absCurrPosition.zb;
 	fVertices[ 9] = absCurrPosition.xb; fVertices[10] = 0.; 			 fVertices[11] = absCurrPosition.zb;
 
 	if( absCurrPosition.xa < absCurrPosition.xb )
@@ -76,12 +76,12 @@ public:
 		float zb;
 	};
 
-	static float gBarrierHeight;
-	static Color gBarrierColor;
-	static bool gStickyBarriers;
-	static bool gRatioPositions;
-	static bxsortedlist gXSortedBarriers;
-	static std::vector<barrier *> gBarriers;
+	static float &gBarrierHeight();
+	static Color &gBarrierColor();
+	static bool &gStickyBarriers();
+	static bool &gRatioPositions();
+	static bxsortedlist &gXSortedBarriers();
+	static std::vector<barrier *> &gBarriers();
 
     barrier();
     ~barrier();
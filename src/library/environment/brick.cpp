@@ -16,13 +16,31 @@
 #include "agent/agent.h"
 #include "graphics/graphics.h"
 #include "sim/globals.h"
+#include "sim/SimulationContext.h"
 
-// External globals
-float brick::gBrickHeight;
-float brick::gBrickRadius;
-unsigned long brick::NumBricks;
-bool brick::BrickClassInited;
-float brick::gCarryBrick2Energy;
+// External globals, kept per simulation
+namespace
+{
+	struct BrickGlobals
+	{
+		float brickHeight;
+		float brickRadius;
+		unsigned long numBricks;
+		bool brickClassInited;
+		float carryBrick2Energy;
+	};
+
+	BrickGlobals &brickGlobals()
+	{
+		return SimulationContext::current()->get<BrickGlobals>();
+	}
+}
+
+float &brick::gBrickHeight() { return brickGlobals().brickHeight; }
+float &brick::gBrickRadius() { return brickGlobals().brickRadius; }
+unsigned long &brick::NumBricks() { return brickGlobals().numBricks; }
+bool &brick::BrickClassInited() { return brickGlobals().brickClassInited; }
+float &brick::gCarryBrick2Energy() { return brickGlobals().carryBrick2Energy; }
 
 
 //===========================================================================
@@ -85,7 +103,7 @@ void brick::load(std::istream& in)
 //-------------------------------------------------------------------------------------------
 void brick::initBrick( Color color )
 {
-	initBrick( color, randpw() * globals::worldsize, randpw() * globals::worldsize );
+	initBrick( color, randpw() * globals::worldsize(), randpw() * globals::worldsize() );
 }
 
 
@@ -94,7 +112,7 @@ void brick::initBrick( Color color )
 //-------------------------------------------------------------------------------------------
 void brick::initBrick( Color color, float x, float z )
 {
-	initBrick( color, x, 0.5 * gBrickHeight, z );
+	initBrick( color, x, 0.5 * gBrickHeight(), z );
 }
  
 
@@ -103,19 +121,19 @@ void brick::initBrick( Color color, float x, float z )
 //-------------------------------------------------------------------------------------------
 void brick::initBrick( Color color, float x, float y, float z )
 {
-	if( !BrickClassInited )
+	if( !BrickClassInited() )
 		InitBrickClass();
 	
-	NumBricks++;
+	NumBricks()++;
 	
 	setType( BRICKTYPE );
-	setTypeNumber( NumBricks );
+	setTypeNumber( NumBricks() );
 
 	fPosition[0] = x;
 	fPosition[1] = y;
 	fPosition[2] = z;
 	
-	setlen( gBrickHeight, gBrickHeight, gBrickHeight );
+	setlen( gBrickHeight(), gBrickHeight(), gBrickHeight() );
 	
 	setcolor( color );
 }
@@ -126,12 +144,12 @@ void brick::initBrick( Color color, float x, float y, float z )
 //-------------------------------------------------------------------------------------------
 void brick::InitBrickClass()
 {
-	if( BrickClassInited )
+	if( BrickClassInited() )
 		return;
 	
-	BrickClassInited = true;
-	NumBricks = 0;
-	gBrickRadius = 0.5 * sqrt( 2.0 ) * gBrickHeight;
+	BrickClassInited() = true;
+	NumBricks() = 0;
+	gBrickRadius() = 0.5 * sqrt( 2.0 ) * gBrickHeight();
 }
  
 
@@ -22,9 +22,9 @@ class brick;
 class brick : public gboxf
 {
  public:
-	static float gBrickHeight;
-	static float gBrickRadius;
-	static float gCarryBrick2Energy;
+	static float &gBrickHeight();
+	static float &gBrickRadius();
+	static float &gCarryBrick2Energy();
 
 	static long GetNumBricks();
 
@@ -46,8 +46,8 @@ class brick : public gboxf
 	void initBrick( Color color, float x, float z );
 	void initBrick( Color color, float x, float y, float z );
 	
-	static unsigned long NumBricks;
-	static bool BrickClassInited;
+	static unsigned long &NumBricks();
+	static bool &BrickClassInited();
 	static void InitBrickClass();
 
 #if 0
@@ -55,7 +55,7 @@ class brick : public gboxf
 #endif
 };
 
-inline long brick::GetNumBricks() { return NumBricks; }
+inline long brick::GetNumBricks() { return NumBricks(); }
 inline void brick::setPatch( BrickPatch* bp ) { myBrickPatch = bp; }
 
 #endif
@@ -16,25 +16,52 @@
 #include "agent/agent.h"
 #include "graphics/graphics.h"
 #include "sim/globals.h"
+#include "sim/SimulationContext.h"
 
-// Static class variables
-unsigned long food::fFoodEver;
+// Static class variables and external globals, kept per simulation
+namespace
+{
+	struct FoodGlobals
+	{
+		unsigned long foodEver;
+		float foodHeight;
+		Color foodColor;
+		float minFoodEnergy;
+		float maxFoodEnergy;
+		float size2Energy;
+		float maxFoodRadius;
+		float carryFood2Energy;
+		long maxLifeSpan;
+	};
+
+	FoodGlobals &foodGlobals()
+	{
+		return SimulationContext::current()->get<FoodGlobals>();
+	}
+}
 
-// External globals
-float food::gFoodHeight;
-Color food::gFoodColor;
-float food::gMinFoodEnergy;
-float food::gMaxFoodEnergy;
-float food::gSize2Energy;
-float food::gMaxFoodRadius;
-float food::gCarryFood2Energy;
-long food::gMaxLifeSpan;
-food::FoodList food::gAllFood;
+unsigned long &food::fFoodEver() { return foodGlobals().foodEver; }
+float &food::gFoodHeight() { return foodGlobals().foodHeight; }
+Color &food::gFoodColor() { return foodGlobals().foodColor; }
+float &food::gMinFoodEnergy() { return foodGlobals().minFoodEnergy; }
+float &food::gMaxFoodEnergy() { return foodGlobals().maxFoodEnergy; }
+float &food::gSize2Energy() { return foodGlobals().size2Energy; }
+float &food::gMaxFoodRadius() { return foodGlobals().maxFoodRadius; }
+float &food::gCarryFood2Energy() { return foodGlobals().carryFood2Energy; }
+long &food::gMaxLifeSpan() { return foodGlobals().maxLifeSpan; }
 
 //===========================================================================
 // food
 //===========================================================================
 
+//-------------------------------------------------------------------------------------------
+// food::gAllFood
+//-------------------------------------------------------------------------------------------
+food::FoodList &food::gAllFood()
+{
+	return SimulationContext::current()->allFood;
+}
+
 
 //-------------------------------------------------------------------------------------------
 // food::food
@@ -69,7 +96,7 @@ food::food( const FoodType *foodType, long step, const Energy &e, float x, float
 food::~food()
 {
 	assert( *fAllFoodIterator == this );
-	gAllFood.erase( fAllFoodIterator );
+	gAllFood().erase( fAllFoodIterator );
 }
 
 
@@ -134,7 +161,7 @@ long food::getAge(long step)
 //-------------------------------------------------------------------------------------------
 void food::initfood( const FoodType *foodType, long step )
 {
-	Energy e = randpw() * (gMaxFoodEnergy - gMinFoodEnergy) + gMinFoodEnergy;
+	Energy e = randpw() * (gMaxFoodEnergy() - gMinFoodEnergy()) + gMinFoodEnergy();
 	initfood( foodType, step, e );
 }
 
@@ -145,8 +172,8 @@ void food::initfood( const FoodType *foodType, long step )
 void food::initfood( const FoodType *foodType, long step, const Energy &e )
 {
 	fEnergy = e;
-	float x = randpw() * globals::worldsize;
-	float z = randpw() * globals::worldsize;
+	float x = randpw() * globals::worldsize();
+	float z = randpw() * globals::worldsize();
 	initfood( foodType, step, e, x, z );
 }
 
@@ -167,19 +194,19 @@ void food::initfood( const FoodType *foodType, long step, const Energy &e, float
 	fCreationStep = step;
 	if( step >= 0 )
 	{
-		gAllFood.push_back( this );
-		fAllFoodIterator = --gAllFood.end();
+		gAllFood().push_back( this );
+		fAllFoodIterator = --gAllFood().end();
 	}
 	else
 	{
-		fAllFoodIterator = gAllFood.begin();
-		while( fAllFoodIterator != gAllFood.end() )
+		fAllFoodIterator = gAllFood().begin();
+		while( fAllFoodIterator != gAllFood().end() )
 		{
 			if( (*fAllFoodIterator)->fCreationStep > step )
 				break;
 			fAllFoodIterator++;
 		}
-		fAllFoodIterator = gAllFood.insert( fAllFoodIterator, this );
+		fAllFoodIterator = gAllFood().insert( fAllFoodIterator, this );
 	}
 	assert( *fAllFoodIterator == this );
 }
@@ -190,8 +217,8 @@ void food::initfood( const FoodType *foodType, long step, const Energy &e, float
 //-------------------------------------------------------------------------------------------
 void food::initlen()
 {
-	float lxz = 0.75 * fEnergy.mean() / gSize2Energy;
-	float ly = gFoodHeight;
+	float lxz = 0.75 * fEnergy.mean() / gSize2Energy();
+	float ly = gFoodHeight();
 	setlen( lxz, ly, lxz );
 }
 
@@ -202,7 +229,7 @@ void food::initlen()
 void food::initrest()
 {
 	setType( FOODTYPE );
-	setTypeNumber( ++food::fFoodEver );
+	setTypeNumber( ++food::fFoodEver() );
 	setcolor( foodType->color );
 }
 
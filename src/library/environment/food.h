@@ -28,17 +28,17 @@ class food;
 class food : public gboxf
 {
 public:
-	static float gFoodHeight;
-	static Color gFoodColor;
-	static float gMinFoodEnergy;
-	static float gMaxFoodEnergy;
-	static float gSize2Energy; // (converts between food/agent size and available energy)
-	static float gMaxFoodRadius;
-	static float gCarryFood2Energy;
-	static long gMaxLifeSpan;
+	static float &gFoodHeight();
+	static Color &gFoodColor();
+	static float &gMinFoodEnergy();
+	static float &gMaxFoodEnergy();
+	static float &gSize2Energy(); // (converts between food/agent size and available energy)
+	static float &gMaxFoodRadius();
+	static float &gCarryFood2Energy();
+	static long &gMaxLifeSpan();
 
     typedef std::list<food *> FoodList;
-	static FoodList gAllFood;
+	static FoodList &gAllFood();
 
     food( const FoodType *foodType, long step );
     food( const FoodType *foodType, long step, const Energy &e );
@@ -73,7 +73,7 @@ protected:
 	void initrest();
    	virtual void setradius();
 
-    static unsigned long fFoodEver;
+    static unsigned long &fFoodEver();
 
 	Energy fEnergy;
     short fDomain;
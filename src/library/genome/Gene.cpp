@@ -222,6 +222,39 @@ Scalar __InterpolatedGene::interpolate( double ratio )
 	}
 }
 
+Scalar __InterpolatedGene::interpolate( Genome *genome, int offset )
+{
+	if( genome->isDecoded() )
+	{
+		GeneValue value = genome->getDecoded( offset );
+
+		if( smin.type == Scalar::INT )
+			return value.ival;
+		else
+			return value.fval;
+	}
+
+	return interpolate( genome->get_raw(offset) );
+}
+
+void __InterpolatedGene::prepareDecoding()
+{
+	for( int raw = 0; raw < 256; raw++ )
+	{
+		Scalar value = interpolate( (unsigned char)raw );
+
+		if( smin.type == Scalar::INT )
+			decoded[raw].ival = value;
+		else
+			decoded[raw].fval = value;
+	}
+}
+
+GeneValue __InterpolatedGene::decode( unsigned char raw )
+{
+	return decoded[raw];
+}
+
 void __InterpolatedGene::printRanges( FILE *file, const std::string &prefix )
 {
 	const char *roundingNames[] = { "None", "IntFloor", "IntNearest", "IntBin" };
@@ -287,7 +320,7 @@ MutableScalarGene::MutableScalarGene( const char *name,
 
 Scalar MutableScalarGene::get( Genome *genome )
 {
-	return interpolate( genome->get_raw(offset) );
+	return interpolate( genome, offset );
 }
 
 const Scalar &MutableScalarGene::getMin()
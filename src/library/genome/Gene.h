@@ -27,6 +27,13 @@ namespace genome
 	typedef std::list<class Gene *> GeneList;
 	typedef std::map<const class GeneType *, GeneVector> GeneTypeMap;
 
+	// A decoded gene value; the gene knows whether it's an int or a float.
+	union GeneValue
+	{
+		int ival;
+		float fval;
+	};
+
 	// ================================================================================
 	// ===
 	// === CLASS GeneType
@@ -149,6 +156,14 @@ namespace genome
 
 		Scalar interpolate( unsigned char raw );
 		Scalar interpolate( double ratio );
+		// Value of the byte at offset, read from the genome's decoded values
+		// when it has them.
+		Scalar interpolate( Genome *genome, int offset );
+
+		// Tabulates interpolate() over all raw values for decode(). Must
+		// follow any change to the interpolation power.
+		void prepareDecoding();
+		GeneValue decode( unsigned char raw );
 
 		void printRanges( FILE *file, const std::string &prefix );
 
@@ -157,6 +172,7 @@ namespace genome
 		Scalar smax;
 		Rounding rounding;
 		double interpolationPower;
+		GeneValue decoded[256];
 	};
 
 
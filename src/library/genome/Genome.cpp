@@ -34,9 +34,20 @@ Genome::Genome( GenomeSchema *schema,
 
 	MISC_BIAS = gene("MiscBias");
 	MISC_INVIS_SLOPE = gene("MiscInvisSlope");
-	gray = GenomeSchema::config.grayCoding;
+	MUTATION_RATE = gene("MutationRate");
+	MUTATION_STDEV_POWER = gene("MutationStdevPower");
+	CROSSOVER_POINT_COUNT = gene("CrossoverPointCount");
+	LIFE_SPAN = gene("LifeSpan");
+	ID = gene("ID");
+	STRENGTH = gene("Strength");
+	SIZE = gene("Size");
+	MAX_SPEED = gene("MaxSpeed");
+	MATE_ENERGY_FRACTION = gene("MateEnergyFraction");
+	gray = GenomeSchema::config().grayCoding;
 
 	nbytes = schema->getMutableSize();
+	decodedValues = NULL;
+	decoded = false;
 
 	alloc();
 }
@@ -44,6 +55,7 @@ Genome::Genome( GenomeSchema *schema,
 Genome::~Genome()
 {
 	delete [] mutable_data ;
+	delete [] decodedValues;
 }
 
 Gene *Genome::gene( const char *name )
@@ -66,37 +78,6 @@ unsigned int Genome::get_raw_uint( long xbyte )
     return (unsigned int)get_raw( xbyte );
 }
 
-void Genome::updateSum( unsigned long *sum, unsigned long *sum2 )
-{
-	// This function is more verbose than necessary because we're optimizing
-	// for speed. This loop is run *a lot*. So, we move the if(gray) outside
-	// the loop and implement the get_raw() logic in here.
-	if( gray )
-	{
-		for( int i = 0; i < nbytes; i++ )
-		{
-			int layoutOffset = layout->getMutableDataOffset_nocheck( i );
-			unsigned long raw = (unsigned long)mutable_data[layoutOffset];
-
-			raw = binofgray[raw];
-
-			sum[i] += raw;
-			sum2[i] += raw * raw;
-		}
-	}
-	else
-	{
-		for( int i = 0; i < nbytes; i++ )
-		{
-			int layoutOffset = layout->getMutableDataOffset_nocheck( i );
-			unsigned long raw = (unsigned long)mutable_data[layoutOffset];
-
-			sum[i] += raw;
-			sum2[i] += raw * raw;
-		}
-	}
-}
-
 #define SEEDCHECK(VAL) assert(((VAL) >= 0) && ((VAL) <= 1))
 #define SEEDVAL(VAL) (unsigned char)((VAL) == 1 ? 255 : (VAL) * 256)
 
@@ -126,6 +107,7 @@ void Genome::seedAll( float rawval_ratio )
 	SEEDCHECK(rawval_ratio);
 
 	unsigned char val = SEEDVAL(rawval_ratio);
+	decoded = false;
     for (long xbyte = 0; xbyte < nbytes; xbyte++)
 	{
         mutable_data[xbyte] = val;
@@ -135,6 +117,7 @@ void Genome::seedAll( float rawval_ratio )
 void Genome::randomizeBits( float bitonprob )
 {
 	// do a random initialization of the bitstring
+	decoded = false;
     for (long xbyte = 0; xbyte < nbytes; xbyte++)
     {
         for (long bit = 0; bit < 8; bit++)
@@ -159,9 +142,9 @@ void Genome::randomizeBytes()
 
 void Genome::randomize()
 {
-	if (GenomeSchema::config.resolution == GenomeSchema::RESOLUTION_BIT)
+	if (GenomeSchema::config().resolution == GenomeSchema::RESOLUTION_BIT)
 		randomizeBits();
-	else if (GenomeSchema::config.resolution == GenomeSchema::RESOLUTION_BYTE)
+	else if (GenomeSchema::config().resolution == GenomeSchema::RESOLUTION_BYTE)
 		randomizeBytes();
 	else
 		assert( false );
@@ -169,6 +152,7 @@ void Genome::randomize()
 
 void Genome::mutateBits( float rate )
 {
+	decoded = false;
     for (long xbyte = 0; xbyte < nbytes; xbyte++)
     {
         for (long bit = 0; bit < 8; bit++)
@@ -181,18 +165,19 @@ void Genome::mutateBits( float rate )
 
 void Genome::mutateBits()
 {
-    mutateBits( get( "MutationRate" ) );
+    mutateBits( get( MUTATION_RATE ) );
 }
 
 void Genome::mutateOneByte( long xbyte, float stdev )
 {
+    decoded = false;
     int val = round( nrand( mutable_data[xbyte], stdev ) );
     mutable_data[xbyte] = pwclamp( val, 0, 255 );
 }
 
 void Genome::mutateBytes( float rate )
 {
-    float stdev = pow( 2.0, get( "MutationStdevPower" ) );
+    float stdev = pow( 2.0, get( MUTATION_STDEV_POWER ) );
     for (long xbyte = 0; xbyte < nbytes; xbyte++)
     {
         if (randpw() < rate)
@@ -202,16 +187,16 @@ void Genome::mutateBytes( float rate )
 
 void Genome::mutateBytes()
 {
-    mutateBytes( get( "MutationRate" ) );
+    mutateBytes( get( MUTATION_RATE ) );
 }
 
 void Genome::mutate( float rate )
 {
-	if (!GenomeSchema::config.enableEvolution)
+	if (!GenomeSchema::config().enableEvolution)
 		return;
-	if (GenomeSchema::config.resolution == GenomeSchema::RESOLUTION_BIT)
+	if (GenomeSchema::config().resolution == GenomeSchema::RESOLUTION_BIT)
 		mutateBits( rate );
-	else if (GenomeSchema::config.resolution == GenomeSchema::RESOLUTION_BYTE)
+	else if (GenomeSchema::config().resolution == GenomeSchema::RESOLUTION_BYTE)
 		mutateBytes( rate );
 	else
 		assert( false );
@@ -219,7 +204,7 @@ void Genome::mutate( float rate )
 
 void Genome::mutate()
 {
-	mutate( get( "MutationRate" ) );
+	mutate( get( MUTATION_RATE ) );
 }
 
 void Genome::crossover( Genome *g1, Genome *g2, bool mutate )
@@ -228,14 +213,16 @@ void Genome::crossover( Genome *g1, Genome *g2, bool mutate )
 	assert(g1 != g2);
 	assert(mutable_data != NULL);
 
+	decoded = false;
+
     // Randomly select number of crossover points from chosen genome
     long numCrossPoints;
     if (randpw() < 0.5)
-        numCrossPoints = g1->get( "CrossoverPointCount" );
+        numCrossPoints = g1->get( g1->CROSSOVER_POINT_COUNT );
     else
-		numCrossPoints = g2->get( "CrossoverPointCount" );
+		numCrossPoints = g2->get( g2->CROSSOVER_POINT_COUNT );
 
-	if (!GenomeSchema::config.enableEvolution)
+	if (!GenomeSchema::config().enableEvolution)
 		numCrossPoints = 0;
 
 	if( numCrossPoints == 0 )
@@ -258,7 +245,7 @@ void Genome::crossover( Genome *g1, Genome *g2, bool mutate )
     long i, j;
 
 #ifdef DUMPBITS
-    if (GenomeSchema::config.resolution == GenomeSchema::RESOLUTION_BIT)
+    if (GenomeSchema::config().resolution == GenomeSchema::RESOLUTION_BIT)
     {
         cout << "**The crossover bits(bytes) are:" nl << "  ";
         for (i = 0; i < numCrossPoints; i++)
@@ -268,7 +255,7 @@ void Genome::crossover( Genome *g1, Genome *g2, bool mutate )
         }
         cout nlf;
     }
-    else if (GenomeSchema::config.resolution == GenomeSchema::RESOLUTION_BYTE)
+    else if (GenomeSchema::config().resolution == GenomeSchema::RESOLUTION_BYTE)
     {
         cout << "**The crossover bytes are:" nl << "  ";
         for (i = 0; i < numCrossPoints; i++)
@@ -300,9 +287,9 @@ void Genome::crossover( Genome *g1, Genome *g2, bool mutate )
         }
         else
         {
-            if (GenomeSchema::config.resolution == GenomeSchema::RESOLUTION_BIT)
+            if (GenomeSchema::config().resolution == GenomeSchema::RESOLUTION_BIT)
                 endbyte = crossoverPoints[i] >> 3;
-            else if (GenomeSchema::config.resolution == GenomeSchema::RESOLUTION_BYTE)
+            else if (GenomeSchema::config().resolution == GenomeSchema::RESOLUTION_BYTE)
                 endbyte = crossoverPoints[i];
             else
                 assert( false );
@@ -325,14 +312,14 @@ void Genome::crossover( Genome *g1, Genome *g2, bool mutate )
 
         if (i < numCrossPoints)  // except on the last stretch...
         {
-            if (GenomeSchema::config.resolution == GenomeSchema::RESOLUTION_BIT)
+            if (GenomeSchema::config().resolution == GenomeSchema::RESOLUTION_BIT)
             {
                 bit = crossoverPoints[i] - (endbyte << 3);
                 // this goes left to right, corresponding more directly to little-endian machines, but leave it alone (at least for now)
                 mutable_data[endbyte] = char((ga->mutable_data[endbyte] & (255 << (8 - bit)))
                                         | (gb->mutable_data[endbyte] & (255 >> bit)));
             }
-            else if (GenomeSchema::config.resolution == GenomeSchema::RESOLUTION_BYTE)
+            else if (GenomeSchema::config().resolution == GenomeSchema::RESOLUTION_BYTE)
             {
                 mutable_data[endbyte] = gb->mutable_data[endbyte];
             }
@@ -355,6 +342,7 @@ void Genome::copyFrom( Genome *g )
 	assert( schema == g->schema );
 
 	memcpy( mutable_data, g->mutable_data, nbytes );
+	decoded = false;
 }
 
 float Genome::separation( Genome *g )
@@ -537,6 +525,37 @@ void Genome::load( AbstractFile *in )
 	}
 }
 
+void Genome::dump( unsigned char *out )
+{
+	for( int i = 0; i < nbytes; i++ )
+	{
+		out[i] = get_raw( i );
+	}
+}
+
+void Genome::load( const unsigned char *in )
+{
+	for( int i = 0; i < nbytes; i++ )
+	{
+		set_raw( i, 1, in[i] );
+	}
+}
+
+void Genome::decode()
+{
+	if( decodedValues == NULL )
+		decodedValues = new GeneValue[nbytes];
+
+	for( int i = 0; i < nbytes; i++ )
+	{
+		__InterpolatedGene *decoder = schema->getDecoder( i );
+		if( decoder )
+			decodedValues[i] = decoder->decode( get_raw(i) );
+	}
+
+	decoded = true;
+}
+
 void Genome::print()
 {
 	long lobit = 0;
@@ -35,6 +35,15 @@ namespace genome
 
 		Gene *MISC_BIAS;
 		Gene *MISC_INVIS_SLOPE;
+		Gene *MUTATION_RATE;
+		Gene *MUTATION_STDEV_POWER;
+		Gene *CROSSOVER_POINT_COUNT;
+		Gene *LIFE_SPAN;
+		Gene *ID;
+		Gene *STRENGTH;
+		Gene *SIZE;
+		Gene *MAX_SPEED;
+		Gene *MATE_ENERGY_FRACTION;
 
 		Gene *gene( const char *name );
 
@@ -42,7 +51,6 @@ namespace genome
 		Scalar get( Gene *gene );
 
         unsigned int get_raw_uint( long xbyte );
-		void updateSum( unsigned long *sum, unsigned long *sum2 );
 
 		void seed( Gene *gene,
 				   float rawval_ratio );
@@ -72,12 +80,22 @@ namespace genome
 
 		void dump( AbstractFile *out );
 		void load( AbstractFile *in );
+		// Same values as the AbstractFile versions, one byte per gene.
+		void dump( unsigned char *out );
+		void load( const unsigned char *in );
 
 		void print();
 		void print( long lobit, long hibit );
 
+		// Interpolates every byte once so that gene reads become table
+		// lookups. Holds until the genome is next modified.
+		void decode();
+		bool isDecoded();
+		GeneValue getDecoded( int offset );
+
 	protected:
 		friend class Gene;
+		friend class __InterpolatedGene;
 		friend class MutableScalarGene;
 		friend class MutableNeurGroupGene;
 		friend class NeurGroupAttrGene;
@@ -96,6 +114,8 @@ namespace genome
 
 		int nbytes;
 		unsigned char *mutable_data;
+		// Cleared by anything that writes mutable_data.
+		bool decoded;
 
 	private:
 		void alloc();
@@ -103,6 +123,7 @@ namespace genome
 		GenomeSchema *schema;
 		GenomeLayout *layout;
 		bool gray;
+		GeneValue *decodedValues;
 	};
 
 
@@ -123,12 +144,26 @@ inline unsigned char Genome::get_raw( int offset )
 	return val;
 }
 
+inline bool Genome::isDecoded()
+{
+	return decoded;
+}
+
+inline GeneValue Genome::getDecoded( int offset )
+{
+	assert( decoded && offset >= 0 && offset < nbytes );
+
+	return decodedValues[offset];
+}
+
 inline void Genome::set_raw( int offset,
 							 int n,
 							 unsigned char val )
 {
 	assert( (offset >= 0) && (offset + n <= nbytes) );
 
+	decoded = false;
+
 	if( gray )
 	{
 		val = grayofbin[val];
@@ -149,6 +184,8 @@ inline void Genome::set_raw_random( int offset,
 {
 	assert( (offset >= 0) && (offset + n <= nbytes) );
 
+	decoded = false;
+
 	for( int i = 0; i < n; i++ )
 	{
 		int layoutOffset = layout->getMutableDataOffset( offset + i );
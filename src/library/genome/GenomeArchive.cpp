@@ -0,0 +1,258 @@
+#include "GenomeArchive.h"
+
+#include <assert.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/stat.h>
+#if !__WIN64__ && !__WIN32__
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <unistd.h>
+#endif
+
+#include <iostream>
+
+using namespace genome;
+
+#define MAGIC "PWGENARC"
+#define VERSION 1
+
+const char *GenomeArchive::RelativePath = "genome/genomes.pwga";
+
+//---------------------------------------------------------------------------
+// GenomeArchive::getPath
+//---------------------------------------------------------------------------
+std::string GenomeArchive::getPath( const std::string &run )
+{
+	return run + "/" + RelativePath;
+}
+
+//---------------------------------------------------------------------------
+// GenomeArchive::exists
+//---------------------------------------------------------------------------
+bool GenomeArchive::exists( const std::string &run )
+{
+	struct stat st;
+	return 0 == stat( getPath(run).c_str(), &st );
+}
+
+//---------------------------------------------------------------------------
+// GenomeArchive::create
+//---------------------------------------------------------------------------
+GenomeArchive *GenomeArchive::create( const std::string &path, int genomeSize )
+{
+	GenomeArchive *archive = new GenomeArchive();
+	archive->path = path;
+
+	Header &header = archive->header;
+	memcpy( header.magic, MAGIC, sizeof(header.magic) );
+	header.version = VERSION;
+	header.genomeSize = genomeSize;
+	header.recordSize = genomeSize + 1;
+	header.headerSize = HeaderSize;
+
+	archive->out = fopen( path.c_str(), "w" );
+	if( archive->out == NULL )
+	{
+		std::cerr << "Failed creating genome archive " << path << std::endl;
+		exit( 1 );
+	}
+
+	unsigned char buf[HeaderSize];
+	memset( buf, 0, sizeof(buf) );
+	memcpy( buf, &header, sizeof(header) );
+	if( fwrite(buf, 1, HeaderSize, archive->out) != HeaderSize )
+	{
+		std::cerr << "Failed writing genome archive header " << path << std::endl;
+		exit( 1 );
+	}
+
+	archive->record = new unsigned char[header.recordSize];
+
+	return archive;
+}
+
+//---------------------------------------------------------------------------
+// GenomeArchive::open
+//---------------------------------------------------------------------------
+GenomeArchive *GenomeArchive::open( const std::string &path )
+{
+#if !__WIN64__ && !__WIN32__
+	int fd = ::open( path.c_str(), O_RDONLY );
+	if( fd < 0 )
+		return NULL;
+
+	struct stat st;
+	if( (fstat(fd, &st) != 0) || (st.st_size < HeaderSize) )
+	{
+		std::cerr << "Invalid genome archive " << path << std::endl;
+		exit( 1 );
+	}
+
+	void *mapping = mmap( NULL, st.st_size, PROT_READ, MAP_SHARED, fd, 0 );
+	if( mapping == MAP_FAILED )
+	{
+		std::cerr << "Failed mapping genome archive " << path << std::endl;
+		exit( 1 );
+	}
+#else
+	// No mmap, so the whole file is read in.
+	FILE *in = fopen( path.c_str(), "rb" );
+	if( in == NULL )
+		return NULL;
+
+	struct stat st;
+	if( (stat(path.c_str(), &st) != 0) || (st.st_size < HeaderSize) )
+	{
+		std::cerr << "Invalid genome archive " << path << std::endl;
+		exit( 1 );
+	}
+
+	unsigned char *mapping = new unsigned char[st.st_size];
+	if( fread(mapping, 1, st.st_size, in) != (size_t)st.st_size )
+	{
+		std::cerr << "Failed reading genome archive " << path << std::endl;
+		exit( 1 );
+	}
+	fclose( in );
+#endif
+
+	GenomeArchive *archive = new GenomeArchive();
+	archive->path = path;
+#if !__WIN64__ && !__WIN32__
+	archive->fd = fd;
+#endif
+	archive->mapping = (const unsigned char *)mapping;
+	archive->mappingSize = st.st_size;
+
+	Header &header = archive->header;
+	memcpy( &header, mapping, sizeof(header) );
+	if( (memcmp(header.magic, MAGIC, sizeof(header.magic)) != 0)
+		|| (header.version != VERSION)
+		|| (header.recordSize != header.genomeSize + 1) )
+	{
+		std::cerr << "Unrecognized genome archive format " << path << std::endl;
+		exit( 1 );
+	}
+
+	// A partially written trailing record (e.g. the run was killed) is ignored.
+	archive->nrecords = (st.st_size - header.headerSize) / header.recordSize;
+
+#if !__WIN64__ && !__WIN32__
+	madvise( mapping, st.st_size, MADV_WILLNEED );
+#endif
+
+	return archive;
+}
+
+//---------------------------------------------------------------------------
+// GenomeArchive::GenomeArchive
+//---------------------------------------------------------------------------
+GenomeArchive::GenomeArchive()
+: out( NULL )
+, nextId( 0 )
+, record( NULL )
+, fd( -1 )
+, mapping( NULL )
+, mappingSize( 0 )
+, nrecords( 0 )
+{
+	memset( &header, 0, sizeof(header) );
+}
+
+//---------------------------------------------------------------------------
+// GenomeArchive::~GenomeArchive
+//---------------------------------------------------------------------------
+GenomeArchive::~GenomeArchive()
+{
+	if( out )
+		fclose( out );
+	delete [] record;
+
+#if !__WIN64__ && !__WIN32__
+	if( mapping )
+		munmap( (void *)mapping, mappingSize );
+	if( fd >= 0 )
+		close( fd );
+#else
+	delete [] mapping;
+#endif
+}
+
+//---------------------------------------------------------------------------
+// GenomeArchive::getGenomeSize
+//---------------------------------------------------------------------------
+int GenomeArchive::getGenomeSize()
+{
+	return header.genomeSize;
+}
+
+//---------------------------------------------------------------------------
+// GenomeArchive::getMaxId
+//---------------------------------------------------------------------------
+long GenomeArchive::getMaxId()
+{
+	return (out ? nextId : nrecords) - 1;
+}
+
+//---------------------------------------------------------------------------
+// GenomeArchive::contains
+//---------------------------------------------------------------------------
+bool GenomeArchive::contains( long id )
+{
+	assert( mapping );
+
+	if( (id < 0) || (id >= nrecords) )
+		return false;
+
+	return mapping[ header.headerSize + id * header.recordSize ] != 0;
+}
+
+//---------------------------------------------------------------------------
+// GenomeArchive::get
+//---------------------------------------------------------------------------
+const unsigned char *GenomeArchive::get( long id )
+{
+	if( !contains(id) )
+		return NULL;
+
+	return mapping + header.headerSize + id * header.recordSize + 1;
+}
+
+//---------------------------------------------------------------------------
+// GenomeArchive::append
+//---------------------------------------------------------------------------
+void GenomeArchive::append( long id, const unsigned char *genes )
+{
+	assert( out );
+	assert( id >= nextId );
+
+	// Zeroed records for agents that weren't recorded.
+	memset( record, 0, header.recordSize );
+	for( ; nextId < id; nextId++ )
+	{
+		if( fwrite(record, 1, header.recordSize, out) != header.recordSize )
+		{
+			std::cerr << "Failed writing genome archive " << path << std::endl;
+			exit( 1 );
+		}
+	}
+
+	record[0] = 1;
+	memcpy( record + 1, genes, header.genomeSize );
+	if( fwrite(record, 1, header.recordSize, out) != header.recordSize )
+	{
+		std::cerr << "Failed writing genome archive " << path << std::endl;
+		exit( 1 );
+	}
+	nextId++;
+}
+
+//---------------------------------------------------------------------------
+// GenomeArchive::flush
+//---------------------------------------------------------------------------
+void GenomeArchive::flush()
+{
+	assert( out );
+	fflush( out );
+}
@@ -0,0 +1,80 @@
+#pragma once
+
+#include <stdint.h>
+#include <stdio.h>
+
+#include <string>
+
+namespace genome
+{
+	// ================================================================================
+	// ===
+	// === CLASS GenomeArchive
+	// ===
+	// === All genomes of a run in one file, indexed by agent number:
+	// ===
+	// ===   Header  (HeaderSize bytes, see struct Header)
+	// ===   Record  agent 0
+	// ===   Record  agent 1
+	// ===   ...
+	// ===
+	// === Each record is one flag byte (nonzero if the agent's genome was recorded)
+	// === followed by the genome's bytes in schema order, i.e. the same values as
+	// === the lines of genome/agents/genome_N.txt. Records are appended in agent
+	// === order while the simulation runs, so agents that were never recorded
+	// === leave a zeroed record behind. Readers map the file into memory, or read
+	// === it in where mmap isn't available.
+	// ===
+	// ================================================================================
+	class GenomeArchive
+	{
+	public:
+		static const char *RelativePath;
+		static const int HeaderSize = 64;
+
+		struct Header
+		{
+			char magic[8];
+			uint32_t version;
+			uint32_t genomeSize;
+			uint32_t recordSize;
+			uint32_t headerSize;
+		};
+
+		static std::string getPath( const std::string &run );
+		static bool exists( const std::string &run );
+
+		// Writer
+		static GenomeArchive *create( const std::string &path, int genomeSize );
+		// Reader. Returns NULL if the file does not exist.
+		static GenomeArchive *open( const std::string &path );
+
+		~GenomeArchive();
+
+		int getGenomeSize();
+		long getMaxId();
+
+		// Reader only
+		bool contains( long id );
+		const unsigned char *get( long id );
+
+		// Writer only. Ids must be strictly increasing.
+		void append( long id, const unsigned char *genes );
+		void flush();
+
+	private:
+		GenomeArchive();
+
+		std::string path;
+		Header header;
+
+		FILE *out;
+		long nextId;
+		unsigned char *record;
+
+		int fd;
+		const unsigned char *mapping;
+		size_t mappingSize;
+		long nrecords;
+	};
+}
@@ -24,7 +24,8 @@ namespace genome
 
 		static GenomeLayout *create( GenomeSchema *schema,
 									 LayoutType type );
-		
+		~GenomeLayout();
+
 	public:
 		int getMutableDataOffset( int geneOffset );
 		int getMutableDataOffset_nocheck( int geneOffset );
@@ -36,7 +37,6 @@ namespace genome
 
 	private:
 		GenomeLayout( GenomeSchema *schema );
-		~GenomeLayout();
 
 		void validate();
 
@@ -7,6 +7,7 @@
 #include "agent/agent.h"
 #include "agent/Metabolism.h"
 #include "genome/sheets/SheetsGenomeSchema.h"
+#include "sim/SimulationContext.h"
 #include "utils/misc.h"
 
 using namespace genome;
@@ -17,7 +18,13 @@ using namespace genome;
 // ===
 // ================================================================================
 
-GenomeSchema::Configuration GenomeSchema::config;
+//-------------------------------------------------------------------------------------------
+// GenomeSchema::config
+//-------------------------------------------------------------------------------------------
+GenomeSchema::Configuration &GenomeSchema::config()
+{
+	return SimulationContext::current()->get<Configuration>();
+}
 
 //-------------------------------------------------------------------------------------------
 // GenomeSchema::processWorldfile
@@ -27,60 +34,60 @@ void GenomeSchema::processWorldfile( proplib::Document &doc )
 	{
         std::string layout = doc.get( "GenomeLayout" );
 		if( layout == "NeurGroup")
-			GenomeSchema::config.layoutType = genome::GenomeLayout::NeurGroup;
+			GenomeSchema::config().layoutType = genome::GenomeLayout::NeurGroup;
 		else if( layout == "None" )
-			GenomeSchema::config.layoutType = genome::GenomeLayout::None;
+			GenomeSchema::config().layoutType = genome::GenomeLayout::None;
 		else
 			assert( false );
 	}
 	{
         std::string resolution = doc.get( "GeneticOperatorResolution" );
 		if( resolution == "Bit" )
-			GenomeSchema::config.resolution = GenomeSchema::RESOLUTION_BIT;
+			GenomeSchema::config().resolution = GenomeSchema::RESOLUTION_BIT;
 		else if( resolution == "Byte" )
-			GenomeSchema::config.resolution = GenomeSchema::RESOLUTION_BYTE;
+			GenomeSchema::config().resolution = GenomeSchema::RESOLUTION_BYTE;
 		else
 			assert( false );
 	}
-    GenomeSchema::config.enableEvolution = doc.get( "EnableEvolution" );
-    GenomeSchema::config.minMutationRate = doc.get( "MinMutationRate" );
-    GenomeSchema::config.maxMutationRate = doc.get( "MaxMutationRate" );
-    GenomeSchema::config.minMutationStdevPower = doc.get( "MinMutationStdevPower" );
-    GenomeSchema::config.maxMutationStdevPower = doc.get( "MaxMutationStdevPower" );
-    GenomeSchema::config.minNumCpts = doc.get( "MinCrossoverPoints" );
-    GenomeSchema::config.maxNumCpts = doc.get( "MaxCrossoverPoints" );
-    GenomeSchema::config.miscBias = doc.get( "MiscegenationFunctionBias" );
-    GenomeSchema::config.miscInvisSlope = doc.get( "MiscegenationFunctionInverseSlope" );
+    GenomeSchema::config().enableEvolution = doc.get( "EnableEvolution" );
+    GenomeSchema::config().minMutationRate = doc.get( "MinMutationRate" );
+    GenomeSchema::config().maxMutationRate = doc.get( "MaxMutationRate" );
+    GenomeSchema::config().minMutationStdevPower = doc.get( "MinMutationStdevPower" );
+    GenomeSchema::config().maxMutationStdevPower = doc.get( "MaxMutationStdevPower" );
+    GenomeSchema::config().minNumCpts = doc.get( "MinCrossoverPoints" );
+    GenomeSchema::config().maxNumCpts = doc.get( "MaxCrossoverPoints" );
+    GenomeSchema::config().miscBias = doc.get( "MiscegenationFunctionBias" );
+    GenomeSchema::config().miscInvisSlope = doc.get( "MiscegenationFunctionInverseSlope" );
 	{
 		proplib::Property &propPowers = doc.get( "GeneInterpolationPower" );
 		itfor( proplib::PropertyMap, propPowers.elements(), it )
 		{
-			GenomeSchema::config.geneInterpolationPower[ it->second->get("Name") ] = it->second->get( "Power" );
+			GenomeSchema::config().geneInterpolationPower[ it->second->get("Name") ] = it->second->get( "Power" );
 		}
 	}
-    GenomeSchema::config.minBitProb = doc.get( "MinInitialBitProb" );
-    GenomeSchema::config.maxBitProb = doc.get( "MaxInitialBitProb" );
+    GenomeSchema::config().minBitProb = doc.get( "MinInitialBitProb" );
+    GenomeSchema::config().maxBitProb = doc.get( "MaxInitialBitProb" );
 	{
         std::string seedType = doc.get( "SeedType" );
 		if( seedType == "Legacy" )
-			GenomeSchema::config.seedType = GenomeSchema::SEED_LEGACY;
+			GenomeSchema::config().seedType = GenomeSchema::SEED_LEGACY;
 		else if( seedType == "Simple" )
-			GenomeSchema::config.seedType = GenomeSchema::SEED_SIMPLE;
+			GenomeSchema::config().seedType = GenomeSchema::SEED_SIMPLE;
 		else if( seedType == "Random" )
-			GenomeSchema::config.seedType = GenomeSchema::SEED_RANDOM;
+			GenomeSchema::config().seedType = GenomeSchema::SEED_RANDOM;
 		else
 			assert( false );
 	}
-	GenomeSchema::config.seedMutationRate = doc.get( "SeedMutationRate" );
-	GenomeSchema::config.simpleSeedYawBiasDelta = doc.get( "SimpleSeedYawBiasDelta" );
-	GenomeSchema::config.seedFightBias = doc.get( "SeedFightBias" );
-	GenomeSchema::config.seedFightExcitation = doc.get( "SeedFightExcitation" );
-	GenomeSchema::config.seedGiveBias = doc.get( "SeedGiveBias" );
-	GenomeSchema::config.seedPickupBias = doc.get( "SeedPickupBias" );
-	GenomeSchema::config.seedDropBias = doc.get( "SeedDropBias" );
-	GenomeSchema::config.seedPickupExcitation = doc.get( "SeedPickupExcitation" );
-	GenomeSchema::config.seedDropExcitation = doc.get( "SeedDropExcitation" );
-    GenomeSchema::config.grayCoding = doc.get( "GrayCoding" );
+	GenomeSchema::config().seedMutationRate = doc.get( "SeedMutationRate" );
+	GenomeSchema::config().simpleSeedYawBiasDelta = doc.get( "SimpleSeedYawBiasDelta" );
+	GenomeSchema::config().seedFightBias = doc.get( "SeedFightBias" );
+	GenomeSchema::config().seedFightExcitation = doc.get( "SeedFightExcitation" );
+	GenomeSchema::config().seedGiveBias = doc.get( "SeedGiveBias" );
+	GenomeSchema::config().seedPickupBias = doc.get( "SeedPickupBias" );
+	GenomeSchema::config().seedDropBias = doc.get( "SeedDropBias" );
+	GenomeSchema::config().seedPickupExcitation = doc.get( "SeedPickupExcitation" );
+	GenomeSchema::config().seedDropExcitation = doc.get( "SeedDropExcitation" );
+    GenomeSchema::config().grayCoding = doc.get( "GrayCoding" );
 
 
 	SheetsGenomeSchema::processWorldfile( doc );
@@ -122,29 +129,29 @@ void GenomeSchema::define()
 															   __InterpolatedGene::ROUND_INT_BIN) )
 
 	INTERPOLATED_IMMUTABLE( BitProbability,
-							GenomeSchema::config.minBitProb,
-							GenomeSchema::config.maxBitProb );
+							GenomeSchema::config().minBitProb,
+							GenomeSchema::config().maxBitProb );
 
 	SCALAR( MutationRate,
-			GenomeSchema::config.minMutationRate,
-			GenomeSchema::config.maxMutationRate );
+			GenomeSchema::config().minMutationRate,
+			GenomeSchema::config().maxMutationRate );
 
-	if( GenomeSchema::config.resolution == GenomeSchema::RESOLUTION_BYTE )
+	if( GenomeSchema::config().resolution == GenomeSchema::RESOLUTION_BYTE )
 	{
 		SCALAR( MutationStdevPower,
-				GenomeSchema::config.minMutationStdevPower,
-				GenomeSchema::config.maxMutationStdevPower );
+				GenomeSchema::config().minMutationStdevPower,
+				GenomeSchema::config().maxMutationStdevPower );
 	}
 
 	SCALAR( CrossoverPointCount,
-		   GenomeSchema::config.minNumCpts,
-		   GenomeSchema::config.maxNumCpts );
+		   GenomeSchema::config().minNumCpts,
+		   GenomeSchema::config().maxNumCpts );
 
 	SCALAR( LifeSpan,
-		   agent::config.minLifeSpan,
-		   agent::config.maxLifeSpan );
+		   agent::config().minLifeSpan,
+		   agent::config().maxLifeSpan );
 
-	if( agent::config.bodyGreenChannel == agent::BGC_ID )
+	if( agent::config().bodyGreenChannel == agent::BGC_ID )
 	{
 		SCALAR( ID,
 				0.0,
@@ -152,22 +159,22 @@ void GenomeSchema::define()
 	}
 
 	SCALAR( Strength,
-		   agent::config.minStrength,
-		   agent::config.maxStrength );
+		   agent::config().minStrength,
+		   agent::config().maxStrength );
 
 	SCALAR( Size,
-		   agent::config.minAgentSize,
-		   agent::config.maxAgentSize );
+		   agent::config().minAgentSize,
+		   agent::config().maxAgentSize );
 
 	SCALAR( MaxSpeed,
-		   agent::config.minmaxspeed,
-		   agent::config.maxmaxspeed );
+		   agent::config().minmaxspeed,
+		   agent::config().maxmaxspeed );
 
 	SCALAR( MateEnergyFraction,
-		   agent::config.minmateenergy,
-		   agent::config.maxmateenergy );
+		   agent::config().minmateenergy,
+		   agent::config().maxmateenergy );
 
-	if( Metabolism::selectionMode == Metabolism::Gene
+	if( Metabolism::selectionMode() == Metabolism::Gene
 		&& (Metabolism::getNumberOfDefinitions() > 1) )
 	{
 		INDEX( MetabolismIndex,
@@ -175,7 +182,7 @@ void GenomeSchema::define()
 			   Metabolism::getNumberOfDefinitions() - 1 );
 	}
 
-	if( Brain::config.neuronModel == Brain::Configuration::SPIKING )
+	if( Brain::config().neuronModel == Brain::Configuration::SPIKING )
 	{
 		SCALAR( ScaleLatestSpikes,
 			   0.1,
@@ -209,15 +216,59 @@ void GenomeSchema::seed( Genome *g )
 		}
 	}
 
-	if( GenomeSchema::config.minMutationRate != GenomeSchema::config.maxMutationRate )
+	if( GenomeSchema::config().minMutationRate != GenomeSchema::config().maxMutationRate )
 	{
-		SEED( MutationRate, GenomeSchema::config.seedMutationRate );
+		SEED( MutationRate, GenomeSchema::config().seedMutationRate );
 	}
 
-	if( Metabolism::selectionMode == Metabolism::Gene
+	if( Metabolism::selectionMode() == Metabolism::Gene
 		&& Metabolism::getNumberOfDefinitions() > 1 )
 	{
 		SEED( MetabolismIndex, randpw() );
 	}
 #undef SEED
 }
+
+//-------------------------------------------------------------------------------------------
+// GenomeSchema::prepareDecoding
+//-------------------------------------------------------------------------------------------
+void GenomeSchema::prepareDecoding()
+{
+	assert( _state == STATE_COMPLETE );
+
+	_decoders.assign( getMutableSize(), NULL );
+
+	prepareDecoding( getAll() );
+}
+
+//-------------------------------------------------------------------------------------------
+// GenomeSchema::prepareDecoding
+//
+// Bytes that don't belong to an interpolated gene are left without a decoder.
+//-------------------------------------------------------------------------------------------
+void GenomeSchema::prepareDecoding( const GeneVector &genes )
+{
+	citfor( GeneVector, genes, it )
+	{
+		Gene *gene = *it;
+		if( !gene->ismutable )
+			continue;
+
+		if( gene->type == GeneType::CONTAINER )
+		{
+			prepareDecoding( GeneType::to_Container(gene)->getAll() );
+			continue;
+		}
+
+		__InterpolatedGene *igene = dynamic_cast<__InterpolatedGene *>( gene );
+		if( igene == NULL )
+			continue;
+
+		igene->prepareDecoding();
+
+		int offset = gene->getOffset();
+		int end = offset + gene->getMutableSize();
+		for( ; offset < end; offset++ )
+			_decoders[offset] = igene;
+	}
+}
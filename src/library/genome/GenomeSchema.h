@@ -26,7 +26,7 @@ namespace genome
 			SEED_RANDOM
 		};
 
-		static struct Configuration
+		struct Configuration
 		{
 			GenomeLayout::LayoutType layoutType;
 			Resolution resolution;
@@ -57,7 +57,8 @@ namespace genome
 			float minBitProb;
 			float maxBitProb;
 			bool grayCoding;
-		} config;
+		};
+		static Configuration &config();
 
 		static void processWorldfile( proplib::Document &doc );
 
@@ -68,6 +69,24 @@ namespace genome
 		virtual void seed( Genome *genome );
 
 		virtual Genome *createGenome( GenomeLayout *layout ) = 0;
+
+		// Builds the per-byte decoders used by Genome::decode(). Must follow
+		// complete() and any change to interpolation.
+		void prepareDecoding();
+		__InterpolatedGene *getDecoder( int offset );
+
+	private:
+		void prepareDecoding( const GeneVector &genes );
+
+		std::vector<__InterpolatedGene *> _decoders;
 	};
 
+	//===========================================================================
+	// inlines
+	//===========================================================================
+	inline __InterpolatedGene *GenomeSchema::getDecoder( int offset )
+	{
+		return _decoders[offset];
+	}
+
 } // namespace genome
@@ -12,41 +12,65 @@
 #include "genome/groups/GroupsGenomeSchema.h"
 #include "genome/sheets/SheetsGenomeSchema.h"
 #include "sim/globals.h"
+#include "sim/SimulationContext.h"
 #include "utils/misc.h"
 
 using namespace genome;
 
-GenomeSchema *GenomeUtil::schema = NULL;
-GenomeLayout *GenomeUtil::layout = NULL;
+// Per simulation, destroyed with its context.
+namespace
+{
+	struct GenomeUtilState
+	{
+		GenomeSchema *schema = NULL;
+		GenomeLayout *layout = NULL;
+
+		~GenomeUtilState()
+		{
+			delete layout;
+			delete schema;
+		}
+	};
+}
+
+GenomeSchema *&GenomeUtil::schema()
+{
+	return SimulationContext::current()->get<GenomeUtilState>().schema;
+}
+
+GenomeLayout *&GenomeUtil::layout()
+{
+	return SimulationContext::current()->get<GenomeUtilState>().layout;
+}
 
 GenomeSchema *GenomeUtil::createSchema()
 {
-	assert(schema == NULL);
+	assert(schema() == NULL);
 
 	// ---
 	// --- Schema
 	// ---
-	switch( Brain::config.architecture )
+	switch( Brain::config().architecture )
 	{
 	case Brain::Configuration::Groups:
-		schema = new GroupsGenomeSchema();
+		schema() = new GroupsGenomeSchema();
 		break;
 	case Brain::Configuration::Sheets:
-		schema = new SheetsGenomeSchema();
+		schema() = new SheetsGenomeSchema();
 		break;
 	default:
 		assert( false );
 	}
 
-	schema->define();
-	schema->complete();	
+	schema()->define();
+	schema()->complete();	
 
 	// ---
 	// --- Configure Interpolation
 	// ---
-	itfor( GenomeSchema::Configuration::GeneInterpolationPowers, GenomeSchema::config.geneInterpolationPower, it )
+	itfor( GenomeSchema::Configuration::GeneInterpolationPowers, GenomeSchema::config().geneInterpolationPower, it )
 	{
-		Gene *gene = schema->get( it->first );
+		Gene *gene = schema()->get( it->first );
 		if( !gene )
 		{
             std::cerr << "Invalid gene name for interpolation power: " << it->first << std::endl;
@@ -63,27 +87,29 @@ GenomeSchema *GenomeUtil::createSchema()
 		igene->setInterpolationPower( it->second );
 	}
 
+	schema()->prepareDecoding();
+
 	// ---
 	// --- Layout
 	// ---
-	layout = GenomeLayout::create( schema, GenomeSchema::config.layoutType );
+	layout() = GenomeLayout::create( schema(), GenomeSchema::config().layoutType );
 
 	
 #if false
-	//	schema->printIndexes( stdout );
-	Genome *g = schema->createGenome( layout );
+	//	schema()->printIndexes( stdout );
+	Genome *g = schema()->createGenome( layout() );
 	exit( 0 );
 #endif
 
-	return schema;
+	return schema();
 }
 
 Genome *GenomeUtil::createGenome( bool randomized )
 {
-	assert(schema);
-	assert(layout);
+	assert(schema());
+	assert(layout());
 
-	Genome *g = schema->createGenome( layout );
+	Genome *g = schema()->createGenome( layout() );
 
 	if( randomized )
 	{
@@ -104,10 +130,10 @@ void GenomeUtil::randomize( Genome *g )
 
 void GenomeUtil::seed( Genome *g )
 {
-	assert( schema );
+	assert( schema() );
 	assert( g );
 
-	schema->seed( g );
+	schema()->seed( g );
 }
 
 const Metabolism *GenomeUtil::getMetabolism( Genome *g )
@@ -128,7 +154,7 @@ const Metabolism *GenomeUtil::getMetabolism( Genome *g )
 
 Gene *GenomeUtil::getGene( const std::string &name, const std::string &err )
 {
-	Gene *gene = schema->get( name );
+	Gene *gene = schema()->get( name );
 	if( !gene && !err.empty() )
 	{
         std::cerr << err << std::endl;
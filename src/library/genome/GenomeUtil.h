@@ -23,8 +23,8 @@ namespace genome
 		static Gene *getGene( const std::string &name, const std::string &err = "" );
 
 	public:
-		static GenomeSchema *schema;
-		static GenomeLayout *layout;
+		static GenomeSchema *&schema();
+		static GenomeLayout *&layout();
 	};
 
 }
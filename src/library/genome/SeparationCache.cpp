@@ -1,12 +1,39 @@
 #include "SeparationCache.h"
 
+#include <vector>
+
 #include "agent/agent.h"
+#include "sim/SimulationContext.h"
 #include "utils/datalib.h"
 
 //#define DB(X...) printf(X)
 #define DB(X...)
 
-AgentAttachedData::SlotHandle SeparationCache::_slotHandle;
+namespace
+{
+	struct State
+	{
+		AgentAttachedData::SlotHandle handle;
+		// Entries of dead agents, emptied and waiting for a birth.
+		std::vector<SeparationCache::AgentEntries *> freeEntries;
+
+		~State()
+		{
+			for( SeparationCache::AgentEntries *entries : freeEntries )
+				delete entries;
+		}
+	};
+
+	State &state()
+	{
+		return SimulationContext::current()->get<State>();
+	}
+}
+
+AgentAttachedData::SlotHandle &SeparationCache::_slotHandle()
+{
+	return state().handle;
+}
 
 // --------------------------------------------------------------------------------
 // start()
@@ -15,7 +42,7 @@ AgentAttachedData::SlotHandle SeparationCache::_slotHandle;
 // --------------------------------------------------------------------------------
 void SeparationCache::init()
 {
-	_slotHandle = AgentAttachedData::createSlot();
+	_slotHandle() = AgentAttachedData::createSlot();
 }
 
 // --------------------------------------------------------------------------------
@@ -23,7 +50,20 @@ void SeparationCache::init()
 // --------------------------------------------------------------------------------
 void SeparationCache::birth( const sim::AgentBirthEvent &birth )
 {
-	AgentAttachedData::set( birth.a, _slotHandle, new AgentEntries() );
+	std::vector<AgentEntries *> &freeEntries = state().freeEntries;
+	AgentEntries *entries;
+
+	if( freeEntries.empty() )
+	{
+		entries = new AgentEntries();
+	}
+	else
+	{
+		entries = freeEntries.back();
+		freeEntries.pop_back();
+	}
+
+	AgentAttachedData::set( birth.a, _slotHandle(), entries );
 }
 
 // --------------------------------------------------------------------------------
@@ -31,7 +71,10 @@ void SeparationCache::birth( const sim::AgentBirthEvent &birth )
 // --------------------------------------------------------------------------------
 void SeparationCache::death( const sim::AgentDeathEvent &death )
 {
-	delete (AgentEntries *)AgentAttachedData::get( death.a, _slotHandle );
+	AgentEntries *entries = (AgentEntries *)AgentAttachedData::get( death.a, _slotHandle() );
+
+	entries->clear();
+	state().freeEntries.push_back( entries );
 }
 
 // --------------------------------------------------------------------------------
@@ -39,7 +82,7 @@ void SeparationCache::death( const sim::AgentDeathEvent &death )
 // --------------------------------------------------------------------------------
 SeparationCache::AgentEntries &SeparationCache::getEntries( agent *a )
 {
-	return *(AgentEntries *)AgentAttachedData::get( a, _slotHandle );
+	return *(AgentEntries *)AgentAttachedData::get( a, _slotHandle() );
 }
 
 
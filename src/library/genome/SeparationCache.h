@@ -23,5 +23,5 @@ class SeparationCache
 
  private:
 	// This gives us a reference to a per-agent opaque pointer.
-	static AgentAttachedData::SlotHandle _slotHandle;
+	static AgentAttachedData::SlotHandle &_slotHandle();
 };
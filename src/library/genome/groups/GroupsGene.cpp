@@ -100,7 +100,7 @@ MutableNeurGroupGene::MutableNeurGroupGene( const char *name_,
 
 Scalar MutableNeurGroupGene::get( Genome *genome )
 {
-	return interpolate( genome->get_raw(offset) );
+	return interpolate( genome, offset );
 }
 
 int MutableNeurGroupGene::getMaxGroupCount()
@@ -232,7 +232,7 @@ Scalar NeurGroupAttrGene::get( Genome *genome,
 {
 	int offset = getOffset( group );
 
-	return interpolate( genome->get_raw(offset) );
+	return interpolate( genome, offset );
 }
 
 void NeurGroupAttrGene::seed( Genome *genome,
@@ -338,7 +338,7 @@ Scalar SynapseAttrGene::get( Genome *genome,
 							group_from,
 							group_to );
 
-	Scalar result = interpolate( genome->get_raw(offset) );
+	Scalar result = interpolate( genome, offset );
 
 	if( negateInhibitory && synapseType->nt_from == INHIBITORY )
 	{
@@ -16,7 +16,7 @@ GroupsGenome::GroupsGenome( GroupsGenomeSchema *schema,
 		  layout )
 , _schema( schema )
 {
-	if( GroupsBrain::config.orderedinternalneurgroups )
+	if( GroupsBrain::config().orderedinternalneurgroups )
 	{
 		ORDER = gene("Order");
 	}
@@ -25,7 +25,7 @@ GroupsGenome::GroupsGenome( GroupsGenomeSchema *schema,
 		ORDER = NULL;
 	}
 
-	if( Brain::config.gaussianInitWeight )
+	if( Brain::config().gaussianInitWeight )
 	{
 		WEIGHT_STDEV = gene("WeightStdev");
 	}
@@ -37,7 +37,7 @@ GroupsGenome::GroupsGenome( GroupsGenomeSchema *schema,
 	CONNECTION_DENSITY = gene("ConnectionDensity");
 	TOPOLOGICAL_DISTORTION = gene("TopologicalDistortion");
 
-	if( Brain::config.enableLearning )
+	if( Brain::config().enableLearning )
 	{
 		LEARNING_RATE = gene("LearningRate");
 	}
@@ -51,7 +51,7 @@ GroupsGenome::GroupsGenome( GroupsGenomeSchema *schema,
 	BIAS = gene("Bias");
 	INTERNAL = schema->getGroupGene( schema->getFirstGroup(NGT_INTERNAL) );
 
-	if( Brain::config.neuronModel == Brain::Configuration::TAU_GAIN )
+	if( Brain::config().neuronModel == Brain::Configuration::TAU_GAIN )
 	{
 		TAU = gene( "Tau" );
 		GAIN = gene( "Gain" );
@@ -62,8 +62,8 @@ GroupsGenome::GroupsGenome( GroupsGenomeSchema *schema,
 		GAIN = NULL;
 	}
 
-	if( (Brain::config.neuronModel == Brain::Configuration::SPIKING)
-		&& Brain::config.Spiking.enableGenes )
+	if( (Brain::config().neuronModel == Brain::Configuration::SPIKING)
+		&& Brain::config().Spiking.enableGenes )
 	{
 		SPIKING_A = gene("SpikingParameterA");
 		SPIKING_B = gene("SpikingParameterB");
@@ -132,7 +132,7 @@ int GroupsGenome::getGroupCount( NeurGroupType type )
 
 std::vector<int> GroupsGenome::getOrderedGroups()
 {
-	if( GroupsBrain::config.orderedinternalneurgroups )
+	if( GroupsBrain::config().orderedinternalneurgroups )
 	{
 		int maxCount = _schema->getMaxGroupCount( NGT_ANY );
 		std::vector<std::pair<int, float> > orders( maxCount );
@@ -345,12 +345,12 @@ void GroupsGenome::getCrossoverPoints( long *crossoverPoints, long numCrossPoint
     // guarantee crossover in "physiology" genes
     if (numCrossPoints > 2 && numphysbytes > 1)
     {
-        if (GenomeSchema::config.resolution == GenomeSchema::RESOLUTION_BIT)
+        if (GenomeSchema::config().resolution == GenomeSchema::RESOLUTION_BIT)
         {
             crossoverPoints[0] = long(randpw() * numphysbytes * 8);	// requires [0.0, 1.0) range for randpw()
             crossoverPoints[1] = numphysbytes * 8;
         }
-        else if (GenomeSchema::config.resolution == GenomeSchema::RESOLUTION_BYTE)
+        else if (GenomeSchema::config().resolution == GenomeSchema::RESOLUTION_BYTE)
         {
             crossoverPoints[0] = long(randpw() * numphysbytes);	// requires [0.0, 1.0) range for randpw()
             crossoverPoints[1] = numphysbytes;
@@ -369,11 +369,11 @@ void GroupsGenome::getCrossoverPoints( long *crossoverPoints, long numCrossPoint
     for ( ; i < numCrossPoints; i++)
     {
         long newCrossPoint;
-        if (GenomeSchema::config.resolution == GenomeSchema::RESOLUTION_BIT)
+        if (GenomeSchema::config().resolution == GenomeSchema::RESOLUTION_BIT)
         {
             newCrossPoint = long(randpw() * (nbytes - numphysbytes) * 8) + numphysbytes * 8;
         }
-        else if (GenomeSchema::config.resolution == GenomeSchema::RESOLUTION_BYTE)
+        else if (GenomeSchema::config().resolution == GenomeSchema::RESOLUTION_BYTE)
         {
             newCrossPoint = long(randpw() * (nbytes - numphysbytes)) + numphysbytes;
         }
@@ -393,11 +393,11 @@ void GroupsGenome::getCrossoverPoints( long *crossoverPoints, long numCrossPoint
 
             if (equal)
             {
-                if (GenomeSchema::config.resolution == GenomeSchema::RESOLUTION_BIT)
+                if (GenomeSchema::config().resolution == GenomeSchema::RESOLUTION_BIT)
                 {
                     newCrossPoint = long(randpw() * (nbytes - numphysbytes) * 8) + numphysbytes * 8;
                 }
-                else if (GenomeSchema::config.resolution == GenomeSchema::RESOLUTION_BYTE)
+                else if (GenomeSchema::config().resolution == GenomeSchema::RESOLUTION_BYTE)
                 {
                     newCrossPoint = long(randpw() * (nbytes - numphysbytes)) + numphysbytes;
                 }
@@ -77,56 +77,56 @@ void GroupsGenomeSchema::define()
 
 	INPUT1( Random );
 	INPUT1( Energy );
-	if( agent::config.enableMateWaitFeedback )
+	if( agent::config().enableMateWaitFeedback )
 		INPUT1( MateWaitFeedback );
-	if( agent::config.enableSpeedFeedback )
+	if( agent::config().enableSpeedFeedback )
 		INPUT1( SpeedFeedback );
-	if( agent::config.enableCarry )
+	if( agent::config().enableCarry )
 	{
 		INPUT1( Carrying );
 		INPUT1( BeingCarried );
 	}
 	INPUT( Red,
-		   GroupsBrain::config.minvisneurpergroup,
-		   GroupsBrain::config.maxvisneurpergroup );
+		   GroupsBrain::config().minvisneurpergroup,
+		   GroupsBrain::config().maxvisneurpergroup );
 	INPUT( Green,
-		   GroupsBrain::config.minvisneurpergroup,
-		   GroupsBrain::config.maxvisneurpergroup );
+		   GroupsBrain::config().minvisneurpergroup,
+		   GroupsBrain::config().maxvisneurpergroup );
 	INPUT( Blue,
-		   GroupsBrain::config.minvisneurpergroup,
-		   GroupsBrain::config.maxvisneurpergroup );
+		   GroupsBrain::config().minvisneurpergroup,
+		   GroupsBrain::config().maxvisneurpergroup );
 
 	OUTPUT( Eat );
 	OUTPUT( Mate );
 	OUTPUT( Fight );
 	OUTPUT( Speed );
 	OUTPUT( Yaw );
-	if( agent::config.yawEncoding == agent::YE_OPPOSE )
+	if( agent::config().yawEncoding == agent::YE_OPPOSE )
 		OUTPUT( YawOppose );
-	if( agent::config.hasLightBehavior )
+	if( agent::config().hasLightBehavior )
 		OUTPUT( Light );
 	OUTPUT( Focus );
 
-	if( agent::config.enableVisionPitch )
+	if( agent::config().enableVisionPitch )
 		OUTPUT( VisionPitch );
 
-	if( agent::config.enableVisionYaw )
+	if( agent::config().enableVisionYaw )
 		OUTPUT( VisionYaw );
 
-	if( agent::config.enableGive )
+	if( agent::config().enableGive )
 		OUTPUT( Give );
 
-	if( agent::config.enableCarry )
+	if( agent::config().enableCarry )
 	{
 		OUTPUT( Pickup );
 		OUTPUT( Drop );
 	}
 
 	INTERNAL( InternalNeuronGroupCount,
-			  GroupsBrain::config.mininternalneurgroups,
-			  GroupsBrain::config.maxinternalneurgroups );
+			  GroupsBrain::config().mininternalneurgroups,
+			  GroupsBrain::config().maxinternalneurgroups );
 
-	if( GroupsBrain::config.orderedinternalneurgroups )
+	if( GroupsBrain::config().orderedinternalneurgroups )
 	{
 		GROUP_ATTR( Order,
 					INTERNAL,
@@ -136,56 +136,56 @@ void GroupsGenomeSchema::define()
 
 	GROUP_ATTR( ExcitatoryNeuronCount,
 				INTERNAL,
-				GroupsBrain::config.mineneurpergroup,
-				GroupsBrain::config.maxeneurpergroup );
+				GroupsBrain::config().mineneurpergroup,
+				GroupsBrain::config().maxeneurpergroup );
 
 	GROUP_ATTR( InhibitoryNeuronCount,
 				INTERNAL,
-				GroupsBrain::config.minineurpergroup,
-				GroupsBrain::config.maxineurpergroup );
+				GroupsBrain::config().minineurpergroup,
+				GroupsBrain::config().maxineurpergroup );
 
 	GROUP_ATTR( Bias,
 				NONINPUT,
-				-Brain::config.maxbias,
-				Brain::config.maxbias );
+				-Brain::config().maxbias,
+				Brain::config().maxbias );
 
-	if( Brain::config.neuronModel == Brain::Configuration::TAU_GAIN )
+	if( Brain::config().neuronModel == Brain::Configuration::TAU_GAIN )
 	{
 		GROUP_ATTR( Tau,
 					NONINPUT,
-					Brain::config.Tau.minVal,
-					Brain::config.Tau.maxVal );
+					Brain::config().Tau.minVal,
+					Brain::config().Tau.maxVal );
 		GROUP_ATTR( Gain,
 					NONINPUT,
-					Brain::config.Gain.minVal,
-					Brain::config.Gain.maxVal );
+					Brain::config().Gain.minVal,
+					Brain::config().Gain.maxVal );
 	}
 
-	if( Brain::config.neuronModel == Brain::Configuration::SPIKING
-		&& Brain::config.Spiking.enableGenes == true )
+	if( Brain::config().neuronModel == Brain::Configuration::SPIKING
+		&& Brain::config().Spiking.enableGenes == true )
 	{
 		GROUP_ATTR( SpikingParameterA,
 					NONINPUT,
-					Brain::config.Spiking.aMinVal,
-					Brain::config.Spiking.aMaxVal );
+					Brain::config().Spiking.aMinVal,
+					Brain::config().Spiking.aMaxVal );
 
 		GROUP_ATTR( SpikingParameterB,
 					NONINPUT,
-					Brain::config.Spiking.bMinVal,
-					Brain::config.Spiking.bMaxVal );
+					Brain::config().Spiking.bMinVal,
+					Brain::config().Spiking.bMaxVal );
 
 		GROUP_ATTR( SpikingParameterC,
 					NONINPUT,
-					Brain::config.Spiking.cMinVal,
-					Brain::config.Spiking.cMaxVal );
+					Brain::config().Spiking.cMinVal,
+					Brain::config().Spiking.cMaxVal );
 
 		GROUP_ATTR( SpikingParameterD,
 					NONINPUT,
-					Brain::config.Spiking.dMinVal,
-					Brain::config.Spiking.dMaxVal );
+					Brain::config().Spiking.dMinVal,
+					Brain::config().Spiking.dMaxVal );
 	}
 
-	if( Brain::config.gaussianInitWeight )
+	if( Brain::config().gaussianInitWeight )
 	{
 		SYNAPSE_ATTR( WeightStdev,
 					  false,
@@ -197,47 +197,47 @@ void GroupsGenomeSchema::define()
 	SYNAPSE_ATTR( ConnectionDensity,
 				  false,
 				  false,
-				  GroupsBrain::config.minconnectiondensity,
-				  GroupsBrain::config.maxconnectiondensity );
+				  GroupsBrain::config().minconnectiondensity,
+				  GroupsBrain::config().maxconnectiondensity );
 
-	if( Brain::config.enableLearning )
+	if( Brain::config().enableLearning )
 	{
-		if( Brain::config.minlrate == Brain::config.maxlrate )
+		if( Brain::config().minlrate == Brain::config().maxlrate )
 		{
-			add( new ImmutableScalarGene("LearningRate", Brain::config.minlrate) );
+			add( new ImmutableScalarGene("LearningRate", Brain::config().minlrate) );
 		}
 		else
 		{
 			SYNAPSE_ATTR( LearningRate,
 						  true,
 						  true,
-						  Brain::config.minlrate,
-						  Brain::config.maxlrate );
+						  Brain::config().minlrate,
+						  Brain::config().maxlrate );
 		}
 	}
 
 	SYNAPSE_ATTR( TopologicalDistortion,
 				  false,
 				  false,
-				  GroupsBrain::config.mintopologicaldistortion,
-				  GroupsBrain::config.maxtopologicaldistortion );
+				  GroupsBrain::config().mintopologicaldistortion,
+				  GroupsBrain::config().maxtopologicaldistortion );
 
-	if( GroupsBrain::config.enableTopologicalDistortionRngSeed )
+	if( GroupsBrain::config().enableTopologicalDistortionRngSeed )
 	{
 		SYNAPSE_ATTR( TopologicalDistortionRngSeed,
 					  false,
 					  false,
-					  GroupsBrain::config.minTopologicalDistortionRngSeed,
-					  GroupsBrain::config.maxTopologicalDistortionRngSeed );
+					  GroupsBrain::config().minTopologicalDistortionRngSeed,
+					  GroupsBrain::config().maxTopologicalDistortionRngSeed );
 
 	}
-	if( GroupsBrain::config.enableInitWeightRngSeed )
+	if( GroupsBrain::config().enableInitWeightRngSeed )
 	{
 		SYNAPSE_ATTR( InitWeightRngSeed,
 					  false,
 					  false,
-					  GroupsBrain::config.minInitWeightRngSeed,
-					  GroupsBrain::config.maxInitWeightRngSeed );
+					  GroupsBrain::config().minInitWeightRngSeed,
+					  GroupsBrain::config().maxInitWeightRngSeed );
 	}
 
 #undef INPUT1
@@ -253,12 +253,12 @@ void GroupsGenomeSchema::define()
 //-------------------------------------------------------------------------------------------
 void GroupsGenomeSchema::seed( Genome *g_ )
 {
-	if( GenomeSchema::config.seedType == GenomeSchema::SEED_RANDOM )
+	if( GenomeSchema::config().seedType == GenomeSchema::SEED_RANDOM )
 	{
 		g_->randomize();
 		return;
 	}
-	else if( GenomeSchema::config.seedType == GenomeSchema::SEED_SIMPLE )
+	else if( GenomeSchema::config().seedType == GenomeSchema::SEED_SIMPLE )
 	{
 		g_->seedAll( 0 );
 	}
@@ -288,29 +288,29 @@ void GroupsGenomeSchema::seed( Genome *g_ )
 			 TO,								\
 			 VAL )
 
-	if( Brain::config.neuronModel == Brain::Configuration::TAU_GAIN )
+	if( Brain::config().neuronModel == Brain::Configuration::TAU_GAIN )
 	{
-		SEED( Tau, Brain::config.Tau.seedVal );
-		SEED( Gain, Brain::config.Gain.seedVal );
+		SEED( Tau, Brain::config().Tau.seedVal );
+		SEED( Gain, Brain::config().Gain.seedVal );
 	}
 
-	if( GroupsBrain::config.minvisneurpergroup != GroupsBrain::config.maxvisneurpergroup )
+	if( GroupsBrain::config().minvisneurpergroup != GroupsBrain::config().maxvisneurpergroup )
 	{
-		SEED( Red, GroupsBrain::config.seedvisneur );
-		SEED( Green, GroupsBrain::config.seedvisneur );
-		SEED( Blue, GroupsBrain::config.seedvisneur );
+		SEED( Red, GroupsBrain::config().seedvisneur );
+		SEED( Green, GroupsBrain::config().seedvisneur );
+		SEED( Blue, GroupsBrain::config().seedvisneur );
 	}
 
-	if( GroupsBrain::config.orderedinternalneurgroups )
+	if( GroupsBrain::config().orderedinternalneurgroups )
 	{
 		SEED( Order, 0.5 );
 	}
 
-	if( GenomeSchema::config.seedType == GenomeSchema::SEED_SIMPLE )
+	if( GenomeSchema::config().seedType == GenomeSchema::SEED_SIMPLE )
 	{
 		SEED( Bias, 0.5 );
-		SEED_GROUP( Bias, Yaw, 0.5 + GenomeSchema::config.simpleSeedYawBiasDelta * (randpw() < 0.5 ? -1 : 1) );
-		SEED( ConnectionDensity, GroupsBrain::config.simpleseedconnectiondensity );
+		SEED_GROUP( Bias, Yaw, 0.5 + GenomeSchema::config().simpleSeedYawBiasDelta * (randpw() < 0.5 ? -1 : 1) );
+		SEED( ConnectionDensity, GroupsBrain::config().simpleseedconnectiondensity );
 		itfor( GeneVector, neurgroups, itIn )
 		{
 			NeurGroupGene *geneIn = GroupsGeneType::to_NeurGroup(*itIn);
@@ -325,11 +325,11 @@ void GroupsGenomeSchema::seed( Genome *g_ )
 				{
 					continue;
 				}
-				SEED_IO_SYNAPSE( ConnectionDensity, EE, geneIn, geneOut, GroupsBrain::config.simpleseedioconnectiondensity );
-				SEED_IO_SYNAPSE( ConnectionDensity, IE, geneIn, geneOut, GroupsBrain::config.simpleseedioconnectiondensity );
+				SEED_IO_SYNAPSE( ConnectionDensity, EE, geneIn, geneOut, GroupsBrain::config().simpleseedioconnectiondensity );
+				SEED_IO_SYNAPSE( ConnectionDensity, IE, geneIn, geneOut, GroupsBrain::config().simpleseedioconnectiondensity );
 			}
 		}
-		if( GroupsBrain::config.mirroredtopologicaldistortion )
+		if( GroupsBrain::config().mirroredtopologicaldistortion )
 		{
 			SEED( TopologicalDistortion, 0.5 );
 		}
@@ -348,33 +348,33 @@ void GroupsGenomeSchema::seed( Genome *g_ )
 	SEED( Bias, 0.5 );
 
 	SEED_GROUP( Bias, Mate, 1.0 );
-	SEED_GROUP( Bias, Fight, GenomeSchema::config.seedFightBias );
-	if( agent::config.enableGive )
+	SEED_GROUP( Bias, Fight, GenomeSchema::config().seedFightBias );
+	if( agent::config().enableGive )
 	{
-		SEED_GROUP( Bias, Give, GenomeSchema::config.seedGiveBias );
+		SEED_GROUP( Bias, Give, GenomeSchema::config().seedGiveBias );
 	}
-	if( agent::config.enableCarry )
+	if( agent::config().enableCarry )
 	{
-		SEED_GROUP( Bias, Pickup, GenomeSchema::config.seedPickupBias );
-		SEED_GROUP( Bias, Drop, GenomeSchema::config.seedDropBias );
+		SEED_GROUP( Bias, Pickup, GenomeSchema::config().seedPickupBias );
+		SEED_GROUP( Bias, Drop, GenomeSchema::config().seedDropBias );
 	}
 
 	SEED( ConnectionDensity, 0 );
-	if( Brain::config.enableLearning && Brain::config.minlrate != Brain::config.maxlrate )
+	if( Brain::config().enableLearning && Brain::config().minlrate != Brain::config().maxlrate )
 	{
 		SEED( LearningRate, 0 );
 	}
 	SEED( TopologicalDistortion, 0 );
-	if( GroupsBrain::config.enableTopologicalDistortionRngSeed )
+	if( GroupsBrain::config().enableTopologicalDistortionRngSeed )
 	{
 		SEED( TopologicalDistortionRngSeed, 0 );
 	}
-	if( GroupsBrain::config.enableInitWeightRngSeed )
+	if( GroupsBrain::config().enableInitWeightRngSeed )
 	{
 		SEED( InitWeightRngSeed, 0 );
 	}
 
-	SEED_SYNAPSE( ConnectionDensity,	 EE, Red,   Fight,	GenomeSchema::config.seedFightExcitation );
+	SEED_SYNAPSE( ConnectionDensity,	 EE, Red,   Fight,	GenomeSchema::config().seedFightExcitation );
 	SEED_SYNAPSE( ConnectionDensity,	 EE, Green, Eat,	1.0 );
 	SEED_SYNAPSE( ConnectionDensity,	 EE, Blue,  Mate,	1.0 );
 	SEED_SYNAPSE( ConnectionDensity,	 IE, Red,   Speed,	0.5 );
@@ -392,17 +392,17 @@ void GroupsGenomeSchema::seed( Genome *g_ )
 	SEED_SYNAPSE( ConnectionDensity,	 EE, Blue,  Yaw,	0.5 );
 	SEED_SYNAPSE( ConnectionDensity,	 IE, Blue,  Yaw,	0.5 );
 	SEED_SYNAPSE( TopologicalDistortion, IE, Blue,  Yaw,	1.0 );
-	SEED_SYNAPSE( ConnectionDensity,	 IE, Eat,   Fight,	GenomeSchema::config.seedFightExcitation );
-	SEED_SYNAPSE( ConnectionDensity,	 IE, Mate,	Fight,	GenomeSchema::config.seedFightExcitation );
-	if( agent::config.enableCarry )
-	{
-		SEED_SYNAPSE( ConnectionDensity,	 EE, Red,	Pickup,	GenomeSchema::config.seedPickupExcitation );
-		SEED_SYNAPSE( ConnectionDensity,	 EE, Green,	Pickup,	GenomeSchema::config.seedPickupExcitation );
-		SEED_SYNAPSE( ConnectionDensity,	 EE, Blue,	Pickup,	GenomeSchema::config.seedPickupExcitation );
-		SEED_SYNAPSE( ConnectionDensity,	 EE, Red,	Drop,	GenomeSchema::config.seedDropExcitation );
-		SEED_SYNAPSE( ConnectionDensity,	 EE, Green,	Drop,	GenomeSchema::config.seedDropExcitation );
-		SEED_SYNAPSE( ConnectionDensity,	 EE, Blue,	Drop,	GenomeSchema::config.seedDropExcitation );
-		SEED_SYNAPSE( ConnectionDensity,	 IE, Pickup,Drop,	GenomeSchema::config.seedPickupExcitation ); // if wiring in pickup, have it suppress drop
+	SEED_SYNAPSE( ConnectionDensity,	 IE, Eat,   Fight,	GenomeSchema::config().seedFightExcitation );
+	SEED_SYNAPSE( ConnectionDensity,	 IE, Mate,	Fight,	GenomeSchema::config().seedFightExcitation );
+	if( agent::config().enableCarry )
+	{
+		SEED_SYNAPSE( ConnectionDensity,	 EE, Red,	Pickup,	GenomeSchema::config().seedPickupExcitation );
+		SEED_SYNAPSE( ConnectionDensity,	 EE, Green,	Pickup,	GenomeSchema::config().seedPickupExcitation );
+		SEED_SYNAPSE( ConnectionDensity,	 EE, Blue,	Pickup,	GenomeSchema::config().seedPickupExcitation );
+		SEED_SYNAPSE( ConnectionDensity,	 EE, Red,	Drop,	GenomeSchema::config().seedDropExcitation );
+		SEED_SYNAPSE( ConnectionDensity,	 EE, Green,	Drop,	GenomeSchema::config().seedDropExcitation );
+		SEED_SYNAPSE( ConnectionDensity,	 EE, Blue,	Drop,	GenomeSchema::config().seedDropExcitation );
+		SEED_SYNAPSE( ConnectionDensity,	 IE, Pickup,Drop,	GenomeSchema::config().seedPickupExcitation ); // if wiring in pickup, have it suppress drop
 	}
 
 #undef SEED
@@ -31,6 +31,8 @@ void SheetsGenome::crossover( Genome *g1,
 								dynamic_cast<SheetsGenome *>(g2) };
 	int genomeIndex = 0;
 
+	decoded = false;
+
 	SheetsCrossover *crossover = _schema->getCrossover();
 	SheetsCrossover::Segment segment;
 
@@ -8,6 +8,7 @@
 #include "SheetsGenome.h"
 #include "agent/agent.h"
 #include "brain/sheets/SheetsBrain.h"
+#include "sim/SimulationContext.h"
 
 using namespace genome;
 using namespace sheets;
@@ -15,7 +16,10 @@ using namespace sheets;
 static const float InputOutputSheetHeight = 0.1;
 static const float InputOutputSheetDefaultWidth = 0.1;
 
-SheetsGenomeSchema::Configuration SheetsGenomeSchema::config;
+SheetsGenomeSchema::Configuration &SheetsGenomeSchema::config()
+{
+	return SimulationContext::current()->get<Configuration>();
+}
 
 void SheetsGenomeSchema::processWorldfile( proplib::Document &doc )
 {
@@ -24,18 +28,18 @@ void SheetsGenomeSchema::processWorldfile( proplib::Document &doc )
 	{
 		proplib::Property &cross = sheets.get( "CrossoverProbability" );
 
-		SheetsGenomeSchema::config.crossoverProbability.sheet = cross.get( "Sheet" );
-		SheetsGenomeSchema::config.crossoverProbability.receptiveField = cross.get( "ReceptiveField" );
-		SheetsGenomeSchema::config.crossoverProbability.neuronAttr = cross.get( "NeuronAttr" );
-		SheetsGenomeSchema::config.crossoverProbability.gene = cross.get( "Gene" );
+		SheetsGenomeSchema::config().crossoverProbability.sheet = cross.get( "Sheet" );
+		SheetsGenomeSchema::config().crossoverProbability.receptiveField = cross.get( "ReceptiveField" );
+		SheetsGenomeSchema::config().crossoverProbability.neuronAttr = cross.get( "NeuronAttr" );
+		SheetsGenomeSchema::config().crossoverProbability.gene = cross.get( "Gene" );
 	}
 
 	{
         std::string val = sheets.get( "NeuronAttrEncoding" );
 		if( val == "Sheet" )
-			SheetsGenomeSchema::config.neuronAttrEncoding = SheetsGenomeSchema::Configuration::SheetNeuronAttr;
+			SheetsGenomeSchema::config().neuronAttrEncoding = SheetsGenomeSchema::Configuration::SheetNeuronAttr;
 		else if( val == "Neuron" )
-			SheetsGenomeSchema::config.neuronAttrEncoding = SheetsGenomeSchema::Configuration::PerNeuronAttr;
+			SheetsGenomeSchema::config().neuronAttrEncoding = SheetsGenomeSchema::Configuration::PerNeuronAttr;
 		else
 			assert( false );
 	}
@@ -43,7 +47,7 @@ void SheetsGenomeSchema::processWorldfile( proplib::Document &doc )
 	{
         std::string val = sheets.get( "SynapseAttrEncoding" );
 		if( val == "Field" )
-			SheetsGenomeSchema::config.synapseAttrEncoding = SheetsGenomeSchema::Configuration::FieldSynapseAttr;
+			SheetsGenomeSchema::config().synapseAttrEncoding = SheetsGenomeSchema::Configuration::FieldSynapseAttr;
 		else
 			assert( false );
 	}
@@ -51,19 +55,19 @@ void SheetsGenomeSchema::processWorldfile( proplib::Document &doc )
 	{
         std::string val = sheets.get( "ReceptiveFieldEncoding" );
 		if( val == "Permutations" )
-			SheetsGenomeSchema::config.receptiveFieldEncoding = SheetsGenomeSchema::Configuration::Permutations;
+			SheetsGenomeSchema::config().receptiveFieldEncoding = SheetsGenomeSchema::Configuration::Permutations;
 		else if( val == "ExplicitVector" )
 		{
-			SheetsGenomeSchema::config.receptiveFieldEncoding = SheetsGenomeSchema::Configuration::ExplicitVector;
-			SheetsGenomeSchema::config.minExplicitVectorSize = sheets.get( "MinExplicitVectorSize" );
-			SheetsGenomeSchema::config.maxExplicitVectorSize = sheets.get( "MaxExplicitVectorSize" );
+			SheetsGenomeSchema::config().receptiveFieldEncoding = SheetsGenomeSchema::Configuration::ExplicitVector;
+			SheetsGenomeSchema::config().minExplicitVectorSize = sheets.get( "MinExplicitVectorSize" );
+			SheetsGenomeSchema::config().maxExplicitVectorSize = sheets.get( "MaxExplicitVectorSize" );
 		}
 		else
 			assert( false );
 	}
 
-	SheetsGenomeSchema::config.enableReceptiveFieldCurrentRegion = sheets.get( "EnableReceptiveFieldCurrentRegion" );
-	SheetsGenomeSchema::config.enableReceptiveFieldOtherRegion = sheets.get( "EnableReceptiveFieldOtherRegion" );
+	SheetsGenomeSchema::config().enableReceptiveFieldCurrentRegion = sheets.get( "EnableReceptiveFieldCurrentRegion" );
+	SheetsGenomeSchema::config().enableReceptiveFieldOtherRegion = sheets.get( "EnableReceptiveFieldOtherRegion" );
 }
 
 
@@ -174,15 +178,15 @@ void SheetsGenomeSchema::define()
 	// ---
 	// --- Model Properties
 	// ---
-	SCALAR( this, "SizeX", SheetsBrain::config.minBrainSize.x, SheetsBrain::config.maxBrainSize.x );
-	SCALAR( this, "SizeY", SheetsBrain::config.minBrainSize.y, SheetsBrain::config.maxBrainSize.y );
-	SCALAR( this, "SizeZ", SheetsBrain::config.minBrainSize.z, SheetsBrain::config.maxBrainSize.z );
+	SCALAR( this, "SizeX", SheetsBrain::config().minBrainSize.x, SheetsBrain::config().maxBrainSize.x );
+	SCALAR( this, "SizeY", SheetsBrain::config().minBrainSize.y, SheetsBrain::config().maxBrainSize.y );
+	SCALAR( this, "SizeZ", SheetsBrain::config().minBrainSize.z, SheetsBrain::config().maxBrainSize.z );
 
-	SCALAR( this, "InternalSheetsCount", SheetsBrain::config.minInternalSheetsCount, SheetsBrain::config.maxInternalSheetsCount );
+	SCALAR( this, "InternalSheetsCount", SheetsBrain::config().minInternalSheetsCount, SheetsBrain::config().maxInternalSheetsCount );
 
-	SCALAR( this, "SynapseProbabilityX", SheetsBrain::config.minSynapseProbabilityX, SheetsBrain::config.maxSynapseProbabilityX );
+	SCALAR( this, "SynapseProbabilityX", SheetsBrain::config().minSynapseProbabilityX, SheetsBrain::config().maxSynapseProbabilityX );
 
-	SCALAR( this, "LearningRate", SheetsBrain::config.minLearningRate, SheetsBrain::config.maxLearningRate );
+	SCALAR( this, "LearningRate", SheetsBrain::config().minLearningRate, SheetsBrain::config().maxLearningRate );
 
 
 	// ---
@@ -199,8 +203,8 @@ void SheetsGenomeSchema::define()
 
 			Vector2f center;
 		};
-		const IntMinMax VisionNeuronCount( SheetsBrain::config.minVisionNeuronsPerSheet,
-										   SheetsBrain::config.maxVisionNeuronsPerSheet );
+		const IntMinMax VisionNeuronCount( SheetsBrain::config().minVisionNeuronsPerSheet,
+										   SheetsBrain::config().maxVisionNeuronsPerSheet );
 
 		// If you are adding a new input, please append to this list in order to maintain stable layout.
         std::vector<InputSheetDef> defs =
@@ -211,10 +215,10 @@ void SheetsGenomeSchema::define()
 				{ "Blue",				1.0,							VisionNeuronCount, true },
 				{ "Random",				InputOutputSheetDefaultWidth,	1,			       true },
 				{ "Energy",				InputOutputSheetDefaultWidth,	1,			       true },
-				{ "MateWaitFeedback",	InputOutputSheetDefaultWidth,	1,			       agent::config.enableMateWaitFeedback },
-				{ "SpeedFeedback",		InputOutputSheetDefaultWidth,	1,			       agent::config.enableSpeedFeedback },
-				{ "Carrying",			InputOutputSheetDefaultWidth,	1,			       agent::config.enableCarry },
-				{ "BeingCarried",		InputOutputSheetDefaultWidth,	1,			       agent::config.enableCarry }
+				{ "MateWaitFeedback",	InputOutputSheetDefaultWidth,	1,			       agent::config().enableMateWaitFeedback },
+				{ "SpeedFeedback",		InputOutputSheetDefaultWidth,	1,			       agent::config().enableSpeedFeedback },
+				{ "Carrying",			InputOutputSheetDefaultWidth,	1,			       agent::config().enableCarry },
+				{ "BeingCarried",		InputOutputSheetDefaultWidth,	1,			       agent::config().enableCarry }
 			};
 
 		layoutInputOutputSheets( defs );
@@ -264,14 +268,14 @@ void SheetsGenomeSchema::define()
 				{ "Fight",			true },
 				{ "Speed",			true },
 				{ "Yaw",			true },
-				{ "YawOppose",		agent::config.yawEncoding == agent::YE_OPPOSE },
+				{ "YawOppose",		agent::config().yawEncoding == agent::YE_OPPOSE },
 				{ "Light",			true },
 				{ "Focus",			true },
-				{ "VisionPitch",	agent::config.enableVisionPitch },
-				{ "VisionYaw",		agent::config.enableVisionYaw },
-				{ "Give",			agent::config.enableGive },
-				{ "Pickup",			agent::config.enableCarry },
-				{ "Drop",			agent::config.enableCarry }
+				{ "VisionPitch",	agent::config().enableVisionPitch },
+				{ "VisionYaw",		agent::config().enableVisionYaw },
+				{ "Give",			agent::config().enableGive },
+				{ "Pickup",			agent::config().enableCarry },
+				{ "Drop",			agent::config().enableCarry }
 			};
 
 		for( OutputSheetDef &def : defs )
@@ -306,7 +310,7 @@ void SheetsGenomeSchema::define()
 	// ---
 	ContainerGene *internalSheets = new ContainerGene( "InternalSheets" );
 	{
-		for( int i = 0; i < SheetsBrain::config.maxInternalSheetsCount; i++ )
+		for( int i = 0; i < SheetsBrain::config().maxInternalSheetsCount; i++ )
 		{
 			ContainerGene *sheet =
 				defineSheet( /* name */ itoa(i),
@@ -316,14 +320,14 @@ void SheetsGenomeSchema::define()
 							 /* slot */ FloatMinMax( 0.0f, 1.0f ),
 							 /* centerA */ FloatMinMax( 0.0, 1.0 ),
 							 /* centerB */ FloatMinMax( 0.0, 1.0 ),
-							 /* sizeA */ FloatMinMax( SheetsBrain::config.minInternalSheetSize,
-													  SheetsBrain::config.maxInternalSheetSize ),
-							 /* sizeB */ FloatMinMax( SheetsBrain::config.minInternalSheetSize,
-													  SheetsBrain::config.maxInternalSheetSize ),
-							 /* neuronCountA */ IntMinMax( SheetsBrain::config.minInternalSheetNeuronCount,
-														   SheetsBrain::config.maxInternalSheetNeuronCount ),
-							 /* neuronCountB */ IntMinMax( SheetsBrain::config.minInternalSheetNeuronCount,
-														   SheetsBrain::config.maxInternalSheetNeuronCount ) );
+							 /* sizeA */ FloatMinMax( SheetsBrain::config().minInternalSheetSize,
+													  SheetsBrain::config().maxInternalSheetSize ),
+							 /* sizeB */ FloatMinMax( SheetsBrain::config().minInternalSheetSize,
+													  SheetsBrain::config().maxInternalSheetSize ),
+							 /* neuronCountA */ IntMinMax( SheetsBrain::config().minInternalSheetNeuronCount,
+														   SheetsBrain::config().maxInternalSheetNeuronCount ),
+							 /* neuronCountB */ IntMinMax( SheetsBrain::config().minInternalSheetNeuronCount,
+														   SheetsBrain::config().maxInternalSheetNeuronCount ) );
 
 			internalSheets->add( sheet );
 		}
@@ -334,7 +338,7 @@ void SheetsGenomeSchema::define()
 	// ---
 	// --- Receptive Fields
 	// ---
-	switch( SheetsGenomeSchema::config.receptiveFieldEncoding )
+	switch( SheetsGenomeSchema::config().receptiveFieldEncoding )
 	{
 	case SheetsGenomeSchema::Configuration::Permutations:
 		{
@@ -373,10 +377,10 @@ void SheetsGenomeSchema::complete( int offset )
 
 	_crossover.GeneLevel.defineRange( NULL, NULL );
 
-	_crossover.SheetLevel.probability = SheetsGenomeSchema::config.crossoverProbability.sheet;
-	_crossover.ReceptiveFieldLevel.probability = SheetsGenomeSchema::config.crossoverProbability.receptiveField;
-	_crossover.NeuronAttrLevel.probability = SheetsGenomeSchema::config.crossoverProbability.neuronAttr;
-	_crossover.GeneLevel.probability = SheetsGenomeSchema::config.crossoverProbability.gene;
+	_crossover.SheetLevel.probability = SheetsGenomeSchema::config().crossoverProbability.sheet;
+	_crossover.ReceptiveFieldLevel.probability = SheetsGenomeSchema::config().crossoverProbability.receptiveField;
+	_crossover.NeuronAttrLevel.probability = SheetsGenomeSchema::config().crossoverProbability.neuronAttr;
+	_crossover.GeneLevel.probability = SheetsGenomeSchema::config().crossoverProbability.gene;
 
 	_crossover.complete( this );
 
@@ -465,11 +469,11 @@ ContainerGene *SheetsGenomeSchema::defineSheet( const char *name,
 	{
 		ContainerGene *attrs = new ContainerGene( "NeuronAttrs" );
 
-		if( SheetsGenomeSchema::config.neuronAttrEncoding == Configuration::SheetNeuronAttr )
+		if( SheetsGenomeSchema::config().neuronAttrEncoding == Configuration::SheetNeuronAttr )
 		{
 			defineNeuronAttrs( attrs );
 		}
-		else if( SheetsGenomeSchema::config.neuronAttrEncoding == Configuration::PerNeuronAttr )
+		else if( SheetsGenomeSchema::config().neuronAttrEncoding == Configuration::PerNeuronAttr )
 		{
 			for( int a = 0; a < neuronCountA.b; a++ )
 			{
@@ -504,23 +508,23 @@ ContainerGene *SheetsGenomeSchema::defineSheet( const char *name,
 
 void SheetsGenomeSchema::defineNeuronAttrs( ContainerGene *attrs )
 {
-	SCALAR( attrs, "Bias", -Brain::config.maxbias, Brain::config.maxbias );
+	SCALAR( attrs, "Bias", -Brain::config().maxbias, Brain::config().maxbias );
 
-	switch( Brain::config.neuronModel )
+	switch( Brain::config().neuronModel )
 	{
 	case Brain::Configuration::FIRING_RATE:
 		// no-op
 		break;
 	case Brain::Configuration::TAU_GAIN:
-		SCALAR( attrs, "Tau", Brain::config.Tau.minVal, Brain::config.Tau.maxVal );
+		SCALAR( attrs, "Tau", Brain::config().Tau.minVal, Brain::config().Tau.maxVal );
 		break;
 	case Brain::Configuration::SPIKING:
-		if( Brain::config.Spiking.enableGenes )
+		if( Brain::config().Spiking.enableGenes )
 		{
-			SCALAR( attrs, "SpikingParameterA", Brain::config.Spiking.aMinVal, Brain::config.Spiking.aMaxVal );
-			SCALAR( attrs, "SpikingParameterB", Brain::config.Spiking.bMinVal, Brain::config.Spiking.bMaxVal );
-			SCALAR( attrs, "SpikingParameterC", Brain::config.Spiking.cMinVal, Brain::config.Spiking.cMaxVal );
-			SCALAR( attrs, "SpikingParameterD", Brain::config.Spiking.dMinVal, Brain::config.Spiking.dMaxVal );
+			SCALAR( attrs, "SpikingParameterA", Brain::config().Spiking.aMinVal, Brain::config().Spiking.aMaxVal );
+			SCALAR( attrs, "SpikingParameterB", Brain::config().Spiking.bMinVal, Brain::config().Spiking.bMaxVal );
+			SCALAR( attrs, "SpikingParameterC", Brain::config().Spiking.cMinVal, Brain::config().Spiking.cMaxVal );
+			SCALAR( attrs, "SpikingParameterD", Brain::config().Spiking.dMinVal, Brain::config().Spiking.dMaxVal );
 		}
 		break;
 	default:
@@ -585,10 +589,10 @@ void SheetsGenomeSchema::defineReceptiveFieldVector( ContainerGene *sheets,
 		ContainerGene *sheetGene = GeneType::to_Container( sheetGene_ );
 		SCALAR( sheetGene,
 				vectorSizeName,
-				SheetsGenomeSchema::config.minExplicitVectorSize,
-				SheetsGenomeSchema::config.maxExplicitVectorSize );
+				SheetsGenomeSchema::config().minExplicitVectorSize,
+				SheetsGenomeSchema::config().maxExplicitVectorSize );
 
-		for( int i = 0; i < SheetsGenomeSchema::config.maxExplicitVectorSize; i++ )
+		for( int i = 0; i < SheetsGenomeSchema::config().maxExplicitVectorSize; i++ )
 		{
 			defineReceptiveField( sheetGene,
 								  otherSheetId,
@@ -626,7 +630,7 @@ void SheetsGenomeSchema::defineReceptiveField( ContainerGene *currentSheet,
 	SCALARV( field, "OtherSheetId", otherSheetId );
 	PWCONST( field, "Role", (int)role );
 	SCALARV( field, "SynapseType", synapseType );
-	if( SheetsGenomeSchema::config.enableReceptiveFieldCurrentRegion )
+	if( SheetsGenomeSchema::config().enableReceptiveFieldCurrentRegion )
 	{
 		SCALAR( field, "CurrentCenterA", 0.0, 1.0 );
 		SCALAR( field, "CurrentCenterB", 0.0, 1.0 );
@@ -640,7 +644,7 @@ void SheetsGenomeSchema::defineReceptiveField( ContainerGene *currentSheet,
 		SCALAR( field, "CurrentSizeA", 1.0, 1.0 );
 		SCALAR( field, "CurrentSizeB", 1.0, 1.0 );
 	}
-	if( SheetsGenomeSchema::config.enableReceptiveFieldOtherRegion )
+	if( SheetsGenomeSchema::config().enableReceptiveFieldOtherRegion )
 	{
 		SCALAR( field, "OtherCenterA", 0.0, 1.0 );
 		SCALAR( field, "OtherCenterB", 0.0, 1.0 );
@@ -659,7 +663,7 @@ void SheetsGenomeSchema::defineReceptiveField( ContainerGene *currentSheet,
 	SCALAR( field, "SizeA", 0.0f, 1.0f );
 	SCALAR( field, "SizeB", 0.0f, 1.0f );
 
-	if( SheetsGenomeSchema::config.synapseAttrEncoding == SheetsGenomeSchema::Configuration::FieldSynapseAttr )
+	if( SheetsGenomeSchema::config().synapseAttrEncoding == SheetsGenomeSchema::Configuration::FieldSynapseAttr )
 		defineSynapseAttrs( field );
 
 	fieldArray->add( field );
@@ -669,7 +673,7 @@ void SheetsGenomeSchema::defineReceptiveField( ContainerGene *currentSheet,
 
 void SheetsGenomeSchema::defineSynapseAttrs( ContainerGene *container )
 {
-	SCALAR( container, "Weight", 0.0f, Brain::config.initMaxWeight );
+	SCALAR( container, "Weight", 0.0f, Brain::config().initMaxWeight );
 	SCALAR( container, "LearningRate", 0.0f, 1.0f );
 }
 
@@ -767,7 +771,7 @@ void SheetsGenomeSchema::createSheet( SheetsModel *model, SheetsGenome *g, Conta
 				setIE( neuron );
 			};
 	}
-	else if( SheetsGenomeSchema::config.neuronAttrEncoding == Configuration::SheetNeuronAttr )
+	else if( SheetsGenomeSchema::config().neuronAttrEncoding == Configuration::SheetNeuronAttr )
 	{
 		ContainerGene *attrsGene = GeneType::to_Container( sheetGene->gene( "NeuronAttrs" ) );
 		Neuron::Attributes attrs = decodeNeuronAttrs( g, attrsGene );
@@ -778,7 +782,7 @@ void SheetsGenomeSchema::createSheet( SheetsModel *model, SheetsGenome *g, Conta
 			setIE( neuron );
 		};
 	}
-	else if( SheetsGenomeSchema::config.neuronAttrEncoding == Configuration::PerNeuronAttr )
+	else if( SheetsGenomeSchema::config().neuronAttrEncoding == Configuration::PerNeuronAttr )
 	{
 		ContainerGene *attrsGene = GeneType::to_Container( sheetGene->gene( "NeuronAttrs" ) );
 
@@ -815,7 +819,7 @@ Neuron::Attributes SheetsGenomeSchema::decodeNeuronAttrs( SheetsGenome *g,
 {
 	Neuron::Attributes attrs;
 
-	switch( Brain::config.neuronModel )
+	switch( Brain::config().neuronModel )
 	{
 	case Brain::Configuration::FIRING_RATE:
 		attrs.neuronModel.firingRate.bias = g->get( attrsGene->gene("Bias") );
@@ -825,7 +829,7 @@ Neuron::Attributes SheetsGenomeSchema::decodeNeuronAttrs( SheetsGenome *g,
 		attrs.neuronModel.tau.tau = g->get( attrsGene->gene("Tau") );
 		break;
 	case Brain::Configuration::SPIKING:
-		if( Brain::config.Spiking.enableGenes )
+		if( Brain::config().Spiking.enableGenes )
 		{
 			attrs.neuronModel.spiking.bias = g->get( attrsGene->gene("Bias") );
 			attrs.neuronModel.spiking.SpikingParameter_a = g->get( attrsGene->gene("SpikingParameterA") );
@@ -862,7 +866,7 @@ void SheetsGenomeSchema::createReceptiveFields( SheetsModel *model, SheetsGenome
 			if( fieldsGene )
 			{
 				int nfields;
-				switch( SheetsGenomeSchema::config.receptiveFieldEncoding )
+				switch( SheetsGenomeSchema::config().receptiveFieldEncoding )
 				{
 				case SheetsGenomeSchema::Configuration::Permutations:
 					nfields = fieldsGene->getAll().size();
@@ -930,7 +934,7 @@ void SheetsGenomeSchema::createReceptiveField( SheetsModel *model,
 	// ---
     std::function<void (Synapse *)> synapseCreated;
 	Synapse::Attributes attrs;
-	if( SheetsGenomeSchema::config.synapseAttrEncoding == SheetsGenomeSchema::Configuration::FieldSynapseAttr )
+	if( SheetsGenomeSchema::config().synapseAttrEncoding == SheetsGenomeSchema::Configuration::FieldSynapseAttr )
 	{
 		WARN_ONCE( "IMPLEMENT INDEX-BASED WEIGHT" );
 		attrs = decodeSynapseAttrs( g, fieldGene );
@@ -10,7 +10,7 @@ namespace genome
 	class SheetsGenomeSchema : public GenomeSchema
 	{
 	public:
-		static struct Configuration
+		struct Configuration
 		{
 			struct CrossoverProbability
 			{
@@ -37,7 +37,8 @@ namespace genome
 			bool enableReceptiveFieldOtherRegion;
 			int minExplicitVectorSize;
 			int maxExplicitVectorSize;
-		} config;
+		};
+		static Configuration &config();
 
 		static void processWorldfile( proplib::Document &doc );
 
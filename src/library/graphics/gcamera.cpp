@@ -61,7 +61,10 @@ gcamera::gcamera()
 		fFollowObject(NULL),
 		fPerspectiveFixed(false),
 		fPerspectiveInUse(false),
-		glFogOn(false)				// this will be turned on for cameras attached to agents at the SetGraphics() function
+		glFogOn(false),				// this will be turned on for cameras attached to agents at the SetGraphics() function
+		sFogFunction('O'),
+		fExpFogDensity(0.0),
+		iLinearFogEnd(0)
 {
 	fPosition[0] = 0.0;
     fPosition[1] = 0.0;
@@ -117,10 +120,11 @@ void gcamera::SetPerspective(float fov, float a, float n, float f)
 //---------------------------------------------------------------------------
 void gcamera::UsePerspective()
 {
-
+#if !PW_HEADLESS
 	glMatrixMode(GL_PROJECTION);
 	glLoadIdentity();
 	gluPerspective(fFOV, fAspect, fNear, fFar);
+#endif
 
 // GL Fog Debugging Info.
 /*
@@ -235,6 +239,7 @@ void gcamera::SetFixationPoint(float x, float y, float z)
 //---------------------------------------------------------------------------      
 void gcamera::UseLookAt()
 {
+#if !PW_HEADLESS
 	glMatrixMode(GL_MODELVIEW);
 	glLoadIdentity();
 
@@ -247,6 +252,7 @@ void gcamera::UseLookAt()
 			  fAngle[0],
 			  fAngle[1],
 			  fAngle[2]);
+#endif
 }
 
 
@@ -276,6 +282,7 @@ void gcamera::Use()
     }
     else
     {
+#if !PW_HEADLESS
 		glMatrixMode(GL_MODELVIEW);
 		glLoadIdentity();
 
@@ -284,6 +291,7 @@ void gcamera::Use()
 		glRotatef(-fAngle[0], 0.0, 1.0, 0.0); // yaw   (y)
 				
 		glTranslatef(-fPosition[0], -fPosition[1], -fPosition[2]);
+#endif
         
         if (fFollowObject != NULL)
         	fFollowObject->inverseposition();		
@@ -327,6 +335,13 @@ void gcamera::print()
 //---------------------------------------------------------------------------    
 void gcamera::SetFog( bool fog, char function, float density, int end )
 {
+	// Kept for renderers that don't go through GL state (see GetFog).
+	glFogOn = fog && (function == 'L' || function == 'E');
+	sFogFunction = function;
+	fExpFogDensity = density;
+	iLinearFogEnd = end;
+
+#if !PW_HEADLESS
 	if( fog )			
 	{
 		glEnable(GL_FOG);				// turn on Fog to give the agents depth perception
@@ -357,4 +372,21 @@ void gcamera::SetFog( bool fog, char function, float density, int end )
 //		cout << "Disabling GL FOG." << endl;
 		glDisable(GL_FOG);		// Turn off the fog if for some reason we ever wanted agents to turn it off.	
 	}
+#endif
+}
+
+
+//---------------------------------------------------------------------------
+// gcamera::GetFog
+//
+// Returns whether fog was enabled by SetFog(), along with its settings.
+// Linear fog starts at the near plane.
+//---------------------------------------------------------------------------    
+bool gcamera::GetFog( char& function, float& density, int& end )
+{
+	function = sFogFunction;
+	density = fExpFogDensity;
+	end = iLinearFogEnd;
+
+	return glFogOn;
 }
@@ -28,6 +28,14 @@ public:
 	void SetAspect(float width, float height);
 	void SetAspect(float a);
 	void SetFog( bool fog, char function, float density, int end );
+	bool GetFog( char& function, float& density, int& end );
+	float GetAspect();
+	float GetNear();
+	float GetFar();
+	gobject* GetFollowObject();
+	bool UsingLookAt();
+	// Only meaningful if UsingLookAt().
+	const float* GetFixationPoint();
 
 	void Use();
     virtual void print();
@@ -77,5 +85,11 @@ inline void gcamera::SetFar(float f) { fFar = f; }
 inline void gcamera::SetAspect(float a) { fAspect = a; }
 //inline void gcamera::SetTwist(float t) { fAngle[2] = t; }
 inline bool gcamera::PerspectiveSet() { return fPerspectiveInUse; }
+inline float gcamera::GetAspect() { return fAspect; }
+inline float gcamera::GetNear() { return fNear; }
+inline float gcamera::GetFar() { return fFar; }
+inline gobject* gcamera::GetFollowObject() { return fFollowObject; }
+inline bool gcamera::UsingLookAt() { return fUsingLookAt; }
+inline const float* gcamera::GetFixationPoint() { return fFixationPoint; }
 
 #endif
@@ -119,23 +119,27 @@ void glight::bind(short lightnum)
 
 void glight::Draw()
 {
+#if !PW_HEADLESS
 //	c4f(col);
     glPushMatrix();
 //    loadmatrix(identmat);
       position();
 //      drawunitcube(); // make this a sphere some day
     glPopMatrix();
+#endif
 }
 
 
 void glight::Use(short lightnum)
 {
+#if !PW_HEADLESS
 ///    c4f(col);
 	glPushMatrix();
 //    loadmatrix(identmat);
       position();
       bind(lightnum);
     glPopMatrix();
+#endif
 }
 
 
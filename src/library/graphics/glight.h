@@ -56,7 +56,11 @@ inline void glight::settranslation(float x, float y, float z) { settranslation(x
 inline void glight::settranslation(float* pp) { settranslation(pp[0], pp[1], pp[2], pos[3]); }
 inline void glight::setcol(float* pcol) { setcol(pcol[0], pcol[1], pcol[2]); }
 inline void glight::setname(char* pc) { name = pc; }
+#if !PW_HEADLESS
 inline void glight::translate() { glTranslatef(pos[0], pos[1], pos[2]); }
+#else
+inline void glight::translate() {}
+#endif
 inline float* glight::getposptr() { return &pos[0]; }
 
 
@@ -78,12 +78,14 @@ void gline::setend(float e0, float e1, float e2)
 
 void gline::draw()
 {
+#if !PW_HEADLESS
 	glColor3fv(&fColor[0]);
 	
 	glBegin(GL_LINES);
 		glVertex3fv(fPosition);
 		glVertex3fv(fEnd);
 	glEnd();
+#endif
 }
 
 
@@ -218,6 +218,7 @@ void TLightList::Print()
 //-------------------------------------------------------------------------------------------
 void drawunitcube()
 {
+#if !PW_HEADLESS
     glPolygonMode(GL_FRONT, GL_FILL);
     
 	glBegin(GL_POLYGON);
@@ -261,6 +262,7 @@ void drawunitcube()
 		glVertex3fv(ucube[6]);
 		glVertex3fv(ucube[4]);
 	glEnd();
+#endif
 }
 
 
@@ -269,6 +271,7 @@ void drawunitcube()
 //-------------------------------------------------------------------------------------------
 void frameunitcube()
 {
+#if !PW_HEADLESS
 	glBegin(GL_LINES);
 		glVertex3fv(ucube[0]);
 		glVertex3fv(ucube[1]);
@@ -290,6 +293,7 @@ void frameunitcube()
 		glVertex3fv(ucube[5]);
 		glVertex3fv(ucube[7]);
 	glEnd();
+#endif
 }
 
 
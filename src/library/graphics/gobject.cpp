@@ -257,18 +257,22 @@ void gobject::GetPosition(float& px, float& py, float& pz)
 // (they are intended for use between glPushMatrix()/glPopMatrix() pairs)
 void gobject::translate()
 {
+#if !PW_HEADLESS
 	glTranslatef(fPosition[0], fPosition[1], fPosition[2]);
+#endif
 }
 
 
 void gobject::rotate()
 {
+#if !PW_HEADLESS
 	if (fRotated)
 	{
 		glRotatef(fAngle[0], 0.0, 1.0, 0.0);	// y
 		glRotatef(fAngle[1], 1.0, 0.0, 0.0); 	// x
 		glRotatef(fAngle[2], 0.0, 0.0, 1.0);	// z
 	}
+#endif
 }
 
 
@@ -281,18 +285,22 @@ void gobject::position()
 
 void gobject::inversetranslate()
 {
+#if !PW_HEADLESS
 	glTranslatef(-fPosition[0], -fPosition[1], -fPosition[2]);
+#endif
 }
 
 
 void gobject::inverserotate()
 {
+#if !PW_HEADLESS
 	if (fRotated)
 	{
 		glRotatef(-fAngle[2], 0.0, 0.0, 1.0);	// z
 		glRotatef(-fAngle[1], 1.0, 0.0, 0.0); 	// x
 		glRotatef(-fAngle[0], 0.0, 1.0, 0.0);	// y
 	}		
+#endif
 }
 
 
@@ -340,13 +348,13 @@ void gobject::Dropped( void )
 	
 	if( fPosition[0] < 0.0 )
 		fPosition[0] = 0.0;
-	else if( fPosition[0] > globals::worldsize )
-		fPosition[0] = globals::worldsize;
+	else if( fPosition[0] > globals::worldsize() )
+		fPosition[0] = globals::worldsize();
 
 	if( fPosition[2] > 0.0 )
 		fPosition[2] = 0.0;
-	else if( fPosition[2] < -globals::worldsize )
-		fPosition[2] = -globals::worldsize;
+	else if( fPosition[2] < -globals::worldsize() )
+		fPosition[2] = -globals::worldsize();
 	
 }
 
@@ -82,6 +82,7 @@ public:
     float pitch();
     float roll();
     void setscale(float s);
+    float getscale();
     void setradius(float r);
     
     void setcol3(float* c);
@@ -177,6 +178,7 @@ inline float gobject::yaw() { return fAngle[0]; }
 inline float gobject::pitch() { return fAngle[1]; }
 inline float gobject::roll() { return fAngle[2]; }
 inline void gobject::setscale(float s) { fScale = s; }
+inline float gobject::getscale() { return fScale; }
 inline void gobject::setradius(float r) { fRadius = r; srPrint( "gobject::%s(r): r=%g\n", __FUNCTION__, fRadius ); }
 inline void gobject::settransparency(float t) { fColor[3] = t; }
 inline void gobject::SetRed(float r) { fColor[0] = r; }
@@ -39,10 +39,12 @@ gpoint::gpoint(char* n, float px, float py, float pz) : gobject(n)
 
 void gpoint::draw()
 {
+#if !PW_HEADLESS
 	glColor3fv(&fColor[0]);
 	
 	glBegin(GL_POINTS);
 		glVertex3fv(fPosition);
 	glEnd();
+#endif
 }
 
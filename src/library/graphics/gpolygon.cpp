@@ -3,6 +3,7 @@
 #include "gpolygon.h"
 
 // System
+#include <assert.h>
 #include <fstream>
 
 // Local
@@ -101,6 +102,7 @@ void gpoly::setscale(float s)
 
 void gpoly::draw()
 {
+#if !PW_HEADLESS
 	glColor3fv(&fColor[0]);
 	
     glPushMatrix();
@@ -113,6 +115,7 @@ void gpoly::draw()
 		glEnd();
       
     glPopMatrix();
+#endif
 }
 
 
@@ -172,6 +175,8 @@ gpolyobj::~gpolyobj()
 // WARNING:  this routine assumes the object to be cloned has the precise
 // same topology as the current object, unless the current object has yet
 // to be defined (in which case appropriate memory will be allocated).
+// Already allocated memory is reused, which is how a recycled agent keeps
+// its body.
 void gpolyobj::clonegeom(const gpolyobj& inPolyObj)
 {
     if (fPolygon == NULL)
@@ -184,7 +189,7 @@ void gpolyobj::clonegeom(const gpolyobj& inPolyObj)
     }
     else
     {
-    	printf("cloning with allocated mem\n");
+        assert(fNumPolygons == inPolyObj.fNumPolygons);
     }
     
     fNumPolygons = inPolyObj.fNumPolygons;
@@ -200,6 +205,7 @@ void gpolyobj::clonegeom(const gpolyobj& inPolyObj)
 
 void gpolyobj::drawcolpolyrange(long i1, long i2, float* color)
 {
+#if !PW_HEADLESS
 	glColor3fv(color);
 	glPolygonMode(GL_FRONT, GL_FILL);      
 
@@ -213,16 +219,19 @@ void gpolyobj::drawcolpolyrange(long i1, long i2, float* color)
 			glVertex3fv(&fPolygon[i].fVertices[0]);
 		glEnd();		
 	}
+#endif
 }
 
 
 void gpolyobj::draw()
 {
+#if !PW_HEADLESS
     glPushMatrix();
       position();
       glScalef(fScale, fScale, fScale);
       drawcolpolyrange(0, fNumPolygons - 1, fColor);
     glPopMatrix();
+#endif
 }
 
 
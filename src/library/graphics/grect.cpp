@@ -98,6 +98,7 @@ void grect::setrect(float xa, float ya, float xb, float yb)
     
 void grect::draw()
 {
+#if !PW_HEADLESS
 	glColor3fv(&fColor[0]);
 	
     glPushMatrix();
@@ -108,6 +109,7 @@ void grect::draw()
       	else
 			glRectf(0., 0., fLengthX, fLengthY);
     glPopMatrix();
+#endif
 }
 
 
@@ -108,6 +108,7 @@ void gscene::Clear()
 //---------------------------------------------------------------------------
 void gscene::Draw()
 {
+#if !PW_HEADLESS
 	if (fCamera == NULL)
     	MakeCamera();
     	
@@ -122,6 +123,7 @@ void gscene::Draw()
 			fStage->Draw();
 		}      
 	glPopMatrix();
+#endif
 }
 
 
@@ -131,6 +133,7 @@ void gscene::Draw()
 //---------------------------------------------------------------------------
 void gscene::Draw(const frustumXZ& fxz)
 {
+#if !PW_HEADLESS
     if (fCamera == NULL)
     	MakeCamera();
     	
@@ -145,6 +148,7 @@ void gscene::Draw(const frustumXZ& fxz)
 			fStage->Draw(fxz);
 		}
     glPopMatrix();
+#endif
 }
 
 
@@ -46,6 +46,7 @@ gsquare::gsquare(char* n, float xa, float ya, float xb, float yb)
 
 void gsquare::draw()
 {
+#if !PW_HEADLESS
 	glColor3fv(&fColor[0]);
 	
 	glPushMatrix();
@@ -56,6 +57,7 @@ void gsquare::draw()
 		else
 			glRectf(-0.5 * fLengthX, -0.5 * fLengthY, 0.5 * fLengthX, 0.5 * fLengthY);
     glPopMatrix();
+#endif
 }
 
 
@@ -149,6 +151,7 @@ void gbox::setradius()
 
 void gbox::draw()
 {
+#if !PW_HEADLESS
 	glColor3fv(&fColor[0]);
 	
 	glPushMatrix();
@@ -160,6 +163,7 @@ void gbox::draw()
 		//	frameunitcube();
 					
     glPopMatrix();
+#endif
 }
 
 void gbox::print()
@@ -113,6 +113,7 @@ void gstage::Clear()
 //---------------------------------------------------------------------------
 void gstage::Compile()
 {
+#if !PW_HEADLESS
 	if( fDisplayList )
 	{
 		Decompile();
@@ -128,6 +129,7 @@ void gstage::Compile()
 	glEndList();
 
 	fDisplayList = displayList;
+#endif
 }
 
 
@@ -136,7 +138,9 @@ void gstage::Compile()
 //---------------------------------------------------------------------------
 void gstage::Decompile()
 {
+#if !PW_HEADLESS
 	glDeleteLists( fDisplayList, 1 );
+#endif
 	fDisplayList = 0;
 }
 
@@ -148,7 +152,9 @@ void gstage::Draw()
 {
 	if( fDisplayList )
 	{
+#if !PW_HEADLESS
 		glCallList( fDisplayList );
+#endif
 	}
 	else
 	{
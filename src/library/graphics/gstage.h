@@ -34,6 +34,10 @@ public:
     void SetDrawLights(bool dl) { fDrawLights = dl; }
     void SetLightModel(glightmodel* plm) { fLightModel = plm; }    
     void SetCurrentCamera(gcamera* pcam);
+
+    TSetList* GetSet() { return fSetList; }
+    TPropList* GetProps() { return fPropList; }
+    TCastList* GetCast() { return fCastList; }
     
     void Clear();  // issues ->Clear() for all associated lists
 	void Compile();
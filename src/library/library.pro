@@ -1,4 +1,21 @@
-QT += opengl
+# "qmake CONFIG+=headless" builds without Qt or a GL context, and doesn't
+# link GL; the immediate-mode draw code is compiled out (#if !PW_HEADLESS).
+# Agent vision is then unavailable (see renderer/null); scene monitors and
+# movies are drawn in software (see renderer/soft).
+headless {
+    CONFIG -= qt
+    DEFINES += PW_HEADLESS
+} else {
+    QT += opengl
+}
+
+# "qmake CONFIG+=avx2" compiles the vector paths for AVX2 (see
+# utils/Activation.cpp, utils/PwMovieUtils.cpp and sim/GeneStats.cpp); the
+# library then needs a CPU with AVX2. Otherwise they use SSE2, which every
+# x86-64 CPU has.
+avx2 {
+    QMAKE_CXXFLAGS += -mavx2
+}
 
 TEMPLATE = lib
 DEFINES += LIBRARY_LIBRARY
@@ -28,6 +45,7 @@ SOURCES += \
     agent/RqSensor.cpp \
     agent/SpeedSensor.cpp \
     brain/Brain.cpp \
+    brain/CompactFiringRateModel.cpp \
     brain/FiringRateModel.cpp \
     brain/Nerve.cpp \
     brain/NervousSystem.cpp \
@@ -46,11 +64,13 @@ SOURCES += \
     environment/Energy.cpp \
     environment/food.cpp \
     environment/FoodPatch.cpp \
+    environment/FoodPatchIndex.cpp \
     environment/FoodType.cpp \
     environment/Patch.cpp \
     genome/Gene.cpp \
     genome/GeneSchema.cpp \
     genome/Genome.cpp \
+    genome/GenomeArchive.cpp \
     genome/GenomeLayout.cpp \
     genome/GenomeSchema.cpp \
     genome/GenomeUtil.cpp \
@@ -82,47 +102,58 @@ SOURCES += \
     monitor/MonitorManager.cpp \
     monitor/MovieController.cpp \
     monitor/SceneRenderer.cpp \
+    monitor/WorldSnapshot.cpp \
     proplib/builder.cpp \
     proplib/convert.cpp \
+    proplib/cppeval.cpp \
     proplib/cppprops.cpp \
+    proplib/cppsyms.cpp \
     proplib/dom.cpp \
     proplib/editor.cpp \
     proplib/expression.cpp \
     proplib/interpreter.cpp \
     proplib/overlay.cpp \
     proplib/parser.cpp \
+    proplib/pyeval.cpp \
     proplib/schema.cpp \
     proplib/state.cpp \
     proplib/writer.cpp \
+    sim/BrainStats.cpp \
     sim/debug.cpp \
     sim/EatStatistics.cpp \
     sim/FittestList.cpp \
     sim/GeneStats.cpp \
     sim/globals.cpp \
+    sim/Profiler.cpp \
     sim/Scheduler.cpp \
     sim/simtypes.cpp \
     sim/Simulation.cpp \
+    sim/SimulationContext.cpp \
+    sim/StatusLog.cpp \
+    sim/StatusSnapshot.cpp \
     utils/AbstractFile.cpp \
+    utils/Activation.cpp \
     utils/analysis.cpp \
     utils/datalib.cpp \
     utils/distributions.cpp \
     utils/drand48.cpp \
     utils/error.cpp \
     utils/indexlist.cpp \
+    utils/Metrics.cpp \
+    utils/MetricsSegment.cpp \
     utils/misc.cpp \
     utils/objectxsortedlist.cpp \
+    utils/PositionSnapshot.cpp \
     utils/PwMovieUtils.cpp \
     utils/RandomNumberGenerator.cpp \
+    utils/RandomStream.cpp \
     utils/resource.cpp \
     utils/Resources.cpp \
     utils/Scalar.cpp \
     utils/ThreadPool.cpp \
     utils/Variant.cpp \
     windows/dlfcn.c \
-    windows/link.c \
-    renderer/qt/PwMovieQGLPixelBufferRecorder.cpp \
-    renderer/qt/QtAgentPovRenderer.cpp \
-    renderer/qt/QtSceneRenderer.cpp
+    windows/link.c
 
 HEADERS += \
     library_global.h \
@@ -142,6 +173,7 @@ HEADERS += \
     agent/SpeedSensor.h \
     brain/BaseNeuronModel.h \
     brain/Brain.h \
+    brain/CompactFiringRateModel.h \
     brain/FiringRateModel.h \
     brain/Nerve.h \
     brain/NervousSystem.h \
@@ -165,11 +197,13 @@ HEADERS += \
     environment/Energy.h \
     environment/food.h \
     environment/FoodPatch.h \
+    environment/FoodPatchIndex.h \
     environment/FoodType.h \
     environment/Patch.h \
     genome/Gene.h \
     genome/GeneSchema.h \
     genome/Genome.h \
+    genome/GenomeArchive.h \
     genome/GenomeLayout.h \
     genome/GenomeSchema.h \
     genome/GenomeUtil.h \
@@ -204,9 +238,12 @@ HEADERS += \
     monitor/MovieController.h \
     monitor/MovieRecorder.h \
     monitor/SceneRenderer.h \
+    monitor/WorldSnapshot.h \
     proplib/builder.h \
     proplib/convert.h \
+    proplib/cppeval.h \
     proplib/cppprops.h \
+    proplib/cppsyms.h \
     proplib/dom.h \
     proplib/editor.h \
     proplib/expression.h \
@@ -214,20 +251,27 @@ HEADERS += \
     proplib/overlay.h \
     proplib/parser.h \
     proplib/proplib.h \
+    proplib/pyeval.h \
     proplib/schema.h \
     proplib/state.h \
     proplib/writer.h \
+    sim/BrainStats.h \
     sim/debug.h \
     sim/Domain.h \
     sim/EatStatistics.h \
     sim/FittestList.h \
     sim/GeneStats.h \
     sim/globals.h \
+    sim/Profiler.h \
     sim/Scheduler.h \
     sim/simconst.h \
     sim/simtypes.h \
     sim/Simulation.h \
+    sim/SimulationContext.h \
+    sim/StatusLog.h \
+    sim/StatusSnapshot.h \
     utils/AbstractFile.h \
+    utils/Activation.h \
     utils/analysis.h \
     utils/datalib.h \
     utils/distributions.h \
@@ -237,12 +281,16 @@ HEADERS += \
     utils/gdlink.h \
     utils/graybin.h \
     utils/indexlist.h \
+    utils/Metrics.h \
+    utils/MetricsSegment.h \
     utils/misc.h \
     utils/next_combination.h \
     utils/objectlist.h \
     utils/objectxsortedlist.h \
+    utils/PositionSnapshot.h \
     utils/PwMovieUtils.h \
     utils/RandomNumberGenerator.h \
+    utils/RandomStream.h \
     utils/resource.h \
     utils/Resources.h \
     utils/Scalar.h \
@@ -250,10 +298,33 @@ HEADERS += \
     utils/ThreadPool.h \
     utils/Variant.h \
     windows/dlfcn.h \
-    windows/link.h \
-    renderer/qt/PwMovieQGLPixelBufferRecorder.h \
-    renderer/qt/QtAgentPovRenderer.h \
-    renderer/qt/QtSceneRenderer.h
+    windows/link.h
+
+headless {
+    SOURCES += \
+        renderer/null/NullAgentPovRenderer.cpp \
+        renderer/soft/PwMovieSoftRecorder.cpp \
+        renderer/soft/SoftRasterizer.cpp \
+        renderer/soft/SoftScene.cpp \
+        renderer/soft/SoftSceneRenderer.cpp
+
+    HEADERS += \
+        renderer/null/NullAgentPovRenderer.h \
+        renderer/soft/PwMovieSoftRecorder.h \
+        renderer/soft/SoftRasterizer.h \
+        renderer/soft/SoftScene.h \
+        renderer/soft/SoftSceneRenderer.h
+} else {
+    SOURCES += \
+        renderer/qt/PwMovieQGLPixelBufferRecorder.cpp \
+        renderer/qt/QtAgentPovRenderer.cpp \
+        renderer/qt/QtSceneRenderer.cpp
+
+    HEADERS += \
+        renderer/qt/PwMovieQGLPixelBufferRecorder.h \
+        renderer/qt/QtAgentPovRenderer.h \
+        renderer/qt/QtSceneRenderer.h
+}
 
 # Default rules for deployment.
 unix {
@@ -261,9 +332,9 @@ unix {
 }
 !isEmpty(target.path): INSTALLS += target
 
-win32: LIBS += -lopengl32
+win32:!headless: LIBS += -lopengl32
 
-win32: LIBS += -lglu32
+win32:!headless: LIBS += -lglu32
 
 win32: LIBS += -lgsl
 
@@ -25,6 +25,7 @@ using namespace proplib;
 //---------------------------------------------------------------------------
 Logger::Logger()
 	: _simulation( NULL )
+	, _logs( NULL )
 	, _record( false )
 {
 	Logs::installLogger( const_cast<Logger *>(this) );
@@ -79,7 +80,7 @@ void Logger::initRecording( TSimulation *sim, StateScope scope, sim::EventType e
 		assert( false );
 	}
 
-	Logs::registerEvents( this, events );
+	_logs->registerEvents( this, events );
 }
 
 //---------------------------------------------------------------------------
@@ -221,7 +222,7 @@ AbstractFile *AbstractFileLogger::createFile( const std::string &path )
 {
 	makeParentDir( path );
 
-	AbstractFile *file = AbstractFile::open( globals::recordFileType, path.c_str(), "w" );
+	AbstractFile *file = AbstractFile::open( globals::recordFileType(), path.c_str(), "w" );
 
 	if( _scope == SimulationStateScope )
 		setSimulationState( file );
@@ -244,7 +245,7 @@ AbstractFile *AbstractFileLogger::createFile( agent *a, const std::string &path
 {
 	makeParentDir( path );
 
-	AbstractFile *file = AbstractFile::open( globals::recordFileType, path.c_str(), "w" );
+	AbstractFile *file = AbstractFile::open( globals::recordFileType(), path.c_str(), "w" );
 	setAgentState( a, file );
 
 	return file;
@@ -92,6 +92,7 @@ class Logger
 
 	StateScope _scope;
 	class TSimulation *_simulation;
+	class Logs *_logs;
 	bool _record;
 
  private:
@@ -10,11 +10,13 @@
 #include "agent/agent.h"
 #include "brain/Brain.h"
 #include "complexity/adami.h"
+#include "genome/GenomeArchive.h"
 #include "genome/GenomeUtil.h"
 #include "genome/SeparationCache.h"
 #include "proplib/proplib.h"
 #include "sim/globals.h"
 #include "sim/Simulation.h"
+#include "sim/SimulationContext.h"
 #include "utils/datalib.h"
 #include "utils/misc.h"
 
@@ -31,22 +33,23 @@ using namespace proplib;
 //===========================================================================
 // Logs
 //===========================================================================
-Logs *logs = NULL;
 
-Logs::LoggerList Logs::_installedLoggers;
-sim::EventType Logs::_registeredEvents;
-Logs::EventRegistry Logs::_eventRegistry;
+// Loggers install themselves as the members of a Logs are constructed, before
+// its constructor body runs; the constructor then claims them.
+static thread_local std::list<Logger *> pendingLoggers;
 
 //---------------------------------------------------------------------------
 // Logs::Logs
 //---------------------------------------------------------------------------
 Logs::Logs( TSimulation *sim, Document *doc )
 {
-	assert( logs == NULL );
+	_installedLoggers.swap( pendingLoggers );
 
 	_registeredEvents = 0;
+	_eventCount = 0;
 	itfor( LoggerList, _installedLoggers, it )
 	{
+		(*it)->_logs = this;
 		(*it)->init( sim, doc );
 	}
 }
@@ -58,7 +61,14 @@ Logs::~Logs()
 {
 	// We don't have to delete the loggers since they're part of this datastructure.
 	_installedLoggers.clear();
-	logs = NULL;
+}
+
+//---------------------------------------------------------------------------
+// Logs::current
+//---------------------------------------------------------------------------
+Logs *Logs::current()
+{
+	return SimulationContext::current()->logs;
 }
 
 //---------------------------------------------------------------------------
@@ -66,7 +76,7 @@ Logs::~Logs()
 //---------------------------------------------------------------------------
 void Logs::installLogger( Logger *logger )
 {
-	_installedLoggers.push_back( logger );
+	pendingLoggers.push_back( logger );
 }
 
 //---------------------------------------------------------------------------
@@ -138,10 +148,10 @@ void Logs::AdamiComplexityLog::processEvent( const StepEndEvent &e )
 {
 	if( getStep() % _frequency == 0 )
 	{
-        FILE *FileOneBit = createFile( "run/genome/AdamiComplexity-1bit.txt", "a" );
-        FILE *FileTwoBit = createFile( "run/genome/AdamiComplexity-2bit.txt", "a" );
-        FILE *FileFourBit = createFile( "run/genome/AdamiComplexity-4bit.txt", "a" );
-        FILE *FileSummary = createFile( "run/genome/AdamiComplexity-summary.txt", "a" );
+        FILE *FileOneBit = createFile( SimulationContext::runPath( "genome/AdamiComplexity-1bit.txt" ), "a" );
+        FILE *FileTwoBit = createFile( SimulationContext::runPath( "genome/AdamiComplexity-2bit.txt" ), "a" );
+        FILE *FileFourBit = createFile( SimulationContext::runPath( "genome/AdamiComplexity-4bit.txt" ), "a" );
+        FILE *FileSummary = createFile( SimulationContext::runPath( "genome/AdamiComplexity-summary.txt" ), "a" );
 
 		computeAdamiComplexity( getStep(),
 								FileOneBit,
@@ -187,7 +197,7 @@ void Logs::AgentEnergyLog::processEvent( const sim::AgentBirthEvent &e )
 
 	char path[512];
 	sprintf( path,
-             "run/energy/agents/agent_%ld.txt",
+             "%s/energy/agents/agent_%ld.txt", SimulationContext::runDir(),
 			 e.a->getTypeNumber() );
 
 	DataLibWriter *writer = createWriter( e.a, path, true, false );
@@ -217,8 +227,8 @@ void Logs::AgentEnergyLog::processEvent( const sim::AgentBirthEvent &e )
 void Logs::AgentEnergyLog::processEvent( const sim::StepEndEvent &e )
 {
 	agent *a;
-	objectxsortedlist::gXSortedObjects.reset();
-	while( objectxsortedlist::gXSortedObjects.nextObj( AGENTTYPE, (gobject**)&a ) )
+	objectxsortedlist::gXSortedObjects().reset();
+	while( objectxsortedlist::gXSortedObjects().nextObj( AGENTTYPE, (gobject**)&a ) )
 	{
 		getWriter( a )->addRow( getStep(),
 								a->GetEnergy().sum(),
@@ -256,7 +266,7 @@ void Logs::AgentMaxEnergyLog::init( TSimulation *sim, Document *doc )
 					   SimulationStateScope,
 					   sim::Event_AgentGrown );
 
-        createWriter( "run/energy/agents/max.txt" );
+        createWriter( SimulationContext::runPath( "energy/agents/max.txt" ) );
 
 		const char *colnames[] =
 			{
@@ -323,7 +333,7 @@ void Logs::AgentPositionLog::processEvent( const sim::AgentBirthEvent &e )
 
 	char path[512];
 	sprintf( path,
-             "run/motion/position/agents/position_%ld.txt",
+             "%s/motion/position/agents/position_%ld.txt", SimulationContext::runDir(),
 			 e.a->getTypeNumber() );
 
 	switch( _mode )
@@ -407,7 +417,7 @@ void Logs::BirthsDeathsLog::init( TSimulation *sim, Document *doc )
 					   sim::Event_AgentBirth
 					   | sim::Event_AgentDeath );
 
-        createFile( "run/BirthsDeaths.log" );
+        createFile( SimulationContext::runPath( "BirthsDeaths.log" ) );
 		fprintf( getFile(), "%% Timestep Event Agent# Parent1 Parent2\n" );
 	}
 }
@@ -502,7 +512,7 @@ void Logs::BrainAnatomyLog::init( TSimulation *sim, Document *doc )
 //---------------------------------------------------------------------------
 void Logs::BrainAnatomyLog::processEvent( const BrainGrownEvent &e )
 {
-	if( Brain::config.learningMode != Brain::Configuration::LEARN_NONE )
+	if( Brain::config().learningMode != Brain::Configuration::LEARN_NONE )
 		createAnatomyFile( e.a, "incept", 0.0 );
 }
 
@@ -519,7 +529,7 @@ void Logs::BrainAnatomyLog::processEvent( const AgentGrownEvent &e )
 //---------------------------------------------------------------------------
 void Logs::BrainAnatomyLog::processEvent( const BrainAnalysisBeginEvent &e )
 {
-	if( Brain::config.learningMode == Brain::Configuration::LEARN_ALL )
+	if( Brain::config().learningMode == Brain::Configuration::LEARN_ALL )
 		createAnatomyFile( e.a, "death", e.a->CurrentHeuristicFitness() );
 }
 
@@ -541,7 +551,7 @@ void Logs::BrainAnatomyLog::processEvent( const EpochEndEvent &e )
 void Logs::BrainAnatomyLog::createAnatomyFile( agent *a, const char *suffix, float fitness )
 {
 	char path[256];
-    sprintf( path, "run/brain/anatomy/brainAnatomy_%ld_%s.txt", a->Number(), suffix );
+    sprintf( path, "%s/brain/anatomy/brainAnatomy_%ld_%s.txt", SimulationContext::runDir(), a->Number(), suffix );
 
 	AbstractFile *file = createFile( path );
 	a->GetBrain()->dumpAnatomical( file, a->Number(), fitness );
@@ -556,7 +566,7 @@ void Logs::BrainAnatomyLog::recordEpochFittest( long step, sim::FitnessScope sco
 	char s[256];
 	FittestList *fittest = _simulation->getFittest( scope );
 
-    sprintf( s, "run/brain/%s/%ld", scopeName, step );
+    sprintf( s, "%s/brain/%s/%ld", SimulationContext::runDir(), scopeName, step );
 	makeDirs( s );
 	for( int i = 0; i < fittest->size(); i++ )
 	{
@@ -565,8 +575,8 @@ void Logs::BrainAnatomyLog::recordEpochFittest( long step, sim::FitnessScope sco
 		for( const char **prefix = prefixes; *prefix; prefix++ )
 		{
 			char t[256];	// target (use s for source)
-            sprintf( s, "run/brain/anatomy/brainAnatomy_%ld_%s.txt", fittest->get(i)->agentID, *prefix );
-            sprintf( t, "run/brain/%s/%ld/%d_brainAnatomy_%ld_%s.txt", scopeName, step, i, fittest->get(i)->agentID, *prefix );
+            sprintf( s, "%s/brain/anatomy/brainAnatomy_%ld_%s.txt", SimulationContext::runDir(), fittest->get(i)->agentID, *prefix );
+            sprintf( t, "%s/brain/%s/%ld/%d_brainAnatomy_%ld_%s.txt", SimulationContext::runDir(), scopeName, step, i, fittest->get(i)->agentID, *prefix );
 			if( AbstractFile::exists( s ) )
 				AbstractFile::link( s, t );
 		}
@@ -671,7 +681,7 @@ void Logs::BrainComplexityLog::writeComplexityFile( long epoch, ComplexityMap &c
 		};
 
 	char path[256];
-    sprintf( path, "run/brain/Recent/%ld/complexity_%s.plt", epoch, _complexityType.c_str() );
+    sprintf( path, "%s/brain/Recent/%ld/complexity_%s.plt", SimulationContext::runDir(), epoch, _complexityType.c_str() );
 
 	DataLibWriter *writer = createWriter( path );
 
@@ -725,10 +735,10 @@ void Logs::BrainComplexityLog::writeBestRecent( long epoch )
 	stddev = sqrt(stddev / (count-1) );		// note that this stddev is divided by N-1 (MATLAB default)
 	double StandardError = stddev / sqrt(count);
 
-    const char *path = "run/brain/bestRecent/complexity.txt";
+    std::string path = SimulationContext::runPath( "brain/bestRecent/complexity.txt" );
 	makeParentDir( path );
-	FILE *cFile = fopen( path, "a" );
-	if( !cFile ) { perror( path ); exit( 1 ); }
+	FILE *cFile = fopen( path.c_str(), "a" );
+	if( !cFile ) { perror( path.c_str() ); exit( 1 ); }
 
 	// print to complexity.txt
 	fprintf( cFile, "%ld %f %f %f %d\n", epoch, mean, stddev, StandardError, count );
@@ -782,7 +792,7 @@ void Logs::BrainFunctionLog::init( TSimulation *sim, Document *doc )
 void Logs::BrainFunctionLog::processEvent( const AgentGrownEvent &e )
 {
 	char path[256];
-    sprintf( path, "run/brain/function/incomplete_brainFunction_%ld.txt", e.a->Number() );
+    sprintf( path, "%s/brain/function/incomplete_brainFunction_%ld.txt", SimulationContext::runDir(), e.a->Number() );
 
 	AbstractFile *file = createFile( e.a, path );
 	e.a->GetBrain()->startFunctional( file, e.a->Number() );
@@ -813,8 +823,8 @@ void Logs::BrainFunctionLog::processEvent( const BrainAnalysisBeginEvent &e )
 
 	char s[256];
 	char t[256];
-    sprintf( s, "run/brain/function/incomplete_brainFunction_%ld.txt", e.a->Number() );
-    sprintf( t, "run/brain/function/brainFunction_%ld.txt", e.a->Number() );
+    sprintf( s, "%s/brain/function/incomplete_brainFunction_%ld.txt", SimulationContext::runDir(), e.a->Number() );
+    sprintf( t, "%s/brain/function/brainFunction_%ld.txt", SimulationContext::runDir(), e.a->Number() );
 	AbstractFile::rename( s, t );
 
 	// Simulation needs this path for calculating complexity.
@@ -822,13 +832,13 @@ void Logs::BrainFunctionLog::processEvent( const BrainAnalysisBeginEvent &e )
 
 	if( _recordRecent )
 	{
-        sprintf( s, "run/brain/Recent/%ld/brainFunction_%ld.txt", _simulation->getEpoch(), e.a->Number() );
+        sprintf( s, "%s/brain/Recent/%ld/brainFunction_%ld.txt", SimulationContext::runDir(), _simulation->getEpoch(), e.a->Number() );
 		makeParentDir( s );
 		AbstractFile::link( t, s );
 
 		if( e.a->Number() <= _nseeds )
 		{
-            sprintf( s, "run/brain/Recent/0/brainFunction_%ld.txt", e.a->Number() );
+            sprintf( s, "%s/brain/Recent/0/brainFunction_%ld.txt", SimulationContext::runDir(), e.a->Number() );
 			makeParentDir( s );
 			AbstractFile::link( t, s );
 		}
@@ -853,8 +863,8 @@ void Logs::BrainFunctionLog::processEvent( const EpochEndEvent &e )
 void Logs::BrainFunctionLog::processEvent( const SimEndEvent &e )
 {
 	agent *a;
-	objectxsortedlist::gXSortedObjects.reset();
-	while( objectxsortedlist::gXSortedObjects.nextObj( AGENTTYPE, (gobject**)&a ) )
+	objectxsortedlist::gXSortedObjects().reset();
+	while( objectxsortedlist::gXSortedObjects().nextObj( AGENTTYPE, (gobject**)&a ) )
 		delete getFile( a );
 }
 
@@ -866,13 +876,13 @@ void Logs::BrainFunctionLog::recordEpochFittest( long step, sim::FitnessScope sc
 	char s[256];
 	FittestList *fittest = _simulation->getFittest( scope );
 
-    sprintf( s, "run/brain/%s/%ld", scopeName, step );
+    sprintf( s, "%s/brain/%s/%ld", SimulationContext::runDir(), scopeName, step );
 	makeDirs( s );
 	for( int i = 0; i < fittest->size(); i++ )
 	{
 		char t[256];	// target (use s for source)
-        sprintf( s, "run/brain/function/brainFunction_%ld.txt", fittest->get(i)->agentID );
-        sprintf( t, "run/brain/%s/%ld/%d_brainFunction_%ld.txt", scopeName, step, i, fittest->get(i)->agentID );
+        sprintf( s, "%s/brain/function/brainFunction_%ld.txt", SimulationContext::runDir(), fittest->get(i)->agentID );
+        sprintf( t, "%s/brain/%s/%ld/%d_brainFunction_%ld.txt", SimulationContext::runDir(), scopeName, step, i, fittest->get(i)->agentID );
 		AbstractFile::link( s, t );
 	}
 }
@@ -893,7 +903,7 @@ void Logs::CarryLog::init( TSimulation *sim, Document *doc )
 					   SimulationStateScope,
 					   sim::Event_Carry );
 
-        DataLibWriter *writer = createWriter( "run/events/carry.log" );
+        DataLibWriter *writer = createWriter( SimulationContext::runPath( "events/carry.log" ) );
 
 		const char *colnames[] =
 			{
@@ -960,7 +970,7 @@ void Logs::CollisionLog::init( TSimulation *sim, Document *doc )
 					   SimulationStateScope,
 					   sim::Event_Collision );
 
-        DataLibWriter *writer = createWriter( "run/events/collisions.log" );
+        DataLibWriter *writer = createWriter( SimulationContext::runPath( "events/collisions.log" ) );
 
 		const char *colnames[] =
 			{
@@ -1016,7 +1026,7 @@ void Logs::ContactLog::init( TSimulation *sim, Document *doc )
 					   SimulationStateScope,
 					   sim::Event_ContactEnd );
 
-        DataLibWriter *writer = createWriter( "run/events/contacts.log" );
+        DataLibWriter *writer = createWriter( SimulationContext::runPath( "events/contacts.log" ) );
 
 		const char *colnames[] =
 			{
@@ -1139,7 +1149,7 @@ void Logs::EnergyLog::init( TSimulation *sim, Document *doc )
 					   SimulationStateScope,
 					   sim::Event_Energy );
 
-        DataLibWriter *writer = createWriter( "run/events/energy.log" );
+        DataLibWriter *writer = createWriter( SimulationContext::runPath( "events/energy.log" ) );
 
 		const char *colnames_template[] =
 			{
@@ -1161,14 +1171,14 @@ void Logs::EnergyLog::init( TSimulation *sim, Document *doc )
 		int lenTemplate = sizeof(colnames_template) / sizeof(char *);
 
 		// Now add columns for the energy types, where the number is not known at compile-time.
-		const char **colnames = new const char *[ lenTemplate + globals::numEnergyTypes + 1 ];
-		datalib::Type *coltypes = new datalib::Type[ lenTemplate + globals::numEnergyTypes ];
+		const char **colnames = new const char *[ lenTemplate + globals::numEnergyTypes() + 1 ];
+		datalib::Type *coltypes = new datalib::Type[ lenTemplate + globals::numEnergyTypes() ];
 		for( int i = 0; i < lenTemplate; i++ )
 		{
 			colnames[i] = colnames_template[i];
 			coltypes[i] = coltypes_template[i];
 		}
-		for( int i = 0; i < globals::numEnergyTypes; i++ )
+		for( int i = 0; i < globals::numEnergyTypes(); i++ )
 		{
 			char buf[128];
 			sprintf( buf, "Energy%d", i );
@@ -1176,7 +1186,7 @@ void Logs::EnergyLog::init( TSimulation *sim, Document *doc )
 
 			coltypes[ lenTemplate + i ] = datalib::FLOAT;
 		}
-		colnames[ lenTemplate + globals::numEnergyTypes ] = NULL;
+		colnames[ lenTemplate + globals::numEnergyTypes() ] = NULL;
 
 		writer->beginTable( "Energy",
 							colnames,
@@ -1194,13 +1204,13 @@ void Logs::EnergyLog::processEvent( const sim::EnergyEvent &e )
 									   "E"};
 	const char *actionName = actionNames[ e.action ];
 
-	Variant *coldata = (Variant *)alloca(sizeof(Variant) * (5 + globals::numEnergyTypes));
+	Variant *coldata = (Variant *)alloca(sizeof(Variant) * (5 + globals::numEnergyTypes()));
 	coldata[0] = getStep();
 	coldata[1] = e.a->Number();
 	coldata[2] = actionName;
 	coldata[3] = (long)e.obj->getTypeNumber();
 	coldata[4] = e.neuralActivation;
-	for( int i = 0; i < globals::numEnergyTypes; i++ )
+	for( int i = 0; i < globals::numEnergyTypes(); i++ )
 	{
 		coldata[5 + i] = e.energy[i];
 	}
@@ -1224,7 +1234,7 @@ void Logs::FoodConsumptionLog::init( TSimulation *sim, Document *doc )
 					   SimulationStateScope,
 					   sim::Event_Energy );
 
-        createWriter( "run/energy/consumption.txt" );
+        createWriter( SimulationContext::runPath( "energy/consumption.txt" ) );
 
 		const char *colnames[] =
 			{
@@ -1283,7 +1293,7 @@ void Logs::FoodEnergyLog::init( TSimulation *sim, Document *doc )
 					   sim::Event_SimInited
 					   | sim::Event_StepEnd );
 
-        createWriter( "run/energy/food.txt" );
+        createWriter( SimulationContext::runPath( "energy/food.txt" ) );
 
 		int count = FoodType::getNumberDefinitions();
 		const char **colnames = new const char*[count + 2];
@@ -1334,8 +1344,8 @@ void Logs::FoodEnergyLog::processEvent( )
 		energy[i] = 0.0f;
 	}
 	food* f;
-	objectxsortedlist::gXSortedObjects.reset();
-	while( objectxsortedlist::gXSortedObjects.nextObj( FOODTYPE, (gobject**) &f ) )
+	objectxsortedlist::gXSortedObjects().reset();
+	while( objectxsortedlist::gXSortedObjects().nextObj( FOODTYPE, (gobject**) &f ) )
 	{
 		energy[f->getType()->index] += f->getEnergy().sum();
 	}
@@ -1369,9 +1379,9 @@ void Logs::GeneStatsLog::init( TSimulation *sim, Document *doc )
 
 		sim->getGeneStats().init( sim->GetMaxAgents() );
 
-        FILE *f = createFile( "run/genome/genestats.txt" );
+        FILE *f = createFile( SimulationContext::runPath( "genome/genestats.txt" ) );
 
-		fprintf( f, "%d\n", GenomeUtil::schema->getMutableSize() );
+		fprintf( f, "%d\n", GenomeUtil::schema()->getMutableSize() );
 	}
 }
 
@@ -1382,7 +1392,7 @@ void Logs::GeneStatsLog::processEvent( const sim::StepEndEvent &e )
 {
 	float *mean = _simulation->getGeneStats().getMean();
 	float *stddev = _simulation->getGeneStats().getStddev();
-	int ngenes = GenomeUtil::schema->getMutableSize();
+	int ngenes = GenomeUtil::schema()->getMutableSize();
 
 	FILE *f = getFile();
 
@@ -1397,10 +1407,78 @@ void Logs::GeneStatsLog::processEvent( const sim::StepEndEvent &e )
 }
 
 
+//===========================================================================
+// GeneHistogramsLog
+//===========================================================================
+
+//---------------------------------------------------------------------------
+// Logs::GeneHistogramsLog::init
+//---------------------------------------------------------------------------
+void Logs::GeneHistogramsLog::init( TSimulation *sim, Document *doc )
+{
+	if( doc->get("RecordGeneHistograms") )
+	{
+		initRecording( sim,
+					   SimulationStateScope,
+					   sim::Event_StepEnd );
+
+		sim->getGeneStats().init( sim->GetMaxAgents() );
+		sim->getGeneStats().initHistograms();
+
+        FILE *f = createFile( SimulationContext::runPath( "genome/genehistograms.txt" ) );
+
+		fprintf( f, "%d %d\n", GenomeUtil::schema()->getMutableSize(), GeneStats::HistogramBins );
+	}
+}
+
+//---------------------------------------------------------------------------
+// Logs::GeneHistogramsLog::processEvent
+//---------------------------------------------------------------------------
+void Logs::GeneHistogramsLog::processEvent( const sim::StepEndEvent &e )
+{
+	unsigned long *histograms = _simulation->getGeneStats().getHistograms();
+	int ngenes = GenomeUtil::schema()->getMutableSize();
+
+	FILE *f = getFile();
+
+	fprintf( f, "%ld", getStep() );
+
+	for( int i = 0; i < ngenes; i++ )
+	{
+		unsigned long *bins = histograms + i * GeneStats::HistogramBins;
+
+		fprintf( f, " %lu", bins[0] );
+		for( int j = 1; j < GeneStats::HistogramBins; j++ )
+			fprintf( f, ",%lu", bins[j] );
+	}
+
+	fprintf( f, "\n" );
+}
+
+
 //===========================================================================
 // GenomeLog
 //===========================================================================
 
+//---------------------------------------------------------------------------
+// Logs::GenomeLog::GenomeLog
+//---------------------------------------------------------------------------
+Logs::GenomeLog::GenomeLog()
+: _text( false )
+, _archive( NULL )
+, _genes( NULL )
+{
+}
+
+//---------------------------------------------------------------------------
+// Logs::GenomeLog::~GenomeLog
+//---------------------------------------------------------------------------
+Logs::GenomeLog::~GenomeLog()
+{
+	delete _archive;
+	delete [] _genes;
+}
+
 //---------------------------------------------------------------------------
 // Logs::GenomeLog::init
 //---------------------------------------------------------------------------
@@ -1411,6 +1489,18 @@ void Logs::GenomeLog::init( TSimulation *sim, Document *doc )
 		initRecording( sim,
 					   NullStateScope,
 					   sim::Event_AgentBirth );
+
+		std::string format = doc->get( "GenomeLogFormat" );
+		_text = format != "Archive";
+		if( format != "Text" )
+		{
+			std::string path = SimulationContext::runPath( GenomeArchive::RelativePath );
+			makeParentDir( path );
+
+			int genomeSize = GenomeUtil::schema()->getMutableSize();
+			_archive = GenomeArchive::create( path, genomeSize );
+			_genes = new unsigned char[genomeSize];
+		}
 	}
 }
 
@@ -1421,12 +1511,21 @@ void Logs::GenomeLog::processEvent( const sim::AgentBirthEvent &birth )
 {
 	if( birth.reason != LifeSpan::BR_VIRTUAL )
 	{
-		char path[256];
-        sprintf( path, "run/genome/agents/genome_%ld.txt", birth.a->Number() );
+		if( _text )
+		{
+			char path[256];
+			sprintf( path, "%s/genome/agents/genome_%ld.txt", SimulationContext::runDir(), birth.a->Number() );
 
-		AbstractFile *out = createFile( path );
-		birth.a->Genes()->dump( out );
-		delete out;
+			AbstractFile *out = createFile( path );
+			birth.a->Genes()->dump( out );
+			delete out;
+		}
+
+		if( _archive )
+		{
+			birth.a->Genes()->dump( _genes );
+			_archive->append( birth.a->Number(), _genes );
+		}
 	}
 }
 
@@ -1451,33 +1550,34 @@ void Logs::GenomeMetaLog::init( TSimulation *sim, Document *doc )
 void Logs::GenomeMetaLog::processEvent( const sim::SimInitedEvent &birth )
 {
 	{
-        FILE* f = createFile("run/genome/meta/geneindex.txt");
+        FILE* f = createFile(SimulationContext::runPath( "genome/meta/geneindex.txt" ));
 
-		GenomeUtil::schema->printIndexes( f );
+		GenomeUtil::schema()->printIndexes( f );
 
 		fclose( f );
 	}
 	{
-        FILE* f = createFile("run/genome/meta/genelayout.txt");
+        FILE* f = createFile(SimulationContext::runPath( "genome/meta/genelayout.txt" ));
 
-        GenomeUtil::schema->printIndexes(f, GenomeUtil::layout);
+        GenomeUtil::schema()->printIndexes(f, GenomeUtil::layout());
 
 		fclose( f );
 
 		// TODO: Migirieren
-        SYSTEM(UTILS_PATH "cat run/genome/meta/genelayout.txt | " UTILS_PATH "sort -n > run/genome/meta/genelayout-sorted.txt");
+        std::string meta = SimulationContext::runPath( "genome/meta/" );
+        SYSTEM((UTILS_PATH "cat " + meta + "genelayout.txt | " UTILS_PATH "sort -n > " + meta + "genelayout-sorted.txt").c_str());
 	}
 	{
-        FILE* f = createFile("run/genome/meta/genetitle.txt");
+        FILE* f = createFile(SimulationContext::runPath( "genome/meta/genetitle.txt" ));
 
-        GenomeUtil::schema->printTitles(f);
+        GenomeUtil::schema()->printTitles(f);
 
         fclose(f);
 	}
 	{
-        FILE* f = createFile( "run/genome/meta/generange.txt" );
+        FILE* f = createFile( SimulationContext::runPath( "genome/meta/generange.txt" ) );
 
-		GenomeUtil::schema->printRanges( f );
+		GenomeUtil::schema()->printRanges( f );
 
 		fclose( f );
 	}
@@ -1508,7 +1608,7 @@ void Logs::GenomeSubsetLog::init( TSimulation *sim, Document *doc )
 			geneNames.push_back( propGeneNames.get(i) );
 		}
 
-		GenomeUtil::schema->getIndexes( geneNames, _geneIndexes );
+		GenomeUtil::schema()->getIndexes( geneNames, _geneIndexes );
 		for( int i = 0; i < (int)geneNames.size(); i++ )
 		{
 			if( _geneIndexes[i] < 0 )
@@ -1530,7 +1630,7 @@ void Logs::GenomeSubsetLog::init( TSimulation *sim, Document *doc )
 			coltypes.push_back( datalib::INT );
 		}
 
-        DataLibWriter *writer = createWriter( "run/genome/subset.log" );
+        DataLibWriter *writer = createWriter( SimulationContext::runPath( "genome/subset.log" ) );
 		writer->beginTable( "GenomeSubset",
 							colnames,
 							coltypes );
@@ -1581,7 +1681,7 @@ void Logs::GitRevisionLog::init( TSimulation *sim, Document *doc )
 //---------------------------------------------------------------------------
 void Logs::GitRevisionLog::processEvent( const sim::SimInitedEvent &birth )
 {
-    SYSTEM( "git rev-parse HEAD > run/gitrevision.txt" );
+    SYSTEM( ("git rev-parse HEAD > " + SimulationContext::runPath("gitrevision.txt")).c_str() );
 }
 
 
@@ -1598,7 +1698,7 @@ void Logs::LifeSpanLog::init( TSimulation *sim, Document *doc )
 				   SimulationStateScope,
 				   sim::Event_AgentDeath );
 
-    createWriter( "run/lifespans.txt" );
+    createWriter( SimulationContext::runPath( "lifespans.txt" ) );
 
 	const char *colnames[] =
 		{
@@ -1656,7 +1756,7 @@ void Logs::PopulationLog::init( TSimulation *sim, Document *doc )
 					   SimulationStateScope,
 					   sim::Event_StepEnd );
 
-        createWriter( "run/population.txt" );
+        createWriter( SimulationContext::runPath( "population.txt" ) );
 
 		const char *colnames[] =
 			{
@@ -1721,7 +1821,7 @@ void Logs::SeparationLog::init( TSimulation *sim, Document *doc )
 			assert(false);
 
 
-        createWriter( "run/genome/separations.txt", false, false );
+        createWriter( SimulationContext::runPath( "genome/separations.txt" ), false, false );
 	}
 }
 
@@ -1838,7 +1938,7 @@ void Logs::SynapseLog::init( TSimulation *sim, Document *doc )
 //---------------------------------------------------------------------------
 void Logs::SynapseLog::processEvent( const BrainGrownEvent &e )
 {
-	if( Brain::config.learningMode != Brain::Configuration::LEARN_NONE )
+	if( Brain::config().learningMode != Brain::Configuration::LEARN_NONE )
 		createSynapseFile( e.a, "incept" );
 }
 
@@ -1855,7 +1955,7 @@ void Logs::SynapseLog::processEvent( const AgentGrownEvent &e )
 //---------------------------------------------------------------------------
 void Logs::SynapseLog::processEvent( const BrainAnalysisBeginEvent &e )
 {
-	if( Brain::config.learningMode == Brain::Configuration::LEARN_ALL )
+	if( Brain::config().learningMode == Brain::Configuration::LEARN_ALL )
 		createSynapseFile( e.a, "death" );
 }
 
@@ -1865,7 +1965,7 @@ void Logs::SynapseLog::processEvent( const BrainAnalysisBeginEvent &e )
 void Logs::SynapseLog::createSynapseFile( agent *a, const char *suffix )
 {
 	char path[256];
-    sprintf( path, "run/brain/synapses/synapses_%ld_%s.txt", a->Number(), suffix );
+    sprintf( path, "%s/brain/synapses/synapses_%ld_%s.txt", SimulationContext::runDir(), a->Number(), suffix );
 
 	AbstractFile *file = createFile( path );
 	a->GetBrain()->dumpSynapses( file, a->Number() );
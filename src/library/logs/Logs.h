@@ -8,13 +8,12 @@
 #include "utils/misc.h"
 #include "sim/simconst.h"
 
+namespace genome { class GenomeArchive; }
+
 //===========================================================================
 // Logs
 //===========================================================================
 
-// Global instance. Constructed/deleted by TSimulation.
-extern class Logs *logs;
-
 class Logs
 {
  private:
@@ -30,22 +29,27 @@ class Logs
 	static void installLogger( Logger *logger );
 
 	// Configure which events logger will receive.
-	static void registerEvents( Logger *logger,
-								sim::EventType eventTypes );
+	void registerEvents( Logger *logger,
+						 sim::EventType eventTypes );
 
  private:
 	typedef std::list<Logger *> LoggerList;
 	typedef std::map< sim::EventType, LoggerList > EventRegistry;
 
-	static LoggerList _installedLoggers;
+	LoggerList _installedLoggers;
 
 	// Bitwise OR of all registered event types.
-	static sim::EventType _registeredEvents;
+	sim::EventType _registeredEvents;
 
 	// Maps from a given event type to all registered logs.
-	static EventRegistry _eventRegistry;
+	EventRegistry _eventRegistry;
+
+	long _eventCount;
 
  public:
+	// Logs of the current simulation. Constructed/deleted by TSimulation.
+	static Logs *current();
+
 	//---------------------------------------------------------------------------
 	// Logs::postEvent
 	//
@@ -63,11 +67,14 @@ class Logs
 			itfor( LoggerList, loggers, it )
 			{
 				(*it)->processEvent( e );
+				_eventCount++;
 			}
 		}
 	}
 
 	int getMaxOpenFiles();
+	// Number of events delivered to loggers so far.
+	long getEventCount() const { return _eventCount; }
 
  private:
 	//===========================================================================
@@ -290,14 +297,33 @@ class Logs
 		virtual void processEvent( const sim::StepEndEvent &e );
 	} _geneStats;
 
+	//===========================================================================
+	// GeneHistogramsLog
+	//===========================================================================
+	class GeneHistogramsLog : public FileLogger
+	{
+	protected:
+		virtual void init( class TSimulation *sim, proplib::Document *doc );
+		virtual void processEvent( const sim::StepEndEvent &e );
+	} _geneHistograms;
+
 	//===========================================================================
 	// GenomeLog
 	//===========================================================================
 	class GenomeLog : public AbstractFileLogger
 	{
+	public:
+		GenomeLog();
+		virtual ~GenomeLog();
+
 	protected:
 		virtual void init( class TSimulation *sim, proplib::Document *doc );
 		virtual void processEvent( const sim::AgentBirthEvent &birth );
+
+	private:
+		bool _text;
+		genome::GenomeArchive *_archive;
+		unsigned char *_genes;
 	} _genome;
 
 	//===========================================================================
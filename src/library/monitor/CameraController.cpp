@@ -65,9 +65,9 @@ void CameraController::initStatic( const StaticParms &parms )
 	mode = MODE__STATIC;
 
 	camera.SetRotation( 0.0, -90, 0.0 );
-	camera.settranslation( 0.5 * globals::worldsize,
-						   parms.height * globals::worldsize,
-						   -0.5 * globals::worldsize );
+	camera.settranslation( 0.5 * globals::worldsize(),
+						   parms.height * globals::worldsize(),
+						   -0.5 * globals::worldsize() );
 }
 
 void CameraController::setRotationAngle( float angle )
@@ -75,9 +75,9 @@ void CameraController::setRotationAngle( float angle )
 	RotationParms &parms = rotationState.parms;
 	rotationState.angle = angle;
 	float camrad = rotationState.angle * DEGTORAD;
-	camera.settranslation( (0.5 + parms.radius * sin(camrad)) * globals::worldsize,
-						   parms.height * globals::worldsize,
-						   (-0.5 + parms.radius * cos(camrad)) * globals::worldsize );
+	camera.settranslation( (0.5 + parms.radius * sin(camrad)) * globals::worldsize(),
+						   parms.height * globals::worldsize(),
+						   (-0.5 + parms.radius * cos(camrad)) * globals::worldsize() );
 }
 
 void CameraController::setAgentTrackingTarget()
@@ -90,7 +90,7 @@ void CameraController::setAgentTrackingTarget()
 		{
 		case AgentTrackingParms::OVERHEAD:
 			camera.SetRotation( 0.0, -90, 0.0 );
-			camera.settranslation( target->x(), 0.2 * globals::worldsize, target->z() );
+			camera.settranslation( target->x(), 0.2 * globals::worldsize(), target->z() );
 			break;
 		case AgentTrackingParms::POV:
 			{
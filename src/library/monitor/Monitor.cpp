@@ -1,13 +1,21 @@
 #include "Monitor.h"
 
+#include <stdlib.h>
+
+#include <chrono>
 #include <iostream>
-#include <sstream>
 
 #include "AgentTracker.h"
 #include "CameraController.h"
 #include "MovieController.h"
 #include "SceneRenderer.h"
+#include "WorldSnapshot.h"
+#include "agent/agent.h"
+#include "logs/Logs.h"
 #include "sim/Simulation.h"
+#include "sim/SimulationContext.h"
+#include "sim/StatusLog.h"
+#include "utils/MetricsSegment.h"
 #include "utils/objectxsortedlist.h"
 
 //===========================================================================
@@ -218,11 +226,21 @@ void PopulationMonitor::step( long timestep )
 //===========================================================================
 // BrainMonitor
 //===========================================================================
-BrainMonitor::BrainMonitor( TSimulation *_sim, int _frequency, AgentTracker *_tracker )
+BrainMonitor::BrainMonitor( TSimulation *_sim,
+							int _frequency,
+							AgentTracker *_tracker,
+							WorldSnapshotBuffer *_snapshots )
 	: Monitor(BRAIN, _sim, "brainmonitor", "Brain Monitor", "Brain Monitor")
 	, frequency(_frequency)
 	, tracker(_tracker)
+	, snapshots(_snapshots)
+{
+	snapshots->addConsumer();
+}
+
+BrainMonitor::~BrainMonitor()
 {
+	snapshots->removeConsumer();
 }
 
 AgentTracker *BrainMonitor::getTracker()
@@ -230,6 +248,11 @@ AgentTracker *BrainMonitor::getTracker()
 	return tracker;
 }
 
+WorldSnapshotBuffer *BrainMonitor::getSnapshots()
+{
+	return snapshots;
+}
+
 void BrainMonitor::step( long timestep )
 {
 	if( (timestep % frequency) == 0 )
@@ -260,16 +283,36 @@ void PovMonitor::step( long timestep )
 StatusTextMonitor::StatusTextMonitor( TSimulation *_sim,
 									  int _frequencyDisplay,
 									  int _frequencyStore,
-									  bool _storePerformance )
+									  bool _storePerformance,
+									  bool _storeBinary )
 	: Monitor(STATUS_TEXT, _sim, "textstatus", "Text Status", "Text Status")
+	, statusTextStale( false )
+	, statusLog( _storeBinary ? new StatusLog(SimulationContext::runPath("stats/status.bin")) : NULL )
 	, frequencyDisplay( _frequencyDisplay )
 	, frequencyStore( _frequencyStore )
 	, storePerformance( _storePerformance )
 {
 }
 
+StatusTextMonitor::~StatusTextMonitor()
+{
+	delete statusLog;
+}
+
+const StatusSnapshot &StatusTextMonitor::getStatus()
+{
+	return status;
+}
+
 StatusText &StatusTextMonitor::getStatusText()
 {
+	if( statusTextStale )
+	{
+		statusText.clear();
+		status.render( statusText );
+		statusTextStale = false;
+	}
+
 	return statusText;
 }
 
@@ -283,13 +326,8 @@ void StatusTextMonitor::step( long timestep )
 
 	if( doDisplay || doStore )
 	{
-		itfor( StatusText, statusText, it )
-		{
-			free( *it );
-		}
-		statusText.clear();
-
-		getSimulation()->getStatusText( statusText, frequencyStore );
+		getSimulation()->getStatus( status, frequencyStore );
+		statusTextStale = true;
 
 		if( doDisplay )
 		{
@@ -300,21 +338,21 @@ void StatusTextMonitor::step( long timestep )
 		{
 			char statusFileName[256];
 		
-            sprintf( statusFileName, "run/stats/stat.%ld", timestep );
+            sprintf( statusFileName, "%s/stats/stat.%ld", SimulationContext::runDir(), timestep );
 			makeParentDir( statusFileName );
 
 			FILE *statusFile = fopen( statusFileName, "w" );
 			ERRIF( statusFile == nullptr, "Failed opening %s", statusFileName );
 
-			StatusText::const_iterator iter = statusText.begin();
-			for( ; iter != statusText.end(); ++iter )
-			{
-				// filter out performance stats
-				if( storePerformance || (0 != strncmp( *iter, "Rate", 4 )) )
-					fprintf( statusFile, "%s\n", *iter );
-			}
+			StatusText storeText;
+			status.render( storeText, storePerformance );
+			for( const std::string &line : storeText )
+				fprintf( statusFile, "%s\n", line.c_str() );
 
 			fclose( statusFile );
+
+			if( statusLog )
+				statusLog->write( status );
 		}
 	}
 }
@@ -348,6 +386,11 @@ FarmMonitor::FarmMonitor( TSimulation *sim,
 				break;
 			}
 		}
+
+		// Farm scripts poll these through the metrics segment (pwmetrics --farm)
+		// rather than being told by a PWFARM_STATUS shell per update.
+		_gauges.push_back( &sim->getMetrics().gauge("polyworld_farm_" + it->title,
+													"Farm status property " + it->name + ".") );
 	}
 }
 
@@ -355,30 +398,87 @@ void FarmMonitor::step( long timestep )
 {
 	if( (timestep == 1) || (timestep % _frequency == 0) )
 	{
-        std::stringstream cmd;
-
-		cmd << "bash -c 'PWFARM_STATUS Polyworld \"[";
-
-		bool first = true;
-        itfor( std::vector<Property>, _properties, it )
+		for( size_t i = 0; i < _properties.size(); i++ )
 		{
-			if( it->metadata )
+			proplib::CppProperties::PropertyMetadata *metadata = _properties[i].metadata;
+			if( !metadata )
+				continue;
+
+			switch( metadata->valueType )
 			{
-				if( !first )
-				{
-					cmd << " ";
-				}
-				else
-					first = false;
-
-				cmd << it->title << "=" << it->metadata->toString();
+			case datalib::INT:
+				_gauges[i]->set( *(int *)metadata->value );
+				break;
+			case datalib::FLOAT:
+				_gauges[i]->set( *(float *)metadata->value );
+				break;
+			case datalib::BOOL:
+				_gauges[i]->set( *(bool *)metadata->value ? 1 : 0 );
+				break;
+			default:
+				assert( false );
+				break;
 			}
 		}
+	}
+}
 
-		cmd << "]\"'";
+//===========================================================================
+// MetricsMonitor
+//===========================================================================
+#define METRICS_PATH SimulationContext::runPath( "metrics" )
 
-		int rc = system( cmd.str().c_str() );
-        if( rc ) std::cerr << "Failed executing PWFARM_STATUS" << std::endl;
+MetricsMonitor::MetricsMonitor( TSimulation *sim, int frequency )
+: Monitor(METRICS, sim, "metrics", "Metrics", "Metrics")
+, frequency( frequency )
+, prevTime( 0.0 )
+{
+	makeParentDir( METRICS_PATH );
+	segment = new MetricsSegment( METRICS_PATH );
+
+	Metrics &metrics = sim->getMetrics();
+
+	simStep = &metrics.gauge( "polyworld_step", "Current simulation step." );
+	agents = &metrics.gauge( "polyworld_agents", "Agents alive." );
+	food = &metrics.gauge( "polyworld_food", "Food pieces in the world." );
+	foodEnergy = &metrics.gauge( "polyworld_food_energy", "Energy summed over all food pieces." );
+	births = &metrics.counter( "polyworld_births_total", "Agents born of two parents." );
+	created = &metrics.counter( "polyworld_created_total", "Agents created without parents." );
+	deaths = &metrics.counter( "polyworld_deaths_total", "Agents that have died." );
+	agentsAllocated = &metrics.counter( "polyworld_agents_allocated_total", "Agent objects allocated; other agents reuse dead ones." );
+	stepsPerSecond = &metrics.gauge( "polyworld_steps_per_second", "Recent simulation rate." );
+	stepSeconds = &metrics.histogram( "polyworld_step_seconds",
+									  "Wall-clock time between consecutive steps.",
+									  {0.001, 0.0025, 0.005, 0.01, 0.025, 0.05, 0.1, 0.25, 0.5, 1, 2.5} );
+	logEvents = &metrics.counter( "polyworld_log_events_total", "Events delivered to loggers." );
+}
+
+MetricsMonitor::~MetricsMonitor()
+{
+	delete segment;
+}
+
+void MetricsMonitor::step( long timestep )
+{
+	double now = std::chrono::duration<double>( std::chrono::steady_clock::now().time_since_epoch() ).count();
+	if( prevTime > 0.0 )
+		stepSeconds->observe( now - prevTime );
+	prevTime = now;
+
+	if( (timestep == 1) || (timestep % frequency == 0) )
+	{
+		simStep->set( timestep );
+		agents->set( sim->getNumAgents() );
+		food->set( objectxsortedlist::gXSortedObjects().getCount(FOODTYPE) );
+		foodEnergy->set( sim->getFoodEnergy() );
+		births->set( sim->getNumBorn(ABT__BORN) );
+		created->set( sim->getNumBorn(ABT__CREATED) );
+		deaths->set( sim->getNumDied() );
+		agentsAllocated->set( agent::getAgentsAllocated() );
+		stepsPerSecond->set( sim->fFramesPerSecondRecent );
+		logEvents->set( Logs::current()->getEventCount() );
+
+		segment->publish( sim->getMetrics().expose() );
 	}
 }
 
@@ -8,7 +8,9 @@
 #include "proplib/proplib.h"
 #include "sim/simconst.h"
 #include "sim/simtypes.h"
+#include "sim/StatusSnapshot.h"
 #include "utils/datalib.h"
+#include "utils/Metrics.h"
 #include "utils/Signal.h"
 #include "library_global.h"
 
@@ -25,6 +27,7 @@ class LIBRARY_SHARED Monitor
 		POV,
 		STATUS_TEXT,
 		FARM,
+		METRICS,
 		SCENE
 	};
 
@@ -150,9 +153,15 @@ class PopulationMonitor : public ChartMonitor
 class LIBRARY_SHARED BrainMonitor : public Monitor
 {
  public:
-	BrainMonitor( class TSimulation *_sim, int _frequency, class AgentTracker *_tracker );
+	BrainMonitor( class TSimulation *_sim,
+				  int _frequency,
+				  class AgentTracker *_tracker,
+				  class WorldSnapshotBuffer *_snapshots );
+	virtual ~BrainMonitor();
 
 	class AgentTracker *getTracker();
+	// The tracked agent's retina and activations as of the last step.
+	class WorldSnapshotBuffer *getSnapshots();
 
 	virtual void step( long timestep );
 
@@ -161,6 +170,7 @@ class LIBRARY_SHARED BrainMonitor : public Monitor
  private:
 	int frequency;
 	class AgentTracker *tracker;
+	class WorldSnapshotBuffer *snapshots;
 };
 
 //===========================================================================
@@ -185,8 +195,13 @@ class LIBRARY_SHARED StatusTextMonitor : public Monitor
 	StatusTextMonitor( class TSimulation *sim,
 					   int frequencyDisplay,
 					   int frequencyStore,
-					   bool storePerformance );
+					   bool storePerformance,
+					   bool storeBinary );
+	virtual ~StatusTextMonitor();
 
+	// Status as of the last update.
+	const StatusSnapshot &getStatus();
+	// The status rendered as text, on first request after an update.
 	sim::StatusText &getStatusText();
 
 	virtual void step( long timestep );
@@ -194,7 +209,10 @@ class LIBRARY_SHARED StatusTextMonitor : public Monitor
     util::Signal<> update;
 
  private:
+	StatusSnapshot status;
 	sim::StatusText statusText;
+	bool statusTextStale;
+	class StatusLog *statusLog;
 	int frequencyDisplay;
 	int frequencyStore;
 	bool storePerformance;
@@ -227,6 +245,39 @@ class FarmMonitor : public Monitor
  private:
 	int _frequency;
 	std::vector<Property> _properties;
+	std::vector<Metrics::Gauge *> _gauges;
+};
+
+//===========================================================================
+// MetricsMonitor
+//
+// Samples the simulation into its Metrics registry and publishes the
+// result through a MetricsSegment at run/metrics.
+//===========================================================================
+class MetricsMonitor : public Monitor
+{
+ public:
+	MetricsMonitor( class TSimulation *sim, int frequency );
+	virtual ~MetricsMonitor();
+
+	virtual void step( long timestep );
+
+ private:
+	int frequency;
+	class MetricsSegment *segment;
+	double prevTime;
+
+	Metrics::Gauge *simStep;
+	Metrics::Gauge *agents;
+	Metrics::Gauge *food;
+	Metrics::Gauge *foodEnergy;
+	Metrics::Counter *births;
+	Metrics::Counter *created;
+	Metrics::Counter *deaths;
+	Metrics::Counter *agentsAllocated;
+	Metrics::Gauge *stepsPerSecond;
+	Metrics::Histogram *stepSeconds;
+	Metrics::Counter *logEvents;
 };
 
 //===========================================================================
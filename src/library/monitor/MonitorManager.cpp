@@ -7,9 +7,11 @@
 #include "CameraController.h"
 #include "Monitor.h"
 #include "SceneRenderer.h"
+#include "WorldSnapshot.h"
 #include "proplib/proplib.h"
 #include "sim/globals.h"
 #include "sim/Simulation.h"
+#include "sim/SimulationContext.h"
 #include "utils/Resources.h"
 
 //===========================================================================
@@ -19,6 +21,7 @@
 MonitorManager::MonitorManager( TSimulation *_simulation,
                                 std::string monitorPath )
 	: simulation( _simulation )
+	, snapshots( new WorldSnapshotBuffer() )
 {
 	proplib::DocumentBuilder builder;
     proplib::SchemaDocument *pschema = builder.buildSchemaDocument( "./etc/monitors.mfs" );
@@ -90,7 +93,7 @@ MonitorManager::MonitorManager( TSimulation *_simulation,
         std::string trackerName = doc.get( "Brain" ).get( "AgentTracker" );
 		AgentTracker *tracker = findAgentTracker( trackerName );
 
-		addMonitor( new BrainMonitor(simulation, frequency, tracker) );
+		addMonitor( new BrainMonitor(simulation, frequency, tracker, snapshots) );
 	}
 
 
@@ -110,13 +113,15 @@ MonitorManager::MonitorManager( TSimulation *_simulation,
 		addMonitor( new StatusTextMonitor(simulation,
 										  doc.get("StatusText").get("FrequencyDisplay"),
 										  doc.get("StatusText").get("FrequencyStore"),
-										  doc.get("StatusText").get("StorePerformance")) );
+										  doc.get("StatusText").get("StorePerformance"),
+										  doc.get("StatusText").get("StoreBinary")) );
 	}
 
 	// ---
 	// --- Farm
 	// ---
-	if( FarmMonitor::isFarmEnv() && (bool)doc.get("Farm").get("Enabled") )
+	bool farm = FarmMonitor::isFarmEnv() && (bool)doc.get("Farm").get("Enabled");
+	if( farm )
 	{
         std::vector<FarmMonitor::Property> properties;
 
@@ -131,6 +136,20 @@ MonitorManager::MonitorManager( TSimulation *_simulation,
 									properties) );
 	}
 
+	// ---
+	// --- Metrics
+	// ---
+	// The farm reads its status from the metrics, so it forces them on. Added
+	// after the farm monitor so they publish its latest values.
+	if( farm || (bool)doc.get("Metrics").get("Enabled") )
+	{
+		int frequency = doc.get("Metrics").get("Enabled")
+			? doc.get("Metrics").get("Frequency")
+			: doc.get("Farm").get("Frequency");
+
+		addMonitor( new MetricsMonitor(simulation, frequency) );
+	}
+
 	// ---
 	// --- Scenes
 	// ---
@@ -189,6 +208,7 @@ MonitorManager::MonitorManager( TSimulation *_simulation,
 			// --- Construct Renderer
 			// ---
             SceneRenderer *renderer = SceneRenderer::create( simulation->getStage(),
+                                                             *snapshots,
                                                              cameraProperties,
                                                              bufferWidth,
                                                              bufferHeight );
@@ -228,9 +248,9 @@ MonitorManager::MonitorManager( TSimulation *_simulation,
 																		   height,
 																		   rate,
 																		   angleStart,
-																		   fixX * globals::worldsize,
+																		   fixX * globals::worldsize(),
 																		   fixY,
-																		   -1 * fixZ * globals::worldsize );
+																		   -1 * fixZ * globals::worldsize() );
 							cameraController->initRotation( rotationParms );
 						}
 						else if( mode == "AgentTracking" )
@@ -279,7 +299,7 @@ MonitorManager::MonitorManager( TSimulation *_simulation,
 			// --- Movie Settings
 			// ---
 			bool recordMovie = propScene.get( "Movie" ).get( "Record" );
-            std::string moviePath = std::string("run/") + (std::string)propScene.get( "Movie" ).get( "Path" );
+            std::string moviePath = SimulationContext::runPath( propScene.get( "Movie" ).get( "Path" ) );
 			int sampleFrequency = propScene.get( "Movie" ).get( "SampleFrequency" );
 			int sampleDuration = propScene.get( "Movie" ).get( "SampleDuration" );
 
@@ -317,6 +337,8 @@ MonitorManager::~MonitorManager()
 	{
 		delete *it;
 	}
+
+	delete snapshots;
 }
 
 const Monitors &MonitorManager::getMonitors()
@@ -343,6 +365,11 @@ AgentTracker *MonitorManager::findAgentTracker( std::string name )
 	exit( 1 );
 }
 
+WorldSnapshotBuffer &MonitorManager::getSnapshots()
+{
+	return *snapshots;
+}
+
 void MonitorManager::step()
 {
 	itfor( AgentTrackers, agentTrackers, it )
@@ -367,6 +394,12 @@ void MonitorManager::step()
 		}
 	}
 
+	if( snapshots->hasConsumers() )
+	{
+		snapshots->beginWrite().capture( simulation->getStep(), simulation->getStage(), agentTrackers );
+		snapshots->publish();
+	}
+
 	itfor( Monitors, monitors, it )
 	{
 		(*it)->step( simulation->getStep() );
@@ -18,6 +18,7 @@ class LIBRARY_SHARED MonitorManager
 	const Monitors &getMonitors();
 	const AgentTrackers &getAgentTrackers();
 	class AgentTracker *findAgentTracker( std::string name );
+	class WorldSnapshotBuffer &getSnapshots();
 
 	void step();
 
@@ -30,4 +31,5 @@ class LIBRARY_SHARED MonitorManager
 	class TSimulation *simulation;
 	Monitors monitors;
 	AgentTrackers agentTrackers;
+	class WorldSnapshotBuffer *snapshots;
 };
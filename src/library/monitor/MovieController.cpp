@@ -25,7 +25,8 @@ SceneMovieController::SceneMovieController( SceneRenderer *_renderer,
 		exit( 1 );
 	}
 
-	writer = new PwMovieWriter( f );
+	// Encode on a background thread so recording doesn't stall the step.
+	writer = new PwMovieWriter( f, true );
 }
 
 SceneMovieController::~SceneMovieController()
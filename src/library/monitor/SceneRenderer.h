@@ -19,7 +19,10 @@ class LIBRARY_SHARED SceneRenderer
 		float fov;
 	};
 
+    // Renderers that draw off the simulation thread read the stage through
+    // snapshots instead of directly.
     static SceneRenderer LIBRARY_SHARED *create(gstage &stage,
+                                 class WorldSnapshotBuffer &snapshots,
                                  const CameraProperties &cameraProps,
                                  int width,
                                  int height);
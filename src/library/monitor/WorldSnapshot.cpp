@@ -0,0 +1,279 @@
+#include "WorldSnapshot.h"
+
+#include <assert.h>
+
+#include "AgentTracker.h"
+#include "agent/agent.h"
+#include "agent/Retina.h"
+#include "brain/Brain.h"
+#include "environment/barrier.h"
+#include "graphics/gpolygon.h"
+#include "graphics/gsquare.h"
+#include "graphics/gstage.h"
+#include "utils/misc.h"
+
+//===========================================================================
+// WorldSnapshot
+//===========================================================================
+
+//---------------------------------------------------------------------------
+// WorldSnapshot::capture
+//---------------------------------------------------------------------------
+void WorldSnapshot::capture( long step_, gstage &stage, const AgentTrackers &trackers )
+{
+	step = step_;
+
+	objects.clear();
+	polygons.clear();
+	vertices.clear();
+
+	captureList( stage.GetSet() );
+	captureList( stage.GetProps() );
+	captureList( stage.GetCast() );
+
+	trackedAgents.resize( trackers.size() );
+
+	size_t i = 0;
+	citfor( AgentTrackers, trackers, it )
+	{
+		TrackedAgent &tracked = trackedAgents[i++];
+		agent *a = (*it)->getTarget();
+
+		tracked.tracker = *it;
+		tracked.number = a ? a->Number() : 0;
+		tracked.retina.clear();
+		tracked.activations.clear();
+
+		if( a == NULL )
+			continue;
+
+		const unsigned char *retina = a->GetRetina()->getBuffer();
+		tracked.retina.assign( retina, retina + 4 * Brain::config().retinaWidth );
+
+		Brain *brain = a->GetBrain();
+		if( brain )
+		{
+			tracked.activations.resize( brain->getNumNeurons() );
+			brain->getActivations( tracked.activations.data(), 0, brain->getNumNeurons() );
+		}
+	}
+}
+
+//---------------------------------------------------------------------------
+// WorldSnapshot::findTrackedAgent
+//---------------------------------------------------------------------------
+const WorldSnapshot::TrackedAgent *WorldSnapshot::findTrackedAgent( const AgentTracker *tracker ) const
+{
+	for( const TrackedAgent &tracked : trackedAgents )
+	{
+		if( tracked.tracker == tracker )
+			return tracked.number ? &tracked : NULL;
+	}
+
+	return NULL;
+}
+
+//---------------------------------------------------------------------------
+// WorldSnapshot::captureList
+//---------------------------------------------------------------------------
+void WorldSnapshot::captureList( TGraphicObjectList *list )
+{
+	if( list == NULL )
+		return;
+
+	for( gobject *obj : *list )
+		captureObject( obj );
+}
+
+//---------------------------------------------------------------------------
+// WorldSnapshot::captureObject
+//---------------------------------------------------------------------------
+void WorldSnapshot::captureObject( gobject *obj )
+{
+	Object o;
+	o.outlineTop = false;
+	o.number = 0;
+	o.position[0] = obj->x();
+	o.position[1] = obj->y();
+	o.position[2] = obj->z();
+	o.angles[0] = obj->getyaw();
+	o.angles[1] = obj->getpitch();
+	o.angles[2] = obj->getroll();
+	o.scale = obj->getscale();
+	o.size[0] = o.size[1] = o.size[2] = 1.0;
+	o.colors[0][0] = o.colors[1][0] = obj->GetRed();
+	o.colors[0][1] = o.colors[1][1] = obj->GetGreen();
+	o.colors[0][2] = o.colors[1][2] = obj->GetBlue();
+	o.firstPolygon = polygons.size();
+	o.polygonCount = 0;
+
+	if( agent *a = dynamic_cast<agent *>(obj) )
+	{
+		// Agents carry a copy of agentobj stretched to their dimensions; see
+		// agent::SetGeometry().
+		o.shape = AGENT;
+		o.number = a->Number();
+		o.size[0] = a->LengthX();
+		o.size[1] = agent::config().agentHeight;
+		o.size[2] = a->LengthZ();
+
+		if( agent::config().noseColor != agent::NC_BODY )
+		{
+			const float *nose = a->GetNoseColor();
+			o.colors[1][0] = nose[0];
+			o.colors[1][1] = nose[1];
+			o.colors[1][2] = nose[2];
+		}
+	}
+	else if( gbox *box = dynamic_cast<gbox *>(obj) )
+	{
+		o.shape = BOX;
+		o.size[0] = box->lx();
+		o.size[1] = box->ly();
+		o.size[2] = box->lz();
+	}
+	else if( gpolyobj *polyobj = dynamic_cast<gpolyobj *>(obj) )
+	{
+		o.shape = POLYGONS;
+		for( long i = 0; i < polyobj->numPolygons(); i++ )
+		{
+			const opoly &poly = polyobj->polygon( i );
+			addPolygon( poly.fVertices, poly.fNumPoints );
+		}
+	}
+	else if( gpoly *poly = dynamic_cast<gpoly *>(obj) )
+	{
+		o.shape = POLYGONS;
+		o.outlineTop = dynamic_cast<barrier *>(obj) != NULL;
+		addPolygon( poly->vertices(), poly->numPoints() );
+	}
+	else
+	{
+		return;
+	}
+
+	o.polygonCount = polygons.size() - o.firstPolygon;
+	objects.push_back( o );
+}
+
+//---------------------------------------------------------------------------
+// WorldSnapshot::addPolygon
+//---------------------------------------------------------------------------
+void WorldSnapshot::addPolygon( const float *v, long n )
+{
+	Polygon polygon = { (uint32_t)vertices.size() / 3, (uint32_t)n };
+
+	vertices.insert( vertices.end(), v, v + 3 * n );
+	polygons.push_back( polygon );
+}
+
+//===========================================================================
+// WorldSnapshotBuffer
+//===========================================================================
+
+//---------------------------------------------------------------------------
+// WorldSnapshotBuffer::WorldSnapshotBuffer
+//---------------------------------------------------------------------------
+WorldSnapshotBuffer::WorldSnapshotBuffer()
+	: back( NULL )
+	, consumers( 0 )
+{
+}
+
+//---------------------------------------------------------------------------
+// WorldSnapshotBuffer::~WorldSnapshotBuffer
+//
+// Every consumer must have let go of its references by now.
+//---------------------------------------------------------------------------
+WorldSnapshotBuffer::~WorldSnapshotBuffer()
+{
+	front.reset();
+
+	delete back;
+	for( WorldSnapshot *snapshot : spares )
+		delete snapshot;
+}
+
+//---------------------------------------------------------------------------
+// WorldSnapshotBuffer::addConsumer
+//---------------------------------------------------------------------------
+void WorldSnapshotBuffer::addConsumer()
+{
+	consumers++;
+}
+
+//---------------------------------------------------------------------------
+// WorldSnapshotBuffer::removeConsumer
+//---------------------------------------------------------------------------
+void WorldSnapshotBuffer::removeConsumer()
+{
+	assert( consumers > 0 );
+	consumers--;
+}
+
+//---------------------------------------------------------------------------
+// WorldSnapshotBuffer::hasConsumers
+//---------------------------------------------------------------------------
+bool WorldSnapshotBuffer::hasConsumers()
+{
+	return consumers > 0;
+}
+
+//---------------------------------------------------------------------------
+// WorldSnapshotBuffer::beginWrite
+//---------------------------------------------------------------------------
+WorldSnapshot &WorldSnapshotBuffer::beginWrite()
+{
+	if( back == NULL )
+	{
+		std::lock_guard<std::mutex> lock( mutex );
+		if( spares.empty() )
+		{
+			back = new WorldSnapshot();
+		}
+		else
+		{
+			back = spares.back();
+			spares.pop_back();
+		}
+	}
+
+	return *back;
+}
+
+//---------------------------------------------------------------------------
+// WorldSnapshotBuffer::publish
+//
+// The previous front buffer goes back to the spares when its last reference
+// is dropped, which may be right here.
+//---------------------------------------------------------------------------
+void WorldSnapshotBuffer::publish()
+{
+	assert( back );
+
+	std::shared_ptr<WorldSnapshot> published( back, [this]( WorldSnapshot *snapshot ) { release(snapshot); } );
+	back = NULL;
+
+	{
+		std::lock_guard<std::mutex> lock( mutex );
+		front.swap( published );
+	}
+}
+
+//---------------------------------------------------------------------------
+// WorldSnapshotBuffer::acquire
+//---------------------------------------------------------------------------
+WorldSnapshotBuffer::Ref WorldSnapshotBuffer::acquire()
+{
+	std::lock_guard<std::mutex> lock( mutex );
+	return front;
+}
+
+//---------------------------------------------------------------------------
+// WorldSnapshotBuffer::release
+//---------------------------------------------------------------------------
+void WorldSnapshotBuffer::release( WorldSnapshot *snapshot )
+{
+	std::lock_guard<std::mutex> lock( mutex );
+	spares.push_back( snapshot );
+}
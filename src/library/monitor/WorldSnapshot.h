@@ -0,0 +1,115 @@
+#pragma once
+
+#include <stdint.h>
+
+#include <memory>
+#include <mutex>
+#include <vector>
+
+#include "MonitorManager.h"
+#include "library_global.h"
+
+//===========================================================================
+// WorldSnapshot
+//
+// Flat copy of everything the monitors draw, taken once at the end of a
+// step. Consumers read it instead of the live gobjects and agents, so they
+// can draw on their own thread while the simulation moves on.
+//===========================================================================
+class LIBRARY_SHARED WorldSnapshot
+{
+ public:
+	enum Shape
+	{
+		AGENT,		// agent::GetAgentObj() stretched by size
+		BOX,		// unit cube stretched by size
+		POLYGONS	// polygons[firstPolygon, firstPolygon + polygonCount)
+	};
+
+	struct Object
+	{
+		uint8_t shape;
+		// Barriers outline the top edge of their polygon.
+		bool outlineTop;
+		long number;
+		float position[3];
+		// yaw, pitch, roll in degrees, as gobject.
+		float angles[3];
+		float scale;
+		float size[3];
+		// Body color, then nose color for agents.
+		float colors[2][3];
+		uint32_t firstPolygon;
+		uint32_t polygonCount;
+	};
+
+	// Vertices in object space.
+	struct Polygon
+	{
+		uint32_t firstVertex;
+		uint32_t vertexCount;
+	};
+
+	struct TrackedAgent
+	{
+		const class AgentTracker *tracker;
+		// 0 when the tracker has no target.
+		long number;
+		// RGBA, Brain::config().retinaWidth pixels.
+		std::vector<unsigned char> retina;
+		std::vector<double> activations;
+	};
+
+	void capture( long step, class gstage &stage, const AgentTrackers &trackers );
+
+	const TrackedAgent *findTrackedAgent( const class AgentTracker *tracker ) const;
+
+	long step;
+	std::vector<Object> objects;
+	std::vector<Polygon> polygons;
+	std::vector<float> vertices;
+	std::vector<TrackedAgent> trackedAgents;
+
+ private:
+	void captureList( class TGraphicObjectList *list );
+	void captureObject( class gobject *obj );
+	void addPolygon( const float *v, long n );
+};
+
+//===========================================================================
+// WorldSnapshotBuffer
+//
+// Double-buffered WorldSnapshots. The simulation thread fills the back buffer
+// and publishes it; readers on any thread acquire the latest one and keep it
+// for as long as they hold the reference. The writer never waits on a reader:
+// a snapshot still held when it's needed again is replaced by a spare, and
+// returns to the spares once the last reference goes.
+//===========================================================================
+class LIBRARY_SHARED WorldSnapshotBuffer
+{
+ public:
+	typedef std::shared_ptr<const WorldSnapshot> Ref;
+
+	WorldSnapshotBuffer();
+	~WorldSnapshotBuffer();
+
+	// Snapshots are only taken while something consumes them.
+	void addConsumer();
+	void removeConsumer();
+	bool hasConsumers();
+
+	WorldSnapshot &beginWrite();
+	void publish();
+
+	// Latest published snapshot, or NULL before the first.
+	Ref acquire();
+
+ private:
+	void release( WorldSnapshot *snapshot );
+
+	std::mutex mutex;
+	std::shared_ptr<WorldSnapshot> front;
+	WorldSnapshot *back;
+	std::vector<WorldSnapshot *> spares;
+	int consumers;
+};
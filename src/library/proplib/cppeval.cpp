@@ -0,0 +1,875 @@
+#include "cppeval.h"
+
+#include <assert.h>
+#include <ctype.h>
+#include <math.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "utils/misc.h"
+
+using namespace proplib;
+
+namespace proplib
+{
+	// ----------------------------------------------------------------------
+	// ----------------------------------------------------------------------
+	// --- Evaluation Tree
+	// ---
+	// --- Bool and Int values live in i, Float and Double values in d. Float
+	// --- results are rounded to float after every operation, as they are in
+	// --- the compiled code.
+	// ----------------------------------------------------------------------
+	// ----------------------------------------------------------------------
+	union __CppEvalValue
+	{
+		long i;
+		double d;
+	};
+
+	class __CppEvalNode
+	{
+	public:
+		__CppEvalNode( CppEvaluator::Type type_ ) : type( type_ ) {}
+		virtual ~__CppEvalNode() {}
+
+		virtual __CppEvalValue eval() = 0;
+
+		CppEvaluator::Type type;
+	};
+
+	class __CppEvalStatement : public __CppEvalNode
+	{
+	public:
+		__CppEvalStatement() : __CppEvalNode( CppEvaluator::Invalid ) {}
+
+		virtual __CppEvalValue eval() { assert( false ); __CppEvalValue v; v.i = 0; return v; }
+
+		// Returns true if a return statement was executed.
+		virtual bool exec( __CppEvalValue &result ) = 0;
+	};
+
+	class __CppEvalSlot : public __CppEvalNode
+	{
+	public:
+		__CppEvalSlot( CppEvaluator::Type type, int index_ ) : __CppEvalNode( type ), index( index_ ), addr( NULL ) {}
+
+		virtual __CppEvalValue eval()
+		{
+			__CppEvalValue v;
+			switch( type )
+			{
+			case CppEvaluator::Bool: v.i = *(bool *)addr; break;
+			case CppEvaluator::Int: v.i = *(int *)addr; break;
+			case CppEvaluator::Float: v.d = *(float *)addr; break;
+			case CppEvaluator::Double: v.d = *(double *)addr; break;
+			default: assert( false );
+			}
+			return v;
+		}
+
+		int index;
+		void *addr;
+	};
+}
+
+namespace
+{
+	typedef CppEvaluator::Type Type;
+	typedef __CppEvalValue Value;
+	typedef __CppEvalNode Node;
+	typedef __CppEvalStatement Statement;
+
+	inline bool isIntegral( Type type )
+	{
+		return (type == CppEvaluator::Bool) || (type == CppEvaluator::Int);
+	}
+
+	// Usual arithmetic conversions; bool is promoted to int.
+	Type promote( Type a, Type b )
+	{
+		if( (a == CppEvaluator::Double) || (b == CppEvaluator::Double) )
+			return CppEvaluator::Double;
+		if( (a == CppEvaluator::Float) || (b == CppEvaluator::Float) )
+			return CppEvaluator::Float;
+		return CppEvaluator::Int;
+	}
+
+	class Constant : public Node
+	{
+	public:
+		Constant( Type type, Value value_ ) : Node( type ), value( value_ ) {}
+		virtual Value eval() { return value; }
+		Value value;
+	};
+
+	class Convert : public Node
+	{
+	public:
+		Convert( Type type, Node *from_ ) : Node( type ), from( from_ ) {}
+
+		virtual Value eval()
+		{
+			Value in = from->eval();
+			Value out;
+			if( isIntegral(from->type) )
+			{
+				switch( type )
+				{
+				case CppEvaluator::Bool: out.i = in.i != 0; break;
+				case CppEvaluator::Int: out.i = (int)in.i; break;
+				case CppEvaluator::Float: out.d = (float)in.i; break;
+				case CppEvaluator::Double: out.d = (double)in.i; break;
+				default: assert( false );
+				}
+			}
+			else
+			{
+				switch( type )
+				{
+				case CppEvaluator::Bool: out.i = in.d != 0; break;
+				case CppEvaluator::Int: out.i = (int)in.d; break;
+				case CppEvaluator::Float: out.d = (float)in.d; break;
+				case CppEvaluator::Double: out.d = in.d; break;
+				default: assert( false );
+				}
+			}
+			return out;
+		}
+
+		Node *from;
+	};
+
+	class Negate : public Node
+	{
+	public:
+		Negate( Node *operand_ ) : Node( operand_->type ), operand( operand_ ) {}
+
+		virtual Value eval()
+		{
+			Value v = operand->eval();
+			if( isIntegral(type) )
+				v.i = (int)-v.i;
+			else
+				v.d = -v.d;
+			return v;
+		}
+
+		Node *operand;
+	};
+
+	class Not : public Node
+	{
+	public:
+		Not( Node *operand_ ) : Node( CppEvaluator::Bool ), operand( operand_ ) {}
+
+		virtual Value eval()
+		{
+			Value v = operand->eval();
+			v.i = !v.i;
+			return v;
+		}
+
+		Node *operand;
+	};
+
+	// Operands have already been converted to the operation's type.
+	class Arithmetic : public Node
+	{
+	public:
+		Arithmetic( char op_, Node *lhs_, Node *rhs_ ) : Node( lhs_->type ), op( op_ ), lhs( lhs_ ), rhs( rhs_ ) {}
+
+		virtual Value eval()
+		{
+			Value a = lhs->eval();
+			Value b = rhs->eval();
+			Value v;
+			if( type == CppEvaluator::Int )
+			{
+				switch( op )
+				{
+				case '+': v.i = (int)(a.i + b.i); break;
+				case '-': v.i = (int)(a.i - b.i); break;
+				case '*': v.i = (int)(a.i * b.i); break;
+				case '/':
+					ERRIF( b.i == 0, "Integer division by zero in dynamic property." );
+					v.i = a.i / b.i;
+					break;
+				case '%':
+					ERRIF( b.i == 0, "Integer division by zero in dynamic property." );
+					v.i = a.i % b.i;
+					break;
+				default: assert( false );
+				}
+			}
+			else
+			{
+				switch( op )
+				{
+				case '+': v.d = a.d + b.d; break;
+				case '-': v.d = a.d - b.d; break;
+				case '*': v.d = a.d * b.d; break;
+				case '/': v.d = a.d / b.d; break;
+				default: assert( false );
+				}
+				if( type == CppEvaluator::Float )
+					v.d = (float)v.d;
+			}
+			return v;
+		}
+
+		char op;
+		Node *lhs;
+		Node *rhs;
+	};
+
+	// Operands have already been converted to a common type.
+	class Compare : public Node
+	{
+	public:
+		Compare( const std::string &op_, Node *lhs_, Node *rhs_ ) : Node( CppEvaluator::Bool ), op( op_ ), lhs( lhs_ ), rhs( rhs_ ) {}
+
+		virtual Value eval()
+		{
+			Value a = lhs->eval();
+			Value b = rhs->eval();
+			Value v;
+			if( isIntegral(lhs->type) )
+				v.i = compare( a.i, b.i );
+			else
+				v.i = compare( a.d, b.d );
+			return v;
+		}
+
+		template<typename T>
+		bool compare( T a, T b )
+		{
+			if( op == "<" ) return a < b;
+			if( op == "<=" ) return a <= b;
+			if( op == ">" ) return a > b;
+			if( op == ">=" ) return a >= b;
+			if( op == "==" ) return a == b;
+			return a != b;
+		}
+
+		std::string op;
+		Node *lhs;
+		Node *rhs;
+	};
+
+	class Logical : public Node
+	{
+	public:
+		Logical( bool isAnd_, Node *lhs_, Node *rhs_ ) : Node( CppEvaluator::Bool ), isAnd( isAnd_ ), lhs( lhs_ ), rhs( rhs_ ) {}
+
+		virtual Value eval()
+		{
+			Value v = lhs->eval();
+			if( (v.i != 0) == isAnd )
+				v = rhs->eval();
+			return v;
+		}
+
+		bool isAnd;
+		Node *lhs;
+		Node *rhs;
+	};
+
+	class Conditional : public Node
+	{
+	public:
+		Conditional( Node *cond_, Node *a_, Node *b_ ) : Node( a_->type ), cond( cond_ ), a( a_ ), b( b_ ) {}
+
+		virtual Value eval()
+		{
+			return cond->eval().i ? a->eval() : b->eval();
+		}
+
+		Node *cond;
+		Node *a;
+		Node *b;
+	};
+
+	// Arguments have already been converted to the function's type.
+	class Call : public Node
+	{
+	public:
+		Call( Type type, const std::string &name_, const std::vector<Node *> &args_ ) : Node( type ), name( name_ ), args( args_ ) {}
+
+		virtual Value eval()
+		{
+			Value a = args[0]->eval();
+			Value b;
+			if( args.size() > 1 )
+				b = args[1]->eval();
+
+			Value v;
+			if( isIntegral(type) )
+			{
+				if( name == "min" ) v.i = (b.i < a.i) ? b.i : a.i;
+				else if( name == "max" ) v.i = (a.i < b.i) ? b.i : a.i;
+				else if( name == "abs" ) v.i = a.i < 0 ? -a.i : a.i;
+				else assert( false );
+			}
+			else
+			{
+				if( name == "min" ) v.d = (b.d < a.d) ? b.d : a.d;
+				else if( name == "max" ) v.d = (a.d < b.d) ? b.d : a.d;
+				else if( name == "fmin" ) v.d = fmin( a.d, b.d );
+				else if( name == "fmax" ) v.d = fmax( a.d, b.d );
+				else if( (name == "abs") || (name == "fabs") ) v.d = fabs( a.d );
+				else if( name == "sqrt" ) v.d = sqrt( a.d );
+				else if( name == "exp" ) v.d = exp( a.d );
+				else if( name == "log" ) v.d = log( a.d );
+				else if( name == "sin" ) v.d = sin( a.d );
+				else if( name == "cos" ) v.d = cos( a.d );
+				else if( name == "tan" ) v.d = tan( a.d );
+				else if( name == "floor" ) v.d = floor( a.d );
+				else if( name == "ceil" ) v.d = ceil( a.d );
+				else if( name == "round" ) v.d = round( a.d );
+				else if( name == "pow" ) v.d = pow( a.d, b.d );
+				else assert( false );
+
+				if( type == CppEvaluator::Float )
+					v.d = (float)v.d;
+			}
+			return v;
+		}
+
+		std::string name;
+		std::vector<Node *> args;
+	};
+
+	class Block : public Statement
+	{
+	public:
+		virtual bool exec( Value &result )
+		{
+			for( Statement *stmt : stmts )
+				if( stmt->exec(result) )
+					return true;
+			return false;
+		}
+
+		std::vector<Statement *> stmts;
+	};
+
+	class If : public Statement
+	{
+	public:
+		If( Node *cond_, Statement *then_, Statement *else_ ) : cond( cond_ ), thenStmt( then_ ), elseStmt( else_ ) {}
+
+		virtual bool exec( Value &result )
+		{
+			if( cond->eval().i )
+				return thenStmt->exec( result );
+			else if( elseStmt )
+				return elseStmt->exec( result );
+			return false;
+		}
+
+		Node *cond;
+		Statement *thenStmt;
+		Statement *elseStmt;
+	};
+
+	class Return : public Statement
+	{
+	public:
+		Return( Node *expr_ ) : expr( expr_ ) {}
+
+		virtual bool exec( Value &result )
+		{
+			result = expr->eval();
+			return true;
+		}
+
+		Node *expr;
+	};
+
+	// Thrown when the body uses something outside the supported subset.
+	struct Unsupported {};
+}
+
+namespace proplib
+{
+	// ----------------------------------------------------------------------
+	// ----------------------------------------------------------------------
+	// --- CLASS CppEvaluatorParser
+	// ---
+	// --- Recursive descent over the body text. All nodes are owned by the
+	// --- evaluator being built.
+	// ----------------------------------------------------------------------
+	// ----------------------------------------------------------------------
+	class CppEvaluatorParser
+	{
+	public:
+		CppEvaluatorParser( CppEvaluator *eval_,
+							const std::string &text_,
+							const std::vector<CppEvaluator::Type> &metadataTypes_ )
+		: eval( eval_ )
+		, text( text_ )
+		, pos( 0 )
+		, metadataTypes( metadataTypes_ )
+		{
+			lex();
+		}
+
+		Statement *parseBody()
+		{
+			Block *block = add( new Block() );
+			while( !tok.empty() )
+				block->stmts.push_back( parseStatement() );
+			return block;
+		}
+
+	private:
+		template<typename T>
+		T *add( T *node )
+		{
+			eval->_nodes.push_back( node );
+			return node;
+		}
+
+		// ---
+		// --- Lexer
+		// ---
+		void lex()
+		{
+			while( true )
+			{
+				while( (pos < text.size()) && isspace(text[pos]) )
+					pos++;
+				if( text.compare(pos, 2, "//") == 0 )
+				{
+					pos = text.find( '\n', pos );
+					if( pos == std::string::npos )
+						pos = text.size();
+					continue;
+				}
+				if( text.compare(pos, 2, "/*") == 0 )
+				{
+					pos = text.find( "*/", pos + 2 );
+					if( pos == std::string::npos )
+						throw Unsupported();
+					pos += 2;
+					continue;
+				}
+				break;
+			}
+
+			if( pos >= text.size() )
+			{
+				tok = "";
+				return;
+			}
+
+			size_t start = pos;
+			char c = text[pos];
+			if( isalpha(c) || (c == '_') || (c == '$') )
+			{
+				pos++;
+				while( (pos < text.size()) && (isalnum(text[pos]) || (text[pos] == '_')) )
+					pos++;
+			}
+			else if( isdigit(c) || ((c == '.') && (pos + 1 < text.size()) && isdigit(text[pos + 1])) )
+			{
+				while( (pos < text.size()) && (isalnum(text[pos]) || (text[pos] == '.')
+											   || (((text[pos] == '-') || (text[pos] == '+'))
+												   && ((text[pos - 1] == 'e') || (text[pos - 1] == 'E')))) )
+					pos++;
+			}
+			else
+			{
+				static const char *ops2[] = { "&&", "||", "==", "!=", "<=", ">=", NULL };
+				pos++;
+				for( int i = 0; ops2[i]; i++ )
+				{
+					if( text.compare(start, 2, ops2[i]) == 0 )
+					{
+						pos++;
+						break;
+					}
+				}
+				if( (pos - start == 1) && !strchr("+-*/%<>!?:(){};,", c) )
+					throw Unsupported();
+			}
+
+			tok = text.substr( start, pos - start );
+		}
+
+		bool accept( const char *s )
+		{
+			if( tok == s )
+			{
+				lex();
+				return true;
+			}
+			return false;
+		}
+
+		void expect( const char *s )
+		{
+			if( !accept(s) )
+				throw Unsupported();
+		}
+
+		// ---
+		// --- Statements
+		// ---
+		Statement *parseStatement()
+		{
+			if( accept("{") )
+			{
+				Block *block = add( new Block() );
+				while( !accept("}") )
+				{
+					if( tok.empty() )
+						throw Unsupported();
+					block->stmts.push_back( parseStatement() );
+				}
+				return block;
+			}
+			else if( accept("if") )
+			{
+				expect( "(" );
+				Node *cond = convert( parseExpression(), CppEvaluator::Bool );
+				expect( ")" );
+				Statement *thenStmt = parseStatement();
+				Statement *elseStmt = NULL;
+				if( accept("else") )
+					elseStmt = parseStatement();
+				return add( new If(cond, thenStmt, elseStmt) );
+			}
+			else if( accept("return") )
+			{
+				Node *expr = convert( parseExpression(), eval->_type );
+				expect( ";" );
+				return add( new Return(expr) );
+			}
+			else if( accept(";") )
+			{
+				return add( new Block() );
+			}
+
+			throw Unsupported();
+		}
+
+		// ---
+		// --- Expressions
+		// ---
+		Node *convert( Node *node, Type type )
+		{
+			if( node->type == type )
+				return node;
+			return add( new Convert(type, node) );
+		}
+
+		Node *parseExpression()
+		{
+			Node *cond = parseBinary( 0 );
+			if( accept("?") )
+			{
+				Node *a = parseExpression();
+				expect( ":" );
+				Node *b = parseExpression();
+				Type type = (a->type == b->type) ? a->type : promote( a->type, b->type );
+				return add( new Conditional(convert(cond, CppEvaluator::Bool), convert(a, type), convert(b, type)) );
+			}
+			return cond;
+		}
+
+		// Binary operators by increasing precedence.
+		int getPrecedence( const std::string &op )
+		{
+			if( op == "||" ) return 1;
+			if( op == "&&" ) return 2;
+			if( (op == "==") || (op == "!=") ) return 3;
+			if( (op == "<") || (op == "<=") || (op == ">") || (op == ">=") ) return 4;
+			if( (op == "+") || (op == "-") ) return 5;
+			if( (op == "*") || (op == "/") || (op == "%") ) return 6;
+			return -1;
+		}
+
+		Node *parseBinary( int minPrecedence )
+		{
+			Node *lhs = parseUnary();
+
+			while( true )
+			{
+				std::string op = tok;
+				int precedence = getPrecedence( op );
+				if( precedence <= minPrecedence )
+					return lhs;
+				lex();
+				Node *rhs = parseBinary( precedence );
+
+				if( (op == "&&") || (op == "||") )
+				{
+					lhs = add( new Logical(op == "&&", convert(lhs, CppEvaluator::Bool), convert(rhs, CppEvaluator::Bool)) );
+				}
+				else
+				{
+					Type type = promote( lhs->type, rhs->type );
+					if( (op == "%") && (type != CppEvaluator::Int) )
+						throw Unsupported();
+					lhs = convert( lhs, type );
+					rhs = convert( rhs, type );
+					if( precedence <= 4 )
+						lhs = add( new Compare(op, lhs, rhs) );
+					else
+						lhs = add( new Arithmetic(op[0], lhs, rhs) );
+				}
+			}
+		}
+
+		Node *parseUnary()
+		{
+			if( accept("-") )
+			{
+				Node *operand = parseUnary();
+				return add( new Negate(convert(operand, promote(operand->type, CppEvaluator::Int))) );
+			}
+			else if( accept("+") )
+			{
+				Node *operand = parseUnary();
+				return convert( operand, promote(operand->type, CppEvaluator::Int) );
+			}
+			else if( accept("!") )
+			{
+				return add( new Not(convert(parseUnary(), CppEvaluator::Bool)) );
+			}
+			return parsePrimary();
+		}
+
+		Node *parsePrimary()
+		{
+			if( tok.empty() )
+				throw Unsupported();
+
+			if( accept("(") )
+			{
+				Node *node = parseExpression();
+				expect( ")" );
+				return node;
+			}
+
+			std::string word = tok;
+			Value v;
+
+			if( (word == "true") || (word == "True") || (word == "false") || (word == "False") )
+			{
+				lex();
+				v.i = (word == "true") || (word == "True");
+				return add( new Constant(CppEvaluator::Bool, v) );
+			}
+
+			if( isdigit(word[0]) || (word[0] == '.') )
+			{
+				lex();
+				return parseNumber( word );
+			}
+
+			if( word[0] == '$' )
+			{
+				lex();
+				char *end;
+				long index = strtol( word.c_str() + 1, &end, 10 );
+				if( (*end != 0) || (index < 0) || (index >= (long)metadataTypes.size())
+					|| (metadataTypes[index] == CppEvaluator::Invalid) )
+				{
+					throw Unsupported();
+				}
+				__CppEvalSlot *slot = add( new __CppEvalSlot(metadataTypes[index], (int)index) );
+				eval->_slots.push_back( slot );
+				return slot;
+			}
+
+			if( isalpha(word[0]) || (word[0] == '_') )
+			{
+				lex();
+				if( tok != "(" )
+					throw Unsupported();
+				return parseCall( word );
+			}
+
+			throw Unsupported();
+		}
+
+		Node *parseNumber( const std::string &word )
+		{
+			std::string digits = word;
+			bool isFloat = false;
+			bool isReal = word.find_first_of( ".eE" ) != std::string::npos;
+
+			char suffix = tolower( digits[digits.size() - 1] );
+			if( (suffix == 'f') && isReal )
+			{
+				isFloat = true;
+				digits.erase( digits.size() - 1 );
+			}
+			else if( (suffix == 'l') || (suffix == 'u') )
+			{
+				throw Unsupported();
+			}
+
+			char *end;
+			Value v;
+			if( isReal )
+			{
+				v.d = strtod( digits.c_str(), &end );
+				if( isFloat )
+					v.d = (float)v.d;
+			}
+			else
+			{
+				if( (digits.size() > 1) && (digits[0] == '0') )
+					throw Unsupported(); // octal/hex
+				v.i = strtol( digits.c_str(), &end, 10 );
+				if( v.i > 0x7fffffff )
+					throw Unsupported();
+			}
+			if( *end != 0 )
+				throw Unsupported();
+
+			return add( new Constant(isReal ? (isFloat ? CppEvaluator::Float : CppEvaluator::Double) : CppEvaluator::Int, v) );
+		}
+
+		Node *parseCall( const std::string &name )
+		{
+			std::vector<Node *> args;
+			expect( "(" );
+			if( !accept(")") )
+			{
+				do
+				{
+					args.push_back( parseExpression() );
+				} while( accept(",") );
+				expect( ")" );
+			}
+
+			bool binary = (name == "min") || (name == "max") || (name == "fmin") || (name == "fmax") || (name == "pow");
+			bool unary = (name == "abs") || (name == "fabs") || (name == "sqrt") || (name == "exp") || (name == "log")
+				|| (name == "sin") || (name == "cos") || (name == "tan") || (name == "floor") || (name == "ceil")
+				|| (name == "round");
+			if( !(binary && (args.size() == 2)) && !(unary && (args.size() == 1)) )
+				throw Unsupported();
+
+			Type type;
+			if( (name == "min") || (name == "max") )
+			{
+				// std::min/max require both arguments to have the same type.
+				if( args[0]->type != args[1]->type )
+					throw Unsupported();
+				type = args[0]->type == CppEvaluator::Bool ? CppEvaluator::Int : args[0]->type;
+			}
+			else if( name == "abs" )
+			{
+				type = promote( args[0]->type, CppEvaluator::Int );
+			}
+			else
+			{
+				// <cmath> has float overloads; integers are computed as double.
+				type = CppEvaluator::Float;
+				for( Node *arg : args )
+					if( arg->type != CppEvaluator::Float )
+						type = CppEvaluator::Double;
+			}
+
+			for( Node *&arg : args )
+				arg = convert( arg, type );
+
+			return add( new Call(type, name, args) );
+		}
+
+		CppEvaluator *eval;
+		std::string text;
+		size_t pos;
+		std::string tok;
+		const std::vector<CppEvaluator::Type> &metadataTypes;
+	};
+}
+
+// ----------------------------------------------------------------------
+// ----------------------------------------------------------------------
+// --- CLASS CppEvaluator
+// ----------------------------------------------------------------------
+// ----------------------------------------------------------------------
+CppEvaluator::Type CppEvaluator::getType( const std::string &cpptype )
+{
+	if( cpptype == "bool" )
+		return Bool;
+	if( cpptype == "int" )
+		return Int;
+	if( cpptype == "float" )
+		return Float;
+	if( cpptype == "double" )
+		return Double;
+	return Invalid;
+}
+
+CppEvaluator *CppEvaluator::compile( const std::string &body,
+									 int metadataIndex,
+									 const std::vector<Type> &metadataTypes )
+{
+	assert( (metadataIndex >= 0) && (metadataIndex < (int)metadataTypes.size()) );
+
+	if( metadataTypes[metadataIndex] == Invalid )
+		return NULL;
+
+	CppEvaluator *eval = new CppEvaluator();
+	eval->_metadataIndex = metadataIndex;
+	eval->_type = metadataTypes[metadataIndex];
+
+	try
+	{
+		CppEvaluatorParser parser( eval, body, metadataTypes );
+		eval->_body = parser.parseBody();
+	}
+	catch( Unsupported & )
+	{
+		delete eval;
+		return NULL;
+	}
+
+	return eval;
+}
+
+CppEvaluator::CppEvaluator()
+: _metadataIndex( -1 )
+, _type( Invalid )
+, _value( NULL )
+, _body( NULL )
+{
+}
+
+CppEvaluator::~CppEvaluator()
+{
+	itfor( std::vector<__CppEvalNode *>, _nodes, it )
+		delete *it;
+}
+
+void CppEvaluator::bind( CppProperties::PropertyMetadata *metadata )
+{
+	_value = metadata[_metadataIndex].value;
+	itfor( std::vector<__CppEvalSlot *>, _slots, it )
+		(*it)->addr = metadata[(*it)->index].value;
+}
+
+void CppEvaluator::update()
+{
+	assert( _value );
+
+	Value result;
+	if( !_body->exec(result) )
+		return;
+
+	switch( _type )
+	{
+	case Bool: *(bool *)_value = result.i != 0; break;
+	case Int: *(int *)_value = (int)result.i; break;
+	case Float: *(float *)_value = (float)result.d; break;
+	case Double: *(double *)_value = result.d; break;
+	default: assert( false );
+	}
+}
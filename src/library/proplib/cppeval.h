@@ -0,0 +1,62 @@
+#pragma once
+
+#include <string>
+#include <vector>
+
+#include "cppprops.h"
+
+namespace proplib
+{
+	// ----------------------------------------------------------------------
+	// ----------------------------------------------------------------------
+	// --- CLASS CppEvaluator
+	// ---
+	// --- Evaluates the update body of a dynamic property without compiling
+	// --- it. Handles the subset of C++ that worldfiles typically use: blocks,
+	// --- if/else, return, arithmetic, comparison and logical operators, ?:,
+	// --- numeric and boolean literals, min/max and common <cmath> functions.
+	// --- Other cpp properties are written $N, where N is the metadata index.
+	// --- Arithmetic follows the C++ conversion rules for bool, int, float and
+	// --- double, so results match the compiled body.
+	// ----------------------------------------------------------------------
+	// ----------------------------------------------------------------------
+	class CppEvaluator
+	{
+	public:
+		enum Type
+		{
+			Bool,
+			Int,
+			Float,
+			Double,
+			Invalid
+		};
+
+		static Type getType( const std::string &cpptype );
+
+		// Returns NULL if the body uses anything outside the supported subset.
+		static CppEvaluator *compile( const std::string &body,
+									  int metadataIndex,
+									  const std::vector<Type> &metadataTypes );
+
+		~CppEvaluator();
+
+		// Resolves $N to metadata[N].value.
+		void bind( CppProperties::PropertyMetadata *metadata );
+
+		// Evaluates the body and stores the result in the property.
+		void update();
+
+	private:
+		CppEvaluator();
+
+		friend class CppEvaluatorParser;
+
+		int _metadataIndex;
+		Type _type;
+		void *_value;
+		class __CppEvalStatement *_body;
+		std::vector<class __CppEvalNode *> _nodes;
+		std::vector<class __CppEvalSlot *> _slots;
+	};
+}
@@ -7,15 +7,21 @@
 #include "windows/dlfcn.h"
 #endif
 #include <stdio.h>
+#include <stdlib.h>
 #include <string.h>
+#include <sys/stat.h>
+#include <unistd.h>
 
 #include <fstream>
 #include <sstream>
 
+#include "cppeval.h"
+#include "cppsyms.h"
 #include "dom.h"
 #include "expression.h"
 #include "interpreter.h"
 #include "parser.h"
+#include "sim/SimulationContext.h"
 #include "utils/misc.h"
 
 using namespace proplib;
@@ -26,16 +32,19 @@ using namespace proplib;
 #define UTILS_PATH ""
 #endif
 
-#define GENDIR "run/.cppprops"
-#define GENSRC GENDIR "/generated.cpp"
 #if !__WIN64__ && ! __WIN32__
-#define GENLIB GENDIR "/" CPPPROPS_TARGET
+#define LIBNAME CPPPROPS_TARGET
+#define CACHEDIR PWHOME "/.cppprops"
 #else
-#define GENLIB GENDIR "/libcppprops.dll"
+#define LIBNAME "libcppprops.dll"
+#define CACHEDIR ".cppprops"
 #endif
 
 #define l(content) out << content << std::endl
 
+// Indexed by datalib::Type.
+static const char *DataLibTypeNames[] = { "INVALID", "INT", "FLOAT", "STRING", "BOOL" };
+
 // ----------------------------------------------------------------------
 // ----------------------------------------------------------------------
 // --- CLASS PropertyMetadata
@@ -68,54 +77,168 @@ const char *CppProperties::PropertyMetadata::toString()
 // ----------------------------------------------------------------------
 // ----------------------------------------------------------------------
 
-CppProperties::LibraryUpdate CppProperties::_update = NULL;
-CppProperties::LibraryGetMetadata CppProperties::_getMetadata = NULL;
-Document *CppProperties::_doc = NULL;
-CppProperties::UpdateContext *CppProperties::_context = NULL;
+// Where the library is generated and loaded from, in the run directory.
+static std::string getGenDir()
+{
+	return SimulationContext::runPath( ".cppprops" );
+}
+
+CppProperties::State &CppProperties::state()
+{
+	return SimulationContext::current()->get<State>();
+}
 
 void CppProperties::init( Document *doc, UpdateContext *context )
 {
-	_doc = doc;
-	_context = context;
+	State &s = state();
+	s.doc = doc;
+	s.context = context;
 
-	generateLibrarySource();
+	std::string source = generateLibrarySource();
+	if( s.native )
+	{
+		itfor( NativePropertyList, s.nativeProperties, it )
+			(*it)->bind( s.metadata.data() );
+		return;
+	}
 
-#if !__WIN64__ && !__WIN32__
-    SYSTEM("cp " PWHOME "/etc/bld/cppprops.mak " GENDIR "/Makefile && export conf=" PWHOME "/Makefile.conf && make -C " GENDIR);
-#else
-    SYSTEM(UTILS_PATH "cp ./etc/bld/cppprops.win " GENDIR "/Makefile && " UTILS_PATH "cp ./etc/bld/Makefile.conf " GENDIR " && " UTILS_PATH "make -C " GENDIR);
-#endif
+	std::string libPath = buildLibrary( source );
 
-    void *libHandle = dlopen(GENLIB, RTLD_LAZY);
-    ERRIF(!libHandle, "Failed opening " GENLIB);
+    void *libHandle = dlopen(libPath.c_str(), RTLD_LAZY);
+    ERRIF(!libHandle, "Failed opening %s", libPath.c_str());
 
     typedef void (*LibraryInit) (UpdateContext *context);
     LibraryInit init = (LibraryInit) dlsym(libHandle, "__clink__CppProperties_Init");
 	ERRIF( dlerror() != NULL, "%s", dlerror() );
 
-    _update = (LibraryUpdate) dlsym(libHandle, "__clink__CppProperties_Update");
+    s.update = (LibraryUpdate) dlsym(libHandle, "__clink__CppProperties_Update");
 	ERRIF( dlerror() != NULL, "%s", dlerror() );
 
-    _getMetadata = (LibraryGetMetadata) dlsym(libHandle, "__clink__CppProperties_GetMetadata");
+    s.getMetadata = (LibraryGetMetadata) dlsym(libHandle, "__clink__CppProperties_GetMetadata");
 	ERRIF( dlerror() != NULL, "%s", dlerror() );
 
     init(context);
+
+	PropertyMetadata *metadata;
+	int count;
+	s.getMetadata( &metadata, &count );
+	itfor( NativePropertyList, s.nativeProperties, it )
+		(*it)->bind( metadata );
 }
 
 void CppProperties::update() {
-    _update(_context);
+	State &s = state();
+	if( s.update )
+		s.update(s.context);
+
+	// Native properties only depend on compiled properties that were just updated.
+	itfor( NativePropertyList, s.nativeProperties, it )
+		(*it)->update();
 }
 
 void CppProperties::getMetadata(PropertyMetadata **metadata, int *count) {
-    _getMetadata(metadata, count);
+	State &s = state();
+	if( s.native )
+	{
+		*metadata = s.metadata.data();
+		*count = (int)s.metadata.size();
+	}
+	else
+		s.getMetadata(metadata, count);
+}
+
+// FNV-1a
+static uint64_t hashString( const std::string &str )
+{
+	uint64_t hash = 14695981039346656037ULL;
+	for( size_t i = 0; i < str.size(); i++ )
+	{
+		hash ^= (unsigned char)str[i];
+		hash *= 1099511628211ULL;
+	}
+	return hash;
+}
+
+// Identifies the build of the library that loads the generated code, whose
+// headers the generated code was compiled against.
+static std::string getBuildStamp()
+{
+	std::stringstream stamp;
+#if !__WIN64__ && !__WIN32__
+	Dl_info info;
+	struct stat st;
+	if( dladdr((void *)&hashString, &info) && info.dli_fname && (stat(info.dli_fname, &st) == 0) )
+		stamp << info.dli_fname << ":" << st.st_size << ":" << st.st_mtime;
+#endif
+	return stamp.str();
+}
+
+static void copyFile( const std::string &from, const std::string &to )
+{
+	std::ifstream in( from.c_str(), std::ios::binary );
+	std::ofstream out( to.c_str(), std::ios::binary );
+	out << in.rdbuf();
+	ERRIF( !in || !out, "Failed copying %s to %s", from.c_str(), to.c_str() );
 }
 
-void CppProperties::generateLibrarySource()
+std::string CppProperties::buildLibrary( const std::string &source )
+{
+	std::string genDir = getGenDir();
+	// The library is always loaded from the run directory: loading one path
+	// twice would give two simulations in a process the same metadata.
+	std::string genLib = genDir + "/" LIBNAME;
+
+    SYSTEM( (UTILS_PATH "mkdir -p " + genDir).c_str() );
+
+	{
+		std::ofstream out( (genDir + "/generated.cpp").c_str() );
+		out << source;
+	}
+
+	// Libraries are cached by content, so launches that generate the same
+	// source (e.g. a parameter sweep) skip make entirely.
+	char hash[32];
+	sprintf( hash, "%016llx", (unsigned long long)hashString(source + getBuildStamp()) );
+	std::string dir = std::string( CACHEDIR "/" ) + hash;
+	std::string path = dir + "/" LIBNAME;
+
+	struct stat st;
+	if( stat(path.c_str(), &st) == 0 )
+	{
+		copyFile( path, genLib );
+		return genLib;
+	}
+
+#if !__WIN64__ && !__WIN32__
+    std::string make = "cp " PWHOME "/etc/bld/cppprops.mak " + genDir + "/Makefile && export conf=" PWHOME "/Makefile.conf && make -C " + genDir;
+#else
+    std::string make = UTILS_PATH "cp ./etc/bld/cppprops.win " + genDir + "/Makefile && " UTILS_PATH "cp ./etc/bld/Makefile.conf " + genDir + " && " UTILS_PATH "make -C " + genDir;
+#endif
+    SYSTEM( make.c_str() );
+
+	// Publish with a rename so that concurrent launches never load a partial file.
+	std::string mkdir = std::string( UTILS_PATH "mkdir -p " ) + dir;
+	SYSTEM( mkdir.c_str() );
+
+	std::stringstream tmp;
+	tmp << path << ".tmp." << getpid();
+	copyFile( genLib, tmp.str() );
+	if( rename(tmp.str().c_str(), path.c_str()) != 0 )
+	{
+		// Another launch may have won the race.
+		remove( tmp.str().c_str() );
+		ERRIF( stat(path.c_str(), &st) != 0, "Failed creating %s", path.c_str() );
+	}
+
+	return genLib;
+}
+
+std::string CppProperties::generateLibrarySource()
 {
 	CppPropertyList cppProperties;
 	DynamicPropertyList dynamicProperties;
 	RuntimePropertyList runtimeProperties;
-	getCppProperties( _doc,
+	getCppProperties( state().doc,
 					  cppProperties,
 					  dynamicProperties,
 					  runtimeProperties );
@@ -136,9 +259,7 @@ void CppProperties::generateLibrarySource()
 		}
 	}
 
-
-    SYSTEM(UTILS_PATH "mkdir -p " GENDIR);
-    std::ofstream out(GENSRC);
+    std::stringstream out;
 
 	l( "// This file is machine-generated. See " << __FILE__ );
 	l( "" );
@@ -214,7 +335,12 @@ void CppProperties::generateLibrarySource()
 	// ---
 	// --- Generate Update Function
 	// ---
-	generateUpdateSource( out, dynamicProperties, infoMap );
+	DynamicPropertyList compiledProperties;
+	selectNativeProperties( dynamicProperties, compiledProperties, infoMap );
+	generateUpdateSource( out, compiledProperties, infoMap );
+
+	// The library is only needed to compile updates, or to find symbols.
+	state().native = compiledProperties.empty() && resolveMetadata( cppProperties, infoMap );
 
 	// --- Generate C Linkage Entry Points
     l("" );
@@ -248,9 +374,95 @@ void CppProperties::generateLibrarySource()
     l("    return TRUE;");
     l("}");
 #endif
+
+	return out.str();
+}
+
+// Fills in the metadata as the generated library's init would, when every
+// symbol is known to CppSymbols.
+bool CppProperties::resolveMetadata( CppPropertyList &cppProperties, CppPropertyInfoMap &infoMap )
+{
+	State &s = state();
+	std::vector<PropertyMetadata> metadata( cppProperties.size() );
+
+	for( __ScalarProperty *prop : cppProperties )
+	{
+		std::vector<int> indices;
+		void *value = CppSymbols::resolve( getCppSymbol(prop, &indices), indices, s.context );
+		if( value == NULL )
+			return false;
+
+		PropertyMetadata &m = metadata[ infoMap[prop].metadataIndex ];
+		m.name = prop->getFullName( 1 );
+		if( dynamic_cast<DynamicScalarProperty *>(prop) )
+			m.type = PropertyMetadata::Dynamic;
+		else
+			m.type = PropertyMetadata::Runtime;
+		m.valueType = getDataLibType( prop );
+		m.value = value;
+		m.state = NULL;
+	}
+
+	s.metadata = metadata;
+	return true;
 }
 
-void CppProperties::generateStateStructs( std::ofstream &out, DynamicPropertyList &dynamicProperties )
+void CppProperties::selectNativeProperties( DynamicPropertyList &dynamicProperties,
+											DynamicPropertyList &result_compiled,
+											CppPropertyInfoMap &infoMap )
+{
+    std::vector<CppEvaluator::Type> metadataTypes( infoMap.size() );
+	itfor( CppPropertyInfoMap, infoMap, it )
+		metadataTypes[ it->second.metadataIndex ] = CppEvaluator::getType( getCppType(it->first) );
+
+    std::map<DynamicScalarProperty *, CppEvaluator *> prop2eval;
+    std::map<DynamicScalarProperty *, DynamicPropertyList> prop2antecedents;
+	for( DynamicScalarProperty *prop : dynamicProperties )
+	{
+        std::string body = generateUpdateFunctionBody( prop, prop2antecedents[prop], infoMap, true );
+
+		CppEvaluator *eval = NULL;
+		if( !prop->getAttr("state") && !prop->getAttr("init") && !prop->getAttr("stage") )
+			eval = CppEvaluator::compile( body, infoMap[prop].metadataIndex, metadataTypes );
+		prop2eval[prop] = eval;
+	}
+
+	// Compiled properties are updated before native ones, so anything a
+	// compiled property depends on must be compiled too.
+	DynamicPropertyList pending;
+	for( DynamicScalarProperty *prop : dynamicProperties )
+		if( prop2eval[prop] == NULL )
+			pending.push_back( prop );
+
+	while( !pending.empty() )
+	{
+		DynamicScalarProperty *prop = pending.front();
+		pending.pop_front();
+
+		for( DynamicScalarProperty *antecedent : prop2antecedents[prop] )
+		{
+			if( prop2eval[antecedent] )
+			{
+				delete prop2eval[antecedent];
+				prop2eval[antecedent] = NULL;
+				pending.push_back( antecedent );
+			}
+		}
+	}
+
+	DynamicPropertyList sorted = dynamicProperties;
+	sortDynamicProperties( sorted, prop2antecedents );
+
+	for( DynamicScalarProperty *prop : sorted )
+	{
+		if( prop2eval[prop] )
+			state().nativeProperties.push_back( prop2eval[prop] );
+		else
+			result_compiled.push_back( prop );
+	}
+}
+
+void CppProperties::generateStateStructs( std::ostream &out, DynamicPropertyList &dynamicProperties )
 {
 	itfor( DynamicPropertyList, dynamicProperties, it )
 	{
@@ -268,7 +480,7 @@ void CppProperties::generateStateStructs( std::ofstream &out, DynamicPropertyLis
 	}
 }
 
-void CppProperties::generateMetadata( std::ofstream &out,
+void CppProperties::generateMetadata( std::ostream &out,
 									  CppPropertyList &cppProperties,
 									  CppPropertyInfoMap &infoMap )
 {
@@ -295,7 +507,7 @@ void CppProperties::generateMetadata( std::ofstream &out,
 			l( "    CppProperties::PropertyMetadata::Runtime," );
 
 		// valueType
-		l( "    " << getDataLibType(prop) << "," );
+		l( "    datalib::" << DataLibTypeNames[getDataLibType(prop)] << "," );
 
 		// value
 		l( "    NULL," );
@@ -316,7 +528,7 @@ void CppProperties::generateMetadata( std::ofstream &out,
 	l( "" );
 }
 
-void CppProperties::generateInitSource( std::ofstream &out,
+void CppProperties::generateInitSource( std::ostream &out,
 										CppPropertyList &cppProperties,
 										DynamicPropertyList &dynamicProperties,
 										CppPropertyInfoMap &infoMap )
@@ -473,7 +685,7 @@ std::string CppProperties::generateInitFunctionBody( DynamicScalarProperty *prop
 	return out.str();
 }
 
-void CppProperties::generateUpdateSource( std::ofstream &out,
+void CppProperties::generateUpdateSource( std::ostream &out,
 											  DynamicPropertyList &dynamicProperties,
 											  CppPropertyInfoMap &infoMap )
 {
@@ -597,7 +809,8 @@ void CppProperties::generateUpdateSource( std::ofstream &out,
 
 std::string CppProperties::generateUpdateFunctionBody( DynamicScalarProperty *prop,
 												  DynamicPropertyList &antecedents,
-												  CppPropertyInfoMap &infoMap )
+												  CppPropertyInfoMap &infoMap,
+												  bool native )
 {
 	Expression *expr;
 	bool skipBraces;
@@ -694,7 +907,10 @@ std::string CppProperties::generateUpdateFunctionBody( DynamicScalarProperty *pr
 									antecedents.push_back( dynamic_cast<DynamicScalarProperty *>(sym.prop) );
 									// fall through.
 								case Node::Runtime:
-									text = getMetadataLValue( sym.prop, infoMap );
+									if( native )
+										text = getNativeReference( sym.prop, infoMap );
+									else
+										text = getMetadataLValue( sym.prop, infoMap );
 									break;
 								default:
 									assert( false );
@@ -748,24 +964,24 @@ std::string CppProperties::getStateStructName( DynamicScalarProperty *prop )
     return std::string("State___") + prop->getFullName( 1, "__" );
 }
 
-std::string CppProperties::getDataLibType( __ScalarProperty *prop )
+datalib::Type CppProperties::getDataLibType( __ScalarProperty *prop )
 {
-    std::string dtype = "";
+    datalib::Type dtype = datalib::INVALID;
 
     std::string type = prop->getSchema()->get( "type" );
 	if( type == "Float" )
-		dtype = "FLOAT";
+		dtype = datalib::FLOAT;
 	if( type == "Int" )
-		dtype = "INT";
+		dtype = datalib::INT;
 	if( type == "String" )
-		dtype = "STRING";
+		dtype = datalib::STRING;
 	if( type == "Bool" )
-		dtype = "BOOL";
+		dtype = datalib::BOOL;
 
-	if( dtype.empty() )
+	if( dtype == datalib::INVALID )
 		prop->err( "No appropriate datalib type for cpp property." );
 
-    return std::string("datalib::") + dtype;
+    return dtype;
 }
 
 std::string CppProperties::getCppType( Property *prop )
@@ -800,6 +1016,14 @@ std::string CppProperties::getMetadataLValue( Property *prop_, CppPropertyInfoMa
 	return buf.str();
 }
 
+std::string CppProperties::getNativeReference( Property *prop, CppPropertyInfoMap &infoMap )
+{
+    std::stringstream buf;
+	buf << "$" << infoMap[prop].metadataIndex;
+
+	return buf.str();
+}
+
 static bool findSymMacro( Property &prop,
                           std::string cppsym,
 						  int *result_start,
@@ -841,7 +1065,9 @@ static bool findSymMacro( Property &prop,
 	return false;
 }
 
-std::string CppProperties::getCppSymbol( Property *prop )
+// With indices, each $[index] is written # and its value appended, giving the
+// pattern CppSymbols looks up.
+std::string CppProperties::getCppSymbol( Property *prop, std::vector<int> *indices )
 {
 	Property &propSym = prop->getSchema()->get( "cppsym" );
     std::string sym = propSym;
@@ -869,7 +1095,13 @@ std::string CppProperties::getCppSymbol( Property *prop )
 			if( prop->getParent()->getType() != Node::Array )
 				propSym.err( "$[index] only valid for element of array." );
 
-			sym.replace( macro_start, macro_len, prop->getName() );
+			if( indices )
+			{
+				indices->push_back( atoi(prop->getName()) );
+				sym.replace( macro_start, macro_len, "#" );
+			}
+			else
+				sym.replace( macro_start, macro_len, prop->getName() );
 		}
 		else if( macro_args[0] == "ancestor" )
 		{
@@ -882,7 +1114,7 @@ std::string CppProperties::getCppSymbol( Property *prop )
 				if( parent->getSchema()->getp("cppsym") )
 				{
 					resolved = true;
-					sym.replace( macro_start, macro_len, getCppSymbol(parent) );
+					sym.replace( macro_start, macro_len, getCppSymbol(parent, indices) );
 					break;
 				}
 			}
@@ -3,6 +3,7 @@
 #include <list>
 #include <map>
 #include <string>
+#include <vector>
 
 #include "utils/datalib.h"
 
@@ -13,10 +14,13 @@ class TSimulation;
 #define PROPLIB_CPP_PROPERTIES \
     friend void proplib::CppProperties_Init(proplib::CppProperties::UpdateContext *context); \
     friend void proplib::CppProperties_Update(proplib::CppProperties::UpdateContext *context); \
-    friend void proplib::CppProperties_GetMetadata(proplib::CppProperties::PropertyMetadata **result_metadata, int *result_count);
+    friend void proplib::CppProperties_GetMetadata(proplib::CppProperties::PropertyMetadata **result_metadata, int *result_count); \
+    friend class proplib::CppSymbols;
 
 namespace proplib
 {
+	class CppSymbols;
+
 	// ----------------------------------------------------------------------
 	// ----------------------------------------------------------------------
 	// --- CLASS CppProperties
@@ -82,30 +86,37 @@ namespace proplib
 		typedef std::list<class RuntimeScalarProperty *> RuntimePropertyList;
 		typedef std::map<class Property *, CppPropertyInfo> CppPropertyInfoMap;
 
-		static void generateLibrarySource();
-		static void generateStateStructs( std::ofstream &out, DynamicPropertyList &dynamicProperties );
-		static void generateMetadata( std::ofstream &out,
+		static std::string generateLibrarySource();
+		static std::string buildLibrary( const std::string &source );
+		static bool resolveMetadata( CppPropertyList &cppProperties, CppPropertyInfoMap &infoMap );
+		static void selectNativeProperties( DynamicPropertyList &dynamicProperties,
+											DynamicPropertyList &result_compiled,
+											CppPropertyInfoMap &infoMap );
+		static void generateStateStructs( std::ostream &out, DynamicPropertyList &dynamicProperties );
+		static void generateMetadata( std::ostream &out,
 									  CppPropertyList &cppProperties, 
 									  CppPropertyInfoMap &infoMap );
-		static void generateInitSource( std::ofstream &out,
+		static void generateInitSource( std::ostream &out,
 										CppPropertyList &cppProperties,
 										DynamicPropertyList &dynamicProperties,
 										CppPropertyInfoMap &infoMap );
 		static std::string generateInitFunctionBody( class DynamicScalarProperty *prop,
 													 DynamicPropertyList &antecedents,
 													 CppPropertyInfoMap &infoMap );
-		static void generateUpdateSource( std::ofstream &out,
+		static void generateUpdateSource( std::ostream &out,
 										  DynamicPropertyList &dynamicProperties,
 										  CppPropertyInfoMap &infoMap );
 		static std::string generateUpdateFunctionBody( class DynamicScalarProperty *prop,
 													   DynamicPropertyList &antecedents,
-													   CppPropertyInfoMap &infoMap );
+													   CppPropertyInfoMap &infoMap,
+													   bool native = false );
 
 		static std::string getStateStructName( class DynamicScalarProperty *prop );
-		static std::string getDataLibType( class __ScalarProperty *prop );
+		static datalib::Type getDataLibType( class __ScalarProperty *prop );
 		static std::string getCppType( class Property *prop );
-		static std::string getCppSymbol( class Property *prop );
+		static std::string getCppSymbol( class Property *prop, std::vector<int> *indices = NULL );
 		static std::string getMetadataLValue( class Property *prop, CppPropertyInfoMap &infoMap );
+		static std::string getNativeReference( class Property *prop, CppPropertyInfoMap &infoMap );
 
 		static void getCppProperties( class Property *container,
 									  CppPropertyList &result_all,
@@ -116,13 +127,24 @@ namespace proplib
 
 
 		typedef void (*LibraryUpdate)( UpdateContext * );
-		static LibraryUpdate _update;
 		typedef void (*LibraryGetMetadata)( PropertyMetadata **, int * );
-		static LibraryGetMetadata _getMetadata;
-		static class Document *_doc;
+		typedef std::vector<class CppEvaluator *> NativePropertyList;
+
+		// Each simulation generates and loads its own library, unless every
+		// property can be resolved and updated natively.
+		struct State
+		{
+			LibraryUpdate update = NULL;
+			LibraryGetMetadata getMetadata = NULL;
+			NativePropertyList nativeProperties;
+			bool native = false;
+			std::vector<PropertyMetadata> metadata;
+			class Document *doc = NULL;
+			UpdateContext *context = NULL;
+		};
+		static State &state();
 
 		friend class __StateObject;
-		static UpdateContext *_context;
 	};
 
 	// These functions are implemented by the generated code.
@@ -0,0 +1,112 @@
+#include "cppsyms.h"
+
+#include "dom.h"
+#include "agent/agent.h"
+#include "agent/Metabolism.h"
+#include "environment/barrier.h"
+#include "environment/BrickPatch.h"
+#include "environment/food.h"
+#include "environment/FoodPatch.h"
+#include "environment/FoodType.h"
+#include "sim/Simulation.h"
+#include "utils/objectxsortedlist.h"
+
+using namespace proplib;
+
+// The expression is the pattern with each # replaced by the next of i[].
+#define SYM( PATTERN, EXPRESSION )										\
+	{ PATTERN, [](CppProperties::UpdateContext *context, const Indices &i) -> void * \
+		{ (void)context; (void)i; return (void *)&(EXPRESSION); } }
+
+// ----------------------------------------------------------------------
+// ----------------------------------------------------------------------
+// --- CLASS CppSymbols
+// ----------------------------------------------------------------------
+// ----------------------------------------------------------------------
+void *CppSymbols::resolve( const std::string &pattern,
+						   const Indices &indices,
+						   CppProperties::UpdateContext *context )
+{
+	const ResolverMap &map = resolvers();
+	ResolverMap::const_iterator it = map.find( pattern );
+	if( it == map.end() )
+		return NULL;
+
+	return it->second( context, indices );
+}
+
+const CppSymbols::ResolverMap &CppSymbols::resolvers()
+{
+	// Keep in step with the cppsym declarations in etc/worldfile.wfs.
+	static const ResolverMap map =
+	{
+		SYM( "food::gMinFoodEnergy()",
+			 food::gMinFoodEnergy() ),
+		SYM( "food::gMaxFoodEnergy()",
+			 food::gMaxFoodEnergy() ),
+
+		SYM( "FoodType::get( # )->eatMultiplier.values[ # ]",
+			 FoodType::get( i[0] )->eatMultiplier.values[ i[1] ] ),
+
+		SYM( "Metabolism::get( # )->minEatAge",
+			 Metabolism::get( i[0] )->minEatAge ),
+		SYM( "Metabolism::get( # )->eatMultiplier.values[ # ]",
+			 Metabolism::get( i[0] )->eatMultiplier.values[ i[1] ] ),
+		SYM( "Metabolism::get( # )->energyDelta.values[ # ]",
+			 Metabolism::get( i[0] )->energyDelta.values[ i[1] ] ),
+		SYM( "context->sim->fNumberAliveWithMetabolism[ Metabolism::get( # )->index ]",
+			 context->sim->fNumberAliveWithMetabolism[ Metabolism::get( i[0] )->index ] ),
+
+		SYM( "barrier::gBarriers()[ # ]->getPosition().xa",
+			 barrier::gBarriers()[ i[0] ]->getPosition().xa ),
+		SYM( "barrier::gBarriers()[ # ]->getPosition().za",
+			 barrier::gBarriers()[ i[0] ]->getPosition().za ),
+		SYM( "barrier::gBarriers()[ # ]->getPosition().xb",
+			 barrier::gBarriers()[ i[0] ]->getPosition().xb ),
+		SYM( "barrier::gBarriers()[ # ]->getPosition().zb",
+			 barrier::gBarriers()[ i[0] ]->getPosition().zb ),
+
+		SYM( "context->sim->fDomains[ # ].foodRate",
+			 context->sim->fDomains[ i[0] ].foodRate ),
+		SYM( "context->sim->fDomains[ # ].fFoodPatches[ # ].growthRate",
+			 context->sim->fDomains[ i[0] ].fFoodPatches[ i[1] ].growthRate ),
+		SYM( "context->sim->fDomains[ # ].fFoodPatches[ # ].energy",
+			 context->sim->fDomains[ i[0] ].fFoodPatches[ i[1] ].energy ),
+		SYM( "context->sim->fDomains[ # ].fFoodPatches[ # ].on",
+			 context->sim->fDomains[ i[0] ].fFoodPatches[ i[1] ].on ),
+		SYM( "context->sim->fDomains[ # ].fBrickPatches[ # ].on",
+			 context->sim->fDomains[ i[0] ].fBrickPatches[ i[1] ].on ),
+
+		SYM( "context->sim->fMaxMateVelocity",
+			 context->sim->fMaxMateVelocity ),
+		SYM( "context->sim->fMinEatVelocity",
+			 context->sim->fMinEatVelocity ),
+		SYM( "context->sim->fMaxEatVelocity",
+			 context->sim->fMaxEatVelocity ),
+		SYM( "context->sim->fMaxEatYaw",
+			 context->sim->fMaxEatYaw ),
+		SYM( "context->sim->fEatWait",
+			 context->sim->fEatWait ),
+		SYM( "context->sim->fMateWait",
+			 context->sim->fMateWait ),
+		SYM( "context->sim->fEatMateMinDistance",
+			 context->sim->fEatMateMinDistance ),
+		SYM( "context->sim->fMinMateFraction",
+			 context->sim->fMinMateFraction ),
+
+		SYM( "agent::config().energyUseMultiplier",
+			 agent::config().energyUseMultiplier ),
+
+		SYM( "context->sim->fStep",
+			 context->sim->fStep ),
+		SYM( "objectxsortedlist::gXSortedObjects().agentCount",
+			 objectxsortedlist::gXSortedObjects().agentCount ),
+		SYM( "objectxsortedlist::gXSortedObjects().foodCount",
+			 objectxsortedlist::gXSortedObjects().foodCount ),
+
+		SYM( "proplib::Document::variables()[ # ]",
+			 proplib::Document::variables()[ i[0] ] )
+	};
+
+	return map;
+}
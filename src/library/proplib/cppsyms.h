@@ -0,0 +1,39 @@
+#pragma once
+
+#include <map>
+#include <string>
+#include <vector>
+
+#include "cppprops.h"
+
+namespace proplib
+{
+	// ----------------------------------------------------------------------
+	// ----------------------------------------------------------------------
+	// --- CLASS CppSymbols
+	// ---
+	// --- Resolves the cppsym of a property to the address of its value
+	// --- without generating code. Symbols are looked up by pattern: the
+	// --- cppsym with its ancestors and $[sim] expanded and every $[index]
+	// --- written #, the index values being passed in order. Only the symbols
+	// --- the shipped schema declares are known; any other needs the
+	// --- generated library.
+	// ----------------------------------------------------------------------
+	// ----------------------------------------------------------------------
+	class CppSymbols
+	{
+	public:
+		typedef std::vector<int> Indices;
+
+		// Returns NULL if the pattern is unknown.
+		static void *resolve( const std::string &pattern,
+							  const Indices &indices,
+							  CppProperties::UpdateContext *context );
+
+	private:
+		typedef void *(*Resolver)( CppProperties::UpdateContext *context, const Indices &i );
+		typedef std::map<std::string, Resolver> ResolverMap;
+
+		static const ResolverMap &resolvers();
+	};
+}
@@ -10,6 +10,7 @@
 
 #include "interpreter.h"
 #include "parser.h"
+#include "sim/SimulationContext.h"
 #include "utils/misc.h"
 
 using namespace proplib;
@@ -121,6 +122,12 @@ Token *DocumentLocation::getEndToken()
 	return _endToken;
 }
 
+void DocumentLocation::rebase( Document *from, Document *to )
+{
+	if( _doc == from )
+		_doc = to;
+}
+
 void DocumentLocation::err( std::string msg )
 {
     std::string desc = getDescription();
@@ -238,6 +245,11 @@ void Node::add( Node *node )
 	node->_parent = this;
 }
 
+void Node::rebase( class Document *from, class Document *to )
+{
+	_loc.rebase( from, to );
+}
+
 
 // ----------------------------------------------------------------------
 // ----------------------------------------------------------------------
@@ -320,6 +332,12 @@ ObjectProperty *Class::getDefinition()
 	return _definition;
 }
 
+void Class::rebase( class Document *from, class Document *to )
+{
+	Node::rebase( from, to );
+	_definition->rebase( from, to );
+}
+
 Class *Class::clone()
 {
 	Class *clone = new Class( getLocation(),
@@ -501,6 +519,14 @@ bool Property::hasBinding()
 	return _schema && _schema->getp( "cppsym" );
 }
 
+void Property::rebase( class Document *from, class Document *to )
+{
+	Node::rebase( from, to );
+
+	itfor( EnumMap, _enums, it )
+		it->second->rebase( from, to );
+}
+
 Property *Property::baseClone( Property *clone )
 {
 	itfor( EnumMap, _enums, it )
@@ -750,6 +776,14 @@ Property *DynamicScalarProperty::clone( Identifier cloneId )
 	return baseClone( clone );
 }
 
+void DynamicScalarProperty::rebase( class Document *from, class Document *to )
+{
+	Property::rebase( from, to );
+
+	itfor( DynamicScalarAttributeMap, _attrs, it )
+		it->second->rebase( from, to );
+}
+
 Expression *DynamicScalarProperty::getInitExpression()
 {
 	return _initExpr->getExpression();
@@ -905,6 +939,14 @@ bool __ContainerProperty::__findLocalSymbol( SymbolPath::Element *name, Symbol &
 	return Property::__findLocalSymbol( name, sym );
 }
 
+void __ContainerProperty::rebase( class Document *from, class Document *to )
+{
+	Property::rebase( from, to );
+
+	itfor( PropertyMap, props(), it )
+		it->second->rebase( from, to );
+}
+
 
 // ----------------------------------------------------------------------
 // ----------------------------------------------------------------------
@@ -937,13 +979,26 @@ Property *ObjectProperty::clone( Identifier cloneId )
 	ObjectProperty *prop = new ObjectProperty( getLocation(),
 											   cloneId );
 
+	cloneContents( prop );
+
+	return baseClone( prop );
+}
+
+void ObjectProperty::cloneContents( ObjectProperty *prop )
+{
 	itfor( PropertyMap, props(), it )
 		prop->add( it->second->clone(it->second->getId()) );
 
 	itfor( ClassMap, _classes, it )
 		prop->addClass( it->second->clone() );
+}
 
-	return baseClone( prop );
+void ObjectProperty::rebase( class Document *from, class Document *to )
+{
+	__ContainerProperty::rebase( from, to );
+
+	itfor( ClassMap, _classes, it )
+		it->second->rebase( from, to );
 }
 
 bool ObjectProperty::__findLocalSymbol( SymbolPath::Element *name, Symbol &sym )
@@ -1059,7 +1114,18 @@ std::string MetaProperty::getValue()
 // ----------------------------------------------------------------------
 // ----------------------------------------------------------------------
 
-std::vector<float> Document::variables;
+namespace
+{
+	struct Variables
+	{
+		std::vector<float> values;
+	};
+}
+
+std::vector<float> &Document::variables()
+{
+	return SimulationContext::current()->get<Variables>().values;
+}
 
 Document::Document( std::string name, std::string path )
 : ObjectProperty( Node::Document, DocumentLocation(this,0), name )
@@ -1076,6 +1142,33 @@ std::string Document::getPath()
 	return _path;
 }
 
+Document *Document::cloneDocument()
+{
+	Document *doc = new Document( getName(), _path );
+
+	cloneContents( doc );
+	baseClone( doc );
+
+	itfor( MetaPropertyMap, _metaprops, it )
+	{
+		MetaProperty *meta = it->second;
+		doc->addMeta( new MetaProperty(meta->getLocation(), meta->getId(), meta->getValue()) );
+	}
+
+	// The clones were made with this document's locations.
+	doc->rebase( this, doc );
+
+	return doc;
+}
+
+void Document::rebase( class Document *from, class Document *to )
+{
+	ObjectProperty::rebase( from, to );
+
+	itfor( MetaPropertyMap, _metaprops, it )
+		it->second->rebase( from, to );
+}
+
 bool Document::hasMeta( std::string name )
 {
 	return getMeta( name ) != NULL;
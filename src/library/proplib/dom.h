@@ -65,6 +65,9 @@ namespace proplib
 		class Token *getBeginToken();
 		class Token *getEndToken();
 
+		// Points a location in document from at document to instead.
+		void rebase( class Document *from, class Document *to );
+
 		void err( std::string msg );
 		void warn( std::string msg );
 
@@ -151,6 +154,9 @@ namespace proplib
 		bool findSymbol( SymbolPath *name, Symbol &sym );
 		virtual bool __findLocalSymbol( SymbolPath::Element *name, Symbol &sym );
 
+		// Moves this node, and any it owns, from one document to another.
+		virtual void rebase( class Document *from, class Document *to );
+
 	protected:
 		void add( Node *node );
 
@@ -209,6 +215,7 @@ namespace proplib
 		class ObjectProperty *getDefinition();
 
 		Class *clone();
+		virtual void rebase( class Document *from, class Document *to );
 
 	protected:
 		friend class Property;
@@ -271,6 +278,7 @@ namespace proplib
 		virtual bool hasBinding();
 
 		virtual bool __findLocalSymbol( SymbolPath::Element *name, Symbol &sym );
+		virtual void rebase( class Document *from, class Document *to );
 
 	protected:
 		int getDepth();
@@ -406,6 +414,7 @@ namespace proplib
 		virtual ~DynamicScalarProperty();
 
 		virtual Property *clone( Identifier cloneId );
+		virtual void rebase( class Document *from, class Document *to );
 
 		Expression *getInitExpression();
 
@@ -452,6 +461,7 @@ namespace proplib
 		virtual void dump( std::ostream &out, std::string indent = "" );
 
 		virtual bool __findLocalSymbol( SymbolPath::Element *name, Symbol &sym );
+		virtual void rebase( class Document *from, class Document *to );
 
 	private:
 		PropertyMap _props;
@@ -475,10 +485,15 @@ namespace proplib
 
 		virtual Property *clone( Identifier cloneId );
 		virtual bool __findLocalSymbol( SymbolPath::Element *name, Symbol &sym );
+		virtual void rebase( class Document *from, class Document *to );
 
 		void addClass( class Class *class_ );
 		class Class *getClass( const std::string &name );
 
+	protected:
+		// Clones this object's properties and classes into prop.
+		void cloneContents( ObjectProperty *prop );
+
 	private:
 		ClassMap _classes;
 	};
@@ -535,12 +550,18 @@ namespace proplib
 
 		std::string getPath();
 
+		// A deep copy that can be edited and have a schema applied without
+		// affecting this document, which must not have had one applied yet.
+		Document *cloneDocument();
+		virtual void rebase( class Document *from, class Document *to );
+
 		bool hasMeta( std::string name );
 		MetaProperty *getMeta( std::string name );
 		void addMeta( MetaProperty *prop );
 		MetaPropertyMap &metaprops();
 
-		static std::vector<float> variables;
+		// The worldfile's Variables, per simulation.
+		static std::vector<float> &variables();
 
 	private:
 		std::string _path;
@@ -2,6 +2,7 @@
 
 #include <assert.h>
 #include <stdio.h>
+#include <string.h>
 #include <unistd.h>
 
 #if __WIN64__ || __WIN32__
@@ -11,10 +12,12 @@
 #include <io.h>
 #endif
 
+#include <mutex>
 #include <sstream>
 
 #include "dom.h"
 #include "parser.h"
+#include "pyeval.h"
 #include "utils/misc.h"
 #include "utils/Resources.h"
 
@@ -162,7 +165,7 @@ class InterpreterProcess {
 
     void createPythonProcess() {
 
-        string script_path = Resources::getInterpreterScript();
+        std::string script_path = Resources::getInterpreterScript();
 
         REQUIRE( 0 == pipe(stdinPipe) );
         REQUIRE( 0 == pipe(stdoutPipe) );
@@ -291,21 +294,63 @@ public:
 // ----------------------------------------------------------------------
 // ----------------------------------------------------------------------
 
+bool Interpreter::initialized = false;
+Interpreter::Mode Interpreter::mode = Interpreter::Native;
 InterpreterProcess *Interpreter::process = nullptr;
 
-void Interpreter::init()
+void Interpreter::init( Mode mode_ )
 {
-	REQUIRE( !process );
-    process = new InterpreterProcess();
+	REQUIRE( !initialized );
+	initialized = true;
+	mode = mode_;
 }
 
 void Interpreter::dispose()
 {
-	REQUIRE( process );
-    delete process;
-    process = nullptr;
+	REQUIRE( initialized );
+	initialized = false;
+	if( process )
+	{
+		delete process;
+		process = nullptr;
+	}
 }
 
 bool Interpreter::eval(const std::string &expr,	char *result, size_t result_size) {
+	REQUIRE( initialized );
+
+	if( mode != Python )
+	{
+		std::string native;
+		if( PyEvaluator::eval(expr, native) && (native.length() < result_size) )
+		{
+			if( mode == Native )
+			{
+				strcpy( result, native.c_str() );
+				return true;
+			}
+
+			bool success = evalPython( expr, result, result_size );
+			if( success && (native != result) )
+			{
+				snprintf( result, result_size, "Native evaluation of '%s' differs: native='%s', python='%s'",
+						  expr.c_str(), native.c_str(), std::string(result).c_str() );
+				return false;
+			}
+			return success;
+		}
+	}
+
+	return evalPython( expr, result, result_size );
+}
+
+bool Interpreter::evalPython(const std::string &expr, char *result, size_t result_size) {
+	// Simulations initializing on several threads share the one process.
+	static std::mutex processMutex;
+	std::lock_guard<std::mutex> lock( processMutex );
+
+	if( !process )
+		process = new InterpreterProcess();
+
     return process->eval(expr, result, result_size);
 }
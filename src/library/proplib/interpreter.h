@@ -15,7 +15,9 @@ namespace proplib
 	// ----------------------------------------------------------------------
 	// --- CLASS Interpreter
 	// ---
-	// --- Manages python interpreter.
+	// --- Evaluates worldfile expressions. Expressions are evaluated natively
+	// --- by PyEvaluator when possible; the python interpreter process is only
+	// --- started for the first expression that PyEvaluator can't handle.
 	// ----------------------------------------------------------------------
 	// ----------------------------------------------------------------------
     class LIBRARY_SHARED Interpreter
@@ -46,14 +48,25 @@ namespace proplib
 		// --- API
 		// ----------------------------------------------------------------------
 		// ----------------------------------------------------------------------
-		static void init();
+		enum Mode
+		{
+			Native,	// PyEvaluator, falling back to python
+			Python,	// Always python
+			Check	// Both, failing if their results differ
+		};
+
+		static void init( Mode mode = Native );
 		static void dispose();
 
 	private:
 		friend class ExpressionEvaluator;
 		static bool eval( const std::string &expr,
 						  char *result, size_t result_size );
+		static bool evalPython( const std::string &expr,
+								char *result, size_t result_size );
 
+		static bool initialized;
+		static Mode mode;
         static InterpreterProcess *process;
 	};
 }
@@ -0,0 +1,1493 @@
+#include "pyeval.h"
+
+#include <assert.h>
+#include <ctype.h>
+#include <errno.h>
+#include <limits.h>
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <memory>
+#include <utility>
+#include <vector>
+
+using namespace proplib;
+
+namespace
+{
+	// Thrown for anything the native evaluator doesn't handle exactly like
+	// Python, including expressions that would raise in Python. The caller
+	// falls back to the interpreter, which produces the real result or error.
+	struct Unsupported {};
+
+	const size_t MaxSequenceLength = 1000000;
+
+	// ----------------------------------------------------------------------
+	// ----------------------------------------------------------------------
+	// --- Values
+	// ----------------------------------------------------------------------
+	// ----------------------------------------------------------------------
+	struct Value
+	{
+		enum Kind
+		{
+			None,
+			Bool,
+			Int,
+			Float,
+			Str,
+			List
+		};
+
+		Value() : kind( None ), i( 0 ), f( 0 ) {}
+
+		static Value makeBool( bool b ) { Value v; v.kind = Bool; v.i = b; return v; }
+		static Value makeInt( long long i ) { Value v; v.kind = Int; v.i = i; return v; }
+		static Value makeFloat( double f ) { Value v; v.kind = Float; v.f = f; return v; }
+		static Value makeStr( const std::string &s ) { Value v; v.kind = Str; v.s = s; return v; }
+		static Value makeList() { Value v; v.kind = List; return v; }
+
+		bool isIntegral() const { return (kind == Bool) || (kind == Int); }
+		bool isNumber() const { return isIntegral() || (kind == Float); }
+		double toDouble() const { return kind == Float ? f : (double)i; }
+
+		Kind kind;
+		long long i;
+		double f;
+		std::string s;
+		std::vector<Value> list;
+	};
+
+	bool truth( const Value &v )
+	{
+		switch( v.kind )
+		{
+		case Value::None: return false;
+		case Value::Bool:
+		case Value::Int: return v.i != 0;
+		case Value::Float: return v.f != 0;
+		case Value::Str: return !v.s.empty();
+		case Value::List: return !v.list.empty();
+		default: assert( false ); return false;
+		}
+	}
+
+	// Python 2 str(float): %.12g, except that exponent notation starts one
+	// digit earlier (1e+11) and ".0" is appended to integral values.
+	std::string formatFloat( double f )
+	{
+		if( isnan(f) )
+			return "nan";
+		if( isinf(f) )
+			return f < 0 ? "-inf" : "inf";
+
+		char buf[64];
+		snprintf( buf, sizeof(buf), "%.11e", f );
+		char *e = strchr( buf, 'e' );
+		if( atoi(e + 1) >= 11 )
+		{
+			// Strip trailing zeros of the mantissa, as %g does.
+			char *end = e;
+			while( end[-1] == '0' )
+				end--;
+			if( end[-1] == '.' )
+				end--;
+			memmove( end, e, strlen(e) + 1 );
+			return buf;
+		}
+
+		snprintf( buf, sizeof(buf), "%.12g", f );
+		if( !strpbrk(buf, ".e") )
+			strcat( buf, ".0" );
+		return buf;
+	}
+
+	std::string formatStr( const Value &v );
+
+	std::string formatRepr( const Value &v )
+	{
+		switch( v.kind )
+		{
+		case Value::Str:
+			for( size_t i = 0; i < v.s.length(); i++ )
+			{
+				char c = v.s[i];
+				if( (c < ' ') || (c > '~') || (c == '\'') || (c == '\\') )
+					throw Unsupported();
+			}
+			return "'" + v.s + "'";
+		case Value::Float:
+			// repr() of floats differs from str(); not worth reproducing.
+			throw Unsupported();
+		default:
+			return formatStr( v );
+		}
+	}
+
+	std::string formatStr( const Value &v )
+	{
+		switch( v.kind )
+		{
+		case Value::None: return "None";
+		case Value::Bool: return v.i ? "True" : "False";
+		case Value::Int:
+			{
+				char buf[32];
+				snprintf( buf, sizeof(buf), "%lld", v.i );
+				return buf;
+			}
+		case Value::Float: return formatFloat( v.f );
+		case Value::Str: return v.s;
+		case Value::List:
+			{
+				std::string result = "[";
+				for( size_t i = 0; i < v.list.size(); i++ )
+				{
+					if( i > 0 )
+						result += ", ";
+					result += formatRepr( v.list[i] );
+				}
+				return result + "]";
+			}
+		default: assert( false ); return "";
+		}
+	}
+
+	// ----------------------------------------------------------------------
+	// ----------------------------------------------------------------------
+	// --- Operators
+	// ----------------------------------------------------------------------
+	// ----------------------------------------------------------------------
+	void checkSequenceLength( size_t n )
+	{
+		if( n > MaxSequenceLength )
+			throw Unsupported();
+	}
+
+	// Python compares ints and floats exactly; stay within the range where
+	// converting the int to double is exact.
+	void checkExactDouble( const Value &a )
+	{
+		if( a.isIntegral() && ((a.i > (1LL << 53)) || (a.i < -(1LL << 53))) )
+			throw Unsupported();
+	}
+
+	bool equal( const Value &a, const Value &b )
+	{
+		if( a.isNumber() && b.isNumber() )
+		{
+			if( a.isIntegral() && b.isIntegral() )
+				return a.i == b.i;
+			checkExactDouble( a );
+			checkExactDouble( b );
+			return a.toDouble() == b.toDouble();
+		}
+		if( a.kind != b.kind )
+			return false;
+
+		switch( a.kind )
+		{
+		case Value::None: return true;
+		case Value::Str: return a.s == b.s;
+		case Value::List:
+			if( a.list.size() != b.list.size() )
+				return false;
+			for( size_t i = 0; i < a.list.size(); i++ )
+				if( !equal(a.list[i], b.list[i]) )
+					return false;
+			return true;
+		default: assert( false ); return false;
+		}
+	}
+
+	bool less( const Value &a, const Value &b )
+	{
+		if( a.isNumber() && b.isNumber() )
+		{
+			if( a.isIntegral() && b.isIntegral() )
+				return a.i < b.i;
+			checkExactDouble( a );
+			checkExactDouble( b );
+			return a.toDouble() < b.toDouble();
+		}
+		// Python 2 orders mismatched types by type name; don't go there.
+		if( a.kind != b.kind )
+			throw Unsupported();
+
+		switch( a.kind )
+		{
+		case Value::Str: return a.s < b.s;
+		case Value::List:
+			for( size_t i = 0; (i < a.list.size()) && (i < b.list.size()); i++ )
+				if( !equal(a.list[i], b.list[i]) )
+					return less( a.list[i], b.list[i] );
+			return a.list.size() < b.list.size();
+		default: throw Unsupported();
+		}
+	}
+
+	bool contains( const Value &container, const Value &item )
+	{
+		switch( container.kind )
+		{
+		case Value::Str:
+			if( item.kind != Value::Str )
+				throw Unsupported();
+			return container.s.find( item.s ) != std::string::npos;
+		case Value::List:
+			for( size_t i = 0; i < container.list.size(); i++ )
+				if( equal(item, container.list[i]) )
+					return true;
+			return false;
+		default:
+			throw Unsupported();
+		}
+	}
+
+	Value repeat( const Value &seq, long long n )
+	{
+		Value result = seq.kind == Value::Str ? Value::makeStr( "" ) : Value::makeList();
+		if( n <= 0 )
+			return result;
+
+		size_t len = seq.kind == Value::Str ? seq.s.length() : seq.list.size();
+		if( (len > 0) && ((unsigned long long)n > MaxSequenceLength / len) )
+			throw Unsupported();
+
+		for( long long i = 0; i < n; i++ )
+		{
+			if( seq.kind == Value::Str )
+				result.s += seq.s;
+			else
+				result.list.insert( result.list.end(), seq.list.begin(), seq.list.end() );
+		}
+		return result;
+	}
+
+	Value intPow( long long base, long long exp )
+	{
+		long long result = 1;
+		while( exp > 0 )
+		{
+			if( exp & 1 )
+			{
+				if( __builtin_mul_overflow(result, base, &result) )
+					throw Unsupported();
+			}
+			exp >>= 1;
+			if( (exp > 0) && __builtin_mul_overflow(base, base, &base) )
+				throw Unsupported();
+		}
+		return Value::makeInt( result );
+	}
+
+	Value floatPow( double base, double exp )
+	{
+		if( !isfinite(base) || !isfinite(exp) )
+			throw Unsupported();
+		if( exp == 0 )
+			return Value::makeFloat( 1.0 );
+		if( (base == 0) && (exp < 0) )
+			throw Unsupported(); // ZeroDivisionError
+		if( (base < 0) && (exp != floor(exp)) )
+			throw Unsupported(); // ValueError
+
+		double result = pow( base, exp );
+		if( !isfinite(result) )
+			throw Unsupported(); // OverflowError
+		return Value::makeFloat( result );
+	}
+
+	// Python's float divmod(), from which both // and % are derived.
+	void floatDivmod( double vx, double wx, double &floordiv, double &mod )
+	{
+		if( wx == 0 )
+			throw Unsupported(); // ZeroDivisionError
+
+		mod = fmod( vx, wx );
+		double div = (vx - mod) / wx;
+		if( mod )
+		{
+			if( (wx < 0) != (mod < 0) )
+			{
+				mod += wx;
+				div -= 1.0;
+			}
+		}
+		else
+			mod = copysign( 0.0, wx );
+
+		if( div )
+		{
+			floordiv = floor( div );
+			if( div - floordiv > 0.5 )
+				floordiv += 1.0;
+		}
+		else
+			floordiv = copysign( 0.0, vx / wx );
+	}
+
+	Value arithmetic( const std::string &op, const Value &a, const Value &b )
+	{
+		if( a.isNumber() && b.isNumber() )
+		{
+			if( a.isIntegral() && b.isIntegral() )
+			{
+				long long x = a.i, y = b.i, r;
+
+				if( op == "+" )
+				{
+					if( __builtin_add_overflow(x, y, &r) )
+						throw Unsupported();
+					return Value::makeInt( r );
+				}
+				else if( op == "-" )
+				{
+					if( __builtin_sub_overflow(x, y, &r) )
+						throw Unsupported();
+					return Value::makeInt( r );
+				}
+				else if( op == "*" )
+				{
+					if( __builtin_mul_overflow(x, y, &r) )
+						throw Unsupported();
+					return Value::makeInt( r );
+				}
+				else if( (op == "/") || (op == "//") || (op == "%") )
+				{
+					// Python 2: int / int floors, like //.
+					if( (y == 0) || ((x == LLONG_MIN) && (y == -1)) )
+						throw Unsupported();
+					long long q = x / y;
+					long long m = x % y;
+					if( (m != 0) && ((m < 0) != (y < 0)) )
+					{
+						q -= 1;
+						m += y;
+					}
+					return Value::makeInt( op == "%" ? m : q );
+				}
+				else if( op == "**" )
+				{
+					if( y < 0 )
+						return floatPow( (double)x, (double)y );
+					return intPow( x, y );
+				}
+			}
+			else
+			{
+				checkExactDouble( a );
+				checkExactDouble( b );
+				double x = a.toDouble(), y = b.toDouble();
+
+				if( op == "+" )
+					return Value::makeFloat( x + y );
+				else if( op == "-" )
+					return Value::makeFloat( x - y );
+				else if( op == "*" )
+					return Value::makeFloat( x * y );
+				else if( op == "/" )
+				{
+					if( y == 0 )
+						throw Unsupported();
+					return Value::makeFloat( x / y );
+				}
+				else if( (op == "//") || (op == "%") )
+				{
+					double floordiv, mod;
+					floatDivmod( x, y, floordiv, mod );
+					return Value::makeFloat( op == "%" ? mod : floordiv );
+				}
+				else if( op == "**" )
+					return floatPow( x, y );
+			}
+		}
+		else if( op == "+" )
+		{
+			if( (a.kind == Value::Str) && (b.kind == Value::Str) )
+			{
+				checkSequenceLength( a.s.length() + b.s.length() );
+				return Value::makeStr( a.s + b.s );
+			}
+			if( (a.kind == Value::List) && (b.kind == Value::List) )
+			{
+				checkSequenceLength( a.list.size() + b.list.size() );
+				Value result = a;
+				result.list.insert( result.list.end(), b.list.begin(), b.list.end() );
+				return result;
+			}
+		}
+		else if( op == "*" )
+		{
+			if( ((a.kind == Value::Str) || (a.kind == Value::List)) && b.isIntegral() )
+				return repeat( a, b.i );
+			if( a.isIntegral() && ((b.kind == Value::Str) || (b.kind == Value::List)) )
+				return repeat( b, a.i );
+		}
+
+		throw Unsupported();
+	}
+
+	// ----------------------------------------------------------------------
+	// ----------------------------------------------------------------------
+	// --- Evaluation Tree
+	// ----------------------------------------------------------------------
+	// ----------------------------------------------------------------------
+
+	// Loop variables of enclosing comprehensions, innermost last.
+	typedef std::vector< std::pair<std::string, Value> > Scope;
+
+	class Node
+	{
+	public:
+		virtual ~Node() {}
+		virtual Value eval( Scope &scope ) = 0;
+	};
+
+	class Literal : public Node
+	{
+	public:
+		Literal( const Value &value_ ) : value( value_ ) {}
+		virtual Value eval( Scope & ) { return value; }
+		Value value;
+	};
+
+	class Name : public Node
+	{
+	public:
+		Name( const std::string &name_ ) : name( name_ ) {}
+
+		virtual Value eval( Scope &scope )
+		{
+			for( Scope::reverse_iterator it = scope.rbegin(); it != scope.rend(); ++it )
+				if( it->first == name )
+					return it->second;
+
+			// Not a worldfile symbol, builtin value or loop variable.
+			throw Unsupported();
+		}
+
+		std::string name;
+	};
+
+	class Unary : public Node
+	{
+	public:
+		Unary( const std::string &op_, Node *operand_ ) : op( op_ ), operand( operand_ ) {}
+
+		virtual Value eval( Scope &scope )
+		{
+			Value v = operand->eval( scope );
+
+			if( op == "not" )
+				return Value::makeBool( !truth(v) );
+
+			if( v.isIntegral() )
+			{
+				if( op == "+" )
+					return Value::makeInt( v.i );
+				if( v.i == LLONG_MIN )
+					throw Unsupported();
+				return Value::makeInt( -v.i );
+			}
+			if( v.kind == Value::Float )
+				return Value::makeFloat( op == "+" ? v.f : -v.f );
+
+			throw Unsupported();
+		}
+
+		std::string op;
+		Node *operand;
+	};
+
+	class Binary : public Node
+	{
+	public:
+		Binary( const std::string &op_, Node *a_, Node *b_ ) : op( op_ ), a( a_ ), b( b_ ) {}
+
+		virtual Value eval( Scope &scope )
+		{
+			Value x = a->eval( scope );
+			Value y = b->eval( scope );
+			return arithmetic( op, x, y );
+		}
+
+		std::string op;
+		Node *a;
+		Node *b;
+	};
+
+	// 'and'/'or' yield one of their operands, not a bool.
+	class Logical : public Node
+	{
+	public:
+		Logical( bool isAnd_, Node *a_, Node *b_ ) : isAnd( isAnd_ ), a( a_ ), b( b_ ) {}
+
+		virtual Value eval( Scope &scope )
+		{
+			Value x = a->eval( scope );
+			if( truth(x) != isAnd )
+				return x;
+			return b->eval( scope );
+		}
+
+		bool isAnd;
+		Node *a;
+		Node *b;
+	};
+
+	class Compare : public Node
+	{
+	public:
+		virtual Value eval( Scope &scope )
+		{
+			Value left = operands[0]->eval( scope );
+			for( size_t i = 0; i < ops.size(); i++ )
+			{
+				Value right = operands[i + 1]->eval( scope );
+				if( !compare(ops[i], left, right) )
+					return Value::makeBool( false );
+				left = right;
+			}
+			return Value::makeBool( true );
+		}
+
+		static bool compare( const std::string &op, const Value &a, const Value &b )
+		{
+			if( op == "==" ) return equal( a, b );
+			if( op == "!=" ) return !equal( a, b );
+			if( op == "<" ) return less( a, b );
+			if( op == ">" ) return less( b, a );
+			if( op == "<=" ) return !less( b, a );
+			if( op == ">=" ) return !less( a, b );
+			if( op == "in" ) return contains( b, a );
+			if( op == "not in" ) return !contains( b, a );
+			assert( false );
+			return false;
+		}
+
+		std::vector<Node *> operands;
+		std::vector<std::string> ops;
+	};
+
+	class Conditional : public Node
+	{
+	public:
+		Conditional( Node *cond_, Node *a_, Node *b_ ) : cond( cond_ ), a( a_ ), b( b_ ) {}
+
+		virtual Value eval( Scope &scope )
+		{
+			return truth( cond->eval(scope) ) ? a->eval( scope ) : b->eval( scope );
+		}
+
+		Node *cond;
+		Node *a;
+		Node *b;
+	};
+
+	class ListDisplay : public Node
+	{
+	public:
+		virtual Value eval( Scope &scope )
+		{
+			Value result = Value::makeList();
+			for( size_t i = 0; i < elements.size(); i++ )
+				result.list.push_back( elements[i]->eval(scope) );
+			return result;
+		}
+
+		std::vector<Node *> elements;
+	};
+
+	// [element for var in iterable if cond ...], also used for generator
+	// expressions passed as the sole argument of a builtin.
+	class Comprehension : public Node
+	{
+	public:
+		struct Clause
+		{
+			bool isFor;
+			std::string var;
+			Node *expr;
+		};
+
+		virtual Value eval( Scope &scope )
+		{
+			Value result = Value::makeList();
+			size_t depth = scope.size();
+			generate( 0, scope, result );
+			scope.resize( depth );
+			return result;
+		}
+
+		void generate( size_t clause, Scope &scope, Value &result )
+		{
+			if( clause == clauses.size() )
+			{
+				result.list.push_back( element->eval(scope) );
+				checkSequenceLength( result.list.size() );
+				return;
+			}
+
+			Clause &c = clauses[clause];
+			if( c.isFor )
+			{
+				Value iterable = c.expr->eval( scope );
+				if( iterable.kind != Value::List )
+					throw Unsupported();
+
+				scope.push_back( std::make_pair(c.var, Value()) );
+				size_t slot = scope.size() - 1;
+				for( size_t i = 0; i < iterable.list.size(); i++ )
+				{
+					scope[slot].second = iterable.list[i];
+					generate( clause + 1, scope, result );
+					scope.resize( slot + 1 );
+				}
+				scope.pop_back();
+			}
+			else if( truth(c.expr->eval(scope)) )
+			{
+				generate( clause + 1, scope, result );
+			}
+		}
+
+		Node *element;
+		std::vector<Clause> clauses;
+	};
+
+	class Subscript : public Node
+	{
+	public:
+		Subscript( Node *seq_, Node *index_ ) : seq( seq_ ), index( index_ ) {}
+
+		virtual Value eval( Scope &scope )
+		{
+			Value s = seq->eval( scope );
+			Value i = index->eval( scope );
+			if( !i.isIntegral() )
+				throw Unsupported();
+
+			long long len;
+			if( s.kind == Value::Str )
+				len = s.s.length();
+			else if( s.kind == Value::List )
+				len = s.list.size();
+			else
+				throw Unsupported();
+
+			long long n = i.i < 0 ? i.i + len : i.i;
+			if( (n < 0) || (n >= len) )
+				throw Unsupported(); // IndexError
+
+			if( s.kind == Value::Str )
+				return Value::makeStr( s.s.substr(n, 1) );
+			return s.list[n];
+		}
+
+		Node *seq;
+		Node *index;
+	};
+
+	class Call : public Node
+	{
+	public:
+		Call( const std::string &name_ ) : name( name_ ) {}
+
+		static bool isBuiltin( const std::string &name )
+		{
+			static const char *builtins[] = {
+				"len", "min", "max", "abs", "int", "float", "bool", "str",
+				"sum", "range", "any", "all", "round", NULL
+			};
+			for( const char **b = builtins; *b; b++ )
+				if( name == *b )
+					return true;
+			return false;
+		}
+
+		virtual Value eval( Scope &scope )
+		{
+			std::vector<Value> a;
+			for( size_t i = 0; i < args.size(); i++ )
+				a.push_back( args[i]->eval(scope) );
+			size_t n = a.size();
+
+			if( name == "len" && n == 1 )
+			{
+				if( a[0].kind == Value::Str )
+					return Value::makeInt( a[0].s.length() );
+				if( a[0].kind == Value::List )
+					return Value::makeInt( a[0].list.size() );
+			}
+			else if( (name == "min" || name == "max") && n >= 1 )
+			{
+				const std::vector<Value> *items = &a;
+				if( n == 1 )
+				{
+					if( a[0].kind != Value::List )
+						throw Unsupported();
+					items = &a[0].list;
+				}
+				if( items->empty() )
+					throw Unsupported();
+
+				// The first of equal extremes wins.
+				size_t best = 0;
+				for( size_t i = 1; i < items->size(); i++ )
+				{
+					if( name == "min" ? less((*items)[i], (*items)[best]) : less((*items)[best], (*items)[i]) )
+						best = i;
+				}
+				return (*items)[best];
+			}
+			else if( name == "abs" && n == 1 )
+			{
+				if( a[0].isIntegral() )
+				{
+					if( a[0].i == LLONG_MIN )
+						throw Unsupported();
+					return Value::makeInt( a[0].i < 0 ? -a[0].i : a[0].i );
+				}
+				if( a[0].kind == Value::Float )
+					return Value::makeFloat( fabs(a[0].f) );
+			}
+			else if( name == "int" && n == 1 )
+			{
+				if( a[0].isIntegral() )
+					return Value::makeInt( a[0].i );
+				if( a[0].kind == Value::Float )
+				{
+					double t = trunc( a[0].f );
+					if( !(t > -9.2e18 && t < 9.2e18) )
+						throw Unsupported();
+					return Value::makeInt( (long long)t );
+				}
+				if( a[0].kind == Value::Str )
+					return Value::makeInt( parseInt(a[0].s) );
+			}
+			else if( name == "float" && n == 1 )
+			{
+				if( a[0].isNumber() )
+				{
+					checkExactDouble( a[0] );
+					return Value::makeFloat( a[0].toDouble() );
+				}
+				if( a[0].kind == Value::Str )
+					return Value::makeFloat( parseFloat(a[0].s) );
+			}
+			else if( name == "bool" && n <= 1 )
+			{
+				return Value::makeBool( n == 1 && truth(a[0]) );
+			}
+			else if( name == "str" && n <= 1 )
+			{
+				return Value::makeStr( n == 1 ? formatStr(a[0]) : "" );
+			}
+			else if( name == "sum" && (n == 1 || n == 2) )
+			{
+				if( a[0].kind != Value::List )
+					throw Unsupported();
+				Value total = n == 2 ? a[1] : Value::makeInt( 0 );
+				if( !total.isNumber() )
+					throw Unsupported();
+				for( size_t i = 0; i < a[0].list.size(); i++ )
+				{
+					if( !a[0].list[i].isNumber() )
+						throw Unsupported();
+					total = arithmetic( "+", total, a[0].list[i] );
+				}
+				return total;
+			}
+			else if( name == "range" && n >= 1 && n <= 3 )
+			{
+				for( size_t i = 0; i < n; i++ )
+					if( !a[i].isIntegral() )
+						throw Unsupported();
+				long long start = n == 1 ? 0 : a[0].i;
+				long long stop = n == 1 ? a[0].i : a[1].i;
+				long long step = n == 3 ? a[2].i : 1;
+				if( step == 0 )
+					throw Unsupported();
+
+				Value result = Value::makeList();
+				for( long long i = start; step > 0 ? i < stop : i > stop; i += step )
+				{
+					result.list.push_back( Value::makeInt(i) );
+					checkSequenceLength( result.list.size() );
+				}
+				return result;
+			}
+			else if( (name == "any" || name == "all") && n == 1 )
+			{
+				if( a[0].kind != Value::List )
+					throw Unsupported();
+				bool isAny = name == "any";
+				for( size_t i = 0; i < a[0].list.size(); i++ )
+					if( truth(a[0].list[i]) == isAny )
+						return Value::makeBool( isAny );
+				return Value::makeBool( !isAny );
+			}
+			else if( name == "round" && n == 1 )
+			{
+				// Python 2 rounds half away from zero and returns a float.
+				if( a[0].isNumber() )
+				{
+					checkExactDouble( a[0] );
+					return Value::makeFloat( round(a[0].toDouble()) );
+				}
+			}
+
+			throw Unsupported();
+		}
+
+		static std::string strip( const std::string &s )
+		{
+			size_t begin = s.find_first_not_of( " \t\n\r\f\v" );
+			if( begin == std::string::npos )
+				return "";
+			size_t end = s.find_last_not_of( " \t\n\r\f\v" );
+			return s.substr( begin, end - begin + 1 );
+		}
+
+		static long long parseInt( const std::string &str )
+		{
+			std::string s = strip( str );
+			size_t i = (s[0] == '-' || s[0] == '+') ? 1 : 0;
+			if( i == s.length() )
+				throw Unsupported();
+			for( size_t j = i; j < s.length(); j++ )
+				if( s[j] < '0' || s[j] > '9' )
+					throw Unsupported();
+
+			errno = 0;
+			long long result = strtoll( s.c_str(), NULL, 10 );
+			if( errno )
+				throw Unsupported();
+			return result;
+		}
+
+		static double parseFloat( const std::string &str )
+		{
+			std::string s = strip( str );
+			if( s.empty() || s.find_first_not_of("0123456789.eE+-") != std::string::npos )
+				throw Unsupported();
+
+			char *end;
+			double result = strtod( s.c_str(), &end );
+			if( *end != '\0' || !isfinite(result) )
+				throw Unsupported();
+			return result;
+		}
+
+		std::string name;
+		std::vector<Node *> args;
+	};
+
+	// ----------------------------------------------------------------------
+	// ----------------------------------------------------------------------
+	// --- Lexer
+	// ----------------------------------------------------------------------
+	// ----------------------------------------------------------------------
+	struct Token
+	{
+		enum Type
+		{
+			Number,
+			String,
+			Name,
+			Op,
+			End
+		};
+
+		Type type;
+		std::string text;
+		Value value;
+	};
+
+	class Lexer
+	{
+	public:
+		Lexer( const std::string &text ) : _text( text ), _pos( 0 ), _depth( 0 ) {}
+
+		Token next()
+		{
+			skipSpace();
+
+			Token tok;
+			if( _pos == _text.length() )
+			{
+				tok.type = Token::End;
+				return tok;
+			}
+
+			char c = _text[_pos];
+			if( isdigit(c) || (c == '.' && isdigit(peek(1))) )
+				return lexNumber();
+			if( isalpha(c) || c == '_' )
+			{
+				size_t start = _pos;
+				while( _pos < _text.length() && (isalnum(_text[_pos]) || _text[_pos] == '_') )
+					_pos++;
+				tok.type = Token::Name;
+				tok.text = _text.substr( start, _pos - start );
+				return tok;
+			}
+			if( c == '"' || c == '\'' )
+				return lexString();
+
+			static const char *ops[] = {
+				"**", "//", "==", "!=", "<=", ">=",
+				"+", "-", "*", "/", "%", "<", ">", "(", ")", "[", "]", ",", NULL
+			};
+			for( const char **op = ops; *op; op++ )
+			{
+				size_t len = strlen( *op );
+				if( _text.compare(_pos, len, *op) == 0 )
+				{
+					// '<>', bitwise operators, slices, attributes, keywords...
+					if( (len == 1) && strchr("<>", c) && (peek(1) == '<' || peek(1) == '>') )
+						throw Unsupported();
+
+					_pos += len;
+					if( c == '(' || c == '[' )
+						_depth++;
+					else if( c == ')' || c == ']' )
+						_depth--;
+					tok.type = Token::Op;
+					tok.text = *op;
+					return tok;
+				}
+			}
+
+			throw Unsupported();
+		}
+
+	private:
+		char peek( size_t offset )
+		{
+			return _pos + offset < _text.length() ? _text[_pos + offset] : '\0';
+		}
+
+		void skipSpace()
+		{
+			while( _pos < _text.length() )
+			{
+				char c = _text[_pos];
+				if( c == '#' )
+				{
+					while( _pos < _text.length() && _text[_pos] != '\n' )
+						_pos++;
+				}
+				else if( c == '\\' && peek(1) == '\n' )
+				{
+					_pos += 2;
+				}
+				else if( c == '\n' && _depth == 0 )
+				{
+					// Python only accepts a newline outside of brackets at the end.
+					size_t p = _pos;
+					while( p < _text.length() && isspace(_text[p]) )
+						p++;
+					if( p < _text.length() )
+						throw Unsupported();
+					_pos = p;
+				}
+				else if( isspace(c) )
+				{
+					_pos++;
+				}
+				else
+					break;
+			}
+		}
+
+		Token lexNumber()
+		{
+			size_t start = _pos;
+			bool isFloat = false;
+
+			while( isdigit(peek(0)) )
+				_pos++;
+			if( peek(0) == '.' )
+			{
+				isFloat = true;
+				_pos++;
+				while( isdigit(peek(0)) )
+					_pos++;
+			}
+			if( peek(0) == 'e' || peek(0) == 'E' )
+			{
+				size_t exp = _pos + 1;
+				if( exp < _text.length() && (_text[exp] == '+' || _text[exp] == '-') )
+					exp++;
+				if( exp < _text.length() && isdigit(_text[exp]) )
+				{
+					isFloat = true;
+					_pos = exp;
+					while( isdigit(peek(0)) )
+						_pos++;
+				}
+			}
+			// Long, imaginary, hex...
+			if( isalnum(peek(0)) || peek(0) == '_' )
+				throw Unsupported();
+
+			Token tok;
+			tok.type = Token::Number;
+			tok.text = _text.substr( start, _pos - start );
+
+			if( isFloat )
+			{
+				tok.value = Value::makeFloat( strtod(tok.text.c_str(), NULL) );
+			}
+			else
+			{
+				// Python 2 octal.
+				if( tok.text.length() > 1 && tok.text[0] == '0' )
+					throw Unsupported();
+				errno = 0;
+				long long i = strtoll( tok.text.c_str(), NULL, 10 );
+				if( errno )
+					throw Unsupported();
+				tok.value = Value::makeInt( i );
+			}
+
+			return tok;
+		}
+
+		Token lexString()
+		{
+			char quote = _text[_pos];
+			if( peek(1) == quote && peek(2) == quote )
+				throw Unsupported();
+
+			std::string s;
+			for( _pos++; ; _pos++ )
+			{
+				if( _pos == _text.length() )
+					throw Unsupported();
+
+				char c = _text[_pos];
+				if( c == quote )
+					break;
+				else if( c == '\n' )
+					throw Unsupported();
+				else if( c == '\\' )
+				{
+					switch( peek(1) )
+					{
+					case '\\': s += '\\'; break;
+					case '\'': s += '\''; break;
+					case '"': s += '"'; break;
+					case 'n': s += '\n'; break;
+					case 't': s += '\t'; break;
+					default: throw Unsupported();
+					}
+					_pos++;
+				}
+				else
+					s += c;
+			}
+			_pos++;
+
+			Token tok;
+			tok.type = Token::String;
+			tok.value = Value::makeStr( s );
+			return tok;
+		}
+
+		const std::string &_text;
+		size_t _pos;
+		int _depth;
+	};
+
+	// ----------------------------------------------------------------------
+	// ----------------------------------------------------------------------
+	// --- Parser
+	// ---
+	// --- Recursive descent over Python's expression grammar, from 'test'
+	// --- down to 'atom'.
+	// ----------------------------------------------------------------------
+	// ----------------------------------------------------------------------
+	class Parser
+	{
+	public:
+		Parser( const std::string &text ) : _lexer( text )
+		{
+			advance();
+		}
+
+		Node *parse()
+		{
+			Node *result = parseTest();
+			if( _tok.type != Token::End )
+				throw Unsupported();
+			return result;
+		}
+
+	private:
+		template<typename T>
+		T *make( T *node )
+		{
+			_nodes.push_back( std::unique_ptr<Node>(node) );
+			return node;
+		}
+
+		void advance()
+		{
+			_tok = _lexer.next();
+		}
+
+		bool isOp( const char *op )
+		{
+			return _tok.type == Token::Op && _tok.text == op;
+		}
+
+		bool isKeyword( const char *keyword )
+		{
+			return _tok.type == Token::Name && _tok.text == keyword;
+		}
+
+		void expectOp( const char *op )
+		{
+			if( !isOp(op) )
+				throw Unsupported();
+			advance();
+		}
+
+		static bool isReserved( const std::string &name )
+		{
+			static const char *reserved[] = {
+				"and", "or", "not", "if", "else", "for", "in", "is", "lambda", "None", "True", "False", NULL
+			};
+			for( const char **r = reserved; *r; r++ )
+				if( name == *r )
+					return true;
+			return false;
+		}
+
+		// test: or_test ['if' or_test 'else' test]
+		Node *parseTest()
+		{
+			Node *a = parseOrTest();
+			if( isKeyword("if") )
+			{
+				advance();
+				Node *cond = parseOrTest();
+				if( !isKeyword("else") )
+					throw Unsupported();
+				advance();
+				Node *b = parseTest();
+				return make( new Conditional(cond, a, b) );
+			}
+			return a;
+		}
+
+		Node *parseOrTest()
+		{
+			Node *a = parseAndTest();
+			while( isKeyword("or") )
+			{
+				advance();
+				a = make( new Logical(false, a, parseAndTest()) );
+			}
+			return a;
+		}
+
+		Node *parseAndTest()
+		{
+			Node *a = parseNotTest();
+			while( isKeyword("and") )
+			{
+				advance();
+				a = make( new Logical(true, a, parseNotTest()) );
+			}
+			return a;
+		}
+
+		Node *parseNotTest()
+		{
+			if( isKeyword("not") )
+			{
+				advance();
+				return make( new Unary("not", parseNotTest()) );
+			}
+			return parseComparison();
+		}
+
+		Node *parseComparison()
+		{
+			Node *a = parseArith();
+
+			Compare *compare = NULL;
+			for( ;; )
+			{
+				std::string op;
+				if( _tok.type == Token::Op
+					&& (_tok.text == "<" || _tok.text == ">" || _tok.text == "==" || _tok.text == "!="
+						|| _tok.text == "<=" || _tok.text == ">=") )
+				{
+					op = _tok.text;
+					advance();
+				}
+				else if( isKeyword("in") )
+				{
+					op = "in";
+					advance();
+				}
+				else if( isKeyword("not") )
+				{
+					advance();
+					if( !isKeyword("in") )
+						throw Unsupported();
+					op = "not in";
+					advance();
+				}
+				else
+					break;
+
+				if( !compare )
+				{
+					compare = make( new Compare() );
+					compare->operands.push_back( a );
+				}
+				compare->ops.push_back( op );
+				compare->operands.push_back( parseArith() );
+			}
+
+			return compare ? compare : a;
+		}
+
+		Node *parseArith()
+		{
+			Node *a = parseTerm();
+			while( isOp("+") || isOp("-") )
+			{
+				std::string op = _tok.text;
+				advance();
+				a = make( new Binary(op, a, parseTerm()) );
+			}
+			return a;
+		}
+
+		Node *parseTerm()
+		{
+			Node *a = parseFactor();
+			while( isOp("*") || isOp("/") || isOp("//") || isOp("%") )
+			{
+				std::string op = _tok.text;
+				advance();
+				a = make( new Binary(op, a, parseFactor()) );
+			}
+			return a;
+		}
+
+		Node *parseFactor()
+		{
+			if( isOp("+") || isOp("-") )
+			{
+				std::string op = _tok.text;
+				advance();
+				return make( new Unary(op, parseFactor()) );
+			}
+			return parsePower();
+		}
+
+		// power: atom trailer* ['**' factor]
+		Node *parsePower()
+		{
+			Node *a = parseAtom();
+			while( isOp("[") )
+			{
+				advance();
+				Node *index = parseTest();
+				expectOp( "]" );
+				a = make( new Subscript(a, index) );
+			}
+			if( isOp("**") )
+			{
+				advance();
+				a = make( new Binary("**", a, parseFactor()) );
+			}
+			return a;
+		}
+
+		Node *parseAtom()
+		{
+			Token tok = _tok;
+
+			switch( tok.type )
+			{
+			case Token::Number:
+				advance();
+				return make( new Literal(tok.value) );
+			case Token::String:
+				{
+					// Adjacent literals concatenate.
+					Value value = tok.value;
+					advance();
+					while( _tok.type == Token::String )
+					{
+						value.s += _tok.value.s;
+						advance();
+					}
+					return make( new Literal(value) );
+				}
+			case Token::Name:
+				advance();
+				if( tok.text == "True" )
+					return make( new Literal(Value::makeBool(true)) );
+				if( tok.text == "False" )
+					return make( new Literal(Value::makeBool(false)) );
+				if( tok.text == "None" )
+					return make( new Literal(Value()) );
+				if( isReserved(tok.text) )
+					throw Unsupported();
+				if( isOp("(") )
+					return parseCall( tok.text );
+				return make( new Name(tok.text) );
+			case Token::Op:
+				if( tok.text == "(" )
+				{
+					advance();
+					Node *inner = parseTest();
+					// Tuples and generator expressions aren't supported.
+					expectOp( ")" );
+					return inner;
+				}
+				else if( tok.text == "[" )
+				{
+					advance();
+					return parseList();
+				}
+				throw Unsupported();
+			default:
+				throw Unsupported();
+			}
+		}
+
+		Node *parseList()
+		{
+			ListDisplay *list = make( new ListDisplay() );
+			if( isOp("]") )
+			{
+				advance();
+				return list;
+			}
+
+			Node *first = parseTest();
+			if( isKeyword("for") )
+			{
+				Node *comprehension = parseComprehension( first );
+				expectOp( "]" );
+				return comprehension;
+			}
+
+			list->elements.push_back( first );
+			while( isOp(",") )
+			{
+				advance();
+				if( isOp("]") )
+					break;
+				list->elements.push_back( parseTest() );
+			}
+			expectOp( "]" );
+			return list;
+		}
+
+		Node *parseComprehension( Node *element )
+		{
+			Comprehension *comprehension = make( new Comprehension() );
+			comprehension->element = element;
+
+			while( isKeyword("for") || isKeyword("if") )
+			{
+				Comprehension::Clause clause;
+				clause.isFor = isKeyword( "for" );
+				advance();
+
+				if( clause.isFor )
+				{
+					if( _tok.type != Token::Name || isReserved(_tok.text) )
+						throw Unsupported();
+					clause.var = _tok.text;
+					advance();
+					if( !isKeyword("in") )
+						throw Unsupported();
+					advance();
+				}
+				clause.expr = parseOrTest();
+
+				comprehension->clauses.push_back( clause );
+			}
+
+			return comprehension;
+		}
+
+		Node *parseCall( const std::string &name )
+		{
+			if( !Call::isBuiltin(name) )
+				throw Unsupported();
+
+			Call *call = make( new Call(name) );
+			expectOp( "(" );
+			if( isOp(")") )
+			{
+				advance();
+				return call;
+			}
+
+			Node *first = parseTest();
+			if( isKeyword("for") )
+			{
+				// Only where a generator behaves like the equivalent list.
+				if( name != "sum" && name != "min" && name != "max" && name != "any" && name != "all" )
+					throw Unsupported();
+				call->args.push_back( parseComprehension(first) );
+				expectOp( ")" );
+				return call;
+			}
+
+			call->args.push_back( first );
+			while( isOp(",") )
+			{
+				advance();
+				if( isOp(")") )
+					break;
+				call->args.push_back( parseTest() );
+			}
+			expectOp( ")" );
+			return call;
+		}
+
+		Lexer _lexer;
+		Token _tok;
+		std::vector< std::unique_ptr<Node> > _nodes;
+	};
+}
+
+// ----------------------------------------------------------------------
+// ----------------------------------------------------------------------
+// --- CLASS PyEvaluator
+// ----------------------------------------------------------------------
+// ----------------------------------------------------------------------
+bool PyEvaluator::eval( const std::string &expr, std::string &result )
+{
+	try
+	{
+		Parser parser( expr );
+		Node *root = parser.parse();
+
+		Scope scope;
+		result = formatStr( root->eval(scope) );
+
+		return true;
+	}
+	catch( Unsupported & )
+	{
+		return false;
+	}
+}
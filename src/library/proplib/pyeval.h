@@ -0,0 +1,28 @@
+#pragma once
+
+#include <string>
+
+namespace proplib
+{
+	// ----------------------------------------------------------------------
+	// ----------------------------------------------------------------------
+	// --- CLASS PyEvaluator
+	// ---
+	// --- Evaluates worldfile/schema expressions in-process. Handles the
+	// --- subset of Python expressions that worldfiles use: int, float,
+	// --- string and bool literals, arithmetic, comparisons, and/or/not,
+	// --- conditional expressions, lists, list comprehensions, indexing and
+	// --- common builtins (len, min, max, abs, int, float, bool, str, sum,
+	// --- range, any, all, round). Semantics and str() formatting follow
+	// --- Python 2, which is what interpreter.py is run with.
+	// ----------------------------------------------------------------------
+	// ----------------------------------------------------------------------
+	class PyEvaluator
+	{
+	public:
+		// Returns false if the expression uses anything outside the supported
+		// subset or would raise in Python, in which case the caller should
+		// hand it to the real interpreter.
+		static bool eval( const std::string &expr, std::string &result );
+	};
+}
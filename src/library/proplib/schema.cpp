@@ -51,6 +51,8 @@ void SchemaDocument::init()
 
 void SchemaDocument::apply( Document *doc )
 {
+	std::lock_guard<std::recursive_mutex> lock( _applyMutex );
+
 	parseDefaults( doc );
 
 	if( doc->getp("overlay") )
@@ -66,6 +68,8 @@ void SchemaDocument::apply( Document *doc )
 
 void SchemaDocument::makePathDefaults( Document *values, SymbolPath *symbolPath )
 {
+	std::lock_guard<std::recursive_mutex> lock( _applyMutex );
+
 	parseDefaults( values );
 	makePathDefaults( *this, *values, symbolPath->head );
 }
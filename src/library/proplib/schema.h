@@ -1,6 +1,7 @@
 #pragma once
 
 #include <list>
+#include <mutex>
 #include <set>
 
 #include "dom.h"
@@ -25,6 +26,8 @@ namespace proplib
 
 		virtual ~SchemaDocument();
 
+		// Applying points the schema at the document (see setSchema()), so
+		// simulations sharing a schema apply it one at a time.
 		void apply( Document *doc );
 		void makePathDefaults( Document *values, SymbolPath *symbolPath );
 
@@ -49,5 +52,7 @@ namespace proplib
 		Property *createDefault( Property &schema );
 
 		std::list<std::string> _defaults;
+		// Recursive, as an embedded overlay makes path defaults mid-apply.
+		std::recursive_mutex _applyMutex;
 	};
 }
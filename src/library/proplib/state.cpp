@@ -1,6 +1,7 @@
 #include "state.h"
 
 #include "sim/Simulation.h"
+#include "sim/SimulationContext.h"
 
 using namespace proplib;
 
@@ -11,12 +12,12 @@ using namespace proplib;
 // ----------------------------------------------------------------------
 CppProperties::UpdateContext *__StateObject::getUpdateContext()
 {
-	return CppProperties::_context;
+	return CppProperties::state().context;
 }
 
 long __StateObject::getStep()
 {
-	return CppProperties::_context->sim->getStep();
+	return CppProperties::state().context->sim->getStep();
 }
 
 
@@ -64,30 +65,35 @@ bool Periodic::update()
 // ----------------------------------------------------------------------
 // ----------------------------------------------------------------------
 
-int FoodPatchTokenRing::_maxPopulation = -1;
-int FoodPatchTokenRing::_timeout = -1;
-int FoodPatchTokenRing::_delay = -1;
-long FoodPatchTokenRing::_step = -1;
-long FoodPatchTokenRing::_delayEnd = -1;
-std::vector<FoodPatchTokenRing::Member *> FoodPatchTokenRing::_members;
-FoodPatchTokenRing::Member *FoodPatchTokenRing::_active = NULL;
+FoodPatchTokenRing::Ring::~Ring()
+{
+	itfor( std::vector<Member *>, members, it )
+		delete *it;
+}
+
+FoodPatchTokenRing::Ring &FoodPatchTokenRing::ring()
+{
+	return SimulationContext::current()->get<Ring>();
+}
 
 void FoodPatchTokenRing::add( FoodPatch &patch, int maxPopulation, int timeout, int delay )
 {
+	Ring &r = ring();
+
 	if( maxPopulation != -1 )
 	{
-		assert( (_maxPopulation == -1) || (_maxPopulation == maxPopulation) );
-		_maxPopulation = maxPopulation;
+		assert( (r.maxPopulation == -1) || (r.maxPopulation == maxPopulation) );
+		r.maxPopulation = maxPopulation;
 	}
 	if( timeout != -1 )
 	{
-		assert( (_timeout == -1) || (_timeout == timeout) );
-		_timeout = timeout;
+		assert( (r.timeout == -1) || (r.timeout == timeout) );
+		r.timeout = timeout;
 	}
 	if( delay != -1 )
 	{
-		assert( (_delay == -1) || (_delay == delay) );
-		_delay = delay;
+		assert( (r.delay == -1) || (r.delay == delay) );
+		r.delay = delay;
 	}
 
 	Member *member = new Member();
@@ -95,51 +101,53 @@ void FoodPatchTokenRing::add( FoodPatch &patch, int maxPopulation, int timeout,
 	member->start = -1;
 	member->end = -1;
 
-	_members.push_back( member );
+	r.members.push_back( member );
 }
 
 bool FoodPatchTokenRing::update( FoodPatch &patch )
 {
-	if( _step != getStep() )
+	Ring &r = ring();
+
+	if( r.step != getStep() )
 	{
-		if( _step == 1 )
+		if( r.step == 1 )
 		{
-			assert( (_maxPopulation > 0) || (_timeout > 0) );
-			assert( _members.size() > 1 );
+			assert( (r.maxPopulation > 0) || (r.timeout > 0) );
+			assert( r.members.size() > 1 );
 		}
 
-		updateActive();
+		updateActive( r );
 	}
 
-	return _active && _active->patch ==  &patch;
+	return r.active && r.active->patch ==  &patch;
 }
 
-void FoodPatchTokenRing::updateActive()
+void FoodPatchTokenRing::updateActive( Ring &r )
 {
-	_step = getStep();
+	r.step = getStep();
 
-	if( _step == 1 )
+	if( r.step == 1 )
 	{
-		findActive( false, NULL );
+		findActive( r, false, NULL );
 	}
-	else if( _step == _delayEnd )
+	else if( r.step == r.delayEnd )
 	{
-		_delayEnd = -1;
-		findActive( true, NULL );
+		r.delayEnd = -1;
+		findActive( r, true, NULL );
 	}
-	else if( _active )
+	else if( r.active )
 	{
 		bool find = false;
 		bool findImmediate;
 		bool killAgents;
 
-		if( (_timeout > 0) && ((_step - _active->start) >= _timeout) )
+		if( (r.timeout > 0) && ((r.step - r.active->start) >= r.timeout) )
 		{
 			find = true;
 			findImmediate = true;
 			killAgents = false;
 		}
-		else if( (_maxPopulation > 0) && (_active->patch->agentInsideCount >= _maxPopulation) )
+		else if( (r.maxPopulation > 0) && (r.active->patch->agentInsideCount >= r.maxPopulation) )
 		{
 			find = true;
 			findImmediate = false;
@@ -148,28 +156,28 @@ void FoodPatchTokenRing::updateActive()
 
 		if( find )
 		{
-			_active->start = -1;
-			_active->end = _step;
+			r.active->start = -1;
+			r.active->end = r.step;
 
-			if( (_delay <= 0) || findImmediate )
+			if( (r.delay <= 0) || findImmediate )
 			{
-				_delayEnd = -1;
-				findActive( killAgents, _active );
+				r.delayEnd = -1;
+				findActive( r, killAgents, r.active );
 			}
 			else
 			{
-				_delayEnd = _step + _delay;
-				_active = NULL;
+				r.delayEnd = r.step + r.delay;
+				r.active = NULL;
 			}
 		}
 	}
 }
 
-void FoodPatchTokenRing::findActive( bool killAgents, Member *exclude )
+void FoodPatchTokenRing::findActive( Ring &r, bool killAgents, Member *exclude )
 {
 	Member *minMember = NULL;
 
-    itfor( std::vector<Member *>, _members, it )
+    itfor( std::vector<Member *>, r.members, it )
 	{
 		Member *member = *it;
 		if( !exclude || (member != exclude) )
@@ -192,17 +200,17 @@ void FoodPatchTokenRing::findActive( bool killAgents, Member *exclude )
 
 	assert( minMember );
 
-	_active = minMember;
-	_active->start = _step;
+	r.active = minMember;
+	r.active->start = r.step;
 
 	// Kill agents in new patch.
 	if( killAgents )
 	{
-		FoodPatch *newPatch = _active->patch;
+		FoodPatch *newPatch = r.active->patch;
 
 		agent *a;
-		objectxsortedlist::gXSortedObjects.reset();
-		while (objectxsortedlist::gXSortedObjects.nextObj(AGENTTYPE, (gobject**)&a))
+		objectxsortedlist::gXSortedObjects().reset();
+		while (objectxsortedlist::gXSortedObjects().nextObj(AGENTTYPE, (gobject**)&a))
 		{
 			if( newPatch->pointIsInside( a->x(), a->z(), 5 ) )
 			{
@@ -55,17 +55,24 @@ namespace proplib
 				int start;
 				int end;
 			};
-			static void updateActive();
-			static void findActive( bool killAgents, Member *exclude );
+			// Each simulation has its own ring.
+			struct Ring
+			{
+				~Ring();
+
+				int maxPopulation = -1;
+				int timeout = -1;
+				int delay = -1;
 
-			static int _maxPopulation;
-			static int _timeout;
-			static int _delay;
+				long step = -1;
+				long delayEnd = -1;
+				std::vector<Member *> members;
+				Member *active = NULL;
+			};
 
-			static long _step;
-			static long _delayEnd;
-			static std::vector<Member *> _members;
-			static Member *_active;
+			static Ring &ring();
+			static void updateActive( Ring &r );
+			static void findActive( Ring &r, bool killAgents, Member *exclude );
 		};
 
 }
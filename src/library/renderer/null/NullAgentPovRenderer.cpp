@@ -0,0 +1,27 @@
+#include "NullAgentPovRenderer.h"
+
+#include <assert.h>
+
+#include "agent/agent.h"
+#include "utils/error.h"
+
+//---------------------------------------------------------------------------
+// AgentPovRenderer::create
+//---------------------------------------------------------------------------
+AgentPovRenderer *AgentPovRenderer::create( int maxAgents,
+                                            int retinaWidth,
+                                            int retinaHeight )
+{
+    if( agent::config().vision )
+        error( 2, "Vision requires a renderer; this is a headless build (set Vision False)" );
+
+    return new NullAgentPovRenderer();
+}
+
+//---------------------------------------------------------------------------
+// NullAgentPovRenderer::render
+//---------------------------------------------------------------------------
+void NullAgentPovRenderer::render( agent *a )
+{
+    assert( false );
+}
@@ -0,0 +1,21 @@
+#pragma once
+
+#include "agent/AgentPovRenderer.h"
+#include "library_global.h"
+
+//---------------------------------------------------------------------------
+// NullAgentPovRenderer
+//
+// Used by headless builds. Only valid for worldfiles with Vision disabled,
+// in which case no agent is ever rendered.
+//---------------------------------------------------------------------------
+class LIBRARY_SHARED NullAgentPovRenderer : public AgentPovRenderer
+{
+ public:
+    virtual void add( class agent *a ) override {}
+    virtual void remove( class agent *a ) override {}
+
+    virtual void beginStep() override {}
+    virtual void render( class agent *a ) override;
+    virtual void endStep() override { renderComplete(); }
+};
@@ -13,6 +13,7 @@
 // SceneRenderer::create
 //---------------------------------------------------------------------------
 SceneRenderer *SceneRenderer::create( gstage &stage,
+                                      WorldSnapshotBuffer &snapshots,
                                       const CameraProperties &cameraProps,
                                       int width,
                                       int height )
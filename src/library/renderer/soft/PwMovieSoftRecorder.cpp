@@ -0,0 +1,54 @@
+#include "PwMovieSoftRecorder.h"
+
+#include <stdlib.h>
+#include <string.h>
+
+#include "SoftSceneRenderer.h"
+
+//===========================================================================
+// PwMovieSoftRecorder
+//===========================================================================
+
+//---------------------------------------------------------------------------
+// PwMovieSoftRecorder::PwMovieSoftRecorder
+//---------------------------------------------------------------------------
+PwMovieSoftRecorder::PwMovieSoftRecorder( SoftSceneRenderer *renderer,
+                                          PwMovieWriter *writer )
+{
+    this->renderer = renderer;
+    this->writer = writer;
+
+    width = renderer->getBufferWidth();
+    height = renderer->getBufferHeight();
+
+    rgbBufOld = (uint32_t *)calloc( width * height, sizeof(*rgbBufOld) );
+}
+
+//---------------------------------------------------------------------------
+// PwMovieSoftRecorder::~PwMovieSoftRecorder
+//---------------------------------------------------------------------------
+PwMovieSoftRecorder::~PwMovieSoftRecorder()
+{
+    // Frames already queued still refer to us.
+    renderer->finish();
+
+    free( rgbBufOld );
+}
+
+//---------------------------------------------------------------------------
+// PwMovieSoftRecorder::recordFrame
+//---------------------------------------------------------------------------
+void PwMovieSoftRecorder::recordFrame( uint32_t timestep )
+{
+    renderer->recordFrame( this, timestep );
+}
+
+//---------------------------------------------------------------------------
+// PwMovieSoftRecorder::writeFrame
+//---------------------------------------------------------------------------
+void PwMovieSoftRecorder::writeFrame( uint32_t timestep, const uint32_t *rgbBuf )
+{
+    writer->writeFrame( timestep, width, height, rgbBufOld, const_cast<uint32_t *>(rgbBuf) );
+
+    memcpy( rgbBufOld, rgbBuf, width * height * sizeof(*rgbBufOld) );
+}
@@ -0,0 +1,29 @@
+#pragma once
+
+#include "monitor/MovieRecorder.h"
+#include "utils/PwMovieUtils.h"
+
+//===========================================================================
+// PwMovieSoftRecorder
+//
+// Records frames drawn by a SoftSceneRenderer. recordFrame() only marks the
+// frame being captured; its pixels arrive later through writeFrame(), on the
+// renderer's thread.
+//===========================================================================
+class PwMovieSoftRecorder : public MovieRecorder
+{
+ public:
+    PwMovieSoftRecorder( class SoftSceneRenderer *renderer, PwMovieWriter *writer );
+    virtual ~PwMovieSoftRecorder();
+
+    virtual void recordFrame( uint32_t timestep ) override;
+
+    void writeFrame( uint32_t timestep, const uint32_t *rgbBuf );
+
+ private:
+    class SoftSceneRenderer *renderer;
+    PwMovieWriter *writer;
+    uint32_t width;
+    uint32_t height;
+    uint32_t *rgbBufOld;
+};
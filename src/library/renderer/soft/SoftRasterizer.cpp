@@ -0,0 +1,426 @@
+#include "SoftRasterizer.h"
+
+#include <math.h>
+
+#include <algorithm>
+
+// glClearColor( 0, 0, 0, 1 )
+static const uint32_t ClearColor = 0xff000000;
+
+//---------------------------------------------------------------------------
+// pack
+//---------------------------------------------------------------------------
+static uint32_t pack( float r, float g, float b )
+{
+    uint32_t ir = (uint32_t)(std::min( std::max(r, 0.0f), 1.0f ) * 255.0f + 0.5f);
+    uint32_t ig = (uint32_t)(std::min( std::max(g, 0.0f), 1.0f ) * 255.0f + 0.5f);
+    uint32_t ib = (uint32_t)(std::min( std::max(b, 0.0f), 1.0f ) * 255.0f + 0.5f);
+
+    return ir | (ig << 8) | (ib << 16) | 0xff000000;
+}
+
+//---------------------------------------------------------------------------
+// shade
+//
+// Fog as GL computes it, with eye distance 1/invW and GL's default black fog
+// color.
+//---------------------------------------------------------------------------
+static uint32_t shade( const SoftScene::Color &color, uint32_t rgba, float invW, const SoftScene::Fog &fog )
+{
+    if( !fog.enabled )
+        return rgba;
+
+    float distance = 1.0f / invW;
+    float f;
+    if( fog.function == 'L' )
+        f = (fog.end - distance) / (fog.end - fog.start);
+    else
+        f = expf( -fog.density * distance );
+    f = std::min( std::max(f, 0.0f), 1.0f );
+
+    return pack( f * color.r, f * color.g, f * color.b );
+}
+
+//---------------------------------------------------------------------------
+// transform
+//---------------------------------------------------------------------------
+static void transform( std::vector<float> &clip, const float *m, const float *v, size_t n )
+{
+    clip.resize( 4 * n );
+    float *out = clip.data();
+
+    for( size_t i = 0; i < n; i++, v += 3, out += 4 )
+        for( int row = 0; row < 4; row++ )
+            out[row] = m[row]*v[0] + m[4 + row]*v[1] + m[8 + row]*v[2] + m[12 + row];
+}
+
+//---------------------------------------------------------------------------
+// outcode
+//
+// One bit per frustum plane the clip-space point is outside of.
+//---------------------------------------------------------------------------
+static int outcode( const float *p )
+{
+    int code = 0;
+    for( int axis = 0; axis < 3; axis++ )
+    {
+        if( p[axis] < -p[3] ) code |= 1 << (2*axis);
+        if( p[axis] > p[3] ) code |= 1 << (2*axis + 1);
+    }
+    return code;
+}
+
+// Signed distance inside frustum plane i (see outcode).
+static float planeDistance( const float *p, int plane )
+{
+    int axis = plane / 2;
+    return (plane & 1) ? p[3] - p[axis] : p[3] + p[axis];
+}
+
+//---------------------------------------------------------------------------
+// edge
+//---------------------------------------------------------------------------
+static float edge( float ax, float ay, float bx, float by, float px, float py )
+{
+    return (bx - ax) * (py - ay) - (by - ay) * (px - ax);
+}
+
+//===========================================================================
+// SoftRasterizer
+//===========================================================================
+
+//---------------------------------------------------------------------------
+// SoftRasterizer::SoftRasterizer
+//
+// The thread calling render() fills tiles too, so nthreads includes it.
+//---------------------------------------------------------------------------
+SoftRasterizer::SoftRasterizer( int width, int height, unsigned nthreads )
+    : width( width )
+    , height( height )
+    , tilesX( (width + TileSize - 1) / TileSize )
+    , tilesY( (height + TileSize - 1) / TileSize )
+    , threadPool( nthreads > 0 ? nthreads - 1 : 0 )
+    , pixels( (size_t)width * height, ClearColor )
+    , depth( (size_t)width * height, 1.0f )
+    , tileTriangles( tilesX * tilesY )
+    , tileSegments( tilesX * tilesY )
+{
+}
+
+//---------------------------------------------------------------------------
+// SoftRasterizer::render
+//---------------------------------------------------------------------------
+void SoftRasterizer::render( const SoftScene &scene )
+{
+    triangles.clear();
+    segments.clear();
+    for( int i = 0; i < tilesX * tilesY; i++ )
+    {
+        tileTriangles[i].clear();
+        tileSegments[i].clear();
+    }
+
+    for( const SoftScene::Instance &instance : scene.instances )
+    {
+        const SoftScene::Mesh &mesh = *instance.mesh;
+        transform( clipVertices, instance.modelViewProjection, mesh.vertices.data(), mesh.vertices.size() / 3 );
+
+        for( const SoftScene::Mesh::Polygon &polygon : mesh.polygons )
+            addPolygon( &clipVertices[4 * polygon.first], polygon.count, instance.colors[polygon.part] );
+    }
+
+    transform( clipVertices, scene.viewProjection, scene.vertices.data(), scene.vertices.size() / 3 );
+    for( const SoftScene::Polygon &polygon : scene.polygons )
+        addPolygon( &clipVertices[4 * polygon.first], polygon.count, polygon.color );
+
+    for( const SoftScene::Line &line : scene.lines )
+    {
+        float ends[6];
+        std::copy( line.a, line.a + 3, ends );
+        std::copy( line.b, line.b + 3, ends + 3 );
+        transform( clipVertices, scene.viewProjection, ends, 2 );
+        addLine( &clipVertices[0], &clipVertices[4], line.color );
+    }
+
+    const SoftScene::Fog &fog = scene.fog;
+    for( int tile = 0; tile < tilesX * tilesY; tile++ )
+        threadPool.schedule( [this, tile, &fog]() { renderTile( tile, fog ); } );
+    threadPool.join();
+}
+
+//---------------------------------------------------------------------------
+// SoftRasterizer::addPolygon
+//
+// Clips a convex clip-space polygon to the frustum, then fans it into
+// triangles.
+//---------------------------------------------------------------------------
+void SoftRasterizer::addPolygon( const float *clip, uint32_t n, const SoftScene::Color &color )
+{
+    if( n < 3 )
+        return;
+
+    int codeAnd = ~0;
+    int codeOr = 0;
+    for( uint32_t i = 0; i < n; i++ )
+    {
+        int code = outcode( clip + 4*i );
+        codeAnd &= code;
+        codeOr |= code;
+    }
+    if( codeAnd )
+        return;
+
+    if( codeOr )
+    {
+        clipIn.assign( clip, clip + 4*n );
+        for( int plane = 0; plane < 6; plane++ )
+        {
+            if( !(codeOr & (1 << plane)) )
+                continue;
+
+            clipOut.clear();
+            size_t count = clipIn.size() / 4;
+            for( size_t i = 0; i < count; i++ )
+            {
+                const float *p = &clipIn[4*i];
+                const float *q = &clipIn[4*((i + 1) % count)];
+                float dp = planeDistance( p, plane );
+                float dq = planeDistance( q, plane );
+
+                if( dp >= 0.0f )
+                    clipOut.insert( clipOut.end(), p, p + 4 );
+                if( (dp >= 0.0f) != (dq >= 0.0f) )
+                {
+                    float t = dp / (dp - dq);
+                    for( int k = 0; k < 4; k++ )
+                        clipOut.push_back( p[k] + t * (q[k] - p[k]) );
+                }
+            }
+            clipIn.swap( clipOut );
+        }
+
+        n = clipIn.size() / 4;
+        if( n < 3 )
+            return;
+        clip = clipIn.data();
+    }
+
+    Triangle t;
+    t.color = color;
+    t.rgba = pack( color.r, color.g, color.b );
+    toWindow( clip, t.v[0] );
+    toWindow( clip + 4, t.v[2] );
+
+    for( uint32_t i = 2; i < n; i++ )
+    {
+        t.v[1] = t.v[2];
+        toWindow( clip + 4*i, t.v[2] );
+
+        float area = edge( t.v[0].x, t.v[0].y, t.v[1].x, t.v[1].y, t.v[2].x, t.v[2].y );
+        if( area == 0.0f )
+            continue;
+
+        // Nothing is culled, so wind everything counter-clockwise.
+        Triangle ccw = t;
+        if( area < 0.0f )
+            std::swap( ccw.v[1], ccw.v[2] );
+
+        triangles.push_back( ccw );
+        bin( tileTriangles, triangles.size() - 1,
+             std::min( std::min(ccw.v[0].x, ccw.v[1].x), ccw.v[2].x ),
+             std::min( std::min(ccw.v[0].y, ccw.v[1].y), ccw.v[2].y ),
+             std::max( std::max(ccw.v[0].x, ccw.v[1].x), ccw.v[2].x ),
+             std::max( std::max(ccw.v[0].y, ccw.v[1].y), ccw.v[2].y ) );
+    }
+}
+
+//---------------------------------------------------------------------------
+// SoftRasterizer::addLine
+//---------------------------------------------------------------------------
+void SoftRasterizer::addLine( const float *clipA, const float *clipB, const SoftScene::Color &color )
+{
+    float a[4];
+    float b[4];
+    std::copy( clipA, clipA + 4, a );
+    std::copy( clipB, clipB + 4, b );
+
+    for( int plane = 0; plane < 6; plane++ )
+    {
+        float da = planeDistance( a, plane );
+        float db = planeDistance( b, plane );
+        if( (da < 0.0f) && (db < 0.0f) )
+            return;
+
+        if( (da < 0.0f) != (db < 0.0f) )
+        {
+            float t = da / (da - db);
+            float *outside = da < 0.0f ? a : b;
+            float p[4];
+            for( int k = 0; k < 4; k++ )
+                p[k] = a[k] + t * (b[k] - a[k]);
+            std::copy( p, p + 4, outside );
+        }
+    }
+
+    Segment s;
+    s.color = color;
+    s.rgba = pack( color.r, color.g, color.b );
+    toWindow( a, s.a );
+    toWindow( b, s.b );
+
+    segments.push_back( s );
+    bin( tileSegments, segments.size() - 1,
+         std::min(s.a.x, s.b.x), std::min(s.a.y, s.b.y),
+         std::max(s.a.x, s.b.x), std::max(s.a.y, s.b.y) );
+}
+
+//---------------------------------------------------------------------------
+// SoftRasterizer::toWindow
+//---------------------------------------------------------------------------
+void SoftRasterizer::toWindow( const float *clip, Vertex &v ) const
+{
+    v.invW = 1.0f / clip[3];
+    v.x = (clip[0] * v.invW + 1.0f) * 0.5f * width;
+    v.y = (clip[1] * v.invW + 1.0f) * 0.5f * height;
+    v.z = (clip[2] * v.invW + 1.0f) * 0.5f;
+}
+
+//---------------------------------------------------------------------------
+// SoftRasterizer::bin
+//---------------------------------------------------------------------------
+void SoftRasterizer::bin( std::vector<std::vector<uint32_t>> &tiles, uint32_t index,
+                          float xmin, float ymin, float xmax, float ymax )
+{
+    int tx0 = std::max( 0, (int)floorf(xmin) / TileSize );
+    int ty0 = std::max( 0, (int)floorf(ymin) / TileSize );
+    int tx1 = std::min( tilesX - 1, (int)floorf(xmax) / TileSize );
+    int ty1 = std::min( tilesY - 1, (int)floorf(ymax) / TileSize );
+
+    for( int ty = ty0; ty <= ty1; ty++ )
+        for( int tx = tx0; tx <= tx1; tx++ )
+            tiles[ty * tilesX + tx].push_back( index );
+}
+
+//---------------------------------------------------------------------------
+// SoftRasterizer::renderTile
+//---------------------------------------------------------------------------
+void SoftRasterizer::renderTile( int tile, const SoftScene::Fog &fog )
+{
+    int x0 = (tile % tilesX) * TileSize;
+    int y0 = (tile / tilesX) * TileSize;
+    int x1 = std::min( x0 + TileSize, width );
+    int y1 = std::min( y0 + TileSize, height );
+
+    for( int y = y0; y < y1; y++ )
+    {
+        std::fill( &pixels[(size_t)y * width + x0], &pixels[(size_t)y * width + x1], ClearColor );
+        std::fill( &depth[(size_t)y * width + x0], &depth[(size_t)y * width + x1], 1.0f );
+    }
+
+    for( uint32_t index : tileTriangles[tile] )
+        renderTriangle( triangles[index], fog, x0, y0, x1, y1 );
+
+    for( uint32_t index : tileSegments[tile] )
+        renderSegment( segments[index], fog, x0, y0, x1, y1 );
+}
+
+//---------------------------------------------------------------------------
+// SoftRasterizer::renderTriangle
+//
+// Samples pixel centers, with a top-left rule for pixels exactly on an edge
+// so that polygons sharing an edge don't both draw it.
+//---------------------------------------------------------------------------
+void SoftRasterizer::renderTriangle( const Triangle &t, const SoftScene::Fog &fog, int x0, int y0, int x1, int y1 )
+{
+    const Vertex *v = t.v;
+
+    int xmin = std::max( x0, (int)ceilf(std::min(std::min(v[0].x, v[1].x), v[2].x) - 0.5f) );
+    int ymin = std::max( y0, (int)ceilf(std::min(std::min(v[0].y, v[1].y), v[2].y) - 0.5f) );
+    int xmax = std::min( x1 - 1, (int)floorf(std::max(std::max(v[0].x, v[1].x), v[2].x) - 0.5f) );
+    int ymax = std::min( y1 - 1, (int)floorf(std::max(std::max(v[0].y, v[1].y), v[2].y) - 0.5f) );
+    if( (xmin > xmax) || (ymin > ymax) )
+        return;
+
+    float invArea = 1.0f / edge( v[0].x, v[0].y, v[1].x, v[1].y, v[2].x, v[2].y );
+
+    // Edge i is opposite vertex i, so its function weights that vertex.
+    float dx[3];
+    float dy[3];
+    float bias[3];
+    float e[3];
+    float px = xmin + 0.5f;
+    float py = ymin + 0.5f;
+    for( int i = 0; i < 3; i++ )
+    {
+        const Vertex &a = v[(i + 1) % 3];
+        const Vertex &b = v[(i + 2) % 3];
+        dx[i] = -(b.y - a.y);
+        dy[i] = b.x - a.x;
+        bool topLeft = (b.y < a.y) || ((b.y == a.y) && (b.x < a.x));
+        bias[i] = topLeft ? 0.0f : -1e-7f;
+        e[i] = edge( a.x, a.y, b.x, b.y, px, py );
+    }
+
+    for( int y = ymin; y <= ymax; y++ )
+    {
+        float w[3] = { e[0], e[1], e[2] };
+        size_t row = (size_t)y * width;
+
+        for( int x = xmin; x <= xmax; x++ )
+        {
+            if( (w[0] + bias[0] >= 0.0f) && (w[1] + bias[1] >= 0.0f) && (w[2] + bias[2] >= 0.0f) )
+            {
+                float l0 = w[0] * invArea;
+                float l1 = w[1] * invArea;
+                float l2 = w[2] * invArea;
+                float z = l0 * v[0].z + l1 * v[1].z + l2 * v[2].z;
+
+                if( z < depth[row + x] )
+                {
+                    depth[row + x] = z;
+                    pixels[row + x] = shade( t.color, t.rgba,
+                                             l0 * v[0].invW + l1 * v[1].invW + l2 * v[2].invW,
+                                             fog );
+                }
+            }
+
+            w[0] += dx[0];
+            w[1] += dx[1];
+            w[2] += dx[2];
+        }
+
+        e[0] += dy[0];
+        e[1] += dy[1];
+        e[2] += dy[2];
+    }
+}
+
+//---------------------------------------------------------------------------
+// SoftRasterizer::renderSegment
+//
+// One pixel wide. Passes the depth test on equality, so the outline of a
+// polygon drawn along its own edge shows.
+//---------------------------------------------------------------------------
+void SoftRasterizer::renderSegment( const Segment &s, const SoftScene::Fog &fog, int x0, int y0, int x1, int y1 )
+{
+    float dx = s.b.x - s.a.x;
+    float dy = s.b.y - s.a.y;
+    int steps = std::max( 1, (int)ceilf(std::max(fabsf(dx), fabsf(dy))) );
+
+    for( int i = 0; i <= steps; i++ )
+    {
+        float t = (float)i / steps;
+        int x = (int)floorf( s.a.x + t * dx );
+        int y = (int)floorf( s.a.y + t * dy );
+        if( (x < x0) || (x >= x1) || (y < y0) || (y >= y1) )
+            continue;
+
+        size_t index = (size_t)y * width + x;
+        float z = s.a.z + t * (s.b.z - s.a.z);
+        if( z <= depth[index] )
+        {
+            depth[index] = z;
+            pixels[index] = shade( s.color, s.rgba, s.a.invW + t * (s.b.invW - s.a.invW), fog );
+        }
+    }
+}
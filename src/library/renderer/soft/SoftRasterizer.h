@@ -0,0 +1,94 @@
+#pragma once
+
+#include <stdint.h>
+
+#include <vector>
+
+#include "SoftScene.h"
+#include "utils/ThreadPool.h"
+
+//---------------------------------------------------------------------------
+// SoftRasterizer
+//
+// Draws a SoftScene the way the GL scene renderers do: flat colors, no
+// culling, a less-than depth test, and GL's linear/exponential fog when the
+// camera has it. Polygons are clipped and binned on the calling thread, then
+// each TileSize x TileSize tile is filled by the thread pool.
+//
+// Pixels are RGBA bytes with the bottom row first, as from glReadPixels().
+//---------------------------------------------------------------------------
+class SoftRasterizer
+{
+ public:
+    static const int TileSize = 32;
+
+    SoftRasterizer( int width, int height, unsigned nthreads );
+
+    void render( const SoftScene &scene );
+
+    int getWidth() const;
+    int getHeight() const;
+    const uint32_t *getPixels() const;
+
+ private:
+    // Window coordinates plus 1/w, which fog needs for eye distance.
+    struct Vertex
+    {
+        float x;
+        float y;
+        float z;
+        float invW;
+    };
+
+    struct Triangle
+    {
+        Vertex v[3];
+        SoftScene::Color color;
+        uint32_t rgba;
+    };
+
+    struct Segment
+    {
+        Vertex a;
+        Vertex b;
+        SoftScene::Color color;
+        uint32_t rgba;
+    };
+
+    void addPolygon( const float *clip, uint32_t n, const SoftScene::Color &color );
+    void addLine( const float *clipA, const float *clipB, const SoftScene::Color &color );
+    void toWindow( const float *clip, Vertex &v ) const;
+    void bin( std::vector<std::vector<uint32_t>> &tiles, uint32_t index,
+              float xmin, float ymin, float xmax, float ymax );
+
+    void renderTile( int tile, const SoftScene::Fog &fog );
+    void renderTriangle( const Triangle &t, const SoftScene::Fog &fog, int x0, int y0, int x1, int y1 );
+    void renderSegment( const Segment &s, const SoftScene::Fog &fog, int x0, int y0, int x1, int y1 );
+
+    int width;
+    int height;
+    int tilesX;
+    int tilesY;
+
+    ThreadPool threadPool;
+
+    std::vector<uint32_t> pixels;
+    std::vector<float> depth;
+
+    std::vector<Triangle> triangles;
+    std::vector<Segment> segments;
+    std::vector<std::vector<uint32_t>> tileTriangles;
+    std::vector<std::vector<uint32_t>> tileSegments;
+
+    // Scratch space for transforming and clipping.
+    std::vector<float> clipVertices;
+    std::vector<float> clipIn;
+    std::vector<float> clipOut;
+};
+
+//===========================================================================
+// inlines
+//===========================================================================
+inline int SoftRasterizer::getWidth() const { return width; }
+inline int SoftRasterizer::getHeight() const { return height; }
+inline const uint32_t *SoftRasterizer::getPixels() const { return pixels.data(); }
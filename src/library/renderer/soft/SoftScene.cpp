@@ -0,0 +1,320 @@
+#include "SoftScene.h"
+
+#include <assert.h>
+#include <math.h>
+#include <string.h>
+
+#include "agent/agent.h"
+#include "graphics/gcamera.h"
+#include "graphics/gpolygon.h"
+#include "monitor/WorldSnapshot.h"
+
+// Faces of the unit cube, as drawn by drawunitcube().
+static const float UnitCube[6][4][3] =
+{
+    { {-0.5, -0.5, -0.5}, {-0.5, -0.5,  0.5}, {-0.5,  0.5,  0.5}, {-0.5,  0.5, -0.5} },
+    { {-0.5, -0.5, -0.5}, { 0.5, -0.5, -0.5}, { 0.5, -0.5,  0.5}, {-0.5, -0.5,  0.5} },
+    { { 0.5, -0.5, -0.5}, { 0.5,  0.5, -0.5}, { 0.5,  0.5,  0.5}, { 0.5, -0.5,  0.5} },
+    { {-0.5,  0.5, -0.5}, {-0.5,  0.5,  0.5}, { 0.5,  0.5,  0.5}, { 0.5,  0.5, -0.5} },
+    { { 0.5, -0.5,  0.5}, { 0.5,  0.5,  0.5}, {-0.5,  0.5,  0.5}, {-0.5, -0.5,  0.5} },
+    { {-0.5, -0.5, -0.5}, {-0.5,  0.5, -0.5}, { 0.5,  0.5, -0.5}, { 0.5, -0.5, -0.5} }
+};
+
+//---------------------------------------------------------------------------
+// Matrix helpers
+//
+// Column-major 4x4, each operation post-multiplying like its GL namesake.
+//---------------------------------------------------------------------------
+static void identity( float *m )
+{
+    memset( m, 0, 16 * sizeof(float) );
+    m[0] = m[5] = m[10] = m[15] = 1.0f;
+}
+
+static void multiply( float *result, const float *a, const float *b )
+{
+    float m[16];
+    for( int col = 0; col < 4; col++ )
+        for( int row = 0; row < 4; row++ )
+            m[col*4 + row] = a[row]      * b[col*4]
+                           + a[4 + row]  * b[col*4 + 1]
+                           + a[8 + row]  * b[col*4 + 2]
+                           + a[12 + row] * b[col*4 + 3];
+    memcpy( result, m, sizeof(m) );
+}
+
+static void translate( float *m, float x, float y, float z )
+{
+    float t[16];
+    identity( t );
+    t[12] = x;
+    t[13] = y;
+    t[14] = z;
+    multiply( m, m, t );
+}
+
+static void scale( float *m, float x, float y, float z )
+{
+    float s[16];
+    identity( s );
+    s[0] = x;
+    s[5] = y;
+    s[10] = z;
+    multiply( m, m, s );
+}
+
+// Rotation about a principal axis (0 = x, 1 = y, 2 = z).
+static void rotate( float *m, float degrees, int axis )
+{
+    if( degrees == 0.0f )
+        return;
+
+    float c = cosf( degrees * DEGTORAD );
+    float s = sinf( degrees * DEGTORAD );
+    int i = (axis + 1) % 3;
+    int j = (axis + 2) % 3;
+
+    float r[16];
+    identity( r );
+    r[i*4 + i] = c;
+    r[i*4 + j] = s;
+    r[j*4 + i] = -s;
+    r[j*4 + j] = c;
+    multiply( m, m, r );
+}
+
+// gluPerspective()
+static void perspective( float *m, float fovy, float aspect, float zNear, float zFar )
+{
+    float f = 1.0f / tanf( 0.5f * fovy * DEGTORAD );
+
+    memset( m, 0, 16 * sizeof(float) );
+    m[0] = f / aspect;
+    m[5] = f;
+    m[10] = (zFar + zNear) / (zNear - zFar);
+    m[11] = -1.0f;
+    m[14] = 2.0f * zFar * zNear / (zNear - zFar);
+}
+
+static void normalize( float *v )
+{
+    float len = sqrtf( v[0]*v[0] + v[1]*v[1] + v[2]*v[2] );
+    if( len > 0.0f )
+    {
+        v[0] /= len;
+        v[1] /= len;
+        v[2] /= len;
+    }
+}
+
+static void cross( float *result, const float *a, const float *b )
+{
+    result[0] = a[1]*b[2] - a[2]*b[1];
+    result[1] = a[2]*b[0] - a[0]*b[2];
+    result[2] = a[0]*b[1] - a[1]*b[0];
+}
+
+// gluLookAt()
+static void lookAt( float *m, const float *eye, const float *center, const float *up )
+{
+    float f[3] = { center[0] - eye[0], center[1] - eye[1], center[2] - eye[2] };
+    normalize( f );
+    float s[3];
+    cross( s, f, up );
+    normalize( s );
+    float u[3];
+    cross( u, s, f );
+
+    identity( m );
+    m[0] = s[0]; m[4] = s[1]; m[8] = s[2];
+    m[1] = u[0]; m[5] = u[1]; m[9] = u[2];
+    m[2] = -f[0]; m[6] = -f[1]; m[10] = -f[2];
+    translate( m, -eye[0], -eye[1], -eye[2] );
+}
+
+static void transformPoint( float *result, const float *m, const float *v )
+{
+    for( int row = 0; row < 3; row++ )
+        result[row] = m[row]*v[0] + m[4 + row]*v[1] + m[8 + row]*v[2] + m[12 + row];
+}
+
+//---------------------------------------------------------------------------
+// Shared meshes
+//
+// Built on first use, which is always on the render thread.
+//---------------------------------------------------------------------------
+static SoftScene::Mesh *createAgentMesh()
+{
+    SoftScene::Mesh *mesh = new SoftScene::Mesh();
+    gpolyobj *obj = agent::GetAgentObj();
+
+    // Polygons 0-4 are the nose, 5-9 the body; see agent::draw().
+    for( long i = 0; (i < obj->numPolygons()) && (i < 10); i++ )
+    {
+        const opoly &poly = obj->polygon( i );
+        SoftScene::Mesh::Polygon polygon = { (uint32_t)mesh->vertices.size() / 3,
+                                             (uint32_t)poly.fNumPoints,
+                                             (uint8_t)(i < 5 ? 0 : 1) };
+        mesh->vertices.insert( mesh->vertices.end(), poly.fVertices, poly.fVertices + 3 * poly.fNumPoints );
+        mesh->polygons.push_back( polygon );
+    }
+
+    return mesh;
+}
+
+static SoftScene::Mesh *createCubeMesh()
+{
+    SoftScene::Mesh *mesh = new SoftScene::Mesh();
+
+    for( int i = 0; i < 6; i++ )
+    {
+        SoftScene::Mesh::Polygon polygon = { (uint32_t)mesh->vertices.size() / 3, 4, 0 };
+        mesh->vertices.insert( mesh->vertices.end(), &UnitCube[i][0][0], &UnitCube[i][0][0] + 12 );
+        mesh->polygons.push_back( polygon );
+    }
+
+    return mesh;
+}
+
+//===========================================================================
+// SoftScene
+//===========================================================================
+
+//---------------------------------------------------------------------------
+// SoftScene::setView
+//
+// Mirrors gscene::Draw() up to gstage::Draw().
+//---------------------------------------------------------------------------
+void SoftScene::setView( gcamera &camera )
+{
+    float projection[16];
+    perspective( projection, camera.GetFOV(), camera.GetAspect(), camera.GetNear(), camera.GetFar() );
+
+    // gcamera::Use()
+    float view[16];
+    if( camera.UsingLookAt() )
+    {
+        float eye[3] = { camera.x(), camera.y(), camera.z() };
+        float up[3] = { camera.getyaw(), camera.getpitch(), camera.getroll() };
+        lookAt( view, eye, camera.GetFixationPoint(), up );
+    }
+    else
+    {
+        identity( view );
+        rotate( view, -camera.getroll(), 2 );
+        rotate( view, -camera.getpitch(), 0 );
+        rotate( view, -camera.getyaw(), 1 );
+        translate( view, -camera.x(), -camera.y(), -camera.z() );
+
+        gobject *follow = camera.GetFollowObject();
+        if( follow )
+        {
+            rotate( view, -follow->getroll(), 2 );
+            rotate( view, -follow->getpitch(), 0 );
+            rotate( view, -follow->getyaw(), 1 );
+            translate( view, -follow->x(), -follow->y(), -follow->z() );
+        }
+    }
+
+    multiply( viewProjection, projection, view );
+
+    int fogEnd;
+    fog.enabled = camera.GetFog( fog.function, fog.density, fogEnd );
+    fog.start = camera.GetNear();
+    fog.end = fogEnd;
+}
+
+//---------------------------------------------------------------------------
+// SoftScene::build
+//
+// Mirrors gstage::Draw().
+//---------------------------------------------------------------------------
+void SoftScene::build( const WorldSnapshot &snapshot )
+{
+    static const Mesh *agentMesh = createAgentMesh();
+    static const Mesh *cubeMesh = createCubeMesh();
+
+    instances.clear();
+    vertices.clear();
+    polygons.clear();
+    lines.clear();
+
+    for( const WorldSnapshot::Object &obj : snapshot.objects )
+    {
+        // gobject::position() followed by the glScalef() of each draw().
+        float model[16];
+        identity( model );
+        translate( model, obj.position[0], obj.position[1], obj.position[2] );
+        rotate( model, obj.angles[0], 1 );
+        rotate( model, obj.angles[1], 0 );
+        rotate( model, obj.angles[2], 2 );
+        scale( model, obj.scale, obj.scale, obj.scale );
+        scale( model, obj.size[0], obj.size[1], obj.size[2] );
+
+        Color body = { obj.colors[0][0], obj.colors[0][1], obj.colors[0][2] };
+
+        switch( obj.shape )
+        {
+        case WorldSnapshot::AGENT:
+            {
+                Color nose = { obj.colors[1][0], obj.colors[1][1], obj.colors[1][2] };
+                addInstance( *agentMesh, model, nose, body );
+            }
+            break;
+        case WorldSnapshot::BOX:
+            addInstance( *cubeMesh, model, body, body );
+            break;
+        case WorldSnapshot::POLYGONS:
+            for( uint32_t i = 0; i < obj.polygonCount; i++ )
+            {
+                const WorldSnapshot::Polygon &poly = snapshot.polygons[obj.firstPolygon + i];
+                addPolygon( model, &snapshot.vertices[3 * poly.firstVertex], poly.vertexCount, body );
+            }
+
+            // barrier::draw() outlines the top edge, in world coordinates.
+            if( obj.outlineTop )
+            {
+                const float *v = &snapshot.vertices[3 * snapshot.polygons[obj.firstPolygon].firstVertex];
+                Line line;
+                memcpy( line.a, v + 3, sizeof(line.a) );
+                memcpy( line.b, v + 6, sizeof(line.b) );
+                line.color = body;
+                lines.push_back( line );
+            }
+            break;
+        default:
+            assert( false );
+        }
+    }
+}
+
+//---------------------------------------------------------------------------
+// SoftScene::addInstance
+//---------------------------------------------------------------------------
+void SoftScene::addInstance( const Mesh &mesh, const float *model, const Color &color0, const Color &color1 )
+{
+    Instance instance;
+    instance.mesh = &mesh;
+    multiply( instance.modelViewProjection, viewProjection, model );
+    instance.colors[0] = color0;
+    instance.colors[1] = color1;
+
+    instances.push_back( instance );
+}
+
+//---------------------------------------------------------------------------
+// SoftScene::addPolygon
+//---------------------------------------------------------------------------
+void SoftScene::addPolygon( const float *model, const float *v, long n, const Color &color )
+{
+    Polygon polygon = { (uint32_t)vertices.size() / 3, (uint32_t)n, color };
+
+    for( long i = 0; i < n; i++ )
+    {
+        float world[3];
+        transformPoint( world, model, v + 3*i );
+        vertices.insert( vertices.end(), world, world + 3 );
+    }
+
+    polygons.push_back( polygon );
+}
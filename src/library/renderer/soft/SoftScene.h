@@ -0,0 +1,89 @@
+#pragma once
+
+#include <stdint.h>
+
+#include <vector>
+
+class gcamera;
+class WorldSnapshot;
+
+//---------------------------------------------------------------------------
+// SoftScene
+//
+// What SoftRasterizer needs to draw one frame. The view is taken from the
+// camera on the simulation thread; the objects are built from a
+// WorldSnapshot on the render thread. Agents, food and bricks become a
+// transform and colors against a shared mesh; the few static set objects
+// (ground, barriers) are transformed to world space. Matrices are 4x4,
+// column-major, as in GL.
+//---------------------------------------------------------------------------
+class SoftScene
+{
+ public:
+    struct Color
+    {
+        float r;
+        float g;
+        float b;
+    };
+
+    // Convex polygons, each drawn in the instance color for its part.
+    struct Mesh
+    {
+        struct Polygon
+        {
+            uint32_t first;
+            uint32_t count;
+            uint8_t part;
+        };
+
+        std::vector<float> vertices;
+        std::vector<Polygon> polygons;
+    };
+
+    struct Instance
+    {
+        const Mesh *mesh;
+        float modelViewProjection[16];
+        Color colors[2];
+    };
+
+    struct Polygon
+    {
+        uint32_t first;
+        uint32_t count;
+        Color color;
+    };
+
+    struct Line
+    {
+        float a[3];
+        float b[3];
+        Color color;
+    };
+
+    struct Fog
+    {
+        bool enabled;
+        char function;
+        float density;
+        float start;
+        float end;
+    };
+
+    void setView( gcamera &camera );
+    void build( const WorldSnapshot &snapshot );
+
+    float viewProjection[16];
+    Fog fog;
+
+    std::vector<Instance> instances;
+    // World-space polygons and lines.
+    std::vector<float> vertices;
+    std::vector<Polygon> polygons;
+    std::vector<Line> lines;
+
+ private:
+    void addInstance( const Mesh &mesh, const float *model, const Color &color0, const Color &color1 );
+    void addPolygon( const float *model, const float *v, long n, const Color &color );
+};
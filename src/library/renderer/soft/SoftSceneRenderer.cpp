@@ -0,0 +1,189 @@
+#include "SoftSceneRenderer.h"
+
+#include <assert.h>
+
+#include <algorithm>
+
+#include "PwMovieSoftRecorder.h"
+#include "SoftRasterizer.h"
+
+//===========================================================================
+// SceneRenderer
+//===========================================================================
+
+//---------------------------------------------------------------------------
+// SceneRenderer::create
+//---------------------------------------------------------------------------
+SceneRenderer *SceneRenderer::create( gstage &stage,
+                                      WorldSnapshotBuffer &snapshots,
+                                      const CameraProperties &cameraProps,
+                                      int width,
+                                      int height )
+{
+    return new SoftSceneRenderer( stage, snapshots, cameraProps, width, height );
+}
+
+//===========================================================================
+// SoftSceneRenderer
+//===========================================================================
+
+//---------------------------------------------------------------------------
+// SoftSceneRenderer::SoftSceneRenderer
+//---------------------------------------------------------------------------
+SoftSceneRenderer::SoftSceneRenderer( gstage &stage,
+                                      WorldSnapshotBuffer &snapshots_,
+                                      const CameraProperties &cameraProps,
+                                      int width,
+                                      int height )
+    : SceneRenderer( stage, cameraProps, width, height )
+    , snapshots( snapshots_ )
+    , completing( false )
+    , stopping( false )
+    , rasterizer( NULL )
+    , thread( NULL )
+{
+    for( Frame &frame : frames )
+        freeFrames.push_back( &frame );
+
+    snapshots.addConsumer();
+}
+
+//---------------------------------------------------------------------------
+// SoftSceneRenderer::~SoftSceneRenderer
+//---------------------------------------------------------------------------
+SoftSceneRenderer::~SoftSceneRenderer()
+{
+    if( thread )
+    {
+        {
+            std::lock_guard<std::mutex> lock( queueMutex );
+            stopping = true;
+        }
+        queueChanged.notify_all();
+
+        thread->join();
+        delete thread;
+    }
+
+    delete rasterizer;
+
+    snapshots.removeConsumer();
+}
+
+//---------------------------------------------------------------------------
+// SoftSceneRenderer::render
+//---------------------------------------------------------------------------
+void SoftSceneRenderer::render()
+{
+    // Don't render if no slots connected
+    if( renderComplete.receivers() == 0 )
+    {
+        return;
+    }
+
+    completing = true;
+    renderComplete();
+    completing = false;
+
+    if( recordings.empty() )
+    {
+        return;
+    }
+
+    if( thread == NULL )
+    {
+        unsigned nthreads = std::min( std::thread::hardware_concurrency(), (unsigned)MaxThreads );
+        rasterizer = new SoftRasterizer( width, height, std::max(1u, nthreads) );
+        thread = new std::thread( &SoftSceneRenderer::renderLoop, this );
+    }
+
+    Frame *frame;
+    {
+        std::unique_lock<std::mutex> lock( queueMutex );
+        while( freeFrames.empty() )
+            queueChanged.wait( lock );
+
+        frame = freeFrames.back();
+        freeFrames.pop_back();
+    }
+
+    frame->scene.setView( camera );
+    frame->snapshot = snapshots.acquire();
+    frame->recordings.swap( recordings );
+    recordings.clear();
+
+    assert( frame->snapshot );
+
+    {
+        std::lock_guard<std::mutex> lock( queueMutex );
+        queue.push_back( frame );
+    }
+    queueChanged.notify_all();
+}
+
+//---------------------------------------------------------------------------
+// SoftSceneRenderer::createMovieRecorder
+//---------------------------------------------------------------------------
+MovieRecorder *SoftSceneRenderer::createMovieRecorder( PwMovieWriter *writer )
+{
+    return new PwMovieSoftRecorder( this, writer );
+}
+
+//---------------------------------------------------------------------------
+// SoftSceneRenderer::recordFrame
+//---------------------------------------------------------------------------
+void SoftSceneRenderer::recordFrame( PwMovieSoftRecorder *recorder, uint32_t timestep )
+{
+    assert( completing );
+
+    Recording recording = { recorder, timestep };
+    recordings.push_back( recording );
+}
+
+//---------------------------------------------------------------------------
+// SoftSceneRenderer::finish
+//---------------------------------------------------------------------------
+void SoftSceneRenderer::finish()
+{
+    std::unique_lock<std::mutex> lock( queueMutex );
+    while( !queue.empty() )
+        queueChanged.wait( lock );
+}
+
+//---------------------------------------------------------------------------
+// SoftSceneRenderer::renderLoop
+//
+// A frame stays at the head of the queue until it's recorded, so finish()
+// can't return while a recorder is still in use.
+//---------------------------------------------------------------------------
+void SoftSceneRenderer::renderLoop()
+{
+    while( true )
+    {
+        Frame *frame;
+        {
+            std::unique_lock<std::mutex> lock( queueMutex );
+            while( queue.empty() && !stopping )
+                queueChanged.wait( lock );
+
+            if( queue.empty() )
+                break;
+            frame = queue.front();
+        }
+
+        frame->scene.build( *frame->snapshot );
+        frame->snapshot.reset();
+
+        rasterizer->render( frame->scene );
+
+        for( Recording &recording : frame->recordings )
+            recording.recorder->writeFrame( recording.timestep, rasterizer->getPixels() );
+
+        {
+            std::lock_guard<std::mutex> lock( queueMutex );
+            queue.pop_front();
+            freeFrames.push_back( frame );
+        }
+        queueChanged.notify_all();
+    }
+}
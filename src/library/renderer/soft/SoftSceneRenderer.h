@@ -0,0 +1,79 @@
+#pragma once
+
+#include <stdint.h>
+
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "SoftScene.h"
+#include "monitor/SceneRenderer.h"
+#include "monitor/WorldSnapshot.h"
+#include "library_global.h"
+
+//---------------------------------------------------------------------------
+// SoftSceneRenderer
+//
+// Used by headless builds, which have no GL context. render() raises
+// renderComplete first, and only when a movie recorder asks for the frame
+// does it queue the camera view with the step's WorldSnapshot; a background
+// thread builds and rasterizes queued frames and hands the pixels to the
+// recorders. Frames nobody records are never drawn, and the simulation only
+// waits when recorded frames back up.
+//---------------------------------------------------------------------------
+class LIBRARY_SHARED SoftSceneRenderer : public SceneRenderer
+{
+ public:
+    // Frames captured but not yet drawn. render() waits when there are more.
+    static const int MaxQueuedFrames = 2;
+    // Tile threads, including the render thread.
+    static const unsigned MaxThreads = 4;
+
+    SoftSceneRenderer( gstage &stage,
+                       WorldSnapshotBuffer &snapshots,
+                       const CameraProperties &cameraProps,
+                       int width,
+                       int height );
+    virtual ~SoftSceneRenderer();
+
+    virtual void render() override;
+    class MovieRecorder *createMovieRecorder( class PwMovieWriter *writer ) override;
+
+    // Only valid from a renderComplete slot; the recorder receives the frame
+    // from the render thread once it's drawn.
+    void recordFrame( class PwMovieSoftRecorder *recorder, uint32_t timestep );
+    // Waits until every queued frame has been drawn and recorded.
+    void finish();
+
+ private:
+    struct Recording
+    {
+        class PwMovieSoftRecorder *recorder;
+        uint32_t timestep;
+    };
+
+    struct Frame
+    {
+        SoftScene scene;
+        WorldSnapshotBuffer::Ref snapshot;
+        std::vector<Recording> recordings;
+    };
+
+    void renderLoop();
+
+    WorldSnapshotBuffer &snapshots;
+    std::vector<Recording> recordings;
+    bool completing;
+
+    Frame frames[MaxQueuedFrames + 1];
+    std::vector<Frame *> freeFrames;
+    std::deque<Frame *> queue;
+    std::mutex queueMutex;
+    std::condition_variable queueChanged;
+    bool stopping;
+
+    class SoftRasterizer *rasterizer;
+    std::thread *thread;
+};
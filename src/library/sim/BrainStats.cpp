@@ -0,0 +1,146 @@
+#include "BrainStats.h"
+
+#include <assert.h>
+
+#include <algorithm>
+
+#include "agent/agent.h"
+#include "brain/Brain.h"
+#include "brain/groups/GroupsBrain.h"
+#include "brain/sheets/SheetsBrain.h"
+
+using namespace sim;
+
+const std::vector<BrainStats::SheetSynapseType> BrainStats::SheetSynapseTypes =
+	{
+		{ sheets::Sheet::Input, sheets::Sheet::Internal },
+		{ sheets::Sheet::Input, sheets::Sheet::Output },
+		{ sheets::Sheet::Internal, sheets::Sheet::Internal },
+		{ sheets::Sheet::Internal, sheets::Sheet::Output },
+		{ sheets::Sheet::Output, sheets::Sheet::Internal },
+		{ sheets::Sheet::Output, sheets::Sheet::Output },
+	};
+
+//===========================================================================
+// BrainStats
+//===========================================================================
+
+//---------------------------------------------------------------------------
+// BrainStats::BrainStats
+//---------------------------------------------------------------------------
+BrainStats::BrainStats()
+{
+}
+
+//---------------------------------------------------------------------------
+// BrainStats::~BrainStats
+//---------------------------------------------------------------------------
+BrainStats::~BrainStats()
+{
+}
+
+//---------------------------------------------------------------------------
+// BrainStats::birth
+//---------------------------------------------------------------------------
+void BrainStats::birth( const AgentBirthEvent &e )
+{
+	// Virtual births have no agent.
+	if( e.a )
+		pending.push_back( e.a );
+}
+
+//---------------------------------------------------------------------------
+// BrainStats::death
+//---------------------------------------------------------------------------
+void BrainStats::death( const AgentDeathEvent &e )
+{
+	auto it = counted.find( e.a );
+	if( it != counted.end() )
+	{
+		for( size_t i = 0; i < stats.size(); i++ )
+			stats[i]->remove( it->second[i] );
+		counted.erase( it );
+	}
+	else
+	{
+		auto itPending = std::find( pending.begin(), pending.end(), e.a );
+		assert( itPending != pending.end() );
+		if( itPending != pending.end() )
+			pending.erase( itPending );
+	}
+}
+
+//---------------------------------------------------------------------------
+// BrainStats::update
+//
+// Counts agents born since the last update. Their brains must be grown.
+//---------------------------------------------------------------------------
+void BrainStats::update()
+{
+	if( stats.empty() )
+	{
+		stats.push_back( &neuronCount );
+		stats.push_back( &synapseCount );
+		stats.push_back( &byteCount );
+
+		switch( Brain::config().architecture )
+		{
+		case Brain::Configuration::Groups:
+			stats.push_back( &groups.groupCount );
+			break;
+		case Brain::Configuration::Sheets:
+			stats.push_back( &sheets.internalSheetCount );
+			stats.push_back( &sheets.internalNeuronCount );
+			for( const SheetSynapseType &type : SheetSynapseTypes )
+				stats.push_back( &sheets.synapseCount[type.from][type.to] );
+			break;
+		default:
+			assert( false );
+		}
+	}
+
+	for( agent *a : pending )
+	{
+		Sample &values = counted[a];
+		sample( a, values );
+		for( size_t i = 0; i < stats.size(); i++ )
+			stats[i]->add( values[i] );
+	}
+	pending.clear();
+}
+
+//---------------------------------------------------------------------------
+// BrainStats::sample
+//---------------------------------------------------------------------------
+void BrainStats::sample( agent *a, Sample &values )
+{
+	Brain *brain = a->GetBrain();
+
+	values.clear();
+	values.push_back( brain->getNumNeurons() );
+	values.push_back( brain->getNumSynapses() );
+	values.push_back( brain->getMemoryFootprint() );
+
+	switch( Brain::config().architecture )
+	{
+	case Brain::Configuration::Groups:
+		{
+			GroupsBrain *groupsBrain = dynamic_cast<GroupsBrain *>( brain );
+			values.push_back( groupsBrain->NumNeuronGroups() );
+		}
+		break;
+	case Brain::Configuration::Sheets:
+		{
+			SheetsBrain *sheetsBrain = dynamic_cast<SheetsBrain *>( brain );
+			values.push_back( sheetsBrain->getNumInternalSheets() );
+			values.push_back( sheetsBrain->getNumInternalNeurons() );
+			for( const SheetSynapseType &type : SheetSynapseTypes )
+				values.push_back( sheetsBrain->getNumSynapses(type.from, type.to) );
+		}
+		break;
+	default:
+		assert( false );
+	}
+
+	assert( values.size() == stats.size() );
+}
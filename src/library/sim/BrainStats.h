@@ -0,0 +1,54 @@
+#pragma once
+
+#include <unordered_map>
+#include <vector>
+
+#include "simtypes.h"
+#include "brain/sheets/SheetsModel.h"
+
+class agent;
+
+//===========================================================================
+// BrainStats
+//
+// Brain size statistics over the living population. They are kept current
+// from birth and death events rather than by rescanning every agent each
+// step. A newborn's brain may still be growing on a pool thread when its
+// birth is posted, so births are queued and counted by the next update().
+//===========================================================================
+class BrainStats
+{
+ public:
+	struct SheetSynapseType { sheets::Sheet::Type from, to; };
+	static const std::vector<SheetSynapseType> SheetSynapseTypes;
+
+	BrainStats();
+	~BrainStats();
+
+	void birth( const sim::AgentBirthEvent &e );
+	void death( const sim::AgentDeathEvent &e );
+	void update();
+
+	sim::StatPopulation neuronCount;
+	sim::StatPopulation synapseCount;
+	sim::StatPopulation byteCount;
+	struct Groups
+	{
+		sim::StatPopulation groupCount;
+	} groups;
+	struct Sheets
+	{
+		sim::StatPopulation internalSheetCount;
+		sim::StatPopulation internalNeuronCount;
+		sim::StatPopulation synapseCount[sheets::Sheet::__NTYPES][sheets::Sheet::__NTYPES];
+	} sheets;
+
+ private:
+	typedef std::vector<float> Sample;
+	void sample( agent *a, Sample &values );
+
+	// Every stat for the configured architecture, in sample order.
+	std::vector<sim::StatPopulation *> stats;
+	std::vector<agent *> pending;
+	std::unordered_map<agent *, Sample> counted;
+};
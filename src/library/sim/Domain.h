@@ -3,6 +3,7 @@
 #include "FittestList.h"
 #include "simtypes.h"
 #include "environment/FoodPatch.h"
+#include "environment/FoodPatchIndex.h"
 
 using namespace sim;
 
@@ -36,6 +37,7 @@ class Domain
     int maxFoodGrownCount;
 	int numFoodPatchesGrown;
 	FoodPatch* fFoodPatches;
+	FoodPatchIndex foodPatchIndex;
 	class BrickPatch* fBrickPatches;
     long minNumAgents;
     long maxNumAgents;
@@ -74,16 +76,5 @@ inline Domain::~Domain()
 
 inline FoodPatch* Domain::whichFoodPatch( float x, float z )
 {
-	FoodPatch* fp = NULL;
-
-	for( int i = 0; i < numFoodPatches; i++ )
-	{
-		if( fFoodPatches[i].pointIsInside( x, z, 0.0 ) )
-		{
-			fp = &(fFoodPatches[i]);
-			break;
-		}
-	}
-
-	return( fp );
+	return foodPatchIndex.whichPatch( x, z );
 }
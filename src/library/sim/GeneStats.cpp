@@ -1,15 +1,77 @@
 #include "GeneStats.h"
 
+#include <assert.h>
+#include <math.h>
+#include <stdint.h>
+#include <string.h>
+
+#include <algorithm>
+
+#if defined(__AVX2__)
+	#include <immintrin.h>
+#elif defined(__SSE2__)
+	#include <emmintrin.h>
+#endif
+
 #include "genome/GenomeUtil.h"
-#include "utils/objectxsortedlist.h"
+#include "utils/misc.h"
 
 using namespace genome;
+using namespace sim;
+
+// Genes reduced by each parallel task.
+#define GENES_PER_TASK 512
+// Squares of bytes are at most 65025, so this many rows can be summed in
+// 32 bits before they're carried into the 64-bit totals.
+#define ROWS_PER_BLOCK 65536
+
+// Adds one row's bytes, and their squares, to the 32-bit column sums.
+static void accumulate( const unsigned char *genes, int n, uint32_t *sum, uint32_t *sum2 )
+{
+	int i = 0;
+
+#if defined(__AVX2__)
+	for( ; i + 8 <= n; i += 8 )
+	{
+		__m256i v = _mm256_cvtepu8_epi32( _mm_loadl_epi64((const __m128i *)(genes + i)) );
+		__m256i s = _mm256_loadu_si256( (const __m256i *)(sum + i) );
+		__m256i s2 = _mm256_loadu_si256( (const __m256i *)(sum2 + i) );
+		_mm256_storeu_si256( (__m256i *)(sum + i), _mm256_add_epi32(s, v) );
+		_mm256_storeu_si256( (__m256i *)(sum2 + i), _mm256_add_epi32(s2, _mm256_mullo_epi32(v, v)) );
+	}
+#elif defined(__SSE2__)
+	__m128i zero = _mm_setzero_si128();
+	for( ; i + 8 <= n; i += 8 )
+	{
+		__m128i v = _mm_unpacklo_epi8( _mm_loadl_epi64((const __m128i *)(genes + i)), zero );
+		// The squares still fit in 16 bits.
+		__m128i v2 = _mm_mullo_epi16( v, v );
+		__m128i *s = (__m128i *)(sum + i);
+		__m128i *s2 = (__m128i *)(sum2 + i);
+		_mm_storeu_si128( s, _mm_add_epi32(_mm_loadu_si128(s), _mm_unpacklo_epi16(v, zero)) );
+		_mm_storeu_si128( s + 1, _mm_add_epi32(_mm_loadu_si128(s + 1), _mm_unpackhi_epi16(v, zero)) );
+		_mm_storeu_si128( s2, _mm_add_epi32(_mm_loadu_si128(s2), _mm_unpacklo_epi16(v2, zero)) );
+		_mm_storeu_si128( s2 + 1, _mm_add_epi32(_mm_loadu_si128(s2 + 1), _mm_unpackhi_epi16(v2, zero)) );
+	}
+#endif
+
+	for( ; i < n; i++ )
+	{
+		uint32_t v = genes[i];
+		sum[i] += v;
+		sum2[i] += v * v;
+	}
+}
 
 GeneStats::GeneStats()
 	: _maxAgents( 0 )
-	, _agents( NULL )
-	, _sum( NULL )
-	, _sum2( NULL )
+	, _ngenes( 0 )
+	, _matrix( NULL )
+	, _capacity( 0 )
+	, _nrows( 0 )
+	, _mean( NULL )
+	, _stddev( NULL )
+	, _histograms( NULL )
 {
 }
 
@@ -17,11 +79,12 @@ GeneStats::~GeneStats()
 {
 	if( _maxAgents )
 	{
-		delete [] _agents;
-		delete [] _sum;
-		delete [] _sum2;
+		delete [] _matrix;
+		itfor( std::vector<unsigned char *>, _retired, it )
+			delete [] *it;
 		delete [] _mean;
 		delete [] _stddev;
+		delete [] _histograms;
 	}
 }
 
@@ -35,13 +98,40 @@ void GeneStats::init( long maxAgents )
 	{
 		_maxAgents = maxAgents;
 
-		_agents = new agent *[ maxAgents ];
+		_ngenes = GenomeUtil::schema()->getMutableSize();
+		_capacity = maxAgents;
+		_matrix = new unsigned char[ _capacity * _ngenes ];
+		_mean = new float[ _ngenes ];
+		_stddev = new float[ _ngenes ];
+	}
+}
 
-		int ngenes = GenomeUtil::schema->getMutableSize();
-		_sum  = new unsigned long[ ngenes ];
-		_sum2 = new unsigned long[ ngenes ];
-		_mean = new float[ ngenes ];
-		_stddev = new float[ ngenes ];
+void GeneStats::initHistograms()
+{
+	assert( _maxAgents );
+
+	if( _histograms == NULL )
+		_histograms = new unsigned long[ _ngenes * HistogramBins ];
+}
+
+void GeneStats::birth( const AgentBirthEvent &e )
+{
+	// Virtual births have no agent.
+	if( !_maxAgents || !e.a )
+		return;
+
+	long row = allocRow();
+	e.a->Genes()->dump( _matrix + row * _ngenes );
+	_agentRows[e.a] = row;
+}
+
+void GeneStats::death( const AgentDeathEvent &e )
+{
+	auto it = _agentRows.find( e.a );
+	if( it != _agentRows.end() )
+	{
+		_releasedRows.push_back( it->second );
+		_agentRows.erase( it );
 	}
 }
 
@@ -55,45 +145,120 @@ float *GeneStats::getStddev()
 	return _stddev;
 }
 
+unsigned long *GeneStats::getHistograms()
+{
+	return _histograms;
+}
+
 void GeneStats::compute( Scheduler &scheduler)
 {
 	if( _maxAgents )
 	{
-		// Because we'll be performing the stats calculations/recording in parallel
-		// with the master task, which will kill and birth agents, we must create a
-		// snapshot of the agents alive right now.
-		_nagents = objectxsortedlist::gXSortedObjects.getCount(AGENTTYPE);
-		objectxsortedlist::gXSortedObjects.reset();
-		for( int i = 0; i < _nagents; i++ )
+		// The reduction runs in parallel with the master task, which will kill and
+		// birth agents. Nothing it reads is written until the next compute(): births
+		// only take rows freed before now, and a larger matrix doesn't replace this
+		// one's storage.
+		itfor( std::vector<unsigned char *>, _retired, it )
+			delete [] *it;
+		_retired.clear();
+
+		_freeRows.insert( _freeRows.end(), _releasedRows.begin(), _releasedRows.end() );
+		_releasedRows.clear();
+
+		_rows.clear();
+		itfor( AgentRows, _agentRows, it )
+			_rows.push_back( it->second );
+		std::sort( _rows.begin(), _rows.end() );
+
+		const unsigned char *matrix = _matrix;
+
+		for( int firstGene = 0; firstGene < _ngenes; firstGene += GENES_PER_TASK )
+		{
+			int endGene = std::min( firstGene + GENES_PER_TASK, _ngenes );
+
+			// !!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!
+			// !!! POST PARALLEL
+			// !!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!
+			scheduler.postParallel( [=]() {
+					reduce( matrix, firstGene, endGene );
+				});
+		}
+	}
+}
+
+long GeneStats::allocRow()
+{
+	if( !_freeRows.empty() )
+	{
+		long row = _freeRows.back();
+		_freeRows.pop_back();
+		return row;
+	}
+
+	if( _nrows == _capacity )
+	{
+		// Deaths since the last compute() hold their rows, so the population can
+		// briefly need more than maxAgents.
+		long capacity = _capacity * 2;
+		unsigned char *matrix = new unsigned char[ capacity * _ngenes ];
+		memcpy( matrix, _matrix, _nrows * _ngenes );
+
+		_retired.push_back( _matrix );
+		_matrix = matrix;
+		_capacity = capacity;
+	}
+
+	return _nrows++;
+}
+
+void GeneStats::reduce( const unsigned char *matrix, int firstGene, int endGene )
+{
+	int n = endGene - firstGene;
+	long nagents = _rows.size();
+
+	uint32_t sum[GENES_PER_TASK];
+	uint32_t sum2[GENES_PER_TASK];
+	uint64_t total[GENES_PER_TASK];
+	uint64_t total2[GENES_PER_TASK];
+
+	memset( total, 0, sizeof(*total) * n );
+	memset( total2, 0, sizeof(*total2) * n );
+
+	for( long begin = 0; begin < nagents; begin += ROWS_PER_BLOCK )
+	{
+		long end = std::min( begin + ROWS_PER_BLOCK, nagents );
+
+		memset( sum, 0, sizeof(*sum) * n );
+		memset( sum2, 0, sizeof(*sum2) * n );
+
+		for( long i = begin; i < end; i++ )
+			accumulate( matrix + _rows[i] * _ngenes + firstGene, n, sum, sum2 );
+
+		for( int j = 0; j < n; j++ )
 		{
-			objectxsortedlist::gXSortedObjects.nextObj( AGENTTYPE, (gobject**)_agents + i );
+			total[j] += sum[j];
+			total2[j] += sum2[j];
 		}
+	}
+
+	float *mean = _mean + firstGene;
+	float *stddev = _stddev + firstGene;
+	for( int j = 0; j < n; j++ )
+	{
+		mean[j] = (float) total[j] / (float) nagents;
+		stddev[j] = sqrt( (float) total2[j] / (float) nagents  -  mean[j] * mean[j] );
+	}
 
-		// !!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!
-		// !!! POST PARALLEL
-		// !!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!
-		scheduler.postParallel( [=]() {
-                    long nagents = _nagents;
-                    agent **agents = _agents;
-                    unsigned long *sum = _sum;
-                    unsigned long *sum2 = _sum2;
-                    int ngenes = GenomeUtil::schema->getMutableSize(); 
-
-                    memset( sum, 0, sizeof(*sum) * ngenes );
-                    memset( sum2, 0, sizeof(*sum2) * ngenes );
-
-                    for( int i = 0; i < nagents; i++ )
-                    {
-                        agents[i]->Genes()->updateSum( sum, sum2 );
-                    }
-
-                    float *mean = _mean;
-                    float *stddev = _stddev;
-                    for( int i = 0; i < ngenes; i++ )
-                    {
-                        mean[i] = (float) sum[i] / (float) nagents;
-                        stddev[i] = sqrt( (float) sum2[i] / (float) nagents  -  mean[i] * mean[i] );
-                    }
-                });
+	if( _histograms )
+	{
+		unsigned long *histograms = _histograms + firstGene * HistogramBins;
+		memset( histograms, 0, sizeof(*histograms) * n * HistogramBins );
+
+		for( long i = 0; i < nagents; i++ )
+		{
+			const unsigned char *genes = matrix + _rows[i] * _ngenes + firstGene;
+			for( int j = 0; j < n; j++ )
+				histograms[j * HistogramBins + genes[j] * HistogramBins / 256]++;
+		}
 	}
 }
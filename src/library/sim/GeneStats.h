@@ -1,27 +1,61 @@
 #pragma once
 
+#include <unordered_map>
+#include <vector>
+
 #include "Scheduler.h"
+#include "simtypes.h"
 #include "agent/agent.h"
 
+//===========================================================================
+// GeneStats
+//
+// Per-byte genome statistics over the living population. Each newborn's
+// genome is copied into a row of one matrix, decoded from gray and in schema
+// order, so compute() only has to reduce the matrix columns. A dead agent's
+// row isn't reused until the next compute(), as the reduction posted by the
+// previous one may still be reading it.
+//===========================================================================
 class GeneStats
 {
  public:
+	// Bins of 256 / HistogramBins consecutive raw values.
+	static const int HistogramBins = 16;
+
 	GeneStats();
 	~GeneStats();
 
 	void init( long maxAgents );
+	// Also count values in HistogramBins bins per gene.
+	void initHistograms();
+
+	void birth( const sim::AgentBirthEvent &e );
+	void death( const sim::AgentDeathEvent &e );
 
 	float *getMean();
 	float *getStddev();
+	// HistogramBins counts per gene, or NULL without initHistograms().
+	unsigned long *getHistograms();
 
 	void compute( Scheduler &scheduler );
 
  private:
+	typedef std::unordered_map<agent *, long> AgentRows;
+
+	long allocRow();
+	void reduce( const unsigned char *matrix, int firstGene, int endGene );
+
 	long _maxAgents;
-	class agent **_agents;   // list of agents to be used for computing stats.
-	unsigned long *_sum;	// sum, for computing mean
-	unsigned long *_sum2;	// sum of squares, for computing std. dev.
-	long _nagents;
+	int _ngenes;
+	unsigned char *_matrix;
+	long _capacity;			// rows allocated in _matrix
+	long _nrows;			// rows ever handed out
+	std::vector<unsigned char *> _retired;	// outgrown matrices still being read
+	std::vector<long> _freeRows;
+	std::vector<long> _releasedRows;
+	AgentRows _agentRows;
+	std::vector<long> _rows;	// rows of the agents alive at the last compute()
 	float *_mean;
 	float *_stddev;
+	unsigned long *_histograms;
 };
@@ -0,0 +1,192 @@
+#include "Profiler.h"
+
+#include <assert.h>
+#include <string.h>
+
+#include <string>
+
+#include "Scheduler.h"
+#include "SimulationContext.h"
+#include "utils/datalib.h"
+#include "utils/misc.h"
+
+#define TIMING_PATH SimulationContext::runPath( "stats/timing.txt" ).c_str()
+
+static const char *PhaseNames[] =
+{
+	"Step",
+	"Properties",
+	"Barriers",
+	"EnergyCosts",
+	"Agents",
+	"Vision",
+	"Brains",
+	"Bodies",
+	"Interact",
+	"CreateAgents",
+	"Bricks",
+	"Food",
+	"Monitors",
+	"Logs"
+};
+
+//===========================================================================
+// Profiler
+//===========================================================================
+
+//---------------------------------------------------------------------------
+// Profiler::getName
+//---------------------------------------------------------------------------
+const char *Profiler::getName( Phase phase )
+{
+	return PhaseNames[phase];
+}
+
+//---------------------------------------------------------------------------
+// Profiler::getParent
+//---------------------------------------------------------------------------
+Profiler::Phase Profiler::getParent( Phase phase )
+{
+	switch( phase )
+	{
+	case Vision:
+	case Brains:
+	case Bodies:
+		return Agents;
+	default:
+		return Step;
+	}
+}
+
+//---------------------------------------------------------------------------
+// Profiler::getDepth
+//---------------------------------------------------------------------------
+int Profiler::getDepth( Phase phase )
+{
+	int depth = 0;
+	for( ; phase != Step; phase = getParent(phase) )
+		depth++;
+	return depth;
+}
+
+//---------------------------------------------------------------------------
+// Profiler::Profiler
+//---------------------------------------------------------------------------
+Profiler::Profiler()
+	: enabled( false )
+	, frequency( 0 )
+	, scheduler( NULL )
+	, writer( NULL )
+	, nsteps( 0 )
+{
+	memset( start, 0, sizeof(start) );
+	memset( elapsed, 0, sizeof(elapsed) );
+	memset( millis, 0, sizeof(millis) );
+}
+
+//---------------------------------------------------------------------------
+// Profiler::~Profiler
+//---------------------------------------------------------------------------
+Profiler::~Profiler()
+{
+	delete writer;
+}
+
+//---------------------------------------------------------------------------
+// Profiler::init
+//---------------------------------------------------------------------------
+void Profiler::init( bool enabled, int frequency, Scheduler *scheduler )
+{
+	assert( writer == NULL );
+
+	this->enabled = enabled;
+	this->frequency = frequency;
+	this->scheduler = scheduler;
+
+	scheduler->setProfiling( enabled );
+
+	if( !enabled )
+		return;
+
+	threadBusy.resize( scheduler->getPoolThreadCount(), 0.0 );
+
+	std::vector<std::string> colnames;
+	std::vector<datalib::Type> coltypes;
+
+	colnames.push_back( "T" );
+	coltypes.push_back( datalib::INT );
+	for( int i = 0; i < __NPHASES; i++ )
+	{
+		colnames.push_back( PhaseNames[i] );
+		coltypes.push_back( datalib::FLOAT );
+	}
+	for( size_t i = 0; i < threadBusy.size(); i++ )
+	{
+		colnames.push_back( "Thread" + std::to_string(i) + "Busy" );
+		coltypes.push_back( datalib::FLOAT );
+	}
+
+	makeParentDir( TIMING_PATH );
+	writer = new DataLibWriter( TIMING_PATH );
+	writer->beginTable( "Timing", colnames, coltypes );
+}
+
+//---------------------------------------------------------------------------
+// Profiler::beginStep
+//---------------------------------------------------------------------------
+void Profiler::beginStep()
+{
+	if( enabled )
+		begin( Step );
+}
+
+//---------------------------------------------------------------------------
+// Profiler::endStep
+//
+// Must come after everything else in the step, logging included.
+//---------------------------------------------------------------------------
+void Profiler::endStep( long step )
+{
+	if( !enabled )
+		return;
+
+	end( Step );
+	nsteps++;
+
+	if( (step % frequency) == 0 )
+		record( step );
+}
+
+//---------------------------------------------------------------------------
+// Profiler::record
+//---------------------------------------------------------------------------
+void Profiler::record( long step )
+{
+	// Brains run on the pool while the master renders, so they aren't timed
+	// directly. What remains of Agents after Vision and Bodies is the brain
+	// work that didn't overlap rendering, which is what the step pays for.
+	elapsed[Brains] = elapsed[Agents] - elapsed[Vision] - elapsed[Bodies];
+
+	for( int i = 0; i < __NPHASES; i++ )
+	{
+		millis[i] = 1000.0 * elapsed[i] / nsteps;
+		elapsed[i] = 0.0;
+	}
+	nsteps = 0;
+
+	std::vector<double> busy;
+	double available;
+	scheduler->takeThreadTimes( busy, available );
+	for( size_t i = 0; i < threadBusy.size(); i++ )
+		threadBusy[i] = available > 0.0 ? busy[i] / available : 0.0;
+
+	std::vector<Variant> row;
+	row.push_back( (int)step );
+	for( int i = 0; i < __NPHASES; i++ )
+		row.push_back( (float)millis[i] );
+	for( double fraction : threadBusy )
+		row.push_back( (float)fraction );
+
+	writer->addRow( row.data() );
+	writer->flush();
+}
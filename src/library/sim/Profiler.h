@@ -0,0 +1,116 @@
+#pragma once
+
+#include <chrono>
+#include <vector>
+
+class DataLibWriter;
+class Scheduler;
+
+//===========================================================================
+// Profiler
+//
+// Wall-clock time spent in each phase of TSimulation::Step(). Enabled by
+// RecordTiming; when disabled a Scope costs a single branch. Every
+// TimingRecordFrequency steps the per-step means over the interval, along
+// with how busy each scheduler pool thread was, are written as a row of
+// run/stats/timing.txt and kept for the status text.
+//===========================================================================
+class Profiler
+{
+ public:
+	// Phases are listed depth-first; see getParent() for the hierarchy.
+	enum Phase
+	{
+		Step,
+		Properties,
+		Barriers,
+		EnergyCosts,
+		Agents,
+		Vision,
+		Brains,
+		Bodies,
+		Interact,
+		CreateAgents,
+		Bricks,
+		Food,
+		Monitors,
+		Logs,
+		__NPHASES
+	};
+
+	static const char *getName( Phase phase );
+	// Step is its own parent.
+	static Phase getParent( Phase phase );
+	static int getDepth( Phase phase );
+
+	// Times the enclosing block as the given phase. Phases may be entered
+	// several times per step (e.g. once per agent); the times accumulate.
+	class Scope
+	{
+	public:
+		Scope( Profiler &profiler, Phase phase )
+			: profiler( profiler.enabled ? &profiler : NULL )
+			, phase( phase )
+		{
+			if( this->profiler )
+				this->profiler->begin( phase );
+		}
+		~Scope()
+		{
+			if( profiler )
+				profiler->end( phase );
+		}
+
+	private:
+		Profiler *profiler;
+		Phase phase;
+	};
+
+	Profiler();
+	~Profiler();
+
+	void init( bool enabled, int frequency, Scheduler *scheduler );
+	bool isEnabled() const;
+
+	void beginStep();
+	void endStep( long step );
+
+	// Mean milliseconds per step over the last completed interval.
+	double getMillis( Phase phase ) const;
+	// Per pool thread, the fraction of the last completed interval's
+	// parallel sections spent running tasks.
+	const std::vector<double> &getThreadBusy() const;
+
+ private:
+	void begin( Phase phase );
+	void end( Phase phase );
+	void record( long step );
+
+	static double now();
+
+	bool enabled;
+	int frequency;
+	Scheduler *scheduler;
+	DataLibWriter *writer;
+
+	double start[__NPHASES];
+	double elapsed[__NPHASES];
+	long nsteps;
+
+	double millis[__NPHASES];
+	std::vector<double> threadBusy;
+};
+
+//===========================================================================
+// inlines
+//===========================================================================
+inline bool Profiler::isEnabled() const { return enabled; }
+inline void Profiler::begin( Phase phase ) { start[phase] = now(); }
+inline void Profiler::end( Phase phase ) { elapsed[phase] += now() - start[phase]; }
+inline double Profiler::getMillis( Phase phase ) const { return millis[phase]; }
+inline const std::vector<double> &Profiler::getThreadBusy() const { return threadBusy; }
+
+inline double Profiler::now()
+{
+	return std::chrono::duration<double>( std::chrono::steady_clock::now().time_since_epoch() ).count();
+}
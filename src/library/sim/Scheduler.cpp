@@ -1,11 +1,24 @@
 #include "Scheduler.h"
+#include "SimulationContext.h"
 
 #include <assert.h>
+#include <chrono>
 #include <iostream>
 #include <thread>
 
-static unsigned get_thread_count()
+unsigned Scheduler::threadCount = 0;
+
+static long long now_nanos()
+{
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+static unsigned get_thread_count( unsigned budget )
 {
+    if( budget > 0 )
+        return budget - 1;
+
     unsigned ncores = std::thread::hardware_concurrency();
     if(ncores == 0)
     {
@@ -17,8 +30,20 @@ static unsigned get_thread_count()
 }
 
 Scheduler::Scheduler()
-    : threadPool(get_thread_count())
+    : poolThreadCount(get_thread_count(threadCount))
+    , threadPool(poolThreadCount)
+    , profiling(false)
+    , busyNanos(new std::atomic<long long>[poolThreadCount])
+    , nextPoolThreadIndex(0)
+    , availableNanos(0)
+{
+    for(unsigned i = 0; i < poolThreadCount; i++)
+        busyNanos[i] = 0;
+}
+
+void Scheduler::setThreadCount( unsigned nthreads )
 {
+    threadCount = nthreads;
 }
 
 void Scheduler::execMasterTask( Task masterTask,
@@ -35,11 +60,17 @@ void Scheduler::execMasterTask( Task masterTask,
         assert(state == Idle);
         state = Master;
 
+        masterThread = std::this_thread::get_id();
+        long long start = profiling ? now_nanos() : 0;
+
         masterTask();
 
         state = Parallel;
         threadPool.join();
 
+        if(profiling)
+            availableNanos += now_nanos() - start;
+
         state = Serial;
         for(Task &task: serialTasks)
         {
@@ -60,7 +91,28 @@ void Scheduler::postParallel( Task task )
 	else
 	{
         assert(state == Master);
-        threadPool.schedule( task );
+        // Pool threads run the task against the poster's simulation.
+        SimulationContext *context = SimulationContext::current();
+        if(profiling)
+        {
+            threadPool.schedule( [this, context, task]() {
+                SimulationContext::Scope scope( context );
+                long long start = now_nanos();
+                task();
+                // The master helps drain the queue in join(); that isn't
+                // pool time.
+                int index = getPoolThreadIndex();
+                if(index >= 0)
+                    busyNanos[index] += now_nanos() - start;
+            });
+        }
+        else
+        {
+            threadPool.schedule( [context, task]() {
+                SimulationContext::Scope scope( context );
+                task();
+            });
+        }
 	}
 }
 
@@ -79,3 +131,46 @@ void Scheduler::postSerial( Task task )
 	}
 		
 }
+
+void Scheduler::setProfiling( bool enabled )
+{
+    assert(state == Idle);
+    profiling = enabled;
+}
+
+unsigned Scheduler::getPoolThreadCount() const
+{
+    return poolThreadCount;
+}
+
+void Scheduler::takeThreadTimes( std::vector<double> &busy, double &available )
+{
+    assert(state == Idle);
+
+    busy.resize(poolThreadCount);
+    for(unsigned i = 0; i < poolThreadCount; i++)
+        busy[i] = busyNanos[i].exchange(0) * 1e-9;
+
+    available = availableNanos * 1e-9;
+    availableNanos = 0;
+}
+
+// Pool threads are numbered in the order they first run a profiled task.
+// Returns -1 on threads outside the pool.
+int Scheduler::getPoolThreadIndex()
+{
+    static thread_local const Scheduler *owner = nullptr;
+    static thread_local int index = -1;
+
+    if(owner != this)
+    {
+        if(std::this_thread::get_id() == masterThread)
+            return -1;
+        owner = this;
+        index = nextPoolThreadIndex++;
+        if(index >= (int)poolThreadCount)
+            index = -1;
+    }
+
+    return index;
+}
@@ -1,7 +1,10 @@
 #pragma once
 
+#include <atomic>
 #include <functional>
+#include <memory>
 #include <mutex>
+#include <thread>
 #include <vector>
 
 #include "utils/ThreadPool.h"
@@ -13,17 +16,40 @@ class Scheduler
 
     Scheduler();
 
+    // Total threads, including the master, used by Schedulers created
+    // afterwards. 0 (the default) uses one per core.
+    static void setThreadCount( unsigned nthreads );
+
 	void execMasterTask(Task masterTask,
                         bool forceAllSerial );
 	void postParallel( Task task );
 	void postSerial( Task task );
 
+    // Time accounting for the Profiler; off by default.
+    void setProfiling( bool enabled );
+    unsigned getPoolThreadCount() const;
+    // Seconds each pool thread spent running tasks, and the wall time of the
+    // parallel sections (master task through join) they could have run in,
+    // both since the previous call.
+    void takeThreadTimes( std::vector<double> &busy, double &available );
+
  private:
+    int getPoolThreadIndex();
+
     enum State {Idle, Master, Parallel, Serial} state = Idle;
 
+    static unsigned threadCount;
+
+    unsigned poolThreadCount;
     ThreadPool threadPool;
 
     std::vector<Task> serialTasks;
     std::mutex serialMutex;
 	bool forceAllSerial;
+
+    bool profiling;
+    std::unique_ptr<std::atomic<long long>[]> busyNanos;
+    std::atomic<int> nextPoolThreadIndex;
+    long long availableNanos;
+    std::thread::id masterThread;
 };
@@ -53,7 +53,6 @@
 #include "agent/AgentPovRenderer.h"
 #include "agent/Metabolism.h"
 #include "brain/Brain.h"
-#include "brain/groups/GroupsBrain.h"
 #include "brain/sheets/SheetsBrain.h"
 #include "complexity/complexity.h"
 #include "environment/barrier.h"
@@ -70,6 +69,7 @@
 #include "utils/objectxsortedlist.h"
 #include "utils/PwMovieUtils.h"
 #include "utils/RandomNumberGenerator.h"
+#include "utils/RandomStream.h"
 #include "utils/Resources.h"
 
 using namespace genome;
@@ -83,32 +83,10 @@ using namespace genome;
 #define UTILS_PATH ""
 #endif
 
-struct SheetSynapseType { sheets::Sheet::Type from, to; };
-static std::vector<SheetSynapseType> SheetSynapseTypes =
-	{
-		{ sheets::Sheet::Input, sheets::Sheet::Internal },
-		{ sheets::Sheet::Input, sheets::Sheet::Output },
-		{ sheets::Sheet::Internal, sheets::Sheet::Internal },
-		{ sheets::Sheet::Internal, sheets::Sheet::Output },
-		{ sheets::Sheet::Output, sheets::Sheet::Internal },
-		{ sheets::Sheet::Output, sheets::Sheet::Output },
-	};
 //===========================================================================
 // TSimulation
 //===========================================================================
 
-static long numglobalcreated = 0;    // needs to be static so we only get warned about influence of global creations once ever
-
-long TSimulation::fMaxNumAgents;
-long LIBRARY_SHARED TSimulation::fStep;
-double TSimulation::fFramesPerSecondOverall;
-double TSimulation::fSecondsPerFrameOverall;
-double TSimulation::fFramesPerSecondRecent;
-double TSimulation::fSecondsPerFrameRecent;
-double TSimulation::fFramesPerSecondInstantaneous;
-double TSimulation::fSecondsPerFrameInstantaneous;
-double TSimulation::fTimeStart;
-
 //---------------------------------------------------------------------------
 // Prototypes
 //---------------------------------------------------------------------------
@@ -198,7 +176,35 @@ inline float AverageAngles( float a, float b )
 // TSimulation::TSimulation
 //---------------------------------------------------------------------------
 TSimulation::TSimulation( std::string worldfilePath, proplib::ParameterMap parameters )
+	: TSimulation()
+{
+	proplib::DocumentBuilder builder;
+	proplib::SchemaDocument *schema = builder.buildSchemaDocument( "./etc/worldfile.wfs" );
+	proplib::Document *worldfile = builder.buildWorldfileDocument( schema, worldfilePath, parameters );
+
+	Init( schema, worldfile );
+
+	delete schema;
+}
+
+//---------------------------------------------------------------------------
+// TSimulation::TSimulation
+//---------------------------------------------------------------------------
+TSimulation::TSimulation( proplib::SchemaDocument *schema, proplib::Document *worldfile,
+						  const std::string &runDirectory )
+	: TSimulation()
+{
+	fContext.runDirectory = runDirectory;
+	Init( schema, worldfile );
+}
+
+//---------------------------------------------------------------------------
+// TSimulation::TSimulation
+//---------------------------------------------------------------------------
+TSimulation::TSimulation()
 	:
+		fContextScope(&fContext),
+
 		fLockStepWithBirthsDeathsLog(false),
 		fLockstepFile(NULL),
 
@@ -240,34 +246,41 @@ TSimulation::TSimulation( std::string worldfilePath, proplib::ParameterMap param
 		fLastCreated(0),
 		fMaxGapCreate(0),
 		fNumBornSinceCreated(0),
+		fNumGlobalCreated(0),
+		fStatusLastNumberBorn(0),
+		fStatusDeltaBorn(0),
 
 		agentPovRenderer(NULL)
 {
+	fContext.simulation = this;
 	fStep = 0;
+	fFrame = 0;
 	memset( fNumberAliveWithMetabolism, 0, sizeof(fNumberAliveWithMetabolism) );
+}
 
-	fCurrentBrainStats.sheets.synapseCount = new Stat *[ sheets::Sheet::__NTYPES ];
-	for( int i = 0; i < sheets::Sheet::__NTYPES; i++ )
-		fCurrentBrainStats.sheets.synapseCount[i] = new Stat[ sheets::Sheet::__NTYPES ];
-
+//---------------------------------------------------------------------------
+// TSimulation::Init
+//---------------------------------------------------------------------------
+void TSimulation::Init( proplib::SchemaDocument *schema, proplib::Document *worldfile )
+{
     srand(1);
 
 	// ---
 	// --- Create the run directory
 	// ---
 	{
-		char s[256];
+		const char *run = fContext.runDirectory.c_str();
 		char t[256];
 
 		// First save the old directory, if it exists
-		sprintf( s, "run" );
-        sprintf( t, "run_%lld", time(NULL) );
-		(void) rename( s, t );
+        sprintf( t, "%s_%lld", run, time(NULL) );
+		(void) rename( run, t );
+		makeParentDir( run );
 
 #if !__WIN64__ && !__WIN32__
-        if( mkdir("run", PwDirMode) ) {
+        if( mkdir(run, PwDirMode) ) {
 #else
-        if (_mkdir("run")) {
+        if (_mkdir(run)) {
 #endif
 			eprintf( "Error making run directory (%d)\n", errno );
 			exit( 1 );
@@ -277,21 +290,13 @@ TSimulation::TSimulation( std::string worldfilePath, proplib::ParameterMap param
 	// ---
 	// --- Process the Worldfile
 	// ---
-	proplib::SchemaDocument *schema;
-	proplib::Document *worldfile;
-    {
-		proplib::DocumentBuilder builder;
-        schema = builder.buildSchemaDocument( "./etc/worldfile.wfs" );
-		worldfile = builder.buildWorldfileDocument( schema, worldfilePath, parameters );
-
-		{
-            std::ofstream out( "run/converted.wf" );
-			proplib::DocumentWriter writer( out );
-			writer.write( worldfile );
-		}
-
-		schema->apply( worldfile );
+	{
+        std::ofstream out( SimulationContext::runPath("converted.wf") );
+		proplib::DocumentWriter writer( out );
+		writer.write( worldfile );
 	}
+
+	schema->apply( worldfile );
 	processWorldFile( worldfile );
 	agent::processWorldfile( *worldfile );
 	GenomeSchema::processWorldfile( *worldfile );
@@ -332,13 +337,13 @@ TSimulation::TSimulation( std::string worldfilePath, proplib::ParameterMap param
 	 // Note:  this code must agree with the agent sizing in agent::grow()
 	 // and the food sizing in food::initlen().
 
-	float maxagentlenx = agent::config.maxAgentSize / sqrt(agent::config.minmaxspeed);
-	float maxagentlenz = agent::config.maxAgentSize * sqrt(agent::config.maxmaxspeed);
+	float maxagentlenx = agent::config().maxAgentSize / sqrt(agent::config().minmaxspeed);
+	float maxagentlenz = agent::config().maxAgentSize * sqrt(agent::config().maxmaxspeed);
 	float maxagentradius = 0.5 * sqrt(maxagentlenx*maxagentlenx + maxagentlenz*maxagentlenz);
-	float maxfoodlen = 0.75 * food::gMaxFoodEnergy / food::gSize2Energy;
+	float maxfoodlen = 0.75 * food::gMaxFoodEnergy() / food::gSize2Energy();
 	float maxfoodradius = 0.5 * sqrt(maxfoodlen * maxfoodlen * 2.0);
-	food::gMaxFoodRadius = maxfoodradius;
-	agent::config.maxRadius = maxagentradius > maxfoodradius ?
+	food::gMaxFoodRadius() = maxfoodradius;
+	agent::config().maxRadius = maxagentradius > maxfoodradius ?
 						  maxagentradius : maxfoodradius;
 
 	InitFittest();
@@ -370,7 +375,7 @@ TSimulation::TSimulation( std::string worldfilePath, proplib::ParameterMap param
 			exit(1);
 		}
 
-        SYSTEM(UTILS_PATH "cp LOCKSTEP-BirthsDeaths.log run/" );    // copy the LOCKSTEP file into the run/ directory.
+        SYSTEM( (UTILS_PATH "cp LOCKSTEP-BirthsDeaths.log " + fContext.runDirectory).c_str() );    // copy the LOCKSTEP file into the run/ directory.
         SetNextLockstepEvent();                                     // setup for the first timestep in which Birth/Death events occurred.
 
 	}
@@ -383,15 +388,23 @@ TSimulation::TSimulation( std::string worldfilePath, proplib::ParameterMap param
 	fEnergyEaten.zero();
 
 	srand48(fGenomeSeed);
+	RandomStream::setSeed(fGenomeSeed);
 
 	agentPovRenderer = AgentPovRenderer::create( fMaxNumAgents,
-                                                 Brain::config.retinaWidth,
-                                                 Brain::config.retinaHeight );
+                                                 Brain::config().retinaWidth,
+                                                 Brain::config().retinaHeight );
 
 	// ---
 	// --- Init Logs
 	// ---
-	logs = new Logs( this, worldfile );
+	fContext.logs = new Logs( this, worldfile );
+
+	// ---
+	// --- Init Profiler
+	// ---
+	fProfiler.init( worldfile->get("RecordTiming"),
+					worldfile->get("TimingRecordFrequency"),
+					&fScheduler );
 
 	// ---
 	// --- Set Maximum Open Files
@@ -399,7 +412,7 @@ TSimulation::TSimulation( std::string worldfilePath, proplib::ParameterMap param
 	{
 		int maxOpenFiles = 100; // just a fudge
 
-		maxOpenFiles += logs->getMaxOpenFiles();
+		maxOpenFiles += fContext.logs->getMaxOpenFiles();
 
 		// If we're going to be saving info on all these files, must increase the number allowed open
 		if( SetMaximumFiles( maxOpenFiles ) )
@@ -434,6 +447,8 @@ TSimulation::TSimulation( std::string worldfilePath, proplib::ParameterMap param
     fTotalFoodEnergyIn = fFoodEnergyIn;
     fTotalFoodEnergyOut = fFoodEnergyOut;
     fTotalEnergyEaten = fEnergyEaten;
+    fStatusLastEnergyEaten = Energy( 0.0f );
+    fStatusDeltaEnergy = Energy( 0.0f );
     fAverageFoodEnergyIn = 0.0;
     fAverageFoodEnergyOut = 0.0;
 
@@ -461,17 +476,16 @@ TSimulation::TSimulation( std::string worldfilePath, proplib::ParameterMap param
 	// --- Save worldfile data to run/ and dispose documents
 	// ---
 	{
-        SYSTEM( (UTILS_PATH "cp " + worldfile->getPath() + " run/original.wf").c_str() );
-        SYSTEM( (UTILS_PATH "cp " + schema->getPath() + " run/original.wfs").c_str() );
+        SYSTEM( (UTILS_PATH "cp " + worldfile->getPath() + " " + SimulationContext::runPath("original.wf")).c_str() );
+        SYSTEM( (UTILS_PATH "cp " + schema->getPath() + " " + SimulationContext::runPath("original.wfs")).c_str() );
 
 		{
-            std::ofstream out( "run/normalized.wf" );
+            std::ofstream out( SimulationContext::runPath("normalized.wf") );
 			proplib::DocumentWriter writer( out );
 			writer.write( worldfile );
 		}
 
 		delete worldfile;
-		delete schema;
 	}
 
 #if DebugLockStep
@@ -483,7 +497,7 @@ TSimulation::TSimulation( std::string worldfilePath, proplib::ParameterMap param
 	}
 #endif
 
-	logs->postEvent( SimInitedEvent() );
+	fContext.logs->postEvent( SimInitedEvent() );
 }
 
 
@@ -492,14 +506,10 @@ TSimulation::TSimulation( std::string worldfilePath, proplib::ParameterMap param
 //---------------------------------------------------------------------------
 TSimulation::~TSimulation()
 {
-	for( int i = 0; i < sheets::Sheet::__NTYPES; i++ )
-		delete [] fCurrentBrainStats.sheets.synapseCount[i];
-	delete [] fCurrentBrainStats.sheets.synapseCount;
-
 	agent *a;
 
-	objectxsortedlist::gXSortedObjects.reset();
-	while (objectxsortedlist::gXSortedObjects.nextObj(AGENTTYPE, (gobject**)&a))
+	objectxsortedlist::gXSortedObjects().reset();
+	while (objectxsortedlist::gXSortedObjects().nextObj(AGENTTYPE, (gobject**)&a))
 	{
 		Kill( a, LifeSpan::DR_SIMEND );
 	}
@@ -507,15 +517,16 @@ TSimulation::~TSimulation()
 	// ---
 	// --- Dispose Logs
 	// ---
-	delete logs;
+	delete fContext.logs;
+	fContext.logs = NULL;
 
 	if( fLockstepFile )
 		fclose( fLockstepFile );
 
 	{
 		barrier* b;
-		barrier::gXSortedBarriers.reset();
-		while( barrier::gXSortedBarriers.next( b ) )
+		barrier::gXSortedBarriers().reset();
+		while( barrier::gXSortedBarriers().next( b ) )
 			delete b;
 	}
 
@@ -523,8 +534,8 @@ TSimulation::~TSimulation()
 	gobject* gob = NULL;
 
 	// delete all non-agents
-	objectxsortedlist::gXSortedObjects.reset();
-	while (objectxsortedlist::gXSortedObjects.next(gob))
+	objectxsortedlist::gXSortedObjects().reset();
+	while (objectxsortedlist::gXSortedObjects().next(gob))
 		if (gob->getType() != AGENTTYPE)
 		{
 			//delete gob;	// ??? why aren't these being deleted?  do we need to delete them by type?  make the destructor virtual?  what???
@@ -532,7 +543,7 @@ TSimulation::~TSimulation()
 	// delete all agents
 	// all the agents are deleted in agentdestruct
 	// rather than cycling through them in xsortedagents here
-	objectxsortedlist::gXSortedObjects.clear();
+	objectxsortedlist::gXSortedObjects().clear();
 
 
 	// TODO who owns items on stage?
@@ -561,7 +572,7 @@ TSimulation::~TSimulation()
 	printf( "Simulation stopped after step %ld\n", fStep );
 
 	{
-        std::ofstream fout( "run/endStep.txt" );
+        std::ofstream fout( SimulationContext::runPath("endStep.txt") );
         fout << fStep << std::endl;
 		fout.close();
 	}
@@ -574,17 +585,19 @@ TSimulation::~TSimulation()
 void TSimulation::Step()
 {
 #define RecentSteps 10
-	static double	sTimePrevious[RecentSteps];
-	static unsigned long frame = 0;
 	double			timeNow;
 
-	if( (frame == 0) && (fSimulationSeed != 0) )
+	// Another simulation may have been stepped on this thread in between.
+	SimulationContext::Scope contextScope( &fContext );
+
+	if( (fFrame == 0) && (fSimulationSeed != 0) )
 	{
 		srand48(fSimulationSeed);
+		RandomStream::setSeed(fSimulationSeed);
 	}
 
-	frame++;
-//	printf( "%s: frame = %lu\n", __FUNCTION__, frame );
+	fFrame++;
+//	printf( "%s: frame = %lu\n", __FUNCTION__, fFrame );
 
 	if( fMaxSteps && ((fStep+1) > fMaxSteps) )
 	{
@@ -592,7 +605,7 @@ void TSimulation::Step()
 		return;
 	}
 	else if( fEndOnPopulationCrash &&
-			 (objectxsortedlist::gXSortedObjects.getCount(AGENTTYPE) <= fMinNumAgents) )
+			 (objectxsortedlist::gXSortedObjects().getCount(AGENTTYPE) <= fMinNumAgents) )
 	{
         std::cerr << "Population crash at step " << fStep << std::endl;
 		End( "PopulationCrash" );
@@ -600,6 +613,7 @@ void TSimulation::Step()
 	}
 
 	fStep++;
+	fProfiler.beginStep();
 
 	debugcheck( "beginning of step %ld", fStep );
 
@@ -625,18 +639,18 @@ void TSimulation::Step()
 
 		if( fStep > RecentSteps )
 		{
-			fFramesPerSecondRecent = RecentSteps / (timeNow - sTimePrevious[RecentSteps-1]);
+			fFramesPerSecondRecent = RecentSteps / (timeNow - fTimePrevious[RecentSteps-1]);
 			fSecondsPerFrameRecent = 1. / fFramesPerSecondRecent;
 		}
 
-		fFramesPerSecondInstantaneous = 1. / (timeNow - sTimePrevious[0]);
+		fFramesPerSecondInstantaneous = 1. / (timeNow - fTimePrevious[0]);
 		fSecondsPerFrameInstantaneous = 1. / fFramesPerSecondInstantaneous;
 
 		int numSteps = fStep < RecentSteps ? fStep : RecentSteps;
 		for( int i = numSteps-1; i > 0; i-- )
-			sTimePrevious[i] = sTimePrevious[i-1];
+			fTimePrevious[i] = fTimePrevious[i-1];
 	}
-	sTimePrevious[0] = timeNow;
+	fTimePrevious[0] = timeNow;
 
 	if (((fStep - fLastCreated) > fMaxGapCreate) && (fLastCreated > 0) )
 		fMaxGapCreate = fStep - fLastCreated;
@@ -659,19 +673,30 @@ void TSimulation::Step()
 	fEnergyEaten.zero();
 
 	// Update dynamic properties
-	proplib::CppProperties::update();
+	{
+		Profiler::Scope scope( fProfiler, Profiler::Properties );
+		proplib::CppProperties::update();
+	}
 
 	// Update the barriers, since they can be dynamic
-	barrier* b;
-	barrier::gXSortedBarriers.reset();
-	while( barrier::gXSortedBarriers.next( b ) )
-		b->update();
-	barrier::gXSortedBarriers.xsort();
+	{
+		Profiler::Scope scope( fProfiler, Profiler::Barriers );
+		barrier* b;
+		barrier::gXSortedBarriers().reset();
+		while( barrier::gXSortedBarriers().next( b ) )
+			b->update();
+		barrier::gXSortedBarriers().xsort();
+	}
 
-	MaintainEnergyCosts();
+	{
+		Profiler::Scope scope( fProfiler, Profiler::EnergyCosts );
+		MaintainEnergyCosts();
+	}
 
 	// Update all agents, using their neurally controlled behaviors
 	{
+		Profiler::Scope scope( fProfiler, Profiler::Agents );
+
 		agentPovRenderer->beginStep();
 
 		if( fStaticTimestepGeometry )
@@ -690,10 +715,13 @@ void TSimulation::Step()
 	// !!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!
 	// !!! EXEC MASTER
 	// !!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!
-	fScheduler.execMasterTask( [=]() { Interact(); },
-							   !fParallelInteract );
+	{
+		Profiler::Scope scope( fProfiler, Profiler::Interact );
+		fScheduler.execMasterTask( [=]() { Interact(); },
+								   !fParallelInteract );
+	}
 
-	assert( fNumberAlive == objectxsortedlist::gXSortedObjects.getCount(AGENTTYPE) );
+	assert( fNumberAlive == objectxsortedlist::gXSortedObjects().getCount(AGENTTYPE) );
 
 	debugcheck( "after Interact() in step %ld", fStep );
 
@@ -710,20 +738,29 @@ void TSimulation::Step()
 	// !!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!
 	// !!! EXEC MASTER
 	// !!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!
-	fScheduler.execMasterTask( [=]() { CreateAgents(); },
-							   !fParallelCreateAgents );
+	{
+		Profiler::Scope scope( fProfiler, Profiler::CreateAgents );
+		fScheduler.execMasterTask( [=]() { CreateAgents(); },
+								   !fParallelCreateAgents );
+	}
 
 	// -------------------------
 	// ---- Maintain Bricks ----
 	// -------------------------
 	// maintain bricks, which may be in dynamic patches...
-	MaintainBricks();
+	{
+		Profiler::Scope scope( fProfiler, Profiler::Bricks );
+		MaintainBricks();
+	}
 
 	// -----------------------
 	// ---- Maintain Food ----
 	// -----------------------
 	// finally, maintain the world's food supply...
-	MaintainFood();
+	{
+		Profiler::Scope scope( fProfiler, Profiler::Food );
+		MaintainFood();
+	}
 
 	fTotalFoodEnergyIn += fFoodEnergyIn;
 	fTotalFoodEnergyOut += fFoodEnergyOut;
@@ -735,21 +772,30 @@ void TSimulation::Step()
 	// ---------------------------------------------------
 	// ---- Step Ending Signal (e.g. update monitors) ----
 	// ---------------------------------------------------
-    stepEnding();
+	{
+		Profiler::Scope scope( fProfiler, Profiler::Monitors );
+		stepEnding();
+	}
 
-	// ---------------
-	// ---- Epoch ----
-	// ---------------
-	if( fEpochFrequency && ((fStep % fEpochFrequency) == 0) )
 	{
-		logs->postEvent( EpochEndEvent(fStep) );
+		Profiler::Scope scope( fProfiler, Profiler::Logs );
 
-		fEpoch += fEpochFrequency;
+		// ---------------
+		// ---- Epoch ----
+		// ---------------
+		if( fEpochFrequency && ((fStep % fEpochFrequency) == 0) )
+		{
+			fContext.logs->postEvent( EpochEndEvent(fStep) );
 
-		fRecentFittest->clear();
+			fEpoch += fEpochFrequency;
+
+			fRecentFittest->clear();
+		}
+
+		fContext.logs->postEvent( StepEndEvent() );
 	}
 
-	logs->postEvent( StepEndEvent() );
+	fProfiler.endStep( fStep );
 }
 
 //---------------------------------------------------------------------------
@@ -758,11 +804,11 @@ void TSimulation::Step()
 void TSimulation::End( const std::string &reason )
 {
 	{
-        std::ofstream fout( "run/endReason.txt" );
+        std::ofstream fout( SimulationContext::runPath("endReason.txt") );
         fout << reason << std::endl;
 		fout.close();
 	}
-	logs->postEvent( SimEndEvent() );
+	fContext.logs->postEvent( SimEndEvent() );
 
 	ended();
 }
@@ -831,7 +877,7 @@ void TSimulation::InitGround()
 	Resources::loadPolygons( &fGround, "ground" );
 
     fGround.sety(-fGroundClearance);
-    fGround.setscale(globals::worldsize);
+    fGround.setscale(globals::worldsize());
     fGround.setcolor(fGroundColor);
     fWorldSet.Add(&fGround);
 }
@@ -851,7 +897,7 @@ void TSimulation::InitAgents()
 	{
 		numSeededDomain = 0;	// reset for each domain
 
-        int limit = std::min((fMaxNumAgents - (long)objectxsortedlist::gXSortedObjects.getCount(AGENTTYPE)), fDomains[id].initNumAgents);
+        int limit = std::min((fMaxNumAgents - (long)objectxsortedlist::gXSortedObjects().getCount(AGENTTYPE)), fDomains[id].initNumAgents);
 		for (int i = 0; i < limit; i++)
 		{
 			bool isSeed = false;
@@ -889,11 +935,11 @@ void TSimulation::InitAgents()
 
 			float x, z;
 			fDomains[id].initAgentsPatch->setPoint( &x, &z );
-			float y = 0.5 * agent::config.agentHeight;
+			float y = 0.5 * agent::config().agentHeight;
 #if TestWorld
 			// evenly distribute the agents
 			x = fDomains[id].xleft  +  0.666 * fDomains[id].xsize;
-			z = - globals::worldsize * ((float) (i+1) / (fDomains[id].initNumAgents + 1));
+			z = - globals::worldsize() * ((float) (i+1) / (fDomains[id].initNumAgents + 1));
 #endif
 			if( isSeed )
 			{
@@ -912,7 +958,7 @@ void TSimulation::InitAgents()
 #endif
 			c->setyaw(yaw);
 
-			objectxsortedlist::gXSortedObjects.add(c);	// stores c->listLink
+			objectxsortedlist::gXSortedObjects().add(c);	// stores c->listLink
 
 			c->Domain(id);
 			fDomains[id].numAgents++;
@@ -933,7 +979,7 @@ void TSimulation::InitAgents()
 	// Handle global initial creations, if necessary
 	assert( fInitNumAgents <= fMaxNumAgents );
 
-	while( (int)objectxsortedlist::gXSortedObjects.getCount(AGENTTYPE) < fInitNumAgents )
+	while( (int)objectxsortedlist::gXSortedObjects().getCount(AGENTTYPE) < fInitNumAgents )
 	{
 		bool isSeed = true;
 
@@ -966,9 +1012,9 @@ void TSimulation::InitAgents()
 
 		fStage.AddObject(c);
 
-		float x =  0.01 + randpw() * (globals::worldsize - 0.02);
-		float z = -0.01 - randpw() * (globals::worldsize - 0.02);
-		float y = 0.5 * agent::config.agentHeight;
+		float x =  0.01 + randpw() * (globals::worldsize() - 0.02);
+		float z = -0.01 - randpw() * (globals::worldsize() - 0.02);
+		float y = 0.5 * agent::config().agentHeight;
 		if( isSeed )
 		{
 			SetSeedPosition( c, numSeededTotal - 1, x, y, z );
@@ -981,7 +1027,7 @@ void TSimulation::InitAgents()
 		float yaw =  360.0 * randpw();
 		c->setyaw(yaw);
 
-		objectxsortedlist::gXSortedObjects.add(c);	// stores c->listLink
+		objectxsortedlist::gXSortedObjects().add(c);	// stores c->listLink
 
 		id = WhichDomain(x, z, 0);
 		c->Domain(id);
@@ -1048,8 +1094,8 @@ void TSimulation::InitBarriers()
 {
 	// Add barriers
 	barrier* b = NULL;
-	barrier::gXSortedBarriers.reset();
-	while( barrier::gXSortedBarriers.next(b) )
+	barrier::gXSortedBarriers().reset();
+	while( barrier::gXSortedBarriers().next(b) )
 		fWorldSet.Add(b);
 }
 
@@ -1119,8 +1165,8 @@ void TSimulation::ReadSeedFilePaths()
 		exit( 1 );
 	}
 
-    makeDirs("run/genome");
-    SYSTEM(UTILS_PATH "cp genomeSeeds.txt run/genome");
+    makeDirs( SimulationContext::runPath("genome") );
+    SYSTEM( (UTILS_PATH "cp genomeSeeds.txt " + SimulationContext::runPath("genome")).c_str() );
 
 	char buf[1024 * 4];
 	while( !in.eof() )
@@ -1180,7 +1226,7 @@ void TSimulation::ReadSeedPositionsFromFile()
 		exit( 1 );
 	}
 
-    SYSTEM(UTILS_PATH "mkdir -p run/motion/position && " UTILS_PATH "cp seedPositions.txt run/motion/position" );
+    SYSTEM( (UTILS_PATH "mkdir -p " + SimulationContext::runPath("motion/position") + " && " UTILS_PATH "cp seedPositions.txt " + SimulationContext::runPath("motion/position")).c_str() );
 
 	while( !in.eof() )
 	{
@@ -1198,7 +1244,7 @@ void TSimulation::ReadSeedPositionsFromFile()
 				{
                     std::string ratiostr = raw.substr(1);
 					float ratio = atof( ratiostr.c_str() );
-					val = ratio * globals::worldsize;
+					val = ratio * globals::worldsize();
 				}
 				else
 				{
@@ -1289,7 +1335,7 @@ void TSimulation::MaintainEnergyCosts()
 	{
 		if( fPopControlGlobal )
 		{
-			long numAgents = objectxsortedlist::gXSortedObjects.getCount(AGENTTYPE);
+			long numAgents = objectxsortedlist::gXSortedObjects().getCount(AGENTTYPE);
 			fGlobalEnergyScaleFactor = EnergyScaleFactor( fMinNumAgents, fMaxNumAgents, numAgents );
 			//printf( "%ld: a=%ld gsf=%g\n", fStep, numAgents, fGlobalEnergyScaleFactor );
 		}
@@ -1315,7 +1361,7 @@ void TSimulation::MaintainEnergyCosts()
 	{
 		// These are the agent counts to be used in applying either the LowPopulationAdvantage or the (high) PopulationPenalty
 		// Assume global settings apply, until we know better
-		long numAgents = objectxsortedlist::gXSortedObjects.getCount(AGENTTYPE);
+		long numAgents = objectxsortedlist::gXSortedObjects().getCount(AGENTTYPE);
 		long initNumAgents = fInitNumAgents;
 		long minNumAgents = fMinNumAgents  +  lround( 0.1 * (fInitNumAgents - fMinNumAgents) );	// 10% buffer, to help prevent reaching actual min value and invoking GA
 		long maxNumAgents = fMaxNumAgents;
@@ -1385,21 +1431,27 @@ void TSimulation::UpdateAgents()
 	int pass = 0;
 #endif
 	agent* a;
-	objectxsortedlist::gXSortedObjects.reset();
-	while (objectxsortedlist::gXSortedObjects.nextObj(AGENTTYPE, (gobject**)&a))
+	objectxsortedlist::gXSortedObjects().reset();
+	while (objectxsortedlist::gXSortedObjects().nextObj(AGENTTYPE, (gobject**)&a))
 	{
 	#if DEBUGCHECK
 		debugcheck( "in agent loop at age %ld, pass = %d, agent = %lu", fStep, pass, a->Number() );
 		pass++;
 	#endif
 
-		a->UpdateVision();
+		{
+			Profiler::Scope scope( fProfiler, Profiler::Vision );
+			a->UpdateVision();
+		}
 		a->UpdateBrain();
 		if( !a->BeingCarried() )
+		{
+			Profiler::Scope scope( fProfiler, Profiler::Bodies );
 			fFoodEnergyOut += a->UpdateBody(fMoveFitnessParameter,
-											agent::config.speed2DPosition,
+											agent::config().speed2DPosition,
 											fSolidObjects,
 											NULL);
+		}
 	}
 }
 
@@ -1413,16 +1465,22 @@ void TSimulation::UpdateAgents_StaticTimestepGeometry()
     // !!! EXEC MASTER
     // !!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!
     fScheduler.execMasterTask([=]() {
-            fStage.Compile();
-            objectxsortedlist::gXSortedObjects.reset();
+            // The compiled stage is only drawn by agent vision, and headless
+            // builds have no GL context to compile it in.
+            if( agent::config().vision )
+                fStage.Compile();
+            objectxsortedlist::gXSortedObjects().reset();
 
             agent *a = NULL;
-            while (objectxsortedlist::gXSortedObjects.nextObj(AGENTTYPE, (gobject**)&a))
+            while (objectxsortedlist::gXSortedObjects().nextObj(AGENTTYPE, (gobject**)&a))
             {
                 // ---
                 // --- Update POV (3D rendering... expensive)
                 // ---
-                a->UpdateVision();
+                {
+                    Profiler::Scope scope( fProfiler, Profiler::Vision );
+                    a->UpdateVision();
+                }
 
                 fScheduler.postParallel([=]() {
                         // ---
@@ -1432,22 +1490,76 @@ void TSimulation::UpdateAgents_StaticTimestepGeometry()
                     });
             }
 
-            fStage.Decompile();
+            if( agent::config().vision )
+                fStage.Decompile();
         },
         !fParallelBrains);
 
 	// ---
 	// --- Body
 	// ---
+	if( fParallelBodies )
+	{
+		Profiler::Scope scope( fProfiler, Profiler::Bodies );
+
+		// Bodies collide against where everything was before any of them
+		// moved, and their effects on the rest of the world are applied in
+		// list order, so the outcome doesn't depend on scheduling.
+		fBodySnapshot.take( objectxsortedlist::gXSortedObjects(),
+							barrier::gXSortedBarriers(),
+							fSolidObjects );
+		fBodyUpdates.resize( objectxsortedlist::gXSortedObjects().getCount(AGENTTYPE) );
+
+		// !!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!
+		// !!! EXEC MASTER
+		// !!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!
+		fScheduler.execMasterTask( [=]() {
+				int nupdates = 0;
+				for( int i = 0; i < (int)fBodySnapshot.objects.size(); i++ )
+				{
+					if( fBodySnapshot.objects[i].type != AGENTTYPE )
+						continue;
+
+					agent *a = (agent *)fBodySnapshot.objects[i].obj;
+					if( a->BeingCarried() )
+						continue;
+
+					agent::ParallelBodyUpdate *update = &fBodyUpdates[nupdates++];
+					update->snapshot = &fBodySnapshot;
+					update->index = i;
+					update->deferred.clear();
+
+					fScheduler.postParallel( [=]() {
+							update->energyUsed = a->UpdateBody( fMoveFitnessParameter,
+																agent::config().speed2DPosition,
+																fSolidObjects,
+																NULL,
+																update );
+						});
+
+					// !!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!
+					// !!! POST SERIAL
+					// !!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!
+					fScheduler.postSerial( [=]() {
+							for( std::function<void()> &effect : update->deferred )
+								effect();
+							fFoodEnergyOut += update->energyUsed;
+						});
+				}
+			},
+			false );
+	}
+	else
 	{
+		Profiler::Scope scope( fProfiler, Profiler::Bodies );
 		agent *a;
 
-		objectxsortedlist::gXSortedObjects.reset();
-		while( objectxsortedlist::gXSortedObjects.nextObj( AGENTTYPE, (gobject**)&a) )
+		objectxsortedlist::gXSortedObjects().reset();
+		while( objectxsortedlist::gXSortedObjects().nextObj( AGENTTYPE, (gobject**)&a) )
 		{
 			if( !a->BeingCarried() )
 				fFoodEnergyOut += a->UpdateBody( fMoveFitnessParameter,
-												 agent::config.speed2DPosition,
+												 agent::config().speed2DPosition,
 												 fSolidObjects,
 												 NULL );
 		}
@@ -1471,24 +1583,24 @@ void TSimulation::Interact()
 	fEatStatistics.StepBegin();
 
 	// first x-sort all the objects
-	objectxsortedlist::gXSortedObjects.sort();
+	objectxsortedlist::gXSortedObjects().sort();
 
 #if DebugShowSort
 	if( fStep == 1 )
-		printf( "food::gMaxFoodRadius = %g\n", food::gMaxFoodRadius );
+		printf( "food::gMaxFoodRadius() = %g\n", food::gMaxFoodRadius() );
 	if( (fStep >= MinDebugStep) && (fStep <= MaxDebugStep) )
 	{
 		food* f;
-		objectxsortedlist::gXSortedObjects.reset();
+		objectxsortedlist::gXSortedObjects().reset();
 		printf( "********** agents at step %ld **********\n", fStep );
-		while( objectxsortedlist::gXSortedObjects.nextObj( AGENTTYPE, (gobject**) &c ) )
+		while( objectxsortedlist::gXSortedObjects().nextObj( AGENTTYPE, (gobject**) &c ) )
 		{
 			printf( "  # %ld edge=%g at (%g,%g) rad=%g\n", c->Number(), c->x() - c->radius(), c->x(), c->z(), c->radius() );
 			fflush( stdout );
 		}
-		objectxsortedlist::gXSortedObjects.reset();
+		objectxsortedlist::gXSortedObjects().reset();
 		printf( "********** food at step %ld **********\n", fStep );
-		while( objectxsortedlist::gXSortedObjects.nextObj( FOODTYPE, (gobject**) &f ) )
+		while( objectxsortedlist::gXSortedObjects().nextObj( FOODTYPE, (gobject**) &f ) )
 		{
 			printf( "  edge=%g at (%g,%g) rad=%g\n", f->x() - f->radius(), f->x(), f->z(), f->radius() );
 			fflush( stdout );
@@ -1532,11 +1644,11 @@ void TSimulation::Interact()
 #if DebugMaxFitness
 	if( (fStep >= MinDebugStep) && (fStep <= MaxDebugStep) )
 	{
-		objectxsortedlist::gXSortedObjects.reset();
-		objectxsortedlist::gXSortedObjects.nextObj(AGENTTYPE, c);
+		objectxsortedlist::gXSortedObjects().reset();
+		objectxsortedlist::gXSortedObjects().nextObj(AGENTTYPE, c);
 		agent* lastAgent;
-		objectxsortedlist::gXSortedObjects.lastObj(AGENTTYPE, (gobject**) &lastAgent );
-		printf( "%s: at age %ld about to process %ld agents, %ld pieces of food, starting with agent %08lx (%4ld), ending with agent %08lx (%4ld)\n", __FUNCTION__, fStep, objectxsortedlist::gXSortedObjects.getCount(AGENTTYPE), objectxsortedlist::gXSortedObjects.getCount(FOODTYPE), (unsigned long) c, c->Number(), (unsigned long) lastAgent, lastAgent->Number() );
+		objectxsortedlist::gXSortedObjects().lastObj(AGENTTYPE, (gobject**) &lastAgent );
+		printf( "%s: at age %ld about to process %ld agents, %ld pieces of food, starting with agent %08lx (%4ld), ending with agent %08lx (%4ld)\n", __FUNCTION__, fStep, objectxsortedlist::gXSortedObjects().getCount(AGENTTYPE), objectxsortedlist::gXSortedObjects().getCount(FOODTYPE), (unsigned long) c, c->Number(), (unsigned long) lastAgent, lastAgent->Number() );
 	}
 #endif
 
@@ -1545,8 +1657,8 @@ void TSimulation::Interact()
 	// -----------------------
 	if( fHealing )	// if healing is turned on...
 	{
-		objectxsortedlist::gXSortedObjects.reset();
-    	while( objectxsortedlist::gXSortedObjects.nextObj( AGENTTYPE, (gobject**) &c) )	// for every agent...
+		objectxsortedlist::gXSortedObjects().reset();
+    	while( objectxsortedlist::gXSortedObjects().nextObj( AGENTTYPE, (gobject**) &c) )	// for every agent...
 			c->Heal( fAgentHealingRate, 0.0 );										// heal it if FoodEnergy > 2ndParam.
 	}
 
@@ -1565,8 +1677,8 @@ void TSimulation::Interact()
 	// Now go through the list, and use the influence radius to determine
 	// all possible interactions
 
-	objectxsortedlist::gXSortedObjects.reset();
-    while( objectxsortedlist::gXSortedObjects.nextObj( AGENTTYPE, (gobject**) &c ) )
+	objectxsortedlist::gXSortedObjects().reset();
+    while( objectxsortedlist::gXSortedObjects().nextObj( AGENTTYPE, (gobject**) &c ) )
     {
 		// Check for new agent.  If totally new (never updated), skip this agent.
 		// This is because newly born agents get added directly to the main list,
@@ -1575,11 +1687,11 @@ void TSimulation::Interact()
 		if( c->Age() <= 0 )
 			continue;
 
-		objectxsortedlist::gXSortedObjects.setMark( AGENTTYPE ); // so can point back to this agent later
+		objectxsortedlist::gXSortedObjects().setMark( AGENTTYPE ); // so can point back to this agent later
         cDied = false;
 
 		// See if there's an overlap with any other agents
-        while( objectxsortedlist::gXSortedObjects.nextObj( AGENTTYPE, (gobject**) &d ) ) // to end of list or...
+        while( objectxsortedlist::gXSortedObjects().nextObj( AGENTTYPE, (gobject**) &d ) ) // to end of list or...
         {
 			if( d == c )	// sanity check; shouldn't happen
 			{
@@ -1606,7 +1718,7 @@ void TSimulation::Interact()
 
 				AgentContactBeginEvent contactEvent( c, d );
 
-				logs->postEvent( contactEvent );
+				fContext.logs->postEvent( contactEvent );
 
 				// -----------------------
 				// ---- Mate (Normal) ----
@@ -1625,7 +1737,7 @@ void TSimulation::Interact()
 				// -----------------------
 				// -------- Give ---------
 				// -----------------------
-				if( agent::config.enableGive )
+				if( agent::config().enableGive )
 				{
 					if( !cDied && !dDied )
 					{
@@ -1637,13 +1749,13 @@ void TSimulation::Interact()
 					}
 				}
 
-				logs->postEvent( AgentContactEndEvent(contactEvent) );
+				fContext.logs->postEvent( AgentContactEndEvent(contactEvent) );
 
 				if( cDied )
 					break;
 
             }  // if close enough
-        }  // while (agent::config.xSortedAgents.next(d))
+        }  // while (agent::config().xSortedAgents.next(d))
 
         debugcheck( "after all agent interactions" );
 
@@ -1666,7 +1778,7 @@ void TSimulation::Interact()
 		// -----------------------
 		// Have to do carry testing here instead of inside inner loop above,
 		// because agents can carry any kind of object, not just other agents
-		if( agent::config.enableCarry )
+		if( agent::config().enableCarry )
 			Carry( c );
 
 		// -----------------------
@@ -1722,17 +1834,17 @@ void TSimulation::DeathAndStats( void )
 			for( int count = 0; count < fLockstepNumDeathsAtTimestep; count++ )
 			{
 				int i = 0;
-				int numagents = objectxsortedlist::gXSortedObjects.getCount( AGENTTYPE );
+				int numagents = objectxsortedlist::gXSortedObjects().getCount( AGENTTYPE );
 				agent* testAgent;
 				agent* randAgent = NULL;
 	//				int randomIndex = int( floor( randpw() * fDomains[kd].numagents ) );	// pick from this domain
 				int randomIndex = int( floor( randpw() * numagents ) );
-				gdlink<gobject*> *saveCurr = objectxsortedlist::gXSortedObjects.getcurr();	// save the state of the x-sorted list
+				gdlink<gobject*> *saveCurr = objectxsortedlist::gXSortedObjects().getcurr();	// save the state of the x-sorted list
 
 				// As written, randAgent may not actually be the randomIndex-th agent in the domain, but it will be close,
 				// and as long as there's a single legitimate agent for killing, we will find and kill it
-				objectxsortedlist::gXSortedObjects.reset();
-				while( objectxsortedlist::gXSortedObjects.nextObj( AGENTTYPE, (gobject**) &testAgent ) )
+				objectxsortedlist::gXSortedObjects().reset();
+				while( objectxsortedlist::gXSortedObjects().nextObj( AGENTTYPE, (gobject**) &testAgent ) )
 				{
 					// no qualifications for this agent.  It doesn't even need to be old enough to smite.
 					randAgent = testAgent;	// as long as there's a single legitimate agent for killing, randAgent will be non-NULL
@@ -1743,7 +1855,7 @@ void TSimulation::DeathAndStats( void )
 						break;
 				}
 
-				objectxsortedlist::gXSortedObjects.setcurr( saveCurr );	// restore the state of the x-sorted list  V???
+				objectxsortedlist::gXSortedObjects().setcurr( saveCurr );	// restore the state of the x-sorted list  V???
 
 				assert( randAgent != NULL );		// In we're in LOCKSTEP mode, we should *always* have a agent to kill.  If we don't kill a agent, then we are no longer in sync in the LOCKSTEP-BirthsDeaths.log
 
@@ -1754,48 +1866,13 @@ void TSimulation::DeathAndStats( void )
 		}	// end of if( fLockstepTimestep == fStep )
 	}
 
-	switch( Brain::config.architecture )
-	{
-	case Brain::Configuration::Groups:
-		fCurrentBrainStats.groups.groupCount.reset();
-		break;
-	case Brain::Configuration::Sheets:
-		fCurrentBrainStats.sheets.internalSheetCount.reset();
-		fCurrentBrainStats.sheets.internalNeuronCount.reset();
-		for( SheetSynapseType &type : SheetSynapseTypes )
-			fCurrentBrainStats.sheets.synapseCount[ type.from ][ type.to ].reset();
-		break;
-	default:
-		assert( false );
-	}
-	fCurrentBrainStats.neuronCount.reset();
-	fCurrentBrainStats.synapseCount.reset();
-	objectxsortedlist::gXSortedObjects.reset();
-    while( objectxsortedlist::gXSortedObjects.nextObj( AGENTTYPE, (gobject**) &c ) )
-    {
-		switch( Brain::config.architecture )
-		{
-		case Brain::Configuration::Groups:
-			{
-				GroupsBrain *brain = dynamic_cast<GroupsBrain *>( c->GetBrain() );
-				fCurrentBrainStats.groups.groupCount.add( brain->NumNeuronGroups() );
-			}
-			break;
-		case Brain::Configuration::Sheets:
-			{
-				SheetsBrain *brain = dynamic_cast<SheetsBrain *>( c->GetBrain() );
-				fCurrentBrainStats.sheets.internalSheetCount.add( brain->getNumInternalSheets() );
-				fCurrentBrainStats.sheets.internalNeuronCount.add( brain->getNumInternalNeurons() );
-				for( SheetSynapseType &type : SheetSynapseTypes )
-					fCurrentBrainStats.sheets.synapseCount[type.from][type.to].add( brain->getNumSynapses(type.from, type.to) );
-			}
-			break;
-		default:
-			assert( false );
-		}
-		fCurrentBrainStats.neuronCount.add( c->GetBrain()->getNumNeurons() );
-		fCurrentBrainStats.synapseCount.add( c->GetBrain()->getNumSynapses() );
+	// Count the brains of everyone born since the last step; deaths below
+	// take themselves out.
+	fCurrentBrainStats.update();
 
+	objectxsortedlist::gXSortedObjects().reset();
+    while( objectxsortedlist::gXSortedObjects().nextObj( AGENTTYPE, (gobject**) &c ) )
+    {
         id = c->Domain();						// Determine the domain in which the agent currently is located
 
 		if( ! fLockStepWithBirthsDeathsLog )
@@ -1805,7 +1882,7 @@ void TSimulation::DeathAndStats( void )
 			// to prevent the population getting too low, or there are enough agents
 			// that we can still afford to lose one (globally & in agent's domain)...
 			if( (!fApplyLowPopulationAdvantage && !fEnergyBasedPopulationControl) ||
-				((objectxsortedlist::gXSortedObjects.getCount( AGENTTYPE ) > fMinNumAgents)
+				((objectxsortedlist::gXSortedObjects().getCount( AGENTTYPE ) > fMinNumAgents)
 				 && (fNumberAliveWithMetabolism[c->GetMetabolism()->index] > fMinNumAgentsWithMetabolism[c->GetMetabolism()->index])
 				 && (fDomains[c->Domain()].numAgents > fDomains[c->Domain()].minNumAgents)) ||
 				(fAllowMinDeaths && (randpw() > float(fNumberBorn)/float(fNumberCreated + fNumberBorn))) )
@@ -1813,9 +1890,9 @@ void TSimulation::DeathAndStats( void )
 			{
 				if ( c->GetEnergy().isDepleted() ||
 					 ( c->Age() >= c->MaxAge() ) ||
-					 ( !globals::blockedEdges && !globals::wraparound &&
-					 	(c->x() < 0.0 || c->x() >  globals::worldsize ||
-						 c->z() > 0.0 || c->z() < -globals::worldsize) ) ||
+					 ( !globals::blockedEdges() && !globals::wraparound() &&
+					 	(c->x() < 0.0 || c->x() >  globals::worldsize() ||
+						 c->z() > 0.0 || c->z() < -globals::worldsize()) ) ||
 					 c->GetDeathByPatch() )
 				{
 					LifeSpan::DeathReason reason = LifeSpan::DR_NATURAL;
@@ -1853,14 +1930,7 @@ void TSimulation::DeathAndStats( void )
 			// Count agents inside FoodPatches
 			// Also: Count agents outside FoodPatches, but within fFoodPatchOuterRange
 			for (int domainNumber = 0; domainNumber < fNumDomains; domainNumber++){
-				for( int foodPatchNumber = 0; foodPatchNumber < fDomains[domainNumber].numFoodPatches; foodPatchNumber++ )
-				{
-					// if agent is inside, then update FoodPatch's agentInsideCount
-					fDomains[domainNumber].fFoodPatches[foodPatchNumber].checkIfAgentIsInside(c->x(), c->z());
-
-					// if agent is inside the outerrange, then update FoodPatch's agentOuterRangeCount
-					fDomains[domainNumber].fFoodPatches[foodPatchNumber].checkIfAgentIsInsideNeighborhood(c->x(), c->z());
-				}
+				fDomains[domainNumber].foodPatchIndex.countAgent(c->x(), c->z());
 			}
 		}
 
@@ -1944,7 +2014,7 @@ void TSimulation::MateLockstep( void )
 
 		int i = 0;
 
-		int numAgents = objectxsortedlist::gXSortedObjects.getCount(AGENTTYPE);
+		int numAgents = objectxsortedlist::gXSortedObjects().getCount(AGENTTYPE);
 		assert( numAgents < fMaxNumAgents );			// Since we've already done all the deaths that occurred at this timestep, we should always have enough room to process the births that happened at this timestep.
 
 		agent* testAgent = NULL;
@@ -1954,8 +2024,8 @@ void TSimulation::MateLockstep( void )
 		// As written, randAgent may not actually be the randomIndex-th agent in the domain, but it will be close,
 		// and as long as there's a single legitimate agent for mating (right domain, long enough since last mating,
 		// and long enough since birth) we will find and use it
-		objectxsortedlist::gXSortedObjects.reset();
-		while( objectxsortedlist::gXSortedObjects.nextObj( AGENTTYPE, (gobject**) &testAgent ) )
+		objectxsortedlist::gXSortedObjects().reset();
+		while( objectxsortedlist::gXSortedObjects().nextObj( AGENTTYPE, (gobject**) &testAgent ) )
 		{
 			// Make sure it wasn't just birthed
 			if( testAgent->Age() > 0 )
@@ -1975,8 +2045,8 @@ void TSimulation::MateLockstep( void )
 		// As written, randAgent may not actually be the randomIndex-th agent in the domain, but it will be close,
 		// and as long as there's a single legitimate agent for mating (right domain, long enough since last mating, and
 		// has enough energy, plus not the same as the mommy), we will find and use it
-		objectxsortedlist::gXSortedObjects.reset();
-		while( objectxsortedlist::gXSortedObjects.nextObj( AGENTTYPE, (gobject**) &testAgent ) )
+		objectxsortedlist::gXSortedObjects().reset();
+		while( objectxsortedlist::gXSortedObjects().nextObj( AGENTTYPE, (gobject**) &testAgent ) )
 		{
 			// If it was not just birthed and it's not the same as mommy, it'll do for daddy.
 			if( (testAgent->Age() > 0) && (testAgent->Number() != c->Number()) )
@@ -2017,16 +2087,16 @@ void TSimulation::MateLockstep( void )
 		eenergy.constrain( minenergy, e->GetMaxEnergy() );
 		e->SetEnergy(eenergy);
 		e->SetFoodEnergy(eenergy);
-		float x =  0.01 + randpw() * (globals::worldsize - 0.02);
-		float z = -0.01 - randpw() * (globals::worldsize - 0.02);
-		float y = 0.5 * agent::config.agentHeight;
+		float x =  0.01 + randpw() * (globals::worldsize() - 0.02);
+		float z = -0.01 - randpw() * (globals::worldsize() - 0.02);
+		float y = 0.5 * agent::config().agentHeight;
 		e->settranslation(x, y, z);
 		float yaw =  360.0 * randpw();
 		c->setyaw(yaw);
 		short kd = WhichDomain(x, z, 0);
 		e->Domain(kd);
 		fStage.AddObject(e);
-		objectxsortedlist::gXSortedObjects.add(e); // Add the new agent directly to the list of objects (no new agent list); the e->listLink that gets auto stored here should be valid immediately
+		objectxsortedlist::gXSortedObjects().add(e); // Add the new agent directly to the list of objects (no new agent list); the e->listLink that gets auto stored here should be valid immediately
 
 		fNewLifes++;
 		fDomains[kd].numAgents++;
@@ -2238,14 +2308,14 @@ void TSimulation::Mate( agent *c,
 				float yaw = AverageAngles( c->yaw(), d->yaw() );
 				if( fRandomBirthLocation )
 				{
-					float distance = globals::worldsize * fRandomBirthLocationRadius * randpw();
+					float distance = globals::worldsize() * fRandomBirthLocationRadius * randpw();
 					float angle = 2*M_PI * randpw();
 
 					x += distance * cosf( angle );
 					z -= distance * sinf( angle );
 
-                    x = pwclamp( x, 0.01, globals::worldsize - 0.01 );
-                    z = pwclamp( z, -globals::worldsize + 0.01, -0.01 );
+                    x = pwclamp( x, 0.01, globals::worldsize() - 0.01 );
+                    z = pwclamp( z, -globals::worldsize() + 0.01, -0.01 );
 				}
 
 				e->settranslation( x, y, z );
@@ -2281,9 +2351,9 @@ void TSimulation::Mate( agent *c,
 				// !!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!
                 fScheduler.postSerial( [=]() {
                         fStage.AddObject(e);
-                        gdlink<gobject*> *saveCurr = objectxsortedlist::gXSortedObjects.getcurr();
-                        objectxsortedlist::gXSortedObjects.add(e); // Add the new agent directly to the list of objects (no new agent list); the e->listLink that gets auto stored here should be valid immediately
-                        objectxsortedlist::gXSortedObjects.setcurr( saveCurr );
+                        gdlink<gobject*> *saveCurr = objectxsortedlist::gXSortedObjects().getcurr();
+                        objectxsortedlist::gXSortedObjects().add(e); // Add the new agent directly to the list of objects (no new agent list); the e->listLink that gets auto stored here should be valid immediately
+                        objectxsortedlist::gXSortedObjects().setcurr( saveCurr );
                     });
 			}
 		}	// steady-state GA vs. natural selection
@@ -2336,13 +2406,13 @@ void TSimulation::Smite( short kd,
 			agent* randAgent = NULL;
 			int randomIndex = int( floor( randpw() * fDomains[kd].numAgents ) );	// pick from this domain
 
-			gdlink<gobject*> *saveCurr = objectxsortedlist::gXSortedObjects.getcurr();	// save the state of the x-sorted list
+			gdlink<gobject*> *saveCurr = objectxsortedlist::gXSortedObjects().getcurr();	// save the state of the x-sorted list
 
 			// As written, randAgent may not actually be the randomIndex-th agent in the domain, but it will be close,
 			// and as long as there's a single legitimate agent for smiting (right domain, old enough, and not one of the
 			// parents), we will find and smite it
-			objectxsortedlist::gXSortedObjects.reset();
-			while( (i <= randomIndex) && objectxsortedlist::gXSortedObjects.nextObj( AGENTTYPE, (gobject**) &testAgent ) )
+			objectxsortedlist::gXSortedObjects().reset();
+			while( (i <= randomIndex) && objectxsortedlist::gXSortedObjects().nextObj( AGENTTYPE, (gobject**) &testAgent ) )
 			{
 				// If it's from the right domain, it's old enough, and it's not one of the parents, allow it
 				if( testAgent->Domain() == kd )
@@ -2357,7 +2427,7 @@ void TSimulation::Smite( short kd,
 					break;
 			}
 
-			objectxsortedlist::gXSortedObjects.setcurr( saveCurr );	// restore the state of the x-sorted list
+			objectxsortedlist::gXSortedObjects().setcurr( saveCurr );	// restore the state of the x-sorted list
 
 			if( randAgent )	// if we found any legitimately smitable agent...
 			{
@@ -2442,14 +2512,14 @@ void TSimulation::Fight( agent *c,
 		{
 			Energy ddamage = d->damage( cpower * fPower2Energy, fFightMode == FM_NULL );
 			if( !ddamage.isZero() )
-				logs->postEvent( EnergyEvent(c, d, c->Fight(), ddamage, EnergyEvent::Fight) );
+				fContext.logs->postEvent( EnergyEvent(c, d, c->Fight(), ddamage, EnergyEvent::Fight) );
 		}
 
 		if( dpower > 0.0 )
 		{
 			Energy cdamage = c->damage( dpower * fPower2Energy, fFightMode == FM_NULL );
 			if( !cdamage.isZero() )
-				logs->postEvent( EnergyEvent(d, c, d->Fight(), cdamage, EnergyEvent::Fight) );
+				fContext.logs->postEvent( EnergyEvent(d, c, d->Fight(), cdamage, EnergyEvent::Fight) );
 		}
 
 		if( !fLockStepWithBirthsDeathsLog )
@@ -2457,22 +2527,22 @@ void TSimulation::Fight( agent *c,
 			// If we're not running in LockStep mode, allow natural deaths
 			if (d->GetEnergy().isDepleted())
 			{
-				//cout << "before deaths2 "; agent::config.xSortedAgents.list();	//dbg
+				//cout << "before deaths2 "; agent::config().xSortedAgents.list();	//dbg
 				Kill( d, LifeSpan::DR_FIGHT );
 				fNumberDiedFight++;
-				//cout << "after deaths2 "; agent::config.xSortedAgents.list();	//dbg
+				//cout << "after deaths2 "; agent::config().xSortedAgents.list();	//dbg
 
 				*dDied = true;
 			}
 			if (c->GetEnergy().isDepleted())
 			{
-				objectxsortedlist::gXSortedObjects.toMark( AGENTTYPE ); // point back to c
+				objectxsortedlist::gXSortedObjects().toMark( AGENTTYPE ); // point back to c
 				Kill( c, LifeSpan::DR_FIGHT );
 				fNumberDiedFight++;
 
 				// note: this leaves list pointing to item before c, and markedAgent set to previous agent
-				//objectxsortedlist::gXSortedObjects.setMarkPrevious( AGENTTYPE );	// if previous object was a agent, this would step one too far back, I think - lsy
-				//cout << "after deaths3 "; agent::config.xSortedAgents.list();	//dbg
+				//objectxsortedlist::gXSortedObjects().setMarkPrevious( AGENTTYPE );	// if previous object was a agent, this would step one too far back, I think - lsy
+				//cout << "after deaths3 "; agent::config().xSortedAgents.list();	//dbg
 				*cDied = true;
 			}
 		}
@@ -2541,14 +2611,14 @@ void TSimulation::Give( agent *x,
 	{
 		y->receive( x, energy );
 
-		logs->postEvent( EnergyEvent(x, y, x->Give(), energy, EnergyEvent::Give) );
+		fContext.logs->postEvent( EnergyEvent(x, y, x->Give(), energy, EnergyEvent::Give) );
 
 		if( !fLockStepWithBirthsDeathsLog )
 		{
 			if (x->GetEnergy().isDepleted())
 			{
 				if( toMarkOnDeath )
-					objectxsortedlist::gXSortedObjects.toMark( AGENTTYPE ); // point back to x
+					objectxsortedlist::gXSortedObjects().toMark( AGENTTYPE ); // point back to x
 				Kill( x, LifeSpan::DR_NATURAL );
 #if GIVE_TODO
 				fNumberDiedGive++;
@@ -2580,7 +2650,7 @@ void TSimulation::Eat( agent *c, bool *cDied )
 	// Just to be slightly more like the old multi-x-sorted list version of the code, look backwards first
 
 	// set the list back to the agent mark, so we can look backward from that point
-	objectxsortedlist::gXSortedObjects.toMark( AGENTTYPE ); // point list back to c
+	objectxsortedlist::gXSortedObjects().toMark( AGENTTYPE ); // point list back to c
 
 	if( IS_PREVENTED_BY_CARRY(Eat, c) )
 	{
@@ -2618,18 +2688,18 @@ void TSimulation::Eat( agent *c, bool *cDied )
 	// would entirely precede our agent, and no smaller piece of food sorting after it, but failing
 	// to reach the agent can prematurely terminate the scan back (hence the factor of 2.0),
 	// so we can then search forward from there
-	while( objectxsortedlist::gXSortedObjects.prevObj( FOODTYPE, (gobject**) &f ) )
-		if( (f->x() + 2.0*food::gMaxFoodRadius) < (c->x() - c->radius()) )
+	while( objectxsortedlist::gXSortedObjects().prevObj( FOODTYPE, (gobject**) &f ) )
+		if( (f->x() + 2.0*food::gMaxFoodRadius()) < (c->x() - c->radius()) )
 			break;
 #else // CompatibilityMode
-	while( objectxsortedlist::gXSortedObjects.prevObj( FOODTYPE, (gobject**) &f ) )
+	while( objectxsortedlist::gXSortedObjects().prevObj( FOODTYPE, (gobject**) &f ) )
 	{
 		if( (f->x() + f->radius()) < (c->x() - c->radius()) )
 		{
 			// end of food comes before beginning of agent, so there is no overlap
 			// if we've gone so far back that the largest possible piece of food could not overlap us,
 			// then we can stop searching for this agent's possible foods in the backward direction
-			if( (f->x() + 2.0*food::gMaxFoodRadius) < (c->x() - c->radius()) )
+			if( (f->x() + 2.0*food::gMaxFoodRadius()) < (c->x() - c->radius()) )
 				break;  // so get out of the backward food while loop
 		}
 		else
@@ -2647,7 +2717,7 @@ void TSimulation::Eat( agent *c, bool *cDied )
 				Energy energyEatenRaw;
 				Energy energyEaten;
 				c->eat( f, fEatFitnessParameter, fEat2Consume, fEatThreshold, fStep, foodEnergyLost, energyEatenRaw, energyEaten );
-				logs->postEvent( EnergyEvent(c, f, c->Eat(), energyEaten, energyEatenRaw, EnergyEvent::Eat) );
+				fContext.logs->postEvent( EnergyEvent(c, f, c->Eat(), energyEaten, energyEatenRaw, EnergyEvent::Eat) );
 				if( fEvents )
 					fEvents->AddEvent( fStep, c->Number(), 'e' );
 
@@ -2673,11 +2743,11 @@ void TSimulation::Eat( agent *c, bool *cDied )
 	{
 	#if ! CompatibilityMode
 		// set the list back to the agent mark, so we can look forward from that point
-		objectxsortedlist::gXSortedObjects.toMark( AGENTTYPE ); // point list back to c
+		objectxsortedlist::gXSortedObjects().toMark( AGENTTYPE ); // point list back to c
 	#endif
 
 		// look for food in the +x direction
-		while( objectxsortedlist::gXSortedObjects.nextObj( FOODTYPE, (gobject**) &f ) )
+		while( objectxsortedlist::gXSortedObjects().nextObj( FOODTYPE, (gobject**) &f ) )
 		{
 			if( (f->x() - f->radius()) > (c->x() + c->radius()) )
 			{
@@ -2705,7 +2775,7 @@ void TSimulation::Eat( agent *c, bool *cDied )
 					Energy energyEatenRaw;
 					Energy energyEaten;
 					c->eat( f, fEatFitnessParameter, fEat2Consume, fEatThreshold, fStep, foodEnergyLost, energyEatenRaw, energyEaten );
-					logs->postEvent( EnergyEvent(c, f, c->Eat(), energyEaten, energyEatenRaw, EnergyEvent::Eat) );
+					fContext.logs->postEvent( EnergyEvent(c, f, c->Eat(), energyEaten, energyEatenRaw, EnergyEvent::Eat) );
 					if( fEvents )
 						fEvents->AddEvent( fStep, c->Number(), 'e' );
 
@@ -2731,12 +2801,12 @@ void TSimulation::Eat( agent *c, bool *cDied )
 		fEatStatistics.AgentEatAttempt( eatAllowed, eatFailedYaw, eatFailedVel, eatFailedMinAge );
 	}
 
-	objectxsortedlist::gXSortedObjects.toMark( AGENTTYPE ); // point list back to c
+	objectxsortedlist::gXSortedObjects().toMark( AGENTTYPE ); // point list back to c
 	if( !fLockStepWithBirthsDeathsLog )
 	{
 		// If we're not running in LockStep mode, allow natural deaths
 		if( c->GetEnergy().isDepleted() ||
-			((c->IsSeed() || c->Age() >= agent::config.starvationWait) && c->GetFoodEnergy().isDepleted( c->GetStarvationFoodEnergy() )) )
+			((c->IsSeed() || c->Age() >= agent::config().starvationWait) && c->GetFoodEnergy().isDepleted( c->GetStarvationFoodEnergy() )) )
 		{
 			// note: this leaves list pointing to item before c, and markedAgent set to previous agent
 			Kill( c, LifeSpan::DR_EAT );
@@ -2758,7 +2828,7 @@ void TSimulation::Carry( agent* c )
 	if( c->Pickup() > fPickupThreshold )
 	{
 		// Don't pick up more than we can carry
-		if( c->NumCarries() < agent::config.maxCarries )
+		if( c->NumCarries() < agent::config().maxCarries )
 		{
 			Pickup( c );
 		}
@@ -2783,10 +2853,10 @@ void TSimulation::Pickup( agent* c )
 	gobject* o;
 
 	// set the list back to the agent mark, so we can look backward from that point
-	objectxsortedlist::gXSortedObjects.toMark( AGENTTYPE ); // point list back to c
+	objectxsortedlist::gXSortedObjects().toMark( AGENTTYPE ); // point list back to c
 
 	// look in the -x direction for something to carry
-	while( objectxsortedlist::gXSortedObjects.prevObj( fCarryObjects, (gobject**) &o ) )
+	while( objectxsortedlist::gXSortedObjects().prevObj( fCarryObjects, (gobject**) &o ) )
 	{
 		if( o->BeingCarried() || (o->NumCarries() > 0) )
 			continue;	// already carrying or being carried, so nothing we can do with it
@@ -2796,7 +2866,7 @@ void TSimulation::Pickup( agent* c )
 			// end of object comes before beginning of agent, so there is no overlap
 			// if we've gone so far back that the largest possible object could not overlap us,
 			// then we can stop searching for this agent's possible pickups in the backward direction
-            if( ( o->x() + 2.0 * std::max( std::max( food::gMaxFoodRadius, agent::config.maxRadius ), brick::gBrickRadius ) ) < ( c->x() - c->radius() ) )
+            if( ( o->x() + 2.0 * std::max( std::max( food::gMaxFoodRadius(), agent::config().maxRadius ), brick::gBrickRadius() ) ) < ( c->x() - c->radius() ) )
 				break;  // so get out of the backward object while loop
 		}
 		else
@@ -2810,20 +2880,20 @@ void TSimulation::Pickup( agent* c )
 
 				c->PickupObject( o );
 
-				if( c->NumCarries() >= agent::config.maxCarries )	// carrying as much as we can,
+				if( c->NumCarries() >= agent::config().maxCarries )	// carrying as much as we can,
 					break;								// so get out of the backward while loop
 			}
 		}
 	}
 
 	// can we pick up anything else?
-	if( c->NumCarries() < agent::config.maxCarries )
+	if( c->NumCarries() < agent::config().maxCarries )
 	{
 		// set the list back to the agent mark, so we can look forward from that point
-		objectxsortedlist::gXSortedObjects.toMark( AGENTTYPE ); // point list back to c
+		objectxsortedlist::gXSortedObjects().toMark( AGENTTYPE ); // point list back to c
 
 		// look in the +x direction for something to pick up
-		while( objectxsortedlist::gXSortedObjects.nextObj( fCarryObjects, (gobject**) &o ) )
+		while( objectxsortedlist::gXSortedObjects().nextObj( fCarryObjects, (gobject**) &o ) )
 		{
 			if( o->BeingCarried() || (o->NumCarries() > 0) )
 				continue;	// already carrying or being carried, so nothing we can do with it
@@ -2845,14 +2915,14 @@ void TSimulation::Pickup( agent* c )
 
 					c->PickupObject( o );
 
-					if( c->NumCarries() >= agent::config.maxCarries )	// carrying as much as we can,
+					if( c->NumCarries() >= agent::config().maxCarries )	// carrying as much as we can,
 						break;								// so get out of the forward while loop
 				}
 			}
 		}
 	}
 
-	objectxsortedlist::gXSortedObjects.toMark( AGENTTYPE ); // point list back to c
+	objectxsortedlist::gXSortedObjects().toMark( AGENTTYPE ); // point list back to c
 
 	debugcheck( "after all agents had a chance to pickup objects" );
 }
@@ -2922,7 +2992,7 @@ void TSimulation::Fitness( agent *c )
 //---------------------------------------------------------------------------
 void TSimulation::CreateAgents( void )
 {
-	long maxToCreate = fMaxNumAgents - (long)(objectxsortedlist::gXSortedObjects.getCount(AGENTTYPE));
+	long maxToCreate = fMaxNumAgents - (long)(objectxsortedlist::gXSortedObjects().getCount(AGENTTYPE));
     if (maxToCreate > 0)
     {
         // provided there are less than the maximum number of agents already
@@ -3039,11 +3109,11 @@ void TSimulation::CreateAgents( void )
 
 				float x = randpw() * (fDomains[id].absoluteSizeX - 0.02) + fDomains[id].startX + 0.01;
 				float z = randpw() * (fDomains[id].absoluteSizeZ - 0.02) + fDomains[id].startZ + 0.01;
-				float y = 0.5 * agent::config.agentHeight;
+				float y = 0.5 * agent::config().agentHeight;
 				float yaw = randpw() * 360.0;
 			#if TestWorld
 				x = fDomains[id].xleft  +  0.666 * fDomains[id].xsize;
-				z = - globals::worldsize * ((float) (i+1) / (fDomains[id].initNumAgents + 1));
+				z = - globals::worldsize() * ((float) (i+1) / (fDomains[id].initNumAgents + 1));
 				yaw = 95.0;
 			#endif
                 newAgent->settranslation( x, y, z );
@@ -3051,7 +3121,7 @@ void TSimulation::CreateAgents( void )
                 newAgent->Domain(id);
                 fStage.AddObject(newAgent);
                 fDomains[id].numAgents++;
-				objectxsortedlist::gXSortedObjects.add(newAgent);
+				objectxsortedlist::gXSortedObjects().add(newAgent);
 				fNewLifes++;
 
 
@@ -3070,12 +3140,12 @@ void TSimulation::CreateAgents( void )
 
 		// then deal with global creation if necessary
 
-        while (((long)(objectxsortedlist::gXSortedObjects.getCount(AGENTTYPE))) < fMinNumAgents)
+        while (((long)(objectxsortedlist::gXSortedObjects().getCount(AGENTTYPE))) < fMinNumAgents)
         {
             fNumberCreated++;
-            numglobalcreated++;
+            fNumGlobalCreated++;
 
-            if ((numglobalcreated == 1) && (fNumDomains > 1))
+            if ((fNumGlobalCreated == 1) && (fNumDomains > 1))
                 errorflash(0, "Possible global influence on domains due to minNumAgents");
 
             fNumBornSinceCreated = 0;
@@ -3086,14 +3156,14 @@ void TSimulation::CreateAgents( void )
             if( fFittest && fFittest->isFull() )
             {
                 if( fFitness1Frequency
-                	&& ((numglobalcreated / fFitness1Frequency) * fFitness1Frequency == numglobalcreated) )
+                	&& ((fNumGlobalCreated / fFitness1Frequency) * fFitness1Frequency == fNumGlobalCreated) )
                 {
                     // revive 1 fittest
                     newAgent->Genes()->copyFrom( fFittest->get(0)->genes );
                     fNumberCreated1Fit++;
 					gaPrint( "%5ld: global creation from one fittest (%4lu) %4ld\n", fStep, fFittest->get(0)->agentID, fNumberCreated1Fit );
                 }
-                else if( fFitness2Frequency && ((numglobalcreated / fFitness2Frequency) * fFitness2Frequency == numglobalcreated) )
+                else if( fFitness2Frequency && ((fNumGlobalCreated / fFitness2Frequency) * fFitness2Frequency == fNumGlobalCreated) )
                 {
                     // mate 2 from array of fittest
 					if( fTournamentSize > 0 )
@@ -3135,7 +3205,7 @@ void TSimulation::CreateAgents( void )
             newAgent->grow( fMateWait );
 			FoodEnergyIn( newAgent->GetFoodEnergy() );
 
-            newAgent->settranslation(randpw() * globals::worldsize, 0.5 * agent::config.agentHeight, randpw() * -globals::worldsize);
+            newAgent->settranslation(randpw() * globals::worldsize(), 0.5 * agent::config().agentHeight, randpw() * -globals::worldsize());
             newAgent->setyaw(randpw() * 360.0);
             id = WhichDomain(newAgent->x(), newAgent->z(), 0);
             newAgent->Domain(id);
@@ -3143,7 +3213,7 @@ void TSimulation::CreateAgents( void )
             fDomains[id].lastcreate = fStep;
             fDomains[id].numAgents++;
             fStage.AddObject(newAgent);
-	    	objectxsortedlist::gXSortedObjects.add(newAgent); // add new agent to list of all objejcts; the newAgent->listLink that gets auto stored here should be valid immediately
+	    	objectxsortedlist::gXSortedObjects().add(newAgent); // add new agent to list of all objejcts; the newAgent->listLink that gets auto stored here should be valid immediately
 	    	fNewLifes++;
             //newAgents.add(newAgent); // add it to the full list later; the e->listLink that gets auto stored here must be replaced with one from full list below
 
@@ -3177,30 +3247,30 @@ void TSimulation::MaintainBricks()
 void TSimulation::MaintainFood()
 {
 	// Remove any food that has exceeded its lifespan
-	if( food::gMaxLifeSpan > 0 )
+	if( food::gMaxLifeSpan() > 0 )
 	{
-		while( !food::gAllFood.empty() )
+		while( !food::gAllFood().empty() )
 		{
-			// gAllFood is ordered by creation, so when we've encountered
+			// gAllFood() is ordered by creation, so when we've encountered
 			// a piece that is too young to be removed, we can stop looking.
 			// Removing food takes it out of the "all food" list, so we can
 			// look at the head of the list on each iteration.
-			food *f = food::gAllFood.front();
-			if( (f == NULL) || (f->getAge(fStep) < food::gMaxLifeSpan) )
+			food *f = food::gAllFood().front();
+			if( (f == NULL) || (f->getAge(fStep) < food::gMaxLifeSpan()) )
 			{
 				break;
 			}
 
-			objectxsortedlist::gXSortedObjects.setcurr( f->GetListLink() );
+			objectxsortedlist::gXSortedObjects().setcurr( f->GetListLink() );
 			RemoveFood( f );
 		}
 
-		objectxsortedlist::gXSortedObjects.reset();
+		objectxsortedlist::gXSortedObjects().reset();
 	}
 
 	// Go through each of the food patches and bring them up to minFoodCount size
 	// and create a new piece based on the foodRate probability
-	if( (long)objectxsortedlist::gXSortedObjects.getCount(FOODTYPE) < fMaxFoodCount )
+	if( (long)objectxsortedlist::gXSortedObjects().getCount(FOODTYPE) < fMaxFoodCount )
 	{
 		for( int domainNumber = 0; domainNumber < fNumDomains; domainNumber++ )
 		{
@@ -3336,8 +3406,8 @@ void TSimulation::MaintainFood()
 			food* f;
 
 			// There are patches currently needing removal, so do it
-			objectxsortedlist::gXSortedObjects.reset();
-			while( objectxsortedlist::gXSortedObjects.nextObj( FOODTYPE, (gobject**) &f ) )
+			objectxsortedlist::gXSortedObjects().reset();
+			while( objectxsortedlist::gXSortedObjects().nextObj( FOODTYPE, (gobject**) &f ) )
 			{
 				for( int i = 0; i < numPatchesNeedingRemoval; i++ )
 				{
@@ -3400,7 +3470,7 @@ void TSimulation::Birth( agent* a,
 	// ---
 	// --- Update Logs
 	// ---
-	logs->postEvent( birthEvent );
+	fContext.logs->postEvent( birthEvent );
 
 	if( a )	// a will NULL for virtual births only
 	{
@@ -3417,6 +3487,20 @@ void TSimulation::Birth( agent* a,
 		// --- Create Separation Cache Entry
 		// ---
 		SeparationCache::birth( birthEvent );
+
+		fCurrentBrainStats.birth( birthEvent );
+		fGeneStats.birth( birthEvent );
+
+#if DebugBirthAllocations
+		// A recycled agent should be born without touching the heap; whatever
+		// still allocates shows up here.
+		if( a->fDebugAllocations != ULONG_MAX )
+		{
+			unsigned long n = DebugAllocationCount() - a->fDebugAllocations;
+			if( n > 0 )
+				dbprintf( "%ld: agent # %ld: %lu heap allocations from recycling to birth\n", fStep, a->Number(), n );
+		}
+#endif
 	}
 
 	// ---
@@ -3468,8 +3552,10 @@ void TSimulation::Kill( agent* c,
 	// ---
 	if( reason == LifeSpan::DR_SIMEND )
 	{
-		logs->postEvent( deathEvent );
+		fContext.logs->postEvent( deathEvent );
 		SeparationCache::death( deathEvent );
+		fCurrentBrainStats.death( deathEvent );
+		fGeneStats.death( deathEvent );
 		c->Die();
 
 		return;
@@ -3510,11 +3596,11 @@ void TSimulation::Kill( agent* c,
 
 	// If agent's carcass is to become food, make it so here
     if ( rFood
-    	&& ((long)objectxsortedlist::gXSortedObjects.getCount(FOODTYPE) < fMaxFoodCount)
+    	&& ((long)objectxsortedlist::gXSortedObjects().getCount(FOODTYPE) < fMaxFoodCount)
 		&& (fDomains[id].foodCount < fDomains[id].maxFoodCount)	// ??? Matt had commented this out; why?
 		&& ((fp = fDomains[id].whichFoodPatch( c->x(), c->z() )) && (fp->foodCount < fp->maxFoodCount))	// ??? Matt had nothing like this here; why?
-    	&& (globals::blockedEdges || (c->x() >= 0.0 && c->x() <=  globals::worldsize &&
-    	                              c->z() <= 0.0 && c->z() >= -globals::worldsize)) )
+    	&& (globals::blockedEdges() || (c->x() >= 0.0 && c->x() <=  globals::worldsize() &&
+    	                              c->z() <= 0.0 && c->z() >= -globals::worldsize())) )
     {
 		const FoodType *carcassFoodType = c->GetMetabolism()->carcassFoodType;
 		if( carcassFoodType )
@@ -3525,14 +3611,14 @@ void TSimulation::Kill( agent* c,
 			Energy foodEnergy = c->GetFoodEnergy();
 			// Multiply by polarity^2 so that we have values > 0 and so that any polarity of UNDEFINED gets zeroed.
 			Energy minFoodEnergyAtDeath = Energy(fMinFoodEnergyAtDeath) * carcassFoodType->energyPolarity * carcassFoodType->energyPolarity;
-			Energy minFoodEnergy = Energy(food::gMinFoodEnergy) * carcassFoodType->energyPolarity * carcassFoodType->energyPolarity;
+			Energy minFoodEnergy = Energy(food::gMinFoodEnergy()) * carcassFoodType->energyPolarity * carcassFoodType->energyPolarity;
 
 			if( foodEnergy.isDepleted(minFoodEnergyAtDeath) )
 			{
 				if( !minFoodEnergyAtDeath.isDepleted(minFoodEnergy) )
 				{
 					Energy addedEnergy;
-					foodEnergy.constrain( minFoodEnergyAtDeath, food::gMaxFoodEnergy, addedEnergy );
+					foodEnergy.constrain( minFoodEnergyAtDeath, food::gMaxFoodEnergy(), addedEnergy );
 					FoodEnergyIn( addedEnergy * -1 );
 				}
 			}
@@ -3544,9 +3630,9 @@ void TSimulation::Kill( agent* c,
 			else
 			{
 				food* f = new food( carcassFoodType, fStep, foodEnergy, c->x(), c->z() );
-				gdlink<gobject*> *saveCurr = objectxsortedlist::gXSortedObjects.getcurr();
-				objectxsortedlist::gXSortedObjects.add( f );	// dead agent becomes food
-				objectxsortedlist::gXSortedObjects.setcurr( saveCurr );
+				gdlink<gobject*> *saveCurr = objectxsortedlist::gXSortedObjects().getcurr();
+				objectxsortedlist::gXSortedObjects().add( f );	// dead agent becomes food
+				objectxsortedlist::gXSortedObjects().setcurr( saveCurr );
 				fStage.AddObject( f );			// put replacement food into the world
 				if( fp )
 				{
@@ -3569,8 +3655,10 @@ void TSimulation::Kill( agent* c,
 	// --- Die()
 	// ---
 	// Must call Die() for the agent before any of the uses of Fitness() below, so we get the final, true, post-death fitness
-	logs->postEvent( deathEvent );
+	fContext.logs->postEvent( deathEvent );
 	SeparationCache::death( deathEvent );
+	fCurrentBrainStats.death( deathEvent );
+	fGeneStats.death( deathEvent );
 	c->Die();
 
 	// ---
@@ -3583,11 +3671,11 @@ void TSimulation::Kill( agent* c,
 	// ---
 	// following assumes (requires!) list to be currently pointing to c,
     // and will leave the list pointing to the previous agent
-	// agent::config.xSortedAgents.remove(); // get agent out of the list
-	// objectxsortedlist::gXSortedObjects.removeCurrentObject(); // get agent out of the list
+	// agent::config().xSortedAgents.remove(); // get agent out of the list
+	// objectxsortedlist::gXSortedObjects().removeCurrentObject(); // get agent out of the list
 
 	// Following assumes (requires!) the agent to have stored c->listLink correctly
-	objectxsortedlist::gXSortedObjects.removeObjectWithLink( (gobject*) c );
+	objectxsortedlist::gXSortedObjects().removeObjectWithLink( (gobject*) c );
 
 	// !!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!
 	// !!! POST PARALLEL
@@ -3602,12 +3690,10 @@ void TSimulation::Kill( agent* c,
     fScheduler.postSerial( [=]() {
             updateFittest( c );
 
-            // Note: For the sake of computational efficiency, I used to never delete an agent,
-            // but "reinit" and reuse them as new agents were born or created.  But Gene made
-            // agents be allocated afresh on birth or creation, so we now need to delete the
-            // old ones here when they die.  Remove this if I ever get a chance to go back to the
-            // more efficient reinit and reuse technique.
-            delete c;
+            // Note: For the sake of computational efficiency, dead agents aren't deleted but
+            // kept for reuse, so that agent::getfreeagent() can construct the next agent born
+            // or created in their place, along with their genome, brain, and sensor storage.
+            agent::recycle( c );
         });
 }
 
@@ -3618,7 +3704,7 @@ void TSimulation::Kill( agent* c,
 //---------------------------------------------------------------------------
 void TSimulation::analyzeBrain( agent *c )
 {
-	logs->postEvent( BrainAnalysisBeginEvent(c) );
+	fContext.logs->postEvent( BrainAnalysisBeginEvent(c) );
 
 	if ( fCalcComplexity )
 	{
@@ -3640,7 +3726,7 @@ void TSimulation::analyzeBrain( agent *c )
 		}
 	}
 
-	logs->postEvent( BrainAnalysisEndEvent(c) );
+	fContext.logs->postEvent( BrainAnalysisEndEvent(c) );
 }
 
 //---------------------------------------------------------------------------
@@ -3716,7 +3802,7 @@ void TSimulation::AddFood( long domainNumber, long patchNumber )
 {
 	long step = fStep;
 	if( fStep == 0 && fRandomInitFoodAge )
-		step = (int)trand( -food::gMaxLifeSpan, 0 );
+		step = (int)trand( -food::gMaxLifeSpan(), 0 );
 	food *f = fDomains[domainNumber].fFoodPatches[patchNumber].addFood( step );
 	if( f != NULL )
 	{
@@ -3737,8 +3823,8 @@ void TSimulation::RemoveFood( food *f )
 	assert( domain >= 0 && domain < fNumDomains );
 	fDomains[f->domain()].foodCount--;
 
-	assert( f == objectxsortedlist::gXSortedObjects.getcurr()->e );
-	objectxsortedlist::gXSortedObjects.removeCurrentObject();   // get it out of the list
+	assert( f == objectxsortedlist::gXSortedObjects().getcurr()->e );
+	objectxsortedlist::gXSortedObjects().removeCurrentObject();   // get it out of the list
 
 	fStage.RemoveObject( f );  // get it out of the world
 
@@ -3761,7 +3847,7 @@ void TSimulation::FoodEnergyIn( const Energy &e ) {
 	if( warn ) {
 		warn = false;
 
-		if( (globals::numEnergyTypes > 1) || (FoodType::getNumberDefinitions() > 1) ) {
+		if( (globals::numEnergyTypes() > 1) || (FoodType::getNumberDefinitions() > 1) ) {
 			fprintf( stderr, "WARNING! FoodEnergyIn/Out too simplistic for tracking this simulation!\n" );
 		}
 	}
@@ -3804,7 +3890,7 @@ float TSimulation::AgentFitness( agent* c )
 		{
 			fprintf( stderr, "********** complexity being calculated when it should already be known **********\n" );
 			char filename[256];
-            sprintf( filename, "run/brain/function/brainFunction_%ld.txt", c->Number() );
+            sprintf( filename, "%s/brain/function/brainFunction_%ld.txt", SimulationContext::runDir(), c->Number() );
 			if( fComplexityType == "D" )	// difference between I and P complexity being used for fitness
 			{
 				float pComplexity = CalcComplexity_brainfunction( filename, "P" );
@@ -3841,32 +3927,32 @@ void TSimulation::processWorldFile( proplib::Document *docWorldFile )
         std::string prop = doc.get( "Edges" );
 		if( prop == "B" )
 		{
-			globals::blockedEdges = true;
-			globals::wraparound = false;
-			globals::stickyEdges = false;
+			globals::blockedEdges() = true;
+			globals::wraparound() = false;
+			globals::stickyEdges() = false;
 		}
 		else if( prop == "W" )
 		{
-			globals::blockedEdges = false;
-			globals::wraparound = true;
-			globals::stickyEdges = false;
+			globals::blockedEdges() = false;
+			globals::wraparound() = true;
+			globals::stickyEdges() = false;
 		}
 		else if( prop == "T" )
 		{
-			globals::blockedEdges = false;
-			globals::wraparound = false;
-			globals::stickyEdges = false;
+			globals::blockedEdges() = false;
+			globals::wraparound() = false;
+			globals::stickyEdges() = false;
 		}
 		else if( prop == "S" )
 		{
-			globals::blockedEdges = true;
-			globals::wraparound = false;
-			globals::stickyEdges = true;
+			globals::blockedEdges() = true;
+			globals::wraparound() = false;
+			globals::stickyEdges() = true;
 		}
 		else
 			assert( false );
 	}
-	globals::numEnergyTypes = doc.get( "NumEnergyTypes" );
+	globals::numEnergyTypes() = doc.get( "NumEnergyTypes" );
 	fStaticTimestepGeometry = doc.get( "StaticTimestepGeometry" );
 	if( fStaticTimestepGeometry )
 	{
@@ -3878,6 +3964,7 @@ void TSimulation::processWorldFile( proplib::Document *docWorldFile )
 	fParallelInteract = doc.get( "ParallelInteract" );
 	fParallelCreateAgents = doc.get( "ParallelCreateAgents" );
 	fParallelBrains = doc.get( "ParallelBrains" );
+	fParallelBodies = doc.get( "ParallelBodies" );
 	fMinNumAgents = doc.get( "MinAgents" );
 	fMaxNumAgents = doc.get( "MaxAgents" );
 	fInitNumAgents = doc.get( "InitAgents" );
@@ -3901,11 +3988,18 @@ void TSimulation::processWorldFile( proplib::Document *docWorldFile )
 	}
 	fFoodRemoveEnergy = doc.get( "FoodRemoveEnergy" );
 	fFoodRemoveFirstEat = doc.get( "FoodRemoveFirstEat" );
-	food::gMaxLifeSpan = doc.get( "FoodMaxLifeSpan" );
+	food::gMaxLifeSpan() = doc.get( "FoodMaxLifeSpan" );
 	fRandomInitFoodAge = doc.get( "RandomInitFoodAge" );
     fPositionSeed = doc.get( "PositionSeed" );
     fGenomeSeed = doc.get( "InitSeed" );
 	fSimulationSeed = doc.get( "SimulationSeed" );
+	{
+		std::string rng = (std::string) doc.get( "RandomNumberGenerator" );
+		if( rng == "Counter" )
+			RandomStream::setMode( RandomStream::COUNTER );
+		else
+			RandomStream::setMode( RandomStream::LEGACY );
+	}
 	{
 		proplib::Property &rfood = doc.get( "AgentsAreFood" );
         if( (std::string)rfood == "Fight" )
@@ -3939,9 +4033,9 @@ void TSimulation::processWorldFile( proplib::Document *docWorldFile )
     fEnergyFitnessParameter = doc.get( "FitnessWeightEnergyAtDeath" );
     fAgeFitnessParameter = doc.get( "FitnessWeightLongevity" );
   	fTotalHeuristicFitness = fEatFitnessParameter + fMateFitnessParameter + fMoveFitnessParameter + fEnergyFitnessParameter + fAgeFitnessParameter;
-	food::gMinFoodEnergy = doc.get( "MinFoodEnergy" );
-    food::gMaxFoodEnergy = doc.get( "MaxFoodEnergy" );
-	food::gSize2Energy = doc.get( "FoodEnergySizeScale" );
+	food::gMinFoodEnergy() = doc.get( "MinFoodEnergy" );
+    food::gMaxFoodEnergy() = doc.get( "MaxFoodEnergy" );
+	food::gSize2Energy() = doc.get( "FoodEnergySizeScale" );
 	fEat2Consume = doc.get( "FoodConsumptionRate" );
 	{
 		fCarryObjects = 0;
@@ -3976,8 +4070,8 @@ void TSimulation::processWorldFile( proplib::Document *docWorldFile )
 
     fMinMateFraction = doc.get( "MinMateEnergyFraction" );
     fPower2Energy = doc.get( "DamageRate" );
-	food::gCarryFood2Energy = doc.get( "EnergyUseCarryFood" );
-	brick::gCarryBrick2Energy = doc.get( "EnergyUseCarryBrick" );
+	food::gCarryFood2Energy() = doc.get( "EnergyUseCarryFood" );
+	brick::gCarryBrick2Energy() = doc.get( "EnergyUseCarryBrick" );
 	{
 		fAgentHealingRate = doc.get( "AgentHealingRate" );
 		// a bool flag to check to see if healing is turned on is faster than always comparing a float.
@@ -4008,16 +4102,16 @@ void TSimulation::processWorldFile( proplib::Document *docWorldFile )
 		__SET( "Bricks", BRICK );
 #undef __SET
 	}
-    food::gFoodHeight = doc.get( "FoodHeight" );
-    food::gFoodColor = doc.get( "FoodColor" );
-	brick::gBrickHeight = doc.get( "BrickHeight" );
-    barrier::gBarrierHeight = doc.get( "BarrierHeight" );
-    barrier::gBarrierColor = doc.get( "BarrierColor" );
-	barrier::gStickyBarriers = doc.get( "StickyBarriers" );
-	barrier::gRatioPositions = doc.get( "RatioBarrierPositions" );
+    food::gFoodHeight() = doc.get( "FoodHeight" );
+    food::gFoodColor() = doc.get( "FoodColor" );
+	brick::gBrickHeight() = doc.get( "BrickHeight" );
+    barrier::gBarrierHeight() = doc.get( "BarrierHeight" );
+    barrier::gBarrierColor() = doc.get( "BarrierColor" );
+	barrier::gStickyBarriers() = doc.get( "StickyBarriers" );
+	barrier::gRatioPositions() = doc.get( "RatioBarrierPositions" );
     fGroundColor = doc.get( "GroundColor" );
     fGroundClearance = doc.get( "GroundClearance" );
-    globals::worldsize = doc.get( "WorldSize" );
+    globals::worldsize() = doc.get( "WorldSize" );
 
 	// ---
 	// --- Barriers
@@ -4030,7 +4124,7 @@ void TSimulation::processWorldFile( proplib::Document *docWorldFile )
 			proplib::Property &propBarrier = propBarriers.get( ibarrier );
 			// Note that barriers were already allocated in InitCppProperties()
 			barrier *b = new barrier();
-			barrier::gBarriers.push_back( b );
+			barrier::gBarriers().push_back( b );
 
 			b->getPosition().xa = propBarrier.get( "X1" );
 			b->getPosition().za = propBarrier.get( "Z1" );
@@ -4039,11 +4133,11 @@ void TSimulation::processWorldFile( proplib::Document *docWorldFile )
 
 			b->init();
 
-			barrier::gXSortedBarriers.add( b );
+			barrier::gXSortedBarriers().add( b );
 		}
 	}
 
-	globals::numEnergyTypes = doc.get( "NumEnergyTypes" );
+	globals::numEnergyTypes() = doc.get( "NumEnergyTypes" );
 
 	// Process FoodTypes
 	{
@@ -4143,9 +4237,9 @@ void TSimulation::processWorldFile( proplib::Document *docWorldFile )
 	{
         std::string mode = doc.get( "AgentMetabolismSelectionMode" );
 		if( mode == "Gene" )
-			Metabolism::selectionMode = Metabolism::Gene;
+			Metabolism::selectionMode() = Metabolism::Gene;
 		else if( mode == "Random" )
-			Metabolism::selectionMode = Metabolism::Random;
+			Metabolism::selectionMode() = Metabolism::Random;
 		else
 			assert( false );
 	}
@@ -4169,24 +4263,24 @@ void TSimulation::processWorldFile( proplib::Document *docWorldFile )
 				fDomains[id].sizeX = dom.get( "SizeX" );
 				fDomains[id].sizeZ = dom.get( "SizeZ" );
 
-				fDomains[id].absoluteSizeX = globals::worldsize * fDomains[id].sizeX;
-				fDomains[id].absoluteSizeZ = globals::worldsize * fDomains[id].sizeZ;
+				fDomains[id].absoluteSizeX = globals::worldsize() * fDomains[id].sizeX;
+				fDomains[id].absoluteSizeZ = globals::worldsize() * fDomains[id].sizeZ;
 
-				fDomains[id].startX = fDomains[id].centerX * globals::worldsize - (fDomains[id].absoluteSizeX / 2.0);
-				fDomains[id].startZ = - fDomains[id].centerZ * globals::worldsize - (fDomains[id].absoluteSizeZ / 2.0);
+				fDomains[id].startX = fDomains[id].centerX * globals::worldsize() - (fDomains[id].absoluteSizeX / 2.0);
+				fDomains[id].startZ = - fDomains[id].centerZ * globals::worldsize() - (fDomains[id].absoluteSizeZ / 2.0);
 
-				fDomains[id].endX = fDomains[id].centerX * globals::worldsize + (fDomains[id].absoluteSizeX / 2.0);
-				fDomains[id].endZ = - fDomains[id].centerZ * globals::worldsize + (fDomains[id].absoluteSizeZ / 2.0);
+				fDomains[id].endX = fDomains[id].centerX * globals::worldsize() + (fDomains[id].absoluteSizeX / 2.0);
+				fDomains[id].endZ = - fDomains[id].centerZ * globals::worldsize() + (fDomains[id].absoluteSizeZ / 2.0);
 
 				// clean up for floating point precision a little
 				if( fDomains[id].startX < 0.0006 )
 					fDomains[id].startX = 0.0;
 				if( fDomains[id].startZ > -0.0006 )
 					fDomains[id].startZ = 0.0;
-				if( fDomains[id].endX > globals::worldsize * 0.9994 )
-					fDomains[id].endX = globals::worldsize;
-				if( fDomains[id].endZ < -globals::worldsize * 0.9994 )
-					fDomains[id].endZ = -globals::worldsize;
+				if( fDomains[id].endX > globals::worldsize() * 0.9994 )
+					fDomains[id].endX = globals::worldsize();
+				if( fDomains[id].endZ < -globals::worldsize() * 0.9994 )
+					fDomains[id].endZ = -globals::worldsize();
 			}
 
 			{
@@ -4401,6 +4495,8 @@ void TSimulation::processWorldFile( proplib::Document *docWorldFile )
 					printf( "Patch Fractions sum to %f, when they must sum to 1.0!\n", patchFractionSpecified );
 					exit( 1 );
 				}
+
+				fDomains[id].foodPatchIndex.build( fDomains[id].fFoodPatches, fDomains[id].numFoodPatches );
 			}
 
 			{
@@ -4560,7 +4656,7 @@ void TSimulation::processWorldFile( proplib::Document *docWorldFile )
 
 	fTournamentSize = doc.get( "TournamentSize" );
 
-	globals::recordFileType = (bool)doc.get( "CompressFiles" )
+	globals::recordFileType() = (bool)doc.get( "CompressFiles" )
 		? AbstractFile::TYPE_GZIP_FILE
 		: AbstractFile::TYPE_FILE;
 
@@ -4581,7 +4677,7 @@ void TSimulation::processWorldFile( proplib::Document *docWorldFile )
 		for( int iVariable = 0; iVariable < numVariables; iVariable++ )
 		{
 			float variable = propVariables.get( iVariable );
-			proplib::Document::variables.push_back( variable );
+			proplib::Document::variables().push_back( variable );
 		}
 	}
 }
@@ -4591,23 +4687,23 @@ void TSimulation::processWorldFile( proplib::Document *docWorldFile )
 //-------------------------------------------------------------------------------------------
 void TSimulation::initLockstepMode()
 {
-	agent::config.dieAtMaxAge = false;
-
-	agent::config.eat2Energy = 0.0;
-	agent::config.mate2Energy = 0.0;
-	agent::config.fight2Energy = 0.0;
-	agent::config.maxSizePenalty = 0.0;
-	agent::config.speed2Energy = 0.0;
-	agent::config.yaw2Energy = 0.0;
-	agent::config.light2Energy = 0.0;
-	agent::config.focus2Energy = 0.0;
-	agent::config.pickup2Energy = 0.0;
-	agent::config.drop2Energy = 0.0;
-	agent::config.carryAgent2Energy = 0.0;
-	agent::config.carryAgentSize2Energy = 0.0;
-	food::gCarryFood2Energy = 0.0;
-	brick::gCarryBrick2Energy = 0.0;
-	agent::config.fixedEnergyDrain = 0.0;
+	agent::config().dieAtMaxAge = false;
+
+	agent::config().eat2Energy = 0.0;
+	agent::config().mate2Energy = 0.0;
+	agent::config().fight2Energy = 0.0;
+	agent::config().maxSizePenalty = 0.0;
+	agent::config().speed2Energy = 0.0;
+	agent::config().yaw2Energy = 0.0;
+	agent::config().light2Energy = 0.0;
+	agent::config().focus2Energy = 0.0;
+	agent::config().pickup2Energy = 0.0;
+	agent::config().drop2Energy = 0.0;
+	agent::config().carryAgent2Energy = 0.0;
+	agent::config().carryAgentSize2Energy = 0.0;
+	food::gCarryFood2Energy() = 0.0;
+	brick::gCarryBrick2Energy() = 0.0;
+	agent::config().fixedEnergyDrain = 0.0;
 
 	fNumDepletionSteps = 0;
 	fMaxPopulationPenaltyFraction = 0.0;
@@ -4616,22 +4712,22 @@ void TSimulation::initLockstepMode()
 	fEnergyBasedPopulationControl = false;
 
     std::cout << "Due to running in LockStepWithBirthsDeathsLog mode, the following parameter values have been forcibly reset as indicated:" nl;
-    std::cout << "  DieAtMaxAge" ses agent::config.dieAtMaxAge nl;
-    std::cout << "  Eat2Energy" ses agent::config.eat2Energy nl;
-    std::cout << "  Mate2Energy" ses agent::config.mate2Energy nl;
-    std::cout << "  Fight2Energy" ses agent::config.fight2Energy nl;
-    std::cout << "  MaxSizePenalty" ses agent::config.maxSizePenalty nl;
-    std::cout << "  Speed2Energy" ses agent::config.speed2Energy nl;
-    std::cout << "  Yaw2Energy" ses agent::config.yaw2Energy nl;
-    std::cout << "  Light2Energy" ses agent::config.light2Energy nl;
-    std::cout << "  Focus2Energy" ses agent::config.focus2Energy nl;
-    std::cout << "  Pickup2Energy" ses agent::config.pickup2Energy nl;
-    std::cout << "  Drop2Energy" ses agent::config.drop2Energy nl;
-    std::cout << "  CarryAgent2Energy" ses agent::config.carryAgent2Energy nl;
-    std::cout << "  CarryAgentSize2Energy" ses agent::config.carryAgentSize2Energy nl;
-    std::cout << "  CarryFood2Energy" ses food::gCarryFood2Energy nl;
-    std::cout << "  CarryBrick2Energy" ses brick::gCarryBrick2Energy nl;
-    std::cout << "  FixedEnergyDrain" ses agent::config.fixedEnergyDrain nl;
+    std::cout << "  DieAtMaxAge" ses agent::config().dieAtMaxAge nl;
+    std::cout << "  Eat2Energy" ses agent::config().eat2Energy nl;
+    std::cout << "  Mate2Energy" ses agent::config().mate2Energy nl;
+    std::cout << "  Fight2Energy" ses agent::config().fight2Energy nl;
+    std::cout << "  MaxSizePenalty" ses agent::config().maxSizePenalty nl;
+    std::cout << "  Speed2Energy" ses agent::config().speed2Energy nl;
+    std::cout << "  Yaw2Energy" ses agent::config().yaw2Energy nl;
+    std::cout << "  Light2Energy" ses agent::config().light2Energy nl;
+    std::cout << "  Focus2Energy" ses agent::config().focus2Energy nl;
+    std::cout << "  Pickup2Energy" ses agent::config().pickup2Energy nl;
+    std::cout << "  Drop2Energy" ses agent::config().drop2Energy nl;
+    std::cout << "  CarryAgent2Energy" ses agent::config().carryAgent2Energy nl;
+    std::cout << "  CarryAgentSize2Energy" ses agent::config().carryAgentSize2Energy nl;
+    std::cout << "  CarryFood2Energy" ses food::gCarryFood2Energy() nl;
+    std::cout << "  CarryBrick2Energy" ses brick::gCarryBrick2Energy() nl;
+    std::cout << "  FixedEnergyDrain" ses agent::config().fixedEnergyDrain nl;
     std::cout << "  NumDepletionSteps" ses fNumDepletionSteps nl;
     std::cout << "  MaxPopulationPenaltyFraction" ses fMaxPopulationPenaltyFraction nl;
     std::cout << "  ApplyLowPopulationAdvantage" ses fApplyLowPopulationAdvantage nl;
@@ -4697,10 +4793,10 @@ void TSimulation::initAdaptivityMode()
 	fAllowBirths = false;
 	fEndOnPopulationCrash = true;
 
-	agent::config.dieAtMaxAge = false;
-	agent::config.maxSeedEnergy = 1.0;
-	agent::config.randomSeedEnergy = false;
-	agent::config.randomSeedMateWait = false;
+	agent::config().dieAtMaxAge = false;
+	agent::config().maxSeedEnergy = 1.0;
+	agent::config().randomSeedEnergy = false;
+	agent::config().randomSeedMateWait = false;
 
 	fNumDepletionSteps = 0;
 	fMaxPopulationPenaltyFraction = 0.0;
@@ -4722,10 +4818,10 @@ void TSimulation::initAdaptivityMode()
 	}
     std::cout << "  AllowBirths" ses fAllowBirths nl;
     std::cout << "  EndOnPopulationCrash" ses fEndOnPopulationCrash nl;
-    std::cout << "  DieAtMaxAge" ses agent::config.dieAtMaxAge nl;
-    std::cout << "  MaxSeedEnergy" ses agent::config.maxSeedEnergy nl;
-    std::cout << "  RandomSeedEnergy" ses agent::config.randomSeedEnergy nl;
-    std::cout << "  RandomSeedMateWait" ses agent::config.randomSeedMateWait nl;
+    std::cout << "  DieAtMaxAge" ses agent::config().dieAtMaxAge nl;
+    std::cout << "  MaxSeedEnergy" ses agent::config().maxSeedEnergy nl;
+    std::cout << "  RandomSeedEnergy" ses agent::config().randomSeedEnergy nl;
+    std::cout << "  RandomSeedMateWait" ses agent::config().randomSeedMateWait nl;
     std::cout << "  NumDepletionSteps" ses fNumDepletionSteps nl;
     std::cout << "  MaxPopulationPenaltyFraction" ses fMaxPopulationPenaltyFraction nl;
     std::cout << "  ApplyLowPopulationAdvantage" ses fApplyLowPopulationAdvantage nl;
@@ -4776,10 +4872,10 @@ void TSimulation::Dump()
 
     agent::agentdump(out);
 
-    out << objectxsortedlist::gXSortedObjects.getCount(FOODTYPE) nl;
+    out << objectxsortedlist::gXSortedObjects().getCount(FOODTYPE) nl;
 	food* f = NULL;
-	objectxsortedlist::gXSortedObjects.reset();
-	while (objectxsortedlist::gXSortedObjects.nextObj(FOODTYPE, (gobject**)&f))
+	objectxsortedlist::gXSortedObjects().reset();
+	while (objectxsortedlist::gXSortedObjects().nextObj(FOODTYPE, (gobject**)&f))
 		f->dump(out);
 
     out << fFitI nl;
@@ -4875,259 +4971,102 @@ void TSimulation::SwitchDomain(short newDomain, short oldDomain, int objectType)
 
 
 //---------------------------------------------------------------------------
-// TSimulation::getStatusText
+// TSimulation::getStatus
 //---------------------------------------------------------------------------
-void TSimulation::getStatusText( StatusText& statusText,
-								 int statusFrequency )
+void TSimulation::getStatus( StatusSnapshot &status,
+							 int statusFrequency )
 {
-	char t[256];
-	char t2[256];
-	short id;
-
-	// TODO: If we're neither updating the window, nor writing to the stat file,
-	// then we shouldn't sprintf all these strings, or put them in the statusText
-	// (but for now, the window always draws anyway, so it's not a big deal)
-
-	sprintf( t, "step = %ld", fStep );
-	statusText.push_back( strdup( t ) );
-
-	sprintf( t, "agents = %4d", objectxsortedlist::gXSortedObjects.getCount(AGENTTYPE) );
-	if (fNumDomains > 1)
-	{
-		sprintf(t2, " (%ld",fDomains[0].numAgents );
-		strcat(t, t2 );
-		for (id = 1; id < fNumDomains; id++)
+	status.step = fStep;
+
+	status.agents = objectxsortedlist::gXSortedObjects().getCount(AGENTTYPE);
+	status.food = objectxsortedlist::gXSortedObjects().getCount(FOODTYPE);
+	status.foodEnergy = getFoodEnergy();
+
+	status.domains.resize( fNumDomains );
+	for( int id = 0; id < fNumDomains; id++ )
+	{
+		StatusSnapshot::Domain &domain = status.domains[id];
+		domain.agents = fDomains[id].numAgents;
+		domain.food = fDomains[id].foodCount;
+		domain.created = fDomains[id].numcreated;
+		domain.born = fDomains[id].numborn;
+		domain.died = fDomains[id].numdied;
+		domain.lastCreate = fDomains[id].lastcreate;
+		domain.maxGapCreate = fDomains[id].maxgapcreate;
+
+		domain.foodPatches.resize( fCalcFoodPatchAgentCounts ? fDomains[id].numFoodPatches : 0 );
+		for( size_t i = 0; i < domain.foodPatches.size(); i++ )
 		{
-			sprintf(t2, ", %ld", fDomains[id].numAgents );
-			strcat( t, t2 );
+			FoodPatch &patch = fDomains[id].fFoodPatches[i];
+			domain.foodPatches[i].foodCount = patch.foodCount;
+			domain.foodPatches[i].agentInsideCount = patch.agentInsideCount;
+			domain.foodPatches[i].agentNeighborhoodCount = patch.agentNeighborhoodCount;
 		}
-
-		strcat(t,")" );
 	}
-	statusText.push_back( strdup( t ) );
+
+	status.metabolisms.clear();
 	if( Metabolism::getNumberOfDefinitions() > 1 )
 	{
 		for( int i = 0; i < Metabolism::getNumberOfDefinitions(); i++ )
-		{
-			sprintf( t, " -%s = %4ld", Metabolism::get(i)->name.c_str(), fNumberAliveWithMetabolism[i] );
-			statusText.push_back( strdup( t ) );
-		}
-	}
-
-	sprintf( t, "food = %4d", objectxsortedlist::gXSortedObjects.getCount(FOODTYPE) );
-	if (fNumDomains > 1)
-	{
-		sprintf(t2, " (%d",fDomains[0].foodCount );
-		strcat(t, t2 );
-		for (id = 1; id < fNumDomains; id++)
-		{
-			sprintf(t2, ", %d", fDomains[id].foodCount );
-			strcat( t, t2 );
-		}
-
-		strcat(t,")" );
-	}
-	statusText.push_back( strdup( t ) );
-
-	sprintf( t, "foodEnergy = %.1f", getFoodEnergy() );
-	statusText.push_back( strdup( t ) );
-
-	sprintf( t, "created  = %4ld", fNumberCreated );
-	if (fNumDomains > 1)
-	{
-		sprintf( t2, " (%ld",fDomains[0].numcreated );
-		strcat( t, t2 );
-
-		for (id = 1; id < fNumDomains; id++)
-		{
-			sprintf( t2, ",%ld",fDomains[id].numcreated );
-			strcat( t, t2 );
-		}
-		strcat(t,")" );
-	}
-	statusText.push_back( strdup( t ) );
-
-	sprintf( t, " -random = %4ld", fNumberCreatedRandom );
-	statusText.push_back( strdup( t ) );
-
-	sprintf( t, " -two    = %4ld", fNumberCreated2Fit );
-	statusText.push_back( strdup( t ) );
-
-	sprintf( t, " -one    = %4ld", fNumberCreated1Fit );
-	statusText.push_back( strdup( t ) );
-
-	sprintf( t, "born     = %4ld", fNumberBorn );
-	if (fNumDomains > 1)
-	{
-		sprintf( t2, " (%ld",fDomains[0].numborn );
-		strcat( t, t2 );
-		for (id = 1; id < fNumDomains; id++)
-		{
-			sprintf( t2, ",%ld",fDomains[id].numborn );
-			strcat( t, t2 );
-		}
-		strcat(t,")" );
-	}
-	statusText.push_back( strdup( t ) );
-
-	if( (fHeuristicFitnessWeight != 0.0) || (fComplexityFitnessWeight != 0.0) || fLockStepWithBirthsDeathsLog )
-	{
-		sprintf( t, "born_v   = %4ld", fNumberBornVirtual );
-		statusText.push_back( strdup( t ) );
-	}
-
-	sprintf( t, "died     = %4ld", fNumberDied );
-	if (fNumDomains > 1)
-	{
-		sprintf( t2, " (%ld",fDomains[0].numdied );
-		strcat( t, t2 );
-		for (id = 1; id < fNumDomains; id++)
-		{
-			sprintf( t2, ",%ld",fDomains[id].numdied );
-			strcat( t, t2 );
-		}
-		strcat(t,")" );
-	}
-	statusText.push_back( strdup( t ) );
-
-
-	sprintf( t, " -age    = %4ld", fNumberDiedAge );
-	statusText.push_back( strdup( t ) );
-
-	sprintf( t, " -energy = %4ld", fNumberDiedEnergy );
-	statusText.push_back( strdup( t ) );
-
-	sprintf( t, " -fight  = %4ld", fNumberDiedFight );
-	statusText.push_back( strdup( t ) );
-
-	sprintf( t, " -eat    = %4ld", fNumberDiedEat );
-	statusText.push_back( strdup( t ) );
-
-	sprintf( t, " -edge   = %4ld", fNumberDiedEdge );
-	statusText.push_back( strdup( t ) );
-
-	sprintf( t, " -smite  = %4ld", fNumberDiedSmite );
-	statusText.push_back( strdup( t ) );
-
-	sprintf( t, " -patch  = %4ld", fNumberDiedPatch );
-	statusText.push_back( strdup( t ) );
-
-    sprintf( t, "birthDenials = %ld", fBirthDenials );
-	statusText.push_back( strdup( t ) );
-
-    sprintf( t, "miscDenials = %ld", fMiscDenials );
-	statusText.push_back( strdup( t ) );
-
-    sprintf( t, "ageCreate = %ld", fLastCreated );
-    if (fNumDomains > 1)
-    {
-        sprintf( t2, " (%ld",fDomains[0].lastcreate );
-        strcat( t, t2 );
-        for (id = 1; id < fNumDomains; id++)
-        {
-            sprintf( t2, ",%ld",fDomains[id].lastcreate );
-            strcat( t, t2 );
-        }
-        strcat(t,")" );
-    }
-	statusText.push_back( strdup( t ) );
-
-	sprintf( t, "maxGapCreate = %ld", fMaxGapCreate );
-	if (fNumDomains > 1)
-	{
-		sprintf( t2, " (%ld",fDomains[0].maxgapcreate );
-	   	strcat( t, t2 );
-	   	for (id = 1; id < fNumDomains; id++)
-	   	{
-			sprintf( t2, ",%ld", fDomains[id].maxgapcreate );
-	       	strcat(t, t2 );
-	   	}
-	   	strcat(t,")" );
-	}
-	statusText.push_back( strdup( t ) );
-
-	if( (fHeuristicFitnessWeight != 0.0) || (fComplexityFitnessWeight != 0.0) )
-		sprintf( t, "born_v/(c+bv) = %.2f", float(fNumberBornVirtual) / float(fNumberCreated + fNumberBornVirtual) );
+			status.metabolisms.push_back( {&Metabolism::get(i)->name, fNumberAliveWithMetabolism[i]} );
+	}
+
+	status.created = fNumberCreated;
+	status.createdRandom = fNumberCreatedRandom;
+	status.createdTwo = fNumberCreated2Fit;
+	status.createdOne = fNumberCreated1Fit;
+	status.born = fNumberBorn;
+	status.showBornVirtual = (fHeuristicFitnessWeight != 0.0) || (fComplexityFitnessWeight != 0.0) || fLockStepWithBirthsDeathsLog;
+	status.bornVirtual = fNumberBornVirtual;
+	status.died = fNumberDied;
+	status.diedAge = fNumberDiedAge;
+	status.diedEnergy = fNumberDiedEnergy;
+	status.diedFight = fNumberDiedFight;
+	status.diedEat = fNumberDiedEat;
+	status.diedEdge = fNumberDiedEdge;
+	status.diedSmite = fNumberDiedSmite;
+	status.diedPatch = fNumberDiedPatch;
+	status.birthDenials = fBirthDenials;
+	status.miscDenials = fMiscDenials;
+	status.lastCreate = fLastCreated;
+	status.maxGapCreate = fMaxGapCreate;
+
+	status.virtualBornRatio = (fHeuristicFitnessWeight != 0.0) || (fComplexityFitnessWeight != 0.0);
+	if( status.virtualBornRatio )
+		status.bornRatio = float(fNumberBornVirtual) / float(fNumberCreated + fNumberBornVirtual);
 	else
-		sprintf( t, "born/total = %.2f", float(fNumberBorn) / float(fNumberCreated + fNumberBorn) );
-	statusText.push_back( strdup( t ) );
-
-	sprintf( t, "Fitness m=%.2f, c=%.2f, a=%.2f", fMaxFitness, fCurrentMaxFitness[0] / fTotalHeuristicFitness, fAverageFitness );
-	statusText.push_back( strdup( t ) );
+		status.bornRatio = float(fNumberBorn) / float(fNumberCreated + fNumberBorn);
 
-//	sprintf( t, "NormFit m=%.2f, c=%.2f, a=%.2f", fMaxFitness / fTotalHeuristicFitness, fCurrentMaxFitness[0] / fTotalHeuristicFitness, fAverageFitness / fTotalHeuristicFitness );
-//	statusText.push_back( strdup( t ) );
+	status.maxFitness = fMaxFitness;
+	status.currentFitness = fCurrentMaxFitness[0] / fTotalHeuristicFitness;
+	status.averageFitness = fAverageFitness;
 
-	sprintf( t, "Fittest =" );
-    int fittestCount = std::min( 5, fFittest->size() );
+	status.fittest.clear();
+	int fittestCount = std::min( 5, fFittest->size() );
 	for( int i = 0; i < fittestCount; i++ )
-	{
-		sprintf( t2, " %lu", fFittest->get(i)->agentID );
-		strcat( t, t2 );
-	}
-	statusText.push_back( strdup( t ) );
+		status.fittest.push_back( {fFittest->get(i)->agentID, fFittest->get(i)->fitness} );
 
-	if( fittestCount > 0 )
-	{
-		sprintf( t, " " );
-		for( int i = 0; i < fittestCount; i++ )
-		{
-			sprintf( t2, "  %.2f", fFittest->get(i)->fitness );
-			strcat( t, t2 );
-		}
-		statusText.push_back( strdup( t ) );
-	}
-
-	sprintf( t, "CurFit =" );
+	status.currentFittest.clear();
 	for( int i = 0; i < fCurrentFittestCount; i++ )
-	{
-		sprintf( t2, " %lu", fCurrentFittestAgent[i]->Number() );
-		strcat( t, t2 );
-	}
-	statusText.push_back( strdup( t ) );
-
-	if( fCurrentFittestCount > 0 )
-	{
-		sprintf( t, " " );
-		for( int i = 0; i < fCurrentFittestCount; i++ )
-		{
-			sprintf( t2, "  %.2f", fCurrentFittestAgent[i]->HeuristicFitness() / fTotalHeuristicFitness );
-			strcat( t, t2 );
-		}
-		statusText.push_back( strdup( t ) );
-	}
+		status.currentFittest.push_back( {(unsigned long)fCurrentFittestAgent[i]->Number(),
+										  fCurrentFittestAgent[i]->HeuristicFitness() / fTotalHeuristicFitness} );
 
-	sprintf( t, "avgFoodEnergy = %.2f", (fAverageFoodEnergyIn - fAverageFoodEnergyOut) / (fAverageFoodEnergyIn + fAverageFoodEnergyOut) );
-	statusText.push_back( strdup( t ) );
+	status.avgFoodEnergy = (fAverageFoodEnergyIn - fAverageFoodEnergyOut) / (fAverageFoodEnergyIn + fAverageFoodEnergyOut);
+	status.totFoodEnergy = (fTotalFoodEnergyIn - fTotalFoodEnergyOut) / (fTotalFoodEnergyIn + fTotalFoodEnergyOut);
 
-	sprintf( t, "totFoodEnergy = %.2f", (fTotalFoodEnergyIn - fTotalFoodEnergyOut) / (fTotalFoodEnergyIn + fTotalFoodEnergyOut) );
-	statusText.push_back( strdup( t ) );
-
-	sprintf( t, "totEnergyEaten = %.1f", fTotalEnergyEaten[0] );
-	for( int i = 1; i < globals::numEnergyTypes; i++ )
-	{
-		sprintf( t2, ", %.1f", fTotalEnergyEaten[i] );
-		strcat( t, t2 );
-	}
-	statusText.push_back( strdup( t ) );
-
-	static Energy lastTotalEnergyEaten;
-	static Energy deltaEnergy;
     if( !(fStep % statusFrequency) )
     {
-		deltaEnergy = fTotalEnergyEaten - lastTotalEnergyEaten;
-		lastTotalEnergyEaten = fTotalEnergyEaten;
+		fStatusDeltaEnergy = fTotalEnergyEaten - fStatusLastEnergyEaten;
+		fStatusLastEnergyEaten = fTotalEnergyEaten;
 	}
-	sprintf( t, "EatRate = %.1f", deltaEnergy[0] / statusFrequency );
-	for( int i = 1; i < globals::numEnergyTypes; i++ )
+	status.totEnergyEaten.resize( globals::numEnergyTypes() );
+	status.eatRate.resize( globals::numEnergyTypes() );
+	for( int i = 0; i < globals::numEnergyTypes(); i++ )
 	{
-		sprintf( t2, ", %.1f", deltaEnergy[i] / statusFrequency );
-		strcat( t, t2 );
+		status.totEnergyEaten[i] = fTotalEnergyEaten[i];
+		status.eatRate[i] = fStatusDeltaEnergy[i] / statusFrequency;
 	}
-	statusText.push_back( strdup( t ) );
 
-	static long lastNumberBorn = 0;
-	static long deltaBorn;
 	long numberBorn;
 	if( (fComplexityFitnessWeight != 0.0) || (fHeuristicFitnessWeight != 0.0) || fLockStepWithBirthsDeathsLog )
 		numberBorn = fNumberBornVirtual;
@@ -5135,45 +5074,47 @@ void TSimulation::getStatusText( StatusText& statusText,
 		numberBorn = fNumberBorn;
     if( !(fStep % statusFrequency) )
     {
-		deltaBorn = numberBorn - lastNumberBorn;
-		lastNumberBorn = numberBorn;
+		fStatusDeltaBorn = numberBorn - fStatusLastNumberBorn;
+		fStatusLastNumberBorn = numberBorn;
 	}
-	sprintf( t, "MateRate = %.2f", (double) deltaBorn / statusFrequency );
-	statusText.push_back( strdup( t ) );
+	status.mateRate = (double) fStatusDeltaBorn / statusFrequency;
 
-	sprintf( t, "LifeSpan = %lu \xb1 %lu [%lu, %lu]", nint( fLifeSpanStats.mean() ), nint( fLifeSpanStats.stddev() ), (unsigned long) fLifeSpanStats.min(), (unsigned long) fLifeSpanStats.max() );
-	statusText.push_back( strdup( t ) );
-
-	sprintf( t, "RecLifeSpan = %lu \xb1 %lu [%lu, %lu]", nint( fLifeSpanRecentStats.mean() ), nint( fLifeSpanRecentStats.stddev() ), (unsigned long) fLifeSpanRecentStats.min(), (unsigned long) fLifeSpanRecentStats.max() );
-	statusText.push_back( strdup( t ) );
+	status.lifeSpan = {fLifeSpanStats.mean(), fLifeSpanStats.stddev(), fLifeSpanStats.min(), fLifeSpanStats.max()};
+	status.recentLifeSpan = {fLifeSpanRecentStats.mean(), fLifeSpanRecentStats.stddev(), fLifeSpanRecentStats.min(), fLifeSpanRecentStats.max()};
 
 	// ---
-	// --- addStat()
+	// --- Brain
 	// ---
-    std::function<void (const char *, Stat &)> addStat =
-		[&t, &statusText] ( const char *name, Stat &stat )
+	status.brain.clear();
+	auto addStat = [&status]( const char *name, StatPopulation &stat )
 		{
-			sprintf( t, "%s = %.1f \xb1 %.1f [%lu, %lu]",
-					 name, stat.mean(), stat.stddev(), (unsigned long) stat.min(), (unsigned long) stat.max() );
-			statusText.push_back( strdup( t ) );
+			status.brain.push_back( {name, {stat.mean(), stat.stddev(), stat.min(), stat.max()}} );
 		};
 
 	addStat( "CurNeurons", fCurrentBrainStats.neuronCount );
 
-	switch( Brain::config.architecture )
+	switch( Brain::config().architecture )
 	{
 	case Brain::Configuration::Groups:
 		addStat( "CurNeurGroups", fCurrentBrainStats.groups.groupCount );
 		break;
 	case Brain::Configuration::Sheets:
-		addStat( "CurInternalSheets", fCurrentBrainStats.sheets.internalSheetCount );
-		addStat( "CurInternalNeurons", fCurrentBrainStats.sheets.internalNeuronCount );
-		for( SheetSynapseType &type : SheetSynapseTypes )
 		{
-			char name[ 64 ];
-			sprintf( name, "CurSynapse%sTo%s", sheets::Sheet::getName(type.from), sheets::Sheet::getName(type.to) );
-
-			addStat( name, fCurrentBrainStats.sheets.synapseCount[type.from][type.to] );
+			static const std::vector<std::string> synapseNames = []()
+				{
+					std::vector<std::string> names;
+					for( const BrainStats::SheetSynapseType &type : BrainStats::SheetSynapseTypes )
+						names.push_back( std::string("CurSynapse") + sheets::Sheet::getName(type.from) + "To" + sheets::Sheet::getName(type.to) );
+					return names;
+				}();
+
+			addStat( "CurInternalSheets", fCurrentBrainStats.sheets.internalSheetCount );
+			addStat( "CurInternalNeurons", fCurrentBrainStats.sheets.internalNeuronCount );
+			for( size_t i = 0; i < BrainStats::SheetSynapseTypes.size(); i++ )
+			{
+				const BrainStats::SheetSynapseType &type = BrainStats::SheetSynapseTypes[i];
+				addStat( synapseNames[i].c_str(), fCurrentBrainStats.sheets.synapseCount[type.from][type.to] );
+			}
 		}
 		break;
 	default:
@@ -5181,85 +5122,48 @@ void TSimulation::getStatusText( StatusText& statusText,
 	}
 
 	addStat( "CurSynapses", fCurrentBrainStats.synapseCount );
+	addStat( "CurBrainBytes", fCurrentBrainStats.byteCount );
 
-	sprintf( t, "Rate %2.1f (%2.1f) %2.1f (%2.1f) %2.1f (%2.1f)",
-			 fFramesPerSecondInstantaneous, fSecondsPerFrameInstantaneous,
-			 fFramesPerSecondRecent,        fSecondsPerFrameRecent,
-			 fFramesPerSecondOverall,       fSecondsPerFrameOverall  );
-	statusText.push_back( strdup( t ) );
+	// ---
+	// --- Performance
+	// ---
+	status.framesPerSecondInstantaneous = fFramesPerSecondInstantaneous;
+	status.secondsPerFrameInstantaneous = fSecondsPerFrameInstantaneous;
+	status.framesPerSecondRecent = fFramesPerSecondRecent;
+	status.secondsPerFrameRecent = fSecondsPerFrameRecent;
+	status.framesPerSecondOverall = fFramesPerSecondOverall;
+	status.secondsPerFrameOverall = fSecondsPerFrameOverall;
 
-	if( fCalcFoodPatchAgentCounts )
+	status.profiled = fProfiler.isEnabled();
+	if( status.profiled )
 	{
-		int numAgentsInAnyFoodPatchInAnyDomain = 0;
-		int numAgentsInOuterRangesInAnyDomain = 0;
-
-		for( int domainNumber = 0; domainNumber < fNumDomains; domainNumber++ )
-		{
-			sprintf( t, "Domain %d", domainNumber);
-			statusText.push_back( strdup( t ) );
-
-			int numAgentsInAnyFoodPatch = 0;
-			int numAgentsInOuterRanges = 0;
-
-			for( int i = 0; i < fDomains[domainNumber].numFoodPatches; i++ )
-			{
-				numAgentsInAnyFoodPatch += fDomains[domainNumber].fFoodPatches[i].agentInsideCount;
-				numAgentsInOuterRanges += fDomains[domainNumber].fFoodPatches[i].agentNeighborhoodCount;
-			}
-
-			float makePercent = 100.0 / fDomains[domainNumber].numAgents;
-			float makePercentNorm = 100.0 / numAgentsInAnyFoodPatch;
-
-			for( int i = 0; i < fDomains[domainNumber].numFoodPatches; i++ )
-			{
-				sprintf( t, "  FP%d %d %3d %3d  %4.1f %4.1f  %4.1f",
-						 i,
-						 fDomains[domainNumber].fFoodPatches[i].foodCount,
-						 fDomains[domainNumber].fFoodPatches[i].agentInsideCount,
-						 fDomains[domainNumber].fFoodPatches[i].agentInsideCount + fDomains[domainNumber].fFoodPatches[i].agentNeighborhoodCount,
-						 fDomains[domainNumber].fFoodPatches[i].agentInsideCount * makePercent,
-						(fDomains[domainNumber].fFoodPatches[i].agentInsideCount + fDomains[domainNumber].fFoodPatches[i].agentNeighborhoodCount) * makePercent,
-						 fDomains[domainNumber].fFoodPatches[i].agentInsideCount * makePercentNorm );
-				statusText.push_back( strdup( t ) );
-			}
-
-
-			sprintf( t, "  FP* %3d %3d  %4.1f %4.1f 100.0",
-					 numAgentsInAnyFoodPatch,
-					 numAgentsInAnyFoodPatch + numAgentsInOuterRanges,
-					 numAgentsInAnyFoodPatch * makePercent,
-					(numAgentsInAnyFoodPatch + numAgentsInOuterRanges) * makePercent );
-			statusText.push_back( strdup( t ) );
-
-			numAgentsInAnyFoodPatchInAnyDomain += numAgentsInAnyFoodPatch;
-			numAgentsInOuterRangesInAnyDomain += numAgentsInOuterRanges;
-		}
-
-		if( fNumDomains > 1 )
-		{
-			float makePercent = 100.0 / objectxsortedlist::gXSortedObjects.getCount( AGENTTYPE );
-
-			sprintf( t, "**FP* %3d %3d  %4.1f %4.1f 100.0",
-					 numAgentsInAnyFoodPatchInAnyDomain,
-					 numAgentsInAnyFoodPatchInAnyDomain + numAgentsInOuterRangesInAnyDomain,
-					 numAgentsInAnyFoodPatchInAnyDomain * makePercent,
-					(numAgentsInAnyFoodPatchInAnyDomain + numAgentsInOuterRangesInAnyDomain) * makePercent );
-			statusText.push_back( strdup( t ) );
-		}
+		for( int i = 0; i < Profiler::__NPHASES; i++ )
+			status.phaseMillis[i] = fProfiler.getMillis( (Profiler::Phase)i );
+		status.threadBusy = fProfiler.getThreadBusy();
 	}
 
+	status.foodPatchCounts = fCalcFoodPatchAgentCounts;
+
 	// Dynamic Properties
 	{
 		int nprops;
 		proplib::CppProperties::PropertyMetadata *metadata;
 		proplib::CppProperties::getMetadata( &metadata, &nprops );
 
+		status.properties.clear();
 		for( int i = 0; i < nprops; i++ )
 		{
 			if( metadata[i].type == proplib::CppProperties::PropertyMetadata::Dynamic )
 			{
-				sprintf( t, "%s = %s", metadata[i].name.c_str(), metadata[i].toString() );
-				statusText.push_back( strdup(t) );
+				double value;
+				switch( metadata[i].valueType )
+				{
+				case datalib::INT: value = *((int *)metadata[i].value); break;
+				case datalib::FLOAT: value = *((float *)metadata[i].value); break;
+				case datalib::BOOL: value = *((bool *)metadata[i].value); break;
+				default: assert( false ); value = 0.0; break;
+				}
+				status.properties.push_back( {&metadata[i].name, metadata[i].valueType, value} );
 			}
 		}
 	}
@@ -7,11 +7,15 @@
 #include <string>
 
 // Local
+#include "BrainStats.h"
 #include "Domain.h"
 #include "EatStatistics.h"
 #include "FittestList.h"
 #include "GeneStats.h"
+#include "Profiler.h"
 #include "Scheduler.h"
+#include "StatusSnapshot.h"
+#include "SimulationContext.h"
 #include "simconst.h"
 #include "simtypes.h"
 #include "agent/LifeSpan.h"
@@ -23,14 +27,16 @@
 #include "graphics/gstage.h"
 #include "proplib/cppprops.h"
 #include "proplib/proplib.h"
+#include "utils/PositionSnapshot.h"
 #include "utils/Events.h"
+#include "utils/Metrics.h"
 #include "utils/Signal.h"
 #include "library_global.h"
 
 using namespace sim;
 
 // Forward declarations
-namespace proplib { class Document; }
+namespace proplib { class Document; class SchemaDocument; }
 
 
 //===========================================================================
@@ -43,6 +49,11 @@ class LIBRARY_SHARED TSimulation
 
 public:
 	TSimulation( std::string worldfilePath, proplib::ParameterMap parameters );
+	// Takes ownership of the worldfile, to which the schema must not yet
+	// have been applied. The schema is only borrowed for initialization, so
+	// it may be shared by simulations constructed concurrently.
+	TSimulation( proplib::SchemaDocument *schema, proplib::Document *worldfile,
+				 const std::string &runDirectory = "run" );
 	virtual ~TSimulation();
 
 	void Step();
@@ -59,12 +70,13 @@ public:
 
 	bool isLockstep() const;
 	long GetMaxAgents() const;
-	static long fMaxNumAgents;
+	long fMaxNumAgents;
 	long GetInitNumAgents() const;
 	long getNumAgents( short domain = -1 );
 	long GetNumDomains() const;
 
 	long getNumBorn( AgentBirthType type );
+	long getNumDied() const;
 	long getEpoch();
 	class agent *getAgentByNumber( long number );
 	FittestList *getFittest( FitnessScope scope );
@@ -75,14 +87,21 @@ public:
 	float getFoodEnergy();
 	GeneStats &getGeneStats();
 
-    void getStatusText(StatusText& statusText, int statusFrequency );
+	void getStatus( StatusSnapshot &status, int statusFrequency );
 
 	long getStep() const;
+	const Profiler &getProfiler() const;
+	Metrics &getMetrics();
 	long GetMaxSteps() const;
 
 	void MaintainEnergyCosts();
 	double EnergyScaleFactor( long minAgents, long maxAgents, long numAgents );
 
+	// Declared first so it is constructed before and destroyed after every
+	// other member. Bound to the constructing thread for our lifetime.
+	SimulationContext fContext;
+	SimulationContext::Scope fContextScope;
+
 	bool fLockStepWithBirthsDeathsLog;	// Are we running in lockstep mode?
 	FILE * fLockstepFile;				// Define a file pointer to our LOCKSTEP-BirthsDeaths.log
 	int fLockstepTimestep;				// Timestep at which the next event in LOCKSTEP-BirthDeaths.log occurs
@@ -92,14 +111,14 @@ public:
 
 	bool fAdaptivityMode;
 
-	static long fStep;
-	static double fFramesPerSecondOverall;
-	static double fSecondsPerFrameOverall;
-	static double fFramesPerSecondRecent;
-	static double fSecondsPerFrameRecent;
-	static double fFramesPerSecondInstantaneous;
-	static double fSecondsPerFrameInstantaneous;
-	static double fTimeStart;
+	long fStep;
+	double fFramesPerSecondOverall;
+	double fSecondsPerFrameOverall;
+	double fFramesPerSecondRecent;
+	double fSecondsPerFrameRecent;
+	double fFramesPerSecondInstantaneous;
+	double fSecondsPerFrameInstantaneous;
+	double fTimeStart;
 
 	int fEpochFrequency;
 	long fEpoch;
@@ -141,6 +160,8 @@ public:
     util::Signal<> ended;
 
 private:
+	TSimulation();
+	void Init( proplib::SchemaDocument *schema, proplib::Document *worldfile );
 	void InitCppProperties( proplib::Document *docWorldFile );
 	void InitFittest();
 	void InitGround();
@@ -239,6 +260,11 @@ private:
 	void Dump();
 
 	Scheduler fScheduler;
+	Profiler fProfiler;
+	Metrics fMetrics;
+
+	unsigned long fFrame;
+	double fTimePrevious[10];	// RecentSteps
 
 	long fMaxSteps;
 	bool fEndOnPopulationCrash;
@@ -359,6 +385,7 @@ private:
 	long fLastCreated;
 	long fMaxGapCreate;
 	long fNumBornSinceCreated;
+	long fNumGlobalCreated;
 
 	bool fUseProbabilisticFoodPatches;
 	bool fFoodRemovalNeeded;
@@ -397,6 +424,10 @@ private:
 	float fAverageFoodEnergyOut;
 	Energy fEnergyEaten;
 	Energy fTotalEnergyEaten;
+	Energy fStatusLastEnergyEaten;		// as of the last getStatus() at statusFrequency
+	Energy fStatusDeltaEnergy;
+	long fStatusLastNumberBorn;
+	long fStatusDeltaBorn;
 	float fEat2Consume; // (converts eat neuron value to energy consumed)
 	int fFoodPatchOuterRange;
 	float fMinFoodEnergyAtDeath;
@@ -407,21 +438,7 @@ private:
 	int   fLinearFogEnd;
 
 	Stat fLifeSpanStats;
-	struct CurrentBrainStats
-	{
-		Stat neuronCount;
-		Stat synapseCount;
-		struct Groups
-		{
-			Stat groupCount;
-		} groups;
-		struct Sheets
-		{
-			Stat internalSheetCount;
-			Stat internalNeuronCount;
-			Stat **synapseCount;
-		} sheets;
-	} fCurrentBrainStats;
+	BrainStats fCurrentBrainStats;
 	StatRecent fLifeSpanRecentStats;
 	StatRecent fLifeFractionRecentStats;
 	GeneStats fGeneStats;
@@ -440,6 +457,9 @@ private:
 	bool fParallelInteract;
 	bool fParallelCreateAgents;
 	bool fParallelBrains;
+	bool fParallelBodies;
+	PositionSnapshot fBodySnapshot;
+	std::vector<agent::ParallelBodyUpdate> fBodyUpdates;
 
     gpolyobj fGround;
     TSetList fWorldSet;
@@ -475,6 +495,7 @@ inline long TSimulation::getNumBorn( AgentBirthType type )
 	default: assert(false); return -1;
 	}
 }
+inline long TSimulation::getNumDied() const { return fNumberDied; }
 inline long TSimulation::getEpoch() { return fEpoch; }
 inline FittestList *TSimulation::getFittest( FitnessScope scope )
 {
@@ -488,8 +509,8 @@ inline FittestList *TSimulation::getFittest( FitnessScope scope )
 inline class agent *TSimulation::getAgentByNumber( long number )
 {
 	class agent* a;
-	objectxsortedlist::gXSortedObjects.reset();
-	while( objectxsortedlist::gXSortedObjects.nextObj( AGENTTYPE, (gobject**) &a ) )
+	objectxsortedlist::gXSortedObjects().reset();
+	while( objectxsortedlist::gXSortedObjects().nextObj( AGENTTYPE, (gobject**) &a ) )
 	{
 		if( a->Number() == number) return a;
 	}
@@ -555,8 +576,8 @@ inline float TSimulation::getFoodEnergy()
 {
 	float foodEnergy = 0.0f;
 	food* f;
-	objectxsortedlist::gXSortedObjects.reset();
-	while( objectxsortedlist::gXSortedObjects.nextObj( FOODTYPE, (gobject**) &f ) )
+	objectxsortedlist::gXSortedObjects().reset();
+	while( objectxsortedlist::gXSortedObjects().nextObj( FOODTYPE, (gobject**) &f ) )
 	{
 		foodEnergy += f->getEnergy().sum();
 	}
@@ -564,6 +585,8 @@ inline float TSimulation::getFoodEnergy()
 }
 inline GeneStats &TSimulation::getGeneStats() { return fGeneStats; }
 inline long TSimulation::getStep() const { return fStep; }
+inline const Profiler &TSimulation::getProfiler() const { return fProfiler; }
+inline Metrics &TSimulation::getMetrics() { return fMetrics; }
 inline long TSimulation::GetMaxSteps() const { return fMaxSteps; }
 inline float TSimulation::EnergyFitnessParameter() const { return fEnergyFitnessParameter; }
 inline float TSimulation::AgeFitnessParameter() const { return fAgeFitnessParameter; }
@@ -0,0 +1,119 @@
+#include "SimulationContext.h"
+
+#include "utils/drand48.h"
+
+static SimulationContext defaultContext;
+static thread_local SimulationContext *boundContext = NULL;
+
+//===========================================================================
+// SimulationContext
+//===========================================================================
+
+//---------------------------------------------------------------------------
+// SimulationContext::SimulationContext
+//---------------------------------------------------------------------------
+SimulationContext::SimulationContext()
+	: simulation( NULL )
+	, agentsEver( 0 )
+	, agentsAllocated( 0 )
+	, logs( NULL )
+	, runDirectory( "run" )
+{
+	rand48_init( rand48 );
+
+	for( int i = 0; i < MaxSlots; i++ )
+		slots[i] = NULL;
+}
+
+//---------------------------------------------------------------------------
+// SimulationContext::~SimulationContext
+//---------------------------------------------------------------------------
+SimulationContext::~SimulationContext()
+{
+	// State created later may refer to state created earlier.
+	for( auto it = created.rbegin(); it != created.rend(); ++it )
+		destructors[*it]( slots[*it].load() );
+}
+
+//---------------------------------------------------------------------------
+// SimulationContext::current
+//---------------------------------------------------------------------------
+SimulationContext *SimulationContext::current()
+{
+	return boundContext ? boundContext : &defaultContext;
+}
+
+//---------------------------------------------------------------------------
+// SimulationContext::runDir
+//---------------------------------------------------------------------------
+const char *SimulationContext::runDir()
+{
+	return current()->runDirectory.c_str();
+}
+
+//---------------------------------------------------------------------------
+// SimulationContext::runPath
+//---------------------------------------------------------------------------
+std::string SimulationContext::runPath( const std::string &path )
+{
+	return current()->runDirectory + "/" + path;
+}
+
+//---------------------------------------------------------------------------
+// SimulationContext::allocSlot
+//---------------------------------------------------------------------------
+int SimulationContext::allocSlot()
+{
+	static std::atomic<int> nslots( 0 );
+
+	int index = nslots++;
+	assert( index < MaxSlots );
+	return index;
+}
+
+//---------------------------------------------------------------------------
+// SimulationContext::create
+//---------------------------------------------------------------------------
+void *SimulationContext::create( int index, void *(*construct)(), void (*destruct)(void *) )
+{
+	std::lock_guard<std::recursive_mutex> lock( slotsMutex );
+
+	// Another thread may have got here first.
+	void *p = slots[index].load();
+	if( p == NULL )
+	{
+		p = construct();
+		destructors[index] = destruct;
+		created.push_back( index );
+		slots[index].store( p, std::memory_order_release );
+	}
+
+	return p;
+}
+
+//---------------------------------------------------------------------------
+// SimulationContext::bind
+//---------------------------------------------------------------------------
+void SimulationContext::bind( SimulationContext *context )
+{
+	boundContext = context;
+	// The default context keeps using the process-wide drand48() state.
+	rand48_bind( context ? context->rand48 : NULL );
+}
+
+//---------------------------------------------------------------------------
+// SimulationContext::Scope::Scope
+//---------------------------------------------------------------------------
+SimulationContext::Scope::Scope( SimulationContext *context )
+	: prev( boundContext )
+{
+	bind( context );
+}
+
+//---------------------------------------------------------------------------
+// SimulationContext::Scope::~Scope
+//---------------------------------------------------------------------------
+SimulationContext::Scope::~Scope()
+{
+	bind( prev );
+}
@@ -0,0 +1,110 @@
+#pragma once
+
+#include <assert.h>
+
+#include <atomic>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include "environment/barrier.h"
+#include "environment/food.h"
+#include "utils/objectxsortedlist.h"
+
+class agent;
+class Logs;
+class TSimulation;
+
+//===========================================================================
+// SimulationContext
+//
+// Per-simulation state that code below TSimulation reaches without a
+// simulation pointer: the object lists, the agent counters and free list, the
+// logs, the drand48() sequence and the run directory everything is written
+// to. TSimulation owns one and binds it to the
+// threads that run it, so two simulations in a process no longer share this
+// state.
+// Modules keep the rest of their mutable statics (worldfile configuration,
+// registries, counters) in a struct of their own obtained with get<T>().
+// Outside any simulation (e.g. the analysis tools) a process-wide default
+// context is current.
+//===========================================================================
+class SimulationContext
+{
+ public:
+	SimulationContext();
+	~SimulationContext();
+
+	static SimulationContext *current();
+
+	// The current context's run directory, and a path within it.
+	static const char *runDir();
+	static std::string runPath( const std::string &path );
+
+	// This context's instance of T, value-initialized on first use and
+	// destroyed with the context, most recently created first. Only call it
+	// from the library's own translation units, which share the slot numbers.
+	template<typename T>
+	T &get();
+
+	// Makes the context current on the calling thread until destroyed,
+	// then restores whatever was current before.
+	class Scope
+	{
+	public:
+		Scope( SimulationContext *context );
+		~Scope();
+
+	private:
+		SimulationContext *prev;
+	};
+
+	TSimulation *simulation;
+	objectxsortedlist xsortedObjects;
+	bxsortedlist xsortedBarriers;
+	food::FoodList allFood;
+	unsigned long agentsEver;
+	unsigned long agentsAllocated;
+	// Dead agents awaiting reuse by agent::getfreeagent().
+	std::vector<agent *> freeAgents;
+	Logs *logs;
+	unsigned short rand48[3];
+	std::string runDirectory;	// "run" unless the simulation was given another
+
+ private:
+	enum { MaxSlots = 64 };
+
+	static void bind( SimulationContext *context );
+	static int allocSlot();
+	template<typename T>
+	static int slot();
+	void *create( int index, void *(*construct)(), void (*destruct)(void *) );
+
+	std::atomic<void *> slots[MaxSlots];
+	void (*destructors[MaxSlots])( void * );
+	std::vector<int> created;
+	std::recursive_mutex slotsMutex;	// constructors may get<>() too
+};
+
+//===========================================================================
+// inlines
+//===========================================================================
+
+template<typename T>
+inline int SimulationContext::slot()
+{
+	static const int index = allocSlot();
+	return index;
+}
+
+template<typename T>
+inline T &SimulationContext::get()
+{
+	int index = slot<T>();
+	void *p = slots[index].load( std::memory_order_acquire );
+	if( p == NULL )
+		p = create( index,
+					[]() -> void * { return new T(); },
+					[]( void *p ) { delete (T *)p; } );
+	return *(T *)p;
+}
@@ -0,0 +1,68 @@
+#include "StatusLog.h"
+
+#include <errno.h>
+#include <stdint.h>
+#include <string.h>
+
+#include "StatusSnapshot.h"
+#include "utils/misc.h"
+
+#define MAGIC "PWSTATUS"
+#define VERSION 1
+
+//===========================================================================
+// StatusLog
+//===========================================================================
+
+//---------------------------------------------------------------------------
+// StatusLog::StatusLog
+//---------------------------------------------------------------------------
+StatusLog::StatusLog( const std::string &path )
+	: path( path )
+	, file( NULL )
+	, ncols( 0 )
+{
+}
+
+//---------------------------------------------------------------------------
+// StatusLog::~StatusLog
+//---------------------------------------------------------------------------
+StatusLog::~StatusLog()
+{
+	if( file )
+		fclose( file );
+}
+
+//---------------------------------------------------------------------------
+// StatusLog::write
+//---------------------------------------------------------------------------
+void StatusLog::write( const StatusSnapshot &status )
+{
+	if( !file )
+	{
+		std::vector<std::string> names;
+		status.flatten( &names, values );
+		ncols = names.size();
+
+		makeParentDir( path.c_str() );
+		file = fopen( path.c_str(), "wb" );
+		ERRIF( file == NULL, "Failed opening %s (%d)", path.c_str(), errno );
+
+		uint32_t version = VERSION;
+		uint32_t n = ncols;
+		fwrite( MAGIC, 1, strlen(MAGIC), file );
+		fwrite( &version, sizeof(version), 1, file );
+		fwrite( &n, sizeof(n), 1, file );
+		for( const std::string &name : names )
+			fwrite( name.c_str(), 1, name.length() + 1, file );
+	}
+	else
+	{
+		status.flatten( NULL, values );
+		ERRIF( values.size() != ncols, "Status columns changed during run (%lu -> %lu)",
+			   (unsigned long)ncols, (unsigned long)values.size() );
+	}
+
+	fwrite( values.data(), sizeof(double), ncols, file );
+	fflush( file );
+}
@@ -0,0 +1,38 @@
+#pragma once
+
+#include <stdio.h>
+
+#include <string>
+#include <vector>
+
+struct StatusSnapshot;
+
+//===========================================================================
+// StatusLog
+//
+// Appends each StatusSnapshot, flattened to numbers, to a binary file that
+// scripts can load without parsing the stat.* text files
+// (see common_stats.parse_status_log). Layout:
+//
+//   "PWSTATUS"                    8 bytes
+//   version                       uint32
+//   ncols                         uint32
+//   column names                  ncols NUL-terminated strings
+//   rows                          ncols float64 each, until end of file
+//
+// Integers are in native byte order, as are the float64s.
+//===========================================================================
+class StatusLog
+{
+ public:
+	StatusLog( const std::string &path );
+	~StatusLog();
+
+	void write( const StatusSnapshot &status );
+
+ private:
+	std::string path;
+	FILE *file;
+	size_t ncols;
+	std::vector<double> values;
+};
@@ -0,0 +1,374 @@
+#include "StatusSnapshot.h"
+
+#include <stdarg.h>
+#include <stdio.h>
+#include <string.h>
+
+#include "utils/misc.h"
+
+using namespace sim;
+
+//---------------------------------------------------------------------------
+// appendf
+//---------------------------------------------------------------------------
+static void appendf( std::string &s, const char *format, ... )
+{
+	char buf[256];
+	va_list args;
+	va_start( args, format );
+	vsnprintf( buf, sizeof(buf), format, args );
+	va_end( args );
+
+	s += buf;
+}
+
+//---------------------------------------------------------------------------
+// line
+//---------------------------------------------------------------------------
+static std::string line( const char *format, ... )
+{
+	char buf[256];
+	va_list args;
+	va_start( args, format );
+	vsnprintf( buf, sizeof(buf), format, args );
+	va_end( args );
+
+	return buf;
+}
+
+//===========================================================================
+// StatusSnapshot
+//===========================================================================
+
+//---------------------------------------------------------------------------
+// StatusSnapshot::render
+//---------------------------------------------------------------------------
+void StatusSnapshot::render( StatusText &text, bool performance ) const
+{
+	// Per-domain breakdown of a total, e.g. " (3, 4)", only with domains.
+	auto byDomain = [this]( std::string &s, const char *first, const char *rest, long Domain::*field )
+		{
+			if( domains.size() > 1 )
+			{
+				appendf( s, first, domains[0].*field );
+				for( size_t i = 1; i < domains.size(); i++ )
+					appendf( s, rest, domains[i].*field );
+				s += ")";
+			}
+		};
+
+	text.push_back( line("step = %ld", step) );
+
+	std::string s = line( "agents = %4ld", agents );
+	byDomain( s, " (%ld", ", %ld", &Domain::agents );
+	text.push_back( s );
+	for( const Metabolism &metabolism : metabolisms )
+		text.push_back( line(" -%s = %4ld", metabolism.name->c_str(), metabolism.agents) );
+
+	s = line( "food = %4d", food );
+	if( domains.size() > 1 )
+	{
+		appendf( s, " (%d", domains[0].food );
+		for( size_t i = 1; i < domains.size(); i++ )
+			appendf( s, ", %d", domains[i].food );
+		s += ")";
+	}
+	text.push_back( s );
+
+	text.push_back( line("foodEnergy = %.1f", foodEnergy) );
+
+	s = line( "created  = %4ld", created );
+	byDomain( s, " (%ld", ",%ld", &Domain::created );
+	text.push_back( s );
+	text.push_back( line(" -random = %4ld", createdRandom) );
+	text.push_back( line(" -two    = %4ld", createdTwo) );
+	text.push_back( line(" -one    = %4ld", createdOne) );
+
+	s = line( "born     = %4ld", born );
+	byDomain( s, " (%ld", ",%ld", &Domain::born );
+	text.push_back( s );
+
+	if( showBornVirtual )
+		text.push_back( line("born_v   = %4ld", bornVirtual) );
+
+	s = line( "died     = %4ld", died );
+	byDomain( s, " (%ld", ",%ld", &Domain::died );
+	text.push_back( s );
+	text.push_back( line(" -age    = %4ld", diedAge) );
+	text.push_back( line(" -energy = %4ld", diedEnergy) );
+	text.push_back( line(" -fight  = %4ld", diedFight) );
+	text.push_back( line(" -eat    = %4ld", diedEat) );
+	text.push_back( line(" -edge   = %4ld", diedEdge) );
+	text.push_back( line(" -smite  = %4ld", diedSmite) );
+	text.push_back( line(" -patch  = %4ld", diedPatch) );
+
+	text.push_back( line("birthDenials = %ld", birthDenials) );
+	text.push_back( line("miscDenials = %ld", miscDenials) );
+
+	s = line( "ageCreate = %ld", lastCreate );
+	byDomain( s, " (%ld", ",%ld", &Domain::lastCreate );
+	text.push_back( s );
+
+	s = line( "maxGapCreate = %ld", maxGapCreate );
+	byDomain( s, " (%ld", ",%ld", &Domain::maxGapCreate );
+	text.push_back( s );
+
+	if( virtualBornRatio )
+		text.push_back( line("born_v/(c+bv) = %.2f", bornRatio) );
+	else
+		text.push_back( line("born/total = %.2f", bornRatio) );
+
+	text.push_back( line("Fitness m=%.2f, c=%.2f, a=%.2f", maxFitness, currentFitness, averageFitness) );
+
+	auto addFits = [&text]( const char *title, const std::vector<Fit> &fits )
+		{
+			std::string s = title;
+			for( const Fit &fit : fits )
+				appendf( s, " %lu", fit.id );
+			text.push_back( s );
+
+			if( !fits.empty() )
+			{
+				s = " ";
+				for( const Fit &fit : fits )
+					appendf( s, "  %.2f", fit.fitness );
+				text.push_back( s );
+			}
+		};
+	addFits( "Fittest =", fittest );
+	addFits( "CurFit =", currentFittest );
+
+	text.push_back( line("avgFoodEnergy = %.2f", avgFoodEnergy) );
+	text.push_back( line("totFoodEnergy = %.2f", totFoodEnergy) );
+
+	auto addEnergy = [&text]( const char *title, const std::vector<float> &energy )
+		{
+			std::string s = line( "%s = %.1f", title, energy[0] );
+			for( size_t i = 1; i < energy.size(); i++ )
+				appendf( s, ", %.1f", energy[i] );
+			text.push_back( s );
+		};
+	addEnergy( "totEnergyEaten", totEnergyEaten );
+	addEnergy( "EatRate", eatRate );
+
+	text.push_back( line("MateRate = %.2f", mateRate) );
+
+	text.push_back( line("LifeSpan = %lu \xb1 %lu [%lu, %lu]",
+						 (unsigned long) nint(lifeSpan.mean), (unsigned long) nint(lifeSpan.stddev),
+						 (unsigned long) lifeSpan.min, (unsigned long) lifeSpan.max) );
+	text.push_back( line("RecLifeSpan = %lu \xb1 %lu [%lu, %lu]",
+						 (unsigned long) nint(recentLifeSpan.mean), (unsigned long) nint(recentLifeSpan.stddev),
+						 (unsigned long) recentLifeSpan.min, (unsigned long) recentLifeSpan.max) );
+
+	for( const BrainStat &stat : brain )
+		text.push_back( line("%s = %.1f \xb1 %.1f [%lu, %lu]",
+							 stat.name, stat.spread.mean, stat.spread.stddev,
+							 (unsigned long) stat.spread.min, (unsigned long) stat.spread.max) );
+
+	if( performance )
+	{
+		text.push_back( line("Rate %2.1f (%2.1f) %2.1f (%2.1f) %2.1f (%2.1f)",
+							 framesPerSecondInstantaneous, secondsPerFrameInstantaneous,
+							 framesPerSecondRecent,        secondsPerFrameRecent,
+							 framesPerSecondOverall,       secondsPerFrameOverall) );
+
+		if( profiled )
+		{
+			for( int i = 0; i < Profiler::__NPHASES; i++ )
+			{
+				Profiler::Phase phase = (Profiler::Phase)i;
+				text.push_back( line("Time %*s%s = %.2f ms",
+									 2 * Profiler::getDepth(phase), "",
+									 Profiler::getName(phase),
+									 phaseMillis[i]) );
+			}
+
+			s = "Time threads busy =";
+			for( double busy : threadBusy )
+			{
+				if( s.length() + 8 > 256 )
+					break;
+				appendf( s, " %.2f", busy );
+			}
+			text.push_back( s );
+		}
+	}
+
+	if( foodPatchCounts )
+	{
+		int numAgentsInAnyFoodPatchInAnyDomain = 0;
+		int numAgentsInOuterRangesInAnyDomain = 0;
+
+		for( size_t domainNumber = 0; domainNumber < domains.size(); domainNumber++ )
+		{
+			const Domain &domain = domains[domainNumber];
+
+			text.push_back( line("Domain %d", (int)domainNumber) );
+
+			int numAgentsInAnyFoodPatch = 0;
+			int numAgentsInOuterRanges = 0;
+
+			for( const FoodPatch &patch : domain.foodPatches )
+			{
+				numAgentsInAnyFoodPatch += patch.agentInsideCount;
+				numAgentsInOuterRanges += patch.agentNeighborhoodCount;
+			}
+
+			float makePercent = 100.0 / domain.agents;
+			float makePercentNorm = 100.0 / numAgentsInAnyFoodPatch;
+
+			for( size_t i = 0; i < domain.foodPatches.size(); i++ )
+			{
+				const FoodPatch &patch = domain.foodPatches[i];
+				text.push_back( line("  FP%d %d %3d %3d  %4.1f %4.1f  %4.1f",
+									 (int)i,
+									 patch.foodCount,
+									 patch.agentInsideCount,
+									 patch.agentInsideCount + patch.agentNeighborhoodCount,
+									 patch.agentInsideCount * makePercent,
+									 (patch.agentInsideCount + patch.agentNeighborhoodCount) * makePercent,
+									 patch.agentInsideCount * makePercentNorm) );
+			}
+
+			text.push_back( line("  FP* %3d %3d  %4.1f %4.1f 100.0",
+								 numAgentsInAnyFoodPatch,
+								 numAgentsInAnyFoodPatch + numAgentsInOuterRanges,
+								 numAgentsInAnyFoodPatch * makePercent,
+								 (numAgentsInAnyFoodPatch + numAgentsInOuterRanges) * makePercent) );
+
+			numAgentsInAnyFoodPatchInAnyDomain += numAgentsInAnyFoodPatch;
+			numAgentsInOuterRangesInAnyDomain += numAgentsInOuterRanges;
+		}
+
+		if( domains.size() > 1 )
+		{
+			float makePercent = 100.0 / agents;
+
+			text.push_back( line("**FP* %3d %3d  %4.1f %4.1f 100.0",
+								 numAgentsInAnyFoodPatchInAnyDomain,
+								 numAgentsInAnyFoodPatchInAnyDomain + numAgentsInOuterRangesInAnyDomain,
+								 numAgentsInAnyFoodPatchInAnyDomain * makePercent,
+								 (numAgentsInAnyFoodPatchInAnyDomain + numAgentsInOuterRangesInAnyDomain) * makePercent) );
+		}
+	}
+
+	for( const Property &prop : properties )
+	{
+		switch( prop.type )
+		{
+		case datalib::INT:
+			text.push_back( line("%s = %d", prop.name->c_str(), (int)prop.value) );
+			break;
+		case datalib::FLOAT:
+			text.push_back( line("%s = %g", prop.name->c_str(), (float)prop.value) );
+			break;
+		case datalib::BOOL:
+			text.push_back( line("%s = %s", prop.name->c_str(), prop.value ? "True" : "False") );
+			break;
+		default:
+			assert( false );
+		}
+	}
+}
+
+//---------------------------------------------------------------------------
+// StatusSnapshot::flatten
+//
+// Column names follow the labels scripts/common_stats.py derives from the
+// text, so the binary log and stat files can be used interchangeably.
+//---------------------------------------------------------------------------
+void StatusSnapshot::flatten( std::vector<std::string> *names, std::vector<double> &values ) const
+{
+	values.clear();
+
+	auto col = [names, &values]( const std::string &name, double value )
+		{
+			if( names )
+				names->push_back( name );
+			values.push_back( value );
+		};
+	auto spread = [&col]( const std::string &name, const Spread &spread )
+		{
+			col( name, spread.mean );
+			col( name + ".stddev", spread.stddev );
+			col( name + ".min", spread.min );
+			col( name + ".max", spread.max );
+		};
+
+	col( "step", step );
+	col( "agents", agents );
+	for( const Metabolism &metabolism : metabolisms )
+		col( "agents-" + *metabolism.name, metabolism.agents );
+	col( "food", food );
+	col( "foodEnergy", foodEnergy );
+	col( "created", created );
+	col( "created-random", createdRandom );
+	col( "created-two", createdTwo );
+	col( "created-one", createdOne );
+	col( "born", born );
+	if( showBornVirtual )
+		col( "born_v", bornVirtual );
+	col( "died", died );
+	col( "died-age", diedAge );
+	col( "died-energy", diedEnergy );
+	col( "died-fight", diedFight );
+	col( "died-eat", diedEat );
+	col( "died-edge", diedEdge );
+	col( "died-smite", diedSmite );
+	col( "died-patch", diedPatch );
+	col( "birthDenials", birthDenials );
+	col( "miscDenials", miscDenials );
+	col( "ageCreate", lastCreate );
+	col( "maxGapCreate", maxGapCreate );
+	col( virtualBornRatio ? "bornRatio_v" : "bornRatio", bornRatio );
+	col( "Fitness.max", maxFitness );
+	col( "Fitness.current", currentFitness );
+	col( "Fitness.average", averageFitness );
+	col( "avgFoodEnergy", avgFoodEnergy );
+	col( "totFoodEnergy", totFoodEnergy );
+	for( size_t i = 0; i < totEnergyEaten.size(); i++ )
+		col( "totEnergyEaten[" + std::to_string(i) + "]", totEnergyEaten[i] );
+	for( size_t i = 0; i < eatRate.size(); i++ )
+		col( "EatRate[" + std::to_string(i) + "]", eatRate[i] );
+	col( "MateRate", mateRate );
+	spread( "LifeSpan", lifeSpan );
+	spread( "RecLifeSpan", recentLifeSpan );
+	for( const BrainStat &stat : brain )
+		spread( stat.name, stat.spread );
+
+	if( domains.size() > 1 )
+	{
+		for( size_t i = 0; i < domains.size(); i++ )
+		{
+			const Domain &domain = domains[i];
+			std::string prefix = "Domain[" + std::to_string(i) + "]";
+			col( prefix + "agents", domain.agents );
+			col( prefix + "food", domain.food );
+			col( prefix + "created", domain.created );
+			col( prefix + "born", domain.born );
+			col( prefix + "died", domain.died );
+			col( prefix + "ageCreate", domain.lastCreate );
+			col( prefix + "maxGapCreate", domain.maxGapCreate );
+		}
+	}
+
+	if( foodPatchCounts )
+	{
+		for( size_t i = 0; i < domains.size(); i++ )
+		{
+			const Domain &domain = domains[i];
+			std::string prefix = "Domain[" + std::to_string(i) + "]FP[";
+			for( size_t j = 0; j < domain.foodPatches.size(); j++ )
+			{
+				const FoodPatch &patch = domain.foodPatches[j];
+				std::string fp = prefix + std::to_string(j) + "]";
+				col( fp + "[0]", patch.foodCount );
+				col( fp + "[1]", patch.agentInsideCount );
+				col( fp + "[2]", patch.agentInsideCount + patch.agentNeighborhoodCount );
+			}
+		}
+	}
+
+	for( const Property &prop : properties )
+		col( *prop.name, prop.value );
+}
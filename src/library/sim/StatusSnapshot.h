@@ -0,0 +1,142 @@
+#pragma once
+
+#include <string>
+#include <vector>
+
+#include "Profiler.h"
+#include "simtypes.h"
+#include "utils/datalib.h"
+
+//===========================================================================
+// StatusSnapshot
+//
+// The simulation's status at one step, as plain values copied from the
+// counters the simulation keeps (see TSimulation::getStatus). Text is only
+// produced when somebody asks for it via render(); flatten() gives the same
+// values as named numeric columns for the binary status log.
+//===========================================================================
+struct StatusSnapshot
+{
+	// Mean, standard deviation and range of a population statistic.
+	struct Spread
+	{
+		double mean;
+		double stddev;
+		double min;
+		double max;
+	};
+
+	struct FoodPatch
+	{
+		int foodCount;
+		int agentInsideCount;
+		int agentNeighborhoodCount;
+	};
+
+	struct Domain
+	{
+		long agents;
+		int food;
+		long created;
+		long born;
+		long died;
+		long lastCreate;
+		long maxGapCreate;
+		std::vector<FoodPatch> foodPatches;
+	};
+
+	struct Metabolism
+	{
+		const std::string *name;
+		long agents;
+	};
+
+	struct Fit
+	{
+		unsigned long id;
+		float fitness;
+	};
+
+	struct BrainStat
+	{
+		const char *name;
+		Spread spread;
+	};
+
+	struct Property
+	{
+		const std::string *name;
+		datalib::Type type;
+		double value;
+	};
+
+	long step;
+
+	long agents;
+	int food;
+	float foodEnergy;
+	std::vector<Domain> domains;
+	std::vector<Metabolism> metabolisms;
+
+	long created;
+	long createdRandom;
+	long createdTwo;
+	long createdOne;
+	long born;
+	bool showBornVirtual;
+	long bornVirtual;
+	long died;
+	long diedAge;
+	long diedEnergy;
+	long diedFight;
+	long diedEat;
+	long diedEdge;
+	long diedSmite;
+	long diedPatch;
+	long birthDenials;
+	long miscDenials;
+	long lastCreate;
+	long maxGapCreate;
+	// born_v/(c+bv) when virtual births are the measure, else born/total.
+	bool virtualBornRatio;
+	float bornRatio;
+
+	float maxFitness;
+	float currentFitness;
+	float averageFitness;
+	std::vector<Fit> fittest;
+	std::vector<Fit> currentFittest;
+
+	float avgFoodEnergy;
+	float totFoodEnergy;
+	std::vector<float> totEnergyEaten;
+	std::vector<float> eatRate;
+	double mateRate;
+
+	Spread lifeSpan;
+	Spread recentLifeSpan;
+	std::vector<BrainStat> brain;
+
+	double framesPerSecondInstantaneous;
+	double secondsPerFrameInstantaneous;
+	double framesPerSecondRecent;
+	double secondsPerFrameRecent;
+	double framesPerSecondOverall;
+	double secondsPerFrameOverall;
+
+	bool profiled;
+	double phaseMillis[Profiler::__NPHASES];
+	std::vector<double> threadBusy;
+
+	bool foodPatchCounts;
+
+	std::vector<Property> properties;
+
+	// Appends the status text lines. Performance lines (Rate, Time) are
+	// left out unless requested.
+	void render( sim::StatusText &text, bool performance = true ) const;
+
+	// Numeric values as columns. The set of columns is fixed for a run, so
+	// names need only be fetched once.
+	void flatten( std::vector<std::string> *names, std::vector<double> &values ) const;
+};
@@ -7,6 +7,9 @@
 
 // System
 #include <stdarg.h>
+#include <stdlib.h>
+
+#include <new>
 
 // Self
 #include "debug.h"
@@ -22,6 +25,31 @@
 
 #define DEBUGCHECK_SPECIFICS 1
 
+#if DebugBirthAllocations
+static thread_local unsigned long allocations = 0;
+
+void *operator new( size_t size )
+{
+	allocations++;
+
+	void *p = malloc( size ? size : 1 );
+	if( p == NULL )
+		throw std::bad_alloc();
+
+	return p;
+}
+
+void operator delete( void *p ) noexcept
+{
+	free( p );
+}
+
+unsigned long DebugAllocationCount()
+{
+	return allocations;
+}
+#endif
+
 void DebugCheck( const char* func, const char* frmt, ... )
 {
 	va_list ap;
@@ -33,10 +61,10 @@ void DebugCheck( const char* func, const char* frmt, ... )
 	gobject* b = NULL;
 	gobject* bbad = NULL;
 	
-	gdlink<gobject*> *saveCurr = objectxsortedlist::gXSortedObjects.getcurr();	// save the state of the x-sorted list
+	gdlink<gobject*> *saveCurr = objectxsortedlist::gXSortedObjects().getcurr();	// save the state of the x-sorted list
 	
-	objectxsortedlist::gXSortedObjects.reset();
-	objectxsortedlist::gXSortedObjects.nextObj( AGENTTYPE, (gobject**) &a );
+	objectxsortedlist::gXSortedObjects().reset();
+	objectxsortedlist::gXSortedObjects().nextObj( AGENTTYPE, (gobject**) &a );
 	if( a )
 		step = ((agent*)a)->fSimulation->fStep;
 	else
@@ -55,8 +83,8 @@ void DebugCheck( const char* func, const char* frmt, ... )
 	// look for any object that thinks it is being carried by an agent that isn't carrying it
 
 	
-	objectxsortedlist::gXSortedObjects.reset();
-	while( objectxsortedlist::gXSortedObjects.nextObj( ANYTYPE, (gobject**) &a ) )
+	objectxsortedlist::gXSortedObjects().reset();
+	while( objectxsortedlist::gXSortedObjects().nextObj( ANYTYPE, (gobject**) &a ) )
 	{
 		b = a->CarriedBy();
 		
@@ -98,7 +126,7 @@ void DebugCheck( const char* func, const char* frmt, ... )
 		}
 	}
 	
-	objectxsortedlist::gXSortedObjects.setcurr( saveCurr );	// restore the state of the x-sorted list
+	objectxsortedlist::gXSortedObjects().setcurr( saveCurr );	// restore the state of the x-sorted list
 
 	//if( step > 410 )
 	//	printf( "%s\n", s );
@@ -10,6 +10,8 @@
 
 #define DebugSetRadius 0
 #define TestWorld 0
+// Report heap allocations made between recycling an agent and its birth.
+#define DebugBirthAllocations 0
 
 #define dbprintf( x... ) ( fprintf( stderr, x ), fflush( stderr ) )
 
@@ -30,6 +32,11 @@ extern void DebugCheck( const char* func, const char* fmt, ... );
 	#define debugcheck( x... )
 #endif
 
+#if DebugBirthAllocations
+	// Calls to operator new made on this thread.
+	extern unsigned long DebugAllocationCount();
+#endif
+
 #define BoolString( boolVar ) (boolVar) ? "true" : "false"
 
 #endif //  DEBUG_H
@@ -8,10 +8,30 @@
 // Self
 #include "globals.h"
 
-float   globals::worldsize;		// agent, food
-bool	globals::wraparound;	// agent, sceneview, simulation
-bool	globals::blockedEdges;	// agent, simulation
-bool	globals::stickyEdges;
-int     globals::numEnergyTypes;
-AbstractFile::ConcreteFileType globals::recordFileType;
+#include "SimulationContext.h"
+
+namespace
+{
+	struct Globals
+	{
+		float   worldsize;		// agent, food
+		bool	wraparound;		// agent, sceneview, simulation
+		bool	blockedEdges;	// agent, simulation
+		bool	stickyEdges;
+		int     numEnergyTypes;
+		AbstractFile::ConcreteFileType recordFileType;
+	};
+
+	Globals &get()
+	{
+		return SimulationContext::current()->get<Globals>();
+	}
+}
+
+float &globals::worldsize() { return get().worldsize; }
+bool &globals::wraparound() { return get().wraparound; }
+bool &globals::blockedEdges() { return get().blockedEdges; }
+bool &globals::stickyEdges() { return get().stickyEdges; }
+int &globals::numEnergyTypes() { return get().numEnergyTypes; }
+AbstractFile::ConcreteFileType &globals::recordFileType() { return get().recordFileType; }
 
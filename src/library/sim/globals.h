@@ -27,15 +27,16 @@ static const int MAXLIGHTS = 10;
 // Prefs
 static const char kWindowsGroupSettingsName[] = "windows";
 
+// Set from the worldfile, so held per simulation (see SimulationContext).
 class globals
 {
 public:
-	static float	worldsize;
-	static bool		wraparound;
-	static bool		blockedEdges;
-	static bool     stickyEdges;
-	static int      numEnergyTypes;
-	static AbstractFile::ConcreteFileType recordFileType;
+	static float	&worldsize();
+	static bool		&wraparound();
+	static bool		&blockedEdges();
+	static bool     &stickyEdges();
+	static int      &numEnergyTypes();
+	static AbstractFile::ConcreteFileType &recordFileType();
 };
 
 #endif
@@ -1,9 +1,12 @@
 #pragma once
 
+#include <assert.h>
 #include <float.h>
 #include <math.h>
 #include <stdlib.h>
 
+#include <map>
+#include <string>
 #include <vector>
 
 #include "simconst.h"
@@ -317,7 +320,7 @@ namespace sim
 	//===========================================================================
 	// StatusText
 	//===========================================================================
-	typedef std::vector<char *> StatusText;
+	typedef std::vector<std::string> StatusText;
 
 	//===========================================================================
 	// Position
@@ -354,6 +357,34 @@ namespace sim
 		unsigned long	count;	// count
 	};
 
+	//===========================================================================
+	// StatPopulation
+	//
+	// Like Stat, but values can be removed again, e.g. when an agent dies. A
+	// histogram of the values keeps min and max exact across removals.
+	//===========================================================================
+	class StatPopulation
+	{
+	public:
+		StatPopulation()		{ reset(); }
+		~StatPopulation()		{}
+
+		float	mean()			{ if( !count ) return( 0.0 ); return( sum / count ); }
+		float	stddev()		{ if( !count ) return( 0.0 ); double m = sum / count;  return( sqrt( fmax( 0.0, sum2 / count  -  m * m ) ) ); }
+		float	min()			{ if( !count ) return( 0.0 ); return( histogram.begin()->first ); }
+		float	max()			{ if( !count ) return( 0.0 ); return( histogram.rbegin()->first ); }
+		void	add( float v )	{ sum += v; sum2 += v*v; count++; histogram[v]++; }
+		void	remove( float v )	{ std::map<float, unsigned long>::iterator it = histogram.find( v ); assert( it != histogram.end() ); if( --it->second == 0 ) histogram.erase( it ); sum -= v; sum2 -= v*v; count--; }
+		void	reset()			{ sum = sum2 = count = 0; histogram.clear(); }
+		unsigned long samples() { return( count ); }
+
+	private:
+		double	sum;	// sum
+		double	sum2;	// sum of squares
+		unsigned long	count;	// count
+		std::map<float, unsigned long> histogram;	// value -> count
+	};
+
 	//===========================================================================
 	// StatRecent
 	//===========================================================================
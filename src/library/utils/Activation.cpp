@@ -0,0 +1,357 @@
+#include "Activation.h"
+
+#include <math.h>
+#include <stdint.h>
+#include <string.h>
+
+#if defined(__AVX2__)
+	#include <immintrin.h>
+#elif defined(__SSE2__)
+	#include <emmintrin.h>
+#endif
+
+// The scalar tail must round exactly like the vector lanes, so keep the
+// compiler from fusing multiply-adds in this file.
+#if defined(__GNUC__) && !defined(__clang__)
+	#pragma GCC optimize ("fp-contract=off")
+#endif
+
+#include "misc.h"
+#include "sim/SimulationContext.h"
+
+using namespace std;
+
+//---------------------------------------------------------------------------
+// Constants
+//---------------------------------------------------------------------------
+#define EXP_HI 88.3762626647949f
+#define EXP_LO -88.3762626647949f
+#define LOG2EF 1.44269504088896341f
+#define EXP_C1 0.693359375f
+#define EXP_C2 -2.12194440e-4f
+#define EXP_P0 1.9875691500E-4f
+#define EXP_P1 1.3981999507E-3f
+#define EXP_P2 8.3334519073E-3f
+#define EXP_P3 4.1665795894E-2f
+#define EXP_P4 1.6666665459E-1f
+#define EXP_P5 5.0000001201E-1f
+
+// Values measured by activationbench on x86-64, rounded up.
+const double Activation::MaxExpRelError = 2.0e-7;
+const double Activation::MaxLogisticAbsError = 1.0e-7;
+const double Activation::MaxTanhAbsError = 2.0e-7;
+
+namespace
+{
+	struct Settings
+	{
+		Activation::Mode mode = Activation::EXACT;
+	};
+}
+
+//---------------------------------------------------------------------------
+// Activation::setMode
+//---------------------------------------------------------------------------
+void Activation::setMode( Mode mode_ )
+{
+	SimulationContext::current()->get<Settings>().mode = mode_;
+}
+
+//---------------------------------------------------------------------------
+// Activation::getMode
+//---------------------------------------------------------------------------
+Activation::Mode Activation::getMode()
+{
+	return SimulationContext::current()->get<Settings>().mode;
+}
+
+//---------------------------------------------------------------------------
+// Activation::isa
+//---------------------------------------------------------------------------
+const char *Activation::isa()
+{
+#if defined(__AVX2__)
+	return "avx2";
+#elif defined(__SSE2__)
+	return "sse2";
+#else
+	return "scalar";
+#endif
+}
+
+//---------------------------------------------------------------------------
+// Activation::logistic
+//---------------------------------------------------------------------------
+double Activation::logistic( double x, double slope )
+{
+	if( getMode() == FAST )
+		return fastLogistic( (float)(x * slope) );
+	else
+		return ::logistic( x, slope );
+}
+
+//---------------------------------------------------------------------------
+// Activation::tanh
+//---------------------------------------------------------------------------
+double Activation::tanh( double x )
+{
+	if( getMode() == FAST )
+		return fastTanh( (float)x );
+	else
+		return ::tanh( x );
+}
+
+//---------------------------------------------------------------------------
+// Batch helpers
+//
+// Double arrays are narrowed into a small float buffer so the FAST path can
+// run on full vectors.
+//---------------------------------------------------------------------------
+#define BLOCK 64
+
+static void narrowApply( double *x, size_t n, void (*fn)(float *, size_t) )
+{
+	float buf[BLOCK];
+
+	for( size_t start = 0; start < n; start += BLOCK )
+	{
+		size_t count = n - start < BLOCK ? n - start : BLOCK;
+		for( size_t i = 0; i < count; i++ )
+			buf[i] = (float)x[start + i];
+		fn( buf, count );
+		for( size_t i = 0; i < count; i++ )
+			x[start + i] = buf[i];
+	}
+}
+
+void Activation::logistic( double *x, size_t n )
+{
+	if( getMode() == FAST )
+	{
+		narrowApply( x, n, fastLogistic );
+	}
+	else
+	{
+		for( size_t i = 0; i < n; i++ )
+			x[i] = ::logistic( x[i], 1.0 );
+	}
+}
+
+void Activation::logistic( float *x, size_t n )
+{
+	if( getMode() == FAST )
+	{
+		fastLogistic( x, n );
+	}
+	else
+	{
+		for( size_t i = 0; i < n; i++ )
+			x[i] = (float)::logistic( x[i], 1.0 );
+	}
+}
+
+void Activation::tanh( double *x, size_t n )
+{
+	if( getMode() == FAST )
+	{
+		narrowApply( x, n, fastTanh );
+	}
+	else
+	{
+		for( size_t i = 0; i < n; i++ )
+			x[i] = ::tanh( x[i] );
+	}
+}
+
+void Activation::tanh( float *x, size_t n )
+{
+	if( getMode() == FAST )
+	{
+		fastTanh( x, n );
+	}
+	else
+	{
+		for( size_t i = 0; i < n; i++ )
+			x[i] = (float)::tanh( (double)x[i] );
+	}
+}
+
+//---------------------------------------------------------------------------
+// Scalar approximations
+//---------------------------------------------------------------------------
+float Activation::fastExp( float x )
+{
+	if( x > EXP_HI ) x = EXP_HI;
+	if( x < EXP_LO ) x = EXP_LO;
+
+	// n = floor(x / ln2 + 0.5)
+	float fx = x * LOG2EF + 0.5f;
+	float t = (float)(int32_t)fx;
+	if( t > fx ) t -= 1.0f;
+	fx = t;
+
+	x = x - fx * EXP_C1;
+	x = x - fx * EXP_C2;
+
+	float z = x * x;
+	float y = EXP_P0;
+	y = y * x + EXP_P1;
+	y = y * x + EXP_P2;
+	y = y * x + EXP_P3;
+	y = y * x + EXP_P4;
+	y = y * x + EXP_P5;
+	y = y * z + x;
+	y = y + 1.0f;
+
+	// y * 2^n, split in two so that n = -127 and n = 128 stay representable.
+	int32_t n = (int32_t)fx;
+	int32_t n1 = n >> 1;
+	int32_t n2 = n - n1;
+	uint32_t b1 = (uint32_t)(n1 + 127) << 23;
+	uint32_t b2 = (uint32_t)(n2 + 127) << 23;
+	float p1, p2;
+	memcpy( &p1, &b1, sizeof(float) );
+	memcpy( &p2, &b2, sizeof(float) );
+
+	return y * p1 * p2;
+}
+
+float Activation::fastLogistic( float x )
+{
+	return 1.0f / (1.0f + fastExp(-x));
+}
+
+float Activation::fastTanh( float x )
+{
+	return 2.0f / (1.0f + fastExp(-2.0f * x)) - 1.0f;
+}
+
+//---------------------------------------------------------------------------
+// Vector approximations
+//
+// Each lane performs exactly the operations of the scalar versions above.
+//---------------------------------------------------------------------------
+#if defined(__AVX2__)
+
+#define VWIDTH 8
+typedef __m256 vfloat;
+typedef __m256i vint;
+
+static inline vfloat vset( float f ) { return _mm256_set1_ps( f ); }
+static inline vfloat vload( const float *p ) { return _mm256_loadu_ps( p ); }
+static inline void vstore( float *p, vfloat v ) { _mm256_storeu_ps( p, v ); }
+static inline vfloat vadd( vfloat a, vfloat b ) { return _mm256_add_ps( a, b ); }
+static inline vfloat vsub( vfloat a, vfloat b ) { return _mm256_sub_ps( a, b ); }
+static inline vfloat vmul( vfloat a, vfloat b ) { return _mm256_mul_ps( a, b ); }
+static inline vfloat vdiv( vfloat a, vfloat b ) { return _mm256_div_ps( a, b ); }
+static inline vfloat vmin( vfloat a, vfloat b ) { return _mm256_min_ps( a, b ); }
+static inline vfloat vmax( vfloat a, vfloat b ) { return _mm256_max_ps( a, b ); }
+static inline vfloat vgtmask( vfloat a, vfloat b, vfloat v ) { return _mm256_and_ps( _mm256_cmp_ps(a, b, _CMP_GT_OS), v ); }
+static inline vint vtrunc( vfloat a ) { return _mm256_cvttps_epi32( a ); }
+static inline vfloat vtofloat( vint a ) { return _mm256_cvtepi32_ps( a ); }
+static inline vfloat vpow2( vint n ) { return _mm256_castsi256_ps( _mm256_slli_epi32(_mm256_add_epi32(n, _mm256_set1_epi32(127)), 23) ); }
+static inline vint vsrai1( vint n ) { return _mm256_srai_epi32( n, 1 ); }
+static inline vint vsubi( vint a, vint b ) { return _mm256_sub_epi32( a, b ); }
+
+#elif defined(__SSE2__)
+
+#define VWIDTH 4
+typedef __m128 vfloat;
+typedef __m128i vint;
+
+static inline vfloat vset( float f ) { return _mm_set1_ps( f ); }
+static inline vfloat vload( const float *p ) { return _mm_loadu_ps( p ); }
+static inline void vstore( float *p, vfloat v ) { _mm_storeu_ps( p, v ); }
+static inline vfloat vadd( vfloat a, vfloat b ) { return _mm_add_ps( a, b ); }
+static inline vfloat vsub( vfloat a, vfloat b ) { return _mm_sub_ps( a, b ); }
+static inline vfloat vmul( vfloat a, vfloat b ) { return _mm_mul_ps( a, b ); }
+static inline vfloat vdiv( vfloat a, vfloat b ) { return _mm_div_ps( a, b ); }
+static inline vfloat vmin( vfloat a, vfloat b ) { return _mm_min_ps( a, b ); }
+static inline vfloat vmax( vfloat a, vfloat b ) { return _mm_max_ps( a, b ); }
+static inline vfloat vgtmask( vfloat a, vfloat b, vfloat v ) { return _mm_and_ps( _mm_cmpgt_ps(a, b), v ); }
+static inline vint vtrunc( vfloat a ) { return _mm_cvttps_epi32( a ); }
+static inline vfloat vtofloat( vint a ) { return _mm_cvtepi32_ps( a ); }
+static inline vfloat vpow2( vint n ) { return _mm_castsi128_ps( _mm_slli_epi32(_mm_add_epi32(n, _mm_set1_epi32(127)), 23) ); }
+static inline vint vsrai1( vint n ) { return _mm_srai_epi32( n, 1 ); }
+static inline vint vsubi( vint a, vint b ) { return _mm_sub_epi32( a, b ); }
+
+#endif
+
+#ifdef VWIDTH
+
+static inline vfloat vexp( vfloat x )
+{
+	// Clamp with min/max in the scalar order: upper bound first.
+	x = vmin( x, vset(EXP_HI) );
+	x = vmax( x, vset(EXP_LO) );
+
+	vfloat fx = vadd( vmul(x, vset(LOG2EF)), vset(0.5f) );
+	vfloat t = vtofloat( vtrunc(fx) );
+	t = vsub( t, vgtmask(t, fx, vset(1.0f)) );
+	fx = t;
+
+	x = vsub( x, vmul(fx, vset(EXP_C1)) );
+	x = vsub( x, vmul(fx, vset(EXP_C2)) );
+
+	vfloat z = vmul( x, x );
+	vfloat y = vset( EXP_P0 );
+	y = vadd( vmul(y, x), vset(EXP_P1) );
+	y = vadd( vmul(y, x), vset(EXP_P2) );
+	y = vadd( vmul(y, x), vset(EXP_P3) );
+	y = vadd( vmul(y, x), vset(EXP_P4) );
+	y = vadd( vmul(y, x), vset(EXP_P5) );
+	y = vadd( vmul(y, z), x );
+	y = vadd( y, vset(1.0f) );
+
+	vint n = vtrunc( fx );
+	vint n1 = vsrai1( n );
+	vint n2 = vsubi( n, n1 );
+
+	return vmul( vmul(y, vpow2(n1)), vpow2(n2) );
+}
+
+#endif
+
+void Activation::fastExp( float *x, size_t n )
+{
+	size_t i = 0;
+#ifdef VWIDTH
+	for( ; i + VWIDTH <= n; i += VWIDTH )
+		vstore( x + i, vexp(vload(x + i)) );
+#endif
+	for( ; i < n; i++ )
+		x[i] = fastExp( x[i] );
+}
+
+void Activation::fastLogistic( float *x, size_t n )
+{
+	size_t i = 0;
+#ifdef VWIDTH
+	vfloat one = vset( 1.0f );
+	vfloat zero = vset( 0.0f );
+	for( ; i + VWIDTH <= n; i += VWIDTH )
+	{
+		vfloat e = vexp( vsub(zero, vload(x + i)) );
+		vstore( x + i, vdiv(one, vadd(one, e)) );
+	}
+#endif
+	for( ; i < n; i++ )
+		x[i] = fastLogistic( x[i] );
+}
+
+void Activation::fastTanh( float *x, size_t n )
+{
+	size_t i = 0;
+#ifdef VWIDTH
+	vfloat one = vset( 1.0f );
+	vfloat two = vset( 2.0f );
+	vfloat negtwo = vset( -2.0f );
+	for( ; i + VWIDTH <= n; i += VWIDTH )
+	{
+		vfloat e = vexp( vmul(negtwo, vload(x + i)) );
+		vstore( x + i, vsub(vdiv(two, vadd(one, e)), one) );
+	}
+#endif
+	for( ; i < n; i++ )
+		x[i] = fastTanh( x[i] );
+}
@@ -0,0 +1,63 @@
+#pragma once
+
+#include <stddef.h>
+#include <stdio.h>
+
+//===========================================================================
+// Activation
+//
+// Logistic and tanh transfer functions for the neural kernels. In EXACT mode
+// these are the libm-based definitions from misc.h. In FAST mode they use a
+// single-precision polynomial exp (Cephes expf, degree 5 on [-ln2/2, ln2/2])
+// that is evaluated 4 (SSE2) lanes at a time by the batch functions, or 8
+// (AVX2) in a library built with "qmake CONFIG+=avx2".
+//
+// The scalar and SIMD fast paths perform the same float operations in the
+// same order (no FMA), so a given build gives identical results whether or
+// not a value lands in a vector lane.
+//
+// Measured maximum error of FAST mode over [-88, 88] (see activationbench):
+//
+//   exp       relative  MaxExpRelError
+//   logistic  absolute  MaxLogisticAbsError
+//   tanh      absolute  MaxTanhAbsError
+//===========================================================================
+class Activation
+{
+ public:
+	enum Mode
+	{
+		EXACT,
+		FAST
+	};
+
+	static const double MaxExpRelError;
+	static const double MaxLogisticAbsError;
+	static const double MaxTanhAbsError;
+
+	// Per simulation.
+	static void setMode( Mode mode );
+	static Mode getMode();
+
+	// Name of the instruction set used by the FAST batch functions.
+	static const char *isa();
+
+	// Mode-dispatched. logistic(x, slope) == 1 / (1 + exp(-x * slope)).
+	static double logistic( double x, double slope );
+	static double tanh( double x );
+
+	// Mode-dispatched, in place, slope 1; callers fold any slope into x.
+	static void logistic( double *x, size_t n );
+	static void logistic( float *x, size_t n );
+	static void tanh( double *x, size_t n );
+	static void tanh( float *x, size_t n );
+
+	// FAST approximations regardless of mode.
+	static float fastExp( float x );
+	static float fastLogistic( float x );
+	static float fastTanh( float x );
+
+	static void fastExp( float *x, size_t n );
+	static void fastLogistic( float *x, size_t n );
+	static void fastTanh( float *x, size_t n );
+};
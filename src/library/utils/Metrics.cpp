@@ -0,0 +1,215 @@
+#include "Metrics.h"
+
+#include <assert.h>
+#include <stdio.h>
+
+#include <algorithm>
+
+static void appendSample( std::string &out, const std::string &name, const char *suffix, const char *labels, double value )
+{
+	char buf[64];
+	snprintf( buf, sizeof(buf), " %.10g\n", value );
+
+	out += name;
+	out += suffix;
+	out += labels;
+	out += buf;
+}
+
+//===========================================================================
+// Metrics::Metric
+//===========================================================================
+
+//---------------------------------------------------------------------------
+// Metrics::Metric::Metric
+//---------------------------------------------------------------------------
+Metrics::Metric::Metric( const std::string &name, const std::string &help, Type type )
+	: name( name )
+	, help( help )
+	, type( type )
+{
+}
+
+//===========================================================================
+// Metrics::Counter
+//===========================================================================
+
+//---------------------------------------------------------------------------
+// Metrics::Counter::Counter
+//---------------------------------------------------------------------------
+Metrics::Counter::Counter( const std::string &name, const std::string &help )
+	: Metric( name, help, COUNTER )
+	, value( 0.0 )
+{
+}
+
+//---------------------------------------------------------------------------
+// Metrics::Counter::expose
+//---------------------------------------------------------------------------
+void Metrics::Counter::expose( std::string &out ) const
+{
+	appendSample( out, name, "", "", value );
+}
+
+//===========================================================================
+// Metrics::Gauge
+//===========================================================================
+
+//---------------------------------------------------------------------------
+// Metrics::Gauge::Gauge
+//---------------------------------------------------------------------------
+Metrics::Gauge::Gauge( const std::string &name, const std::string &help )
+	: Metric( name, help, GAUGE )
+	, value( 0.0 )
+{
+}
+
+//---------------------------------------------------------------------------
+// Metrics::Gauge::expose
+//---------------------------------------------------------------------------
+void Metrics::Gauge::expose( std::string &out ) const
+{
+	appendSample( out, name, "", "", value );
+}
+
+//===========================================================================
+// Metrics::Histogram
+//===========================================================================
+
+//---------------------------------------------------------------------------
+// Metrics::Histogram::Histogram
+//---------------------------------------------------------------------------
+Metrics::Histogram::Histogram( const std::string &name, const std::string &help, const std::vector<double> &bounds )
+	: Metric( name, help, HISTOGRAM )
+	, bounds( bounds )
+	, counts( bounds.size(), 0 )
+	, count( 0 )
+	, sum( 0.0 )
+{
+	assert( std::is_sorted(bounds.begin(), bounds.end()) );
+}
+
+//---------------------------------------------------------------------------
+// Metrics::Histogram::observe
+//---------------------------------------------------------------------------
+void Metrics::Histogram::observe( double value )
+{
+	size_t i = std::lower_bound( bounds.begin(), bounds.end(), value ) - bounds.begin();
+	if( i < counts.size() )
+		counts[i]++;
+	count++;
+	sum += value;
+}
+
+//---------------------------------------------------------------------------
+// Metrics::Histogram::expose
+//---------------------------------------------------------------------------
+void Metrics::Histogram::expose( std::string &out ) const
+{
+	uint64_t cumulative = 0;
+	for( size_t i = 0; i < bounds.size(); i++ )
+	{
+		char labels[64];
+		snprintf( labels, sizeof(labels), "{le=\"%g\"}", bounds[i] );
+		cumulative += counts[i];
+		appendSample( out, name, "_bucket", labels, (double)cumulative );
+	}
+	appendSample( out, name, "_bucket", "{le=\"+Inf\"}", (double)count );
+	appendSample( out, name, "_sum", "", sum );
+	appendSample( out, name, "_count", "", (double)count );
+}
+
+//===========================================================================
+// Metrics
+//===========================================================================
+
+//---------------------------------------------------------------------------
+// Metrics::Metrics
+//---------------------------------------------------------------------------
+Metrics::Metrics()
+{
+}
+
+//---------------------------------------------------------------------------
+// Metrics::~Metrics
+//---------------------------------------------------------------------------
+Metrics::~Metrics()
+{
+	for( Metric *metric : metrics )
+		delete metric;
+}
+
+//---------------------------------------------------------------------------
+// Metrics::find
+//---------------------------------------------------------------------------
+Metrics::Metric *Metrics::find( const std::string &name, Type type )
+{
+	for( Metric *metric : metrics )
+	{
+		if( metric->name == name )
+		{
+			assert( metric->type == type );
+			return metric;
+		}
+	}
+	return NULL;
+}
+
+//---------------------------------------------------------------------------
+// Metrics::counter
+//---------------------------------------------------------------------------
+Metrics::Counter &Metrics::counter( const std::string &name, const std::string &help )
+{
+	Metric *metric = find( name, COUNTER );
+	if( !metric )
+	{
+		metric = new Counter( name, help );
+		metrics.push_back( metric );
+	}
+	return *(Counter *)metric;
+}
+
+//---------------------------------------------------------------------------
+// Metrics::gauge
+//---------------------------------------------------------------------------
+Metrics::Gauge &Metrics::gauge( const std::string &name, const std::string &help )
+{
+	Metric *metric = find( name, GAUGE );
+	if( !metric )
+	{
+		metric = new Gauge( name, help );
+		metrics.push_back( metric );
+	}
+	return *(Gauge *)metric;
+}
+
+//---------------------------------------------------------------------------
+// Metrics::histogram
+//---------------------------------------------------------------------------
+Metrics::Histogram &Metrics::histogram( const std::string &name, const std::string &help, const std::vector<double> &bounds )
+{
+	Metric *metric = find( name, HISTOGRAM );
+	if( !metric )
+	{
+		metric = new Histogram( name, help, bounds );
+		metrics.push_back( metric );
+	}
+	return *(Histogram *)metric;
+}
+
+//---------------------------------------------------------------------------
+// Metrics::expose
+//---------------------------------------------------------------------------
+std::string Metrics::expose() const
+{
+	static const char *TypeNames[] = { "counter", "gauge", "histogram" };
+
+	std::string out;
+	for( Metric *metric : metrics )
+	{
+		out += "# HELP " + metric->name + " " + metric->help + "\n";
+		out += "# TYPE " + metric->name + " " + TypeNames[metric->type] + "\n";
+		metric->expose( out );
+	}
+	return out;
+}
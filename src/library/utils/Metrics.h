@@ -0,0 +1,112 @@
+#pragma once
+
+#include <stdint.h>
+
+#include <string>
+#include <vector>
+
+//===========================================================================
+// Metrics
+//
+// Registry of live run telemetry, rendered by expose() in the Prometheus
+// text exposition format:
+//
+//   # HELP polyworld_agents Agents alive.
+//   # TYPE polyworld_agents gauge
+//   polyworld_agents 182
+//
+// Metrics are registered and updated from the master thread. Registering a
+// name twice returns the existing metric.
+//===========================================================================
+class Metrics
+{
+ public:
+	enum Type
+	{
+		COUNTER,
+		GAUGE,
+		HISTOGRAM
+	};
+
+	class Metric
+	{
+	public:
+		virtual ~Metric() {}
+
+		const std::string name;
+		const std::string help;
+		const Type type;
+
+	protected:
+		friend class Metrics;
+
+		Metric( const std::string &name, const std::string &help, Type type );
+
+		virtual void expose( std::string &out ) const = 0;
+	};
+
+	// Monotonic total. set() mirrors a tally the simulation already keeps.
+	class Counter : public Metric
+	{
+	public:
+		void inc( double n = 1.0 ) { value += n; }
+		void set( double total ) { value = total; }
+		double get() const { return value; }
+
+	private:
+		friend class Metrics;
+
+		Counter( const std::string &name, const std::string &help );
+		virtual void expose( std::string &out ) const;
+
+		double value;
+	};
+
+	class Gauge : public Metric
+	{
+	public:
+		void set( double value ) { this->value = value; }
+		double get() const { return value; }
+
+	private:
+		friend class Metrics;
+
+		Gauge( const std::string &name, const std::string &help );
+		virtual void expose( std::string &out ) const;
+
+		double value;
+	};
+
+	// Cumulative buckets with the given ascending upper bounds, plus +Inf.
+	class Histogram : public Metric
+	{
+	public:
+		void observe( double value );
+
+	private:
+		friend class Metrics;
+
+		Histogram( const std::string &name, const std::string &help, const std::vector<double> &bounds );
+		virtual void expose( std::string &out ) const;
+
+		std::vector<double> bounds;
+		std::vector<uint64_t> counts;
+		uint64_t count;
+		double sum;
+	};
+
+	Metrics();
+	~Metrics();
+
+	Counter &counter( const std::string &name, const std::string &help );
+	Gauge &gauge( const std::string &name, const std::string &help );
+	Histogram &histogram( const std::string &name, const std::string &help, const std::vector<double> &bounds );
+
+	// All metrics, in registration order.
+	std::string expose() const;
+
+ private:
+	Metric *find( const std::string &name, Type type );
+
+	std::vector<Metric *> metrics;
+};
@@ -0,0 +1,199 @@
+#include "MetricsSegment.h"
+
+#include <errno.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#if !__WIN64__ && !__WIN32__
+#include <fcntl.h>
+#include <sched.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+#include <atomic>
+#include <new>
+
+#define MAGIC "PWMETRIC"
+#define VERSION 1
+#define READ_ATTEMPTS 1000
+
+static_assert( ATOMIC_LLONG_LOCK_FREE == 2, "Shared sequence number must be lock-free" );
+
+//===========================================================================
+// MetricsSegment::Header
+//===========================================================================
+struct MetricsSegment::Header
+{
+	char magic[8];
+	uint32_t version;
+	uint32_t capacity;
+	std::atomic<uint64_t> sequence;
+	std::atomic<uint64_t> length;
+};
+
+//===========================================================================
+// MetricsSegment
+//===========================================================================
+
+//---------------------------------------------------------------------------
+// MetricsSegment::MetricsSegment
+//---------------------------------------------------------------------------
+MetricsSegment::MetricsSegment( const std::string &path, size_t capacity )
+	: size( sizeof(Header) + capacity )
+	, header( NULL )
+	, data( NULL )
+	, warnedTruncate( false )
+{
+#if __WIN64__ || __WIN32__
+	fprintf( stderr, "Metrics segments are not supported on Windows; %s not written\n", path.c_str() );
+#else
+	// Replace rather than truncate, so a reader still mapping a previous
+	// run's segment never sees it shrink underneath it.
+	std::string tmp = path + ".tmp";
+	int fd = open( tmp.c_str(), O_RDWR | O_CREAT | O_TRUNC, 0644 );
+	if( (fd < 0) || ftruncate(fd, size) )
+	{
+		fprintf( stderr, "Failed creating %s (%d)\n", tmp.c_str(), errno );
+		exit( 1 );
+	}
+
+	void *addr = mmap( NULL, size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0 );
+	close( fd );
+	if( addr == MAP_FAILED )
+	{
+		fprintf( stderr, "Failed mapping %s (%d)\n", tmp.c_str(), errno );
+		exit( 1 );
+	}
+
+	header = new (addr) Header;
+	data = (char *)addr + sizeof(Header);
+
+	memcpy( header->magic, MAGIC, sizeof(header->magic) );
+	header->version = VERSION;
+	header->capacity = capacity;
+	header->sequence.store( 0 );
+	header->length.store( 0 );
+
+	if( rename(tmp.c_str(), path.c_str()) )
+	{
+		fprintf( stderr, "Failed renaming %s to %s (%d)\n", tmp.c_str(), path.c_str(), errno );
+		exit( 1 );
+	}
+#endif
+}
+
+//---------------------------------------------------------------------------
+// MetricsSegment::~MetricsSegment
+//
+// The file is left in place with the final metrics.
+//---------------------------------------------------------------------------
+MetricsSegment::~MetricsSegment()
+{
+#if !__WIN64__ && !__WIN32__
+	if( header )
+		munmap( header, size );
+#endif
+}
+
+//---------------------------------------------------------------------------
+// MetricsSegment::publish
+//---------------------------------------------------------------------------
+void MetricsSegment::publish( const std::string &text )
+{
+	if( !header )
+		return;
+
+	size_t length = text.size();
+	if( length > header->capacity )
+	{
+		length = text.rfind( '\n', header->capacity - 1 ) + 1;
+		if( !warnedTruncate )
+		{
+			fprintf( stderr, "Metrics exceed segment capacity of %u bytes; truncating\n", header->capacity );
+			warnedTruncate = true;
+		}
+	}
+
+	uint64_t sequence = header->sequence.load( std::memory_order_relaxed );
+	header->sequence.store( sequence + 1, std::memory_order_relaxed );
+	std::atomic_thread_fence( std::memory_order_release );
+
+	memcpy( data, text.data(), length );
+	header->length.store( length, std::memory_order_relaxed );
+
+	header->sequence.store( sequence + 2, std::memory_order_release );
+}
+
+//---------------------------------------------------------------------------
+// MetricsSegment::read
+//---------------------------------------------------------------------------
+bool MetricsSegment::read( const std::string &path, std::string &text, std::string &err )
+{
+#if __WIN64__ || __WIN32__
+	err = "not supported on Windows";
+	return false;
+#else
+	int fd = open( path.c_str(), O_RDONLY );
+	if( fd < 0 )
+	{
+		err = strerror( errno );
+		return false;
+	}
+
+	struct stat st;
+	if( fstat(fd, &st) || (st.st_size < (off_t)sizeof(Header)) )
+	{
+		close( fd );
+		err = "not a metrics segment";
+		return false;
+	}
+
+	size_t size = st.st_size;
+	void *addr = mmap( NULL, size, PROT_READ, MAP_SHARED, fd, 0 );
+	close( fd );
+	if( addr == MAP_FAILED )
+	{
+		err = strerror( errno );
+		return false;
+	}
+
+	const Header *header = (const Header *)addr;
+	const char *data = (const char *)addr + sizeof(Header);
+	bool ok = false;
+
+	if( (0 != memcmp(header->magic, MAGIC, sizeof(header->magic)))
+		|| (header->version != VERSION)
+		|| (sizeof(Header) + header->capacity > size) )
+	{
+		err = "not a metrics segment";
+	}
+	else
+	{
+		for( int attempt = 0; !ok && (attempt < READ_ATTEMPTS); attempt++ )
+		{
+			uint64_t before = header->sequence.load( std::memory_order_acquire );
+			if( before & 1 )
+			{
+				sched_yield();
+				continue;
+			}
+
+			uint64_t length = header->length.load( std::memory_order_relaxed );
+			if( length <= header->capacity )
+				text.assign( data, length );
+
+			std::atomic_thread_fence( std::memory_order_acquire );
+			ok = (length <= header->capacity)
+				&& (header->sequence.load(std::memory_order_relaxed) == before);
+		}
+		if( !ok )
+			err = "writer too busy";
+	}
+
+	munmap( addr, size );
+	return ok;
+#endif
+}
@@ -0,0 +1,40 @@
+#pragma once
+
+#include <stddef.h>
+
+#include <string>
+
+//===========================================================================
+// MetricsSegment
+//
+// A file mapped into memory holding the most recently published metrics
+// text, so any number of readers can poll a run without talking to it. The
+// writer bumps a sequence number before and after each update (it is odd
+// while the text is being written); a reader retries until it copies the
+// text between two equal, even sequence numbers. Nobody blocks.
+//
+// Not supported on Windows: the writer does nothing and readers fail.
+//===========================================================================
+class MetricsSegment
+{
+ public:
+	static const size_t DefaultCapacity = 256 * 1024;
+
+	MetricsSegment( const std::string &path, size_t capacity = DefaultCapacity );
+	~MetricsSegment();
+
+	// Text beyond capacity is dropped at a line boundary.
+	void publish( const std::string &text );
+
+	// Copies the latest text of the segment at path. On failure, returns
+	// false with a description in err.
+	static bool read( const std::string &path, std::string &text, std::string &err );
+
+ private:
+	struct Header;
+
+	size_t size;
+	Header *header;
+	char *data;
+	bool warnedTruncate;
+};
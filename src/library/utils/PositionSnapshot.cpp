@@ -0,0 +1,64 @@
+#include "PositionSnapshot.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "environment/barrier.h"
+#include "graphics/gobject.h"
+#include "utils/objectxsortedlist.h"
+
+//===========================================================================
+// PositionSnapshot
+//===========================================================================
+
+//---------------------------------------------------------------------------
+// PositionSnapshot::take
+//---------------------------------------------------------------------------
+void PositionSnapshot::take( objectxsortedlist &objects,
+							 bxsortedlist &barriers,
+							 int objTypes )
+{
+	this->objects.clear();
+	this->barriers.clear();
+
+	gobject *o;
+	objects.reset();
+	while( objects.nextObj(objTypes | AGENTTYPE, &o) )
+	{
+		Object entry = { o, o->getType(), o->x(), o->z(), o->radius() };
+		this->objects.push_back( entry );
+	}
+
+	barrier *b;
+	barriers.reset();
+	while( barriers.next(b) )
+		this->barriers.push_back( b );
+}
+
+//---------------------------------------------------------------------------
+// PositionSnapshot::anotherObj
+//---------------------------------------------------------------------------
+const PositionSnapshot::Object *PositionSnapshot::anotherObj( int direction,
+															  int objType,
+															  int &index ) const
+{
+	int step;
+	if( direction == NEXT )
+		step = 1;
+	else if( direction == PREV )
+		step = -1;
+	else
+	{
+		// Error!  Should not get here.
+		printf( "%s: ERROR--Unknown direction (%d)\n", __func__, direction );
+		exit( 1 );
+	}
+
+	for( index += step; (index >= 0) && (index < (int)objects.size()); index += step )
+	{
+		if( objects[index].type & objType )
+			return &objects[index];
+	}
+
+	return NULL;
+}
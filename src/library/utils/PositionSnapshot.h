@@ -0,0 +1,43 @@
+#pragma once
+
+#include <vector>
+
+class barrier;
+class bxsortedlist;
+class gobject;
+class objectxsortedlist;
+
+//===========================================================================
+// PositionSnapshot
+//
+// Read-only copy of the x-sorted object and barrier lists, taken before
+// agent bodies are updated in parallel. Queries walk arrays by index rather
+// than the lists' shared cursors, and see positions as of the snapshot no
+// matter which bodies have already moved.
+//===========================================================================
+class PositionSnapshot
+{
+ public:
+	struct Object
+	{
+		gobject *obj;
+		int type;
+		float x;
+		float z;
+		float radius;
+	};
+
+	// Copies the objects of the given types, in list order. Agents are
+	// always copied, so each has an index to search from.
+	void take( objectxsortedlist &objects,
+			   bxsortedlist &barriers,
+			   int objTypes );
+
+	// Steps index in direction (NEXT or PREV) to the next object of one of
+	// the given types, like objectxsortedlist::anotherObj(). Returns NULL at
+	// the end of the list.
+	const Object *anotherObj( int direction, int objType, int &index ) const;
+
+	std::vector<Object> objects;
+	std::vector<barrier *> barriers;
+};
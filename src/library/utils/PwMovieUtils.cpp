@@ -31,6 +31,12 @@
 #include <sys/stat.h>
 #include <unistd.h>
 
+#if defined(__AVX2__)
+	#include <immintrin.h>
+#elif defined(__SSE2__)
+	#include <emmintrin.h>
+#endif
+
 #include <iostream>
 
 #include "misc.h"
@@ -89,7 +95,7 @@ namespace PwMovieMetaEntry
 //---------------------------------------------------------------------------
 //---------------------------------------------------------------------------
 //---------------------------------------------------------------------------
-PwMovieWriter::PwMovieWriter( FILE *file )
+PwMovieWriter::PwMovieWriter( FILE *file, bool threaded )
 {
 #if __BIG_ENDIAN__
 	fprintf( stderr, "big endian arch not currently supported for movie files.\n" );
@@ -102,6 +108,7 @@ PwMovieWriter::PwMovieWriter( FILE *file )
 	timestep = 1;
 	width = 0;
 	height = 0;
+	keyframeStride = CHECKPOINT_STRIDE;
 	rleBuf = NULL;
 	rleBufSize = 0;
 
@@ -113,6 +120,9 @@ PwMovieWriter::PwMovieWriter( FILE *file )
 	header.offsetMetaEntries = 0;
 
 	writeHeader();
+
+	stopping = false;
+	encoder = threaded ? new std::thread( &PwMovieWriter::encoderLoop, this ) : NULL;
 }
 
 PwMovieWriter::~PwMovieWriter()
@@ -126,6 +136,13 @@ PwMovieWriter::~PwMovieWriter()
 	}
 }
 
+void PwMovieWriter::setKeyframeStride( uint32_t stride )
+{
+	assert( stride > 0 );
+
+	keyframeStride = stride;
+}
+
 void LIBRARY_SHARED PwMovieWriter::writeFrame( uint32_t timestep,
 								uint32_t width,
 								uint32_t height,
@@ -135,6 +152,55 @@ void LIBRARY_SHARED PwMovieWriter::writeFrame( uint32_t timestep,
 	assert( timestep > 0 );
 	assert( (width > 0) && (height > 0) );
 
+	if( !encoder )
+	{
+		encodeFrame( timestep, width, height, rgbBufOld, rgbBufNew );
+		return;
+	}
+
+	size_t npixels = (size_t)width * height;
+	QueuedFrame queued;
+	{
+		std::unique_lock<std::mutex> lock( queueMutex );
+		while( queue.size() >= MaxQueuedFrames )
+			queueChanged.wait( lock );
+
+		if( freeFrames.empty() )
+		{
+			queued.rgbBuf = NULL;
+			queued.capacity = 0;
+		}
+		else
+		{
+			queued = freeFrames.back();
+			freeFrames.pop_back();
+		}
+	}
+
+	if( queued.capacity < npixels )
+	{
+		free( queued.rgbBuf );
+		queued.rgbBuf = (uint32_t *)malloc( npixels * sizeof(uint32_t) );
+		queued.capacity = npixels;
+	}
+	queued.timestep = timestep;
+	queued.width = width;
+	queued.height = height;
+	memcpy( queued.rgbBuf, rgbBufNew, npixels * sizeof(uint32_t) );
+
+	{
+		std::lock_guard<std::mutex> lock( queueMutex );
+		queue.push_back( queued );
+	}
+	queueChanged.notify_all();
+}
+
+void PwMovieWriter::encodeFrame( uint32_t timestep,
+								 uint32_t width,
+								 uint32_t height,
+								 uint32_t *rgbBufOld,
+								 uint32_t *rgbBufNew )
+{
 	frame++;
 
 	bool useDiff = true;
@@ -153,7 +219,7 @@ void LIBRARY_SHARED PwMovieWriter::writeFrame( uint32_t timestep,
 			useDiff = false;
 	}
 
-	if( ((frame - 1) % CHECKPOINT_STRIDE) == 0 )
+	if( ((frame - 1) % keyframeStride) == 0 )
 	{
 		useDiff = false;
 		addCheckpoint();
@@ -171,8 +237,63 @@ void LIBRARY_SHARED PwMovieWriter::writeFrame( uint32_t timestep,
 	}
 }
 
+void PwMovieWriter::encoderLoop()
+{
+	QueuedFrame prev;
+	prev.rgbBuf = NULL;
+
+	std::unique_lock<std::mutex> lock( queueMutex );
+	while( true )
+	{
+		while( queue.empty() && !stopping )
+			queueChanged.wait( lock );
+		if( queue.empty() )
+			break;
+
+		QueuedFrame queued = queue.front();
+		queue.pop_front();
+		lock.unlock();
+
+		encodeFrame( queued.timestep,
+					 queued.width,
+					 queued.height,
+					 prev.rgbBuf,
+					 queued.rgbBuf );
+
+		lock.lock();
+		if( prev.rgbBuf )
+			freeFrames.push_back( prev );
+		prev = queued;
+		queueChanged.notify_all();
+	}
+
+	if( prev.rgbBuf )
+		freeFrames.push_back( prev );
+}
+
+void PwMovieWriter::stopEncoder()
+{
+	if( encoder )
+	{
+		{
+			std::lock_guard<std::mutex> lock( queueMutex );
+			stopping = true;
+		}
+		queueChanged.notify_all();
+		encoder->join();
+		delete encoder;
+		encoder = NULL;
+
+		itfor( std::vector<QueuedFrame>, freeFrames, it )
+			free( it->rgbBuf );
+		freeFrames.clear();
+	}
+}
+
 void PwMovieWriter::close()
 {
+	stopEncoder();
+
 	if( file )
 	{
 		header.frameCount = frame;
@@ -208,9 +329,10 @@ void PwMovieWriter::setDimensions( uint32_t width,
 	this->width = width;
 	this->height = height;
 
+	// Worst case is a keyframe without any runs: a length and a pair per pixel.
 	if( rleBuf ) free( rleBuf );
-	rleBufSize = 1 + width * height * sizeof(*rleBuf);
-	rleBuf = (uint32_t*) malloc( rleBufSize );
+	rleBufSize = 1 + 2 * width * height;
+	rleBuf = (uint32_t*) malloc( rleBufSize * sizeof(*rleBuf) );
 
 	PwMovieMetaEntry::Entry entry;
 	entry.header.type = PwMovieMetaEntry::DIMENSIONS;
@@ -323,7 +445,11 @@ void PwMovieReader::readFrame( uint32_t frame,
 
 	pmpdb( cout << "readFrame(" << frame << ")" << endl );
 
-	if( (this->frame == 0) || (this->frame != frame ) )
+	if( (this->frame > 0) && (this->frame - 1 == frame) )
+	{
+		// Already decoded.
+	}
+	else if( (this->frame == 0) || (this->frame != frame ) )
 	{
 		seekFrame( frame );
 	}
@@ -462,8 +588,9 @@ void PwMovieReader::setDimensions( uint32_t width, uint32_t height )
 	if( rleBuf ) free( rleBuf );
 	if( rgbBuf ) free( rgbBuf );
 
+	// Worst case is a keyframe without any runs: a length and a pair per pixel.
 	uint32_t rgbBufSize = width * height * sizeof(uint32_t);
-	uint32_t rleBufSize = rgbBufSize + 1;
+	uint32_t rleBufSize = (1 + 2 * width * height) * sizeof(uint32_t);
 
 	rleBuf = (uint32_t *)malloc( rleBufSize );
 	rgbBuf = (uint32_t *)malloc( rgbBufSize );
@@ -475,8 +602,14 @@ void PwMovieReader::seekFrame( uint32_t frame )
 														 PwMovieMetaEntry::CHECKPOINT,
 														 true );
 
-	fseeko( file, (off_t)entryCheckpoint->checkpoint->offsetFrame, SEEK_SET );
-	this->frame = entryCheckpoint->header.frame;
+	// Decode forward from where we are unless the keyframe is closer.
+	if( (this->frame == 0)
+		|| (this->frame > frame)
+		|| (entryCheckpoint->header.frame > this->frame) )
+	{
+		fseeko( file, (off_t)entryCheckpoint->checkpoint->offsetFrame, SEEK_SET );
+		this->frame = entryCheckpoint->header.frame;
+	}
 
 	while( this->frame <= frame )
 	{
@@ -568,6 +701,116 @@ void PwMovieReader::nextFrame()
 //---------------------------------------------------------------------------
 //---------------------------------------------------------------------------
 //---------------------------------------------------------------------------
+//---------------------------------------------------------------------------
+// Pixel kernels
+//
+// The encoders spend nearly all of their time finding where runs of pixels
+// end, so these compare 4 (SSE2) pixels at a time, or 8 (AVX2) in a library
+// built with "qmake CONFIG+=avx2".
+//---------------------------------------------------------------------------
+
+// Length of the leading span of pixels for which ((a[i] ^ b[i]) & mask) == 0
+// is the same as 'match'.
+static uint32_t scanPixels( const uint32_t *a,
+							const uint32_t *b,
+							uint32_t n,
+							uint32_t mask,
+							bool match )
+{
+	uint32_t i = 0;
+
+#if defined(__AVX2__)
+	__m256i vmask = _mm256_set1_epi32( (int)mask );
+	__m256i zero = _mm256_setzero_si256();
+	for( ; i + 8 <= n; i += 8 )
+	{
+		__m256i x = _mm256_xor_si256( _mm256_loadu_si256((const __m256i *)(a + i)),
+									  _mm256_loadu_si256((const __m256i *)(b + i)) );
+		int same = _mm256_movemask_ps( _mm256_castsi256_ps(_mm256_cmpeq_epi32(_mm256_and_si256(x, vmask), zero)) );
+		int stop = match ? (~same & 0xff) : same;
+		if( stop )
+			return i + __builtin_ctz( stop );
+	}
+#elif defined(__SSE2__)
+	__m128i vmask = _mm_set1_epi32( (int)mask );
+	__m128i zero = _mm_setzero_si128();
+	for( ; i + 4 <= n; i += 4 )
+	{
+		__m128i x = _mm_xor_si128( _mm_loadu_si128((const __m128i *)(a + i)),
+								   _mm_loadu_si128((const __m128i *)(b + i)) );
+		int same = _mm_movemask_ps( _mm_castsi128_ps(_mm_cmpeq_epi32(_mm_and_si128(x, vmask), zero)) );
+		int stop = match ? (~same & 0xf) : same;
+		if( stop )
+			return i + __builtin_ctz( stop );
+	}
+#endif
+
+	for( ; i < n; i++ )
+	{
+		if( (((a[i] ^ b[i]) & mask) == 0) != match )
+			break;
+	}
+
+	return i;
+}
+
+// Length of the leading span of pixels for which (a[i] & mask) == (value & mask).
+static uint32_t scanRun( const uint32_t *a,
+						 uint32_t n,
+						 uint32_t value,
+						 uint32_t mask )
+{
+	uint32_t i = 0;
+
+#if defined(__AVX2__)
+	__m256i vmask = _mm256_set1_epi32( (int)mask );
+	__m256i vvalue = _mm256_set1_epi32( (int)(value & mask) );
+	for( ; i + 8 <= n; i += 8 )
+	{
+		__m256i x = _mm256_and_si256( _mm256_loadu_si256((const __m256i *)(a + i)), vmask );
+		int same = _mm256_movemask_ps( _mm256_castsi256_ps(_mm256_cmpeq_epi32(x, vvalue)) );
+		if( same != 0xff )
+			return i + __builtin_ctz( ~same );
+	}
+#elif defined(__SSE2__)
+	__m128i vmask = _mm_set1_epi32( (int)mask );
+	__m128i vvalue = _mm_set1_epi32( (int)(value & mask) );
+	for( ; i + 4 <= n; i += 4 )
+	{
+		__m128i x = _mm_and_si128( _mm_loadu_si128((const __m128i *)(a + i)), vmask );
+		int same = _mm_movemask_ps( _mm_castsi128_ps(_mm_cmpeq_epi32(x, vvalue)) );
+		if( same != 0xf )
+			return i + __builtin_ctz( ~same );
+	}
+#endif
+
+	for( ; i < n; i++ )
+	{
+		if( ((a[i] ^ value) & mask) != 0 )
+			break;
+	}
+
+	return i;
+}
+
+static void fillPixels( uint32_t *rgb, uint32_t n, uint32_t value )
+{
+	uint32_t i = 0;
+
+#if defined(__AVX2__)
+	__m256i v = _mm256_set1_epi32( (int)value );
+	for( ; i + 8 <= n; i += 8 )
+		_mm256_storeu_si256( (__m256i *)(rgb + i), v );
+#elif defined(__SSE2__)
+	__m128i v = _mm_set1_epi32( (int)value );
+	for( ; i + 4 <= n; i += 4 )
+		_mm_storeu_si128( (__m128i *)(rgb + i), v );
+#endif
+
+	for( ; i < n; i++ )
+		rgb[i] = value;
+}
+
 void rleproc( uint32_t *rgb,
 			  uint32_t width,
 			  uint32_t height,
@@ -590,10 +833,8 @@ void rleproc( uint32_t *rgb,
 
     while( (rgb < rgbend) && (rle < rleend) )
 	{
-        n = 1;
-        while( (++rgb < rgbend) &&
-			   ((*rgb | AlphaMask_RGBA) == currentrgb) )
-            n++;
+        n = 1 + scanRun( rgb + 1, (uint32_t)(rgbend - rgb - 1), currentrgb, NoAlphaMask_RGBA );
+        rgb += n;
 		pmpPrint( "encoding run of %lu pixels = %08lx\n", n, currentrgb );
         *rle++ = n;
         *rle++ = currentrgb;
@@ -649,8 +890,11 @@ void unrle( uint32_t *rle,
 				after[i] = before[3-i];
 		}
 		pmpPrint( "run of %lu pixels = %08lx\n", len, currentrgb );
-        while( rgb < rgbend )
-           *rgb++ = currentrgb;
+        if( rgb < rgbend )
+        {
+            fillPixels( rgb, (uint32_t)(rgbend - rgb), currentrgb );
+            rgb = rgbend;
+        }
     }
 }
 
@@ -986,28 +1230,17 @@ void rlediff4( uint32_t *rgbnew,
     while( (rgbnew < rgbnewend) && (srle < srleend) )
 	{
         // Look for unchanged pixel runs
-        n = 0;
-        while( (rgbnew < rgbnewend) &&
-			   ((*rgbnew & NoAlphaMask_RGBA) ==
-				(*rgbold & NoAlphaMask_RGBA)) )
-		{
-            rgbnew++;
-            rgbold++;
-            n++;
-            if( n == (1 << 15) )	// have to save now cause we only use shorts
-			{
-				// Note: We encode n-1, to eek out one extra pixel, since a run of zero pixels is not possible
-				pmpPrint( "unchanged run of %4ld (0x%04lx) pixels (0x%08lx) encoded as 0x%04x\n", n, n, *(rgbnew-1), (unsigned short) (n-1) | HIGHBITONSHORT );
-                *srle++ = (unsigned short) (n-1) | HIGHBITONSHORT;
-                len += 1;
-                n = 0;
-            }
-        }
-        if( n > 0 )
+        n = scanPixels( rgbnew, rgbold, (uint32_t)(rgbnewend - rgbnew), NoAlphaMask_RGBA, true );
+        rgbnew += n;
+        rgbold += n;
+        // have to save every 1 << 15 cause we only use shorts
+        while( n > 0 )
 		{
+			uint32_t nsave = n < (1 << 15) ? n : (1 << 15);
+			n -= nsave;
 			// Note: We encode n-1, to eek out one extra pixel, since a run of zero pixels is not possible
-			pmpPrint( "unchanged run of %4ld (0x%04lx) pixels (0x%08lx) encoded as 0x%04x\n", n, n, *(rgbnew-1), (unsigned short) (n-1) | HIGHBITONSHORT );
-            *srle++ = (unsigned short) (n-1) | HIGHBITONSHORT;
+			pmpPrint( "unchanged run of %4ld (0x%04lx) pixels (0x%08lx) encoded as 0x%04x\n", nsave, nsave, *(rgbnew-1), (unsigned short) (nsave-1) | HIGHBITONSHORT );
+            *srle++ = (unsigned short) (nsave-1) | HIGHBITONSHORT;
             len += 1;
         }
 
@@ -1016,15 +1249,9 @@ void rlediff4( uint32_t *rgbnew,
             // First find where they sync up again
             uint32_t *rgbnewtmp;
 
-            rgbnewtmp = rgbnew;
-
-            while( (rgbnewtmp < rgbnewend) &&
-				   ((*rgbnewtmp & NoAlphaMask_RGBA) !=
-					(*rgbold    & NoAlphaMask_RGBA)) )
-			{
-                rgbnewtmp++;
-                rgbold++;
-            }
+            n = scanPixels( rgbnew, rgbold, (uint32_t)(rgbnewend - rgbnew), NoAlphaMask_RGBA, false );
+            rgbnewtmp = rgbnew + n;
+            rgbold += n;
 
             // Now do regular rle until they sync up
             while( (rgbnew < rgbnewtmp) && (srle < srleend) )
@@ -1032,47 +1259,27 @@ void rlediff4( uint32_t *rgbnew,
                 // no -1 is required (even though a long is), because we
                 // computed srleend above so as to leave a long at the end
 
-                currentrgb = *rgbnew++ & NoAlphaMask_RGBA;
+                currentrgb = *rgbnew & NoAlphaMask_RGBA;
 
-                n = 1;
-                while( (rgbnew < rgbnewtmp) &&
-					   ((*rgbnew & NoAlphaMask_RGBA) == currentrgb) )
-				{
-                    rgbnew++;
-                    n++;
-                    if( n == 128 )	// have to save now cause we use 7bits+1
-					{
-						// Note: We encode n-1, to eek out one extra pixel, since a run of zero pixels is not possible
-						pmpPrint( "  changed run of %4ld pixels (0x%08lx) encoded as 0x%04lx.%04lx\n", n, currentrgb, ((n-1) << 8) | (currentrgb & 0x000000ff), (currentrgb >> 8) & 0x0000ffff );
-					#if ABGR
-                        *srle++ = (unsigned short) ( ((n-1) << 8) | (currentrgb >> 16) );
-                        *srle++ = (unsigned short) (currentrgb & 0x0000ffff);
-					#else
-					  #if __BIG_ENDIAN__
-                        *srle++ = (unsigned short) ( ((n-1) << 8) | (currentrgb >> 24) );	// store n & r
-                        *srle++ = (unsigned short) ( (currentrgb >> 8) & 0x0000ffff );		// store g & b
-					  #else
-                        *srle++ = (unsigned short) ( ((n-1) << 8) | (currentrgb & 0x000000ff) );	// store n & r
-                        *srle++ = (unsigned short) ( (currentrgb >> 8) & 0x0000ffff );				// store g & b
-					  #endif
-					#endif
-                        len += 2;
-                        n = 0;
-                    }
-                }
-                if( n > 0 )
+                n = 1 + scanRun( rgbnew + 1, (uint32_t)(rgbnewtmp - rgbnew - 1), currentrgb, NoAlphaMask_RGBA );
+                rgbnew += n;
+
+                // have to save every 128 cause we use 7bits+1
+                while( n > 0 )
 				{
+					uint32_t nsave = n < 128 ? n : 128;
+					n -= nsave;
 					// Note: We encode n-1, to eek out one extra pixel, since a run of zero pixels is not possible
-					pmpPrint( "  changed run of %4ld pixels (0x%08lx) encoded as 0x%04lx.%04lx\n", n, currentrgb, ((n-1) << 8) | (currentrgb & 0x000000ff), (currentrgb >> 8) & 0x0000ffff );
+					pmpPrint( "  changed run of %4ld pixels (0x%08lx) encoded as 0x%04lx.%04lx\n", nsave, currentrgb, ((nsave-1) << 8) | (currentrgb & 0x000000ff), (currentrgb >> 8) & 0x0000ffff );
 				#if ABGR
-					*srle++ = (unsigned short) ( ((n-1) << 8) | (currentrgb >> 16) );
+					*srle++ = (unsigned short) ( ((nsave-1) << 8) | (currentrgb >> 16) );
 					*srle++ = (unsigned short) (currentrgb & 0x0000ffff);
 				#else
 				  #if __BIG_ENDIAN__
-					*srle++ = (unsigned short) ( ((n-1) << 8) | (currentrgb >> 24) );	// store n & r
+					*srle++ = (unsigned short) ( ((nsave-1) << 8) | (currentrgb >> 24) );	// store n & r
 					*srle++ = (unsigned short) ( (currentrgb >> 8) & 0x0000ffff );		// store g & b
 				  #else
-					*srle++ = (unsigned short) ( ((n-1) << 8) | (currentrgb & 0x000000ff) );	// store n & r
+					*srle++ = (unsigned short) ( ((nsave-1) << 8) | (currentrgb & 0x000000ff) );	// store n & r
 					*srle++ = (unsigned short) ( (currentrgb >> 8) & 0x0000ffff );				// store g & b
 				  #endif
 				#endif
@@ -1179,8 +1386,11 @@ void unrlediff4( uint32_t *rle,
 				}
 				pmpPrint( "  changed run of %4d pixels (0x%08lx)\n", n, currentrgb );
                 srle += 2;
-                while( rgb < rgbend )
-                   *rgb++ = currentrgb;
+                if( rgb < rgbend )
+                {
+                    fillPixels( rgb, (uint32_t)(rgbend - rgb), currentrgb );
+                    rgb = rgbend;
+                }
             }
         }
     }
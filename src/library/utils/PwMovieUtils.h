@@ -4,9 +4,14 @@
 #include <stdint.h>
 #include <stdio.h>
 
+#include <condition_variable>
+#include <deque>
 #include <list>
 #include <map>
+#include <mutex>
 #include <string>
+#include <thread>
+#include <vector>
 
 #include "library_global.h"
 
@@ -99,13 +104,24 @@ namespace PwMovieMetaEntry
 
 //===========================================================================
 // PwMovieWriter
+//
+// If threaded, frames are encoded and written by a background thread, and
+// writeFrame() only copies the new frame into a queue of at most
+// MaxQueuedFrames. rgbBufOld is then ignored; each frame is diffed against
+// the frame passed to the previous writeFrame().
 //===========================================================================
 class PwMovieWriter
 {
  public:
-	PwMovieWriter( FILE *file );
+	static const uint32_t MaxQueuedFrames = 4;
+
+	PwMovieWriter( FILE *file, bool threaded = false );
 	~PwMovieWriter();
 
+	// Number of frames between keyframes (CHECKPOINT entries). Only takes
+	// effect if called before the first frame.
+	void setKeyframeStride( uint32_t stride );
+
     void LIBRARY_SHARED writeFrame( uint32_t timestep,
 					 uint32_t width,
 					 uint32_t height,
@@ -115,6 +131,23 @@ class PwMovieWriter
 	void close();
 
  private:
+	struct QueuedFrame
+	{
+		uint32_t timestep;
+		uint32_t width;
+		uint32_t height;
+		uint32_t *rgbBuf;
+		size_t capacity;
+	};
+
+	void encodeFrame( uint32_t timestep,
+					  uint32_t width,
+					  uint32_t height,
+					  uint32_t *rgbBufOld,
+					  uint32_t *rgbBufNew );
+	void encoderLoop();
+	void stopEncoder();
+
 	void writeHeader();
 	void setDimensions( uint32_t width,
 						uint32_t height );
@@ -130,10 +163,18 @@ class PwMovieWriter
 	uint32_t timestep;
 	uint32_t width;
 	uint32_t height;
+	uint32_t keyframeStride;
 	uint32_t *rleBuf;
 	uint32_t rleBufSize;
 	typedef std::list<PwMovieMetaEntry::Entry> EntryList;
 	EntryList metaEntries;
+
+	std::thread *encoder;
+	std::mutex queueMutex;
+	std::condition_variable queueChanged;
+	std::deque<QueuedFrame> queue;
+	std::vector<QueuedFrame> freeFrames;
+	bool stopping;
 };
 
 //===========================================================================
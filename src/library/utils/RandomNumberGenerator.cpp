@@ -6,30 +6,36 @@
 #include <gsl/gsl_rng.h>
 
 #include "misc.h"
+#include "sim/SimulationContext.h"
 
-RandomNumberGenerator::Type RandomNumberGenerator::types[];
-
-namespace __RandomNumberGenerator
+namespace
 {
-	class ModuleInit
+	struct Types
 	{
-	public:
-		ModuleInit()
+		RandomNumberGenerator::Type types[RandomNumberGenerator::__NROLES];
+
+		Types()
 		{
-			RandomNumberGenerator::init();
+			for( int role = 0; role < RandomNumberGenerator::__NROLES; role++ )
+				types[role] = RandomNumberGenerator::GLOBAL;
 		}
-	} init;
+	};
+}
+
+RandomNumberGenerator::Type *RandomNumberGenerator::types()
+{
+	return SimulationContext::current()->get<Types>().types;
 }
 
 void RandomNumberGenerator::set( Role role,
 								 Type type )
 {
-	types[role] = type;
+	types()[role] = type;
 }
 
 RandomNumberGenerator *RandomNumberGenerator::create( Role role )
 {
-	return new RandomNumberGenerator( types[role] );
+	return new RandomNumberGenerator( role, types()[role] );
 }
 
 void RandomNumberGenerator::dispose( RandomNumberGenerator *rng )
@@ -37,19 +43,20 @@ void RandomNumberGenerator::dispose( RandomNumberGenerator *rng )
 	delete rng;
 }
 
-void RandomNumberGenerator::init()
+RandomNumberGenerator::RandomNumberGenerator( Role role,
+											  Type type )
 {
-	for( Role role = (Role)0;
-		 role < __NROLES;
-		 role = (Role)(role + 1) )
+	this->role = role;
+	this->type = type;
+	this->state = NULL;
+	this->stream = NULL;
+
+	if( !RandomStream::isLegacy() )
 	{
-		set( role, GLOBAL );
+		// Until seeded, draw from a stream unique to the role.
+		stream = new RandomStream( RandomStream::SUBSYSTEM, role );
+		return;
 	}
-}
-
-RandomNumberGenerator::RandomNumberGenerator( Type type )
-{
-	this->type = type;
 
 	switch( type )
 	{
@@ -66,6 +73,12 @@ RandomNumberGenerator::RandomNumberGenerator( Type type )
 
 RandomNumberGenerator::~RandomNumberGenerator()
 {
+	if( stream )
+	{
+		delete stream;
+		return;
+	}
+
 	switch( type )
 	{
 	case LOCAL:
@@ -79,6 +92,13 @@ RandomNumberGenerator::~RandomNumberGenerator()
 
 void RandomNumberGenerator::seed( long x )
 {
+	if( stream )
+	{
+		stream->select( RandomStream::SUBSYSTEM,
+						((uint64_t)(role + 1) << 32) | (uint32_t)x );
+		return;
+	}
+
 	switch( type )
 	{
 	case LOCAL:
@@ -95,12 +115,15 @@ void RandomNumberGenerator::seed( long x )
 
 void RandomNumberGenerator::seedIfLocal( long x )
 {
-	if( type == LOCAL )
+	if( stream || (type == LOCAL) )
 		seed( x );
 }
 
 double RandomNumberGenerator::drand()
 {
+	if( stream )
+		return stream->drand();
+
 	switch( type )
 	{
 	case LOCAL:
@@ -114,6 +137,9 @@ double RandomNumberGenerator::drand()
 
 double RandomNumberGenerator::nrand()
 {
+	if( stream )
+		return stream->nrand();
+
 	switch( type )
 	{
 	case LOCAL:
@@ -132,3 +158,15 @@ double RandomNumberGenerator::range( double lo,
 				   lo,
 				   hi );
 }
+
+void RandomNumberGenerator::fill( double *out, size_t n )
+{
+	if( stream )
+	{
+		stream->fill( out, n );
+		return;
+	}
+
+	for( size_t i = 0; i < n; i++ )
+		out[i] = drand();
+}
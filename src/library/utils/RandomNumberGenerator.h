@@ -1,9 +1,6 @@
 #pragma once
 
-namespace __RandomNumberGenerator
-{
-	class ModuleInit;
-}
+#include "RandomStream.h"
 
 class RandomNumberGenerator
 {
@@ -19,6 +16,8 @@ class RandomNumberGenerator
 		__NROLES
 	};
 
+	// Only meaningful in RandomStream::LEGACY mode. In COUNTER mode every
+	// generator is an independent RandomStream keyed by role and seed.
 	enum Type
 	{
 		GLOBAL,
@@ -36,18 +35,15 @@ class RandomNumberGenerator
 	static void dispose( RandomNumberGenerator *rng );
 
  private:
-	friend class __RandomNumberGenerator::ModuleInit;
-
-	static void init();
-
- private:
-	static Type types[__NROLES];
+	// Set per simulation; every role starts out GLOBAL.
+	static Type *types();
 
 	// ---
 	// --- INSTANCE
 	// ---
  private:
-	RandomNumberGenerator( Type type );
+	RandomNumberGenerator( Role role,
+						   Type type );
 	~RandomNumberGenerator();
 
  public:
@@ -57,8 +53,11 @@ class RandomNumberGenerator
 	double nrand();
 	double range( double lo,
 				  double hi );
+	void fill( double *out, size_t n );
 
  private:
+	Role role;
 	Type type;
 	void *state;
+	RandomStream *stream;
 };
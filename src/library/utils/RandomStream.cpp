@@ -0,0 +1,510 @@
+#include "RandomStream.h"
+
+#include <assert.h>
+#include <math.h>
+#include <string.h>
+
+#include "misc.h"
+#include "sim/SimulationContext.h"
+
+// The mode and seed come from each simulation's worldfile.
+namespace
+{
+	struct Settings
+	{
+		RandomStream::Mode mode = RandomStream::LEGACY;
+		unsigned long seed = 0;
+	};
+
+	Settings &settings()
+	{
+		return SimulationContext::current()->get<Settings>();
+	}
+}
+
+#define PHILOX_M0 0xD2511F53
+#define PHILOX_M1 0xCD9E8D57
+#define PHILOX_W0 0x9E3779B9
+#define PHILOX_W1 0xBB67AE85
+#define PHILOX_ROUNDS 10
+
+//---------------------------------------------------------------------------
+// splitmix64
+//
+// Used to spread (seed, domain, id) over the 64 bits of the Philox key.
+//---------------------------------------------------------------------------
+static inline uint64_t splitmix64( uint64_t x )
+{
+	x += 0x9E3779B97F4A7C15ULL;
+	x = (x ^ (x >> 30)) * 0xBF58476D1CE4E5B9ULL;
+	x = (x ^ (x >> 27)) * 0x94D049BB133111EBULL;
+	return x ^ (x >> 31);
+}
+
+static inline double u32pair_to_double( uint32_t a, uint32_t b )
+{
+	// 53 random bits in [0,1)
+	return ((double)(a >> 5) * 67108864.0 + (double)(b >> 6)) * (1.0 / 9007199254740992.0);
+}
+
+static inline float u32_to_float( uint32_t a )
+{
+	// 24 random bits in [0,1)
+	return (float)(a >> 8) * (1.0f / 16777216.0f);
+}
+
+//---------------------------------------------------------------------------
+// RandomStream::setMode
+//---------------------------------------------------------------------------
+void RandomStream::setMode( Mode mode_ )
+{
+	settings().mode = mode_;
+}
+
+//---------------------------------------------------------------------------
+// RandomStream::getMode
+//---------------------------------------------------------------------------
+RandomStream::Mode RandomStream::getMode()
+{
+	return settings().mode;
+}
+
+//---------------------------------------------------------------------------
+// RandomStream::isLegacy
+//---------------------------------------------------------------------------
+bool RandomStream::isLegacy()
+{
+	return getMode() == LEGACY;
+}
+
+//---------------------------------------------------------------------------
+// RandomStream::setSeed
+//---------------------------------------------------------------------------
+void RandomStream::setSeed( unsigned long seed_ )
+{
+	settings().seed = seed_;
+}
+
+//---------------------------------------------------------------------------
+// RandomStream::getSeed
+//---------------------------------------------------------------------------
+unsigned long RandomStream::getSeed()
+{
+	return settings().seed;
+}
+
+//---------------------------------------------------------------------------
+// RandomStream::philox
+//
+// Philox4x32-10 (Salmon et al., "Parallel Random Numbers: As Easy as
+// 1, 2, 3", SC11).
+//---------------------------------------------------------------------------
+void RandomStream::philox( const uint32_t ctr[4],
+						   const uint32_t key[2],
+						   uint32_t out[4] )
+{
+	uint32_t c0 = ctr[0], c1 = ctr[1], c2 = ctr[2], c3 = ctr[3];
+	uint32_t k0 = key[0], k1 = key[1];
+
+	for( int round = 0; round < PHILOX_ROUNDS; round++ )
+	{
+		uint64_t p0 = (uint64_t)PHILOX_M0 * c0;
+		uint64_t p1 = (uint64_t)PHILOX_M1 * c2;
+
+		uint32_t hi0 = (uint32_t)(p0 >> 32), lo0 = (uint32_t)p0;
+		uint32_t hi1 = (uint32_t)(p1 >> 32), lo1 = (uint32_t)p1;
+
+		c0 = hi1 ^ c1 ^ k0;
+		c1 = lo1;
+		c2 = hi0 ^ c3 ^ k1;
+		c3 = lo0;
+
+		k0 += PHILOX_W0;
+		k1 += PHILOX_W1;
+	}
+
+	out[0] = c0;
+	out[1] = c1;
+	out[2] = c2;
+	out[3] = c3;
+}
+
+//---------------------------------------------------------------------------
+// RandomStream::RandomStream
+//---------------------------------------------------------------------------
+RandomStream::RandomStream()
+{
+	select( SIMULATION, 0, 0 );
+}
+
+RandomStream::RandomStream( Domain domain,
+							uint64_t id,
+							uint64_t step )
+{
+	select( domain, id, step );
+}
+
+//---------------------------------------------------------------------------
+// RandomStream::select
+//---------------------------------------------------------------------------
+void RandomStream::select( Domain domain,
+						   uint64_t id,
+						   uint64_t step )
+{
+	assert( domain >= 0 && domain < __NDOMAINS );
+
+	const Settings &current = settings();
+	legacy = current.mode == LEGACY;
+
+	uint64_t k = splitmix64( splitmix64( splitmix64( (uint64_t)current.seed ) ^ (uint64_t)domain ) ^ (uint64_t)id );
+	key[0] = (uint32_t)k;
+	key[1] = (uint32_t)(k >> 32);
+
+	setStep( step );
+}
+
+//---------------------------------------------------------------------------
+// RandomStream::setStep
+//
+// Restarts the draw counter within the current (domain, id) stream.
+//---------------------------------------------------------------------------
+void RandomStream::setStep( uint64_t step )
+{
+	ctr[0] = 0;
+	ctr[1] = 0;
+	ctr[2] = (uint32_t)step;
+	ctr[3] = (uint32_t)((uint64_t)step >> 32);
+
+	bufpos = 4;
+	haveSpare = false;
+}
+
+//---------------------------------------------------------------------------
+// RandomStream::refill
+//---------------------------------------------------------------------------
+inline void RandomStream::refill()
+{
+	philox( ctr, key, buf );
+	if( ++ctr[0] == 0 )
+		++ctr[1];
+	bufpos = 0;
+}
+
+//---------------------------------------------------------------------------
+// RandomStream::next32
+//---------------------------------------------------------------------------
+uint32_t RandomStream::next32()
+{
+	if( legacy )
+		return (uint32_t)(drand48() * 4294967296.0);
+
+	if( bufpos == 4 )
+		refill();
+	return buf[bufpos++];
+}
+
+//---------------------------------------------------------------------------
+// RandomStream::drand
+//---------------------------------------------------------------------------
+double RandomStream::drand()
+{
+	if( legacy )
+		return drand48();
+
+	uint32_t a = next32();
+	uint32_t b = next32();
+	return u32pair_to_double( a, b );
+}
+
+//---------------------------------------------------------------------------
+// RandomStream::frand
+//---------------------------------------------------------------------------
+float RandomStream::frand()
+{
+	if( legacy )
+		return (float)drand48();
+
+	return u32_to_float( next32() );
+}
+
+//---------------------------------------------------------------------------
+// RandomStream::nrand
+//---------------------------------------------------------------------------
+double RandomStream::nrand()
+{
+	if( legacy )
+		return ::nrand();
+
+	if( haveSpare )
+	{
+		haveSpare = false;
+		return spare;
+	}
+
+	// Box-Muller; u1 in (0,1] so the log is finite.
+	double u1 = 1.0 - drand();
+	double u2 = drand();
+	double r = sqrt( -2.0 * log(u1) );
+	double theta = TWOPI * u2;
+
+	spare = r * sin( theta );
+	haveSpare = true;
+
+	return r * cos( theta );
+}
+
+//---------------------------------------------------------------------------
+// RandomStream::range
+//---------------------------------------------------------------------------
+double RandomStream::range( double lo,
+							double hi )
+{
+	return interp( drand(),
+				   lo,
+				   hi );
+}
+
+//---------------------------------------------------------------------------
+// RandomStream::fill
+//
+// Whole Philox blocks are generated straight into the output, with no
+// per-value branching, so the loop is amenable to auto-vectorization.
+//---------------------------------------------------------------------------
+void RandomStream::fill( double *out, size_t n )
+{
+	if( legacy )
+	{
+		for( size_t i = 0; i < n; i++ )
+			out[i] = drand48();
+		return;
+	}
+
+	size_t i = 0;
+
+	// Drain any partially consumed block.
+	while( (i < n) && (bufpos != 4) )
+		out[i++] = drand();
+
+	uint64_t block = ((uint64_t)ctr[1] << 32) | ctr[0];
+	size_t nblocks = (n - i) / 2;
+
+	for( size_t j = 0; j < nblocks; j++ )
+	{
+		uint64_t b = block + j;
+		uint32_t c[4] = { (uint32_t)b, (uint32_t)(b >> 32), ctr[2], ctr[3] };
+		uint32_t r[4];
+		philox( c, key, r );
+		out[i + 2*j] = u32pair_to_double( r[0], r[1] );
+		out[i + 2*j + 1] = u32pair_to_double( r[2], r[3] );
+	}
+	block += nblocks;
+	ctr[0] = (uint32_t)block;
+	ctr[1] = (uint32_t)(block >> 32);
+	i += 2 * nblocks;
+
+	while( i < n )
+		out[i++] = drand();
+}
+
+void RandomStream::fill( float *out, size_t n )
+{
+	if( legacy )
+	{
+		for( size_t i = 0; i < n; i++ )
+			out[i] = (float)drand48();
+		return;
+	}
+
+	size_t i = 0;
+
+	while( (i < n) && (bufpos != 4) )
+		out[i++] = frand();
+
+	uint64_t block = ((uint64_t)ctr[1] << 32) | ctr[0];
+	size_t nblocks = (n - i) / 4;
+
+	for( size_t j = 0; j < nblocks; j++ )
+	{
+		uint64_t b = block + j;
+		uint32_t c[4] = { (uint32_t)b, (uint32_t)(b >> 32), ctr[2], ctr[3] };
+		uint32_t r[4];
+		philox( c, key, r );
+		for( int k = 0; k < 4; k++ )
+			out[i + 4*j + k] = u32_to_float( r[k] );
+	}
+	block += nblocks;
+	ctr[0] = (uint32_t)block;
+	ctr[1] = (uint32_t)(block >> 32);
+	i += 4 * nblocks;
+
+	while( i < n )
+		out[i++] = frand();
+}
+
+//---------------------------------------------------------------------------
+// RandomStream::selfTest
+//---------------------------------------------------------------------------
+#define TEST(NAME, STMT)												\
+	{																	\
+		bool __pass = (STMT);											\
+		if( out ) fprintf( out, "  %-40s %s\n", NAME, __pass ? "ok" : "FAILED" ); \
+		if( !__pass ) pass = false;										\
+	}
+
+bool RandomStream::selfTest( FILE *out )
+{
+	bool pass = true;
+
+	Mode saveMode = getMode();
+	unsigned long saveSeed = getSeed();
+
+	if( out ) fprintf( out, "RandomStream self-test\n" );
+
+	// --- Known-answer vectors from the Random123 distribution.
+	{
+		static const uint32_t kat[3][10] =
+		{
+			{ 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000,
+			  0x6627e8d5, 0xe169c58d, 0xbc57ac4c, 0x9b00dbd8 },
+			{ 0xffffffff, 0xffffffff, 0xffffffff, 0xffffffff, 0xffffffff, 0xffffffff,
+			  0x408f276d, 0x41c83b0e, 0xa20bc7c6, 0x6d5451fd },
+			{ 0x243f6a88, 0x85a308d3, 0x13198a2e, 0x03707344, 0xa4093822, 0x299f31d0,
+			  0xd16cfe09, 0x94fdcceb, 0x5001e420, 0x24126ea1 }
+		};
+
+		bool ok = true;
+		for( int i = 0; i < 3; i++ )
+		{
+			uint32_t r[4];
+			philox( kat[i], kat[i] + 4, r );
+			ok = ok && (memcmp( r, kat[i] + 6, sizeof(r) ) == 0);
+		}
+		TEST( "philox4x32-10 known answers", ok );
+	}
+
+	setMode( COUNTER );
+	setSeed( 42 );
+
+	// --- Same (domain, id, step) reproduces; bulk matches scalar.
+	{
+		RandomStream a( AGENT, 7, 3 ), b( AGENT, 7, 3 );
+		bool ok = true;
+		for( int i = 0; i < 1000; i++ )
+			ok = ok && (a.next32() == b.next32());
+		TEST( "stream reproducibility", ok );
+
+		double bulk[101], scalar[101];
+		a.setStep( 5 );
+		b.setStep( 5 );
+		a.drand();
+		b.drand();
+		a.fill( bulk, 101 );
+		for( int i = 0; i < 101; i++ )
+			scalar[i] = b.drand();
+		TEST( "bulk/scalar equivalence (double)", memcmp(bulk, scalar, sizeof(bulk)) == 0 );
+
+		float fbulk[103], fscalar[103];
+		a.frand();
+		b.frand();
+		a.fill( fbulk, 103 );
+		for( int i = 0; i < 103; i++ )
+			fscalar[i] = b.frand();
+		TEST( "bulk/scalar equivalence (float)", memcmp(fbulk, fscalar, sizeof(fbulk)) == 0 );
+	}
+
+	// --- Uniformity: chi-square over 64 bins, 1M draws. 99.9% critical
+	// --- value for 63 degrees of freedom is ~103.4.
+	{
+		const int NBINS = 64;
+		const int N = 1 << 20;
+		long bins[NBINS] = {0};
+		RandomStream s( SUBSYSTEM, 1 );
+		double sum = 0.0, sum2 = 0.0;
+		for( int i = 0; i < N; i++ )
+		{
+			double x = s.drand();
+			sum += x;
+			sum2 += x * x;
+			bins[ (int)(x * NBINS) ]++;
+		}
+		double expected = (double)N / NBINS;
+		double chi2 = 0.0;
+		for( int i = 0; i < NBINS; i++ )
+			chi2 += (bins[i] - expected) * (bins[i] - expected) / expected;
+		double mean = sum / N;
+		double var = sum2 / N - mean * mean;
+
+		if( out ) fprintf( out, "    chi2=%.2f mean=%.5f var=%.5f\n", chi2, mean, var );
+		TEST( "uniformity (chi-square, 64 bins)", chi2 < 103.4 );
+		TEST( "uniform mean/variance", (fabs(mean - 0.5) < 0.002) && (fabs(var - 1.0/12.0) < 0.001) );
+	}
+
+	// --- Normal deviates.
+	{
+		const int N = 1 << 18;
+		RandomStream s( SUBSYSTEM, 2 );
+		double sum = 0.0, sum2 = 0.0;
+		for( int i = 0; i < N; i++ )
+		{
+			double x = s.nrand();
+			sum += x;
+			sum2 += x * x;
+		}
+		double mean = sum / N;
+		double var = sum2 / N - mean * mean;
+
+		if( out ) fprintf( out, "    nrand mean=%.5f var=%.5f\n", mean, var );
+		TEST( "normal mean/variance", (fabs(mean) < 0.01) && (fabs(var - 1.0) < 0.01) );
+	}
+
+	// --- Neighboring streams must be uncorrelated.
+	{
+		const int N = 1 << 18;
+		bool ok = true;
+		for( int id = 0; id < 8; id++ )
+		{
+			RandomStream a( AGENT, id ), b( AGENT, id + 1 ), c( STEP, id );
+			double sab = 0.0, sac = 0.0;
+			for( int i = 0; i < N; i++ )
+			{
+				double x = a.drand() - 0.5;
+				sab += x * (b.drand() - 0.5);
+				sac += x * (c.drand() - 0.5);
+			}
+			// correlation coefficient; stddev of estimate is ~1/sqrt(N)
+			double rab = sab / N * 12.0;
+			double rac = sac / N * 12.0;
+			ok = ok && (fabs(rab) < 5.0 / sqrt((double)N)) && (fabs(rac) < 5.0 / sqrt((double)N));
+		}
+		TEST( "inter-stream correlation", ok );
+	}
+
+	// --- Legacy mode must be indistinguishable from raw drand48().
+	{
+		setMode( LEGACY );
+
+		const int N = 1000;
+		double expected[N];
+		srand48( 42 );
+		for( int i = 0; i < N; i++ )
+			expected[i] = drand48();
+
+		srand48( 42 );
+		RandomStream s( AGENT, 1 );
+		double actual[N];
+		for( int i = 0; i < N / 2; i++ )
+			actual[i] = s.drand();
+		s.fill( actual + N / 2, N - N / 2 );
+
+		TEST( "legacy drand48 compatibility", memcmp(expected, actual, sizeof(actual)) == 0 );
+	}
+
+	setMode( saveMode );
+	setSeed( saveSeed );
+
+	if( out ) fprintf( out, "%s\n", pass ? "PASSED" : "FAILED" );
+
+	return pass;
+}
+
+#undef TEST
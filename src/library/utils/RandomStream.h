@@ -0,0 +1,95 @@
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdio.h>
+
+//===========================================================================
+// RandomStream
+//
+// Counter-based (Philox4x32-10) random number streams. A stream's output is
+// a pure function of (run seed, domain, id, step, draw index), so streams
+// may be created and consumed from any thread, in any order, and still give
+// results that are independent of scheduling.
+//
+// In LEGACY mode every stream draws from the global drand48() sequence,
+// which reproduces the behavior of old worldfiles.
+//===========================================================================
+class RandomStream
+{
+ public:
+	// ---
+	// --- ENUMS
+	// ---
+	enum Mode
+	{
+		LEGACY,
+		COUNTER
+	};
+
+	enum Domain
+	{
+		SIMULATION = 0,
+		STEP,
+		AGENT,
+		FOOD_PATCH,
+		SUBSYSTEM,
+		__NDOMAINS
+	};
+
+	// ---
+	// --- STATIC
+	// ---
+ public:
+	static void setMode( Mode mode );
+	static Mode getMode();
+	static bool isLegacy();
+
+	static void setSeed( unsigned long seed );
+	static unsigned long getSeed();
+
+	static void philox( const uint32_t ctr[4],
+						const uint32_t key[2],
+						uint32_t out[4] );
+
+	// Known-answer, uniformity, independence and legacy-compatibility
+	// checks. Prints a report to out (if non-NULL) and returns true on pass.
+	static bool selfTest( FILE *out );
+
+	// ---
+	// --- INSTANCE
+	// ---
+ public:
+	RandomStream();
+	RandomStream( Domain domain,
+				  uint64_t id,
+				  uint64_t step = 0 );
+
+	void select( Domain domain,
+				 uint64_t id,
+				 uint64_t step = 0 );
+	void setStep( uint64_t step );
+
+	uint32_t next32();
+	double drand();
+	float frand();
+	double nrand();
+	double range( double lo,
+				  double hi );
+
+	// Bulk generation for hot loops. Consumes the same counters as the
+	// equivalent sequence of scalar drand()/frand() calls would.
+	void fill( double *out, size_t n );
+	void fill( float *out, size_t n );
+
+ private:
+	void refill();
+
+	bool legacy;	// mode when last selected
+	uint32_t key[2];
+	uint32_t ctr[4];
+	uint32_t buf[4];
+	int bufpos;
+	bool haveSpare;
+	double spare;
+};
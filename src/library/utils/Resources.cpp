@@ -1,5 +1,6 @@
 #include "Resources.h"
 
+#include <stdlib.h>
 #include <string.h>
 
 #include "error.h"
@@ -70,5 +71,18 @@ std::string Resources::find( std::string name ) {
 		}
 	}
 
+	// Batch instances run in their own directories; fall back to the
+	// Polyworld home directory.
+	const char *home = getenv( "PW_HOME" );
+	if( home ) {
+		for ( const char **path = RPATH; *path; path++ ) {
+			std::string homepath = std::string( home ) + "/" + *path + name;
+
+			if( exists(homepath) ) {
+				return homepath;
+			}
+		}
+	}
+
 	return "";
 }
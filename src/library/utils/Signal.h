@@ -6,6 +6,7 @@
     #include <tr1/functional>
 #endif
 #include <list>
+#include <stddef.h>
 
 namespace util
 {
@@ -1,9 +1,17 @@
 #include "analysis.h"
 
+#include <algorithm>
+#include <assert.h>
 #include <fstream>
+#include <iostream>
+#include <map>
 #include <math.h>
+#include <mutex>
+#include <sstream>
+#include <stdio.h>
 #include <stdlib.h>
 #include <string>
+#include <thread>
 #include <time.h>
 
 #include "agent/agent.h"
@@ -11,6 +19,7 @@
 #include "brain/NeuronModel.h"
 #include "brain/RqNervousSystem.h"
 #include "genome/Genome.h"
+#include "genome/GenomeArchive.h"
 #include "genome/GenomeSchema.h"
 #include "genome/GenomeUtil.h"
 #include "proplib/builder.h"
@@ -19,6 +28,7 @@
 #include "proplib/schema.h"
 #include "sim/globals.h"
 #include "utils/AbstractFile.h"
+#include "utils/ThreadPool.h"
 #include "utils/datalib.h"
 #include "utils/misc.h"
 
@@ -82,7 +92,7 @@ void analysis::initialize(const std::string& run) {
     schema->lenient = true;
     worldfile = builder.buildWorldfileDocument(schema, run + "/original.wf");
     schema->apply(worldfile);
-    globals::recordFileType = (bool)worldfile->get("CompressFiles") ? AbstractFile::TYPE_GZIP_FILE : AbstractFile::TYPE_FILE;
+    globals::recordFileType() = (bool)worldfile->get("CompressFiles") ? AbstractFile::TYPE_GZIP_FILE : AbstractFile::TYPE_FILE;
     agent::processWorldfile(*worldfile);
     genome::GenomeSchema::processWorldfile(*worldfile);
     Brain::processWorldfile(*worldfile);
@@ -120,9 +130,27 @@ int analysis::getMaxAgent(const std::string& run) {
     return reader.nrows();
 }
 
+genome::GenomeArchive* analysis::getGenomeArchive(const std::string& run) {
+    static std::map<std::string, genome::GenomeArchive*> archives;
+    static std::mutex mutex;
+    std::lock_guard<std::mutex> lock(mutex);
+    auto it = archives.find(run);
+    if (it == archives.end()) {
+        it = archives.insert(std::make_pair(run, genome::GenomeArchive::open(genome::GenomeArchive::getPath(run)))).first;
+    }
+    return it->second;
+}
+
 genome::Genome* analysis::getGenome(const std::string& run, int agent) {
+    genome::GenomeArchive* archive = getGenomeArchive(run);
+    if (archive != NULL && archive->contains(agent)) {
+        genome::Genome* genome = genome::GenomeUtil::createGenome();
+        assert(archive->getGenomeSize() == genome::GenomeUtil::schema()->getMutableSize());
+        genome->load(archive->get(agent));
+        return genome;
+    }
     std::string path = run + "/genome/agents/genome_" + std::to_string(agent) + ".txt";
-    AbstractFile* file = AbstractFile::open(globals::recordFileType, path.c_str(), "r");
+    AbstractFile* file = AbstractFile::open(globals::recordFileType(), path.c_str(), "r");
     genome::Genome* genome = genome::GenomeUtil::createGenome();
     genome->load(file);
     delete file;
@@ -132,7 +160,7 @@ genome::Genome* analysis::getGenome(const std::string& run, int agent) {
 AbstractFile* analysis::getSynapses(const std::string& run, int agent, const std::string& stage) {
     std::string path = run + "/brain/synapses/synapses_" + std::to_string(agent) + "_" + stage + ".txt";
     if (AbstractFile::exists(path.c_str())) {
-        return AbstractFile::open(globals::recordFileType, path.c_str(), "r");
+        return AbstractFile::open(globals::recordFileType(), path.c_str(), "r");
     } else {
         return NULL;
     }
@@ -249,3 +277,112 @@ double analysis::getExpansion(genome::Genome* genome, RqNervousSystem* cns, doub
     // Return overall average
     return distanceSum / perturbation / (repeats * steps);
 }
+
+analysis::DriverOptions::DriverOptions() :
+    threads(0),
+    seed(time(NULL)),
+    checkpoint() { }
+
+bool analysis::tryParseDriverOptions(int& argc, char** argv, DriverOptions& options) {
+    int argj = 1;
+    for (int argi = 1; argi < argc; argi++) {
+        std::string arg(argv[argi]);
+        if (arg != "--threads" && arg != "--seed" && arg != "--checkpoint") {
+            argv[argj++] = argv[argi];
+            continue;
+        }
+        if (argi + 1 >= argc) {
+            return false;
+        }
+        std::string value(argv[++argi]);
+        if (arg == "--threads") {
+            options.threads = atoi(value.c_str());
+            if (options.threads < 1) {
+                return false;
+            }
+        } else if (arg == "--seed") {
+            options.seed = atol(value.c_str());
+        } else {
+            options.checkpoint = value;
+        }
+    }
+    argc = argj;
+    argv[argc] = NULL;
+    return true;
+}
+
+void analysis::printDriverUsage() {
+    std::cerr << "  --threads N        Number of threads (default: all cores)" << std::endl;
+    std::cerr << "  --seed N           Random seed (default: current time)" << std::endl;
+    std::cerr << "  --checkpoint FILE  Record progress in FILE and resume from it" << std::endl;
+}
+
+namespace {
+    long getAgentSeed(long seed, int agent) {
+        unsigned long x = (unsigned long)seed * 0x9e3779b97f4a7c15UL + (unsigned long)agent;
+        x = (x ^ (x >> 30)) * 0xbf58476d1ce4e5b9UL;
+        x = (x ^ (x >> 27)) * 0x94d049bb133111ebUL;
+        return (long)(x ^ (x >> 31));
+    }
+    
+    // The last agent completed, or noProgress if there is no usable checkpoint.
+    int readCheckpoint(const std::string& path, int noProgress) {
+        int agent;
+        std::ifstream in(path);
+        if (!(in >> agent)) {
+            return noProgress;
+        }
+        return agent;
+    }
+    
+    void writeCheckpoint(const std::string& path, int agent) {
+        std::string tmp = path + ".tmp";
+        {
+            std::ofstream out(tmp);
+            out << agent << std::endl;
+        }
+        rename(tmp.c_str(), path.c_str());
+    }
+}
+
+void analysis::forEachAgent(const DriverOptions& options, int first, int last, AgentTask task) {
+    if (!options.checkpoint.empty()) {
+        first = std::max(first, readCheckpoint(options.checkpoint, first - 1) + 1);
+    }
+    unsigned threads = options.threads;
+    if (threads == 0) {
+        threads = std::max(1u, std::thread::hardware_concurrency());
+    }
+    
+    std::mutex mutex;
+    std::map<int, std::string> pending;
+    int next = first;
+    std::streamsize precision = std::cout.precision();
+    
+    // The calling thread works too, while joining.
+    ThreadPool pool(threads - 1);
+    for (int agent = first; agent <= last; agent++) {
+        pool.schedule([&, agent]() {
+            seedThreadRandom(getAgentSeed(options.seed, agent));
+            std::ostringstream out;
+            out.precision(precision);
+            task(agent, out);
+            
+            std::lock_guard<std::mutex> lock(mutex);
+            pending[agent] = out.str();
+            if (agent != next) {
+                return;
+            }
+            while (!pending.empty() && pending.begin()->first == next) {
+                std::cout << pending.begin()->second;
+                pending.erase(pending.begin());
+                next++;
+            }
+            std::cout.flush();
+            if (!options.checkpoint.empty()) {
+                writeCheckpoint(options.checkpoint, next - 1);
+            }
+        });
+    }
+    pool.join();
+}
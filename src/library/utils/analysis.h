@@ -1,9 +1,12 @@
 #pragma once
 
+#include <functional>
+#include <ostream>
 #include <string>
 
 #include "brain/RqNervousSystem.h"
 #include "genome/Genome.h"
+#include "genome/GenomeArchive.h"
 #include "utils/AbstractFile.h"
 
 namespace analysis {
@@ -28,6 +31,8 @@ namespace analysis {
     int getMaxTimestep(const std::string&);
     int getInitAgentCount(const std::string&);
     int getMaxAgent(const std::string&);
+    // Memory-mapped genome archive of the run, or NULL if it has none.
+    genome::GenomeArchive* getGenomeArchive(const std::string&);
     genome::Genome* getGenome(const std::string&, int);
     AbstractFile* getSynapses(const std::string&, int, const std::string&);
     RqNervousSystem* getNervousSystem(genome::Genome*, AbstractFile*);
@@ -35,4 +40,25 @@ namespace analysis {
     RqNervousSystem* copyNervousSystem(genome::Genome*, RqNervousSystem*);
     void setMaxWeight(RqNervousSystem*, AbstractFile*, float);
     double getExpansion(genome::Genome*, RqNervousSystem*, double, int, int, int, int);
+    
+    // Options of forEachAgent(), given on the command line as
+    // --threads N, --seed N and --checkpoint FILE.
+    struct DriverOptions {
+        DriverOptions();
+        int threads;
+        long seed;
+        std::string checkpoint;
+    };
+    
+    // Removes the driver options from argv, adjusting argc.
+    bool tryParseDriverOptions(int&, char**, DriverOptions&);
+    void printDriverUsage();
+    
+    // Runs task(agent, out) for agents first..last on a pool of threads and
+    // writes each agent's output to std::cout in agent order. Every task
+    // starts with randpw()/nrand() seeded from (seed, agent), so results do
+    // not depend on the number of threads. With a checkpoint file, the last
+    // agent written is recorded there and a rerun resumes after it.
+    typedef std::function<void(int, std::ostream&)> AgentTask;
+    void forEachAgent(const DriverOptions&, int, int, AgentTask);
 }
@@ -21,6 +21,12 @@ unsigned short _rand48_mult[3] = {
  };
 unsigned short _rand48_add = RAND48_ADD;
 
+// Set by srand48_thread(); the calling thread then has its own sequence.
+static thread_local bool _rand48_thread = false;
+static thread_local unsigned short _rand48_thread_seed[3];
+// Set by rand48_bind(); state owned by the caller, e.g. a simulation.
+static thread_local unsigned short *_rand48_bound = NULL;
+
 void
  _dorand48(unsigned short xseed[3])
  {
@@ -50,15 +56,34 @@ double erand48(unsigned short xseed[3])
 }
 
 double drand48(){
-    return erand48(_rand48_seed);
+    return erand48(_rand48_thread ? _rand48_thread_seed
+                   : _rand48_bound ? _rand48_bound : _rand48_seed);
 }
 
 void srand48(long seed){
-    _rand48_seed[0] = RAND48_SEED_0;
-    _rand48_seed[1] = (unsigned short)seed;
-    _rand48_seed[2] = (unsigned short)(seed >> 16);
+    unsigned short *state = _rand48_bound ? _rand48_bound : _rand48_seed;
+    state[0] = RAND48_SEED_0;
+    state[1] = (unsigned short)seed;
+    state[2] = (unsigned short)(seed >> 16);
     _rand48_mult[0] = RAND48_MULT_0;
     _rand48_mult[1] = RAND48_MULT_1;
     _rand48_mult[2] = RAND48_MULT_2;
     _rand48_add = RAND48_ADD;
 }
+
+void srand48_thread(long seed){
+    _rand48_thread = true;
+    _rand48_thread_seed[0] = RAND48_SEED_0;
+    _rand48_thread_seed[1] = (unsigned short)seed;
+    _rand48_thread_seed[2] = (unsigned short)(seed >> 16);
+}
+
+void rand48_init(unsigned short state[3]){
+    state[0] = RAND48_SEED_0;
+    state[1] = RAND48_SEED_1;
+    state[2] = RAND48_SEED_2;
+}
+
+void rand48_bind(unsigned short *state){
+    _rand48_bound = state;
+}
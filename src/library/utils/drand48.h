@@ -3,5 +3,13 @@
 
 void srand48(long);
 double drand48();
+// Gives the calling thread its own drand48() sequence from now on.
+void srand48_thread(long);
+// Sets state to the sequence drand48() starts with before any srand48().
+void rand48_init(unsigned short state[3]);
+// Makes drand48()/srand48() on the calling thread use the given state
+// instead of the process-wide one; NULL restores the process-wide state.
+// srand48_thread() still takes precedence.
+void rand48_bind(unsigned short *state);
 
 #endif // DRAND48_H
@@ -40,13 +40,14 @@
 #endif
 
 // https://en.wikipedia.org/wiki/Marsaglia_polar_method
+static thread_local bool nrandSpare = false;
+
 double nrand()
 {
-    static bool spare = false;
-    static double u, v, s, c;
-    if (spare)
+    static thread_local double u, v, s, c;
+    if (nrandSpare)
     {
-        spare = false;
+        nrandSpare = false;
         return c * v;
     }
     do
@@ -56,7 +57,7 @@ double nrand()
         s = u * u + v * v;
     } while (s == 0.0 || s >= 1.0);
     c = sqrt(-2.0 * log(s) / s);
-    spare = true;
+    nrandSpare = true;
     return c * u;
 }
 
@@ -65,6 +66,12 @@ double nrand(double mean, double stdev)
     return mean + nrand() * stdev;
 }
 
+void seedThreadRandom(long seed)
+{
+    srand48_thread(seed);
+    nrandSpare = false;
+}
+
 double trand(double min, double max)
 {
     double range = max - min;
@@ -43,6 +43,8 @@
 #define rrand(lo,hi) (interp(randpw(),(lo),(hi)))
 double nrand();
 double nrand(double mean, double stdev);
+// Gives the calling thread its own randpw()/nrand() sequence.
+void seedThreadRandom(long seed);
 double trand(double min, double max);
 
 #define index2(i,j,nj) ((i)*(nj)+(j))
@@ -11,6 +11,7 @@
 #include "objectxsortedlist.h"
 #include "agent/agent.h"
 #include "library_global.h"
+#include "sim/SimulationContext.h"
 
 #define DebugCounts 0
 
@@ -22,10 +23,13 @@
 
 class objectxsortedlist;
 
-// Globals 
-
-// The big list of all objects (agents, food, bricks, etc.)
-objectxsortedlist LIBRARY_SHARED objectxsortedlist::gXSortedObjects;
+//---------------------------------------------------------------------------
+// objectxsortedlist::gXSortedObjects
+//---------------------------------------------------------------------------
+objectxsortedlist &objectxsortedlist::gXSortedObjects()
+{
+	return SimulationContext::current()->xsortedObjects;
+}
 
 //---------------------------------------------------------------------------
 // objectxsortedlist::getCount
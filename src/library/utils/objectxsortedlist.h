@@ -47,11 +47,12 @@ class objectxsortedlist : public gdlist<gobject*>
     void toMark( int objType );
     void getMark( int objType, gobject* gob );
 
-    static LIBRARY_SHARED objectxsortedlist gXSortedObjects;
+    // The big list of all objects of the current simulation.
+    static LIBRARY_SHARED objectxsortedlist &gXSortedObjects();
 };
 
 #define xfor( TYPE, VARTYPE, VAR )										\
-	objectxsortedlist::gXSortedObjects.reset();							\
-	for( VARTYPE *VAR; objectxsortedlist::gXSortedObjects.nextObj(TYPE, (gobject**)&VAR); ) \
+	objectxsortedlist::gXSortedObjects().reset();							\
+	for( VARTYPE *VAR; objectxsortedlist::gXSortedObjects().nextObj(TYPE, (gobject**)&VAR); ) \
 
 #endif
@@ -0,0 +1,137 @@
+// This program measures the accuracy of the FAST Activation functions against
+// libm, checks that the scalar and batch paths agree, and compares throughput
+// of the EXACT and FAST batch functions.
+
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <chrono>
+#include <vector>
+
+#include "utils/Activation.h"
+
+#define SWEEP_LO -88.0
+#define SWEEP_HI 88.0
+#define SWEEP_STEP 1e-4
+#define THROUGHPUT_N (1 << 16)
+#define THROUGHPUT_REPEATS 200
+
+struct ErrorStats
+{
+	double maxAbs;
+	double maxRel;
+	double worstX;
+	long mismatches;
+};
+
+typedef float (*ScalarFn)( float );
+typedef void (*BatchFn)( float *, size_t );
+typedef double (*ReferenceFn)( double );
+
+static double refExp( double x ) { return exp( x ); }
+static double refLogistic( double x ) { return 1.0 / (1.0 + exp(-x)); }
+static double refTanh( double x ) { return tanh( x ); }
+
+static ErrorStats measure( ScalarFn scalar, BatchFn batch, ReferenceFn reference, double lo, double hi )
+{
+	ErrorStats stats = { 0.0, 0.0, 0.0, 0 };
+	long n = (long)((hi - lo) / SWEEP_STEP) + 1;
+	std::vector<float> x( n );
+	for( long i = 0; i < n; i++ )
+		x[i] = (float)(lo + i * SWEEP_STEP);
+
+	std::vector<float> y( x );
+	batch( y.data(), n );
+
+	for( long i = 0; i < n; i++ )
+	{
+		float s = scalar( x[i] );
+		if( memcmp(&s, &y[i], sizeof(float)) != 0 )
+			stats.mismatches++;
+
+		double ref = reference( x[i] );
+		double abserr = fabs( (double)y[i] - ref );
+		double relerr = ref != 0.0 ? abserr / fabs(ref) : abserr;
+		if( abserr > stats.maxAbs )
+		{
+			stats.maxAbs = abserr;
+			stats.worstX = x[i];
+		}
+		if( relerr > stats.maxRel )
+			stats.maxRel = relerr;
+	}
+
+	return stats;
+}
+
+static bool report( const char *name, ErrorStats stats, double bound, bool relative )
+{
+	double err = relative ? stats.maxRel : stats.maxAbs;
+	bool pass = (err <= bound) && (stats.mismatches == 0);
+	printf( "%-9s maxabs = %.3e  maxrel = %.3e  (worst x = %g)  bound = %.1e %s  scalar/batch mismatches = %ld  %s\n",
+			name, stats.maxAbs, stats.maxRel, stats.worstX,
+			bound, relative ? "rel" : "abs",
+			stats.mismatches,
+			pass ? "PASS" : "FAIL" );
+	return pass;
+}
+
+template<typename T>
+static double timeBatch( Activation::Mode mode, void (*fn)(T *, size_t) )
+{
+	Activation::setMode( mode );
+
+	std::vector<T> source( THROUGHPUT_N );
+	for( int i = 0; i < THROUGHPUT_N; i++ )
+		source[i] = (T)(-8.0 + 16.0 * i / THROUGHPUT_N);
+	std::vector<T> work( THROUGHPUT_N );
+
+	auto start = std::chrono::steady_clock::now();
+	for( int r = 0; r < THROUGHPUT_REPEATS; r++ )
+	{
+		memcpy( work.data(), source.data(), THROUGHPUT_N * sizeof(T) );
+		fn( work.data(), THROUGHPUT_N );
+	}
+	auto end = std::chrono::steady_clock::now();
+
+	double seconds = std::chrono::duration<double>( end - start ).count();
+	return (double)THROUGHPUT_N * THROUGHPUT_REPEATS / seconds / 1e6;
+}
+
+int main( int argc, char** argv )
+{
+	bool pass = true;
+
+	printf( "isa = %s\n", Activation::isa() );
+	printf( "\n--- accuracy over [%g, %g], step %g ---\n", SWEEP_LO, SWEEP_HI, SWEEP_STEP );
+
+	pass &= report( "exp",
+					measure(Activation::fastExp, Activation::fastExp, refExp, SWEEP_LO, SWEEP_HI),
+					Activation::MaxExpRelError, true );
+	pass &= report( "logistic",
+					measure(Activation::fastLogistic, Activation::fastLogistic, refLogistic, SWEEP_LO, SWEEP_HI),
+					Activation::MaxLogisticAbsError, false );
+	pass &= report( "tanh",
+					measure(Activation::fastTanh, Activation::fastTanh, refTanh, SWEEP_LO / 2, SWEEP_HI / 2),
+					Activation::MaxTanhAbsError, false );
+
+	void (*logisticDouble)( double *, size_t ) = Activation::logistic;
+	void (*logisticFloat)( float *, size_t ) = Activation::logistic;
+	void (*tanhDouble)( double *, size_t ) = Activation::tanh;
+	void (*tanhFloat)( float *, size_t ) = Activation::tanh;
+
+	printf( "\n--- throughput (million values/s) ---\n" );
+	printf( "%-18s %10s %10s %8s\n", "", "exact", "fast", "speedup" );
+
+	struct { const char *name; double exact; double fast; } rows[] = {
+		{ "logistic double", timeBatch(Activation::EXACT, logisticDouble), timeBatch(Activation::FAST, logisticDouble) },
+		{ "logistic float", timeBatch(Activation::EXACT, logisticFloat), timeBatch(Activation::FAST, logisticFloat) },
+		{ "tanh double", timeBatch(Activation::EXACT, tanhDouble), timeBatch(Activation::FAST, tanhDouble) },
+		{ "tanh float", timeBatch(Activation::EXACT, tanhFloat), timeBatch(Activation::FAST, tanhFloat) }
+	};
+	for( size_t i = 0; i < sizeof(rows) / sizeof(rows[0]); i++ )
+		printf( "%-18s %10.1f %10.1f %7.2fx\n", rows[i].name, rows[i].exact, rows[i].fast, rows[i].fast / rows[i].exact );
+
+	return pass ? 0 : 1;
+}
@@ -1,4 +1,5 @@
 #include <iostream>
+#include <ostream>
 #include <stdio.h>
 #include <stdlib.h>
 #include <string>
@@ -26,10 +27,12 @@ struct Args {
 void printUsage(int, char**);
 bool tryParseArgs(int, char**, Args&);
 void printArgs(const Args&);
+void processWeight(const Args&, int, std::ostream&);
 
 int main(int argc, char** argv) {
     Args args;
-    if (!tryParseArgs(argc, argv, args)) {
+    analysis::DriverOptions options;
+    if (!analysis::tryParseDriverOptions(argc, argv, options) || !tryParseArgs(argc, argv, args)) {
         printUsage(argc, argv);
         return 1;
     }
@@ -39,43 +42,50 @@ int main(int argc, char** argv) {
     if (synapses == NULL) {
         return 0;
     }
+    delete synapses;
+    // Each maximum weight is independent, so they are the driver's work items.
+    analysis::forEachAgent(options, 0, args.wmaxCount - 1, [&args](int index, std::ostream& out) {
+        processWeight(args, index, out);
+    });
+    return 0;
+}
+
+void processWeight(const Args& args, int index, std::ostream& out) {
+    AbstractFile* synapses = analysis::getSynapses(args.run, args.agent, args.stage);
     genome::Genome* genome = analysis::getGenome(args.run, args.agent);
     RqNervousSystem* cns = analysis::getNervousSystem(genome, synapses);
     delete genome;
     cns->getBrain()->freeze();
     NeuronModel::Dimensions dims = cns->getBrain()->getDimensions();
     double* activations = new double[dims.numOutputNeurons];
-    for (int index = 0; index < args.wmaxCount; index++) {
-        float wmax = interp((float)index / (args.wmaxCount - 1), args.wmaxMin, args.wmaxMax);
-        synapses->seek(0, SEEK_SET);
-        analysis::setMaxWeight(cns, synapses, wmax);
-        cns->getBrain()->randomizeActivations();
-        cns->setMode(RqNervousSystem::RANDOM);
-        for (int step = 1; step <= args.random; step++) {
-            cns->update(false);
-        }
-        cns->setMode(RqNervousSystem::QUIESCENT);
-        for (int step = 1; step <= args.quiescent; step++) {
-            cns->update(false);
-        }
-        for (int step = 1; step <= args.steps; step++) {
-            cns->update(false);
-            cns->getBrain()->getActivations(activations, dims.getFirstOutputNeuron(), dims.numOutputNeurons);
-            std::cout << wmax;
-            for (int neuron = 0; neuron < dims.numOutputNeurons; neuron++) {
-                std::cout << " " << activations[neuron];
-            }
-            std::cout << std::endl;
+    float wmax = interp((float)index / (args.wmaxCount - 1), args.wmaxMin, args.wmaxMax);
+    synapses->seek(0, SEEK_SET);
+    analysis::setMaxWeight(cns, synapses, wmax);
+    cns->getBrain()->randomizeActivations();
+    cns->setMode(RqNervousSystem::RANDOM);
+    for (int step = 1; step <= args.random; step++) {
+        cns->update(false);
+    }
+    cns->setMode(RqNervousSystem::QUIESCENT);
+    for (int step = 1; step <= args.quiescent; step++) {
+        cns->update(false);
+    }
+    for (int step = 1; step <= args.steps; step++) {
+        cns->update(false);
+        cns->getBrain()->getActivations(activations, dims.getFirstOutputNeuron(), dims.numOutputNeurons);
+        out << wmax;
+        for (int neuron = 0; neuron < dims.numOutputNeurons; neuron++) {
+            out << " " << activations[neuron];
         }
+        out << std::endl;
     }
     delete[] activations;
     delete cns;
     delete synapses;
-    return 0;
 }
 
 void printUsage(int argc, char** argv) {
-    std::cerr << "Usage: " << argv[0] << " RUN STAGE WMAX_MIN WMAX_MAX WMAX_COUNT RANDOM QUIESCENT STEPS AGENT" << std::endl;
+    std::cerr << "Usage: " << argv[0] << " [OPTIONS] RUN STAGE WMAX_MIN WMAX_MAX WMAX_COUNT RANDOM QUIESCENT STEPS AGENT" << std::endl;
     std::cerr << std::endl;
     std::cerr << "Generates data for bifurcation diagrams." << std::endl;
     std::cerr << std::endl;
@@ -88,6 +98,8 @@ void printUsage(int argc, char** argv) {
     std::cerr << "  QUIESCENT   Number of quiescent timesteps" << std::endl;
     std::cerr << "  STEPS       Number of output timesteps" << std::endl;
     std::cerr << "  AGENT       Agent index" << std::endl;
+    std::cerr << std::endl;
+    analysis::printDriverUsage();
 }
 
 bool tryParseArgs(int argc, char** argv, Args& args) {
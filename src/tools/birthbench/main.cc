@@ -0,0 +1,199 @@
+#include <chrono>
+#include <iostream>
+#include <stdlib.h>
+#include <string>
+#include <string.h>
+#include <vector>
+
+#include "agent/agent.h"
+#include "brain/Brain.h"
+#include "brain/RqNervousSystem.h"
+#include "genome/Genome.h"
+#include "genome/GenomeSchema.h"
+#include "genome/GenomeUtil.h"
+#include "proplib/builder.h"
+#include "proplib/dom.h"
+#include "proplib/interpreter.h"
+#include "proplib/schema.h"
+#include "utils/misc.h"
+
+struct Args {
+    std::string worldfile;
+    int births;
+    int population;
+    long seed;
+};
+
+enum Mode {
+    BY_NAME,
+    RAW,
+    DECODED
+};
+
+struct Result {
+    double seconds;
+    double growSeconds;
+    std::vector<long> brains;
+    std::vector<float> genes;
+};
+
+void printUsage(int, char**);
+bool tryParseArgs(int, char**, Args&);
+void initialize(const std::string&);
+Result run(const Args&, Mode);
+void readGenes(genome::Genome*, Mode, std::vector<float>&);
+void printResult(const char*, const Args&, const Result&);
+
+int main(int argc, char** argv) {
+    Args args;
+    if (!tryParseArgs(argc, argv, args)) {
+        printUsage(argc, argv);
+        return 1;
+    }
+    initialize(args.worldfile);
+
+    Result byName = run(args, BY_NAME);
+    Result raw = run(args, RAW);
+    Result decoded = run(args, DECODED);
+
+    std::cout << "worldfile = " << args.worldfile << std::endl;
+    std::cout << "births = " << args.births << std::endl;
+    std::cout << "population = " << args.population << std::endl;
+    printResult("byname", args, byName);
+    printResult("raw", args, raw);
+    printResult("decoded", args, decoded);
+    std::cout << "speedup = " << (raw.seconds / decoded.seconds) << std::endl;
+    std::cout << "grow speedup = " << (raw.growSeconds / decoded.growSeconds) << std::endl;
+    std::cout << "byname speedup = " << (byName.seconds / decoded.seconds) << std::endl;
+    bool identical = byName.brains == decoded.brains && byName.genes == decoded.genes
+        && raw.brains == decoded.brains && raw.genes == decoded.genes;
+    std::cout << "identical = " << (identical ? "True" : "False") << std::endl;
+    return identical ? 0 : 2;
+}
+
+void printResult(const char* name, const Args& args, const Result& result) {
+    std::cout << name << " = " << result.seconds << " s (" << (args.births / result.seconds) << " births/s, "
+              << (1e6 * result.growSeconds / args.births) << " us/grow)" << std::endl;
+}
+
+void printUsage(int argc, char** argv) {
+    std::cerr << "Usage: " << argv[0] << " [--births N] [--population N] [--seed N] WORLDFILE" << std::endl;
+    std::cerr << std::endl;
+    std::cerr << "Times the genome side of births from WORLDFILE: crossover and mutation of two" << std::endl;
+    std::cerr << "random parents, then growing the child's brain (GroupsBrain::grow for groups" << std::endl;
+    std::cerr << "worldfiles) and reading the genes an agent reads at birth. Each birth is run" << std::endl;
+    std::cerr << "three times: with genes looked up by name and read raw, with gene handles read" << std::endl;
+    std::cerr << "raw, and with gene handles and the genome decoded first, as agent::setGenomeReady()" << std::endl;
+    std::cerr << "does. All three must read the same genes and grow the same brains. Must be run" << std::endl;
+    std::cerr << "from the Polyworld home directory. For example:" << std::endl;
+    std::cerr << std::endl;
+    std::cerr << "  for wf in worldfiles/tests/low-spec-pc/*.wf; do " << argv[0] << " $wf; done" << std::endl;
+    std::cerr << std::endl;
+    std::cerr << "  --births N       Number of births (default 1000)" << std::endl;
+    std::cerr << "  --population N   Number of parent genomes (default 100)" << std::endl;
+    std::cerr << "  --seed N         Random seed for genomes and mating (default 42)" << std::endl;
+}
+
+bool tryParseArgs(int argc, char** argv, Args& args) {
+    args.births = 1000;
+    args.population = 100;
+    args.seed = 42;
+    int argi = 1;
+    while (argi < argc - 1) {
+        if (strcmp(argv[argi], "--births") == 0) {
+            args.births = atoi(argv[argi + 1]);
+        } else if (strcmp(argv[argi], "--population") == 0) {
+            args.population = atoi(argv[argi + 1]);
+        } else if (strcmp(argv[argi], "--seed") == 0) {
+            args.seed = atol(argv[argi + 1]);
+        } else {
+            return false;
+        }
+        argi += 2;
+    }
+    if (argi != argc - 1 || args.births < 1 || args.population < 2) {
+        return false;
+    }
+    args.worldfile = argv[argi];
+    return exists(args.worldfile);
+}
+
+void initialize(const std::string& path) {
+    proplib::Interpreter::init();
+    proplib::DocumentBuilder builder;
+    proplib::SchemaDocument* schema = builder.buildSchemaDocument("etc/worldfile.wfs");
+    proplib::Document* worldfile = builder.buildWorldfileDocument(schema, path);
+    schema->apply(worldfile);
+    agent::processWorldfile(*worldfile);
+    genome::GenomeSchema::processWorldfile(*worldfile);
+    Brain::processWorldfile(*worldfile);
+    proplib::Interpreter::dispose();
+    delete worldfile;
+    delete schema;
+    Brain::init();
+    genome::GenomeUtil::createSchema();
+}
+
+Result run(const Args& args, Mode mode) {
+    // Identical parents and matings for all modes.
+    srand48(args.seed);
+    std::vector<genome::Genome*> parents;
+    for (int index = 0; index < args.population; index++) {
+        parents.push_back(genome::GenomeUtil::createGenome(true));
+    }
+    // Reused, as a recycled agent's genome is.
+    genome::Genome* child = genome::GenomeUtil::createGenome();
+
+    Result result;
+    result.growSeconds = 0.0;
+    auto start = std::chrono::steady_clock::now();
+    for (int birth = 0; birth < args.births; birth++) {
+        int i = (int)(drand48() * args.population);
+        int j = (int)(drand48() * (args.population - 1));
+        if (j >= i) {
+            j++;
+        }
+        child->crossover(parents[i], parents[j], true);
+        if (mode == DECODED) {
+            child->decode();
+        }
+        readGenes(child, mode, result.genes);
+
+        auto growStart = std::chrono::steady_clock::now();
+        RqNervousSystem* cns = new RqNervousSystem();
+        cns->grow(child);
+        auto growEnd = std::chrono::steady_clock::now();
+        result.growSeconds += std::chrono::duration<double>(growEnd - growStart).count();
+
+        result.brains.push_back(cns->getBrain()->getNumNeurons());
+        result.brains.push_back(cns->getBrain()->getNumSynapses());
+        delete cns;
+    }
+    auto end = std::chrono::steady_clock::now();
+    result.seconds = std::chrono::duration<double>(end - start).count();
+
+    delete child;
+    for (genome::Genome* parent : parents) {
+        delete parent;
+    }
+    return result;
+}
+
+// The genes agent::grow() and agent::setGenomeReady() read, in their order.
+void readGenes(genome::Genome* genome, Mode mode, std::vector<float>& genes) {
+    if (mode == BY_NAME) {
+        genes.push_back(genome->get("ID"));
+        genes.push_back(genome->get("MaxSpeed"));
+        genes.push_back(genome->get("Strength"));
+        genes.push_back(genome->get("Size"));
+        genes.push_back(genome->get("MateEnergyFraction"));
+        genes.push_back(genome->get("MutationRate"));
+    } else {
+        genes.push_back(genome->get(genome->ID));
+        genes.push_back(genome->get(genome->MAX_SPEED));
+        genes.push_back(genome->get(genome->STRENGTH));
+        genes.push_back(genome->get(genome->SIZE));
+        genes.push_back(genome->get(genome->MATE_ENERGY_FRACTION));
+        genes.push_back(genome->get(genome->MUTATION_RATE));
+    }
+}
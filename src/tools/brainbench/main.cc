@@ -0,0 +1,161 @@
+#include <chrono>
+#include <iostream>
+#include <stdlib.h>
+#include <string>
+#include <string.h>
+#include <vector>
+
+#include "agent/agent.h"
+#include "brain/Brain.h"
+#include "brain/FiringRateModel.h"
+#include "brain/RqNervousSystem.h"
+#include "genome/Genome.h"
+#include "genome/GenomeSchema.h"
+#include "genome/GenomeUtil.h"
+#include "proplib/builder.h"
+#include "proplib/dom.h"
+#include "proplib/interpreter.h"
+#include "proplib/schema.h"
+#include "utils/Activation.h"
+#include "utils/misc.h"
+#include "utils/RandomNumberGenerator.h"
+
+struct Args {
+    std::string worldfile;
+    int agents;
+    int steps;
+    long seed;
+};
+
+struct Result {
+    double seconds;
+    std::vector<double> activations;
+};
+
+void printUsage(int, char**);
+bool tryParseArgs(int, char**, Args&);
+void initialize(const std::string&);
+Result run(const Args&, bool);
+
+int main(int argc, char** argv) {
+    Args args;
+    if (!tryParseArgs(argc, argv, args)) {
+        printUsage(argc, argv);
+        return 1;
+    }
+    initialize(args.worldfile);
+    if (Brain::config().neuronModel == Brain::Configuration::SPIKING) {
+        std::cerr << args.worldfile << ": spiking model has no specialized kernels" << std::endl;
+        return 1;
+    }
+
+    Result generic = run(args, false);
+    Result specialized = run(args, true);
+
+    long updates = (long)args.agents * args.steps;
+    std::cout << "worldfile = " << args.worldfile << std::endl;
+    std::cout << "neuronModel = " << (Brain::config().neuronModel == Brain::Configuration::TAU_GAIN ? "T" : "F") << std::endl;
+    std::cout << "learning = " << (Brain::config().enableLearning ? "True" : "False") << std::endl;
+    std::cout << "activation = " << (Brain::config().fastActivation ? "Fast" : "Exact") << " (" << Activation::isa() << ")" << std::endl;
+    std::cout << "storage = " << (Brain::config().compactStorage ? "Compact" : "Standard") << std::endl;
+    std::cout << "agents = " << args.agents << std::endl;
+    std::cout << "steps = " << args.steps << std::endl;
+    std::cout << "generic = " << generic.seconds << " s (" << (updates / generic.seconds) << " updates/s)" << std::endl;
+    std::cout << "specialized = " << specialized.seconds << " s (" << (updates / specialized.seconds) << " updates/s)" << std::endl;
+    std::cout << "speedup = " << (generic.seconds / specialized.seconds) << std::endl;
+    bool identical = generic.activations == specialized.activations;
+    std::cout << "identical = " << (identical ? "True" : "False") << std::endl;
+    return identical ? 0 : 2;
+}
+
+void printUsage(int argc, char** argv) {
+    std::cerr << "Usage: " << argv[0] << " [--agents N] [--steps N] [--seed N] WORLDFILE" << std::endl;
+    std::cerr << std::endl;
+    std::cerr << "Times brain updates of random genomes grown from WORLDFILE using the generic" << std::endl;
+    std::cerr << "and the specialized FiringRateModel kernels, and checks that both agree." << std::endl;
+    std::cerr << "Must be run from the Polyworld home directory. For example:" << std::endl;
+    std::cerr << std::endl;
+    std::cerr << "  for wf in worldfiles/tests/low-spec-pc/*.wf; do " << argv[0] << " $wf; done" << std::endl;
+    std::cerr << std::endl;
+    std::cerr << "  --agents N   Number of brains (default 300)" << std::endl;
+    std::cerr << "  --steps N    Updates per brain (default 1000)" << std::endl;
+    std::cerr << "  --seed N     Random seed for genomes and inputs (default 42)" << std::endl;
+}
+
+bool tryParseArgs(int argc, char** argv, Args& args) {
+    args.agents = 300;
+    args.steps = 1000;
+    args.seed = 42;
+    int argi = 1;
+    while (argi < argc - 1) {
+        if (strcmp(argv[argi], "--agents") == 0) {
+            args.agents = atoi(argv[argi + 1]);
+        } else if (strcmp(argv[argi], "--steps") == 0) {
+            args.steps = atoi(argv[argi + 1]);
+        } else if (strcmp(argv[argi], "--seed") == 0) {
+            args.seed = atol(argv[argi + 1]);
+        } else {
+            return false;
+        }
+        argi += 2;
+    }
+    if (argi != argc - 1 || args.agents < 1 || args.steps < 1) {
+        return false;
+    }
+    args.worldfile = argv[argi];
+    return exists(args.worldfile);
+}
+
+void initialize(const std::string& path) {
+    proplib::Interpreter::init();
+    proplib::DocumentBuilder builder;
+    proplib::SchemaDocument* schema = builder.buildSchemaDocument("etc/worldfile.wfs");
+    proplib::Document* worldfile = builder.buildWorldfileDocument(schema, path);
+    schema->apply(worldfile);
+    agent::processWorldfile(*worldfile);
+    genome::GenomeSchema::processWorldfile(*worldfile);
+    Brain::processWorldfile(*worldfile);
+    proplib::Interpreter::dispose();
+    delete worldfile;
+    delete schema;
+    Brain::init();
+    genome::GenomeUtil::createSchema();
+}
+
+Result run(const Args& args, bool specialized) {
+    FiringRateModel::useSpecializedKernels() = specialized;
+    FiringRateModel::selectUpdateKernels();
+
+    // Identical genomes, synapses and inputs for both kernels.
+    srand48(args.seed);
+    std::vector<RqNervousSystem*> brains;
+    for (int index = 0; index < args.agents; index++) {
+        genome::Genome* genome = genome::GenomeUtil::createGenome(true);
+        RqNervousSystem* cns = new RqNervousSystem();
+        cns->grow(genome);
+        cns->getRNG()->seed(index + 1);
+        cns->setMode(RqNervousSystem::RANDOM);
+        delete genome;
+        brains.push_back(cns);
+    }
+
+    Result result;
+    auto start = std::chrono::steady_clock::now();
+    for (int step = 0; step < args.steps; step++) {
+        for (RqNervousSystem* cns : brains) {
+            cns->update(false);
+        }
+    }
+    auto end = std::chrono::steady_clock::now();
+    result.seconds = std::chrono::duration<double>(end - start).count();
+
+    for (RqNervousSystem* cns : brains) {
+        Brain* brain = cns->getBrain();
+        int count = brain->getNumNeurons();
+        std::vector<double> activations(count);
+        brain->getActivations(activations.data(), 0, count);
+        result.activations.insert(result.activations.end(), activations.begin(), activations.end());
+        delete cns;
+    }
+    return result;
+}
@@ -4,7 +4,9 @@
 #include <assert.h>
 #include <dirent.h>
 #include <errno.h>
+#include <fcntl.h>
 #include <getopt.h>
+#include <stdint.h>
 #include <stdio.h>
 #include <stdlib.h>
 #include <math.h>
@@ -12,6 +14,7 @@
 #include "readline.h"
 #include <unistd.h>
 #include <zlib.h>
+#include <sys/mman.h>
 #include <sys/stat.h>
 #include <sys/time.h>
 #include <sys/types.h>
@@ -101,7 +104,9 @@ struct CliParms {
 	float threshFact;
 	int genomeCacheCapacity;
 	int clusterStrideDivisor;
+	int candidateCacheMegabytes;
 	int neighborCandidateStride;
+	bool halfPrecisionDistances;
 	enum {
 		NA_MEASURE_MEMBERS,
 		NA_CLUSTER
@@ -116,7 +121,9 @@ struct CliParms {
 		threshFact = 2.125;
 		genomeCacheCapacity = -1;
 		clusterStrideDivisor = -1;
+		candidateCacheMegabytes = 256;
 		neighborCandidateStride = 1;
+		halfPrecisionDistances = false;
 		neighborAlgorithm = NA_MEASURE_MEMBERS;
 		neighborAlgorithmName = "measureMembers";
 		path_run = "./run";
@@ -170,13 +177,15 @@ int main(int argc, char *argv[]) {
 				{"clusterStrideDivisor", 1, 0, 'd'},
 				{"threshFact", 1, 0, 'f'},
 				{"genomeCacheCapacity", 1, 0, 'g'},
+				{"candidateCacheMegabytes", 1, 0, 'c'},
 				{"neighborCandidateStride", 1, 0, 's'},
 				{"neighborAlgorithm", 1, 0, 'n'},
+				{"halfPrecisionDistances", 0, 0, 'H'},
 				{0, 0, 0, 0}
 			};
 			int option_index = 0;
 
-			int opt = getopt_long(argc, argv, "p:m:d:f:g:s:n:",
+			int opt = getopt_long(argc, argv, "p:m:d:f:g:c:s:n:H",
 								  long_options, &option_index);
 			if( opt == -1 )
 				break;
@@ -227,6 +236,15 @@ int main(int argc, char *argv[]) {
 					err( "Invalid -g value -- must be > 0 or -1.\n" );
 				}
 			} break;
+			case 'c': {
+				char *endptr;
+				cliParms.candidateCacheMegabytes = strtol( optarg, &endptr, 10 );
+				if( *endptr ) {
+					err( "Invalid -c value -- expecting int.\n" );
+				} else if( cliParms.candidateCacheMegabytes < 0 ) {
+					err( "Invalid -c value -- must be >= 0.\n" );
+				}
+			} break;
 			case 's': {
 				char *endptr;
 				cliParms.neighborCandidateStride = strtol( optarg, &endptr, 10 );
@@ -250,6 +268,9 @@ int main(int argc, char *argv[]) {
 
 				cliParms.neighborAlgorithmName = strdup( optarg );
 			} break;
+			case 'H':
+				cliParms.halfPrecisionDistances = true;
+				break;
 			default:
 				exit(1);
 			}
@@ -450,6 +471,10 @@ void usage() {
 	p( "   -g,--genomeCacheCapacity arg" );
 	p( "        Set the max number of genomes that will be cached in RAM." );
 	p( "" );
+	p( "   -c,--candidateCacheMegabytes arg" );
+	p( "        Set the max RAM used to keep candidate clusters between clusters. Candidates that" );
+	p( "      don't fit are rebuilt when needed. 0 disables the cache. Default is 256." );
+	p( "" );
 	p( "   -s,--neighborCandidateStride arg" );
 	p( "        Sets the increment value for stepping through a cluster's members when determining" );
 	p( "      if a potential neighbor violates THRESH with a cluster. A reasonable value is 2." );
@@ -458,6 +483,10 @@ void usage() {
 	p( "        Specifies algorithm of neighboring pass. Values values are 'measureNeighbors' and" );
 	p( "      'cluster'. Default is 'measureNeighbors'." );
 	p( "" );
+	p( "   -H,--halfPrecisionDistances" );
+	p( "        Store the distance cache as 16-bit floats, halving its memory. Distances close" );
+	p( "      to THRESH may round across it, so results can differ slightly from the default." );
+	p( "" );
 	p( "" );
 	p( "qt_clust compareCentroids [-n max_clusters] [-g genomeCacheCapacity] subdir_A subdir_B [run]" );
 	p( "   Compute the distance between cluster centroids from two cluster files." );
@@ -680,6 +709,89 @@ char *get_results_path( const char *subdir, const char *type ) {
 	return strdup( buf );
 }
 
+// --------------------------------------------------------------------------------
+// ---
+// --- CLASS GenomeArchive
+// ---
+// --- Read-only view of the run's packed genome archive (genome/genomes.pwga),
+// --- laid out as described in src/library/genome/GenomeArchive.h: a 64-byte
+// --- header, then one record per agent number consisting of a flag byte and
+// --- the genes.
+// ---
+// --------------------------------------------------------------------------------
+class GenomeArchive {
+public:
+	static GenomeArchive *open( const char *path ) {
+		int fd = ::open( path, O_RDONLY );
+		if( fd < 0 )
+			return NULL;
+
+		struct stat st;
+		errif( fstat(fd, &st) != 0, "Failed stat of %s\n", path );
+		errif( st.st_size < 64, "Invalid genome archive %s\n", path );
+
+		void *mapping = mmap( NULL, st.st_size, PROT_READ, MAP_SHARED, fd, 0 );
+		errif( mapping == MAP_FAILED, "Failed mapping %s\n", path );
+		close( fd );
+
+		GenomeArchive *archive = new GenomeArchive();
+		archive->data = (const unsigned char *)mapping;
+		archive->size = st.st_size;
+
+		uint32_t header[4];
+		errif( 0 != memcmp(archive->data, "PWGENARC", 8), "Invalid genome archive %s\n", path );
+		memcpy( header, archive->data + 8, sizeof(header) );
+		errif( header[0] != 1, "Unsupported genome archive version %u in %s\n", header[0], path );
+		archive->genomeSize = header[1];
+		archive->recordSize = header[2];
+		archive->headerSize = header[3];
+		archive->nrecords = (archive->size - archive->headerSize) / archive->recordSize;
+
+		return archive;
+	}
+
+	inline bool contains( AgentId id ) {
+		return (id >= 0) && (id < nrecords) && (data[headerSize + (size_t)id * recordSize] != 0);
+	}
+
+	inline const unsigned char *genes( AgentId id ) {
+		return data + headerSize + (size_t)id * recordSize + 1;
+	}
+
+	const unsigned char *data;
+	size_t size;
+	int genomeSize;
+	int recordSize;
+	int headerSize;
+	long nrecords;
+};
+
+// --------------------------------------------------------------------------------
+// ---
+// --- FUNCTION get_genome_archive
+// ---
+// --- Returns NULL if the run has no genome archive.
+// ---
+// --------------------------------------------------------------------------------
+GenomeArchive *get_genome_archive() {
+	static bool opened = false;
+	static GenomeArchive *archive = NULL;
+
+	#pragma omp critical( genome_archive )
+	{
+		if( !opened ) {
+			char *path = get_run_path( "genome/genomes.pwga" );
+			archive = GenomeArchive::open( path );
+			errif( archive && (archive->genomeSize != GENES),
+				   "Genome archive %s has %d genes, expected %d\n", path, archive->genomeSize, GENES );
+			free( path );
+			opened = true;
+		}
+	}
+
+	return archive;
+}
+
 // --------------------------------------------------------------------------------
 // ---
 // --- FUNCTION load_genome
@@ -688,6 +800,12 @@ char *get_results_path( const char *subdir, const char *type ) {
 // ---
 // --------------------------------------------------------------------------------
 void load_genome( AgentId id, unsigned char *genome ) {
+	GenomeArchive *archive = get_genome_archive();
+	if( archive && archive->contains(id) ) {
+		memcpy( genome, archive->genes(id), GENES );
+		return;
+	}
+
 	char *dir_genome = get_run_path( "genome/agents" );
     char path_genome[1024];
     sprintf(path_genome, "%s/genome_%d.txt", dir_genome, id);
@@ -857,6 +975,13 @@ AgentIdVector *get_agent_ids() {
 
 		errif( !found, "Failed finding cluster %d\n", cliParms.clusterNumber );
 		
+	} else if( get_genome_archive() ) {
+		GenomeArchive *archive = get_genome_archive();
+		for( AgentId id = 0; id < archive->nrecords; id++ ) {
+			if( archive->contains(id) ) {
+				ids->push_back( id );
+			}
+		}
 	} else {
 		const char *path_genomes = get_run_path("genome/agents");
 
@@ -1644,42 +1769,178 @@ void compute_distances( GeneDistanceDeltaCache *deltaCache,
 
 // --------------------------------------------------------------------------------
 // ---
-// --- FUNCTION create_distanceCache
+// --- CLASS DistanceCache
+// ---
+// --- Genomic distances between all agents of a partition. Distances are
+// --- symmetric and dist(i,i) == 0, so only the upper triangle is stored, packed
+// --- row by row:
+// ---
+// ---    {dist(0,1) ... dist(0,n-1), dist(1,2) ... dist(1,n-1), ... dist(n-2,n-1)}
+// ---
+// --- which is half the memory of a full matrix. With halfPrecision the values
+// --- are stored as IEEE 754 binary16, halving it again. Note that rounding to
+// --- 11 significant bits can move a distance across THRESH, so clusters created
+// --- from a half-precision cache may differ slightly from full precision.
 // ---
 // --------------------------------------------------------------------------------
-float **create_distanceCache( GeneDistanceDeltaCache *deltaCache, PopulationPartition *partition ) {
-	int numGenomes = partition->members.size();
+class DistanceCache {
+public:
+	DistanceCache( GeneDistanceDeltaCache *deltaCache,
+				   PopulationPartition *partition,
+				   bool halfPrecision ) {
+		n = partition->members.size();
+
+		// Entry (x,y), x < y, lives at rowBase[x] + y.
+		rowBase = new ptrdiff_t[ max(n, 1) ];
+		for( int i = 0; i < n; i++ ) {
+			rowBase[i] = ptrdiff_t( size_t(i) * (2 * size_t(n) - i - 1) / 2 ) - (i + 1);
+		}
+		size_t count = max( size_t(n) * max(n - 1, 0) / 2, size_t(1) );
+
+		dists = NULL;
+		halfDists = NULL;
+
+		if( halfPrecision ) {
+			halfDists = new uint16_t[ count ];
+
+			#pragma omp parallel
+			{
+				float *rowDists = new float[ max(n, 1) ];
+
+				#pragma omp for schedule(dynamic)
+				for( int i = 0; i < n - 1; i++ ) {
+					compute_distances( deltaCache,
+									   partition->genomeCache,
+									   partition->members,
+									   i, i+1, n,
+									   rowDists );
+
+					uint16_t *D = halfDists + rowBase[i];
+					for( int j = i + 1; j < n; j++ ) {
+						D[j] = float_to_half( rowDists[j - (i + 1)] );
+					}
+				}
+
+				delete [] rowDists;
+			}
+		} else {
+			dists = new float[ count ];
+
+			#pragma omp parallel for schedule(dynamic)
+			for( int i = 0; i < n - 1; i++ ) {
+				compute_distances( deltaCache,
+								   partition->genomeCache,
+								   partition->members,
+								   i, i+1, n,
+								   dists + rowBase[i] + (i + 1) );
+			}
+		}
+
+		nbytes = count * (halfPrecision ? sizeof(uint16_t) : sizeof(float));
+	}
 
-	// allocate distance cache
-	float **distanceCache = new float*[numGenomes];
-	for( int i = 0; i < numGenomes; i++ ) {
-		distanceCache[i] = new float[numGenomes];
+	~DistanceCache() {
+		delete [] rowBase;
+		delete [] dists;
+		delete [] halfDists;
 	}
 
-	#pragma omp parallel for schedule(dynamic)
-	for( int i = 0; i < numGenomes; i++ ) {
-		float *D = distanceCache[i];
+	inline float get( AgentIndex x, AgentIndex y ) {
+		if( x == y ) {
+			return 0;
+		} else if( x > y ) {
+			swap( x, y );
+		}
+
+		if( dists ) {
+			return dists[ rowBase[x] + y ];
+		} else {
+			return half_to_float( halfDists[ rowBase[x] + y ] );
+		}
+	}
 
-		compute_distances( deltaCache,
-						   partition->genomeCache,
-						   partition->members,
-						   i, i+1, numGenomes,
-						   D + (i+1) );
+	inline size_t getBytes() {
+		return nbytes;
 	}
 
-	#pragma omp parallel for
-	for( int i = 0; i < numGenomes; i++ ) {
-		float *D = distanceCache[i];
+private:
+	// Round to nearest even. Distances are finite and non-negative.
+	static uint16_t float_to_half( float f ) {
+		uint32_t x;
+		memcpy( &x, &f, sizeof(x) );
+
+		uint32_t sign = (x >> 16) & 0x8000;
+		int32_t exp = int32_t((x >> 23) & 0xff) - 127 + 15;
+		uint32_t mant = x & 0x7fffff;
+
+		if( exp >= 31 ) {
+			return sign | 0x7c00;
+		} else if( exp <= 0 ) {
+			if( exp < -10 ) {
+				return sign;
+			}
+			mant |= 0x800000;
+			int shift = 14 - exp;
+			uint32_t h = mant >> shift;
+			uint32_t rem = mant & ((1u << shift) - 1);
+			uint32_t halfway = 1u << (shift - 1);
+			if( (rem > halfway) || ((rem == halfway) && (h & 1)) ) {
+				h++;
+			}
+			return sign | h;
+		} else {
+			uint32_t h = (uint32_t(exp) << 10) | (mant >> 13);
+			uint32_t rem = mant & 0x1fff;
+			if( (rem > 0x1000) || ((rem == 0x1000) && (h & 1)) ) {
+				h++; // may carry into the exponent, which is still correct
+			}
+			return sign | h;
+		}
+	}
+
+	static float half_to_float( uint16_t h ) {
+		uint32_t sign = uint32_t(h & 0x8000) << 16;
+		uint32_t exp = (h >> 10) & 0x1f;
+		uint32_t mant = h & 0x3ff;
+		uint32_t x;
 
-		D[i] = 0.0;
-        
-		for( int j = 0; j < i; j++ ) {
-			float d = distanceCache[j][i];
-			D[j] = d;
+		if( exp == 0 ) {
+			if( mant == 0 ) {
+				x = sign;
+			} else {
+				// subnormal
+				exp = 127 - 15 + 1;
+				while( (mant & 0x400) == 0 ) {
+					mant <<= 1;
+					exp--;
+				}
+				x = sign | (exp << 23) | ((mant & 0x3ff) << 13);
+			}
+		} else if( exp == 31 ) {
+			x = sign | 0x7f800000 | (mant << 13);
+		} else {
+			x = sign | ((exp - 15 + 127) << 23) | (mant << 13);
 		}
+
+		float f;
+		memcpy( &f, &x, sizeof(f) );
+		return f;
 	}
 
-	return distanceCache;
+	int n;
+	ptrdiff_t *rowBase;
+	float *dists;
+	uint16_t *halfDists;
+	size_t nbytes;
+};
+
+// --------------------------------------------------------------------------------
+// ---
+// --- FUNCTION create_distanceCache
+// ---
+// --------------------------------------------------------------------------------
+DistanceCache *create_distanceCache( GeneDistanceDeltaCache *deltaCache, PopulationPartition *partition ) {
+	return new DistanceCache( deltaCache, partition, cliParms.halfPrecisionDistances );
 }
 
 // --------------------------------------------------------------------------------
@@ -1687,10 +1948,7 @@ float **create_distanceCache( GeneDistanceDeltaCache *deltaCache, PopulationPart
 // --- FUNCTION dispose_distanceCache
 // ---
 // --------------------------------------------------------------------------------
-void dispose_distanceCache( float **distanceCache, PopulationPartition *population ) {
-	for( int i = 0; i < (int)population->members.size(); i++ ) {
-		delete distanceCache[i];
-	}
+void dispose_distanceCache( DistanceCache *distanceCache ) {
 	delete distanceCache;
 }
 
@@ -1701,8 +1959,8 @@ void dispose_distanceCache( float **distanceCache, PopulationPartition *populati
 // --- Fetch genomic distance between two agents from cache
 // ---
 // --------------------------------------------------------------------------------
-inline float get_distance( float **distanceCache, AgentIndex x, AgentIndex y ) {
-	return distanceCache[x][y];
+inline float get_distance( DistanceCache *distanceCache, AgentIndex x, AgentIndex y ) {
+	return distanceCache->get( x, y );
 }
 
 // --------------------------------------------------------------------------------
@@ -2141,7 +2399,14 @@ void write_results( ClusterVector &clusters ) {
 // ---
 // --- FUNCTION create_candidate_cluster
 // ---
-// --- Build a candidate cluster from a given starting agent.
+// --- Build a candidate cluster from a given starting agent. The members are
+// --- placed in <result> in the order they were picked.
+// ---
+// --- Agents are dropped from consideration as soon as they violate THRESH, so
+// --- the picks made plus the agents left bound the final size. Once that falls
+// --- below <minSize> the candidate is abandoned, leaving the picks made so far
+// --- in <result>. Returns the bound, which equals result.size() if the
+// --- candidate is complete.
 // ---
 // --------------------------------------------------------------------------------
 namespace __create_candidate_cluster {
@@ -2151,24 +2416,27 @@ namespace __create_candidate_cluster {
 	};
 }
 
-AgentIdVector *create_candidate_cluster( float **distanceCache,
-										 PopulationPartition *partition,
-										 AgentIndex startAgent,
-										 AgentIndexSet &allAgents ) {
+size_t create_candidate_cluster( DistanceCache *distanceCache,
+								 AgentIndex startAgent,
+								 AgentIndexVector &allAgents,
+								 AgentIndexVector &result,
+								 size_t minSize = 0 ) {
 	using namespace __create_candidate_cluster;
 
 	AgentIndex clusterAgents[ allAgents.size() ];
 	size_t numClusterAgents = 0;
+	size_t numRemaining = 0;
 #define ADD_CLUSTER_AGENT( ID ) clusterAgents[numClusterAgents++] = ID;
 
 	ADD_CLUSTER_AGENT( startAgent );
 
 	if( allAgents.size() > 1 ) {
 		ListBuffer<MaxDist> max_dists( allAgents.size() - 1 );
+		numRemaining = allAgents.size() - 1;
 		{
 			MaxDist *node = max_dists.head();
-			itfor( AgentIndexSet, allAgents, it ) {
-				AgentId index = *it;
+			itfor( AgentIndexVector, allAgents, it ) {
+				AgentIndex index = *it;
 
 				if( index != startAgent ) {
 					node->index = index;
@@ -2197,6 +2465,7 @@ AgentIdVector *create_candidate_cluster( float **distanceCache,
 
 				if( node->dist > THRESH ) {
 					max_dists.remove( node );
+					numRemaining--;
 				} else if( node->dist < pickDist ) {
 					pick = node;
 					pickDist = pick->dist;
@@ -2208,86 +2477,316 @@ AgentIdVector *create_candidate_cluster( float **distanceCache,
 				lastPick = pick->index;
 				ADD_CLUSTER_AGENT( pick->index );
 				max_dists.remove( pick );
+				numRemaining--;
+			}
+
+			if( (numRemaining > 0) && (numClusterAgents + numRemaining < minSize) ) {
+				if (DEBUG) printf("%dC | abandoned (bound %zu)\n", startAgent, numClusterAgents + numRemaining);
+				break;
 			}
 		}
 	}
+#undef ADD_CLUSTER_AGENT
 
-	AgentIndexVector *result = partition->createAgentIdVector( clusterAgents, numClusterAgents );
+	result.assign( clusterAgents, clusterAgents + numClusterAgents );
 
-	if (DEBUG) printf("%dC | (len %zu)\n", startAgent, result->size());
+	if (DEBUG) printf("%dC | (len %zu)\n", startAgent, result.size());
 
-	return result;
+	return numClusterAgents + numRemaining;
 }
 
+// --------------------------------------------------------------------------------
+// ---
+// --- CLASS CandidateClusterCache
+// ---
+// --- Candidate clusters from previous calls to create_cluster(), indexed by
+// --- start agent.
+// ---
+// --- create_candidate_cluster() picks the first agent with the smallest max
+// --- distance, and an agent's max distance only depends on the agents picked
+// --- before it. An agent that was never picked therefore never affected a pick,
+// --- so removing agents that aren't members of a candidate leaves the candidate
+// --- unchanged. After a cluster is extracted only the candidates that shared an
+// --- agent with it are invalidated.
+// ---
+// --- The same holds for the picks of an abandoned candidate, so its size bound
+// --- stays valid as long as none of those picks are removed. For other
+// --- candidates the bound is the number of remaining agents within THRESH of
+// --- the start agent. create_cluster() rebuilds candidates in order of
+// --- descending bound and stops once no bound can beat the biggest candidate.
+// ---
+// --- Member lists are kept only while their total allocated length is at
+// --- most <capacity> indices; beyond that, candidates are rebuilt when needed.
+// --- Only valid candidates hold a list, so the cache uses at most
+// --- capacity * sizeof(AgentIndex) bytes for members plus about 48 bytes of
+// --- bookkeeping per agent. Unbounded, the lists of n agents could take
+// --- n(n-1)/2 indices.
+// ---
+// --------------------------------------------------------------------------------
+class CandidateClusterCache {
+public:
+	CandidateClusterCache( DistanceCache *distanceCache,
+						   int numAgents,
+						   AgentIndexSet &agents,
+						   size_t capacity )
+		: _distanceCache( distanceCache )
+		, _members( numAgents )
+		, _valid( numAgents, false )
+		, _removed( numAgents, false )
+		, _neighborBound( numAgents, 0 )
+		, _sizeBound( numAgents, 0 )
+		, _size( 0 )
+		, _capacity( capacity )
+	{
+		AgentIndexVector agentsVector( agents.begin(), agents.end() );
+		int n = agentsVector.size();
+
+		#pragma omp parallel for schedule(dynamic)
+		for( int i = 0; i < n; i++ ) {
+			size_t bound = 0;
+			for( int j = 0; j < n; j++ ) {
+				if( get_distance(distanceCache, agentsVector[i], agentsVector[j]) <= THRESH ) {
+					bound++;
+				}
+			}
+			_neighborBound[ agentsVector[i] ] = bound;
+		}
+	}
+
+	// True if the candidate for startAgent is known exactly.
+	inline bool isComplete( AgentIndex startAgent ) {
+		return _valid[startAgent] && (_sizeBound[startAgent] == _members[startAgent].size());
+	}
+
+	inline AgentIndexVector &getMembers( AgentIndex startAgent ) {
+		assert( isComplete(startAgent) );
+		return _members[startAgent];
+	}
+
+	inline size_t getBound( AgentIndex startAgent ) {
+		if( _valid[startAgent] ) {
+			return min( _sizeBound[startAgent], _neighborBound[startAgent] );
+		} else {
+			return _neighborBound[startAgent];
+		}
+	}
+
+	// Takes ownership of the contents of <members> if there is room.
+	void store( AgentIndex startAgent, AgentIndexVector &members, size_t sizeBound ) {
+		invalidate( startAgent );
+
+		if( _size + members.capacity() <= _capacity ) {
+			_members[startAgent].swap( members );
+			_sizeBound[startAgent] = sizeBound;
+			_valid[startAgent] = true;
+			_size += _members[startAgent].capacity();
+		}
+	}
+
+	// Must be called after <removedAgents> have been erased from <remainingAgents>.
+	void remove( AgentIndexVector &removedAgents, AgentIndexSet &remainingAgents ) {
+		itfor( AgentIndexVector, removedAgents, it ) {
+			_removed[*it] = true;
+			invalidate( *it );
+		}
+
+		AgentIndexVector remaining( remainingAgents.begin(), remainingAgents.end() );
+		int n = remaining.size();
+		int nremoved = removedAgents.size();
+		vector<char> stale( n, false );
+
+		#pragma omp parallel for schedule(dynamic)
+		for( int i = 0; i < n; i++ ) {
+			AgentIndex startAgent = remaining[i];
+
+			for( int j = 0; j < nremoved; j++ ) {
+				if( get_distance(_distanceCache, startAgent, removedAgents[j]) <= THRESH ) {
+					_neighborBound[startAgent]--;
+				}
+			}
+
+			if( _valid[startAgent] ) {
+				AgentIndexVector &members = _members[startAgent];
+				for( size_t j = 0; j < members.size(); j++ ) {
+					if( _removed[members[j]] ) {
+						stale[i] = true;
+						break;
+					}
+				}
+			}
+		}
+
+		for( int i = 0; i < n; i++ ) {
+			if( stale[i] ) {
+				invalidate( remaining[i] );
+			}
+		}
+	}
+
+private:
+	void invalidate( AgentIndex startAgent ) {
+		if( _valid[startAgent] ) {
+			_size -= _members[startAgent].capacity();
+			AgentIndexVector().swap( _members[startAgent] );
+			_valid[startAgent] = false;
+		}
+	}
+
+	DistanceCache *_distanceCache;
+	vector<AgentIndexVector> _members;
+	vector<char> _valid;
+	vector<char> _removed;
+	vector<size_t> _neighborBound;
+	vector<size_t> _sizeBound;
+	size_t _size;
+	size_t _capacity;
+};
 
 // --------------------------------------------------------------------------------
 // ---
 // --- FUNCTION create_cluster
 // ---
-// --- Create the largest cluster possible for the remaining agents.
+// --- Create the largest cluster possible for the remaining agents. Ties are
+// --- broken by the lowest start agent.
+// ---
+// --- If a candidateCache is provided it must describe remainingAgents.
 // ---
 // --------------------------------------------------------------------------------
-Cluster *create_cluster( float **distanceCache,
+namespace __create_cluster {
+	const int BatchSize = 64;
+
+	struct BoundDescending {
+		CandidateClusterCache *cache;
+
+		bool operator()( AgentIndex a, AgentIndex b ) const {
+			size_t abound = cache->getBound( a );
+			size_t bbound = cache->getBound( b );
+			return (abound > bbound) || ((abound == bbound) && (a < b));
+		}
+	};
+}
+
+Cluster *create_cluster( DistanceCache *distanceCache,
 						 PopulationPartition *partition,
 						 AgentIndexSet &remainingAgents,
 						 ClusterId clusterId,
-						 int stride_divisor = -1 ) {
+						 int stride_divisor = -1,
+						 CandidateClusterCache *candidateCache = NULL ) {
+	using namespace __create_cluster;
+
+	CandidateClusterCache *localCache = NULL;
+	if( candidateCache == NULL ) {
+		localCache = new CandidateClusterCache( distanceCache,
+												partition->members.size(),
+												remainingAgents,
+												0 );
+		candidateCache = localCache;
+	}
 
-	AgentIdVector *biggestMembers = NULL;
-	AgentIndex biggestStartAgent;
+	AgentIndexVector agents( remainingAgents.begin(), remainingAgents.end() );
 
-	AgentIndexSet::iterator it = remainingAgents.begin();
-	AgentIndexSet::iterator it_end = remainingAgents.end();
+	int stride = max( 1, int(agents.size() / stride_divisor) );
 
-	int stride = max( 1, int(remainingAgents.size() / stride_divisor) );
-	
-	#pragma omp parallel
+	size_t biggestSize = 0;
+	AgentIndex biggestStartAgent = -1;
+	AgentIndexVector biggestMembers;
+	bool biggestCached = false;
+
+#define MIN_SIZE_TO_BEAT_BIGGEST( START )								\
+	( (biggestStartAgent == -1) ? 0										\
+	  : ((START) < biggestStartAgent) ? biggestSize						\
+	  : biggestSize + 1 )
+
+	// ---
+	// --- Consider complete cached candidates; collect the others.
+	// ---
+	AgentIndexVector rebuild;
+
+	for( size_t i = 0; i < agents.size(); i += stride ) {
+		AgentIndex startAgent = agents[i];
+
+		if( candidateCache->isComplete(startAgent) ) {
+			size_t size = candidateCache->getMembers( startAgent ).size();
+			if( size >= MIN_SIZE_TO_BEAT_BIGGEST(startAgent) ) {
+				biggestSize = size;
+				biggestStartAgent = startAgent;
+				biggestCached = true;
+			}
+		} else {
+			rebuild.push_back( startAgent );
+		}
+	}
+
+	// ---
+	// --- Rebuild candidates that could still beat the biggest.
+	// ---
 	{
-		AgentIndexSet::iterator it_threadLocal = it_end;
+		BoundDescending cmp = { candidateCache };
+		sort( rebuild.begin(), rebuild.end(), cmp );
+	}
 
-		do {
-			#pragma omp critical( cluster_single__it )
-			{
-				it_threadLocal = it;
-				if( it != it_end ) {
-					for( int i = 0; (i < stride) && (it != it_end); i++ ) {
-						++it;
-					}
-				}
+	vector<AgentIndexVector> batch( BatchSize );
+	size_t next = 0;
+
+	while( next < rebuild.size() ) {
+		int nbatch = 0;
+		size_t minSize[BatchSize];
+		size_t bound[BatchSize];
+
+		while( (nbatch < BatchSize) && (next + nbatch < rebuild.size()) ) {
+			AgentIndex startAgent = rebuild[next + nbatch];
+			minSize[nbatch] = MIN_SIZE_TO_BEAT_BIGGEST( startAgent );
+			if( candidateCache->getBound(startAgent) < minSize[nbatch] ) {
+				break;
 			}
+			nbatch++;
+		}
 
-			if( it_threadLocal != it_end ) {
-				AgentIndex startAgent = *it_threadLocal;
-				AgentIdVector *members = create_candidate_cluster( distanceCache,
-																   partition,
-																   startAgent, 
-																   remainingAgents );
+		if( nbatch == 0 ) {
+			break;
+		}
 
-				#pragma omp critical ( cluster_single__biggest )
-				{
-					if( (biggestMembers == NULL)
-						|| (members->size() > biggestMembers->size())
-						|| ((members->size() == biggestMembers->size()) && (startAgent < biggestStartAgent)) )
-					{
-						if( biggestMembers ) {
-							delete biggestMembers;
-						}
+		#pragma omp parallel for schedule(dynamic)
+		for( int i = 0; i < nbatch; i++ ) {
+			bound[i] = create_candidate_cluster( distanceCache,
+												 rebuild[next + i],
+												 agents,
+												 batch[i],
+												 minSize[i] );
+		}
 
-						biggestMembers = members;
-						biggestStartAgent = startAgent;
-					} else {
-						delete members;
-					}
-				}
+		for( int i = 0; i < nbatch; i++ ) {
+			AgentIndex startAgent = rebuild[next + i];
+
+			if( (bound[i] == batch[i].size())
+				&& (batch[i].size() >= MIN_SIZE_TO_BEAT_BIGGEST(startAgent)) )
+			{
+				biggestSize = batch[i].size();
+				biggestStartAgent = startAgent;
+				biggestMembers = batch[i];
+				biggestCached = false;
 			}
-		} while( it_threadLocal != it_end );
+
+			candidateCache->store( startAgent, batch[i], bound[i] );
+		}
+
+		next += nbatch;
+	}
+
+#undef MIN_SIZE_TO_BEAT_BIGGEST
+
+	if( biggestCached ) {
+		biggestMembers = candidateCache->getMembers( biggestStartAgent );
 	}
 
-	sort( biggestMembers->begin(), biggestMembers->end() );
+	AgentIdVector *members = partition->createAgentIdVector( &biggestMembers[0], biggestMembers.size() );
+	sort( members->begin(), members->end() );
 
 	Cluster *result = new Cluster( partition,
 								   clusterId,
-								   biggestMembers );
+								   members );
+
+	delete localCache;
 
 	return result;
 }
@@ -2303,7 +2802,7 @@ void create_clusters( GeneDistanceDeltaCache *distance_deltaCache,
 					  PopulationPartition *population,
 					  ClusterVector &allClusters ) {
 	printf("calculating distances...\n");
-	float **distanceCache;
+	DistanceCache *distanceCache;
 	{
 		double startTime = hirestime();
 
@@ -2311,6 +2810,7 @@ void create_clusters( GeneDistanceDeltaCache *distance_deltaCache,
 
 		double endTime = hirestime();
 		printf( "distance time=%f seconds\n", endTime - startTime );
+		printf( "distance cache=%.1f MB\n", distanceCache->getBytes() / (1024.0 * 1024.0) );
 	}
 
 
@@ -2331,18 +2831,30 @@ void create_clusters( GeneDistanceDeltaCache *distance_deltaCache,
 
 	ClusterVector clusters;
 
+	size_t candidateCapacity = size_t(cliParms.candidateCacheMegabytes) * 1024 * 1024 / sizeof(AgentIndex);
+	CandidateClusterCache candidateCache( distanceCache,
+										  population->members.size(),
+										  remainingAgents,
+										  candidateCapacity );
+	printf( "candidate cache capacity=%d MB\n", cliParms.candidateCacheMegabytes );
+
 	while( !remainingAgents.empty() ) {
 		Cluster *cluster = create_cluster( distanceCache,
 										   population,
 										   remainingAgents,
 										   clusters.size() + allClusters.size(),
-										   cliParms.clusterStrideDivisor );
+										   cliParms.clusterStrideDivisor,
+										   &candidateCache );
 		clusters.push_back( cluster );
 
 		// remove cluster members from agents needing processing
+		AgentIndexVector removedAgents;
 		for( int i = 0; i < (int)cluster->members.size(); i++ ) {
-			remainingAgents.erase( population->getIndex(cluster->members[i]) );
+			AgentIndex index = population->getIndex( cluster->members[i] );
+			remainingAgents.erase( index );
+			removedAgents.push_back( index );
 		}
+		candidateCache.remove( removedAgents, remainingAgents );
 
 #if VERBOSE
 		write_cluster( stdout, cluster );
@@ -2374,7 +2886,7 @@ void create_clusters( GeneDistanceDeltaCache *distance_deltaCache,
 	// ---
 	// --- Dispose Distance Cache
 	// ---
-	dispose_distanceCache( distanceCache, population );
+	dispose_distanceCache( distanceCache );
 
 	// ---
 	// --- Add clusters to result
@@ -2497,7 +3009,7 @@ void find_valid_neighbors__cluster( Cluster *cluster,
 	PopulationPartition partition( new AgentIdVector(clusterNeighborCandidates),
 								   neighborPartition->genomeCache );
 
-	float **distanceCache = create_distanceCache( distance_deltaCache, &partition );
+	DistanceCache *distanceCache = create_distanceCache( distance_deltaCache, &partition );
 
 	Cluster *neighborCluster = create_cluster( distanceCache,
 											   &partition,
@@ -2510,7 +3022,7 @@ void find_valid_neighbors__cluster( Cluster *cluster,
 		  cluster->neighbors.begin() );	
 
 	delete neighborCluster;
-	dispose_distanceCache( distanceCache, &partition );
+	dispose_distanceCache( distanceCache );
 }
 
 // --------------------------------------------------------------------------------
@@ -1,6 +1,7 @@
 #include <iostream>
 #include <math.h>
 #include <limits>
+#include <ostream>
 #include <stdio.h>
 #include <stdlib.h>
 #include <string>
@@ -30,83 +31,89 @@ struct Args {
 void printUsage(int, char**);
 bool tryParseArgs(int, char**, Args&);
 void printArgs(const Args&);
+void processAgent(const Args&, int, std::ostream&);
 
 int main(int argc, char** argv) {
     Args args;
-    if (!tryParseArgs(argc, argv, args)) {
+    analysis::DriverOptions options;
+    if (!analysis::tryParseDriverOptions(argc, argv, options) || !tryParseArgs(argc, argv, args)) {
         printUsage(argc, argv);
         return 1;
     }
     printArgs(args);
     analysis::initialize(args.run);
     int maxAgent = args.mode == "single" ? args.agent : analysis::getMaxAgent(args.run);
-    for (int agent = args.agent; agent <= maxAgent; agent++) {
-        AbstractFile* synapses = analysis::getSynapses(args.run, agent, args.stage);
-        if (synapses == NULL) {
-            continue;
+    analysis::forEachAgent(options, args.agent, maxAgent, [&args](int agent, std::ostream& out) {
+        processAgent(args, agent, out);
+    });
+    return 0;
+}
+
+void processAgent(const Args& args, int agent, std::ostream& out) {
+    AbstractFile* synapses = analysis::getSynapses(args.run, agent, args.stage);
+    if (synapses == NULL) {
+        return;
+    }
+    genome::Genome* genome = analysis::getGenome(args.run, agent);
+    RqNervousSystem* cns = analysis::getNervousSystem(genome, synapses);
+    if (args.mode == "all") {
+        double expansion = analysis::getExpansion(genome, cns, args.perturbation, args.repeats, args.random, args.quiescent, args.steps);
+        out << agent << " " << expansion << std::endl;
+    } else if (args.mode == "single") {
+        int index = 0;
+        float wmax = args.wmaxMin;
+        while (wmax <= args.wmaxMax) {
+            synapses->seek(0, SEEK_SET);
+            analysis::setMaxWeight(cns, synapses, wmax);
+            for (int repeat = 0; repeat < args.repeats; repeat++) {
+                double expansion = analysis::getExpansion(genome, cns, args.perturbation, 1, args.random, args.quiescent, args.steps);
+                out << wmax << " " << expansion << std::endl;
+            }
+            index++;
+            wmax = args.wmaxMin + index * args.wmaxInc;
         }
-        genome::Genome* genome = analysis::getGenome(args.run, agent);
-        RqNervousSystem* cns = analysis::getNervousSystem(genome, synapses);
-        if (args.mode == "all") {
-            double expansion = analysis::getExpansion(genome, cns, args.perturbation, args.repeats, args.random, args.quiescent, args.steps);
-            std::cout << agent << " " << expansion << std::endl;
-        } else if (args.mode == "single") {
-            int index = 0;
-            float wmax = args.wmaxMin;
-            while (wmax <= args.wmaxMax) {
-                synapses->seek(0, SEEK_SET);
-                analysis::setMaxWeight(cns, synapses, wmax);
-                for (int repeat = 0; repeat < args.repeats; repeat++) {
-                    double expansion = analysis::getExpansion(genome, cns, args.perturbation, 1, args.random, args.quiescent, args.steps);
-                    std::cout << wmax << " " << expansion << std::endl;
-                }
-                index++;
-                wmax = args.wmaxMin + index * args.wmaxInc;
+    } else if (args.mode == "onset") {
+        int stage = 1;
+        bool done = false;
+        float wmaxStageInc = args.wmaxInc;
+        float wmaxStageMax = args.wmaxInc * 100.0f;
+        for (float wmax = args.wmaxMin; wmax <= args.wmaxMax; wmax += wmaxStageInc) {
+            synapses->seek(0, SEEK_SET);
+            analysis::setMaxWeight(cns, synapses, wmax);
+            double expansion = analysis::getExpansion(genome, cns, args.perturbation, 1, args.random, args.quiescent, args.steps);
+            if (expansion >= args.threshold * 0.9) {
+                expansion = analysis::getExpansion(genome, cns, args.perturbation, args.repeats, args.random, args.quiescent, args.steps);
             }
-        } else if (args.mode == "onset") {
-            int stage = 1;
-            bool done = false;
-            float wmaxStageInc = args.wmaxInc;
-            float wmaxStageMax = args.wmaxInc * 100.0f;
-            for (float wmax = args.wmaxMin; wmax <= args.wmaxMax; wmax += wmaxStageInc) {
-                synapses->seek(0, SEEK_SET);
-                analysis::setMaxWeight(cns, synapses, wmax);
-                double expansion = analysis::getExpansion(genome, cns, args.perturbation, 1, args.random, args.quiescent, args.steps);
-                if (expansion >= args.threshold * 0.9) {
-                    expansion = analysis::getExpansion(genome, cns, args.perturbation, args.repeats, args.random, args.quiescent, args.steps);
-                }
-                if (expansion >= args.threshold) {
-                    if (stage == 1) {
-                        std::cout << agent << " " << wmax << std::endl;
-                        done = true;
-                        break;
-                    } else {
-                        stage--;
-                        wmaxStageMax = wmax;
-                        wmax -= wmaxStageInc;
-                    }
-                } else if (wmax >= wmaxStageMax) {
-                    stage++;
-                    wmaxStageMax = args.wmaxInc * pow(10.0f, stage + 1);
+            if (expansion >= args.threshold) {
+                if (stage == 1) {
+                    out << agent << " " << wmax << std::endl;
+                    done = true;
+                    break;
+                } else {
+                    stage--;
+                    wmaxStageMax = wmax;
+                    wmax -= wmaxStageInc;
                 }
-                wmaxStageInc = args.wmaxInc * pow(10.0f, stage - 1);
-            }
-            if (!done) {
-                std::cout << agent << " " << std::numeric_limits<double>::infinity() << std::endl;
+            } else if (wmax >= wmaxStageMax) {
+                stage++;
+                wmaxStageMax = args.wmaxInc * pow(10.0f, stage + 1);
             }
+            wmaxStageInc = args.wmaxInc * pow(10.0f, stage - 1);
+        }
+        if (!done) {
+            out << agent << " " << std::numeric_limits<double>::infinity() << std::endl;
         }
-        delete cns;
-        delete genome;
-        delete synapses;
     }
-    return 0;
+    delete cns;
+    delete genome;
+    delete synapses;
 }
 
 void printUsage(int argc, char** argv) {
     std::cerr << "Usage:" << std::endl;
-    std::cerr << "  " << argv[0] << " all RUN STAGE PERTURBATION REPEATS RANDOM QUIESCENT STEPS [AGENT]" << std::endl;
-    std::cerr << "  " << argv[0] << " single RUN STAGE WMAX_MIN WMAX_MAX WMAX_INC PERTURBATION REPEATS RANDOM QUIESCENT STEPS AGENT" << std::endl;
-    std::cerr << "  " << argv[0] << " onset RUN STAGE WMAX_MAX PERTURBATION REPEATS RANDOM QUIESCENT STEPS THRESHOLD [AGENT]" << std::endl;
+    std::cerr << "  " << argv[0] << " [OPTIONS] all RUN STAGE PERTURBATION REPEATS RANDOM QUIESCENT STEPS [AGENT]" << std::endl;
+    std::cerr << "  " << argv[0] << " [OPTIONS] single RUN STAGE WMAX_MIN WMAX_MAX WMAX_INC PERTURBATION REPEATS RANDOM QUIESCENT STEPS AGENT" << std::endl;
+    std::cerr << "  " << argv[0] << " [OPTIONS] onset RUN STAGE WMAX_MAX PERTURBATION REPEATS RANDOM QUIESCENT STEPS THRESHOLD [AGENT]" << std::endl;
     std::cerr << std::endl;
     std::cerr << "Calculates phase space expansion." << std::endl;
     std::cerr << std::endl;
@@ -122,6 +129,8 @@ void printUsage(int argc, char** argv) {
     std::cerr << "  STEPS         Number of calculation timesteps" << std::endl;
     std::cerr << "  THRESHOLD     Threshold phase space expansion" << std::endl;
     std::cerr << "  AGENT         [Starting] agent index" << std::endl;
+    std::cerr << std::endl;
+    analysis::printDriverUsage();
 }
 
 bool tryParseArgs(int argc, char** argv, Args& args) {
@@ -0,0 +1,176 @@
+#include <algorithm>
+#include <dirent.h>
+#include <iostream>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string>
+#include <string.h>
+#include <unistd.h>
+#include <vector>
+
+#include "genome/GenomeArchive.h"
+#include "utils/AbstractFile.h"
+#include "utils/misc.h"
+
+using namespace genome;
+
+struct Args {
+    std::string run;
+    bool force;
+    bool verify;
+};
+
+void printUsage(int, char**);
+bool tryParseArgs(int, char**, Args&);
+std::vector<long> getAgentIds(const std::string&);
+int readGenome(const std::string&, long, std::vector<unsigned char>&);
+bool verify(const Args&, const std::vector<long>&);
+
+int main(int argc, char** argv) {
+    Args args;
+    if (!tryParseArgs(argc, argv, args)) {
+        printUsage(argc, argv);
+        return 1;
+    }
+
+    std::string path = GenomeArchive::getPath(args.run);
+    if (GenomeArchive::exists(args.run) && !args.force) {
+        if (args.verify) {
+            return verify(args, getAgentIds(args.run)) ? 0 : 1;
+        }
+        std::cerr << path << " already exists (use --force to rebuild)" << std::endl;
+        return 1;
+    }
+
+    std::vector<long> ids = getAgentIds(args.run);
+    if (ids.empty()) {
+        std::cerr << "No genomes found in " << args.run << "/genome/agents" << std::endl;
+        return 1;
+    }
+
+    // Write to a temporary file so an interrupted conversion leaves no archive.
+    std::string tmppath = path + ".tmp";
+    std::vector<unsigned char> genes;
+    int genomeSize = readGenome(args.run, ids.front(), genes);
+    GenomeArchive* archive = GenomeArchive::create(tmppath, genomeSize);
+    for (long id : ids) {
+        if (readGenome(args.run, id, genes) != genomeSize) {
+            std::cerr << "Agent " << id << " has " << genes.size() << " genes, expected " << genomeSize << std::endl;
+            delete archive;
+            unlink(tmppath.c_str());
+            return 1;
+        }
+        archive->append(id, genes.data());
+    }
+    delete archive;
+
+    if (rename(tmppath.c_str(), path.c_str()) != 0) {
+        std::cerr << "Failed renaming " << tmppath << " to " << path << std::endl;
+        return 1;
+    }
+    std::cout << "Archived " << ids.size() << " genomes of " << genomeSize << " genes to " << path << std::endl;
+
+    if (args.verify) {
+        return verify(args, ids) ? 0 : 1;
+    }
+    return 0;
+}
+
+void printUsage(int argc, char** argv) {
+    std::cerr << "Usage: " << argv[0] << " [--force] [--verify] RUN" << std::endl;
+    std::cerr << std::endl;
+    std::cerr << "Packs the per-agent genome files of RUN/genome/agents into the archive" << std::endl;
+    std::cerr << "RUN/" << GenomeArchive::RelativePath << " read by the analysis tools." << std::endl;
+    std::cerr << std::endl;
+    std::cerr << "  --force    Rebuild the archive if it already exists" << std::endl;
+    std::cerr << "  --verify   Compare every archived genome with its text file" << std::endl;
+}
+
+bool tryParseArgs(int argc, char** argv, Args& args) {
+    args.force = false;
+    args.verify = false;
+    int argi = 1;
+    for (; argi < argc - 1; argi++) {
+        if (strcmp(argv[argi], "--force") == 0) {
+            args.force = true;
+        } else if (strcmp(argv[argi], "--verify") == 0) {
+            args.verify = true;
+        } else {
+            return false;
+        }
+    }
+    if (argi != argc - 1) {
+        return false;
+    }
+    args.run = argv[argi];
+    return exists(args.run + "/genome/agents");
+}
+
+std::vector<long> getAgentIds(const std::string& run) {
+    std::vector<long> ids;
+    std::string path = run + "/genome/agents";
+    DIR* dir = opendir(path.c_str());
+    if (dir == NULL) {
+        return ids;
+    }
+    dirent* ent;
+    while ((ent = readdir(dir)) != NULL) {
+        if (strncmp(ent->d_name, "genome_", 7) == 0) {
+            ids.push_back(atol(ent->d_name + 7));
+        }
+    }
+    closedir(dir);
+    std::sort(ids.begin(), ids.end());
+    ids.erase(std::unique(ids.begin(), ids.end()), ids.end());
+    return ids;
+}
+
+// Returns the number of genes read.
+int readGenome(const std::string& run, long id, std::vector<unsigned char>& genes) {
+    std::string path = run + "/genome/agents/genome_" + std::to_string(id) + ".txt";
+    AbstractFile* file = AbstractFile::open(path.c_str(), "r");
+    if (file == NULL) {
+        std::cerr << "Failed opening " << path << std::endl;
+        exit(1);
+    }
+
+    genes.clear();
+    char buf[64 * 1024];
+    int value = -1;
+    size_t nread;
+    while ((nread = file->read(buf, 1, sizeof(buf))) > 0) {
+        for (size_t i = 0; i < nread; i++) {
+            if (buf[i] >= '0' && buf[i] <= '9') {
+                value = (value < 0 ? 0 : value * 10) + (buf[i] - '0');
+            } else if (value >= 0) {
+                genes.push_back((unsigned char)value);
+                value = -1;
+            }
+        }
+    }
+    if (value >= 0) {
+        genes.push_back((unsigned char)value);
+    }
+    delete file;
+
+    return (int)genes.size();
+}
+
+bool verify(const Args& args, const std::vector<long>& ids) {
+    GenomeArchive* archive = GenomeArchive::open(GenomeArchive::getPath(args.run));
+    std::vector<unsigned char> genes;
+    long mismatches = 0;
+    for (long id : ids) {
+        readGenome(args.run, id, genes);
+        const unsigned char* archived = archive->get(id);
+        if (archived == NULL
+            || (int)genes.size() != archive->getGenomeSize()
+            || memcmp(archived, genes.data(), genes.size()) != 0) {
+            std::cerr << "Mismatch for agent " << id << std::endl;
+            mismatches++;
+        }
+    }
+    delete archive;
+    std::cout << "Verified " << ids.size() << " genomes, " << mismatches << " mismatches" << std::endl;
+    return mismatches == 0;
+}
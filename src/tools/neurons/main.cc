@@ -1,4 +1,5 @@
 #include <iostream>
+#include <ostream>
 #include <stdlib.h>
 #include <string>
 
@@ -15,38 +16,49 @@ struct Args {
 
 void printUsage(int, char**);
 bool tryParseArgs(int, char**, Args&);
+void processAgent(const Args&, int, std::ostream&);
 
 int main(int argc, char** argv) {
     Args args;
-    if (!tryParseArgs(argc, argv, args)) {
+    analysis::DriverOptions options;
+    if (!analysis::tryParseDriverOptions(argc, argv, options) || !tryParseArgs(argc, argv, args)) {
         printUsage(argc, argv);
         return 1;
     }
     analysis::initialize(args.run);
     int maxAgent = analysis::getMaxAgent(args.run);
-    for (int agent = 1; agent <= maxAgent; agent++) {
-        RqNervousSystem* cns = analysis::getNervousSystem(args.run, agent, "birth");
-        const NervousSystem::NerveList& nerves = cns->getNerves();
-        citfor(NervousSystem::NerveList, nerves, it) {
-            std::cout << agent << " " << (*it)->name << " " << (*it)->getNeuronCount() << std::endl;
-        }
-        NeuronModel::Dimensions dimensions = cns->getBrain()->getDimensions();
-        std::cout << agent << " Input " << dimensions.numInputNeurons << std::endl;
-        std::cout << agent << " Output " << dimensions.numOutputNeurons << std::endl;
-        std::cout << agent << " Internal " << dimensions.numNeurons - dimensions.numInputNeurons - dimensions.numOutputNeurons << std::endl;
-        std::cout << agent << " Processing " << dimensions.numNeurons - dimensions.numInputNeurons << std::endl;
-        std::cout << agent << " Total " << dimensions.numNeurons << std::endl;
-        delete cns;
-    }
+    analysis::forEachAgent(options, 1, maxAgent, [&args](int agent, std::ostream& out) {
+        processAgent(args, agent, out);
+    });
     return 0;
 }
 
+void processAgent(const Args& args, int agent, std::ostream& out) {
+    RqNervousSystem* cns = analysis::getNervousSystem(args.run, agent, "birth");
+    if (cns == NULL) {
+        return;
+    }
+    const NervousSystem::NerveList& nerves = cns->getNerves();
+    citfor(NervousSystem::NerveList, nerves, it) {
+        out << agent << " " << (*it)->name << " " << (*it)->getNeuronCount() << std::endl;
+    }
+    NeuronModel::Dimensions dimensions = cns->getBrain()->getDimensions();
+    out << agent << " Input " << dimensions.numInputNeurons << std::endl;
+    out << agent << " Output " << dimensions.numOutputNeurons << std::endl;
+    out << agent << " Internal " << dimensions.numNeurons - dimensions.numInputNeurons - dimensions.numOutputNeurons << std::endl;
+    out << agent << " Processing " << dimensions.numNeurons - dimensions.numInputNeurons << std::endl;
+    out << agent << " Total " << dimensions.numNeurons << std::endl;
+    delete cns;
+}
+
 void printUsage(int argc, char** argv) {
-    std::cerr << "Usage: " << argv[0] << " RUN" << std::endl;
+    std::cerr << "Usage: " << argv[0] << " [OPTIONS] RUN" << std::endl;
     std::cerr << std::endl;
     std::cerr << "Prints neuron counts by type." << std::endl;
     std::cerr << std::endl;
     std::cerr << "  RUN  Run directory" << std::endl;
+    std::cerr << std::endl;
+    analysis::printDriverUsage();
 }
 
 bool tryParseArgs(int argc, char** argv, Args& args) {
@@ -37,7 +37,7 @@ int main(int argc, char** argv) {
     }
     analysis::initialize(args.run);
     std::vector<genome::Genome*> genomes;
-    int geneCount = genome::GenomeUtil::schema->getMutableSize();
+    int geneCount = genome::GenomeUtil::schema()->getMutableSize();
     std::vector<std::vector<int> > distribution(geneCount, std::vector<int>(256 >> args.groupSize));
     genome::Genome* seed = analysis::getGenome(args.run, 1);
     for (int agent = 1; agent <= args.agents; agent++) {
@@ -149,7 +149,7 @@ double getDistance(const std::vector<std::vector<int> >& distribution, int popul
 }
 
 void logGenome(const std::string& path, genome::Genome* genome) {
-    AbstractFile* file = AbstractFile::open(globals::recordFileType, path.c_str(), "w");
+    AbstractFile* file = AbstractFile::open(globals::recordFileType(), path.c_str(), "w");
     genome->dump(file);
     delete file;
 }
@@ -74,7 +74,7 @@ int main(int argc, char** argv) {
         drivens.insert(agent);
         passives[agent] = analysis::getGenome(args.driven, agent);
         copyAbstractFile(args.driven, args.passive, "/genome/agents/genome_" + std::to_string(agent) + ".txt");
-        if (Brain::config.learningMode != Brain::Configuration::LEARN_NONE) {
+        if (Brain::config().learningMode != Brain::Configuration::LEARN_NONE) {
             copyAbstractFile(args.driven, args.passive, "/brain/synapses/synapses_" + std::to_string(agent) + "_incept.txt");
         }
         copyAbstractFile(args.driven, args.passive, "/brain/synapses/synapses_" + std::to_string(agent) + "_birth.txt");
@@ -104,7 +104,7 @@ int main(int argc, char** argv) {
                     logGenome(args.passive, event.agent, child);
                     RqNervousSystem* cns = new RqNervousSystem();
                     cns->grow(child);
-                    if (Brain::config.learningMode != Brain::Configuration::LEARN_NONE) {
+                    if (Brain::config().learningMode != Brain::Configuration::LEARN_NONE) {
                         logSynapses(args.passive, event.agent, "incept", cns);
                     }
                     cns->prebirth();
@@ -191,7 +191,7 @@ void copyFile(const std::string& run1, const std::string& run2, const std::strin
 }
 
 void copyAbstractFile(const std::string& run1, const std::string& run2, std::string path) {
-    if (globals::recordFileType == AbstractFile::TYPE_GZIP_FILE) {
+    if (globals::recordFileType() == AbstractFile::TYPE_GZIP_FILE) {
         path += ".gz";
     }
     SYSTEM(("cp " + (run1 + path) + " " + (run2 + path)).c_str());
@@ -224,14 +224,14 @@ std::map<int, genome::Genome*>::iterator pick(std::map<int, genome::Genome*>& ge
 
 void logGenome(const std::string& run, int agent, genome::Genome* genome) {
     std::string path = run + "/genome/agents/genome_" + std::to_string(agent) + ".txt";
-    AbstractFile* file = AbstractFile::open(globals::recordFileType, path.c_str(), "w");
+    AbstractFile* file = AbstractFile::open(globals::recordFileType(), path.c_str(), "w");
     genome->dump(file);
     delete file;
 }
 
 void logSynapses(const std::string& run, int agent, const std::string& stage, RqNervousSystem* cns) {
     std::string path = run + "/brain/synapses/synapses_" + std::to_string(agent) + "_" + stage + ".txt";
-    AbstractFile* file = AbstractFile::open(globals::recordFileType, path.c_str(), "w");
+    AbstractFile* file = AbstractFile::open(globals::recordFileType(), path.c_str(), "w");
     cns->getBrain()->dumpSynapses(file, agent);
     delete file;
 }
@@ -3,6 +3,7 @@
 
 #include <iostream>
 #include <string>
+#include <vector>
 
 #include "utils/PwMovieUtils.h"
 
@@ -11,7 +12,11 @@ using namespace std;
 
 void usage( string msg = "" )
 {
-	cerr << "usage: pmvutil clip path_input startFrame endFrame path_output " << endl;
+	cerr << "usage: pmvutil clip path_input startFrame endFrame path_output [keyframeStride]" << endl;
+	cerr << "       pmvutil roundtrip path_output [frameCount]" << endl;
+	cerr << endl;
+	cerr << "  roundtrip writes synthetic frames to path_output, reads them back in a" << endl;
+	cerr << "  shuffled order and exits nonzero if any frame differs." << endl;
 
 	if( msg.length() > 0 )
 	{
@@ -22,7 +27,8 @@ void usage( string msg = "" )
 	exit( 1 );
 }
 
-void clip( const char *pathInput, uint32_t frameStart, uint32_t frameEnd, const char *pathOutput );
+void clip( const char *pathInput, uint32_t frameStart, uint32_t frameEnd, const char *pathOutput, uint32_t keyframeStride );
+bool roundtrip( const char *pathOutput, uint32_t frameCount );
 
 int main( int argc, char **argv )
 {
@@ -35,18 +41,48 @@ int main( int argc, char **argv )
 
 	if( mode == "clip" )
 	{
-		if( argc != 6 )
+		if( (argc != 6) && (argc != 7) )
 		{
 			usage();
 		}
 
-		clip( argv[2], (uint32_t)atol(argv[3]), (uint32_t)atol(argv[4]), argv[5] );
+		uint32_t keyframeStride = 0;
+		if( argc == 7 )
+		{
+			keyframeStride = (uint32_t)atol( argv[6] );
+			if( keyframeStride < 1 )
+				usage( "keyframeStride must be >= 1" );
+		}
+
+		clip( argv[2], (uint32_t)atol(argv[3]), (uint32_t)atol(argv[4]), argv[5], keyframeStride );
+	}
+	else if( mode == "roundtrip" )
+	{
+		if( (argc != 3) && (argc != 4) )
+		{
+			usage();
+		}
+
+		uint32_t frameCount = 200;
+		if( argc == 4 )
+		{
+			frameCount = (uint32_t)atol( argv[3] );
+			if( frameCount < 1 )
+				usage( "frameCount must be >= 1" );
+		}
+
+		if( !roundtrip(argv[2], frameCount) )
+			return 1;
+	}
+	else
+	{
+		usage( "Invalid mode " + mode );
 	}
 
 	return 0;
 }
 
-void clip( const char *pathInput, uint32_t frameStart, uint32_t frameEnd, const char *pathOutput )
+void clip( const char *pathInput, uint32_t frameStart, uint32_t frameEnd, const char *pathOutput, uint32_t keyframeStride )
 {
 	FILE *fileInput = fopen( pathInput, "r" );
 	if( !fileInput )
@@ -73,7 +109,10 @@ void clip( const char *pathInput, uint32_t frameStart, uint32_t frameEnd, const
 	if( !fileOutput )
 		usage( string("Cannot open output file '") + pathOutput + "'" );
 
-	PwMovieWriter *writer = new PwMovieWriter( fileOutput );
+	// Encoding on its own thread overlaps with decoding the input.
+	PwMovieWriter *writer = new PwMovieWriter( fileOutput, true );
+	if( keyframeStride > 0 )
+		writer->setKeyframeStride( keyframeStride );
 	
 	uint32_t oldwidth = 0;
 	uint32_t oldheight = 0;
@@ -123,3 +162,111 @@ void clip( const char *pathInput, uint32_t frameStart, uint32_t frameEnd, const
 	delete writer;
 	delete reader;
 }
+
+// Deterministic, so a failure can be reproduced.
+static uint32_t nextRandom( uint32_t &state )
+{
+	state = state * 1664525 + 1013904223;
+	return state >> 8;
+}
+
+// A frame with flat runs, a rectangle that moves every few frames and some
+// noise, so the encoders see long runs, unchanged frames and short spans.
+// The widths aren't multiples of the vector width, and change midway.
+static void synthesizeFrame( uint32_t frame, uint32_t frameCount, uint32_t &random,
+							 uint32_t *width, uint32_t *height, uint32_t *rgbBuf )
+{
+	bool second = frame > frameCount / 2;
+	*width = second ? 45 : 67;
+	*height = second ? 29 : 31;
+
+	uint32_t n = *width * *height;
+	uint32_t opaque = 0xff000000;
+	for( uint32_t i = 0; i < n; i++ )
+		rgbBuf[i] = opaque | (i < n / 3 ? 0x204060 : 0x000000);
+
+	uint32_t x0 = (frame / 3) % *width;
+	for( uint32_t y = 5; y < 15; y++ )
+		for( uint32_t x = x0; (x < x0 + 13) && (x < *width); x++ )
+			rgbBuf[y * *width + x] = opaque | 0xc08020;
+
+	if( frame % 7 != 0 )
+	{
+		uint32_t nnoise = nextRandom( random ) % 40;
+		for( uint32_t i = 0; i < nnoise; i++ )
+			rgbBuf[nextRandom(random) % n] = opaque | (nextRandom(random) & 0xffffff);
+	}
+}
+
+bool roundtrip( const char *pathOutput, uint32_t frameCount )
+{
+	const uint32_t maxPixels = 67 * 31;
+	vector<uint32_t> frames( frameCount * maxPixels );
+	vector<uint32_t> widths( frameCount );
+	vector<uint32_t> heights( frameCount );
+	uint32_t random = 1;
+
+	{
+		FILE *fileOutput = fopen( pathOutput, "w" );
+		if( !fileOutput )
+			usage( string("Cannot open output file '") + pathOutput + "'" );
+
+		PwMovieWriter *writer = new PwMovieWriter( fileOutput, true );
+		writer->setKeyframeStride( 16 );
+
+		for( uint32_t i = 0; i < frameCount; i++ )
+		{
+			uint32_t *rgbBuf = &frames[i * maxPixels];
+			synthesizeFrame( i + 1, frameCount, random, &widths[i], &heights[i], rgbBuf );
+			writer->writeFrame( i + 1, widths[i], heights[i], NULL, rgbBuf );
+		}
+
+		// Closes the file.
+		writer->close();
+		delete writer;
+	}
+
+	FILE *fileInput = fopen( pathOutput, "r" );
+	if( !fileInput )
+		usage( string("Cannot open input file '") + pathOutput + "'" );
+
+	PwMovieReader *reader = new PwMovieReader( fileInput );
+	if( reader->getFrameCount() != frameCount )
+	{
+		cerr << pathOutput << ": wrote " << frameCount << " frames, read " << reader->getFrameCount() << endl;
+		delete reader;
+		return false;
+	}
+
+	// Sequential reads, then jumps both ways across keyframes.
+	vector<uint32_t> order;
+	for( uint32_t frame = 1; frame <= frameCount; frame++ )
+		order.push_back( frame );
+	for( uint32_t i = 0; i < frameCount; i++ )
+		order.push_back( 1 + nextRandom(random) % frameCount );
+
+	uint32_t nbad = 0;
+	for( uint32_t frame : order )
+	{
+		uint32_t timestep;
+		uint32_t width;
+		uint32_t height;
+		uint32_t *rgbBuf;
+
+		reader->readFrame( frame, &timestep, &width, &height, &rgbBuf );
+
+		uint32_t i = frame - 1;
+		if( (timestep != frame) || (width != widths[i]) || (height != heights[i])
+			|| (memcmp(rgbBuf, &frames[i * maxPixels], sizeof(uint32_t) * width * height) != 0) )
+		{
+			if( nbad++ < 10 )
+				cerr << pathOutput << ": frame " << frame << " differs" << endl;
+		}
+	}
+
+	delete reader;
+
+	cout << order.size() << " frame reads, " << nbad << " mismatches" << endl;
+
+	return nbad == 0;
+}
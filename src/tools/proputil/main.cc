@@ -25,7 +25,7 @@ void err( string msg )
 
 void usage( string msg = "" )
 {
-	cerr << "usage: proputil [-w] apply path_schema path_doc" << endl;
+	cerr << "usage: proputil [-i mode] [-w] apply path_schema path_doc" << endl;
 	cerr << "       proputil [-w] get [-s path_schema] path_doc propname" << endl;
 	cerr << "       proputil [-w] set [-s path_schema] path_doc propname=propvalue..." << endl;
 	cerr << "       proputil [-w] len [-s path_schema] path_doc propname" << endl;
@@ -35,6 +35,8 @@ void usage( string msg = "" )
 	cerr << "";
 	cerr << "   -w: Treat doc as worldfile, which may entail property conversion." << endl;
 	cerr << "       If used, then -s must also be used." << endl;
+	cerr << "   -i: How expressions are evaluated: native (default; falls back to" << endl;
+	cerr << "       python), python, or check (both, failing if they differ)." << endl;
 
 	if( msg.length() > 0 )
 	{
@@ -84,6 +86,27 @@ void dbgsyntax( const char *pathDoc );
 
 int main( int argc, const char **argv )
 {
+	Interpreter::Mode interpreterMode = Interpreter::Native;
+
+	if( (argc >= 2) && (string(argv[1]) == "-i") )
+	{
+		if( argc < 3 )
+			usage( "Missing -i arg" );
+
+		string mode = argv[2];
+		if( mode == "native" )
+			interpreterMode = Interpreter::Native;
+		else if( mode == "python" )
+			interpreterMode = Interpreter::Python;
+		else if( mode == "check" )
+			interpreterMode = Interpreter::Check;
+		else
+			usage( "Invalid -i arg (" + mode + ")" );
+
+		argc -= 2;
+		argv += 2;
+	}
+
 	if( argc >= 2 )
 	{
 		if( string(argv[1]) == "-w" )
@@ -113,7 +136,7 @@ int main( int argc, const char **argv )
 		usage( "Must specify mode" );
 	}
 
-	Interpreter::init();
+	Interpreter::init( interpreterMode );
 
 	string mode = argv[1];
 
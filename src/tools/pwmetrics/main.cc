@@ -0,0 +1,151 @@
+#include <stdlib.h>
+#include <string.h>
+#include <sys/stat.h>
+
+#include <iostream>
+#include <sstream>
+#include <string>
+
+#include "utils/MetricsSegment.h"
+
+using namespace std;
+
+#define FARM_PREFIX "polyworld_farm_"
+
+void usage( string msg = "" )
+{
+	cerr << "usage: pwmetrics [--farm | --metric name] path..." << endl;
+	cerr << endl;
+	cerr << "  Prints the metrics most recently published by each run. A path may be a" << endl;
+	cerr << "  run directory or its metrics file." << endl;
+	cerr << endl;
+	cerr << "  --farm         Print the farm status properties as [title=value ...]" << endl;
+	cerr << "  --metric name  Print only the value of the named sample" << endl;
+
+	if( msg.length() > 0 )
+	{
+		cerr << "--------------------------------------------------------------------------------" << endl;
+		cerr << msg << endl;
+	}
+
+	exit( 1 );
+}
+
+string resolve( const string &path )
+{
+	struct stat st;
+	if( (stat(path.c_str(), &st) == 0) && S_ISDIR(st.st_mode) )
+		return path + "/metrics";
+	return path;
+}
+
+string farmStatus( const string &text )
+{
+	string status = "[";
+	istringstream in( text );
+	string line;
+	while( getline(in, line) )
+	{
+		if( line.compare(0, strlen(FARM_PREFIX), FARM_PREFIX) != 0 )
+			continue;
+
+		size_t space = line.find( ' ' );
+		if( space == string::npos )
+			continue;
+
+		if( status.length() > 1 )
+			status += " ";
+		status += line.substr( strlen(FARM_PREFIX), space - strlen(FARM_PREFIX) ) + "=" + line.substr( space + 1 );
+	}
+	return status + "]";
+}
+
+bool metricValue( const string &text, const string &name, string &value )
+{
+	istringstream in( text );
+	string line;
+	while( getline(in, line) )
+	{
+		if( (line.length() > name.length())
+			&& (line.compare(0, name.length(), name) == 0)
+			&& (line[name.length()] == ' ') )
+		{
+			value = line.substr( name.length() + 1 );
+			return true;
+		}
+	}
+	return false;
+}
+
+int main( int argc, char **argv )
+{
+	bool farm = false;
+	string metric;
+
+	int argi = 1;
+	for( ; (argi < argc) && (argv[argi][0] == '-'); argi++ )
+	{
+		string opt = argv[argi];
+		if( opt == "--farm" )
+		{
+			farm = true;
+		}
+		else if( opt == "--metric" )
+		{
+			if( ++argi == argc )
+				usage( "--metric requires a name" );
+			metric = argv[argi];
+		}
+		else
+		{
+			usage( "Unknown option " + opt );
+		}
+	}
+
+	if( argi == argc )
+		usage( "Must specify path" );
+	if( farm && !metric.empty() )
+		usage( "--farm and --metric are exclusive" );
+
+	int nruns = argc - argi;
+	int nfailed = 0;
+
+	for( ; argi < argc; argi++ )
+	{
+		string path = resolve( argv[argi] );
+		string text, err;
+
+		if( !MetricsSegment::read(path, text, err) )
+		{
+			cerr << path << ": " << err << endl;
+			nfailed++;
+			continue;
+		}
+
+		string prefix = nruns > 1 ? string(argv[argi]) + " " : "";
+
+		if( farm )
+		{
+			cout << prefix << farmStatus( text ) << endl;
+		}
+		else if( !metric.empty() )
+		{
+			string value;
+			if( !metricValue(text, metric, value) )
+			{
+				cerr << path << ": no metric " << metric << endl;
+				nfailed++;
+				continue;
+			}
+			cout << prefix << value << endl;
+		}
+		else
+		{
+			if( nruns > 1 )
+				cout << "# run " << argv[argi] << endl;
+			cout << text;
+		}
+	}
+
+	return nfailed ? 1 : 0;
+}
@@ -1 +1 @@
-// This program prints the first 10 random numbers from rand(), drand48(), random(), and gsl#include <stdio.h>#include <stdlib.h>#include <gsl/gsl_rng.h>#define SEED 42int main( int argc, char** argv ){	int i;	srand( SEED );	srand48( SEED );	srandom( SEED );	gsl_rng *gsl = gsl_rng_alloc( gsl_rng_mt19937 );	gsl_rng_set( gsl, SEED );	for( i = 0; i < 10 ; i++ )		printf( "%d:  srand = %10d,  drand48 = %06.4f,  random = %10ld,  gsl = %lf\n",				i,				rand(),				drand48(),				random(),				gsl_rng_uniform(gsl) );	return( 0 );}
\ No newline at end of file
+// This program prints the first 10 random numbers from rand(), drand48(), random(), gsl// and a Philox RandomStream, then runs the RandomStream statistical self-test.#include <stdio.h>#include <stdlib.h>#include <string.h>#include <gsl/gsl_rng.h>#include "utils/RandomStream.h"#define SEED 42int main( int argc, char** argv ){	int i;		srand( SEED );	srand48( SEED );	srandom( SEED );	gsl_rng *gsl = gsl_rng_alloc( gsl_rng_mt19937 );	gsl_rng_set( gsl, SEED );	RandomStream::setMode( RandomStream::COUNTER );	RandomStream::setSeed( SEED );	RandomStream philox( RandomStream::SIMULATION, 0 );		for( i = 0; i < 10 ; i++ )		printf( "%d:  srand = %10d,  drand48 = %06.4f,  random = %10ld,  gsl = %lf,  philox = %lf\n",				i,				rand(),				drand48(),				random(),				gsl_rng_uniform(gsl),				philox.drand() );		if( (argc > 1) && (strcmp(argv[1], "--noselftest") == 0) )		return( 0 );		return( RandomStream::selfTest(stdout) ? 0 : 1 );}
\ No newline at end of file
@@ -0,0 +1,135 @@
+#include <chrono>
+#include <functional>
+#include <iostream>
+#include <stdlib.h>
+#include <string.h>
+#include <vector>
+
+#include "brain/sheets/SheetsModel.h"
+
+using namespace sheets;
+
+struct Args {
+    std::vector<int> sizes;
+    int births;
+    long seed;
+};
+
+void printUsage(int, char**);
+bool tryParseArgs(int, char**, Args&);
+SheetsModel* grow(int, unsigned int&);
+
+int main(int argc, char** argv) {
+    Args args;
+    if (!tryParseArgs(argc, argv, args)) {
+        printUsage(argc, argv);
+        return 1;
+    }
+
+    std::cout << "# size neurons synapses births/s ms/birth" << std::endl;
+    for (int size : args.sizes) {
+        unsigned int rng = (unsigned int)args.seed;
+        long neurons = 0;
+        long synapses = 0;
+        auto start = std::chrono::steady_clock::now();
+        for (int birth = 0; birth < args.births; birth++) {
+            SheetsModel* model = grow(size, rng);
+            neurons += model->getNeurons().size();
+            synapses += model->getSynapses().size();
+            delete model;
+        }
+        auto end = std::chrono::steady_clock::now();
+        double seconds = std::chrono::duration<double>(end - start).count();
+        std::cout << size << " "
+                  << (neurons / args.births) << " "
+                  << (synapses / args.births) << " "
+                  << (args.births / seconds) << " "
+                  << (1000.0 * seconds / args.births) << std::endl;
+    }
+
+    return 0;
+}
+
+void printUsage(int argc, char** argv) {
+    std::cerr << "Usage: " << argv[0] << " [--births N] [--seed N] SIZE..." << std::endl;
+    std::cerr << std::endl;
+    std::cerr << "Measures Sheets brain growth throughput (model construction, receptive" << std::endl;
+    std::cerr << "fields and culling) for synthetic brains whose input and internal sheets" << std::endl;
+    std::cerr << "are SIZE x SIZE neurons. For example:" << std::endl;
+    std::cerr << std::endl;
+    std::cerr << "  " << argv[0] << " 8 16 32 64 128" << std::endl;
+    std::cerr << std::endl;
+    std::cerr << "  --births N   Brains grown per size (default 20)" << std::endl;
+    std::cerr << "  --seed N     Seed for receptive field placement (default 42)" << std::endl;
+}
+
+bool tryParseArgs(int argc, char** argv, Args& args) {
+    args.births = 20;
+    args.seed = 42;
+    int argi = 1;
+    for (; argi < argc - 1 && strncmp(argv[argi], "--", 2) == 0; argi += 2) {
+        if (strcmp(argv[argi], "--births") == 0) {
+            args.births = atoi(argv[argi + 1]);
+        } else if (strcmp(argv[argi], "--seed") == 0) {
+            args.seed = atol(argv[argi + 1]);
+        } else {
+            return false;
+        }
+    }
+    for (; argi < argc; argi++) {
+        int size = atoi(argv[argi]);
+        if (size < 1) {
+            return false;
+        }
+        args.sizes.push_back(size);
+    }
+    return !args.sizes.empty() && args.births > 0;
+}
+
+float uniform(unsigned int& rng, float lo, float hi) {
+    return lo + (hi - lo) * (rand_r(&rng) / (float)RAND_MAX);
+}
+
+// Builds an input sheet, two recurrently connected internal sheets and an
+// output sheet, with receptive fields placed at random.
+SheetsModel* grow(int size, unsigned int& rng) {
+    SheetsModel* model = new SheetsModel(Vector3f(1.0f, 1.0f, 1.0f), 0.0f);
+
+    std::function<void (Neuron*)> neuronCreated = [](Neuron* neuron) {
+        memset(&neuron->attrs, 0, sizeof(neuron->attrs));
+        neuron->attrs.type = Neuron::Attributes::EI;
+    };
+    Vector2f center(0.5f, 0.5f);
+    Vector2f full(1.0f, 1.0f);
+
+    Sheet* input = model->createSheet("Input", 0, Sheet::Input, PlaneXY, 0.0f, center, full, Vector2i(size, size), neuronCreated);
+    Sheet* output = model->createSheet("Output", 1, Sheet::Output, PlaneXY, 1.0f, center, full, Vector2i(4, 1), neuronCreated);
+    Sheet* internal1 = model->createSheet("Internal1", 2, Sheet::Internal, PlaneXY, 0.33f, center, full, Vector2i(size, size), neuronCreated);
+    Sheet* internal2 = model->createSheet("Internal2", 3, Sheet::Internal, PlaneXY, 0.67f, center, full, Vector2i(size, size), neuronCreated);
+
+    auto predicate = [](Neuron*, Sheet::ReceptiveFieldNeuronRole) { return true; };
+    auto synapseCreated = [](Synapse* synapse) {
+        synapse->attrs.weight = 1.0f;
+        synapse->attrs.lrate = 0.0f;
+    };
+    auto field = [&](Sheet* sheet, Sheet* other, Sheet::ReceptiveFieldRole role) {
+        Vector2f currentCenter(uniform(rng, 0.25f, 0.75f), uniform(rng, 0.25f, 0.75f));
+        Vector2f otherCenter(uniform(rng, 0.25f, 0.75f), uniform(rng, 0.25f, 0.75f));
+        Vector2f offset(uniform(rng, -0.5f, 0.5f), uniform(rng, -0.5f, 0.5f));
+        Vector2f fieldSize(uniform(rng, 0.05f, 0.3f), uniform(rng, 0.05f, 0.3f));
+        sheet->addReceptiveField(role, currentCenter, Vector2f(0.8f, 0.8f), otherCenter, Vector2f(0.8f, 0.8f),
+                                 offset, fieldSize, other, predicate, synapseCreated);
+    };
+
+    for (int i = 0; i < 2; i++) {
+        field(internal1, input, Sheet::Source);
+        field(internal1, internal2, Sheet::Source);
+        field(internal2, internal1, Sheet::Source);
+        field(internal2, internal2, Sheet::Target);
+        field(output, internal2, Sheet::Source);
+    }
+
+    model->cull();
+
+    return model;
+}
@@ -1,6 +1,7 @@
 #include <iostream>
 #include <limits>
 #include <map>
+#include <ostream>
 #include <set>
 #include <stdlib.h>
 #include <string>
@@ -31,16 +32,18 @@ struct Args {
 void printUsage(int, char**);
 bool tryParseArgs(int, char**, Args&);
 void printArgs(const Args&);
-void printHeader(int, RqNervousSystem*);
-void printNerves(RqNervousSystem*);
-void printSynapses(RqNervousSystem*);
-void printTimeSeries(RqNervousSystem*, int, int);
-void printActual(AbstractFile*, int);
+void processAgent(const Args&, int, std::ostream&);
+void printHeader(std::ostream&, int, RqNervousSystem*);
+void printNerves(std::ostream&, RqNervousSystem*);
+void printSynapses(std::ostream&, RqNervousSystem*);
+void printTimeSeries(std::ostream&, RqNervousSystem*, int, int);
+void printActual(std::ostream&, AbstractFile*, int);
 void writeBrainFunction(AbstractFile*, int, RqNervousSystem*, int, int, int);
 
 int main(int argc, char** argv) {
     Args args;
-    if (!tryParseArgs(argc, argv, args)) {
+    analysis::DriverOptions options;
+    if (!analysis::tryParseDriverOptions(argc, argv, options) || !tryParseArgs(argc, argv, args)) {
         printUsage(argc, argv);
         return 1;
     }
@@ -51,46 +54,47 @@ int main(int argc, char** argv) {
     }
     analysis::initialize(args.run);
     int maxAgent = analysis::getMaxAgent(args.run);
-    for (int index = 0; index < args.count; index++) {
-        int agent = args.start + index;
-        if (agent > maxAgent) {
-            break;
-        }
-        RqNervousSystem* cns = analysis::getNervousSystem(args.run, agent, args.stage);
-        if (cns == NULL) {
-            continue;
+    int lastAgent = args.count > maxAgent - args.start ? maxAgent : args.start + args.count - 1;
+    analysis::forEachAgent(options, args.start, lastAgent, [&args](int agent, std::ostream& out) {
+        processAgent(args, agent, out);
+    });
+    return 0;
+}
+
+void processAgent(const Args& args, int agent, std::ostream& out) {
+    RqNervousSystem* cns = analysis::getNervousSystem(args.run, agent, args.stage);
+    if (cns == NULL) {
+        return;
+    }
+    cns->getBrain()->freeze();
+    if (args.bf) {
+        char path[256];
+        sprintf(path, "%s/brainFunction_%d.txt", args.output.c_str(), agent);
+        AbstractFile* file = AbstractFile::open(globals::recordFileType(), path, "w");
+        writeBrainFunction(file, agent, cns, args.repeats, args.transient, args.steps);
+        delete file;
+    } else {
+        printHeader(out, agent, cns);
+        printNerves(out, cns);
+        printSynapses(out, cns);
+        out << "# BEGIN ENSEMBLE" << std::endl;
+        for (int index = 0; index < args.repeats; index++) {
+            printTimeSeries(out, cns, args.transient, args.steps);
         }
-        cns->getBrain()->freeze();
-        if (args.bf) {
+        if (args.actual) {
             char path[256];
-            sprintf(path, "%s/brainFunction_%d.txt", args.output.c_str(), agent);
-            AbstractFile* file = AbstractFile::open(globals::recordFileType, path, "w");
-            writeBrainFunction(file, agent, cns, args.repeats, args.transient, args.steps);
+            sprintf(path, "%s/brain/function/brainFunction_%d.txt", args.run.c_str(), agent);
+            AbstractFile* file = AbstractFile::open(globals::recordFileType(), path, "r");
+            printActual(out, file, cns->getBrain()->getDimensions().numNeurons);
             delete file;
-        } else {
-            printHeader(agent, cns);
-            printNerves(cns);
-            printSynapses(cns);
-            std::cout << "# BEGIN ENSEMBLE" << std::endl;
-            for (int index = 0; index < args.repeats; index++) {
-                printTimeSeries(cns, args.transient, args.steps);
-            }
-            if (args.actual) {
-                char path[256];
-                sprintf(path, "%s/brain/function/brainFunction_%d.txt", args.run.c_str(), agent);
-                AbstractFile* file = AbstractFile::open(globals::recordFileType, path, "r");
-                printActual(file, cns->getBrain()->getDimensions().numNeurons);
-                delete file;
-            }
-            std::cout << "# END ENSEMBLE" << std::endl;
         }
-        delete cns;
+        out << "# END ENSEMBLE" << std::endl;
     }
-    return 0;
+    delete cns;
 }
 
 void printUsage(int argc, char** argv) {
-    std::cerr << "Usage: " << argv[0] << " [--actual] [--bf OUTPUT] RUN STAGE REPEATS TRANSIENT STEPS [START [COUNT]]" << std::endl;
+    std::cerr << "Usage: " << argv[0] << " [OPTIONS] [--actual] [--bf OUTPUT] RUN STAGE REPEATS TRANSIENT STEPS [START [COUNT]]" << std::endl;
     std::cerr << std::endl;
     std::cerr << "Generates neural activation time series using random inputs." << std::endl;
     std::cerr << std::endl;
@@ -104,6 +108,8 @@ void printUsage(int argc, char** argv) {
     std::cerr << std::endl;
     std::cerr << "  --actual     Append actual brain function time series" << std::endl;
     std::cerr << "  --bf OUTPUT  Write brain function files to OUTPUT directory" << std::endl;
+    std::cerr << std::endl;
+    analysis::printDriverUsage();
 }
 
 bool tryParseArgs(int argc, char** argv, Args& args) {
@@ -194,26 +200,26 @@ void printArgs(const Args& args) {
     std::cout << "# END ARGUMENTS" << std::endl;
 }
 
-void printHeader(int agent, RqNervousSystem* cns) {
-    std::cout << "# AGENT " << agent << std::endl;
+void printHeader(std::ostream& out, int agent, RqNervousSystem* cns) {
+    out << "# AGENT " << agent << std::endl;
     NeuronModel::Dimensions dims = cns->getBrain()->getDimensions();
-    std::cout << "# DIMENSIONS";
-    std::cout << " " << dims.numNeurons;
-    std::cout << " " << dims.numInputNeurons;
-    std::cout << " " << dims.numOutputNeurons;
-    std::cout << std::endl;
+    out << "# DIMENSIONS";
+    out << " " << dims.numNeurons;
+    out << " " << dims.numInputNeurons;
+    out << " " << dims.numOutputNeurons;
+    out << std::endl;
 }
 
-void printNerves(RqNervousSystem* cns) {
-    std::cout << "# BEGIN NERVES" << std::endl;
+void printNerves(std::ostream& out, RqNervousSystem* cns) {
+    out << "# BEGIN NERVES" << std::endl;
     const NervousSystem::NerveList& nerves = cns->getNerves();
     citfor(NervousSystem::NerveList, nerves, it) {
-        std::cout << (*it)->name << " " << (*it)->getNeuronCount() << std::endl;
+        out << (*it)->name << " " << (*it)->getNeuronCount() << std::endl;
     }
-    std::cout << "# END NERVES" << std::endl;
+    out << "# END NERVES" << std::endl;
 }
 
-void printSynapses(RqNervousSystem* cns) {
+void printSynapses(std::ostream& out, RqNervousSystem* cns) {
     std::map<short, std::set<short> > synapses;
     NeuronModel::Dimensions dims = cns->getBrain()->getDimensions();
     NeuronModel* model = cns->getBrain()->getNeuronModel();
@@ -225,46 +231,46 @@ void printSynapses(RqNervousSystem* cns) {
         model->get_synapse(synapse, neuron1, neuron2, weight, learningRate);
         synapses[neuron1].insert(neuron2);
     }
-    std::cout << "# BEGIN SYNAPSES" << std::endl;
+    out << "# BEGIN SYNAPSES" << std::endl;
     for (int neuron = 0; neuron < dims.numNeurons; neuron++) {
         if (synapses[neuron].size() == 0) {
             continue;
         }
-        std::cout << neuron;
+        out << neuron;
         citfor(std::set<short>, synapses[neuron], it) {
-            std::cout << " " << *it;
+            out << " " << *it;
         }
-        std::cout << std::endl;
+        out << std::endl;
     }
-    std::cout << "# END SYNAPSES" << std::endl;
+    out << "# END SYNAPSES" << std::endl;
 }
 
-void printTimeSeries(RqNervousSystem* cns, int transient, int steps) {
+void printTimeSeries(std::ostream& out, RqNervousSystem* cns, int transient, int steps) {
     cns->getBrain()->randomizeActivations();
     for (int step = 1; step <= transient; step++) {
         cns->update(false);
     }
     NeuronModel::Dimensions dims = cns->getBrain()->getDimensions();
     double* activations = new double[dims.numNeurons];
-    std::cout << "# BEGIN TIME SERIES" << std::endl;
+    out << "# BEGIN TIME SERIES" << std::endl;
     for (int step = 1; step <= steps; step++) {
         cns->getBrain()->getActivations(activations + dims.numInputNeurons, dims.numInputNeurons, dims.getNumNonInputNeurons());
         cns->update(false);
         cns->getBrain()->getActivations(activations, 0, dims.numInputNeurons);
         for (int neuron = 0; neuron < dims.numNeurons; neuron++) {
             if (neuron > 0) {
-                std::cout << " ";
+                out << " ";
             }
-            std::cout << activations[neuron];
+            out << activations[neuron];
         }
-        std::cout << std::endl;
+        out << std::endl;
     }
-    std::cout << "# END TIME SERIES" << std::endl;
+    out << "# END TIME SERIES" << std::endl;
     delete[] activations;
 }
 
-void printActual(AbstractFile* file, int neuronCount) {
-    std::cout << "# BEGIN TIME SERIES";
+void printActual(std::ostream& out, AbstractFile* file, int neuronCount) {
+    out << "# BEGIN TIME SERIES";
     char line[256];
     file->gets(line, sizeof(line));
     file->gets(line, sizeof(line));
@@ -276,14 +282,14 @@ void printActual(AbstractFile* file, int neuronCount) {
             break;
         }
         if (neuron == 0) {
-            std::cout << std::endl;
+            out << std::endl;
         } else {
-            std::cout << " ";
+            out << " ";
         }
-        std::cout << activation;
+        out << activation;
     }
-    std::cout << std::endl;
-    std::cout << "# END TIME SERIES" << std::endl;
+    out << std::endl;
+    out << "# END TIME SERIES" << std::endl;
 }
 
 void writeBrainFunction(AbstractFile* file, int agent, RqNervousSystem* cns, int repeats, int transient, int steps) {